@@ -27,6 +27,7 @@
 #include "log.h"
 
 #include <sstream>
+#include <map>
 
 /**
  * \file
@@ -150,6 +151,9 @@ MatchContainer::DisconnectWithoutContext (std::string name, const CallbackBase &
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, at construction, into a list of
+ * index ranges.
  */
 class ArrayMatcher
 {
@@ -167,7 +171,21 @@ public:
    * \returns \c true if the index matches the Config Path.
    */
   bool Matches (std::size_t i) const;
+  /**
+   * Test if the Config path specification matches a single index.
+   *
+   * \param [out] i The index.
+   * \returns \c true if the specification matches a single index.
+   */
+  bool GetIndex (std::size_t *i) const;
 private:
+  /**
+   * Parse a Config path specification, or a part of it, and add
+   * the matching index ranges.
+   *
+   * \param [in] element The Config path specification.
+   */
+  void Parse (std::string element);
   /**
    * Convert a string to an \c uint32_t.
    *
@@ -178,78 +196,94 @@ private:
   bool StringToUint32 (std::string str, uint32_t *value) const;
   /** The Config path element. */
   std::string m_element;
+  /** Whether any index matches. */
+  bool m_any;
+  /** The matching index ranges, bounds included. */
+  std::vector<std::pair<uint32_t, uint32_t> > m_ranges;
 
 };  // class ArrayMatcher
 
 
 ArrayMatcher::ArrayMatcher (std::string element)
-  : m_element (element)
+  : m_element (element),
+    m_any (false)
 {
   NS_LOG_FUNCTION (this << element);
+  Parse (element);
 }
-bool
-ArrayMatcher::Matches (std::size_t i) const
+void
+ArrayMatcher::Parse (std::string element)
 {
-  NS_LOG_FUNCTION (this << i);
-  if (m_element == "*")
+  NS_LOG_FUNCTION (this << element);
+  if (element == "*")
     {
-      NS_LOG_DEBUG ("Array "<<i<<" matches *");
-      return true;
+      m_any = true;
+      return;
     }
   std::string::size_type tmp;
-  tmp = m_element.find ("|");
+  tmp = element.find ("|");
   if (tmp != std::string::npos)
     {
-      std::string left = m_element.substr (0, tmp-0);
-      std::string right = m_element.substr (tmp+1, m_element.size () - (tmp + 1));
-      ArrayMatcher matcher = ArrayMatcher (left);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array "<<i<<" matches "<<left);
-          return true;
-        }
-      matcher = ArrayMatcher (right);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array "<<i<<" matches "<<right);
-          return true;
-        }
-      NS_LOG_DEBUG ("Array "<<i<<" does not match "<<m_element);
-      return false;
+      Parse (element.substr (0, tmp-0));
+      Parse (element.substr (tmp+1, element.size () - (tmp + 1)));
+      return;
     }
-  std::string::size_type leftBracket = m_element.find ("[");
-  std::string::size_type rightBracket = m_element.find ("]");
-  std::string::size_type dash = m_element.find ("-");
-  if (leftBracket == 0 && rightBracket == m_element.size () - 1 &&
+  std::string::size_type leftBracket = element.find ("[");
+  std::string::size_type rightBracket = element.find ("]");
+  std::string::size_type dash = element.find ("-");
+  if (leftBracket == 0 && rightBracket == element.size () - 1 &&
       dash > leftBracket && dash < rightBracket)
     {
-      std::string lowerBound = m_element.substr (leftBracket + 1, dash - (leftBracket + 1));
-      std::string upperBound = m_element.substr (dash + 1, rightBracket - (dash + 1));
+      std::string lowerBound = element.substr (leftBracket + 1, dash - (leftBracket + 1));
+      std::string upperBound = element.substr (dash + 1, rightBracket - (dash + 1));
       uint32_t min;
       uint32_t max;
-      if (StringToUint32 (lowerBound, &min) && 
+      if (StringToUint32 (lowerBound, &min) &&
           StringToUint32 (upperBound, &max) &&
-          i >= min && i <= max)
-        {
-          NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
-          return true;
-        }
-      else
+          min <= max)
         {
-          NS_LOG_DEBUG ("Array "<<i<<" does not "<<m_element);
-          return false;
+          m_ranges.push_back (std::make_pair (min, max));
         }
+      return;
     }
   uint32_t value;
-  if (StringToUint32 (m_element, &value) &&
-      i == value)
+  if (StringToUint32 (element, &value))
+    {
+      m_ranges.push_back (std::make_pair (value, value));
+    }
+}
+bool
+ArrayMatcher::Matches (std::size_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  if (m_any)
     {
       NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
       return true;
     }
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator range = m_ranges.begin ();
+       range != m_ranges.end (); ++range)
+    {
+      if (i >= range->first && i <= range->second)
+        {
+          NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
+          return true;
+        }
+    }
   NS_LOG_DEBUG ("Array "<<i<<" does not match "<<m_element);
   return false;
 }
+bool
+ArrayMatcher::GetIndex (std::size_t *i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  if (m_any || m_ranges.size () != 1 || m_ranges[0].first != m_ranges[0].second)
+    {
+      return false;
+    }
+  *i = m_ranges[0].first;
+  return true;
+}
 
 bool
 ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
@@ -264,6 +298,11 @@ ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
+ *
+ * The Config path is compiled once, at construction, into a list of
+ * segments.  The attributes which can be followed from an object are
+ * looked up once per TypeId and segment name, and then shared by all
+ * the resolutions.
  */
 class Resolver
 {
@@ -285,25 +324,73 @@ public:
    *                  in the Config path.
    */
   void Resolve (Ptr<Object> root);
-  
+
 private:
-  /** Ensure the Config path starts and ends with a '/'. */
-  void Canonicalize (void);
+  /** A compiled segment of the Config path. */
+  struct Segment
+  {
+    /**
+     * Constructor.
+     * \param [in] item The path segment.
+     */
+    Segment (std::string item);
+    /** The path segment. */
+    std::string item;
+    /** Whether this segment is a GetObject call, i.e., starts with '$'. */
+    bool getObject;
+    /** Whether the TypeId of a GetObject call is known. */
+    bool tidFound;
+    /** The TypeId of a GetObject call. */
+    TypeId tid;
+    /** The matcher, if this segment is an index into a container. */
+    ArrayMatcher matcher;
+  };
+  /** An attribute which can be followed along a Config path. */
+  struct PathAttribute
+  {
+    /** The attribute name. */
+    std::string name;
+    /** The attribute accessor. */
+    Ptr<const AttributeAccessor> accessor;
+    /** The container accessor, if the attribute is a container, or 0. */
+    const ObjectPtrContainerAccessor *container;
+    /** Whether the attribute is a pointer. */
+    bool pointer;
+    /** Whether the attribute value can be read through the accessor. */
+    bool getter;
+  };
+  /** Container type of the followable attributes. */
+  typedef std::vector<PathAttribute> PathAttributes;
+
+  /**
+   * Compile the Config path into segments.
+   *
+   * \param [in] path The Config path.
+   */
+  void Compile (std::string path);
+  /**
+   * Get the followable attributes of a TypeId which match a path segment.
+   *
+   * \param [in] tid The TypeId of the current object.
+   * \param [in] item The path segment.
+   * \returns The matching attributes.
+   */
+  static const PathAttributes & LookupAttributes (TypeId tid, const std::string &item);
   /**
    * Parse the next element in the Config path.
    *
-   * \param [in] path The remaining portion of the Config path.
+   * \param [in] segment The index of the next segment of the Config path.
    * \param [in] root The object corresponding to the current position
    *                  in the Config path.
    */
-  void DoResolve (std::string path, Ptr<Object> root);
+  void DoResolve (std::size_t segment, Ptr<Object> root);
   /**
    * Parse an index on the Config path.
    *
-   * \param [in] path The remaining Config path.
+   * \param [in] segment The index of the next segment of the Config path.
    * \param [in,out] vector The resulting list of matching objects.
    */
-  void DoArrayResolve (std::string path, const ObjectPtrContainerValue &vector);
+  void DoArrayResolve (std::size_t segment, const ObjectPtrContainerValue &vector);
   /**
    * Handle one object found on the path.
    *
@@ -326,47 +413,67 @@ private:
 
   /** Current list of path tokens. */
   std::vector<std::string> m_workStack;
-  /** The Config path. */
-  std::string m_path;
+  /** The compiled Config path. */
+  std::vector<Segment> m_segments;
 
 };  // class Resolver
 
+Resolver::Segment::Segment (std::string item)
+  : item (item),
+    getObject (item.find ("$") == 0),
+    tidFound (false),
+    matcher (item)
+{
+  if (getObject)
+    {
+      tidFound = TypeId::LookupByNameFailSafe (item.substr (1, item.size () - 1), &tid);
+    }
+}
+
 Resolver::Resolver (std::string path)
-  : m_path (path)
 {
   NS_LOG_FUNCTION (this << path);
-  Canonicalize ();
+  Compile (path);
 }
 Resolver::~Resolver ()
 {
   NS_LOG_FUNCTION (this);
 }
 void
-Resolver::Canonicalize (void)
+Resolver::Compile (std::string path)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << path);
 
   // ensure that we start and end with a '/'
-  std::string::size_type tmp = m_path.find ("/");
+  std::string::size_type tmp = path.find ("/");
   if (tmp != 0)
     {
       // no slash at start
-      m_path = "/" + m_path;
+      path = "/" + path;
     }
-  tmp = m_path.find_last_of ("/");
-  if (tmp != (m_path.size () - 1))
+  tmp = path.find_last_of ("/");
+  if (tmp != (path.size () - 1))
     {
       // no slash at end
-      m_path = m_path + "/";
+      path = path + "/";
+    }
+
+  std::string::size_type cur = 0;
+  std::string::size_type next = path.find ("/", 1);
+  while (next != std::string::npos)
+    {
+      m_segments.push_back (Segment (path.substr (cur + 1, next - (cur + 1))));
+      cur = next;
+      next = path.find ("/", cur + 1);
     }
 }
 
-void 
+void
 Resolver::Resolve (Ptr<Object> root)
 {
   NS_LOG_FUNCTION (this << root);
 
-  DoResolve (m_path, root);
+  DoResolve (0, root);
 }
 
 std::string
@@ -382,7 +489,7 @@ Resolver::GetResolvedPath (void) const
   return fullPath;
 }
 
-void 
+void
 Resolver::DoResolveOne (Ptr<Object> object)
 {
   NS_LOG_FUNCTION (this << object);
@@ -391,46 +498,93 @@ Resolver::DoResolveOne (Ptr<Object> object)
   DoOne (object, GetResolvedPath ());
 }
 
+const Resolver::PathAttributes &
+Resolver::LookupAttributes (TypeId tid, const std::string &item)
+{
+  NS_LOG_FUNCTION (tid << item);
+  // TypeIds are never unregistered, so that the entries never go stale
+  static std::map<std::pair<uint16_t, std::string>, PathAttributes> cache;
+  std::pair<uint16_t, std::string> key = std::make_pair (tid.GetUid (), item);
+  std::map<std::pair<uint16_t, std::string>, PathAttributes>::iterator it = cache.find (key);
+  if (it != cache.end ())
+    {
+      return it->second;
+    }
+
+  PathAttributes attributes;
+  TypeId instanceTid = tid;
+  TypeId nextTid = tid;
+  do
+    {
+      tid = nextTid;
+      for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
+        {
+          struct TypeId::AttributeInformation info = tid.GetAttribute (i);
+          if (info.name != item && item != "*")
+            {
+              continue;
+            }
+          bool pointer = dynamic_cast<const PointerChecker *> (PeekPointer (info.checker)) != 0;
+          bool container = dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker)) != 0;
+          if (!pointer && !container)
+            {
+              // this could be anything else and we don't know what to do with it.
+              continue;
+            }
+          // as in ObjectBase::GetAttribute, the attribute is accessed by name
+          instanceTid.LookupAttributeByName (info.name, &info);
+          PathAttribute attribute;
+          attribute.name = info.name;
+          attribute.accessor = info.accessor;
+          attribute.container = container ?
+            dynamic_cast<const ObjectPtrContainerAccessor *> (PeekPointer (info.accessor)) : 0;
+          attribute.pointer = pointer;
+          attribute.getter = (info.flags & TypeId::ATTR_GET) && info.accessor->HasGetter ();
+          attributes.push_back (attribute);
+        }
+      nextTid = tid.GetParent ();
+    } while (nextTid != tid);
+
+  return cache.insert (std::make_pair (key, attributes)).first->second;
+}
+
 void
-Resolver::DoResolve (std::string path, Ptr<Object> root)
+Resolver::DoResolve (std::size_t segment, Ptr<Object> root)
 {
-  NS_LOG_FUNCTION (this << path << root);
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
+  NS_LOG_FUNCTION (this << segment << root);
 
-  if (next == std::string::npos)
+  if (segment == m_segments.size ())
     {
       //
-      // If root is zero, we're beginning to see if we can use the object name 
-      // service to resolve this path.  It is impossible to have a object name 
+      // If root is zero, we're beginning to see if we can use the object name
+      // service to resolve this path.  It is impossible to have a object name
       // associated with the root of the object name service since that root
       // is not an object.  This path must be referring to something in another
       // namespace and it will have been found already since the name service
       // is always consulted last.
-      // 
+      //
       if (root)
         {
           DoResolveOne (root);
         }
       return;
     }
-  std::string item = path.substr (1, next-1);
-  std::string pathLeft = path.substr (next, path.size ()-next);
+  const Segment &current = m_segments[segment];
+  const std::string &item = current.item;
 
   //
-  // If root is zero, we're beginning to see if we can use the object name 
-  // service to resolve this path.  In this case, we must see the name space 
-  // "/Names" on the front of this path.  There is no object associated with 
-  // the root of the "/Names" namespace, so we just ignore it and move on to 
+  // If root is zero, we're beginning to see if we can use the object name
+  // service to resolve this path.  In this case, we must see the name space
+  // "/Names" on the front of this path.  There is no object associated with
+  // the root of the "/Names" namespace, so we just ignore it and move on to
   // the next segment.
   //
   if (root == 0)
     {
-      std::string::size_type offset = path.find ("/Names");
-      if (offset == 0)
+      if (item.compare (0, 5, "Names") == 0)
         {
           m_workStack.push_back (item);
-          DoResolve (pathLeft, root);
+          DoResolve (segment + 1, root);
           m_workStack.pop_back ();
           return;
         }
@@ -447,7 +601,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       NS_LOG_DEBUG ("Name system resolved item = " << item << " to " << namedObject);
       m_workStack.push_back (item);
-      DoResolve (pathLeft, namedObject);
+      DoResolve (segment + 1, namedObject);
       m_workStack.pop_back ();
       return;
     }
@@ -463,83 +617,80 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       return;
     }
-  std::string::size_type dollarPos = item.find ("$");
-  if (dollarPos == 0)
+  if (current.getObject)
     {
       // This is a call to GetObject
-      std::string tidString = item.substr (1, item.size () - 1);
-      NS_LOG_DEBUG ("GetObject="<<tidString<<" on path="<<GetResolvedPath ());
-      TypeId tid = TypeId::LookupByName (tidString);
+      NS_LOG_DEBUG ("GetObject="<<item<<" on path="<<GetResolvedPath ());
+      // an unknown TypeId is a fatal error, as soon as it is used
+      TypeId tid = current.tidFound ? current.tid
+        : TypeId::LookupByName (item.substr (1, item.size () - 1));
       Ptr<Object> object = root->GetObject<Object> (tid);
       if (object == 0)
         {
-          NS_LOG_DEBUG ("GetObject ("<<tidString<<") failed on path="<<GetResolvedPath ());
+          NS_LOG_DEBUG ("GetObject ("<<item<<") failed on path="<<GetResolvedPath ());
           return;
         }
       m_workStack.push_back (item);
-      DoResolve (pathLeft, object);
+      DoResolve (segment + 1, object);
       m_workStack.pop_back ();
     }
-  else 
+  else
     {
       // this is a normal attribute.
-      TypeId tid;
-      TypeId nextTid = root->GetInstanceTypeId ();
-      bool foundMatch = false;
-      
-      do
+      const PathAttributes &attributes = LookupAttributes (root->GetInstanceTypeId (), item);
+      for (PathAttributes::const_iterator i = attributes.begin (); i != attributes.end (); ++i)
         {
-          tid = nextTid;
-          
-          for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+          if (i->pointer)
             {
-              struct TypeId::AttributeInformation info;
-              info = tid.GetAttribute(i);
-              if (info.name != item && item != "*")
+              NS_LOG_DEBUG ("GetAttribute(ptr)="<<i->name<<" on path="<<GetResolvedPath ());
+              PointerValue pValue;
+              if (!i->getter || !i->accessor->Get (PeekPointer (root), pValue))
                 {
+                  root->GetAttribute (i->name, pValue);
+                }
+              Ptr<Object> object = pValue.Get<Object> ();
+              if (object == 0)
+                {
+                  NS_LOG_ERROR ("Requested object name=\""<<item<<
+                                "\" exists on path=\""<<GetResolvedPath ()<<"\""
+                                " but is null.");
                   continue;
                 }
-              // attempt to cast to a pointer checker.
-              const PointerChecker *pChecker = dynamic_cast<const PointerChecker *> (PeekPointer(info.checker));
-              if (pChecker != 0)
+              m_workStack.push_back (i->name);
+              DoResolve (segment + 1, object);
+              m_workStack.pop_back ();
+            }
+          else
+            {
+              NS_LOG_DEBUG ("GetAttribute(vector)="<<i->name<<" on path="<<GetResolvedPath ());
+              std::size_t index;
+              if (i->container != 0 && i->getter &&
+                  segment + 1 < m_segments.size () &&
+                  m_segments[segment + 1].matcher.GetIndex (&index))
                 {
-                  NS_LOG_DEBUG ("GetAttribute(ptr)="<<info.name<<" on path="<<GetResolvedPath ());
-                  PointerValue pValue;
-                  root->GetAttribute (info.name, pValue);
-                  Ptr<Object> object = pValue.Get<Object> ();
-                  if (object == 0)
+                  // a single index: avoid copying the whole container
+                  Ptr<Object> object = i->container->Find (PeekPointer (root), index);
+                  if (object != 0)
                     {
-                      NS_LOG_ERROR ("Requested object name=\""<<item<<
-                                    "\" exists on path=\""<<GetResolvedPath ()<<"\""
-                                    " but is null.");
-                      continue;
+                      std::ostringstream oss;
+                      oss << index;
+                      m_workStack.push_back (i->name);
+                      m_workStack.push_back (oss.str ());
+                      DoResolve (segment + 2, object);
+                      m_workStack.pop_back ();
+                      m_workStack.pop_back ();
                     }
-                  foundMatch = true;
-                  m_workStack.push_back (info.name);
-                  DoResolve (pathLeft, object);
-                  m_workStack.pop_back ();
-                }
-              // attempt to cast to an object vector.
-              const ObjectPtrContainerChecker *vectorChecker = 
-                dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker));
-              if (vectorChecker != 0)
-                {
-                  NS_LOG_DEBUG ("GetAttribute(vector)="<<info.name<<" on path="<<GetResolvedPath () << pathLeft);
-                  foundMatch = true;
-                  ObjectPtrContainerValue vector;
-                  root->GetAttribute (info.name, vector);
-                  m_workStack.push_back (info.name);
-                  DoArrayResolve (pathLeft, vector);
-                  m_workStack.pop_back ();
+                  continue;
                 }
-              // this could be anything else and we don't know what to do with it.
-              // So, we just ignore it.
+              ObjectPtrContainerValue vector;
+              root->GetAttribute (i->name, vector);
+              m_workStack.push_back (i->name);
+              DoArrayResolve (segment + 1, vector);
+              m_workStack.pop_back ();
             }
+        }
 
-          nextTid = tid.GetParent ();
-        } while (nextTid != tid);
-      
-      if (!foundMatch)
+      if (attributes.empty ())
         {
           NS_LOG_DEBUG ("Requested item="<<item<<" does not exist on path="<<GetResolvedPath ());
           return;
@@ -547,21 +698,16 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     }
 }
 
-void 
-Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &container)
+void
+Resolver::DoArrayResolve (std::size_t segment, const ObjectPtrContainerValue &container)
 {
-  NS_LOG_FUNCTION(this << path << &container);
-  NS_ASSERT (path != "");
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-  if (next == std::string::npos)
+  NS_LOG_FUNCTION(this << segment << &container);
+  if (segment == m_segments.size ())
     {
       return;
     }
-  std::string item = path.substr (1, next-1);
-  std::string pathLeft = path.substr (next, path.size ()-next);
 
-  ArrayMatcher matcher = ArrayMatcher (item);
+  const ArrayMatcher &matcher = m_segments[segment].matcher;
   ObjectPtrContainerValue::Iterator it;
   for (it = container.Begin (); it != container.End (); ++it)
     {
@@ -570,7 +716,7 @@ Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &conta
           std::ostringstream oss;
           oss << (*it).first;
           m_workStack.push_back (oss.str ());
-          DoResolve (pathLeft, (*it).second);
+          DoResolve (segment + 1, (*it).second);
           m_workStack.pop_back ();
         }
     }
@@ -593,6 +739,12 @@ public:
   void DisconnectWithoutContext (std::string path, const CallbackBase &cb);
   /** \copydoc Config::Disconnect() */
   void Disconnect (std::string path, const CallbackBase &cb);
+  /**
+   * \copydoc Config::Connect(const std::vector<std::string>&,const std::vector<CallbackBase>&)
+   * \param [in] context Whether the sinks receive the context.
+   */
+  void Connect (const std::vector<std::string> &paths,
+                const std::vector<CallbackBase> &cbs, bool context);
   /** \copydoc Config::LookupMatches() */
   MatchContainer LookupMatches (std::string path);
 
@@ -684,6 +836,46 @@ ConfigImpl::Disconnect (std::string path, const CallbackBase &cb)
   MatchContainer container = LookupMatches (root);
   container.Disconnect (leaf, cb);
 }
+void
+ConfigImpl::Connect (const std::vector<std::string> &paths,
+                     const std::vector<CallbackBase> &cbs, bool context)
+{
+  NS_LOG_FUNCTION (this << paths.size () << context);
+  NS_ASSERT_MSG (paths.size () == cbs.size (), "One callback is needed per path");
+
+  // group the trace sources by object path, in order of first appearance,
+  // so that every object path is resolved only once
+  std::vector<std::string> roots;
+  std::map<std::string, std::vector<std::size_t> > groups;
+  std::vector<std::string> leaves (paths.size ());
+  for (std::size_t i = 0; i < paths.size (); i++)
+    {
+      std::string root;
+      ParsePath (paths[i], &root, &leaves[i]);
+      std::vector<std::size_t> &group = groups[root];
+      if (group.empty ())
+        {
+          roots.push_back (root);
+        }
+      group.push_back (i);
+    }
+  for (std::vector<std::string>::const_iterator root = roots.begin (); root != roots.end (); ++root)
+    {
+      MatchContainer container = LookupMatches (*root);
+      const std::vector<std::size_t> &group = groups[*root];
+      for (std::vector<std::size_t>::const_iterator i = group.begin (); i != group.end (); ++i)
+        {
+          if (context)
+            {
+              container.Connect (leaves[*i], cbs[*i]);
+            }
+          else
+            {
+              container.ConnectWithoutContext (leaves[*i], cbs[*i]);
+            }
+        }
+    }
+}
 
 MatchContainer 
 ConfigImpl::LookupMatches (std::string path)
@@ -851,6 +1043,18 @@ Disconnect (std::string path, const CallbackBase &cb)
   NS_LOG_FUNCTION (path << &cb);
   ConfigImpl::Get ()->Disconnect (path, cb);
 }
+void
+Connect (const std::vector<std::string> &paths, const std::vector<CallbackBase> &cbs)
+{
+  NS_LOG_FUNCTION (paths.size ());
+  ConfigImpl::Get ()->Connect (paths, cbs, true);
+}
+void
+ConnectWithoutContext (const std::vector<std::string> &paths, const std::vector<CallbackBase> &cbs)
+{
+  NS_LOG_FUNCTION (paths.size ());
+  ConfigImpl::Get ()->Connect (paths, cbs, false);
+}
 MatchContainer LookupMatches (std::string path)
 {
   NS_LOG_FUNCTION (path);
@@ -131,6 +131,28 @@ void DisconnectWithoutContext (std::string path, const CallbackBase &cb);
  * context string upon trace event notification.
  */
 void Connect (std::string path, const CallbackBase &cb);
+/**
+ * \ingroup config
+ * \param [in] paths The paths to match trace sources.
+ * \param [in] cbs The callbacks to connect, one per path.
+ *
+ * Connect many trace sources at once, with the same semantics as
+ * calling Connect(std::string,const CallbackBase&) for every path
+ * and callback; however, the paths which only differ by the name
+ * of the trace source are resolved only once.
+ */
+void Connect (const std::vector<std::string> &paths, const std::vector<CallbackBase> &cbs);
+/**
+ * \ingroup config
+ * \param [in] paths The paths to match trace sources.
+ * \param [in] cbs The callbacks to connect, one per path.
+ *
+ * Connect many trace sources at once, with the same semantics as
+ * calling ConnectWithoutContext(std::string,const CallbackBase&) for
+ * every path and callback; however, the paths which only differ by
+ * the name of the trace source are resolved only once.
+ */
+void ConnectWithoutContext (const std::vector<std::string> &paths, const std::vector<CallbackBase> &cbs);
 /**
  * \ingroup config
  * \param [in] path A path to match trace sources.
@@ -25,10 +25,24 @@
 
 #include "ptr.h"
 #include "pointer.h"
+#include "boolean.h"
+#include "object-base.h"
 #include "assert.h"
 #include "log.h"
 
 #include <cmath>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#if (__GNUC__ >= 3)
+#include <cxxabi.h>
+#endif
 
 
 /**
@@ -53,10 +67,88 @@ DefaultSimulatorImpl::GetTypeId (void)
     .SetParent<SimulatorImpl> ()
     .SetGroupName ("Core")
     .AddConstructor<DefaultSimulatorImpl> ()
+    .AddAttribute ("EventProfiling",
+                   "Profile the wall-clock time, count and fan-out of the events "
+                   "per event target and per context.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&DefaultSimulatorImpl::m_profiling),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
+/**
+ * \ingroup simulator
+ * Get a readable name for the target of an event.
+ *
+ * For the events built by MakeEvent, this is the signature of the
+ * bound function or class method, followed by its address.
+ *
+ * \param [in] type The dynamic type of the event.
+ * \param [in] function The raw bits of the bound function pointer.
+ * \returns The name of the event target.
+ */
+static std::string
+EventTargetName (const std::type_info &type, const void * const function[2])
+{
+  std::string name = type.name ();
+#if (__GNUC__ >= 3)
+  int status;
+  char *demangled = abi::__cxa_demangle (name.c_str (), NULL, NULL, &status);
+  if (status == 0)
+    {
+      name = demangled;
+    }
+  std::free (demangled);
+#endif
+  std::string::size_type start = name.find ("MakeEvent<");
+  if (start != std::string::npos)
+    {
+      start += 10;
+      std::string::size_type end = start;
+      int depth = 1;
+      while (end < name.size () && depth > 0)
+        {
+          if (name[end] == '<')
+            {
+              depth++;
+            }
+          else if (name[end] == '>')
+            {
+              depth--;
+            }
+          end++;
+        }
+      name = name.substr (start, end - 1 - start);
+      name.erase (name.find_last_not_of (' ') + 1);
+    }
+  if (function[0] != 0)
+    {
+      std::ostringstream oss;
+      oss << name << " @" << function[0];
+      name = oss.str ();
+    }
+  return name;
+}
+
+bool
+DefaultSimulatorImpl::ProfileKey::operator < (const ProfileKey &o) const
+{
+  if (type != o.type)
+    {
+      return type->before (*o.type);
+    }
+  if (function[0] != o.function[0])
+    {
+      return function[0] < o.function[0];
+    }
+  if (function[1] != o.function[1])
+    {
+      return function[1] < o.function[1];
+    }
+  return tid < o.tid;
+}
+
 DefaultSimulatorImpl::DefaultSimulatorImpl ()
 {
   NS_LOG_FUNCTION (this);
@@ -70,6 +162,8 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_currentUid = 0;
   m_currentTs = 0;
   m_currentContext = Simulator::NO_CONTEXT;
+  m_eventCount = 0;
+  m_profiling = false;
   m_unscheduledEvents = 0;
   m_eventsWithContextEmpty = true;
   m_main = SystemThread::Self();
@@ -108,6 +202,10 @@ DefaultSimulatorImpl::Destroy ()
           ev->Invoke ();
         }
     }
+  if (m_profiling)
+    {
+      PrintProfile (std::clog);
+    }
 }
 
 void
@@ -146,12 +244,164 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
   m_currentTs = next.key.m_ts;
   m_currentContext = next.key.m_context;
   m_currentUid = next.key.m_uid;
-  next.impl->Invoke ();
+  m_eventCount++;
+  if (m_profiling)
+    {
+      InvokeProfiled (next.impl);
+    }
+  else
+    {
+      next.impl->Invoke ();
+    }
   next.impl->Unref ();
 
   ProcessEventsWithContext ();
 }
 
+void
+DefaultSimulatorImpl::InvokeProfiled (EventImpl *event)
+{
+  if (event->IsCancelled ())
+    {
+      // the object bound to a canceled event may be gone already
+      return;
+    }
+  EventImpl::Target target;
+  target.function[0] = 0;
+  target.function[1] = 0;
+  target.object = 0;
+  event->GetTarget (target);
+
+  ProfileKey key;
+  key.type = &typeid (*event);
+  key.function[0] = target.function[0];
+  key.function[1] = target.function[1];
+  key.tid = target.object != 0 ? target.object->GetInstanceTypeId ().GetUid () : 0;
+
+  // the entries are never erased, so that the iterator stays valid
+  // even if the event itself resets the profile
+  std::map<ProfileKey, ProfileTarget>::iterator it = m_profileTargets.find (key);
+  if (it == m_profileTargets.end ())
+    {
+      ProfileTarget entry = ProfileTarget ();
+      entry.object = target.object != 0 ? target.object->GetInstanceTypeId ().GetName () : "-";
+      entry.function = EventTargetName (*key.type, key.function);
+      it = m_profileTargets.insert (std::make_pair (key, entry)).first;
+    }
+
+  uint32_t uid = m_uid;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+  event->Invoke ();
+  uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>
+      (std::chrono::steady_clock::now () - start).count ();
+
+  ProfileStats &stats = it->second.stats;
+  stats.count++;
+  stats.ns += ns;
+  stats.fanOut += m_uid - uid;
+  ProfileStats &contextStats = m_profileContexts[m_currentContext];
+  contextStats.count++;
+  contextStats.ns += ns;
+  contextStats.fanOut += m_uid - uid;
+}
+
+/**
+ * \ingroup simulator
+ * Print the statistics of an event profile entry.
+ *
+ * \param [in,out] os The output stream.
+ * \param [in] count The number of invocations.
+ * \param [in] ns The wall-clock time spent in the invocations, in ns.
+ * \param [in] fanOut The number of events scheduled by the invocations.
+ * \param [in] total The wall-clock time spent in all the events, in ns.
+ */
+static void
+PrintProfileStats (std::ostream &os, uint64_t count, uint64_t ns, uint64_t fanOut, uint64_t total)
+{
+  os << std::fixed
+     << std::setw (12) << std::setprecision (3) << ns / 1e6
+     << std::setw (8) << std::setprecision (2) << (total > 0 ? 100.0 * ns / total : 0.0)
+     << std::setw (12) << count
+     << std::setw (12) << std::setprecision (3) << (count > 0 ? ns / 1e3 / count : 0.0)
+     << std::setw (9) << std::setprecision (2) << (count > 0 ? double (fanOut) / count : 0.0)
+     << "  ";
+}
+
+void
+DefaultSimulatorImpl::PrintProfile (std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this);
+  uint64_t total = 0;
+  uint64_t count = 0;
+  std::vector<std::pair<uint64_t, const ProfileTarget *> > targets;
+  for (std::map<ProfileKey, ProfileTarget>::const_iterator i = m_profileTargets.begin ();
+       i != m_profileTargets.end (); ++i)
+    {
+      if (i->second.stats.count > 0)
+        {
+          total += i->second.stats.ns;
+          count += i->second.stats.count;
+          targets.push_back (std::make_pair (i->second.stats.ns, &i->second));
+        }
+    }
+  std::sort (targets.begin (), targets.end (),
+             std::greater<std::pair<uint64_t, const ProfileTarget *> > ());
+  std::vector<std::pair<uint64_t, uint32_t> > contexts;
+  for (std::map<uint32_t, ProfileStats>::const_iterator i = m_profileContexts.begin ();
+       i != m_profileContexts.end (); ++i)
+    {
+      contexts.push_back (std::make_pair (i->second.ns, i->first));
+    }
+  std::sort (contexts.begin (), contexts.end (),
+             std::greater<std::pair<uint64_t, uint32_t> > ());
+
+  std::ios_base::fmtflags flags = os.flags ();
+  std::streamsize precision = os.precision ();
+  os << "Event profile: " << count << " events, "
+     << std::fixed << std::setprecision (3) << total / 1e6 << " ms" << std::endl;
+  os << std::setw (12) << "time (ms)" << std::setw (8) << "%"
+     << std::setw (12) << "count" << std::setw (12) << "mean (us)"
+     << std::setw (9) << "fan-out" << "  object / target" << std::endl;
+  for (std::vector<std::pair<uint64_t, const ProfileTarget *> >::const_iterator i = targets.begin ();
+       i != targets.end (); ++i)
+    {
+      const ProfileTarget *target = i->second;
+      PrintProfileStats (os, target->stats.count, target->stats.ns, target->stats.fanOut, total);
+      os << target->object << " / " << target->function << std::endl;
+    }
+  os << std::setw (12) << "time (ms)" << std::setw (8) << "%"
+     << std::setw (12) << "count" << std::setw (12) << "mean (us)"
+     << std::setw (9) << "fan-out" << "  context" << std::endl;
+  for (std::vector<std::pair<uint64_t, uint32_t> >::const_iterator i = contexts.begin ();
+       i != contexts.end (); ++i)
+    {
+      const ProfileStats &stats = m_profileContexts.find (i->second)->second;
+      PrintProfileStats (os, stats.count, stats.ns, stats.fanOut, total);
+      if (i->second == Simulator::NO_CONTEXT)
+        {
+          os << "none" << std::endl;
+        }
+      else
+        {
+          os << i->second << std::endl;
+        }
+    }
+  os.flags (flags);
+  os.precision (precision);
+}
+
+void
+DefaultSimulatorImpl::ResetProfile (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::map<ProfileKey, ProfileTarget>::iterator i = m_profileTargets.begin ();
+       i != m_profileTargets.end (); ++i)
+    {
+      i->second.stats = ProfileStats ();
+    }
+  m_profileContexts.clear ();
+}
+
 bool 
 DefaultSimulatorImpl::IsFinished (void) const
 {
@@ -411,4 +661,10 @@ DefaultSimulatorImpl::GetContext (void) const
   return m_currentContext;
 }
 
+uint64_t
+DefaultSimulatorImpl::GetEventCount (void) const
+{
+  return m_eventCount;
+}
+
 } // namespace ns3
@@ -30,6 +30,10 @@
 #include "ptr.h"
 
 #include <list>
+#include <map>
+#include <string>
+#include <ostream>
+#include <typeinfo>
 
 /**
  * \file
@@ -77,12 +81,35 @@ public:
   virtual void SetScheduler (ObjectFactory schedulerFactory);
   virtual uint32_t GetSystemId (void) const; 
   virtual uint32_t GetContext (void) const;
+  virtual uint64_t GetEventCount (void) const;
+
+  /**
+   * Print the event profile collected so far.
+   *
+   * The profile aggregates the wall-clock time, the number of
+   * invocations and the number of events scheduled (the fan-out)
+   * per event target, i.e., per bound function or class method and
+   * TypeId of the bound object, and per context.  Both tables are
+   * sorted by decreasing wall-clock time.  The profile is empty
+   * unless the EventProfiling attribute is set; it is also printed
+   * to std::clog at Simulator::Destroy.
+   *
+   * \param [in,out] os The output stream.
+   */
+  void PrintProfile (std::ostream &os) const;
+  /** Discard the event profile collected so far. */
+  void ResetProfile (void);
 
 private:
   virtual void DoDispose (void);
 
   /** Process the next event. */
   void ProcessOneEvent (void);
+  /**
+   * Invoke an event and account for it in the event profile.
+   * \param [in] event The event to invoke.
+   */
+  void InvokeProfiled (EventImpl *event);
   /** Move events from a different context into the main event queue. */
   void ProcessEventsWithContext (void);
  
@@ -124,6 +151,8 @@ private:
   uint64_t m_currentTs;
   /** Execution context of the current event. */
   uint32_t m_currentContext;
+  /** The event count. */
+  uint64_t m_eventCount;
   /**
    * Number of events that have been inserted but not yet scheduled,
    *  not counting the Destroy events; this is used for validation
@@ -132,6 +161,49 @@ private:
 
   /** Main execution thread. */
   SystemThread::ThreadId m_main;
+
+  /** Profile key of an event target. */
+  struct ProfileKey
+  {
+    /** The dynamic type of the event. */
+    const std::type_info *type;
+    /** The raw bits of the bound function or class method pointer. */
+    const void *function[2];
+    /** The TypeId uid of the bound object, or 0. */
+    uint16_t tid;
+    /**
+     * Ordering operator.
+     * \param [in] o The other key.
+     * \returns \c true if this key is before \pname{o}.
+     */
+    bool operator < (const ProfileKey &o) const;
+  };
+  /** The statistics of a profile entry. */
+  struct ProfileStats
+  {
+    /** Number of invocations. */
+    uint64_t count;
+    /** Wall-clock time spent in the invocations, in ns. */
+    uint64_t ns;
+    /** Number of events scheduled by the invocations. */
+    uint64_t fanOut;
+  };
+  /** The profile entry of an event target. */
+  struct ProfileTarget
+  {
+    /** The statistics. */
+    ProfileStats stats;
+    /** The TypeId name of the bound object, resolved once. */
+    std::string object;
+    /** The name of the bound function, resolved once. */
+    std::string function;
+  };
+  /** Enable the event profiling. */
+  bool m_profiling;
+  /** The event profile per target. */
+  std::map<ProfileKey, ProfileTarget> m_profileTargets;
+  /** The event profile per context. */
+  std::map<uint32_t, ProfileStats> m_profileContexts;
 };
 
 } // namespace ns3
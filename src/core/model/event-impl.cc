@@ -66,4 +66,9 @@ EventImpl::IsCancelled (void)
   return m_cancel;
 }
 
+void
+EventImpl::GetTarget (Target &target)
+{
+}
+
 } // namespace ns3
@@ -31,6 +31,8 @@
 
 namespace ns3 {
 
+class ObjectBase;
+
 /**
  * \ingroup events
  * \brief A simulation event.
@@ -66,6 +68,27 @@ public:
    */
   bool IsCancelled (void);
 
+  /**
+   * The function and object bound to an event, as seen by the
+   * simulator event profiling.
+   */
+  struct Target
+  {
+    /** The raw bits of the bound function or class method pointer. */
+    const void *function[2];
+    /** The bound object, if it is an ObjectBase, or 0. */
+    const ObjectBase *object;
+  };
+  /**
+   * Identify the function and object bound to this event.
+   *
+   * The fields of \pname{target} are expected to be zeroed by the
+   * caller; this default implementation leaves them untouched.
+   *
+   * \param [out] target The event target.
+   */
+  virtual void GetTarget (Target &target);
+
 protected:
   /**
    * Implementation for Invoke().
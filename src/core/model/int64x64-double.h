@@ -52,9 +52,10 @@ class int64x64_t
    * We could make this a static and initialize in int64x64-double.cc or
    * int64x64.cc, but this requires handling static initialization order
    * when most of the implementation is inline.  Instead, we resort to
-   * this define.
+   * this define, spelled as a literal so that unoptimized builds don't
+   * call pow () on every conversion.
    */
-#define HP_MAX_64    (std::pow (2.0L, 64))
+#define HP_MAX_64    (18446744073709551616.0L)
 
 public:
   /**
@@ -0,0 +1,298 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <pthread.h>
+#include <cstdlib>    // for atexit
+#include <iostream>
+#include <list>
+#include <streambuf>
+#include <string>
+
+#include "log-async-sink.h"
+#include "fatal-impl.h"
+
+/**
+ * \file
+ * \ingroup logging
+ * ns3::LogEnableAsyncSink() and ns3::LogDisableAsyncSink() implementations.
+ *
+ * \note The sink uses pthreads directly and does no logging itself:
+ * the SystemMutex and SystemCondition classes log their calls, which
+ * would write back into the sink while it holds its lock.
+ */
+
+namespace ns3 {
+
+namespace {
+
+/**
+ * \ingroup logging
+ * A stream buffer which collects its output in blocks, and writes
+ * the blocks to another stream buffer from a background thread.
+ */
+class AsyncLogBuffer : public std::streambuf
+{
+public:
+  /**
+   * Constructor: start the background thread.
+   * \param [in] sink The stream buffer to write to.
+   */
+  AsyncLogBuffer (std::streambuf *sink);
+  /** Destructor: write the pending output and stop the background thread. */
+  virtual ~AsyncLogBuffer ();
+  /** Write the pending output, and wait until it is written. */
+  void Drain (void);
+
+protected:
+  virtual int overflow (int c);
+  virtual std::streamsize xsputn (const char *s, std::streamsize n);
+  virtual int sync (void);
+
+private:
+  /**
+   * Entry point of the background thread.
+   * \param [in] self The AsyncLogBuffer.
+   * \return 0.
+   */
+  static void * Run (void *self);
+  /** Write the queued blocks, until the buffer is stopped. */
+  void Write (void);
+  /** Queue the current block; the mutex must be held. */
+  void Push (void);
+
+  /** The size above which a block is queued. */
+  static const std::string::size_type BLOCK_SIZE = 64 * 1024;
+
+  std::streambuf *m_sink;         //!< The stream buffer to write to.
+  std::string m_block;            //!< The block being filled.
+  std::list<std::string> m_queue; //!< The blocks to write.
+  bool m_writing;                 //!< A block is being written.
+  bool m_stop;                    //!< Stop the background thread.
+  pthread_mutex_t m_mutex;        //!< Protects all of the above.
+  pthread_cond_t m_queued;        //!< Signaled when a block is queued.
+  pthread_cond_t m_written;       //!< Signaled when a block is written.
+  pthread_t m_thread;             //!< The background thread.
+};
+
+AsyncLogBuffer::AsyncLogBuffer (std::streambuf *sink)
+  : m_sink (sink),
+    m_writing (false),
+    m_stop (false)
+{
+  m_block.reserve (BLOCK_SIZE);
+  pthread_mutex_init (&m_mutex, 0);
+  pthread_cond_init (&m_queued, 0);
+  pthread_cond_init (&m_written, 0);
+  pthread_create (&m_thread, 0, &AsyncLogBuffer::Run, this);
+}
+
+AsyncLogBuffer::~AsyncLogBuffer ()
+{
+  pthread_mutex_lock (&m_mutex);
+  Push ();
+  m_stop = true;
+  pthread_cond_signal (&m_queued);
+  pthread_mutex_unlock (&m_mutex);
+  pthread_join (m_thread, 0);
+  pthread_cond_destroy (&m_written);
+  pthread_cond_destroy (&m_queued);
+  pthread_mutex_destroy (&m_mutex);
+}
+
+void
+AsyncLogBuffer::Drain (void)
+{
+  pthread_mutex_lock (&m_mutex);
+  Push ();
+  while (!m_queue.empty () || m_writing)
+    {
+      pthread_cond_wait (&m_written, &m_mutex);
+    }
+  pthread_mutex_unlock (&m_mutex);
+}
+
+int
+AsyncLogBuffer::overflow (int c)
+{
+  if (c != traits_type::eof ())
+    {
+      pthread_mutex_lock (&m_mutex);
+      m_block.push_back (traits_type::to_char_type (c));
+      pthread_mutex_unlock (&m_mutex);
+    }
+  return traits_type::not_eof (c);
+}
+
+std::streamsize
+AsyncLogBuffer::xsputn (const char *s, std::streamsize n)
+{
+  pthread_mutex_lock (&m_mutex);
+  m_block.append (s, n);
+  pthread_mutex_unlock (&m_mutex);
+  return n;
+}
+
+int
+AsyncLogBuffer::sync (void)
+{
+  // std::endl flushes every log line: only queue large blocks,
+  // the others are written by Drain.
+  pthread_mutex_lock (&m_mutex);
+  if (m_block.size () >= BLOCK_SIZE)
+    {
+      Push ();
+    }
+  pthread_mutex_unlock (&m_mutex);
+  return 0;
+}
+
+void *
+AsyncLogBuffer::Run (void *self)
+{
+  static_cast<AsyncLogBuffer *> (self)->Write ();
+  return 0;
+}
+
+void
+AsyncLogBuffer::Write (void)
+{
+  pthread_mutex_lock (&m_mutex);
+  while (true)
+    {
+      while (m_queue.empty () && !m_stop)
+        {
+          pthread_cond_wait (&m_queued, &m_mutex);
+        }
+      if (m_queue.empty ())
+        {
+          break;
+        }
+      std::string block;
+      block.swap (m_queue.front ());
+      m_queue.pop_front ();
+      m_writing = true;
+      pthread_mutex_unlock (&m_mutex);
+
+      m_sink->sputn (block.data (), block.size ());
+      m_sink->pubsync ();
+
+      pthread_mutex_lock (&m_mutex);
+      m_writing = false;
+      pthread_cond_broadcast (&m_written);
+    }
+  pthread_mutex_unlock (&m_mutex);
+}
+
+void
+AsyncLogBuffer::Push (void)
+{
+  if (m_block.empty ())
+    {
+      return;
+    }
+  m_queue.push_back (std::string ());
+  m_queue.back ().swap (m_block);
+  m_block.reserve (BLOCK_SIZE);
+  pthread_cond_signal (&m_queued);
+}
+
+/**
+ * \ingroup logging
+ * A stream buffer which drains the AsyncLogBuffer when it is flushed,
+ * registered with FatalImpl::RegisterStream() to keep the last
+ * log lines before a fatal error.
+ */
+class AsyncLogDrain : public std::streambuf
+{
+public:
+  /**
+   * Constructor.
+   * \param [in] buffer The AsyncLogBuffer to drain.
+   */
+  AsyncLogDrain (AsyncLogBuffer *buffer)
+    : m_buffer (buffer)
+  {}
+
+protected:
+  virtual int sync (void)
+  {
+    m_buffer->Drain ();
+    return 0;
+  }
+
+private:
+  AsyncLogBuffer *m_buffer;   //!< The AsyncLogBuffer to drain.
+};
+
+/** The stream buffer of \c std::clog before the sink was enabled. */
+std::streambuf *g_syncLogBuffer = 0;
+/** The sink, while it is enabled. */
+AsyncLogBuffer *g_asyncLogBuffer = 0;
+/** The buffer of g_asyncLogDrainStream. */
+AsyncLogDrain *g_asyncLogDrain = 0;
+/** The stream registered with FatalImpl::RegisterStream(). */
+std::ostream *g_asyncLogDrainStream = 0;
+
+/** Disable the sink at the exit of the program. */
+void
+AsyncLogSinkAtExit (void)
+{
+  LogDisableAsyncSink ();
+}
+
+}  // unnamed namespace
+
+void
+LogEnableAsyncSink (void)
+{
+  if (g_asyncLogBuffer != 0)
+    {
+      return;
+    }
+  static bool atExit = false;
+  if (!atExit)
+    {
+      std::atexit (&AsyncLogSinkAtExit);
+      atExit = true;
+    }
+  std::clog.flush ();
+  g_syncLogBuffer = std::clog.rdbuf ();
+  g_asyncLogBuffer = new AsyncLogBuffer (g_syncLogBuffer);
+  g_asyncLogDrain = new AsyncLogDrain (g_asyncLogBuffer);
+  g_asyncLogDrainStream = new std::ostream (g_asyncLogDrain);
+  FatalImpl::RegisterStream (g_asyncLogDrainStream);
+  std::clog.rdbuf (g_asyncLogBuffer);
+}
+
+void
+LogDisableAsyncSink (void)
+{
+  if (g_asyncLogBuffer == 0)
+    {
+      return;
+    }
+  std::clog.rdbuf (g_syncLogBuffer);
+  FatalImpl::UnregisterStream (g_asyncLogDrainStream);
+  delete g_asyncLogDrainStream;
+  delete g_asyncLogDrain;
+  delete g_asyncLogBuffer;
+  g_asyncLogDrainStream = 0;
+  g_asyncLogDrain = 0;
+  g_asyncLogBuffer = 0;
+  g_syncLogBuffer = 0;
+}
+
+} // namespace ns3
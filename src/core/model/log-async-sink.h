@@ -0,0 +1,59 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_LOG_ASYNC_SINK_H
+#define NS3_LOG_ASYNC_SINK_H
+
+/**
+ * \file
+ * \ingroup logging
+ * ns3::LogEnableAsyncSink() and ns3::LogDisableAsyncSink() declarations.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup logging
+ *
+ * Write the log output from a background thread.
+ *
+ * The output of the logging macros, which goes to \c std::clog, is
+ * collected in large blocks, and a background thread writes the
+ * blocks to the previous destination of \c std::clog.  The simulation
+ * no longer waits for the output of every log line, which makes long
+ * runs with logging enabled much faster.
+ *
+ * The pending output is written when the sink is disabled, at the
+ * exit of the program and on fatal errors, after the error message;
+ * however, it is lost if the program crashes.
+ *
+ * Calling this function when the sink is already enabled has no effect.
+ */
+void LogEnableAsyncSink (void);
+
+/**
+ * \ingroup logging
+ *
+ * Write the pending log output and restore the synchronous output
+ * of \c std::clog.
+ *
+ * Calling this function when the sink is not enabled has no effect.
+ */
+void LogDisableAsyncSink (void);
+
+} // namespace ns3
+
+#endif /* NS3_LOG_ASYNC_SINK_H */
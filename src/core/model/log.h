@@ -443,6 +443,23 @@ private:
 
 };  // class LogComponent
 
+/*
+ * The logging macros check the LogComponent on every use, even when
+ * nothing is logged: keep these checks inline.
+ */
+
+inline bool
+LogComponent::IsEnabled (const enum LogLevel level) const
+{
+  return (level & m_levels) ? 1 : 0;
+}
+
+inline bool
+LogComponent::IsNoneEnabled (void) const
+{
+  return m_levels == 0;
+}
+
 /**
  * Get the LogComponent registered with the given name.
  *
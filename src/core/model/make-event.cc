@@ -52,6 +52,10 @@ protected:
     {
       (*m_function)();
     }
+    virtual void GetTarget (Target &target)
+    {
+      EventTargetFunction (target, m_function);
+    }
 private:
     F m_function;
   } *ev = new EventFunctionImpl0 (f);
@@ -316,6 +316,7 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5,U6), T1 a1, T2 a2, T3 a3, T4 a4,
 
 #include "event-impl.h"
 #include "type-traits.h"
+#include <cstring>
 
 namespace ns3 {
 
@@ -355,6 +356,52 @@ struct EventMemberImplObjTraits<T *>
   }
 };
 
+/**
+ * \ingroup makeeventmemptr
+ * Helper for the event profiling: store the bits of a function or
+ * class method pointer in an EventImpl::Target.
+ *
+ * \tparam F \deduced The function or class method pointer type.
+ * \param [out] target The event target.
+ * \param [in] function The function or class method pointer.
+ */
+template <typename F>
+void
+EventTargetFunction (EventImpl::Target &target, F function)
+{
+  std::memcpy (target.function, &function,
+               sizeof (F) < sizeof (target.function) ? sizeof (F) : sizeof (target.function));
+}
+
+/**
+ * \ingroup makeeventmemptr
+ * Helper for the event profiling: get the object bound to an event,
+ * if it is an ObjectBase.
+ *
+ * \param [in] obj The bound object.
+ * \returns The bound object.
+ */
+inline const ObjectBase *
+EventTargetObject (const ObjectBase *obj)
+{
+  return obj;
+}
+
+/**
+ * \ingroup makeeventmemptr
+ * \copybrief EventTargetObject(const ObjectBase*)
+ *
+ * This overload is selected for the objects which are not an ObjectBase.
+ *
+ * \param [in] obj The bound object.
+ * \returns 0.
+ */
+inline const ObjectBase *
+EventTargetObject (const void *obj)
+{
+  return 0;
+}
+
 template <typename MEM, typename OBJ>
 EventImpl * MakeEvent (MEM mem_ptr, OBJ obj)
 {
@@ -375,6 +422,11 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)();
     }
+    virtual void GetTarget (Target &target)
+    {
+      EventTargetFunction (target, m_function);
+      target.object = EventTargetObject (&EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
   } *ev = new EventMemberImpl0 (obj, mem_ptr);
@@ -405,6 +457,11 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1);
     }
+    virtual void GetTarget (Target &target)
+    {
+      EventTargetFunction (target, m_function);
+      target.object = EventTargetObject (&EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -436,6 +493,11 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2);
     }
+    virtual void GetTarget (Target &target)
+    {
+      EventTargetFunction (target, m_function);
+      target.object = EventTargetObject (&EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -469,6 +531,11 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3);
     }
+    virtual void GetTarget (Target &target)
+    {
+      EventTargetFunction (target, m_function);
+      target.object = EventTargetObject (&EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -504,6 +571,11 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4);
     }
+    virtual void GetTarget (Target &target)
+    {
+      EventTargetFunction (target, m_function);
+      target.object = EventTargetObject (&EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -542,6 +614,11 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
     }
+    virtual void GetTarget (Target &target)
+    {
+      EventTargetFunction (target, m_function);
+      target.object = EventTargetObject (&EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -582,6 +659,11 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
     }
+    virtual void GetTarget (Target &target)
+    {
+      EventTargetFunction (target, m_function);
+      target.object = EventTargetObject (&EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -617,6 +699,10 @@ private:
     {
       (*m_function)(m_a1);
     }
+    virtual void GetTarget (Target &target)
+    {
+      EventTargetFunction (target, m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
   } *ev = new EventFunctionImpl1 (f, a1);
@@ -647,6 +733,10 @@ private:
     {
       (*m_function)(m_a1, m_a2);
     }
+    virtual void GetTarget (Target &target)
+    {
+      EventTargetFunction (target, m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -680,6 +770,10 @@ private:
     {
       (*m_function)(m_a1, m_a2, m_a3);
     }
+    virtual void GetTarget (Target &target)
+    {
+      EventTargetFunction (target, m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -715,6 +809,10 @@ private:
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4);
     }
+    virtual void GetTarget (Target &target)
+    {
+      EventTargetFunction (target, m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -752,6 +850,10 @@ private:
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
     }
+    virtual void GetTarget (Target &target)
+    {
+      EventTargetFunction (target, m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -791,6 +893,10 @@ private:
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
     }
+    virtual void GetTarget (Target &target)
+    {
+      EventTargetFunction (target, m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -455,6 +455,13 @@ public:
   }
   inline static Time FromDouble (double value, enum Unit unit)
   {
+    struct Information *info = PeekInformation (unit);
+    int64_t v;
+    if (info->exact && info->fromMul
+        && FromDoubleExact (value, info->dfactor, v))
+      {
+        return Time (v);
+      }
     return From (int64x64_t (value), unit);
   }
   inline static Time From (const int64x64_t & value, enum Unit unit)
@@ -504,6 +511,21 @@ public:
   }
   inline double ToDouble (enum Unit unit) const
   {
+    struct Information *info = PeekInformation (unit);
+    if (info->exact)
+      {
+        if (info->toMul)
+          {
+            if (m_data <= info->maxTo && m_data >= -info->maxTo)
+              {
+                return static_cast<double> (m_data * info->factor);
+              }
+          }
+        else if (m_data % info->factor == 0)
+          {
+            return static_cast<double> (m_data / info->factor);
+          }
+      }
     return To (unit).GetDouble ();
   }
   inline int64x64_t To (enum Unit unit) const
@@ -554,6 +576,9 @@ private:
     int64_t factor;                 //!< Ratio of this unit / current unit
     int64x64_t timeTo;              //!< Multiplier to convert to this unit
     int64x64_t timeFrom;            //!< Multiplier to convert from this unit
+    double dfactor;                 //!< factor, as a double
+    int64_t maxTo;                  //!< Largest magnitude converted To by multiplication without overflow
+    bool exact;                     //!< Whether the 64-bit paths give the same results as int64x64_t
   };
   /** Current time unit, and conversion info. */
   struct Resolution
@@ -583,6 +608,63 @@ private:
     return & (PeekResolution ()->info[timeUnit]);
   }
 
+  /**
+   *  Convert \p value, in a unit larger than the current resolution,
+   *  with 64-bit arithmetic and the same result as
+   *  From (int64x64_t (value), unit).
+   *
+   *  Like the int64x64_t conversion, the magnitude of \p value is
+   *  rounded half up to 64 fractional bits; the product with \p factor
+   *  is then floored, towards negative infinity.  The double product is
+   *  only an estimate of the exact one, but the two can only straddle an
+   *  integer when the estimate is itself an integer: the sign of the
+   *  exact remainder, from a fused multiply-add, settles that case.
+   *
+   *  \param [in] value The value to convert.
+   *  \param [in] factor The ratio of its unit to the current unit.
+   *  \param [out] result The converted value, in the current unit.
+   *  \return \c true if the value was converted, \c false if the result
+   *    would not be exact in a double, or \p value is not finite.
+   */
+  static inline bool FromDoubleExact (double value, double factor, int64_t & result)
+  {
+    static const double TWO_52 = 4503599627370496.0;
+    static const double TWO_64 = 18446744073709551616.0;
+    const bool negative = value < 0;
+    const double scaled = (negative ? -value : value) * TWO_64;
+    double fixed = std::floor (scaled);
+    if (scaled - fixed >= 0.5)
+      {
+        fixed += 1;
+      }
+    const double estimate = fixed * factor / TWO_64;
+    // also rejects NaN and infinities
+    if (!(estimate < TWO_52))
+      {
+        return false;
+      }
+    double rounded;
+    if (negative)
+      {
+        rounded = std::ceil (estimate);
+        if (rounded == estimate && std::fma (fixed, factor, -rounded * TWO_64) > 0)
+          {
+            rounded += 1;
+          }
+        result = -static_cast<int64_t> (rounded);
+      }
+    else
+      {
+        rounded = std::floor (estimate);
+        if (rounded == estimate && std::fma (fixed, factor, -rounded * TWO_64) < 0)
+          {
+            rounded -= 1;
+          }
+        result = static_cast<int64_t> (rounded);
+      }
+    return true;
+  }
+
   /**
    *  Set the default resolution
    *
@@ -127,6 +127,35 @@ ObjectPtrContainerAccessor::Get (const ObjectBase * object, AttributeValue &valu
     }
   return true;
 }
+Ptr<Object>
+ObjectPtrContainerAccessor::Find (const ObjectBase *object, std::size_t index) const
+{
+  NS_LOG_FUNCTION (this << object << index);
+  std::size_t n;
+  if (!DoGetN (object, &n))
+    {
+      return 0;
+    }
+  // the instances of a vector are stored at their index
+  std::size_t found;
+  if (index < n)
+    {
+      Ptr<Object> o = DoGet (object, index, &found);
+      if (found == index)
+        {
+          return o;
+        }
+    }
+  for (std::size_t i = 0; i < n; i++)
+    {
+      Ptr<Object> o = DoGet (object, i, &found);
+      if (found == index)
+        {
+          return o;
+        }
+    }
+  return 0;
+}
 bool 
 ObjectPtrContainerAccessor::HasGetter (void) const
 {
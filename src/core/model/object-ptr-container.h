@@ -220,6 +220,15 @@ public:
   virtual bool Get (const ObjectBase * object, AttributeValue &value) const;
   virtual bool HasGetter (void) const;
   virtual bool HasSetter (void) const;
+  /**
+   * Find the instance with a given index in the container, without
+   * building the complete ObjectPtrContainerValue.
+   *
+   * \param [in] object The container object.
+   * \param [in] index The index of the instance.
+   * \returns The instance, or 0 if there is no instance with this index.
+   */
+  Ptr<Object> Find (const ObjectBase *object, std::size_t index) const;
 private:
   /**
    * Get the number of instances in the container.
@@ -97,11 +97,10 @@ Object::Object ()
   : m_tid (Object::GetTypeId ()),
     m_disposed (false),
     m_initialized (false),
-    m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates))),
+    m_aggregates (CreateAggregates (1)),
     m_getObjectCount (0)
 {
   NS_LOG_FUNCTION (this);
-  m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
 }
 Object::~Object () 
@@ -121,10 +120,16 @@ Object::~Object ()
         }
     }
   // finally, if all objects have been removed from the list,
-  // delete the aggregate list
+  // delete the aggregate list. Otherwise, drop the lookups which
+  // could have found this object.
   if (m_aggregates->n == 0)
     {
-      std::free (m_aggregates);
+      DeleteAggregates (m_aggregates);
+    }
+  else
+    {
+      std::free (m_aggregates->cache);
+      m_aggregates->cache = 0;
     }
   m_aggregates = 0;
 }
@@ -132,12 +137,28 @@ Object::Object (const Object &o)
   : m_tid (o.m_tid),
     m_disposed (false),
     m_initialized (false),
-    m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates))),
+    m_aggregates (CreateAggregates (1)),
     m_getObjectCount (0)
 {
-  m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
 }
+struct Object::Aggregates *
+Object::CreateAggregates (uint32_t n)
+{
+  NS_LOG_FUNCTION (n);
+  struct Aggregates *aggregates = 
+    (struct Aggregates *)std::malloc (sizeof (struct Aggregates)+(n-1)*sizeof (Object*));
+  aggregates->n = n;
+  aggregates->cache = 0;
+  return aggregates;
+}
+void
+Object::DeleteAggregates (struct Aggregates *aggregates)
+{
+  NS_LOG_FUNCTION (aggregates);
+  std::free (aggregates->cache);
+  std::free (aggregates);
+}
 void
 Object::Construct (const AttributeConstructionList &attributes)
 {
@@ -151,8 +172,18 @@ Object::DoGetObject (TypeId tid) const
   NS_LOG_FUNCTION (this << tid);
   NS_ASSERT (CheckLoose ());
 
+  // first, look for a previous lookup of the same TypeId.
+  struct LookupCache *cache = m_aggregates->cache;
+  uint16_t uid = tid.GetUid ();
+  uint16_t slot = uid & (LookupCache::SIZE - 1);
+  if (cache != 0 && cache->uid[slot] == uid)
+    {
+      return cache->object[slot];
+    }
+
   uint32_t n = m_aggregates->n;
   TypeId objectTid = Object::GetTypeId ();
+  Object *found = 0;
   for (uint32_t i = 0; i < n; i++)
     {
       Object *current = m_aggregates->buffer[i];
@@ -173,11 +204,23 @@ Object::DoGetObject (TypeId tid) const
           current->m_getObjectCount++;
           // then, update the sort
           UpdateSortedArray (m_aggregates, i);
-          // finally, return the match
-          return const_cast<Object *> (current);
+          found = current;
+          break;
+        }
+    }
+  // finally, remember the result: a lone object is checked as fast
+  // as a cache entry, so it does not get one.
+  if (n > 1)
+    {
+      if (cache == 0)
+        {
+          cache = (struct LookupCache *)std::calloc (1, sizeof (struct LookupCache));
+          m_aggregates->cache = cache;
         }
+      cache->uid[slot] = uid;
+      cache->object[slot] = found;
     }
-  return 0;
+  return found;
 }
 void
 Object::Initialize (void)
@@ -260,9 +303,7 @@ Object::AggregateObject (Ptr<Object> o)
   Object *other = PeekPointer (o);
   // first create the new aggregate buffer.
   uint32_t total = m_aggregates->n + other->m_aggregates->n;
-  struct Aggregates *aggregates = 
-    (struct Aggregates *)std::malloc (sizeof(struct Aggregates)+(total-1)*sizeof(Object*));
-  aggregates->n = total;
+  struct Aggregates *aggregates = CreateAggregates (total);
 
   // copy our buffer to the new buffer
   std::memcpy (&aggregates->buffer[0], 
@@ -314,8 +355,8 @@ Object::AggregateObject (Ptr<Object> o)
     }
 
   // Now that we are done with them, we can free our old aggregate buffers
-  std::free (a);
-  std::free (b);
+  DeleteAggregates (a);
+  DeleteAggregates (b);
 }
 /**
  * This function must be implemented in the stack that needs to notify
@@ -320,6 +320,24 @@ private:
   friend class AggregateIterator;
   friend struct ObjectDeleter;
 
+  /**
+   * A direct-mapped cache of the results of DoGetObject(), indexed
+   * by the uid of the TypeId looked up.
+   *
+   * It is shared by all aggregated Objects, as the Aggregates are,
+   * and holds the failed lookups too.  The cache is dropped
+   * whenever an Object leaves the aggregate, and a new aggregate
+   * starts with an empty cache.
+   */
+  struct LookupCache {
+    /** The number of entries, a power of two. */
+    static const uint16_t SIZE = 32;
+    /** The uid of the TypeId of each entry, 0 if the entry is empty. */
+    uint16_t uid[SIZE];
+    /** The Object found for each entry, 0 if none was found. */
+    Object *object[SIZE];
+  };
+
   /**
    * The list of Objects aggregated to this one.
    *
@@ -335,10 +353,26 @@ private:
   struct Aggregates {
     /** The number of entries in \c buffer. */
     uint32_t n;
+    /** The cache of the GetObject() lookups, allocated on demand. */
+    struct LookupCache *cache;
     /** The array of Objects. */
     Object *buffer[1];
   };
 
+  /**
+   * Create a list of aggregated Objects.
+   *
+   * \param [in] n The number of Objects in the list.
+   * \return The list, with an empty cache.
+   */
+  static struct Aggregates * CreateAggregates (uint32_t n);
+  /**
+   * Delete a list of aggregated Objects, and its cache.
+   *
+   * \param [in] aggregates The list to delete.
+   */
+  static void DeleteAggregates (struct Aggregates *aggregates);
+
   /**
    * Find an Object of TypeId tid in the aggregates of this Object.
    *
@@ -34,6 +34,7 @@
 #include "rng-stream.h"
 #include "rng-seed-manager.h"
 #include "unused.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -47,6 +48,13 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("RandomVariableStream");
 
+/**
+ * \ingroup randomvariable
+ * The number of values drawn at once by the batches which need an
+ * intermediate array.
+ */
+static const std::size_t BATCH_SIZE = 64;
+
 NS_OBJECT_ENSURE_REGISTERED (RandomVariableStream);
 
 TypeId 
@@ -138,6 +146,25 @@ RandomVariableStream::Peek(void) const
   return m_rng;
 }
 
+void
+RandomVariableStream::GetValues (double *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  for (std::size_t i = 0; i < n; i++)
+    {
+      values[i] = GetValue ();
+    }
+}
+void
+RandomVariableStream::GetIntegers (uint32_t *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  for (std::size_t i = 0; i < n; i++)
+    {
+      values[i] = GetInteger ();
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(UniformRandomVariable);
 
 TypeId 
@@ -209,6 +236,43 @@ UniformRandomVariable::GetInteger (void)
   return (uint32_t)GetValue (m_min, m_max + 1);
 }
 
+void
+UniformRandomVariable::GetValues (double min, double max, double *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << min << max << values << n);
+  Peek ()->RandU01 (values, n);
+  for (std::size_t i = 0; i < n; i++)
+    {
+      double v = min + values[i] * (max - min);
+      if (IsAntithetic ())
+        {
+          v = min + (max - v);
+        }
+      values[i] = v;
+    }
+}
+void
+UniformRandomVariable::GetValues (double *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  GetValues (m_min, m_max, values, n);
+}
+void
+UniformRandomVariable::GetIntegers (uint32_t *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  double batch[BATCH_SIZE];
+  for (std::size_t i = 0; i < n; i += BATCH_SIZE)
+    {
+      std::size_t m = std::min (n - i, BATCH_SIZE);
+      GetValues (m_min, m_max + 1, batch, m);
+      for (std::size_t j = 0; j < m; j++)
+        {
+          values[i + j] = (uint32_t)batch[j];
+        }
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(ConstantRandomVariable);
 
 TypeId 
@@ -446,6 +510,49 @@ ExponentialRandomVariable::GetInteger (void)
   return (uint32_t)GetValue (m_mean, m_bound);
 }
 
+void
+ExponentialRandomVariable::GetValues (double *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  // Draw the uniforms of all the missing values, and keep the ones
+  // within the bound in order: this returns the same values as
+  // drawing them one at a time, without drawing any extra uniform.
+  std::size_t filled = 0;
+  while (filled < n)
+    {
+      std::size_t drawn = n - filled;
+      Peek ()->RandU01 (values + filled, drawn);
+      for (std::size_t i = filled, end = filled + drawn; i < end; i++)
+        {
+          double v = values[i];
+          if (IsAntithetic ())
+            {
+              v = (1 - v);
+            }
+          double r = -m_mean*std::log (v);
+          if (m_bound == 0 || r <= m_bound)
+            {
+              values[filled++] = r;
+            }
+        }
+    }
+}
+void
+ExponentialRandomVariable::GetIntegers (uint32_t *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  double batch[BATCH_SIZE];
+  for (std::size_t i = 0; i < n; i += BATCH_SIZE)
+    {
+      std::size_t m = std::min (n - i, BATCH_SIZE);
+      GetValues (batch, m);
+      for (std::size_t j = 0; j < m; j++)
+        {
+          values[i + j] = (uint32_t)batch[j];
+        }
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(ParetoRandomVariable);
 
 TypeId 
@@ -779,6 +886,80 @@ NormalRandomVariable::GetInteger (void)
   return (uint32_t)GetValue (m_mean, m_variance, m_bound);
 }
 
+void
+NormalRandomVariable::GetValues (double *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  std::size_t filled = 0;
+  if (n > 0 && m_nextValid)
+    { // use previously generated
+      m_nextValid = false;
+      values[filled++] = m_next;
+    }
+  double u[2 * BATCH_SIZE];
+  while (filled < n)
+    {
+      // Each pair of uniforms gives at most two values so, with one
+      // pair per two missing values, only the last pair of the batch
+      // can complete the array, and its second value is kept for later
+      // as GetValue (void) does: no extra uniform is drawn.
+      std::size_t pairs = std::min ((n - filled + 1) / 2, BATCH_SIZE);
+      Peek ()->RandU01 (u, 2 * pairs);
+      for (std::size_t i = 0; i < pairs; i++)
+        {
+          double u1 = u[2 * i];
+          double u2 = u[2 * i + 1];
+          if (IsAntithetic ())
+            {
+              u1 = (1 - u1);
+              u2 = (1 - u2);
+            }
+          double v1 = 2 * u1 - 1;
+          double v2 = 2 * u2 - 1;
+          double w = v1 * v1 + v2 * v2;
+          if (w <= 1.0)
+            {
+              double y = std::sqrt ((-2 * std::log (w)) / w);
+              double x2 = m_mean + v2 * y * std::sqrt (m_variance);
+              bool x2Valid = std::fabs (x2 - m_mean) <= m_bound;
+              double x1 = m_mean + v1 * y * std::sqrt (m_variance);
+              if (std::fabs (x1 - m_mean) <= m_bound)
+                {
+                  values[filled++] = x1;
+                  if (x2Valid && filled == n)
+                    {
+                      m_next = x2;
+                      m_nextValid = true;
+                    }
+                  else if (x2Valid)
+                    {
+                      values[filled++] = x2;
+                    }
+                }
+              else if (x2Valid)
+                {
+                  values[filled++] = x2;
+                }
+            }
+        }
+    }
+}
+void
+NormalRandomVariable::GetIntegers (uint32_t *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  double batch[BATCH_SIZE];
+  for (std::size_t i = 0; i < n; i += BATCH_SIZE)
+    {
+      std::size_t m = std::min (n - i, BATCH_SIZE);
+      GetValues (batch, m);
+      for (std::size_t j = 0; j < m; j++)
+        {
+          values[i + j] = (uint32_t)batch[j];
+        }
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(LogNormalRandomVariable);
 
 TypeId 
@@ -29,6 +29,7 @@
 #include "type-id.h"
 #include "object.h"
 #include "attribute-helper.h"
+#include <cstddef>
 #include <stdint.h>
 
 /**
@@ -149,6 +150,30 @@ public:
    */
   virtual uint32_t GetInteger (void) = 0;
 
+  /**
+   * \brief Get the next random values as doubles drawn from the distribution.
+   *
+   * The values are the same as those returned by \p n calls to
+   * GetValue(void).  The default implementation makes these calls;
+   * subclasses which can draw their values in bulk override it.
+   *
+   * \param [out] values The array of \p n random values.
+   * \param [in] n The number of random values.
+   */
+  virtual void GetValues (double *values, std::size_t n);
+
+  /**
+   * \brief Get the next random values as integers drawn from the distribution.
+   *
+   * The values are the same as those returned by \p n calls to
+   * GetInteger(void).  The default implementation makes these calls;
+   * subclasses which can draw their values in bulk override it.
+   *
+   * \param [out] values The array of \p n random values.
+   * \param [in] n The number of random values.
+   */
+  virtual void GetIntegers (uint32_t *values, std::size_t n);
+
 protected:
   /**
    * \brief Get the pointer to the underlying RngStream.
@@ -294,8 +319,21 @@ public:
    * \note The upper limit is included in the output range.
    */
   virtual uint32_t GetInteger (void);
+  virtual void GetValues (double *values, std::size_t n);
+  virtual void GetIntegers (uint32_t *values, std::size_t n);
   
 private:
+  /**
+   * \brief Get the next random values, as doubles in the specified range
+   * \f$[min, max)\f$.
+   *
+   * \param [in] min Low end of the range (included).
+   * \param [in] max High end of the range (excluded).
+   * \param [out] values The array of \p n random values.
+   * \param [in] n The number of random values.
+   */
+  void GetValues (double min, double max, double *values, std::size_t n);
+
   /** The lower bound on values that can be returned by this RNG stream. */
   double m_min;
 
@@ -586,6 +624,8 @@ public:
   // Inherited from RandomVariableStream
   virtual double GetValue (void);
   virtual uint32_t GetInteger (void);
+  virtual void GetValues (double *values, std::size_t n);
+  virtual void GetIntegers (uint32_t *values, std::size_t n);
 
 private:
   /** The mean value of the unbounded exponential distribution. */
@@ -1234,6 +1274,10 @@ public:
    */
   virtual uint32_t GetInteger (void);
 
+  // Inherited from RandomVariableStream
+  virtual void GetValues (double *values, std::size_t n);
+  virtual void GetIntegers (uint32_t *values, std::size_t n);
+
 private:
   /** The mean value for the normal distribution returned by this RNG stream. */
   double m_mean;
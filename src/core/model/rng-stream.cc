@@ -360,6 +360,47 @@ double RngStream::RandU01 ()
   return u;
 }
 
+void RngStream::RandU01 (double *values, std::size_t n)
+{
+  // The recurrence of RandU01 (void), with the state held in local
+  // variables rather than reloaded from memory for every number: the
+  // two components do not depend on each other, so their computations
+  // can overlap.
+  double s10 = m_currentState[0], s11 = m_currentState[1], s12 = m_currentState[2];
+  double s20 = m_currentState[3], s21 = m_currentState[4], s22 = m_currentState[5];
+
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      int32_t k;
+
+      /* Component 1 */
+      double p1 = a12 * s11 - a13n * s10;
+      k = static_cast<int32_t> (p1 / m1);
+      p1 -= k * m1;
+      if (p1 < 0.0)
+        {
+          p1 += m1;
+        }
+      s10 = s11; s11 = s12; s12 = p1;
+
+      /* Component 2 */
+      double p2 = a21 * s22 - a23n * s20;
+      k = static_cast<int32_t> (p2 / m2);
+      p2 -= k * m2;
+      if (p2 < 0.0)
+        {
+          p2 += m2;
+        }
+      s20 = s21; s21 = s22; s22 = p2;
+
+      /* Combination */
+      values[i] = ((p1 > p2) ? (p1 - p2) * norm : (p1 - p2 + m1) * norm);
+    }
+
+  m_currentState[0] = s10; m_currentState[1] = s11; m_currentState[2] = s12;
+  m_currentState[3] = s20; m_currentState[4] = s21; m_currentState[5] = s22;
+}
+
 RngStream::RngStream (uint32_t seedNumber, uint64_t stream, uint64_t substream)
 {
   if (seedNumber >= m1 || seedNumber >= m2 || seedNumber == 0)
@@ -20,6 +20,7 @@
 #ifndef RNGSTREAM_H
 #define RNGSTREAM_H
 #include <string>
+#include <cstddef>
 #include <stdint.h>
 
 /**
@@ -70,6 +71,17 @@ public:
    * \returns The next random.
    */
   double RandU01 (void);
+  /**
+   * Generate the next \p n random numbers for this stream.
+   * Uniformly distributed between 0 and 1.
+   *
+   * The numbers are the same as those returned by \p n calls to
+   * RandU01(void).
+   *
+   * \param [out] values The array of \p n random numbers.
+   * \param [in] n The number of random numbers to generate.
+   */
+  void RandU01 (double *values, std::size_t n);
 
 private:
   /**
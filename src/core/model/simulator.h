@@ -184,6 +184,16 @@ public:
    */
   static uint32_t GetContext (void);
 
+  /**
+   * Get the number of events executed so far.
+   *
+   * This can be used, e.g., to report the event rate of a simulation.
+   *
+   * @return The number of events executed, including the canceled
+   *         events but excluding the destroy events
+   */
+  static uint64_t GetEventCount (void);
+
   /**
    * Context enum values.
    *
@@ -222,6 +222,14 @@ Time::SetResolution (enum Unit unit, struct Resolution *resolution,
       NS_LOG_DEBUG ("SetResolution factor " << factor << " real factor " << realFactor);
       struct Information *info = &resolution->info[i];
       info->factor = factor;
+      info->dfactor = static_cast<double> (factor);
+      info->maxTo = factor > 0 ? std::numeric_limits<int64_t>::max () / factor : 0;
+      // The 64-bit paths mirror the int128 and cairo conversions,
+      // which round doubles through an 80-bit long double.
+      info->exact = int64x64_t::implementation != int64x64_t::ld_impl
+        && std::numeric_limits<long double>::digits >= 64
+        && factor > 0 && info->dfactor <= 9007199254740992.0
+        && static_cast<int64_t> (info->dfactor) == factor;
       // here we could equivalently check for realFactor == 1.0 but it's better
       // to avoid checking equality of doubles
       if (shift == 0 && quotient == 1)
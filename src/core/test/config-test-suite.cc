@@ -775,6 +775,134 @@ ObjectVectorTraceConfigTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_path, "/NodeA/NodeB/NodesB/1/Source", "Trace 1 did not provide expected context");
 }
 
+/**
+ * \ingroup config-tests
+ * Test for the ability to trace connect many paths at once.
+ */
+class BatchConnectConfigTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  BatchConnectConfigTestCase ();
+  /** Destructor. */
+  virtual ~BatchConnectConfigTestCase () {}
+
+  /**
+   * Trace callback without context.
+   * \param oldValue The old value.
+   * \param newValue The new value.
+   */
+  void Trace (int16_t oldValue, int16_t newValue)
+  {
+    NS_UNUSED (oldValue);
+    m_newValue = newValue;
+  }
+  /**
+   * Trace callback with context path.
+   * \param path The context path.
+   * \param old The old value.
+   * \param newValue The new value.
+   */
+  void TraceWithPath (std::string path, int16_t old, int16_t newValue)
+  {
+    NS_UNUSED (old);
+    m_newValue = newValue;
+    m_path = path;
+  }
+
+private:
+  virtual void DoRun (void);
+
+  int16_t m_newValue; //!< Flag to detect tracing result.
+  std::string m_path; //!< The context path.
+};
+
+BatchConnectConfigTestCase::BatchConnectConfigTestCase ()
+  : TestCase ("Check ability to trace connect a batch of paths through vectors of Object")
+{
+}
+
+void
+BatchConnectConfigTestCase::DoRun (void)
+{
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Config::RegisterRootNamespaceObject (root);
+  Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject> ();
+  root->SetNodeA (a);
+  Ptr<ConfigTestObject> b = CreateObject<ConfigTestObject> ();
+  a->SetNodeB (b);
+
+  Ptr<ConfigTestObject> obj0 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> obj1 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> obj2 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> obj3 = CreateObject<ConfigTestObject> ();
+  b->AddNodeB (obj0);
+  b->AddNodeB (obj1);
+  b->AddNodeB (obj2);
+  b->AddNodeB (obj3);
+
+  //
+  // Connect (with context) a single index, which takes the direct
+  // container lookup, and a range of indices in the same batch.
+  //
+  std::vector<std::string> paths;
+  std::vector<CallbackBase> cbs;
+  paths.push_back ("/NodeA/NodeB/NodesB/2/Source");
+  cbs.push_back (MakeCallback (&BatchConnectConfigTestCase::TraceWithPath, this));
+  paths.push_back ("/NodeA/NodeB/NodesB/[0-1]/Source");
+  cbs.push_back (MakeCallback (&BatchConnectConfigTestCase::TraceWithPath, this));
+  Config::Connect (paths, cbs);
+
+  m_newValue = 0;
+  m_path = "";
+  obj2->SetAttribute ("Source", IntegerValue (-3));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -3, "Trace 2 did not fire as expected");
+  NS_TEST_ASSERT_MSG_EQ (m_path, "/NodeA/NodeB/NodesB/2/Source", "Trace 2 did not provide expected context");
+
+  m_newValue = 0;
+  m_path = "";
+  obj1->SetAttribute ("Source", IntegerValue (-2));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -2, "Trace 1 did not fire as expected");
+  NS_TEST_ASSERT_MSG_EQ (m_path, "/NodeA/NodeB/NodesB/1/Source", "Trace 1 did not provide expected context");
+
+  m_newValue = 0;
+  obj3->SetAttribute ("Source", IntegerValue (-4));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, 0, "Trace 3 fired unexpectedly");
+
+  //
+  // Connect (without context) an existing and an out of range index:
+  // the latter simply matches nothing.
+  //
+  paths.clear ();
+  cbs.clear ();
+  paths.push_back ("/NodeA/NodeB/NodesB/3/Source");
+  cbs.push_back (MakeCallback (&BatchConnectConfigTestCase::Trace, this));
+  paths.push_back ("/NodeA/NodeB/NodesB/9/Source");
+  cbs.push_back (MakeCallback (&BatchConnectConfigTestCase::Trace, this));
+  Config::ConnectWithoutContext (paths, cbs);
+
+  m_newValue = 0;
+  obj3->SetAttribute ("Source", IntegerValue (-5));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -5, "Trace 3 did not fire as expected");
+
+  //
+  // A single index is matched by its value, not its spelling.
+  //
+  Config::MatchContainer matches = Config::LookupMatches ("/NodeA/NodeB/NodesB/02");
+  bool found = false;
+  for (uint32_t i = 0; i < matches.GetN (); i++)
+    {
+      if (matches.Get (i) == obj2)
+        {
+          found = true;
+          NS_TEST_ASSERT_MSG_EQ (matches.GetMatchedPath (i), "/NodeA/NodeB/NodesB/2/", "Unexpected matched path");
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (found, true, "Object 2 not matched by its index");
+
+  Config::UnregisterRootNamespaceObject (root);
+}
+
 /**
  * \ingroup config-tests
  * Test for the ability to search attributes of parent classes
@@ -847,6 +975,7 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new RootNamespaceConfigTestCase);
   AddTestCase (new UnderRootNamespaceConfigTestCase);
   AddTestCase (new ObjectVectorConfigTestCase);
+  AddTestCase (new BatchConnectConfigTestCase);
   AddTestCase (new SearchAttributesOfParentObjectsTestCase);
 }
 
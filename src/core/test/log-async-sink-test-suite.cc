@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log-async-sink.h"
+#include "ns3/test.h"
+
+#include <iostream>
+#include <sstream>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup logging
+ * \ingroup log-async-sink-tests
+ * Asynchronous log sink test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup log-async-sink-tests Asynchronous log sink test suite
+ */
+
+namespace ns3 {
+
+  namespace tests {
+
+
+/**
+ * \ingroup log-async-sink-tests
+ * Check the log output written through the asynchronous sink.
+ */
+class LogAsyncSinkTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  LogAsyncSinkTestCase ();
+  /** Destructor. */
+  virtual ~LogAsyncSinkTestCase () {}
+
+private:
+  virtual void DoRun (void);
+};
+
+LogAsyncSinkTestCase::LogAsyncSinkTestCase ()
+  : TestCase ("Check the output written through the asynchronous log sink")
+{
+}
+
+void
+LogAsyncSinkTestCase::DoRun (void)
+{
+  std::ostringstream output;
+  std::streambuf *clog = std::clog.rdbuf (output.rdbuf ());
+
+  // enough lines for several blocks, and a partial one at the end
+  std::ostringstream expected;
+  LogEnableAsyncSink ();
+  // enabling the sink twice has no effect
+  LogEnableAsyncSink ();
+  for (uint32_t i = 0; i < 20000; i++)
+    {
+      std::clog << "line " << i << std::endl;
+      expected << "line " << i << std::endl;
+    }
+  LogDisableAsyncSink ();
+  LogDisableAsyncSink ();
+
+  std::clog << "synchronous" << std::endl;
+  expected << "synchronous" << std::endl;
+  std::clog.rdbuf (clog);
+
+  NS_TEST_ASSERT_MSG_EQ (output.str (), expected.str (), "Unexpected log output");
+}
+
+/**
+ * \ingroup log-async-sink-tests
+ * Asynchronous log sink test suite.
+ */
+class LogAsyncSinkTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  LogAsyncSinkTestSuite ();
+};
+
+LogAsyncSinkTestSuite::LogAsyncSinkTestSuite ()
+  : TestSuite ("log-async-sink")
+{
+  AddTestCase (new LogAsyncSinkTestCase);
+}
+
+/**
+ * \ingroup log-async-sink-tests
+ * LogAsyncSinkTestSuite instance variable.
+ */
+static LogAsyncSinkTestSuite g_logAsyncSinkTestSuite;
+
+
+  }  // namespace tests
+
+}  // namespace ns3
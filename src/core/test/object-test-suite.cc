@@ -143,10 +143,35 @@ protected:
   }
 };
 
+/**
+ * \ingroup object-tests
+ * Base class C.
+ */
+class BaseC : public ns3::Object
+{
+public:
+  /**
+   * Register this type.
+   * \return The TypeId.
+   */
+  static ns3::TypeId GetTypeId (void)
+  {
+    static ns3::TypeId tid = ns3::TypeId ("ObjectTest:BaseC")
+      .SetParent<Object> ()
+      .SetGroupName ("Core")
+      .HideFromDocumentation ()
+      .AddConstructor<BaseC> ();
+    return tid;
+  }
+  /** Constructor. */
+  BaseC () {}
+};
+
 NS_OBJECT_ENSURE_REGISTERED (BaseA);
 NS_OBJECT_ENSURE_REGISTERED (DerivedA);
 NS_OBJECT_ENSURE_REGISTERED (BaseB);
 NS_OBJECT_ENSURE_REGISTERED (DerivedB);
+NS_OBJECT_ENSURE_REGISTERED (BaseC);
 
 }  // unnamed namespace
 
@@ -398,6 +423,74 @@ AggregateObjectTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_NE (baseA, 0, "Unable to GetObject on released object");
 }
 
+/**
+ * \ingroup object-tests
+ * Test repeated lookups of aggregated Objects.
+ */
+class AggregateLookupTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  AggregateLookupTestCase ();
+  /** Destructor. */
+  virtual ~AggregateLookupTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+AggregateLookupTestCase::AggregateLookupTestCase ()
+  : TestCase ("Check repeated GetObject lookups in an aggregation")
+{
+}
+
+AggregateLookupTestCase::~AggregateLookupTestCase ()
+{
+}
+
+void
+AggregateLookupTestCase::DoRun (void)
+{
+  Ptr<DerivedA> derivedA = CreateObject<DerivedA> ();
+  Ptr<BaseC> baseC = CreateObject<BaseC> ();
+  derivedA->AggregateObject (baseC);
+
+  //
+  // Look up by TypeId, which bypasses the cast of the first aggregate,
+  // twice in a row: the second lookup must find the same answer as the
+  // first one.
+  //
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (baseC->GetObject<Object> (DerivedA::GetTypeId ()), derivedA,
+                             "Cannot GetObject (through baseC) for DerivedA Object");
+      NS_TEST_ASSERT_MSG_EQ (baseC->GetObject<Object> (BaseA::GetTypeId ()), derivedA,
+                             "Cannot GetObject (through baseC) for BaseA Object");
+      NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<Object> (BaseC::GetTypeId ()), baseC,
+                             "Cannot GetObject (through derivedA) for BaseC Object");
+      NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<Object> (BaseB::GetTypeId ()), 0,
+                             "Unexpectedly found a BaseB through derivedA");
+      NS_TEST_ASSERT_MSG_EQ (baseC->GetObject<DerivedB> (), 0,
+                             "Unexpectedly found a DerivedB through baseC");
+    }
+
+  //
+  // Once a DerivedB joins the aggregation, the lookups which failed
+  // before must find it.
+  //
+  Ptr<DerivedB> derivedB = CreateObject<DerivedB> ();
+  baseC->AggregateObject (derivedB);
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<Object> (BaseB::GetTypeId ()), derivedB,
+                             "Cannot GetObject (through derivedA) for BaseB Object");
+      NS_TEST_ASSERT_MSG_EQ (baseC->GetObject<DerivedB> (), derivedB,
+                             "Cannot GetObject (through baseC) for DerivedB Object");
+      NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<BaseA> (), derivedA,
+                             "Cannot GetObject (through derivedB) for BaseA Object");
+    }
+}
+
 /**
  * \ingroup object-tests
  * Test an Object factory can create Objects
@@ -489,6 +582,7 @@ ObjectTestSuite::ObjectTestSuite ()
 {
   AddTestCase (new CreateObjectTestCase);
   AddTestCase (new AggregateObjectTestCase);
+  AddTestCase (new AggregateLookupTestCase);
   AddTestCase (new ObjectFactoryTestCase);
 }
 
@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/object-factory.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-stream.h"
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup randomvariable
+ * \ingroup randomvariable-tests
+ * Test for the batched draws of random variable streams.
+ */
+
+namespace ns3 {
+
+  namespace tests {
+    
+
+/**
+ * \ingroup randomvariable-tests
+ * Test that RngStream::RandU01 (double *, std::size_t) generates the
+ * same numbers as RandU01 (void).
+ */
+class RngStreamBatchTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  RngStreamBatchTestCase ();
+  /** Destructor. */
+  virtual ~RngStreamBatchTestCase () {}
+
+private:
+  virtual void DoRun (void);
+};
+
+RngStreamBatchTestCase::RngStreamBatchTestCase ()
+  : TestCase ("Check the batch of RngStream numbers")
+{
+}
+
+void
+RngStreamBatchTestCase::DoRun (void)
+{
+  RngStream one (12345, 3, 1);
+  RngStream batch (12345, 3, 1);
+  std::vector<double> values (1000);
+  for (std::size_t n = 0; n < 40; n++)
+    {
+      batch.RandU01 (&values[0], n);
+      for (std::size_t i = 0; i < n; i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (values[i], one.RandU01 (), "Different number " << i << " of batch " << n);
+        }
+    }
+}
+
+/**
+ * \ingroup randomvariable-tests
+ * Test that the batches of a random variable stream return the same
+ * values as one call per value, whatever the size of the batches.
+ */
+class RandomVariableStreamBatchTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   * \param [in] factory The factory of the random variables to compare.
+   * \param [in] name The name of the random variables.
+   */
+  RandomVariableStreamBatchTestCase (ObjectFactory factory, std::string name);
+  /** Destructor. */
+  virtual ~RandomVariableStreamBatchTestCase () {}
+
+private:
+  virtual void DoRun (void);
+
+  ObjectFactory m_factory;   //!< The factory of the random variables.
+};
+
+RandomVariableStreamBatchTestCase::RandomVariableStreamBatchTestCase (ObjectFactory factory, std::string name)
+  : TestCase ("Check the batches of " + name),
+    m_factory (factory)
+{
+}
+
+void
+RandomVariableStreamBatchTestCase::DoRun (void)
+{
+  Ptr<RandomVariableStream> one = m_factory.Create<RandomVariableStream> ();
+  Ptr<RandomVariableStream> batch = m_factory.Create<RandomVariableStream> ();
+  one->SetStream (7);
+  batch->SetStream (7);
+
+  // the batches mix with single values, odd sizes and sizes
+  // larger than the internal batches of the implementations
+  std::vector<double> values (1000);
+  std::vector<uint32_t> integers (1000);
+  const std::size_t sizes[] = { 1, 3, 0, 64, 65, 129, 1000, 7 };
+  for (std::size_t s = 0; s < sizeof (sizes) / sizeof (sizes[0]); s++)
+    {
+      std::size_t n = sizes[s];
+      batch->GetValues (&values[0], n);
+      for (std::size_t i = 0; i < n; i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (values[i], one->GetValue (), "Different value " << i << " of batch " << n);
+        }
+      NS_TEST_ASSERT_MSG_EQ (batch->GetValue (), one->GetValue (), "Different value after batch " << n);
+
+      batch->GetIntegers (&integers[0], n);
+      for (std::size_t i = 0; i < n; i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (integers[i], one->GetInteger (), "Different integer " << i << " of batch " << n);
+        }
+      NS_TEST_ASSERT_MSG_EQ (batch->GetInteger (), one->GetInteger (), "Different integer after batch " << n);
+    }
+}
+
+/**
+ * \ingroup randomvariable-tests
+ * Test suite for the batched draws of random variable streams.
+ */
+class RandomVariableStreamBatchTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  RandomVariableStreamBatchTestSuite ();
+};
+
+RandomVariableStreamBatchTestSuite::RandomVariableStreamBatchTestSuite ()
+  : TestSuite ("random-variable-stream-batch")
+{
+  AddTestCase (new RngStreamBatchTestCase);
+
+  for (uint32_t antithetic = 0; antithetic < 2; antithetic++)
+    {
+      std::string suffix = antithetic ? " (antithetic)" : "";
+      ObjectFactory factory;
+
+      factory.SetTypeId ("ns3::UniformRandomVariable");
+      factory.Set ("Min", DoubleValue (10));
+      factory.Set ("Max", DoubleValue (1000));
+      factory.Set ("Antithetic", BooleanValue (antithetic));
+      AddTestCase (new RandomVariableStreamBatchTestCase (factory, "UniformRandomVariable" + suffix));
+
+      factory = ObjectFactory ();
+      factory.SetTypeId ("ns3::ExponentialRandomVariable");
+      factory.Set ("Mean", DoubleValue (50));
+      factory.Set ("Bound", DoubleValue (80));
+      factory.Set ("Antithetic", BooleanValue (antithetic));
+      AddTestCase (new RandomVariableStreamBatchTestCase (factory, "ExponentialRandomVariable" + suffix));
+
+      factory = ObjectFactory ();
+      factory.SetTypeId ("ns3::NormalRandomVariable");
+      factory.Set ("Mean", DoubleValue (100));
+      factory.Set ("Variance", DoubleValue (400));
+      factory.Set ("Bound", DoubleValue (30));
+      factory.Set ("Antithetic", BooleanValue (antithetic));
+      AddTestCase (new RandomVariableStreamBatchTestCase (factory, "NormalRandomVariable" + suffix));
+
+      // a distribution which uses the default batches
+      factory = ObjectFactory ();
+      factory.SetTypeId ("ns3::ParetoRandomVariable");
+      factory.Set ("Antithetic", BooleanValue (antithetic));
+      AddTestCase (new RandomVariableStreamBatchTestCase (factory, "ParetoRandomVariable" + suffix));
+    }
+}
+
+/**
+ * \ingroup randomvariable-tests
+ * RandomVariableStreamBatchTestSuite instance variable.
+ */
+static RandomVariableStreamBatchTestSuite g_randomVariableStreamBatchTestSuite;
+
+
+  }  // namespace tests
+
+}  // namespace ns3
@@ -23,6 +23,10 @@
 #include "ns3/heap-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/object.h"
+#include "ns3/boolean.h"
+#include <sstream>
 
 using namespace ns3;
 
@@ -138,6 +142,8 @@ SimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_b, true, "Event B did not run ?");
   NS_TEST_EXPECT_MSG_EQ (m_c, true, "Event C did not run ?");
   NS_TEST_EXPECT_MSG_EQ (m_d, true, "Event D did not run ?");
+  // the canceled event A, B and D
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetEventCount (), 3, "Unexpected event count");
 
   EventId anId = Simulator::ScheduleNow (&SimulatorEventsTestCase::Eventfoo0, this);
   EventId anotherId = anId;
@@ -461,6 +467,111 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SimulatorProfilingTestCase : public TestCase
+{
+public:
+  SimulatorProfilingTestCase ();
+  virtual void DoRun (void);
+  void Parent (int n);
+  void Child (void);
+  /**
+   * Find the profile line of a target and parse its count and fan-out.
+   * \param profile The printed profile.
+   * \param pattern A substring of the target name.
+   * \param count The number of invocations.
+   * \param fanOut The mean fan-out.
+   * \returns true if the target was found.
+   */
+  bool ParseProfile (std::string profile, std::string pattern,
+                     uint64_t &count, double &fanOut);
+};
+
+SimulatorProfilingTestCase::SimulatorProfilingTestCase ()
+  : TestCase ("Check the event profiling of the default simulator")
+{
+}
+
+void
+SimulatorProfilingTestCase::Parent (int n)
+{
+  for (int i = 0; i < n; i++)
+    {
+      Simulator::Schedule (MicroSeconds (1), &SimulatorProfilingTestCase::Child, this);
+    }
+}
+
+void
+SimulatorProfilingTestCase::Child (void)
+{
+}
+
+bool
+SimulatorProfilingTestCase::ParseProfile (std::string profile, std::string pattern,
+                                          uint64_t &count, double &fanOut)
+{
+  std::istringstream is (profile);
+  std::string line;
+  while (std::getline (is, line))
+    {
+      if (line.find (pattern) != std::string::npos)
+        {
+          std::istringstream fields (line);
+          double ms, percent, mean;
+          fields >> ms >> percent >> count >> mean >> fanOut;
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+SimulatorProfilingTestCase::DoRun (void)
+{
+  Ptr<DefaultSimulatorImpl> impl = DynamicCast<DefaultSimulatorImpl> (Simulator::GetImplementation ());
+  if (impl == 0)
+    {
+      // another simulator implementation has been selected
+      return;
+    }
+  impl->SetAttribute ("EventProfiling", BooleanValue (true));
+
+  Simulator::Schedule (MicroSeconds (10), &SimulatorProfilingTestCase::Parent, this, 3);
+  Simulator::Schedule (MicroSeconds (20), &SimulatorProfilingTestCase::Parent, this, 1);
+  Ptr<Object> object = CreateObject<Object> ();
+  Simulator::ScheduleWithContext (12345678, MicroSeconds (30), &Object::Initialize, object);
+  EventId canceled = Simulator::Schedule (MicroSeconds (40), &SimulatorProfilingTestCase::Child, this);
+  canceled.Cancel ();
+  Simulator::Run ();
+
+  std::ostringstream oss;
+  impl->PrintProfile (oss);
+  uint64_t count = 0;
+  double fanOut = 0;
+  NS_TEST_ASSERT_MSG_EQ (ParseProfile (oss.str (), "SimulatorProfilingTestCase::*)(int)", count, fanOut),
+                         true, "Parent event not profiled:\n" << oss.str ());
+  NS_TEST_EXPECT_MSG_EQ (count, 2, "Unexpected Parent count");
+  NS_TEST_EXPECT_MSG_EQ_TOL (fanOut, 2, 0.01, "Unexpected Parent fan-out");
+  NS_TEST_ASSERT_MSG_EQ (ParseProfile (oss.str (), "SimulatorProfilingTestCase::*)()", count, fanOut),
+                         true, "Child event not profiled:\n" << oss.str ());
+  NS_TEST_EXPECT_MSG_EQ (count, 4, "Unexpected Child count, the canceled event is not profiled");
+  NS_TEST_EXPECT_MSG_EQ_TOL (fanOut, 0, 0.01, "Unexpected Child fan-out");
+  NS_TEST_ASSERT_MSG_EQ (ParseProfile (oss.str (), "ns3::Object / ", count, fanOut),
+                         true, "Object event not profiled:\n" << oss.str ());
+  NS_TEST_EXPECT_MSG_EQ (count, 1, "Unexpected Object::Initialize count");
+  NS_TEST_ASSERT_MSG_EQ (ParseProfile (oss.str (), "  12345678", count, fanOut),
+                         true, "Context not profiled:\n" << oss.str ());
+  NS_TEST_EXPECT_MSG_EQ (count, 1, "Unexpected context count");
+
+  impl->ResetProfile ();
+  std::ostringstream reset;
+  impl->PrintProfile (reset);
+  NS_TEST_EXPECT_MSG_EQ (ParseProfile (reset.str (), "SimulatorProfilingTestCase", count, fanOut),
+                         false, "Profile not reset:\n" << reset.str ());
+
+  impl->SetAttribute ("EventProfiling", BooleanValue (false));
+  Simulator::Destroy ();
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -477,5 +588,6 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SimulatorProfilingTestCase (), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
@@ -20,8 +20,11 @@
  * TimeStep support by Emmanuelle Laprise <emmanuelle.laprise@bluekazoo.ca>
  */
 
+#include <cmath>
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <sstream>
 
@@ -230,6 +233,94 @@ TimeInputOutputTestCase::DoRun (void)
   std::cout << std::endl;
 }
     
+class TimeFastPathTestCase : public TestCase
+{
+public:
+  TimeFastPathTestCase ();
+private:
+  virtual void DoRun (void);
+  void CheckFrom (double value);
+  void CheckTo (int64_t step);
+};
+
+TimeFastPathTestCase::TimeFastPathTestCase ()
+  : TestCase ("64-bit conversions match the int64x64_t ones")
+{
+}
+
+void
+TimeFastPathTestCase::CheckFrom (double value)
+{
+  for (int unit = Time::Y; unit < Time::LAST; unit++)
+    {
+      Time::Unit u = static_cast<Time::Unit> (unit);
+      if (std::fabs (value) >= Time::Max ().ToDouble (u) / 2)
+        {
+          // out of range
+          continue;
+        }
+      Time fast = Time::FromDouble (value, u);
+      Time ref = Time::From (int64x64_t (value), u);
+      NS_TEST_ASSERT_MSG_EQ (fast.GetTimeStep (), ref.GetTimeStep (),
+                             "FromDouble (" << std::setprecision (20) << value
+                             << ", " << unit << ")");
+    }
+}
+
+void
+TimeFastPathTestCase::CheckTo (int64_t step)
+{
+  for (int unit = Time::Y; unit < Time::LAST; unit++)
+    {
+      Time::Unit u = static_cast<Time::Unit> (unit);
+      if (u > Time::GetResolution ()
+          && std::abs (step) > std::numeric_limits<int64_t>::max () / 1000000)
+        {
+          // out of range
+          continue;
+        }
+      Time t = TimeStep (step);
+      NS_TEST_ASSERT_MSG_EQ (t.ToDouble (u), t.To (u).GetDouble (),
+                             "ToDouble (" << step << ", " << unit << ")");
+    }
+}
+
+void
+TimeFastPathTestCase::DoRun (void)
+{
+  // decimal fractions whose double product with the unit factor lands
+  // on, or next to, an integer
+  const double edges[] = { 0.0, 0.29, 0.001, 4e-6, 1e-9, 0.1, 1.0 / 3,
+                           0.5 - std::ldexp (1.0, -54), std::ldexp (1.0, -65),
+                           123456.789 };
+  for (uint32_t i = 0; i < sizeof (edges) / sizeof (edges[0]); i++)
+    {
+      CheckFrom (edges[i]);
+      CheckFrom (-edges[i]);
+    }
+  for (int32_t i = 0; i < 5000; i++)
+    {
+      CheckFrom (i * 0.001);
+      CheckFrom (-i * 1e-6);
+      CheckFrom (1.0 / (i + 1));
+      CheckFrom (std::ldexp (i + 0.5, -(i % 90)));
+    }
+
+  const int64_t steps[] = { 0, 1, -1, 999999999, 1000000000, -3000000000LL,
+                            60000000000LL, std::numeric_limits<int64_t>::max (),
+                            std::numeric_limits<int64_t>::min () + 1 };
+  for (uint32_t i = 0; i < sizeof (steps) / sizeof (steps[0]); i++)
+    {
+      CheckTo (steps[i]);
+    }
+  for (int64_t i = 0; i < 5000; i++)
+    {
+      CheckTo (i * 1000000);
+      CheckTo (-i * 1000000000);
+      CheckTo (i * i * 7919);
+    }
+}
+
 static class TimeTestSuite : public TestSuite
 {
 public:
@@ -238,6 +329,7 @@ public:
   {
     AddTestCase (new TimeWithSignTestCase (), TestCase::QUICK);
     AddTestCase (new TimeInputOutputTestCase (), TestCase::QUICK);
+    AddTestCase (new TimeFastPathTestCase (), TestCase::QUICK);
     // This should be last, since it changes the resolution
     AddTestCase (new TimeSimpleTestCase (), TestCase::QUICK);
   }
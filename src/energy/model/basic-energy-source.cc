@@ -22,6 +22,7 @@
 #include "ns3/log.h"
 #include "ns3/assert.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/simulator.h"
 
@@ -66,6 +67,13 @@ BasicEnergySource::GetTypeId (void)
                    MakeTimeAccessor (&BasicEnergySource::SetEnergyUpdateInterval,
                                      &BasicEnergySource::GetEnergyUpdateInterval),
                    MakeTimeChecker ())
+    .AddAttribute ("EventDrivenEnergyUpdate",
+                   "If true, update the remaining energy only when the total "
+                   "current changes and when it crosses a battery threshold, "
+                   "instead of every PeriodicEnergyUpdateInterval.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&BasicEnergySource::m_eventDriven),
+                   MakeBooleanChecker ())
     .AddTraceSource ("RemainingEnergy",
                      "Remaining energy at BasicEnergySource.",
                      MakeTraceSourceAccessor (&BasicEnergySource::m_remainingEnergyJ),
@@ -182,9 +190,17 @@ BasicEnergySource::UpdateEnergySource (void)
       NotifyEnergyChanged ();
     }
 
-  m_energyUpdateEvent = Simulator::Schedule (m_energyUpdateInterval,
-                                             &BasicEnergySource::UpdateEnergySource,
-                                             this);
+  if (m_eventDriven)
+    {
+      m_energyUpdateEvent = Simulator::ScheduleNow (&BasicEnergySource::ScheduleThresholdEvent,
+                                                    this);
+    }
+  else
+    {
+      m_energyUpdateEvent = Simulator::Schedule (m_energyUpdateInterval,
+                                                 &BasicEnergySource::UpdateEnergySource,
+                                                 this);
+    }
 }
 
 /*
@@ -235,4 +251,36 @@ BasicEnergySource::CalculateRemainingEnergy (void)
   NS_LOG_DEBUG ("BasicEnergySource:Remaining energy = " << m_remainingEnergyJ);
 }
 
+void
+BasicEnergySource::ScheduleThresholdEvent (void)
+{
+  NS_LOG_FUNCTION (this);
+  double powerW = CalculateTotalCurrent () * m_supplyVoltageV;
+  double energyToThresholdJ;
+  if (!m_depleted && powerW > 0)
+    {
+      energyToThresholdJ = m_remainingEnergyJ - m_lowBatteryTh * m_initialEnergyJ;
+    }
+  else if (m_depleted && powerW < 0)
+    {
+      energyToThresholdJ = m_remainingEnergyJ - m_highBatteryTh * m_initialEnergyJ;
+    }
+  else
+    {
+      // no threshold ahead, until the current changes
+      return;
+    }
+  double delayS = energyToThresholdJ / powerW;
+  if (delayS >= (Simulator::GetMaximumSimulationTime () - Simulator::Now ()).GetSeconds ())
+    {
+      return;
+    }
+  // one step later, so that the threshold is crossed when the update runs
+  Time delay = Seconds (delayS) + TimeStep (1);
+  NS_LOG_DEBUG ("BasicEnergySource:Next threshold in " << delay.GetSeconds () << " s");
+  m_energyUpdateEvent = Simulator::Schedule (delay,
+                                             &BasicEnergySource::UpdateEnergySource,
+                                             this);
+}
+
 } // namespace ns3
@@ -135,6 +135,16 @@ private:
    */
   void CalculateRemainingEnergy (void);
 
+  /**
+   * Schedules the next energy update, in event-driven mode. As long as the
+   * total current does not change, the remaining energy decreases (or
+   * increases) linearly, so the time at which it crosses the low (or high)
+   * battery threshold is known in advance: a single update is scheduled at
+   * that time. Device energy models update the source before they change
+   * their current, so this runs once they are done.
+   */
+  void ScheduleThresholdEvent (void);
+
 private:
   double m_initialEnergyJ;                // initial energy, in Joules
   double m_supplyVoltageV;                // supply voltage, in Volts
@@ -146,6 +156,7 @@ private:
   EventId m_energyUpdateEvent;            // energy update event
   Time m_lastUpdateTime;                  // last update time
   Time m_energyUpdateInterval;            // energy update interval
+  bool m_eventDriven;                     // update on changes of current and thresholds only
 
 };
 
@@ -0,0 +1,195 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/basic-energy-source.h"
+#include "ns3/simple-device-energy-model.h"
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("BasicEnergySourceTestSuite");
+
+/**
+ * Check that an event-driven BasicEnergySource reports the same remaining
+ * energy as a periodically updated one, and that it notices the crossing
+ * of the battery thresholds when they happen.
+ */
+class BasicEnergySourceEventDrivenTestCase : public TestCase
+{
+public:
+  BasicEnergySourceEventDrivenTestCase ();
+  ~BasicEnergySourceEventDrivenTestCase ();
+
+  void DoRun (void);
+
+private:
+  /// A source and the device drawing from it.
+  struct Battery
+  {
+    Ptr<BasicEnergySource> source;         //!< The energy source.
+    Ptr<SimpleDeviceEnergyModel> device;   //!< The device.
+    std::vector<double> samples;           //!< The remaining energy, sampled.
+    Time drained;                          //!< When the low threshold was noticed.
+    Time recharged;                        //!< When the high threshold was noticed.
+  };
+
+  /**
+   * Create a source and its device.
+   * \param eventDriven whether the source is event-driven.
+   * \param battery the source and device created.
+   */
+  void Create (bool eventDriven, Battery &battery);
+  /**
+   * Set the current drawn by the devices.
+   * \param currentA the current, in Amperes.
+   */
+  void SetCurrent (double currentA);
+  /// Sample the remaining energy of the sources.
+  void Sample (void);
+  /**
+   * Trace sink of the remaining energy of a source.
+   * \param battery the source.
+   * \param oldValue the previous remaining energy.
+   * \param newValue the remaining energy.
+   */
+  static void RemainingEnergy (Battery *battery, double oldValue, double newValue);
+
+  Battery m_periodic;   //!< The periodically updated source.
+  Battery m_event;      //!< The event-driven source.
+};
+
+BasicEnergySourceEventDrivenTestCase::BasicEnergySourceEventDrivenTestCase ()
+  : TestCase ("Event-driven BasicEnergySource updates")
+{
+}
+
+BasicEnergySourceEventDrivenTestCase::~BasicEnergySourceEventDrivenTestCase ()
+{
+}
+
+void
+BasicEnergySourceEventDrivenTestCase::Create (bool eventDriven, Battery &battery)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  battery.source = CreateObject<BasicEnergySource> ();
+  battery.source->SetAttribute ("EventDrivenEnergyUpdate", BooleanValue (eventDriven));
+  battery.source->SetNode (node);
+  node->AggregateObject (battery.source);
+
+  battery.device = CreateObject<SimpleDeviceEnergyModel> ();
+  battery.device->SetEnergySource (battery.source);
+  battery.device->SetNode (node);
+  battery.source->AppendDeviceEnergyModel (battery.device);
+
+  battery.drained = Time (0);
+  battery.recharged = Time (0);
+  battery.source->TraceConnectWithoutContext
+    ("RemainingEnergy",
+     MakeBoundCallback (&BasicEnergySourceEventDrivenTestCase::RemainingEnergy, &battery));
+}
+
+void
+BasicEnergySourceEventDrivenTestCase::SetCurrent (double currentA)
+{
+  m_periodic.device->SetCurrentA (currentA);
+  m_event.device->SetCurrentA (currentA);
+}
+
+void
+BasicEnergySourceEventDrivenTestCase::Sample (void)
+{
+  m_periodic.samples.push_back (m_periodic.source->GetRemainingEnergy ());
+  m_event.samples.push_back (m_event.source->GetRemainingEnergy ());
+}
+
+void
+BasicEnergySourceEventDrivenTestCase::RemainingEnergy (Battery *battery,
+                                                       double oldValue, double newValue)
+{
+  double initialEnergyJ = battery->source->GetInitialEnergy ();
+  if (battery->drained.IsZero () && newValue <= 0.10 * initialEnergyJ)
+    {
+      battery->drained = Simulator::Now ();
+    }
+  if (!battery->drained.IsZero () && battery->recharged.IsZero ()
+      && newValue > 0.15 * initialEnergyJ)
+    {
+      battery->recharged = Simulator::Now ();
+    }
+}
+
+void
+BasicEnergySourceEventDrivenTestCase::DoRun (void)
+{
+  // 10 J at 3 V, with the default 10% and 15% thresholds
+  Create (false, m_periodic);
+  Create (true, m_event);
+
+  // 0.3 W for 5 s, then nothing for 3 s, then 0.9 W: the low threshold
+  // (1 J) is crossed after 7.5 / 0.9 s.  At 17 s, with 0.4 J left, the
+  // device recharges the battery at 0.6 W: the high threshold (1.5 J)
+  // is crossed after 1.1 / 0.6 s.
+  Simulator::Schedule (Seconds (0.0), &BasicEnergySourceEventDrivenTestCase::SetCurrent, this, 0.1);
+  Simulator::Schedule (Seconds (5.0), &BasicEnergySourceEventDrivenTestCase::SetCurrent, this, 0.0);
+  Simulator::Schedule (Seconds (8.0), &BasicEnergySourceEventDrivenTestCase::SetCurrent, this, 0.3);
+  Simulator::Schedule (Seconds (17.0), &BasicEnergySourceEventDrivenTestCase::SetCurrent, this, -0.2);
+  for (uint32_t i = 1; i < 80; i++)
+    {
+      Simulator::Schedule (MilliSeconds (250 * i) + MicroSeconds (1),
+                           &BasicEnergySourceEventDrivenTestCase::Sample, this);
+    }
+  Simulator::Stop (Seconds (20.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_event.samples.size (), m_periodic.samples.size (), "Missing samples");
+  for (uint32_t i = 0; i < m_event.samples.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (m_event.samples[i], m_periodic.samples[i], 1e-9,
+                                 "Different remaining energy in sample " << i);
+    }
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_event.samples.back (), 0.4 + 0.6 * 2.75, 1e-6,
+                             "Wrong remaining energy");
+
+  // the periodic source notices the thresholds on its next update
+  Time drained = Seconds (8.0) + NanoSeconds (8333333334);
+  Time recharged = Seconds (17.0) + NanoSeconds (1833333334);
+  NS_TEST_ASSERT_MSG_EQ (m_event.drained, drained, "Low threshold noticed at the wrong time");
+  NS_TEST_ASSERT_MSG_EQ (m_event.recharged, recharged, "High threshold noticed at the wrong time");
+  NS_TEST_ASSERT_MSG_GT_OR_EQ (m_periodic.drained, drained, "Low threshold noticed too early");
+  NS_TEST_ASSERT_MSG_GT_OR_EQ (m_periodic.recharged, recharged, "High threshold noticed too early");
+}
+
+class BasicEnergySourceTestSuite : public TestSuite
+{
+public:
+  BasicEnergySourceTestSuite ();
+};
+
+BasicEnergySourceTestSuite::BasicEnergySourceTestSuite ()
+  : TestSuite ("basic-energy-source", UNIT)
+{
+  AddTestCase (new BasicEnergySourceEventDrivenTestCase, TestCase::QUICK);
+}
+
+// create an instance of the test suite
+static BasicEnergySourceTestSuite g_basicEnergySourceTestSuite;
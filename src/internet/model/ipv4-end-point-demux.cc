@@ -18,6 +18,8 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 
+#include <algorithm>
+
 #include "ipv4-end-point-demux.h"
 #include "ipv4-end-point.h"
 #include "ipv4-interface-address.h"
@@ -40,23 +42,105 @@ Ipv4EndPointDemux::~Ipv4EndPointDemux ()
   for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++) 
     {
       Ipv4EndPoint *endPoint = *i;
+      endPoint->m_demux = 0;
       delete endPoint;
     }
   m_endPoints.clear ();
+  m_connected.clear ();
+  m_wildcards.clear ();
+  m_ports.clear ();
 }
 
 bool
-Ipv4EndPointDemux::LookupPortLocal (uint16_t port)
+Ipv4EndPointDemux::EndPointKey::operator== (const EndPointKey &other) const
 {
-  NS_LOG_FUNCTION (this << port);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++) 
+  return localPort == other.localPort && peerPort == other.peerPort
+         && localAddress == other.localAddress && peerAddress == other.peerAddress;
+}
+
+size_t
+Ipv4EndPointDemux::EndPointKeyHash::operator() (const EndPointKey &key) const
+{
+  size_t hash = key.localAddress.Get ();
+  hash = hash * 31 + key.peerAddress.Get ();
+  hash = hash * 31 + ((static_cast<uint32_t> (key.localPort) << 16) | key.peerPort);
+  return hash;
+}
+
+bool
+Ipv4EndPointDemux::IsConnected (Ipv4EndPoint *endPoint)
+{
+  return endPoint->GetPeerPort () != 0
+         && endPoint->GetPeerAddress () != Ipv4Address::GetAny ()
+         && endPoint->GetLocalAddress () != Ipv4Address::GetAny ();
+}
+
+void
+Ipv4EndPointDemux::Insert (Ipv4EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  endPoint->m_demuxPosition = m_endPoints.insert (m_endPoints.end (), endPoint);
+  endPoint->m_demux = this;
+  AddToIndex (endPoint);
+  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+}
+
+void
+Ipv4EndPointDemux::AddToIndex (Ipv4EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  if (IsConnected (endPoint))
     {
-      if ((*i)->GetLocalPort  () == port) 
+      EndPointKey key = { endPoint->GetLocalAddress (), endPoint->GetLocalPort (),
+                          endPoint->GetPeerAddress (), endPoint->GetPeerPort () };
+      m_connected[key].push_back (endPoint);
+    }
+  else
+    {
+      m_wildcards[endPoint->GetLocalPort ()].push_back (endPoint);
+    }
+  m_ports[endPoint->GetLocalPort ()]++;
+}
+
+void
+Ipv4EndPointDemux::RemoveFromIndex (Ipv4EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  if (IsConnected (endPoint))
+    {
+      EndPointKey key = { endPoint->GetLocalAddress (), endPoint->GetLocalPort (),
+                          endPoint->GetPeerAddress (), endPoint->GetPeerPort () };
+      ConnectedEndPoints::iterator it = m_connected.find (key);
+      NS_ASSERT (it != m_connected.end ());
+      it->second.remove (endPoint);
+      if (it->second.empty ())
         {
-          return true;
+          m_connected.erase (it);
         }
     }
-  return false;
+  else
+    {
+      PortEndPoints::iterator it = m_wildcards.find (endPoint->GetLocalPort ());
+      NS_ASSERT (it != m_wildcards.end ());
+      it->second.remove (endPoint);
+      if (it->second.empty ())
+        {
+          m_wildcards.erase (it);
+        }
+    }
+  PortCount::iterator it = m_ports.find (endPoint->GetLocalPort ());
+  NS_ASSERT (it != m_ports.end () && it->second > 0);
+  if (--it->second == 0)
+    {
+      m_ports.erase (it);
+    }
+}
+
+bool
+Ipv4EndPointDemux::LookupPortLocal (uint16_t port)
+{
+  NS_LOG_FUNCTION (this << port);
+  return m_ports.find (port) != m_ports.end ();
 }
 
 bool
@@ -86,8 +170,7 @@ Ipv4EndPointDemux::Allocate (void)
       return 0;
     }
   Ipv4EndPoint *endPoint = new Ipv4EndPoint (Ipv4Address::GetAny (), port);
-  m_endPoints.push_back (endPoint);
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+  Insert (endPoint);
   return endPoint;
 }
 
@@ -102,8 +185,7 @@ Ipv4EndPointDemux::Allocate (Ipv4Address address)
       return 0;
     }
   Ipv4EndPoint *endPoint = new Ipv4EndPoint (address, port);
-  m_endPoints.push_back (endPoint);
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+  Insert (endPoint);
   return endPoint;
 }
 
@@ -125,8 +207,7 @@ Ipv4EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice, Ipv4Address address,
       return 0;
     }
   Ipv4EndPoint *endPoint = new Ipv4EndPoint (address, port);
-  m_endPoints.push_back (endPoint);
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+  Insert (endPoint);
   return endPoint;
 }
 
@@ -136,23 +217,44 @@ Ipv4EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice,
                              Ipv4Address peerAddress, uint16_t peerPort)
 {
   NS_LOG_FUNCTION (this << localAddress << localPort << peerAddress << peerPort << boundNetDevice);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++) 
+
+  // an endpoint with the same four-tuple is in the same index bucket
+  EndPoints *candidates = 0;
+  if (peerPort != 0 && peerAddress != Ipv4Address::GetAny () && localAddress != Ipv4Address::GetAny ())
     {
-      if ((*i)->GetLocalPort () == localPort &&
-          (*i)->GetLocalAddress () == localAddress &&
-          (*i)->GetPeerPort () == peerPort &&
-          (*i)->GetPeerAddress () == peerAddress &&
-          ((*i)->GetBoundNetDevice () == boundNetDevice || (*i)->GetBoundNetDevice () == 0))
+      EndPointKey key = { localAddress, localPort, peerAddress, peerPort };
+      ConnectedEndPoints::iterator it = m_connected.find (key);
+      if (it != m_connected.end ())
         {
-          NS_LOG_WARN ("Duplicated endpoint.");
-          return 0;
+          candidates = &it->second;
+        }
+    }
+  else
+    {
+      PortEndPoints::iterator it = m_wildcards.find (localPort);
+      if (it != m_wildcards.end ())
+        {
+          candidates = &it->second;
+        }
+    }
+  if (candidates != 0)
+    {
+      for (EndPointsI i = candidates->begin (); i != candidates->end (); i++) 
+        {
+          if ((*i)->GetLocalPort () == localPort &&
+              (*i)->GetLocalAddress () == localAddress &&
+              (*i)->GetPeerPort () == peerPort &&
+              (*i)->GetPeerAddress () == peerAddress &&
+              ((*i)->GetBoundNetDevice () == boundNetDevice || (*i)->GetBoundNetDevice () == 0))
+            {
+              NS_LOG_WARN ("Duplicated endpoint.");
+              return 0;
+            }
         }
     }
   Ipv4EndPoint *endPoint = new Ipv4EndPoint (localAddress, localPort);
   endPoint->SetPeer (peerAddress, peerPort);
-  m_endPoints.push_back (endPoint);
-
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+  Insert (endPoint);
 
   return endPoint;
 }
@@ -161,15 +263,14 @@ void
 Ipv4EndPointDemux::DeAllocate (Ipv4EndPoint *endPoint)
 {
   NS_LOG_FUNCTION (this << endPoint);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++) 
+  if (endPoint->m_demux != this)
     {
-      if (*i == endPoint)
-        {
-          delete endPoint;
-          m_endPoints.erase (i);
-          break;
-        }
+      return;
     }
+  RemoveFromIndex (endPoint);
+  m_endPoints.erase (endPoint->m_demuxPosition);
+  endPoint->m_demux = 0;
+  delete endPoint;
 }
 
 /*
@@ -208,128 +309,168 @@ Ipv4EndPointDemux::Lookup (Ipv4Address daddr, uint16_t dport,
   EndPoints retval4; // Exact match on all 4
 
   NS_LOG_DEBUG ("Looking up endpoint for destination address " << daddr << ":" << dport);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++) 
-    {
-      Ipv4EndPoint* endP = *i;
-
-      NS_LOG_DEBUG ("Looking at endpoint dport=" << endP->GetLocalPort ()
-                                                 << " daddr=" << endP->GetLocalAddress ()
-                                                 << " sport=" << endP->GetPeerPort ()
-                                                 << " saddr=" << endP->GetPeerAddress ());
 
-      if (!endP->IsRxEnabled ())
+  // Only the endpoints that may match are examined, in place in their
+  // index buckets: the connected ones with the exact four-tuple or bound
+  // to the subnet of the destination (subnet-directed broadcast), and the
+  // ones with wildcards on the port.
+  m_candidates.clear ();
+  EndPointKey key = { daddr, dport, saddr, sport };
+  ConnectedEndPoints::iterator connected = m_connected.find (key);
+  if (connected != m_connected.end ())
+    {
+      m_candidates.push_back (&connected->second);
+    }
+  if (incomingInterface && !m_connected.empty ())
+    {
+      for (uint32_t i = 0; i < incomingInterface->GetNAddresses (); i++)
         {
-          NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                        << " because endpoint can not receive packets");
-          continue;
+          Ipv4InterfaceAddress addr = incomingInterface->GetAddress (i);
+          Ipv4Address addrNetpart = addr.GetLocal ().CombineMask (addr.GetMask ());
+          if (addrNetpart == daddr || daddr.CombineMask (addr.GetMask ()) != addrNetpart)
+            {
+              continue;
+            }
+          key.localAddress = addrNetpart;
+          connected = m_connected.find (key);
+          if (connected != m_connected.end ()
+              && std::find (m_candidates.begin (), m_candidates.end (), &connected->second) == m_candidates.end ())
+            {
+              m_candidates.push_back (&connected->second);
+            }
         }
+    }
+  PortEndPoints::iterator wildcards = m_wildcards.find (dport);
+  if (wildcards != m_wildcards.end ())
+    {
+      m_candidates.push_back (&wildcards->second);
+    }
 
-      if (endP->GetLocalPort () != dport) 
-        {
-          NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                                             << " because endpoint dport "
-                                             << endP->GetLocalPort ()
-                                             << " does not match packet dport " << dport);
-          continue;
-        }
-      if (endP->GetBoundNetDevice ())
+  for (uint32_t c = 0; c < m_candidates.size (); c++)
+    {
+      for (EndPointsI i = m_candidates[c]->begin (); i != m_candidates[c]->end (); i++) 
         {
-          if (endP->GetBoundNetDevice () != incomingInterface->GetDevice ())
+          Ipv4EndPoint* endP = *i;
+
+          NS_LOG_DEBUG ("Looking at endpoint dport=" << endP->GetLocalPort ()
+                                                     << " daddr=" << endP->GetLocalAddress ()
+                                                     << " sport=" << endP->GetPeerPort ()
+                                                     << " saddr=" << endP->GetPeerAddress ());
+
+          if (!endP->IsRxEnabled ())
             {
               NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                                                 << " because endpoint is bound to specific device and"
-                                                 << endP->GetBoundNetDevice ()
-                                                 << " does not match packet device " << incomingInterface->GetDevice ());
+                            << " because endpoint can not receive packets");
               continue;
             }
-        }
 
-      bool localAddressMatchesExact = false;
-      bool localAddressIsAny = false;
-      bool localAddressIsSubnetAny = false;
+          if (endP->GetLocalPort () != dport) 
+            {
+              NS_LOG_LOGIC ("Skipping endpoint " << &endP
+                                                 << " because endpoint dport "
+                                                 << endP->GetLocalPort ()
+                                                 << " does not match packet dport " << dport);
+              continue;
+            }
+          if (endP->GetBoundNetDevice ())
+            {
+              if (endP->GetBoundNetDevice () != incomingInterface->GetDevice ())
+                {
+                  NS_LOG_LOGIC ("Skipping endpoint " << &endP
+                                                     << " because endpoint is bound to specific device and"
+                                                     << endP->GetBoundNetDevice ()
+                                                     << " does not match packet device " << incomingInterface->GetDevice ());
+                  continue;
+                }
+            }
 
-      // We have 3 cases:
-      // 1) Exact local / destination address match
-      // 2) Local endpoint bound to Any -> matches anything
-      // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g., x.y.z.255 in a /24 net) and direct destination match.
+          bool localAddressMatchesExact = false;
+          bool localAddressIsAny = false;
+          bool localAddressIsSubnetAny = false;
 
-      if (endP->GetLocalAddress () == daddr)
-        {
-          // Case 1:
-          localAddressMatchesExact = true;
-        }
-      else if (endP->GetLocalAddress () == Ipv4Address::GetAny ())
-        {
-          // Case 2:
-          localAddressIsAny = true;
-        }
-      else
-        {
-          // Case 3:
-          for (uint32_t i = 0; i < incomingInterface->GetNAddresses (); i++)
-            {
-              Ipv4InterfaceAddress addr = incomingInterface->GetAddress (i);
+          // We have 3 cases:
+          // 1) Exact local / destination address match
+          // 2) Local endpoint bound to Any -> matches anything
+          // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g., x.y.z.255 in a /24 net) and direct destination match.
 
-              Ipv4Address addrNetpart = addr.GetLocal ().CombineMask (addr.GetMask ());
-              if (endP->GetLocalAddress () == addrNetpart)
+          if (endP->GetLocalAddress () == daddr)
+            {
+              // Case 1:
+              localAddressMatchesExact = true;
+            }
+          else if (endP->GetLocalAddress () == Ipv4Address::GetAny ())
+            {
+              // Case 2:
+              localAddressIsAny = true;
+            }
+          else
+            {
+              // Case 3:
+              for (uint32_t i = 0; i < incomingInterface->GetNAddresses (); i++)
                 {
-                  NS_LOG_LOGIC ("Endpoint is SubnetDirectedAny " << endP->GetLocalAddress () << "/" << addr.GetMask ().GetPrefixLength ());
+                  Ipv4InterfaceAddress addr = incomingInterface->GetAddress (i);
 
-                  Ipv4Address daddrNetPart = daddr.CombineMask (addr.GetMask ());
-                  if (addrNetpart == daddrNetPart)
+                  Ipv4Address addrNetpart = addr.GetLocal ().CombineMask (addr.GetMask ());
+                  if (endP->GetLocalAddress () == addrNetpart)
                     {
-                      localAddressIsSubnetAny = true;
+                      NS_LOG_LOGIC ("Endpoint is SubnetDirectedAny " << endP->GetLocalAddress () << "/" << addr.GetMask ().GetPrefixLength ());
+
+                      Ipv4Address daddrNetPart = daddr.CombineMask (addr.GetMask ());
+                      if (addrNetpart == daddrNetPart)
+                        {
+                          localAddressIsSubnetAny = true;
+                        }
                     }
                 }
-            }
 
-          // if no match here, keep looking
-          if (!localAddressIsSubnetAny)
-            continue;
-        }
+              // if no match here, keep looking
+              if (!localAddressIsSubnetAny)
+                continue;
+            }
 
-      bool remotePortMatchesExact = endP->GetPeerPort () == sport;
-      bool remotePortMatchesWildCard = endP->GetPeerPort () == 0;
-      bool remoteAddressMatchesExact = endP->GetPeerAddress () == saddr;
-      bool remoteAddressMatchesWildCard = endP->GetPeerAddress () == Ipv4Address::GetAny ();
+          bool remotePortMatchesExact = endP->GetPeerPort () == sport;
+          bool remotePortMatchesWildCard = endP->GetPeerPort () == 0;
+          bool remoteAddressMatchesExact = endP->GetPeerAddress () == saddr;
+          bool remoteAddressMatchesWildCard = endP->GetPeerAddress () == Ipv4Address::GetAny ();
 
-      // If remote does not match either with exact or wildcard,
-      // skip this one
-      if (!(remotePortMatchesExact || remotePortMatchesWildCard))
-        continue;
-      if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        continue;
+          // If remote does not match either with exact or wildcard,
+          // skip this one
+          if (!(remotePortMatchesExact || remotePortMatchesWildCard))
+            continue;
+          if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
+            continue;
 
-      bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
+          bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
 
-      if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All 4 match - this is the case of an open TCP connection, for example.
-          NS_LOG_LOGIC ("Found an endpoint for case 4, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
-          retval4.push_back (endP);
-        }
-      if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All but local address - no idea what this case could be.
-          NS_LOG_LOGIC ("Found an endpoint for case 3, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
-          retval3.push_back (endP);
-        }
-      if (localAddressMatchesExact && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
-        { // Only local port and local address matches exactly - Not yet opened connection
-          NS_LOG_LOGIC ("Found an endpoint for case 2, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
-          retval2.push_back (endP);
-        }
-      if (localAddressMatchesWildCard && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
-        { // Only local port matches exactly - Endpoint open to "any" connection
-          NS_LOG_LOGIC ("Found an endpoint for case 1, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
-          retval1.push_back (endP);
+          if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
+            { // All 4 match - this is the case of an open TCP connection, for example.
+              NS_LOG_LOGIC ("Found an endpoint for case 4, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
+              retval4.push_back (endP);
+            }
+          if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
+            { // All but local address - no idea what this case could be.
+              NS_LOG_LOGIC ("Found an endpoint for case 3, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
+              retval3.push_back (endP);
+            }
+          if (localAddressMatchesExact && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
+            { // Only local port and local address matches exactly - Not yet opened connection
+              NS_LOG_LOGIC ("Found an endpoint for case 2, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
+              retval2.push_back (endP);
+            }
+          if (localAddressMatchesWildCard && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
+            { // Only local port matches exactly - Endpoint open to "any" connection
+              NS_LOG_LOGIC ("Found an endpoint for case 1, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
+              retval1.push_back (endP);
+            }
         }
     }
 
   // Here we find the most exact match
   EndPoints retval;
-  if (!retval4.empty ()) retval = retval4;
-  else if (!retval3.empty ()) retval = retval3;
-  else if (!retval2.empty ()) retval = retval2;
-  else retval = retval1;
+  if (!retval4.empty ()) retval.swap (retval4);
+  else if (!retval3.empty ()) retval.swap (retval3);
+  else if (!retval2.empty ()) retval.swap (retval2);
+  else retval.swap (retval1);
 
   NS_ABORT_MSG_IF (retval.size () > 1, "Too many endpoints - perhaps you created too many sockets without binding them to different NetDevices.");
   return retval;  // might be empty if no matches
@@ -343,6 +484,14 @@ Ipv4EndPointDemux::SimpleLookup (Ipv4Address daddr,
 {
   NS_LOG_FUNCTION (this << daddr << dport << saddr << sport);
 
+  // fast path for connected endpoints
+  EndPointKey key = { daddr, dport, saddr, sport };
+  ConnectedEndPoints::iterator it = m_connected.find (key);
+  if (it != m_connected.end ())
+    {
+      return it->second.front ();
+    }
+
   // this code is a copy/paste version of an old BSD ip stack lookup
   // function.
   uint32_t genericity = 3;
@@ -23,7 +23,9 @@
 
 #include <stdint.h>
 #include <list>
+#include <vector>
 #include "ns3/ipv4-address.h"
+#include "ns3/sgi-hashmap.h"
 #include "ipv4-interface.h"
 
 namespace ns3 {
@@ -40,6 +42,11 @@ class Ipv4EndPoint;
  * of endpoints, and has APIs to add and find endpoints in this demux.  This
  * code is shared in common to TCP and UDP protocols in ns3.  This demux
  * sits between ns3's layer four and the socket layer
+ *
+ * The endpoints with a fully specified four-tuple (e.g., TCP connections)
+ * are indexed in a hash table by four-tuple, and the other ones (e.g.,
+ * listening sockets) in a hash table by local port, so that a lookup does
+ * not depend on the number of connections.
  */
 
 class Ipv4EndPointDemux {
@@ -166,6 +173,82 @@ public:
   void DeAllocate (Ipv4EndPoint *endPoint);
 
 private:
+  friend class Ipv4EndPoint;
+
+  /**
+   * \brief Four-tuple of a connected endpoint.
+   */
+  struct EndPointKey
+  {
+    Ipv4Address localAddress; //!< Local address
+    uint16_t localPort;        //!< Local port
+    Ipv4Address peerAddress;  //!< Peer address
+    uint16_t peerPort;         //!< Peer port
+
+    /**
+     * \brief Comparison operator.
+     * \param other the other four-tuple
+     * \return true if the four-tuples are equal
+     */
+    bool operator== (const EndPointKey &other) const;
+  };
+
+  /**
+   * \brief Hash function of the four-tuples.
+   */
+  struct EndPointKeyHash
+  {
+    /**
+     * \brief Returns the hash of the four-tuple.
+     * \param key the four-tuple
+     * \return the hash
+     */
+    size_t operator() (const EndPointKey &key) const;
+  };
+
+  /**
+   * \brief Index of the connected endpoints, by four-tuple.
+   */
+  typedef sgi::hash_map<EndPointKey, EndPoints, EndPointKeyHash> ConnectedEndPoints;
+
+  /**
+   * \brief Index of the endpoints by local port.
+   */
+  typedef sgi::hash_map<uint16_t, EndPoints> PortEndPoints;
+
+  /**
+   * \brief Number of endpoints using each local port.
+   */
+  typedef sgi::hash_map<uint16_t, uint32_t> PortCount;
+
+  /**
+   * \brief Check if an endpoint has a fully specified four-tuple.
+   *
+   * Connected endpoints are indexed by four-tuple, the others (e.g.,
+   * listening endpoints) by local port only.
+   * \param endPoint the endpoint to check
+   * \return true if the local address, peer address and peer port are not wildcards
+   */
+  static bool IsConnected (Ipv4EndPoint *endPoint);
+
+  /**
+   * \brief Add a newly created endpoint to the list and to the indexes.
+   * \param endPoint the endpoint to add
+   */
+  void Insert (Ipv4EndPoint *endPoint);
+
+  /**
+   * \brief Index an endpoint by its current four-tuple.
+   * \param endPoint the endpoint to index
+   */
+  void AddToIndex (Ipv4EndPoint *endPoint);
+
+  /**
+   * \brief Remove an endpoint from the indexes, using its current four-tuple.
+   * \param endPoint the endpoint to remove
+   */
+  void RemoveFromIndex (Ipv4EndPoint *endPoint);
+
 
   /**
    * \brief Allocate an ephemeral port.
@@ -192,6 +275,26 @@ private:
    * \brief A list of IPv4 end points.
    */
   EndPoints m_endPoints;
+
+  /**
+   * \brief The connected end points, indexed by four-tuple.
+   */
+  ConnectedEndPoints m_connected;
+
+  /**
+   * \brief The other end points, indexed by local port.
+   */
+  PortEndPoints m_wildcards;
+
+  /**
+   * \brief The number of end points using each local port.
+   */
+  PortCount m_ports;
+
+  /**
+   * \brief The index buckets examined by Lookup, kept to avoid reallocations.
+   */
+  std::vector<EndPoints *> m_candidates;
 };
 
 } // namespace ns3
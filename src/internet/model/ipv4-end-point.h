@@ -22,6 +22,7 @@
 #define IPV4_END_POINT_H
 
 #include <stdint.h>
+#include <list>
 #include "ns3/ipv4-address.h"
 #include "ns3/callback.h"
 #include "ns3/net-device.h"
@@ -32,6 +33,7 @@ namespace ns3 {
 
 class Header;
 class Packet;
+class Ipv4EndPointDemux;
 
 /**
  * \ingroup ipv4
@@ -183,6 +185,8 @@ public:
   bool IsRxEnabled (void);
 
 private:
+  friend class Ipv4EndPointDemux;
+
   /**
    * \brief The local address.
    */
@@ -227,6 +231,19 @@ private:
    * \brief true if the endpoint can receive packets.
    */
   bool m_rxEnabled;
+
+  /**
+   * \brief The demux the endpoint has been allocated by (if any).
+   *
+   * The demux indexes the endpoint by its four-tuple, so it is
+   * notified of any change of the local address or of the peer.
+   */
+  Ipv4EndPointDemux *m_demux;
+
+  /**
+   * \brief The position of the endpoint in the list of its demux.
+   */
+  std::list<Ipv4EndPoint *>::iterator m_demuxPosition;
 };
 
 } // namespace ns3
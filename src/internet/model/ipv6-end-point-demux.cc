@@ -40,22 +40,99 @@ Ipv6EndPointDemux::~Ipv6EndPointDemux ()
   for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
     {
       Ipv6EndPoint *endPoint = *i;
+      endPoint->m_demux = 0;
       delete endPoint;
     }
   m_endPoints.clear ();
+  m_connected.clear ();
+  m_wildcards.clear ();
+  m_ports.clear ();
 }
 
-bool Ipv6EndPointDemux::LookupPortLocal (uint16_t port)
+bool Ipv6EndPointDemux::EndPointKey::operator== (const EndPointKey &other) const
 {
-  NS_LOG_FUNCTION (this << port);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  return localPort == other.localPort && peerPort == other.peerPort
+         && localAddress == other.localAddress && peerAddress == other.peerAddress;
+}
+
+size_t Ipv6EndPointDemux::EndPointKeyHash::operator() (const EndPointKey &key) const
+{
+  Ipv6AddressHash addressHash;
+  size_t hash = addressHash (key.localAddress);
+  hash = hash * 31 + addressHash (key.peerAddress);
+  hash = hash * 31 + ((static_cast<uint32_t> (key.localPort) << 16) | key.peerPort);
+  return hash;
+}
+
+bool Ipv6EndPointDemux::IsConnected (Ipv6EndPoint *endPoint)
+{
+  return endPoint->GetPeerPort () != 0
+         && endPoint->GetPeerAddress () != Ipv6Address::GetAny ()
+         && endPoint->GetLocalAddress () != Ipv6Address::GetAny ();
+}
+
+void Ipv6EndPointDemux::Insert (Ipv6EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  endPoint->m_demuxPosition = m_endPoints.insert (m_endPoints.end (), endPoint);
+  endPoint->m_demux = this;
+  AddToIndex (endPoint);
+  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+}
+
+void Ipv6EndPointDemux::AddToIndex (Ipv6EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  if (IsConnected (endPoint))
     {
-      if ((*i)->GetLocalPort  () == port)
+      EndPointKey key = { endPoint->GetLocalAddress (), endPoint->GetLocalPort (),
+                          endPoint->GetPeerAddress (), endPoint->GetPeerPort () };
+      m_connected[key].push_back (endPoint);
+    }
+  else
+    {
+      m_wildcards[endPoint->GetLocalPort ()].push_back (endPoint);
+    }
+  m_ports[endPoint->GetLocalPort ()]++;
+}
+
+void Ipv6EndPointDemux::RemoveFromIndex (Ipv6EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  if (IsConnected (endPoint))
+    {
+      EndPointKey key = { endPoint->GetLocalAddress (), endPoint->GetLocalPort (),
+                          endPoint->GetPeerAddress (), endPoint->GetPeerPort () };
+      ConnectedEndPoints::iterator it = m_connected.find (key);
+      NS_ASSERT (it != m_connected.end ());
+      it->second.remove (endPoint);
+      if (it->second.empty ())
         {
-          return true;
+          m_connected.erase (it);
         }
     }
-  return false;
+  else
+    {
+      PortEndPoints::iterator it = m_wildcards.find (endPoint->GetLocalPort ());
+      NS_ASSERT (it != m_wildcards.end ());
+      it->second.remove (endPoint);
+      if (it->second.empty ())
+        {
+          m_wildcards.erase (it);
+        }
+    }
+  PortCount::iterator it = m_ports.find (endPoint->GetLocalPort ());
+  NS_ASSERT (it != m_ports.end () && it->second > 0);
+  if (--it->second == 0)
+    {
+      m_ports.erase (it);
+    }
+}
+
+bool Ipv6EndPointDemux::LookupPortLocal (uint16_t port)
+{
+  NS_LOG_FUNCTION (this << port);
+  return m_ports.find (port) != m_ports.end ();
 }
 
 bool Ipv6EndPointDemux::LookupLocal (Ptr<NetDevice> boundNetDevice, Ipv6Address addr, uint16_t port)
@@ -83,8 +160,7 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate ()
       return 0;
     }
   Ipv6EndPoint *endPoint = new Ipv6EndPoint (Ipv6Address::GetAny (), port);
-  m_endPoints.push_back (endPoint);
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+  Insert (endPoint);
   return endPoint;
 }
 
@@ -98,8 +174,7 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ipv6Address address)
       return 0;
     }
   Ipv6EndPoint *endPoint = new Ipv6EndPoint (address, port);
-  m_endPoints.push_back (endPoint);
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+  Insert (endPoint);
   return endPoint;
 }
 
@@ -119,8 +194,7 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice, Ipv6Ad
       return 0;
     }
   Ipv6EndPoint *endPoint = new Ipv6EndPoint (address, port);
-  m_endPoints.push_back (endPoint);
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+  Insert (endPoint);
   return endPoint;
 }
 
@@ -129,23 +203,44 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice,
                                            Ipv6Address peerAddress, uint16_t peerPort)
 {
   NS_LOG_FUNCTION (this << boundNetDevice << localAddress << localPort << peerAddress << peerPort);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+
+  // an endpoint with the same four-tuple is in the same index bucket
+  EndPoints *candidates = 0;
+  if (peerPort != 0 && peerAddress != Ipv6Address::GetAny () && localAddress != Ipv6Address::GetAny ())
     {
-      if ((*i)->GetLocalPort () == localPort &&
-          (*i)->GetLocalAddress () == localAddress &&
-          (*i)->GetPeerPort () == peerPort &&
-          (*i)->GetPeerAddress () == peerAddress &&
-          ((*i)->GetBoundNetDevice () == boundNetDevice || (*i)->GetBoundNetDevice () == 0))
+      EndPointKey key = { localAddress, localPort, peerAddress, peerPort };
+      ConnectedEndPoints::iterator it = m_connected.find (key);
+      if (it != m_connected.end ())
         {
-          NS_LOG_WARN ("Duplicated endpoint.");
-          return 0;
+          candidates = &it->second;
+        }
+    }
+  else
+    {
+      PortEndPoints::iterator it = m_wildcards.find (localPort);
+      if (it != m_wildcards.end ())
+        {
+          candidates = &it->second;
+        }
+    }
+  if (candidates != 0)
+    {
+      for (EndPointsI i = candidates->begin (); i != candidates->end (); i++)
+        {
+          if ((*i)->GetLocalPort () == localPort &&
+              (*i)->GetLocalAddress () == localAddress &&
+              (*i)->GetPeerPort () == peerPort &&
+              (*i)->GetPeerAddress () == peerAddress &&
+              ((*i)->GetBoundNetDevice () == boundNetDevice || (*i)->GetBoundNetDevice () == 0))
+            {
+              NS_LOG_WARN ("Duplicated endpoint.");
+              return 0;
+            }
         }
     }
   Ipv6EndPoint *endPoint = new Ipv6EndPoint (localAddress, localPort);
   endPoint->SetPeer (peerAddress, peerPort);
-  m_endPoints.push_back (endPoint);
-
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+  Insert (endPoint);
 
   return endPoint;
 }
@@ -153,15 +248,14 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice,
 void Ipv6EndPointDemux::DeAllocate (Ipv6EndPoint *endPoint)
 {
   NS_LOG_FUNCTION (this);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  if (endPoint->m_demux != this)
     {
-      if (*i == endPoint)
-        {
-          delete endPoint;
-          m_endPoints.erase (i);
-          break;
-        }
+      return;
     }
+  RemoveFromIndex (endPoint);
+  m_endPoints.erase (endPoint->m_demuxPosition);
+  endPoint->m_demux = 0;
+  delete endPoint;
 }
 
 /*
@@ -181,108 +275,129 @@ Ipv6EndPointDemux::EndPoints Ipv6EndPointDemux::Lookup (Ipv6Address daddr, uint1
   EndPoints retval4; /* Exact match on all 4 */
 
   NS_LOG_DEBUG ("Looking up endpoint for destination address " << daddr);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
-    {
-      Ipv6EndPoint* endP = *i;
 
-      NS_LOG_DEBUG ("Looking at endpoint dport=" << endP->GetLocalPort ()
-                                                 << " daddr=" << endP->GetLocalAddress ()
-                                                 << " sport=" << endP->GetPeerPort ()
-                                                 << " saddr=" << endP->GetPeerAddress ());
+  /* Only the endpoints that may match are examined, in place in their
+     index buckets: the connected ones with the exact four-tuple, and the
+     ones with wildcards on the port. */
+  EndPoints *candidates[2];
+  uint32_t nCandidates = 0;
+  EndPointKey key = { daddr, dport, saddr, sport };
+  ConnectedEndPoints::iterator connected = m_connected.find (key);
+  if (connected != m_connected.end ())
+    {
+      candidates[nCandidates++] = &connected->second;
+    }
+  PortEndPoints::iterator wildcards = m_wildcards.find (dport);
+  if (wildcards != m_wildcards.end ())
+    {
+      candidates[nCandidates++] = &wildcards->second;
+    }
 
-      if (!endP->IsRxEnabled ())
+  for (uint32_t c = 0; c < nCandidates; c++)
+    {
+      for (EndPointsI i = candidates[c]->begin (); i != candidates[c]->end (); i++)
         {
-          NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                        << " because endpoint can not receive packets");
-          continue;
-        }
+          Ipv6EndPoint* endP = *i;
 
-      if (endP->GetLocalPort () != dport)
-        {
-          NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                                             << " because endpoint dport "
-                                             << endP->GetLocalPort ()
-                                             << " does not match packet dport " << dport);
-          continue;
-        }
+          NS_LOG_DEBUG ("Looking at endpoint dport=" << endP->GetLocalPort ()
+                                                     << " daddr=" << endP->GetLocalAddress ()
+                                                     << " sport=" << endP->GetPeerPort ()
+                                                     << " saddr=" << endP->GetPeerAddress ());
 
-      if (endP->GetBoundNetDevice ())
-        {
-          if (!incomingInterface)
+          if (!endP->IsRxEnabled ())
             {
+              NS_LOG_LOGIC ("Skipping endpoint " << &endP
+                            << " because endpoint can not receive packets");
               continue;
             }
-          if (endP->GetBoundNetDevice () != incomingInterface->GetDevice ())
+
+          if (endP->GetLocalPort () != dport)
             {
               NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                                                 << " because endpoint is bound to specific device and"
-                                                 << endP->GetBoundNetDevice ()
-                                                 << " does not match packet device " << incomingInterface->GetDevice ());
+                                                 << " because endpoint dport "
+                                                 << endP->GetLocalPort ()
+                                                 << " does not match packet dport " << dport);
               continue;
             }
-        }
 
-      /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
-      NS_LOG_DEBUG ("dest addr " << daddr);
+          if (endP->GetBoundNetDevice ())
+            {
+              if (!incomingInterface)
+                {
+                  continue;
+                }
+              if (endP->GetBoundNetDevice () != incomingInterface->GetDevice ())
+                {
+                  NS_LOG_LOGIC ("Skipping endpoint " << &endP
+                                                     << " because endpoint is bound to specific device and"
+                                                     << endP->GetBoundNetDevice ()
+                                                     << " does not match packet device " << incomingInterface->GetDevice ());
+                  continue;
+                }
+            }
 
-      bool localAddressMatchesWildCard = endP->GetLocalAddress () == Ipv6Address::GetAny ();
-      bool localAddressMatchesExact = endP->GetLocalAddress () == daddr;
-      bool localAddressMatchesAllRouters = endP->GetLocalAddress () == Ipv6Address::GetAllRoutersMulticast ();
+          /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
+          NS_LOG_DEBUG ("dest addr " << daddr);
 
-      /* if no match here, keep looking */
-      if (!(localAddressMatchesExact || localAddressMatchesWildCard))
-        {
-          continue;
-        }
-      bool remotePeerMatchesExact = endP->GetPeerPort () == sport;
-      bool remotePeerMatchesWildCard = endP->GetPeerPort () == 0;
-      bool remoteAddressMatchesExact = endP->GetPeerAddress () == saddr;
-      bool remoteAddressMatchesWildCard = endP->GetPeerAddress () == Ipv6Address::GetAny ();
-
-      /* If remote does not match either with exact or wildcard,i
-         skip this one */
-      if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
-        {
-          continue;
-        }
-      if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-          continue;
-        }
+          bool localAddressMatchesWildCard = endP->GetLocalAddress () == Ipv6Address::GetAny ();
+          bool localAddressMatchesExact = endP->GetLocalAddress () == daddr;
+          bool localAddressMatchesAllRouters = endP->GetLocalAddress () == Ipv6Address::GetAllRoutersMulticast ();
 
-      /* Now figure out which return list to add this one to */
-      if (localAddressMatchesWildCard
-          && remotePeerMatchesWildCard
-          && remoteAddressMatchesWildCard)
-        { /* Only local port matches exactly */
-          retval1.push_back (endP);
-        }
-      if ((localAddressMatchesExact || (localAddressMatchesAllRouters))
-          && remotePeerMatchesWildCard
-          && remoteAddressMatchesWildCard)
-        { /* Only local port and local address matches exactly */
-          retval2.push_back (endP);
-        }
-      if (localAddressMatchesWildCard
-          && remotePeerMatchesExact
-          && remoteAddressMatchesExact)
-        { /* All but local address */
-          retval3.push_back (endP);
-        }
-      if (localAddressMatchesExact
-          && remotePeerMatchesExact
-          && remoteAddressMatchesExact)
-        { /* All 4 match */
-          retval4.push_back (endP);
+          /* if no match here, keep looking */
+          if (!(localAddressMatchesExact || localAddressMatchesWildCard))
+            {
+              continue;
+            }
+          bool remotePeerMatchesExact = endP->GetPeerPort () == sport;
+          bool remotePeerMatchesWildCard = endP->GetPeerPort () == 0;
+          bool remoteAddressMatchesExact = endP->GetPeerAddress () == saddr;
+          bool remoteAddressMatchesWildCard = endP->GetPeerAddress () == Ipv6Address::GetAny ();
+
+          /* If remote does not match either with exact or wildcard,i
+             skip this one */
+          if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
+            {
+              continue;
+            }
+          if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
+            {
+              continue;
+            }
+
+          /* Now figure out which return list to add this one to */
+          if (localAddressMatchesWildCard
+              && remotePeerMatchesWildCard
+              && remoteAddressMatchesWildCard)
+            { /* Only local port matches exactly */
+              retval1.push_back (endP);
+            }
+          if ((localAddressMatchesExact || (localAddressMatchesAllRouters))
+              && remotePeerMatchesWildCard
+              && remoteAddressMatchesWildCard)
+            { /* Only local port and local address matches exactly */
+              retval2.push_back (endP);
+            }
+          if (localAddressMatchesWildCard
+              && remotePeerMatchesExact
+              && remoteAddressMatchesExact)
+            { /* All but local address */
+              retval3.push_back (endP);
+            }
+          if (localAddressMatchesExact
+              && remotePeerMatchesExact
+              && remoteAddressMatchesExact)
+            { /* All 4 match */
+              retval4.push_back (endP);
+            }
         }
     }
 
   // Here we find the most exact match
   EndPoints retval;
-  if (!retval4.empty ()) retval = retval4;
-  else if (!retval3.empty ()) retval = retval3;
-  else if (!retval2.empty ()) retval = retval2;
-  else retval = retval1;
+  if (!retval4.empty ()) retval.swap (retval4);
+  else if (!retval3.empty ()) retval.swap (retval3);
+  else if (!retval2.empty ()) retval.swap (retval2);
+  else retval.swap (retval1);
 
   NS_ABORT_MSG_IF (retval.size () > 1, "Too many endpoints - perhaps you created too many sockets without binding them to different NetDevices.");
   return retval;  // might be empty if no matches
@@ -290,6 +405,14 @@ Ipv6EndPointDemux::EndPoints Ipv6EndPointDemux::Lookup (Ipv6Address daddr, uint1
 
 Ipv6EndPoint* Ipv6EndPointDemux::SimpleLookup (Ipv6Address dst, uint16_t dport, Ipv6Address src, uint16_t sport)
 {
+  /* fast path for connected endpoints */
+  EndPointKey key = { dst, dport, src, sport };
+  ConnectedEndPoints::iterator it = m_connected.find (key);
+  if (it != m_connected.end ())
+    {
+      return it->second.front ();
+    }
+
   uint32_t genericity = 3;
   Ipv6EndPoint *generic = 0;
 
@@ -24,6 +24,7 @@
 #include <stdint.h>
 #include <list>
 #include "ns3/ipv6-address.h"
+#include "ns3/sgi-hashmap.h"
 #include "ipv6-interface.h"
 
 namespace ns3 {
@@ -34,6 +35,11 @@ class Ipv6EndPoint;
  * \ingroup ipv6
  *
  * \brief Demultiplexer for end points.
+ *
+ * The endpoints with a fully specified four-tuple (e.g., TCP connections)
+ * are indexed in a hash table by four-tuple, and the other ones (e.g.,
+ * listening sockets) in a hash table by local port, so that a lookup does
+ * not depend on the number of connections.
  */
 class Ipv6EndPointDemux
 {
@@ -153,6 +159,82 @@ public:
   EndPoints GetEndPoints () const;
 
 private:
+  friend class Ipv6EndPoint;
+
+  /**
+   * \brief Four-tuple of a connected endpoint.
+   */
+  struct EndPointKey
+  {
+    Ipv6Address localAddress; //!< Local address
+    uint16_t localPort;        //!< Local port
+    Ipv6Address peerAddress;  //!< Peer address
+    uint16_t peerPort;         //!< Peer port
+
+    /**
+     * \brief Comparison operator.
+     * \param other the other four-tuple
+     * \return true if the four-tuples are equal
+     */
+    bool operator== (const EndPointKey &other) const;
+  };
+
+  /**
+   * \brief Hash function of the four-tuples.
+   */
+  struct EndPointKeyHash
+  {
+    /**
+     * \brief Returns the hash of the four-tuple.
+     * \param key the four-tuple
+     * \return the hash
+     */
+    size_t operator() (const EndPointKey &key) const;
+  };
+
+  /**
+   * \brief Index of the connected endpoints, by four-tuple.
+   */
+  typedef sgi::hash_map<EndPointKey, EndPoints, EndPointKeyHash> ConnectedEndPoints;
+
+  /**
+   * \brief Index of the endpoints by local port.
+   */
+  typedef sgi::hash_map<uint16_t, EndPoints> PortEndPoints;
+
+  /**
+   * \brief Number of endpoints using each local port.
+   */
+  typedef sgi::hash_map<uint16_t, uint32_t> PortCount;
+
+  /**
+   * \brief Check if an endpoint has a fully specified four-tuple.
+   *
+   * Connected endpoints are indexed by four-tuple, the others (e.g.,
+   * listening endpoints) by local port only.
+   * \param endPoint the endpoint to check
+   * \return true if the local address, peer address and peer port are not wildcards
+   */
+  static bool IsConnected (Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Add a newly created endpoint to the list and to the indexes.
+   * \param endPoint the endpoint to add
+   */
+  void Insert (Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Index an endpoint by its current four-tuple.
+   * \param endPoint the endpoint to index
+   */
+  void AddToIndex (Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Remove an endpoint from the indexes, using its current four-tuple.
+   * \param endPoint the endpoint to remove
+   */
+  void RemoveFromIndex (Ipv6EndPoint *endPoint);
+
   /**
    * \brief Allocate a ephemeral port.
    * \return a port
@@ -178,6 +260,21 @@ private:
    * \brief A list of IPv6 end points.
    */
   EndPoints m_endPoints;
+
+  /**
+   * \brief The connected end points, indexed by four-tuple.
+   */
+  ConnectedEndPoints m_connected;
+
+  /**
+   * \brief The other end points, indexed by local port.
+   */
+  PortEndPoints m_wildcards;
+
+  /**
+   * \brief The number of end points using each local port.
+   */
+  PortCount m_ports;
 };
 
 } /* namespace ns3 */
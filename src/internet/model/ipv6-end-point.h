@@ -22,6 +22,7 @@
 #define IPV6_END_POINT_H
 
 #include <stdint.h>
+#include <list>
 
 #include "ns3/ipv6-address.h"
 #include "ns3/callback.h"
@@ -34,6 +35,7 @@ namespace ns3
 
 class Header;
 class Packet;
+class Ipv6EndPointDemux;
 
 /**
  * \ingroup ipv6
@@ -192,6 +194,8 @@ public:
   bool IsRxEnabled (void);
 
 private:
+  friend class Ipv6EndPointDemux;
+
   /**
    * \brief The local address.
    */
@@ -236,6 +240,20 @@ private:
    * \brief true if the endpoint can receive packets.
    */
   bool m_rxEnabled;
+
+  /**
+   * \brief The demux the endpoint has been allocated by (if any).
+   *
+   * The demux indexes the endpoint by its four-tuple, so it is
+   * notified of any change of the local address, local port or
+   * of the peer.
+   */
+  Ipv6EndPointDemux *m_demux;
+
+  /**
+   * \brief The position of the endpoint in the list of its demux.
+   */
+  std::list<Ipv6EndPoint *>::iterator m_demuxPosition;
 };
 
 } /* namespace ns3 */
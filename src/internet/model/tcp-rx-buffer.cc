@@ -155,8 +155,14 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
       if (maxSeq < tailSeq) tailSeq = maxSeq;
       if (tailSeq < headSeq) headSeq = tailSeq;
     }
-  // Remove overlapped bytes from packet
-  BufIterator i = m_data.begin ();
+  // Remove overlapped bytes from packet. Stored blocks do not overlap, so
+  // only the block starting at or before headSeq and the following ones can
+  // overlap with the incoming data
+  BufIterator i = m_data.upper_bound (headSeq);
+  if (i != m_data.begin ())
+    {
+      --i;
+    }
   while (i != m_data.end () && i->first <= tailSeq)
     {
       SequenceNumber32 lastByteSeq = i->first + SequenceNumber32 (i->second->GetSize ());
@@ -189,7 +195,10 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
     {
       uint32_t start = static_cast<uint32_t> (headSeq - tcph.GetSequenceNumber ());
       uint32_t length = static_cast<uint32_t> (tailSeq - headSeq);
-      p = p->CreateFragment (start, length);
+      if (start != 0 || length != pktSize)
+        {
+          p = p->CreateFragment (start, length);
+        }
       NS_ASSERT (length == p->GetSize ());
     }
   // Insert packet into buffer
@@ -205,7 +214,7 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
   NS_LOG_LOGIC ("Buffered packet of seqno=" << headSeq << " len=" << p->GetSize ());
   // Update variables
   m_size += p->GetSize ();      // Occupancy
-  for (i = m_data.begin (); i != m_data.end (); ++i)
+  for (i = m_data.lower_bound (m_nextRxSeq); i != m_data.end (); ++i)
     {
       if (i->first < m_nextRxSeq)
         {
@@ -169,6 +169,8 @@ TcpTxBuffer::SetHeadSequence (const SequenceNumber32& seq)
   // if you change the head with data already sent, something bad will happen
   NS_ASSERT (m_sentList.size () == 0);
   m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
+  m_nextSegLostHint = seq;
+  m_nextSegUnsackedHint = seq;
 }
 
 bool
@@ -294,7 +296,7 @@ TcpTxBuffer::GetNewSegment (uint32_t numBytes)
   NS_ASSERT (it != m_appList.end ());
 
   m_appList.erase (it);
-  m_sentList.insert (m_sentList.end (), item);
+  IndexSentItem (m_sentList.insert (m_sentList.end (), item));
   m_sentSize += item->m_packet->GetSize ();
 
   return item;
@@ -308,36 +310,33 @@ TcpTxBuffer::GetTransmittedSegment (uint32_t numBytes, const SequenceNumber32 &s
   NS_ASSERT (numBytes <= m_sentSize);
   NS_ASSERT (m_sentList.size () >= 1);
 
-  auto it = m_sentList.begin ();
   bool listEdited = false;
   uint32_t s = numBytes;
 
   // Avoid to merge different packet for this retransmission if flags are
   // different.
-  for (; it != m_sentList.end(); ++it)
+  SentIndex::iterator indexIt = m_sentIndex.find (seq);
+  if (indexIt != m_sentIndex.end ())
     {
-      if ((*it)->m_startSeq == seq)
+      PacketList::iterator it = indexIt->second;
+      auto next = it;
+      next++;
+      if (next != m_sentList.end ())
         {
-          auto next = it;
-          next++;
-          if (next != m_sentList.end ())
+          // Next is not sacked... there is the possibility to merge
+          if (! (*next)->m_sacked)
             {
-              // Next is not sacked... there is the possibility to merge
-              if (! (*next)->m_sacked)
-                {
-                  s = std::min(s, (*it)->m_packet->GetSize () + (*next)->m_packet->GetSize ());
-                }
-              else
-                {
-                  // Next is sacked... better to retransmit only the first segment
-                  s = std::min(s, (*it)->m_packet->GetSize ());
-                }
+              s = std::min(s, (*it)->m_packet->GetSize () + (*next)->m_packet->GetSize ());
             }
           else
             {
+              // Next is sacked... better to retransmit only the first segment
               s = std::min(s, (*it)->m_packet->GetSize ());
             }
-          break;
+        }
+      else
+        {
+          s = std::min(s, (*it)->m_packet->GetSize ());
         }
     }
 
@@ -352,29 +351,6 @@ TcpTxBuffer::GetTransmittedSegment (uint32_t numBytes, const SequenceNumber32 &s
   return item;
 }
 
-std::pair <TcpTxBuffer::PacketList::const_iterator, SequenceNumber32>
-TcpTxBuffer::FindHighestSacked () const
-{
-  NS_LOG_FUNCTION (this);
-
-  SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-
-  auto ret = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
-
-  for (auto it = m_sentList.begin (); it != m_sentList.end (); ++it)
-    {
-      const TcpTxItem *item = *it;
-      if (item->m_sacked)
-        {
-          ret = std::make_pair (it, beginOfCurrentPacket);
-        }
-      beginOfCurrentPacket += item->m_packet->GetSize ();
-    }
-
-  return ret;
-}
-
-
 void
 TcpTxBuffer::SplitItems (TcpTxItem *t1, TcpTxItem *t2, uint32_t size) const
 {
@@ -398,7 +374,7 @@ TcpTxBuffer::SplitItems (TcpTxItem *t1, TcpTxItem *t2, uint32_t size) const
 TcpTxItem*
 TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listStartFrom,
                                 uint32_t numBytes, const SequenceNumber32 &seq,
-                                bool *listEdited) const
+                                bool *listEdited)
 {
   NS_LOG_FUNCTION (this << numBytes << seq);
 
@@ -434,6 +410,15 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
   TcpTxItem *outItem = nullptr;
   PacketList::iterator it = list.begin ();
   SequenceNumber32 beginOfCurrentPacket = listStartFrom;
+  bool indexed = (&list == &m_sentList);
+
+  if (indexed && !list.empty ())
+    {
+      // Items of the sent list know their sequence: jump directly to the
+      // one that contains seq instead of walking the list from its head
+      it = FindSentItem (seq);
+      beginOfCurrentPacket = (*it)->m_startSeq;
+    }
 
   while (it != list.end ())
     {
@@ -469,7 +454,12 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
               SplitItems (firstPart, currentItem, seq - beginOfCurrentPacket);
 
               // insert firstPart before currentItem
-              list.insert (it, firstPart);
+              PacketList::iterator firstPartIt = list.insert (it, firstPart);
+              if (indexed)
+                {
+                  IndexSentItem (firstPartIt);
+                  IndexSentItem (it);
+                }
               if (listEdited)
                 {
                   *listEdited = true;
@@ -515,6 +505,10 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
                   NS_ASSERT (it != list.begin ());
                   TcpTxItem *previous = *(--it);
 
+                  if (indexed)
+                    {
+                      m_sentIndex.erase (previous->m_startSeq);
+                    }
                   list.erase (it);
 
                   MergeItems (previous, currentItem);
@@ -535,7 +529,12 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
               SplitItems (firstPart, currentItem, numBytes);
 
               // insert firstPart before currentItem
-              list.insert (it, firstPart);
+              PacketList::iterator firstPartIt = list.insert (it, firstPart);
+              if (indexed)
+                {
+                  IndexSentItem (firstPartIt);
+                  IndexSentItem (it);
+                }
               if (listEdited)
                 {
                   *listEdited = true;
@@ -564,6 +563,10 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
                                    // in the previous if
 
           MergeItems (currentItem, next);
+          if (indexed)
+            {
+              m_sentIndex.erase (next->m_startSeq);
+            }
           list.erase (it);
 
           delete next;
@@ -580,6 +583,48 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
   NS_FATAL_ERROR ("This point is not reachable");
 }
 
+TcpTxBuffer::PacketList::iterator
+TcpTxBuffer::FindSentItem (const SequenceNumber32 &seq)
+{
+  NS_LOG_FUNCTION (this << seq);
+
+  SentIndex::iterator it = m_sentIndex.upper_bound (seq);
+  if (it == m_sentIndex.begin ())
+    {
+      return m_sentList.begin ();
+    }
+  --it;
+  NS_ASSERT_MSG ((*it->second)->m_startSeq == it->first,
+                 "Index of the sent list out of sync: " << it->first <<
+                 " points to " << *(*it->second));
+  return it->second;
+}
+
+TcpTxBuffer::PacketList::const_iterator
+TcpTxBuffer::FindSentItem (const SequenceNumber32 &seq) const
+{
+  return const_cast<TcpTxBuffer *> (this)->FindSentItem (seq);
+}
+
+void
+TcpTxBuffer::RewindNextSegHints (const SequenceNumber32 &seq, bool lostOnly) const
+{
+  if (seq < m_nextSegLostHint)
+    {
+      m_nextSegLostHint = seq;
+    }
+  if (!lostOnly && seq < m_nextSegUnsackedHint)
+    {
+      m_nextSegUnsackedHint = seq;
+    }
+}
+
+void
+TcpTxBuffer::IndexSentItem (PacketList::iterator it)
+{
+  m_sentIndex[(*it)->m_startSeq] = it;
+}
+
 static bool AreEquals (const bool &first, const bool &second)
 {
   return first ? second : !second;
@@ -602,6 +647,7 @@ TcpTxBuffer::MergeItems (TcpTxItem *t1, TcpTxItem *t2) const
   // be updated in GetTransmittedSegment.
   if (! AreEquals (t1->m_retrans, t2->m_retrans))
     {
+      RewindNextSegHints (t1->m_startSeq, false);
       if (t1->m_retrans)
         {
           TcpTxBuffer *self = const_cast<TcpTxBuffer*> (this);
@@ -693,6 +739,7 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq)
 
           RemoveFromCounts (item, pktSize);
 
+          m_sentIndex.erase (item->m_startSeq);
           i = m_sentList.erase (i);
           NS_LOG_INFO ("Removed " << *item << " lost: " << m_lostOut <<
                        " retrans: " << m_retrans << " sacked: " << m_sackedOut <<
@@ -705,7 +752,9 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq)
           NS_LOG_INFO (*item);
           // PacketTags are preserved when fragmenting
           item->m_packet = item->m_packet->CreateFragment (offset, pktSize);
+          m_sentIndex.erase (item->m_startSeq);
           item->m_startSeq += offset;
+          IndexSentItem (i);
           m_size -= offset;
           m_sentSize -= offset;
           m_firstByteSeq += offset;
@@ -735,6 +784,7 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq)
           // when adding Reno dupacks in the count.
           head->m_sacked = false;
           m_sackedOut -= head->m_packet->GetSize ();
+          RewindNextSegHints (head->m_startSeq, false);
           NS_LOG_INFO ("Moving the SACK flag from the HEAD to another segment");
           AddRenoSack ();
           MarkHeadAsLost ();
@@ -749,6 +799,14 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq)
     {
       m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
     }
+  if (m_nextSegLostHint < m_firstByteSeq)
+    {
+      m_nextSegLostHint = m_firstByteSeq;
+    }
+  if (m_nextSegUnsackedHint < m_firstByteSeq)
+    {
+      m_nextSegUnsackedHint = m_firstByteSeq;
+    }
 
   NS_LOG_DEBUG ("Discarded up to " << seq << " lost: " << m_lostOut <<
                 " retrans: " << m_retrans << " sacked: " << m_sackedOut);
@@ -768,15 +826,21 @@ TcpTxBuffer::Update (const TcpOptionSack::SackList &list)
 
   for (auto option_it = list.begin (); option_it != list.end (); ++option_it)
     {
-      PacketList::iterator item_it = m_sentList.begin ();
-      SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-
       if (m_firstByteSeq + m_sentSize < (*option_it).first && !modified)
         {
           NS_LOG_INFO ("Not updating scoreboard, the option block is outside the sent list");
           return false;
         }
 
+      // Items before the one containing the start of the block cannot be
+      // mapped over it, so start the walk from there
+      PacketList::iterator item_it = FindSentItem ((*option_it).first);
+      SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
+      if (item_it != m_sentList.end ())
+        {
+          beginOfCurrentPacket = (*item_it)->m_startSeq;
+        }
+
       while (item_it != m_sentList.end ())
         {
           uint32_t pktSize = (*item_it)->m_packet->GetSize ();
@@ -865,6 +929,7 @@ TcpTxBuffer::UpdateLostCount ()
                    ", will start from item " << *(*m_highestSack.first));
     }
 
+  bool complete = true;
   for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
     {
       TcpTxItem *item = *it;
@@ -875,10 +940,18 @@ TcpTxBuffer::UpdateLostCount ()
 
       if (sacked >= m_dupAckThresh)
         {
+          if (item->m_lost && m_lostIsContiguous)
+            {
+              // Everything before this item is already lost or sacked
+              NS_LOG_INFO ("Stopping at the already lost item " << *item);
+              complete = false;
+              break;
+            }
           if (!item->m_sacked && !item->m_lost)
             {
               item->m_lost = true;
               m_lostOut += item->m_packet->GetSize ();
+              RewindNextSegHints (item->m_startSeq, true);
             }
         }
       beginOfCurrentPacket -= item->m_packet->GetSize ();
@@ -891,6 +964,11 @@ TcpTxBuffer::UpdateLostCount ()
         {
           item->m_lost = true;
           m_lostOut += item->m_packet->GetSize ();
+          RewindNextSegHints (item->m_startSeq, true);
+        }
+      if (complete)
+        {
+          m_lostIsContiguous = true;
         }
     }
   NS_LOG_INFO ("Status after the update: " << *this);
@@ -902,35 +980,31 @@ TcpTxBuffer::IsLost (const SequenceNumber32 &seq) const
 {
   NS_LOG_FUNCTION (this << seq);
 
-  SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-  PacketList::const_iterator it;
-
   if (seq >= m_highestSack.second)
     {
       return false;
     }
 
-  // In theory, using a map and hints when inserting elements can improve
-  // performance
-  for (it = m_sentList.begin (); it != m_sentList.end (); ++it)
+  // Start from the first item that begins at or after seq
+  SentIndex::const_iterator first = m_sentIndex.lower_bound (seq);
+  if (first == m_sentIndex.end ())
     {
-      // Search for the right iterator before calling IsLost()
-      if (beginOfCurrentPacket >= seq)
-        {
-          if ((*it)->m_lost == true)
-            {
-              NS_LOG_INFO ("seq=" << seq << " is lost because of lost flag");
-              return true;
-            }
+      return false;
+    }
 
-          if ((*it)->m_sacked == true)
-            {
-              NS_LOG_INFO ("seq=" << seq << " is not lost because of sacked flag");
-              return false;
-            }
+  for (PacketList::const_iterator it = first->second; it != m_sentList.end (); ++it)
+    {
+      if ((*it)->m_lost == true)
+        {
+          NS_LOG_INFO ("seq=" << seq << " is lost because of lost flag");
+          return true;
         }
 
-      beginOfCurrentPacket += (*it)->m_packet->GetSize ();
+      if ((*it)->m_sacked == true)
+        {
+          NS_LOG_INFO ("seq=" << seq << " is not lost because of sacked flag");
+          return false;
+        }
     }
 
   return false;
@@ -954,35 +1028,26 @@ TcpTxBuffer::NextSeg (SequenceNumber32 *seq, bool isRecovery) const
    *
    *     (1.c) IsLost (S2) returns true.
    */
-  PacketList::const_iterator it;
-  TcpTxItem *item;
-  SequenceNumber32 seqPerRule3;
-  bool isSeqPerRule3Valid = false;
-  SequenceNumber32 beginOfCurrentPkt = m_firstByteSeq;
-
-  for (it = m_sentList.begin (); it != m_sentList.end (); ++it)
+  // Every sent byte before m_nextSegLostHint is known not to be in a lost,
+  // unSACKed and not retransmitted item, so the walk resumes from there;
+  // without lost bytes, rule (1) cannot match at all
+  if (m_lostOut > 0)
     {
-      item = *it;
-
-      // Condition 1.a , 1.b , and 1.c
-      if (item->m_retrans == false && item->m_sacked == false)
+      SequenceNumber32 from = std::max (m_nextSegLostHint, m_firstByteSeq.Get ());
+      for (PacketList::const_iterator it = FindSentItem (from); it != m_sentList.end (); ++it)
         {
-          if (item->m_lost)
+          const TcpTxItem *item = *it;
+
+          // Condition 1.a , 1.b , and 1.c
+          if (item->m_retrans == false && item->m_sacked == false && item->m_lost)
             {
-              NS_LOG_INFO("IsLost, returning" << beginOfCurrentPkt);
-              *seq = beginOfCurrentPkt;
+              NS_LOG_INFO("IsLost, returning" << item->m_startSeq);
+              m_nextSegLostHint = item->m_startSeq;
+              *seq = item->m_startSeq;
               return true;
             }
-          else if (seqPerRule3.GetValue () == 0 && isRecovery)
-            {
-              NS_LOG_INFO ("Saving for rule 3 the seq " << beginOfCurrentPkt);
-              isSeqPerRule3Valid = true;
-              seqPerRule3 = beginOfCurrentPkt;
-            }
         }
-
-      // Nothing found, iterate
-      beginOfCurrentPkt += item->m_packet->GetSize ();
+      m_nextSegLostHint = m_firstByteSeq + m_sentSize;
     }
 
   /* (2) If no sequence number 'S2' per rule (1) exists but there
@@ -1008,11 +1073,23 @@ TcpTxBuffer::NextSeg (SequenceNumber32 *seq, bool isRecovery) const
    *     (specifically excluding step (1.c)), then one segment of up to
    *     SMSS octets starting with S3 SHOULD be returned.
    */
-  if (isSeqPerRule3Valid)
+  if (isRecovery)
     {
-      NS_LOG_INFO ("Rule3 valid. " << seqPerRule3);
-      *seq = seqPerRule3;
-      return true;
+      // As rule (1) failed, the first unSACKed and not retransmitted item
+      // is not lost
+      SequenceNumber32 from = std::max (m_nextSegUnsackedHint, m_firstByteSeq.Get ());
+      for (PacketList::const_iterator it = FindSentItem (from); it != m_sentList.end (); ++it)
+        {
+          const TcpTxItem *item = *it;
+          if (item->m_retrans == false && item->m_sacked == false)
+            {
+              NS_LOG_INFO ("Rule3 valid. " << item->m_startSeq);
+              m_nextSegUnsackedHint = item->m_startSeq;
+              *seq = item->m_startSeq;
+              return true;
+            }
+        }
+      m_nextSegUnsackedHint = m_firstByteSeq + m_sentSize;
     }
 
   /* (4) If the conditions for (1), (2), and (3) fail, but there exists
@@ -1184,6 +1261,9 @@ TcpTxBuffer::ResetRenoSack ()
     {
       (*it)->m_sacked = false;
     }
+  // Lost items may now follow items that are neither lost nor sacked
+  m_lostIsContiguous = false;
+  RewindNextSegHints (m_firstByteSeq, false);
 
   m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
 }
@@ -1202,6 +1282,9 @@ TcpTxBuffer::ResetSentList ()
       m_appList.push_front (item);
       m_sentList.pop_back ();
     }
+  m_sentIndex.clear ();
+  m_lostIsContiguous = true;
+  RewindNextSegHints (m_firstByteSeq, false);
 
   m_sentSize = 0;
   m_lostOut = 0;
@@ -1218,6 +1301,7 @@ TcpTxBuffer::ResetLastSegmentSent ()
     {
       TcpTxItem *item = m_sentList.back ();
 
+      m_sentIndex.erase (item->m_startSeq);
       m_sentList.pop_back ();
       m_sentSize -= item->m_packet->GetSize ();
       if (item->m_retrans)
@@ -1225,6 +1309,8 @@ TcpTxBuffer::ResetLastSegmentSent ()
           m_retrans -= item->m_packet->GetSize ();
         }
       m_appList.insert (m_appList.begin (), item);
+      // the data will be sent again, possibly in several items
+      RewindNextSegHints (item->m_startSeq, false);
     }
   ConsistencyCheck ();
 }
@@ -1270,6 +1356,8 @@ TcpTxBuffer::SetSentListLost (bool resetSack)
 
       (*it)->m_retrans = false;
     }
+  m_lostIsContiguous = true;
+  RewindNextSegHints (m_firstByteSeq, false);
 
   NS_LOG_INFO ("Set sent list lost, status: " << *this);
   NS_ASSERT_MSG (m_sentSize >= m_sackedOut + m_lostOut, *this);
@@ -1303,6 +1391,7 @@ TcpTxBuffer::DeleteRetransmittedFlagFromHead ()
     {
       m_sentList.front ()->m_retrans = false;
       m_retrans -= m_sentList.front ()->m_packet->GetSize ();
+      RewindNextSegHints (m_firstByteSeq, false);
     }
   ConsistencyCheck ();
 }
@@ -1332,6 +1421,7 @@ TcpTxBuffer::MarkHeadAsLost ()
           m_sentList.front()->m_lost = true;
           m_lostOut += m_sentList.front ()->m_packet->GetSize ();
         }
+      RewindNextSegHints (m_firstByteSeq, false);
     }
   ConsistencyCheck ();
 }
@@ -1384,8 +1474,15 @@ TcpTxBuffer::ConsistencyCheck () const
   uint32_t lost = 0;
   uint32_t retrans = 0;
 
+  NS_ASSERT_MSG (m_sentIndex.size () == m_sentList.size (),
+                 "Indexed items: " << m_sentIndex.size () <<
+                 " sent items: " << m_sentList.size ());
+
   for (auto it = m_sentList.begin (); it != m_sentList.end (); ++it)
     {
+      SentIndex::const_iterator indexIt = m_sentIndex.find ((*it)->m_startSeq);
+      NS_ASSERT_MSG (indexIt != m_sentIndex.end () && indexIt->second == it,
+                     "Item " << *(*it) << " is not indexed");
       if ((*it)->m_sacked)
         {
           sacked += (*it)->m_packet->GetSize ();
@@ -28,6 +28,7 @@
 #include "ns3/nstime.h"
 #include "ns3/tcp-option-sack.h"
 #include "ns3/packet.h"
+#include <map>
 
 namespace ns3 {
 class Packet;
@@ -426,8 +427,9 @@ private:
    * The {New}Reno cases, for now, are managed in TcpSocketBase through the
    * call to MarkHeadAsLost.
    * This function is, therefore, called after a SACK option has been received,
-   * and updates the lost count. It can be probably optimized by not walking
-   * the entire list, but a subset.
+   * and updates the lost count. The walk starts from the highest SACKed item
+   * and stops at the first item already marked as lost, since every item
+   * before it is known to be either lost or SACKed (see m_lostIsContiguous).
    *
    */
   void UpdateLostCount ();
@@ -560,7 +562,30 @@ private:
    */
   TcpTxItem* GetPacketFromList (PacketList &list, const SequenceNumber32 &startingSeq,
                                 uint32_t numBytes, const SequenceNumber32 &requestedSeq,
-                                bool *listEdited = nullptr) const;
+                                bool *listEdited = nullptr);
+
+  /**
+   * \brief Find the item of the sent list that contains a sequence number
+   *
+   * The lookup goes through m_sentIndex, and takes O(log n) in the number of
+   * items in the sent list.
+   *
+   * \param seq the sequence number
+   * \return the item that contains seq, or the head of the sent list if seq
+   * is before it
+   */
+  PacketList::iterator FindSentItem (const SequenceNumber32 &seq);
+
+  /**
+   * \copydoc FindSentItem
+   */
+  PacketList::const_iterator FindSentItem (const SequenceNumber32 &seq) const;
+
+  /**
+   * \brief Add an item of the sent list to m_sentIndex
+   * \param it the item, which must already be in the sent list
+   */
+  void IndexSentItem (PacketList::iterator it);
 
   /**
    * \brief Merge two TcpTxItem
@@ -593,14 +618,19 @@ private:
   void ConsistencyCheck () const;
 
   /**
-   * \brief Find the highest SACK byte
-   * \return a pair with the highest byte and an iterator inside m_sentList
+   * \brief Move the NextSeg hints back to a sequence whose item may have
+   * become a candidate for retransmission
+   *
+   * \param seq the start of the item
+   * \param lostOnly true if the item may only have become lost
    */
-  std::pair <TcpTxBuffer::PacketList::const_iterator, SequenceNumber32>
-  FindHighestSacked () const;
+  void RewindNextSegHints (const SequenceNumber32 &seq, bool lostOnly) const;
+
+  typedef std::map<SequenceNumber32, PacketList::iterator> SentIndex; //!< index of the sent items by starting sequence
 
   PacketList m_appList;  //!< Buffer for application data
   PacketList m_sentList; //!< Buffer for sent (but not acked) data
+  SentIndex m_sentIndex; //!< Items of m_sentList, indexed by their starting sequence
   uint32_t m_maxBuffer;  //!< Max number of data bytes in buffer (SND.WND)
   uint32_t m_size;       //!< Size of all data in this buffer
   uint32_t m_sentSize;   //!< Size of sent (and not discarded) segments
@@ -615,6 +645,12 @@ private:
   uint32_t m_dupAckThresh {0}; //!< Duplicate Ack threshold from TcpSocketBase
   uint32_t m_segmentSize {0}; //!< Segment size from TcpSocketBase
   bool     m_renoSack {false}; //!< Indicates if AddRenoSack was called
+  bool     m_lostIsContiguous {true}; //!< Every lost item is preceded only by lost or sacked items
+
+  // NextSeg resumes its walks from these sequences, as every sent byte
+  // before them is known not to be in a candidate item
+  mutable SequenceNumber32 m_nextSegLostHint {0};     //!< No lost, unSACKed and not retransmitted byte before it (rule 1)
+  mutable SequenceNumber32 m_nextSegUnsackedHint {0}; //!< No unSACKed and not retransmitted byte before it (rule 3)
 
 };
 
@@ -0,0 +1,233 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv4-interface-address.h"
+#include "ns3/ipv6-interface.h"
+#include "../model/ipv4-end-point.h"
+#include "../model/ipv4-end-point-demux.h"
+#include "../model/ipv6-end-point.h"
+#include "../model/ipv6-end-point-demux.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 EndPoint Demux lookup precedence Test
+ */
+class Ipv4EndPointDemuxLookupTestCase : public TestCase
+{
+public:
+  Ipv4EndPointDemuxLookupTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \brief Lookup a four-tuple and return the single match (if any)
+   * \param demux the demux
+   * \param daddr destination address
+   * \param dport destination port
+   * \param saddr source address
+   * \param sport source port
+   * \param incomingInterface the incoming interface
+   * \return the matching endpoint, or 0
+   */
+  Ipv4EndPoint * LookupOne (Ipv4EndPointDemux &demux,
+                            Ipv4Address daddr, uint16_t dport,
+                            Ipv4Address saddr, uint16_t sport,
+                            Ptr<Ipv4Interface> incomingInterface);
+};
+
+Ipv4EndPointDemuxLookupTestCase::Ipv4EndPointDemuxLookupTestCase ()
+  : TestCase ("Check the IPv4 endpoint demux lookup precedence and re-indexing")
+{
+}
+
+Ipv4EndPoint *
+Ipv4EndPointDemuxLookupTestCase::LookupOne (Ipv4EndPointDemux &demux,
+                                            Ipv4Address daddr, uint16_t dport,
+                                            Ipv4Address saddr, uint16_t sport,
+                                            Ptr<Ipv4Interface> incomingInterface)
+{
+  Ipv4EndPointDemux::EndPoints endPoints = demux.Lookup (daddr, dport, saddr, sport, incomingInterface);
+  return endPoints.empty () ? 0 : endPoints.front ();
+}
+
+void
+Ipv4EndPointDemuxLookupTestCase::DoRun (void)
+{
+  Ipv4Address local ("10.0.0.1");
+  Ipv4Address subnet ("10.0.0.0");
+  Ipv4Address peer ("10.0.0.2");
+
+  Ptr<Ipv4Interface> interface = CreateObject<Ipv4Interface> ();
+  interface->AddAddress (Ipv4InterfaceAddress (local, Ipv4Mask ("255.255.255.0")));
+
+  Ipv4EndPointDemux demux;
+
+  // listening socket on any address
+  Ipv4EndPoint *listenAny = demux.Allocate (0, Ipv4Address::GetAny (), 9);
+  NS_TEST_ASSERT_MSG_NE (listenAny, 0, "Listening endpoint not allocated");
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, local, 9, peer, 1000, interface), listenAny, "Wildcard match expected");
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, local, 10, peer, 1000, interface), 0, "No match expected on another port");
+
+  // a listening socket on the local address has precedence
+  Ipv4EndPoint *listenLocal = demux.Allocate (0, local, 9);
+  NS_TEST_ASSERT_MSG_NE (listenLocal, 0, "Listening endpoint not allocated");
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, local, 9, peer, 1000, interface), listenLocal, "Local address match expected");
+
+  // a connected socket has precedence for its four-tuple only
+  Ipv4EndPoint *connected = demux.Allocate (0, local, 9, peer, 1000);
+  NS_TEST_ASSERT_MSG_NE (connected, 0, "Connected endpoint not allocated");
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, local, 9, peer, 1000, interface), connected, "Exact match expected");
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, local, 9, peer, 1001, interface), listenLocal, "Local address match expected");
+  NS_TEST_EXPECT_MSG_EQ (demux.Allocate (0, local, 9, peer, 1000), 0, "Duplicated endpoint allocated");
+  NS_TEST_EXPECT_MSG_EQ (demux.SimpleLookup (local, 9, peer, 1000), connected, "Exact match expected");
+
+  // a socket bound to the subnet and connected to the peer
+  Ipv4EndPoint *subnetConnected = demux.Allocate (0, subnet, 9, peer, 2000);
+  NS_TEST_ASSERT_MSG_NE (subnetConnected, 0, "Subnet endpoint not allocated");
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, Ipv4Address ("10.0.0.255"), 9, peer, 2000, interface), subnetConnected,
+                         "Subnet-directed match expected");
+
+  // disabled endpoints are skipped
+  connected->SetRxEnabled (false);
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, local, 9, peer, 1000, interface), listenLocal, "Disabled endpoint matched");
+  connected->SetRxEnabled (true);
+
+  // an endpoint is re-indexed when its four-tuple changes
+  Ipv4EndPoint *client = demux.Allocate (Ipv4Address::GetAny ());
+  NS_TEST_ASSERT_MSG_NE (client, 0, "Ephemeral endpoint not allocated");
+  uint16_t port = client->GetLocalPort ();
+  NS_TEST_EXPECT_MSG_EQ (demux.LookupPortLocal (port), true, "Ephemeral port not in use");
+  client->SetPeer (peer, 80);
+  client->SetLocalAddress (local);
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, local, port, peer, 80, interface), client, "Re-indexed endpoint not found");
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, local, port, peer, 81, interface), 0, "No match expected for another peer");
+  client->SetPeer (Ipv4Address::GetAny (), 0);
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, local, port, peer, 81, interface), client, "Wildcard match expected");
+
+  // deallocation
+  demux.DeAllocate (client);
+  NS_TEST_EXPECT_MSG_EQ (demux.LookupPortLocal (port), false, "Ephemeral port still in use");
+  demux.DeAllocate (connected);
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, local, 9, peer, 1000, interface), listenLocal, "Local address match expected");
+  NS_TEST_EXPECT_MSG_EQ (demux.GetAllEndPoints ().size (), 3, "Wrong number of endpoints");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv6 EndPoint Demux lookup precedence Test
+ */
+class Ipv6EndPointDemuxLookupTestCase : public TestCase
+{
+public:
+  Ipv6EndPointDemuxLookupTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \brief Lookup a four-tuple and return the single match (if any)
+   * \param demux the demux
+   * \param daddr destination address
+   * \param dport destination port
+   * \param saddr source address
+   * \param sport source port
+   * \return the matching endpoint, or 0
+   */
+  Ipv6EndPoint * LookupOne (Ipv6EndPointDemux &demux,
+                            Ipv6Address daddr, uint16_t dport,
+                            Ipv6Address saddr, uint16_t sport);
+};
+
+Ipv6EndPointDemuxLookupTestCase::Ipv6EndPointDemuxLookupTestCase ()
+  : TestCase ("Check the IPv6 endpoint demux lookup precedence and re-indexing")
+{
+}
+
+Ipv6EndPoint *
+Ipv6EndPointDemuxLookupTestCase::LookupOne (Ipv6EndPointDemux &demux,
+                                            Ipv6Address daddr, uint16_t dport,
+                                            Ipv6Address saddr, uint16_t sport)
+{
+  Ipv6EndPointDemux::EndPoints endPoints = demux.Lookup (daddr, dport, saddr, sport, 0);
+  return endPoints.empty () ? 0 : endPoints.front ();
+}
+
+void
+Ipv6EndPointDemuxLookupTestCase::DoRun (void)
+{
+  Ipv6Address local ("2001:1::1");
+  Ipv6Address peer ("2001:1::2");
+
+  Ipv6EndPointDemux demux;
+
+  Ipv6EndPoint *listenAny = demux.Allocate (0, Ipv6Address::GetAny (), 9);
+  NS_TEST_ASSERT_MSG_NE (listenAny, 0, "Listening endpoint not allocated");
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, local, 9, peer, 1000), listenAny, "Wildcard match expected");
+
+  Ipv6EndPoint *listenLocal = demux.Allocate (0, local, 9);
+  NS_TEST_ASSERT_MSG_NE (listenLocal, 0, "Listening endpoint not allocated");
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, local, 9, peer, 1000), listenLocal, "Local address match expected");
+
+  Ipv6EndPoint *connected = demux.Allocate (0, local, 9, peer, 1000);
+  NS_TEST_ASSERT_MSG_NE (connected, 0, "Connected endpoint not allocated");
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, local, 9, peer, 1000), connected, "Exact match expected");
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, local, 9, peer, 1001), listenLocal, "Local address match expected");
+  NS_TEST_EXPECT_MSG_EQ (demux.Allocate (0, local, 9, peer, 1000), 0, "Duplicated endpoint allocated");
+
+  Ipv6EndPoint *client = demux.Allocate (Ipv6Address::GetAny ());
+  NS_TEST_ASSERT_MSG_NE (client, 0, "Ephemeral endpoint not allocated");
+  uint16_t port = client->GetLocalPort ();
+  client->SetPeer (peer, 80);
+  client->SetLocalAddress (local);
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, local, port, peer, 80), client, "Re-indexed endpoint not found");
+  client->SetLocalPort (port + 1);
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, local, port, peer, 80), 0, "Endpoint found on its old port");
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, local, port + 1, peer, 80), client, "Endpoint not found on its new port");
+
+  demux.DeAllocate (client);
+  NS_TEST_EXPECT_MSG_EQ (demux.LookupPortLocal (port + 1), false, "Port still in use");
+  demux.DeAllocate (connected);
+  NS_TEST_EXPECT_MSG_EQ (LookupOne (demux, local, 9, peer, 1000), listenLocal, "Local address match expected");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief EndPoint Demux TestSuite
+ */
+class EndPointDemuxTestSuite : public TestSuite
+{
+public:
+  EndPointDemuxTestSuite ();
+};
+
+EndPointDemuxTestSuite::EndPointDemuxTestSuite ()
+  : TestSuite ("end-point-demux", UNIT)
+{
+  AddTestCase (new Ipv4EndPointDemuxLookupTestCase (), TestCase::QUICK);
+  AddTestCase (new Ipv6EndPointDemuxLookupTestCase (), TestCase::QUICK);
+}
+
+static EndPointDemuxTestSuite g_endPointDemuxTestSuite; //!< Static variable for test initialization
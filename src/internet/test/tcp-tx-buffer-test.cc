@@ -49,6 +49,8 @@ private:
   void TestTransmittedBlock ();
   /** \brief Test the generation of the "next" block */
   void TestNextSeg ();
+  /** \brief Test the scoreboard of a large window with many holes */
+  void TestLargeScoreboard ();
 };
 
 TcpTxBufferTestCase::TcpTxBufferTestCase ()
@@ -82,6 +84,13 @@ TcpTxBufferTestCase::DoRun ()
   Simulator::Schedule (Seconds (0.0),
                        &TcpTxBufferTestCase::TestNextSeg, this);
 
+  /*
+   * Many SACKed segments, each one followed by a hole, then retransmission
+   * of the holes and cumulative ACKs through the window
+   */
+  Simulator::Schedule (Seconds (0.0),
+                       &TcpTxBufferTestCase::TestLargeScoreboard, this);
+
   Simulator::Run ();
   Simulator::Destroy ();
 }
@@ -342,6 +351,83 @@ TcpTxBufferTestCase::TestTransmittedBlock ()
 {
 }
 
+void
+TcpTxBufferTestCase::TestLargeScoreboard ()
+{
+  TcpTxBuffer txBuf;
+  SequenceNumber32 head (1);
+  const uint32_t segSize = 1000;
+  const uint32_t segments = 2000;
+  txBuf.SetHeadSequence (head);
+  txBuf.SetSegmentSize (segSize);
+  txBuf.SetDupAckThresh (3);
+  txBuf.SetMaxBufferSize (segments * segSize);
+
+  txBuf.Add (Create<Packet> (segments * segSize));
+  for (uint32_t i = 0; i < segments; ++i)
+    {
+      txBuf.CopyFromSequence (segSize, head + i * segSize);
+    }
+
+  // SACK every odd segment, leaving a hole in each even one. A hole is lost
+  // when at least three SACKed segments are above it.
+  uint32_t blocks = segments / 2;
+  for (uint32_t i = 0; i < blocks; ++i)
+    {
+      Ptr<TcpOptionSack> sack = CreateObject<TcpOptionSack> ();
+      SequenceNumber32 start = head + (2 * i + 1) * segSize;
+      sack->AddSackBlock (TcpOptionSack::SackBlock (start, start + segSize));
+      NS_TEST_ASSERT_MSG_EQ (txBuf.Update (sack->GetSackList ()), true,
+                             "SACK block not mapped over the sent list");
+      uint32_t lost = i >= 2 ? (i - 1) * segSize : 0;
+      NS_TEST_ASSERT_MSG_EQ (txBuf.GetLost (), lost, "Wrong lost count");
+      NS_TEST_ASSERT_MSG_EQ (txBuf.GetSacked (), (i + 1) * segSize,
+                             "Wrong sacked count");
+    }
+
+  // A duplicate SACK does not change the scoreboard
+  Ptr<TcpOptionSack> sack = CreateObject<TcpOptionSack> ();
+  sack->AddSackBlock (TcpOptionSack::SackBlock (head + segSize, head + 2 * segSize));
+  txBuf.Update (sack->GetSackList ());
+  NS_TEST_ASSERT_MSG_EQ (txBuf.GetSacked (), blocks * segSize, "Wrong sacked count");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.GetLost (), (blocks - 2) * segSize, "Wrong lost count");
+
+  for (uint32_t i = 0; i < blocks; ++i)
+    {
+      bool lost = i < blocks - 2;
+      NS_TEST_ASSERT_MSG_EQ (txBuf.IsLost (head + 2 * i * segSize), lost,
+                             "Wrong lost status of hole " << i);
+      NS_TEST_ASSERT_MSG_EQ (txBuf.IsLost (head + (2 * i + 1) * segSize), false,
+                             "SACKed segment " << i << " reported as lost");
+    }
+
+  // Retransmit the lost holes, in the order given by NextSeg
+  SequenceNumber32 next;
+  for (uint32_t i = 0; i < blocks - 2; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (txBuf.NextSeg (&next, false), true,
+                             "NextSeg does not find lost segment " << i);
+      NS_TEST_ASSERT_MSG_EQ (next, head + 2 * i * segSize, "Wrong NextSeg");
+      Ptr<Packet> p = txBuf.CopyFromSequence (segSize, next);
+      NS_TEST_ASSERT_MSG_EQ (p->GetSize (), segSize, "Wrong retransmission size");
+    }
+  NS_TEST_ASSERT_MSG_EQ (txBuf.GetRetransmitsCount (), (blocks - 2) * segSize,
+                         "Wrong retransmitted count");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.NextSeg (&next, false), false,
+                         "NextSeg finds a segment but nothing is lost or unsent");
+
+  // Cumulative ACKs through the window, one hole at a time
+  for (uint32_t i = 1; i <= blocks; ++i)
+    {
+      txBuf.DiscardUpTo (head + 2 * i * segSize);
+      NS_TEST_ASSERT_MSG_EQ (txBuf.Size (), (segments - 2 * i) * segSize,
+                             "Size is different than expected");
+      // The holes left are either retransmitted or not lost
+      NS_TEST_ASSERT_MSG_EQ (txBuf.BytesInFlight (), (blocks - i) * segSize,
+                             "Wrong bytes in flight");
+    }
+}
+
 void
 TcpTxBufferTestCase::DoTeardown ()
 {
@@ -23,30 +23,131 @@
 #include "ns3/lte-enb-net-device.h"
 #include "ns3/lte-ue-net-device.h"
 #include "ns3/lte-spectrum-phy.h"
+#include "ns3/lte-enb-phy.h"
+#include "ns3/lte-ue-phy.h"
+#include "ns3/spectrum-channel.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/antenna-model.h"
+#include "ns3/mobility-model.h"
+#include "ns3/simulator.h"
+#include "ns3/abort.h"
 
 #include <limits>
+#include <algorithm>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("LteGlobalPathlossDatabase");
 
+LteGlobalPathlossDatabase::LteGlobalPathlossDatabase (bool singlePrecision)
+  : m_singlePrecision (singlePrecision),
+    m_numRows (0),
+    m_numColumns (0)
+{
+}
+
 LteGlobalPathlossDatabase::~LteGlobalPathlossDatabase (void)
 {
+  m_snapshotEvent.Cancel ();
+}
+
+void
+LteGlobalPathlossDatabase::Resize (uint32_t numRows, uint32_t numColumns)
+{
+  NS_LOG_FUNCTION (this << numRows << numColumns);
+  numRows = std::max (numRows, m_numRows);
+  numColumns = std::max (numColumns, m_numColumns);
+  if (numRows == m_numRows && numColumns == m_numColumns)
+    {
+      return;
+    }
+  uint64_t size = (uint64_t) numRows * numColumns;
+  uint64_t maxSize = m_singlePrecision ? m_pathlossFloat.max_size () : m_pathloss.max_size ();
+  NS_ABORT_MSG_IF (size > std::numeric_limits<std::size_t>::max () || size > maxSize,
+                   "a pathloss matrix of " << numRows << " cell IDs by " << numColumns
+                                           << " IMSIs is too large; the IMSIs must be small and sequential");
+  const double infinity = std::numeric_limits<double>::infinity ();
+  if (numColumns == m_numColumns)
+    {
+      // the rows are appended
+      if (m_singlePrecision)
+        {
+          m_pathlossFloat.resize (size, infinity);
+        }
+      else
+        {
+          m_pathloss.resize (size, infinity);
+        }
+    }
+  else if (m_singlePrecision)
+    {
+      std::vector<float> pathloss (size, infinity);
+      for (std::size_t row = 0; row < m_numRows; row++)
+        {
+          std::copy (m_pathlossFloat.begin () + row * m_numColumns,
+                     m_pathlossFloat.begin () + (row + 1) * m_numColumns,
+                     pathloss.begin () + row * numColumns);
+        }
+      m_pathlossFloat.swap (pathloss);
+    }
+  else
+    {
+      std::vector<double> pathloss (size, infinity);
+      for (std::size_t row = 0; row < m_numRows; row++)
+        {
+          std::copy (m_pathloss.begin () + row * m_numColumns,
+                     m_pathloss.begin () + (row + 1) * m_numColumns,
+                     pathloss.begin () + row * numColumns);
+        }
+      m_pathloss.swap (pathloss);
+    }
+  m_numRows = numRows;
+  m_numColumns = numColumns;
+}
+
+void
+LteGlobalPathlossDatabase::Reserve (uint16_t maxCellId, uint64_t maxImsi)
+{
+  NS_LOG_FUNCTION (this << maxCellId << maxImsi);
+  NS_ABORT_MSG_IF (maxImsi >= std::numeric_limits<uint32_t>::max (), "IMSI " << maxImsi << " too large");
+  Resize (maxCellId + 1, maxImsi + 1);
+}
+
+void
+LteGlobalPathlossDatabase::SetPathloss (uint16_t cellId, uint64_t imsi, double lossDb)
+{
+  NS_LOG_FUNCTION (this << cellId << imsi << lossDb);
+  if (cellId >= m_numRows || imsi >= m_numColumns)
+    {
+      NS_ABORT_MSG_IF (imsi >= std::numeric_limits<uint32_t>::max (), "IMSI " << imsi << " too large");
+      // grow geometrically, so that the values are copied a few times only
+      Resize (cellId < m_numRows ? m_numRows : std::max<uint32_t> (cellId + 1, 2 * m_numRows),
+              imsi < m_numColumns ? m_numColumns : std::max<uint32_t> (imsi + 1, 2 * m_numColumns));
+    }
+  uint64_t index = (uint64_t) cellId * m_numColumns + imsi;
+  if (m_singlePrecision)
+    {
+      m_pathlossFloat[index] = lossDb;
+    }
+  else
+    {
+      m_pathloss[index] = lossDb;
+    }
 }
 
 void 
 LteGlobalPathlossDatabase::Print ()
 {
   NS_LOG_FUNCTION (this);
-  for (std::map<uint16_t, std::map<uint64_t, double> >::const_iterator cellIdIt = m_pathlossMap.begin ();
-       cellIdIt != m_pathlossMap.end ();
-       ++cellIdIt)
+  for (uint32_t cellId = 0; cellId < m_numRows; cellId++)
     {
-      for (std::map<uint64_t, double>::const_iterator imsiIt = cellIdIt->second.begin ();
-           imsiIt != cellIdIt->second.end ();
-           ++imsiIt)
+      for (uint32_t imsi = 0; imsi < m_numColumns; imsi++)
         {
-          std::cout << "CellId: " << cellIdIt->first << " IMSI: " << imsiIt->first << " pathloss: " << imsiIt->second << " dB" << std::endl;
+          double pathloss = GetPathloss (cellId, imsi);
+          if (pathloss != std::numeric_limits<double>::infinity ())
+            {
+              std::cout << "CellId: " << cellId << " IMSI: " << imsi << " pathloss: " << pathloss << " dB" << std::endl;
+            }
         }
     }
 }
@@ -56,20 +157,121 @@ double
 LteGlobalPathlossDatabase::GetPathloss (uint16_t cellId, uint64_t imsi)
 {
   NS_LOG_FUNCTION (this);
-  std::map<uint16_t, std::map<uint64_t, double> >::iterator cellIt = m_pathlossMap.find (cellId);
-  if (cellIt == m_pathlossMap.end())
+  if (cellId >= m_numRows || imsi >= m_numColumns)
     {
       return std::numeric_limits<double>::infinity ();
     }
-  std::map<uint64_t, double>::iterator ueIt = cellIt->second.find (imsi);
-  if (ueIt ==  cellIt->second.end())
+  uint64_t index = (uint64_t) cellId * m_numColumns + imsi;
+  return m_singlePrecision ? m_pathlossFloat[index] : m_pathloss[index];
+}
+
+void
+LteGlobalPathlossDatabase::Snapshot (NetDeviceContainer enbDevices, NetDeviceContainer ueDevices)
+{
+  NS_LOG_FUNCTION (this << enbDevices.GetN () << ueDevices.GetN ());
+  for (NetDeviceContainer::Iterator enbIt = enbDevices.Begin (); enbIt != enbDevices.End (); ++enbIt)
     {
-      return std::numeric_limits<double>::infinity ();
+      Ptr<LteEnbNetDevice> enb = (*enbIt)->GetObject<LteEnbNetDevice> ();
+      NS_ASSERT_MSG (enb != 0, "not an eNB device");
+      uint16_t cellId = enb->GetCellId ();
+      for (NetDeviceContainer::Iterator ueIt = ueDevices.Begin (); ueIt != ueDevices.End (); ++ueIt)
+        {
+          Ptr<LteUeNetDevice> ue = (*ueIt)->GetObject<LteUeNetDevice> ();
+          NS_ASSERT_MSG (ue != 0, "not a UE device");
+          Ptr<LteSpectrumPhy> txPhy;
+          Ptr<LteSpectrumPhy> rxPhy;
+          GetSpectrumPhys (enb, ue, txPhy, rxPhy);
+          Ptr<MobilityModel> txMobility = txPhy->GetMobility ();
+          Ptr<MobilityModel> rxMobility = rxPhy->GetMobility ();
+          if (txMobility == 0 || rxMobility == 0)
+            {
+              // the channel does not trace the pathloss either
+              continue;
+            }
+
+          // same computation as the PathLoss trace of the spectrum channels
+          double pathLossDb = 0;
+          Ptr<AntennaModel> txAntenna = txPhy->GetRxAntenna ();
+          if (txAntenna != 0)
+            {
+              Angles txAngles (rxMobility->GetPosition (), txMobility->GetPosition ());
+              pathLossDb -= txAntenna->GetGainDb (txAngles);
+            }
+          Ptr<AntennaModel> rxAntenna = rxPhy->GetRxAntenna ();
+          if (rxAntenna != 0)
+            {
+              Angles rxAngles (txMobility->GetPosition (), rxMobility->GetPosition ());
+              pathLossDb -= rxAntenna->GetGainDb (rxAngles);
+            }
+          Ptr<PropagationLossModel> propagationLoss = txPhy->GetChannel ()->GetPropagationLossModel ();
+          if (propagationLoss != 0)
+            {
+              pathLossDb -= propagationLoss->CalcRxPower (0, txMobility, rxMobility);
+            }
+          SetPathloss (cellId, ue->GetImsi (), pathLossDb);
+        }
+    }
+}
+
+void
+LteGlobalPathlossDatabase::EnablePeriodicSnapshots (NetDeviceContainer enbDevices, NetDeviceContainer ueDevices,
+                                                    Time period, std::string filename)
+{
+  NS_LOG_FUNCTION (this << period << filename);
+  NS_ABORT_MSG_IF (!period.IsStrictlyPositive (), "the period of the snapshots must be positive");
+  m_snapshotEnbDevices = enbDevices;
+  m_snapshotUeDevices = ueDevices;
+  m_snapshotPeriod = period;
+  if (m_snapshotFile.is_open ())
+    {
+      m_snapshotFile.close ();
+    }
+  if (!filename.empty ())
+    {
+      m_snapshotFile.open (filename.c_str (), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+      NS_ABORT_MSG_IF (!m_snapshotFile.is_open (), "cannot open " << filename);
+    }
+  m_snapshotEvent.Cancel ();
+  m_snapshotEvent = Simulator::ScheduleNow (&LteGlobalPathlossDatabase::PeriodicSnapshot, this);
+}
+
+void
+LteGlobalPathlossDatabase::PeriodicSnapshot (void)
+{
+  NS_LOG_FUNCTION (this);
+  Snapshot (m_snapshotEnbDevices, m_snapshotUeDevices);
+  if (m_snapshotFile.is_open ())
+    {
+      ExportBinary (m_snapshotFile);
+      m_snapshotFile.flush ();
+    }
+  m_snapshotEvent = Simulator::Schedule (m_snapshotPeriod, &LteGlobalPathlossDatabase::PeriodicSnapshot, this);
+}
+
+void
+LteGlobalPathlossDatabase::ExportBinary (std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t header[3] = { m_numRows, m_numColumns, m_singlePrecision ? (uint32_t) sizeof (float) : (uint32_t) sizeof (double) };
+  os.write (reinterpret_cast<const char *> (header), sizeof (header));
+  double time = Simulator::Now ().GetSeconds ();
+  os.write (reinterpret_cast<const char *> (&time), sizeof (time));
+  if (m_singlePrecision && !m_pathlossFloat.empty ())
+    {
+      os.write (reinterpret_cast<const char *> (&m_pathlossFloat[0]), m_pathlossFloat.size () * sizeof (float));
+    }
+  else if (!m_singlePrecision && !m_pathloss.empty ())
+    {
+      os.write (reinterpret_cast<const char *> (&m_pathloss[0]), m_pathloss.size () * sizeof (double));
     }
-  return ueIt->second;
 }
  
 
+DownlinkLteGlobalPathlossDatabase::DownlinkLteGlobalPathlossDatabase (bool singlePrecision)
+  : LteGlobalPathlossDatabase (singlePrecision)
+{
+}
+
 void
 DownlinkLteGlobalPathlossDatabase::UpdatePathloss (std::string context, 
                                         Ptr<SpectrumPhy> txPhy, 
@@ -78,11 +280,24 @@ DownlinkLteGlobalPathlossDatabase::UpdatePathloss (std::string context,
 {
   NS_LOG_FUNCTION (this << lossDb);
   uint16_t cellId = txPhy->GetDevice ()->GetObject<LteEnbNetDevice> ()->GetCellId ();
-  uint16_t imsi = rxPhy->GetDevice ()->GetObject<LteUeNetDevice> ()->GetImsi ();
-  m_pathlossMap[cellId][imsi] = lossDb;
+  uint64_t imsi = rxPhy->GetDevice ()->GetObject<LteUeNetDevice> ()->GetImsi ();
+  SetPathloss (cellId, imsi, lossDb);
+}
+
+void
+DownlinkLteGlobalPathlossDatabase::GetSpectrumPhys (Ptr<LteEnbNetDevice> enb, Ptr<LteUeNetDevice> ue,
+                                                    Ptr<LteSpectrumPhy> &txPhy, Ptr<LteSpectrumPhy> &rxPhy)
+{
+  txPhy = enb->GetPhy ()->GetDownlinkSpectrumPhy ();
+  rxPhy = ue->GetPhy ()->GetDownlinkSpectrumPhy ();
 }
 
 
+UplinkLteGlobalPathlossDatabase::UplinkLteGlobalPathlossDatabase (bool singlePrecision)
+  : LteGlobalPathlossDatabase (singlePrecision)
+{
+}
+
 void
 UplinkLteGlobalPathlossDatabase::UpdatePathloss (std::string context, 
                                         Ptr<SpectrumPhy> txPhy, 
@@ -90,9 +305,17 @@ UplinkLteGlobalPathlossDatabase::UpdatePathloss (std::string context,
                                         double lossDb)
 {
   NS_LOG_FUNCTION (this << lossDb);
-  uint16_t imsi = txPhy->GetDevice ()->GetObject<LteUeNetDevice> ()->GetImsi ();
+  uint64_t imsi = txPhy->GetDevice ()->GetObject<LteUeNetDevice> ()->GetImsi ();
   uint16_t cellId = rxPhy->GetDevice ()->GetObject<LteEnbNetDevice> ()->GetCellId ();
-  m_pathlossMap[cellId][imsi] = lossDb;
+  SetPathloss (cellId, imsi, lossDb);
+}
+
+void
+UplinkLteGlobalPathlossDatabase::GetSpectrumPhys (Ptr<LteEnbNetDevice> enb, Ptr<LteUeNetDevice> ue,
+                                                  Ptr<LteSpectrumPhy> &txPhy, Ptr<LteSpectrumPhy> &rxPhy)
+{
+  txPhy = ue->GetPhy ()->GetUplinkSpectrumPhy ();
+  rxPhy = enb->GetPhy ()->GetUplinkSpectrumPhy ();
 }
 
 
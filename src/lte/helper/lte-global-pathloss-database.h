@@ -24,12 +24,20 @@
 
 #include <ns3/log.h>
 #include <ns3/ptr.h>
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+#include <ns3/net-device-container.h>
 #include <string>
-#include <map>
+#include <vector>
+#include <ostream>
+#include <fstream>
 
 namespace ns3 {
 
 class SpectrumPhy;
+class LteSpectrumPhy;
+class LteEnbNetDevice;
+class LteUeNetDevice;
 
 /**
  * \ingroup lte
@@ -37,11 +45,30 @@ class SpectrumPhy;
  * Store the last pathloss value for each TX-RX pair. This is an
  * example of how the PathlossTrace (provided by some SpectrumChannel
  * implementations) work. 
- * 
+ *
+ * The values are stored in a dense matrix with a row per cell ID and a
+ * column per IMSI, which grows to the largest cell ID and IMSI seen and
+ * can be preallocated with Reserve. The IMSIs are used as column indices,
+ * so they must be small and sequential, as allocated by LteHelper: its
+ * memory is proportional to the largest cell ID times the largest IMSI,
+ * and the simulation aborts if the number of values cannot be stored in
+ * a vector.
+ * Instead of connecting UpdatePathloss
+ * to the PathlossTrace, which is called for every transmitted signal, the
+ * values can be computed from the models of the channel with Snapshot,
+ * possibly periodically with EnablePeriodicSnapshots, and written with
+ * ExportBinary for an offline analysis.
  */
 class LteGlobalPathlossDatabase
 {
 public:
+  /**
+   * Constructor
+   *
+   * \param singlePrecision if true, the pathloss values are stored as
+   * float instead of double, which halves the memory of the matrix
+   */
+  LteGlobalPathlossDatabase (bool singlePrecision = false);
 
   virtual ~LteGlobalPathlossDatabase (void);
 
@@ -55,13 +82,23 @@ public:
    */
   virtual void UpdatePathloss (std::string context, Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy, double lossDb) = 0;
 
+  /**
+   * Preallocate the matrix of the pathloss values, so that it does not
+   * grow during the simulation.
+   *
+   * \param maxCellId the largest cell ID to store
+   * \param maxImsi the largest IMSI to store
+   */
+  void Reserve (uint16_t maxCellId, uint64_t maxImsi);
+
   /** 
    * 
    * 
    * \param cellId the id of the eNB
    * \param imsi the id of the UE
    * 
-   * \return the pathloss value between the UE and the eNB
+   * \return the pathloss value between the UE and the eNB, or infinity if
+   * none is stored
    */
   double GetPathloss (uint16_t cellId, uint64_t imsi);
 
@@ -71,12 +108,100 @@ public:
    */
   void Print ();
 
+  /**
+   * Store the pathloss between each eNB and each UE, computed from the
+   * antennas, the positions and the propagation loss model of the channel
+   * like the channel computes the value of its PathlossTrace.
+   *
+   * \warning The random variables of the propagation loss models, if any,
+   * are drawn as for a transmitted signal: a snapshot consumes values of
+   * these random variables, and thus changes the results of the
+   * simulation.
+   *
+   * \param enbDevices the eNB devices
+   * \param ueDevices the UE devices
+   */
+  void Snapshot (NetDeviceContainer enbDevices, NetDeviceContainer ueDevices);
+
+  /**
+   * Take a snapshot of the pathloss between each eNB and each UE now and
+   * then every period until the end of the simulation. As with Snapshot,
+   * the snapshots change the results of the simulation when the
+   * propagation loss models are random.
+   *
+   * \param enbDevices the eNB devices
+   * \param ueDevices the UE devices
+   * \param period the time between two snapshots
+   * \param filename if not empty, the file to which each snapshot is
+   * appended with ExportBinary
+   */
+  void EnablePeriodicSnapshots (NetDeviceContainer enbDevices, NetDeviceContainer ueDevices,
+                                Time period, std::string filename = "");
+
+  /**
+   * Write the stored pathloss values in binary, in the byte order of the
+   * host:
+   *  - the number of rows of the matrix, i.e., the largest cell ID + 1
+   *    (uint32_t);
+   *  - the number of columns of the matrix, i.e., the largest IMSI + 1
+   *    (uint32_t);
+   *  - the size of each value, i.e., 4 for float or 8 for double (uint32_t);
+   *  - the current simulation time in seconds (double);
+   *  - the pathloss values in dB row by row, with infinity for the pairs
+   *    without a value.
+   *
+   * \param os the output stream
+   */
+  void ExportBinary (std::ostream &os) const;
+
 protected:
   /**
-   * List of the last pathloss value for each UE by CellId.
-   * ( CELL ID,  ( IMSI,PATHLOSS ))
+   * Store a pathloss value, growing the matrix if needed.
+   *
+   * \param cellId the id of the eNB
+   * \param imsi the id of the UE
+   * \param lossDb the loss in dB
    */
-  std::map<uint16_t, std::map<uint64_t, double> > m_pathlossMap;
+  void SetPathloss (uint16_t cellId, uint64_t imsi, double lossDb);
+
+  /**
+   * Get the PHYs of an eNB and of a UE that transmit and receive in the
+   * direction of the database.
+   *
+   * \param enb the eNB
+   * \param ue the UE
+   * \param txPhy the transmitting PHY
+   * \param rxPhy the receiving PHY
+   */
+  virtual void GetSpectrumPhys (Ptr<LteEnbNetDevice> enb, Ptr<LteUeNetDevice> ue,
+                                Ptr<LteSpectrumPhy> &txPhy, Ptr<LteSpectrumPhy> &rxPhy) = 0;
+
+private:
+  /**
+   * Take a snapshot, export it if a file was given and schedule the next one
+   */
+  void PeriodicSnapshot (void);
+
+  /**
+   * Grow the matrix, keeping the stored values. Abort if the number of
+   * values cannot be stored in a vector.
+   *
+   * \param numRows the number of rows
+   * \param numColumns the number of columns
+   */
+  void Resize (uint32_t numRows, uint32_t numColumns);
+
+  bool m_singlePrecision; ///< whether the values are stored as float
+  uint32_t m_numRows; ///< the number of rows of the matrix, one per cell ID
+  uint32_t m_numColumns; ///< the number of columns of the matrix, one per IMSI
+  std::vector<double> m_pathloss; ///< the matrix of the values, if stored as double
+  std::vector<float> m_pathlossFloat; ///< the matrix of the values, if stored as float
+
+  NetDeviceContainer m_snapshotEnbDevices; ///< the eNB devices of the periodic snapshots
+  NetDeviceContainer m_snapshotUeDevices; ///< the UE devices of the periodic snapshots
+  Time m_snapshotPeriod; ///< the period of the snapshots
+  EventId m_snapshotEvent; ///< the next periodic snapshot
+  std::ofstream m_snapshotFile; ///< the file of the periodic snapshots
 };
 
 /**
@@ -86,8 +211,20 @@ protected:
 class DownlinkLteGlobalPathlossDatabase : public LteGlobalPathlossDatabase
 {
 public:
+  /**
+   * Constructor
+   *
+   * \param singlePrecision if true, the pathloss values are stored as float
+   */
+  DownlinkLteGlobalPathlossDatabase (bool singlePrecision = false);
+
   // inherited from LteGlobalPathlossDatabase
   virtual void UpdatePathloss (std::string context, Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy, double lossDb);
+
+protected:
+  // inherited from LteGlobalPathlossDatabase
+  virtual void GetSpectrumPhys (Ptr<LteEnbNetDevice> enb, Ptr<LteUeNetDevice> ue,
+                                Ptr<LteSpectrumPhy> &txPhy, Ptr<LteSpectrumPhy> &rxPhy);
 };
 
 /**
@@ -97,8 +234,20 @@ public:
 class UplinkLteGlobalPathlossDatabase : public LteGlobalPathlossDatabase
 {
 public:
+  /**
+   * Constructor
+   *
+   * \param singlePrecision if true, the pathloss values are stored as float
+   */
+  UplinkLteGlobalPathlossDatabase (bool singlePrecision = false);
+
   // inherited from LteGlobalPathlossDatabase
   virtual void UpdatePathloss (std::string context, Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy, double lossDb);
+
+protected:
+  // inherited from LteGlobalPathlossDatabase
+  virtual void GetSpectrumPhys (Ptr<LteEnbNetDevice> enb, Ptr<LteUeNetDevice> ue,
+                                Ptr<LteSpectrumPhy> &txPhy, Ptr<LteSpectrumPhy> &rxPhy);
 };
 
 
@@ -65,6 +65,7 @@
 #include <ns3/epc-x2.h>
 #include <ns3/object-map.h>
 #include <ns3/object-factory.h>
+#include <ns3/position-kd-tree.h>
 
 namespace ns3 {
 
@@ -1033,9 +1034,26 @@ void
 LteHelper::AttachToClosestEnb (NetDeviceContainer ueDevices, NetDeviceContainer enbDevices)
 {
   NS_LOG_FUNCTION (this);
+  if (ueDevices.GetN () == 0)
+    {
+      return;
+    }
+  NS_ASSERT_MSG (enbDevices.GetN () > 0, "empty enb device container");
+
+  // index the eNBs by position, to find the closest one of each UE in O(log(n))
+  std::vector<Vector> enbPositions;
+  enbPositions.reserve (enbDevices.GetN ());
+  for (NetDeviceContainer::Iterator i = enbDevices.Begin (); i != enbDevices.End (); ++i)
+    {
+      enbPositions.push_back ((*i)->GetNode ()->GetObject<MobilityModel> ()->GetPosition ());
+    }
+  PositionKdTree enbTree;
+  enbTree.Build (enbPositions);
+
   for (NetDeviceContainer::Iterator i = ueDevices.Begin (); i != ueDevices.End (); ++i)
     {
-      AttachToClosestEnb (*i, enbDevices);
+      Vector uepos = (*i)->GetNode ()->GetObject<MobilityModel> ()->GetPosition ();
+      Attach (*i, enbDevices.Get (enbTree.FindClosest (uepos)));
     }
 }
 
@@ -421,7 +421,9 @@ public:
    * \param enbDevices the set of eNodeB devices to be considered
    * 
    * This function finds among the eNodeB set the closest eNodeB for each UE,
-   * and then invokes manual attachment between the pair.
+   * and then invokes manual attachment between the pair. The eNodeBs are
+   * indexed by position once (see PositionKdTree), so that the search
+   * takes O(log(n)) for each UE.
    * 
    * Users are encouraged to use automatic attachment (Idle mode cell selection)
    * instead of this function.
@@ -22,6 +22,7 @@
 
 #include <ns3/log.h>
 #include <ns3/config.h>
+#include <ns3/simulator.h>
 #include <ns3/lte-enb-rrc.h>
 #include <ns3/lte-ue-rrc.h>
 #include <ns3/lte-enb-net-device.h>
@@ -34,7 +35,8 @@ NS_LOG_COMPONENT_DEFINE ("LteStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (LteStatsCalculator);
 
 LteStatsCalculator::LteStatsCalculator ()
-  : m_dlOutputFilename (""),
+  : m_epochPending (false),
+    m_dlOutputFilename (""),
     m_ulOutputFilename ("")
 {
   // Nothing to do here
@@ -43,7 +45,16 @@ LteStatsCalculator::LteStatsCalculator ()
 
 LteStatsCalculator::~LteStatsCalculator ()
 {
-  // Nothing to do here
+  m_finishEvent.Cancel ();
+}
+
+void
+LteStatsCalculator::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  Finish ();
+  m_finishEvent.Cancel ();
+  Object::DoDispose ();
 }
 
 
@@ -54,10 +65,138 @@ LteStatsCalculator::GetTypeId (void)
     .SetParent<Object> ()
     .SetGroupName("Lte")
     .AddConstructor<LteStatsCalculator> ()
+    .AddAttribute ("FlushInterval",
+                   "Interval between the flushes of the output files, which "
+                   "are also flushed and closed at Simulator::Destroy.",
+                   TimeValue (Seconds (1.0)),
+                   MakeTimeAccessor (&LteStatsCalculator::m_flushInterval),
+                   MakeTimeChecker (Time (0)))
+    .AddAttribute ("AggregationEpoch",
+                   "If not zero, write one summary of the records of each epoch "
+                   "of this duration, instead of one row per record.",
+                   TimeValue (Time (0)),
+                   MakeTimeAccessor (&LteStatsCalculator::m_aggregationEpoch),
+                   MakeTimeChecker (Time (0)))
   ;
   return tid;
 }
 
+bool
+LteStatsCalculator::AggregateId::operator< (const AggregateId &other) const
+{
+  if (cellId != other.cellId)
+    {
+      return cellId < other.cellId;
+    }
+  if (imsi != other.imsi)
+    {
+      return imsi < other.imsi;
+    }
+  if (rnti != other.rnti)
+    {
+      return rnti < other.rnti;
+    }
+  return componentCarrierId < other.componentCarrierId;
+}
+
+std::ofstream *
+LteStatsCalculator::GetOutputStream (OutputFile &file, const std::string &filename,
+                                     const std::string &header)
+{
+  if (file.stream.is_open () && file.filename == filename)
+    {
+      if (Simulator::Now () >= m_nextFlush)
+        {
+          for (std::vector<OutputFile *>::iterator it = m_outputFiles.begin ();
+               it != m_outputFiles.end (); ++it)
+            {
+              (*it)->stream.flush ();
+            }
+          m_nextFlush = Simulator::Now () + m_flushInterval;
+        }
+      return &file.stream;
+    }
+
+  if (file.stream.is_open ())
+    {
+      // the file name changed
+      file.stream.close ();
+    }
+  else
+    {
+      m_outputFiles.push_back (&file);
+    }
+  file.filename = filename;
+  bool created = m_createdFiles.insert (filename).second;
+  file.stream.open (filename.c_str (), created ? std::ios_base::out : std::ios_base::app);
+  if (!file.stream.is_open ())
+    {
+      NS_LOG_ERROR ("Can't open file " << filename.c_str ());
+      m_outputFiles.pop_back ();
+      return 0;
+    }
+  if (created)
+    {
+      file.stream << header << std::endl;
+    }
+  ScheduleFinish ();
+  return &file.stream;
+}
+
+bool
+LteStatsCalculator::AggregateRecord (void)
+{
+  if (m_aggregationEpoch.IsZero ())
+    {
+      return false;
+    }
+  Time now = Simulator::Now ();
+  if (now >= m_epochStart + m_aggregationEpoch)
+    {
+      if (m_epochPending)
+        {
+          WriteAggregates (m_epochStart);
+        }
+      m_epochStart = now - TimeStep (now.GetTimeStep () % m_aggregationEpoch.GetTimeStep ());
+    }
+  m_epochPending = true;
+  ScheduleFinish ();
+  return true;
+}
+
+void
+LteStatsCalculator::WriteAggregates (Time)
+{
+}
+
+void
+LteStatsCalculator::ScheduleFinish (void)
+{
+  if (!m_finishEvent.IsRunning ())
+    {
+      m_finishEvent = Simulator::ScheduleDestroy (&LteStatsCalculator::Finish, this);
+    }
+}
+
+void
+LteStatsCalculator::Finish (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_epochPending)
+    {
+      WriteAggregates (m_epochStart);
+      m_epochPending = false;
+    }
+  m_epochStart = Time (0);
+  for (std::vector<OutputFile *>::iterator it = m_outputFiles.begin ();
+       it != m_outputFiles.end (); ++it)
+    {
+      (*it)->stream.close ();
+    }
+  m_outputFiles.clear ();
+  m_nextFlush = Time (0);
+}
+
 
 void
 LteStatsCalculator::SetUlOutputFilename (std::string outputFilename)
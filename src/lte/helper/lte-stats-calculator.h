@@ -23,7 +23,12 @@
 
 #include "ns3/object.h"
 #include "ns3/string.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
 #include <map>
+#include <set>
+#include <vector>
+#include <fstream>
 
 namespace ns3 {
 
@@ -33,6 +38,12 @@ namespace ns3 {
  * Base class for ***StatsCalculator classes. Provides
  * basic functionality to parse and store IMSI and CellId.
  * Also stores names of output files.
+ *
+ * The output files are kept open between records.  They are flushed
+ * every FlushInterval, and closed at Simulator::Destroy or when the
+ * calculator is disposed of.  When AggregationEpoch is not zero, the
+ * calculators supporting it write one summary per epoch instead of
+ * one row per record.
  */
 
 class LteStatsCalculator : public Object
@@ -123,6 +134,63 @@ public:
   uint16_t GetCellIdPath (std::string path);
 
 protected:
+  virtual void DoDispose (void);
+
+  /**
+   * An output file, kept open between records.
+   */
+  struct OutputFile
+  {
+    std::ofstream stream; //!< The stream, open after the first record
+    std::string filename; //!< The name of the file the stream writes
+  };
+
+  /**
+   * The identifiers of the records aggregated in a summary.
+   */
+  struct AggregateId
+  {
+    uint16_t cellId; //!< The cell ID
+    uint64_t imsi; //!< The IMSI
+    uint16_t rnti; //!< The C-RNTI
+    uint8_t componentCarrierId; //!< The component carrier ID
+    /**
+     * Less than operator
+     * \param other the other identifiers
+     * \return true if these identifiers sort before the other ones
+     */
+    bool operator< (const AggregateId &other) const;
+  };
+
+  /**
+   * Get the stream of an output file to write a record.  The file is
+   * created with a header line for the first record, then kept open
+   * and appended to.  The open files are flushed if the flush interval
+   * has elapsed.
+   *
+   * @param file the output file
+   * @param filename the name of the file
+   * @param header the header line
+   * @return the stream, or 0 if the file can not be opened
+   */
+  std::ofstream * GetOutputStream (OutputFile &file, const std::string &filename,
+                                   const std::string &header);
+
+  /**
+   * Start a record in aggregated mode.  If the aggregation epoch of
+   * the previous records has ended, their summaries are written first.
+   *
+   * @return true if the records are aggregated, false if they are
+   *         written one per row
+   */
+  bool AggregateRecord (void);
+
+  /**
+   * Write the summaries of an aggregation epoch and clear them.
+   *
+   * @param start the start time of the epoch
+   */
+  virtual void WriteAggregates (Time start);
 
   /**
    * Retrieves IMSI from Enb RLC path in the attribute system
@@ -185,6 +253,25 @@ protected:
   static uint64_t FindImsiForUe (std::string path, uint16_t rnti);
 
 private:
+  /**
+   * Write the pending summaries, then close the output files.
+   */
+  void Finish (void);
+
+  /**
+   * Schedule Finish at Simulator::Destroy, if not already done.
+   */
+  void ScheduleFinish (void);
+
+  Time m_flushInterval; //!< The interval between the flushes of the output files
+  Time m_nextFlush; //!< The time of the next flush of the output files
+  Time m_aggregationEpoch; //!< The duration of an aggregation epoch, or zero
+  Time m_epochStart; //!< The start time of the current aggregation epoch
+  bool m_epochPending; //!< Whether the current aggregation epoch has records
+  EventId m_finishEvent; //!< The call to Finish at Simulator::Destroy
+  std::vector<OutputFile *> m_outputFiles; //!< The open output files
+  std::set<std::string> m_createdFiles; //!< The files created, to append to
+
   /**
    * List of IMSI by path in the attribute system
    */
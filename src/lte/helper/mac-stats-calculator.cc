@@ -32,8 +32,6 @@ NS_LOG_COMPONENT_DEFINE ("MacStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (MacStatsCalculator);
 
 MacStatsCalculator::MacStatsCalculator ()
-  : m_dlFirstWrite (true),
-    m_ulFirstWrite (true)
 {
   NS_LOG_FUNCTION (this);
 
@@ -96,41 +94,36 @@ MacStatsCalculator::DlScheduling (uint16_t cellId, uint64_t imsi, DlSchedulingCa
 		  dlSchedulingCallbackInfo.rnti << (uint32_t) dlSchedulingCallbackInfo.mcsTb1 << dlSchedulingCallbackInfo.sizeTb1 << (uint32_t) dlSchedulingCallbackInfo.mcsTb2 << dlSchedulingCallbackInfo.sizeTb2);
   NS_LOG_INFO ("Write DL Mac Stats in " << GetDlOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_dlFirstWrite == true )
+  if (AggregateRecord ())
     {
-      outFile.open (GetDlOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
-          return;
-        }
-      m_dlFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcsTb1\tsizeTb1\tmcsTb2\tsizeTb2\tccId";
-      outFile << std::endl;
+      AggregateId id = { cellId, imsi, dlSchedulingCallbackInfo.rnti, dlSchedulingCallbackInfo.componentCarrierId };
+      SchedulingSummary &summary = m_dlSummaries[id];
+      summary.samples++;
+      summary.mcsTb1 += dlSchedulingCallbackInfo.mcsTb1;
+      summary.sizeTb1 += dlSchedulingCallbackInfo.sizeTb1;
+      summary.mcsTb2 += dlSchedulingCallbackInfo.mcsTb2;
+      summary.sizeTb2 += dlSchedulingCallbackInfo.sizeTb2;
+      return;
     }
-  else
+
+  std::ofstream *outFile = GetOutputStream (m_dlFile, GetDlOutputFilename (),
+                                            "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcsTb1\tsizeTb1\tmcsTb2\tsizeTb2\tccId");
+  if (outFile == 0)
     {
-      outFile.open (GetDlOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
-          return;
-        }
+      return;
     }
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << (uint32_t) cellId << "\t";
-  outFile << imsi << "\t";
-  outFile << dlSchedulingCallbackInfo.frameNo << "\t";
-  outFile << dlSchedulingCallbackInfo.subframeNo << "\t";
-  outFile << dlSchedulingCallbackInfo.rnti << "\t";
-  outFile << (uint32_t) dlSchedulingCallbackInfo.mcsTb1 << "\t";
-  outFile << dlSchedulingCallbackInfo.sizeTb1 << "\t";
-  outFile << (uint32_t) dlSchedulingCallbackInfo.mcsTb2 << "\t";
-  outFile << dlSchedulingCallbackInfo.sizeTb2 << "\t";
-  outFile << (uint32_t) dlSchedulingCallbackInfo.componentCarrierId << std::endl;
-  outFile.close ();
+  *outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
+  *outFile << (uint32_t) cellId << "\t";
+  *outFile << imsi << "\t";
+  *outFile << dlSchedulingCallbackInfo.frameNo << "\t";
+  *outFile << dlSchedulingCallbackInfo.subframeNo << "\t";
+  *outFile << dlSchedulingCallbackInfo.rnti << "\t";
+  *outFile << (uint32_t) dlSchedulingCallbackInfo.mcsTb1 << "\t";
+  *outFile << dlSchedulingCallbackInfo.sizeTb1 << "\t";
+  *outFile << (uint32_t) dlSchedulingCallbackInfo.mcsTb2 << "\t";
+  *outFile << dlSchedulingCallbackInfo.sizeTb2 << "\t";
+  *outFile << (uint32_t) dlSchedulingCallbackInfo.componentCarrierId << "\n";
 }
 
 void
@@ -140,39 +133,80 @@ MacStatsCalculator::UlScheduling (uint16_t cellId, uint64_t imsi, uint32_t frame
   NS_LOG_FUNCTION (this << cellId << imsi << frameNo << subframeNo << rnti << (uint32_t) mcsTb << size);
   NS_LOG_INFO ("Write UL Mac Stats in " << GetUlOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_ulFirstWrite == true )
+  if (AggregateRecord ())
+    {
+      AggregateId id = { cellId, imsi, rnti, componentCarrierId };
+      SchedulingSummary &summary = m_ulSummaries[id];
+      summary.samples++;
+      summary.mcsTb1 += mcsTb;
+      summary.sizeTb1 += size;
+      return;
+    }
+
+  std::ofstream *outFile = GetOutputStream (m_ulFile, GetUlOutputFilename (),
+                                            "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcs\tsize\tccId");
+  if (outFile == 0)
+    {
+      return;
+    }
+
+  *outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
+  *outFile << (uint32_t) cellId << "\t";
+  *outFile << imsi << "\t";
+  *outFile << frameNo << "\t";
+  *outFile << subframeNo << "\t";
+  *outFile << rnti << "\t";
+  *outFile << (uint32_t) mcsTb << "\t";
+  *outFile << size << "\t";
+  *outFile << (uint32_t) componentCarrierId << "\n";
+}
+
+void
+MacStatsCalculator::WriteAggregates (Time start)
+{
+  NS_LOG_FUNCTION (this << start);
+  double time = start.GetNanoSeconds () / (double) 1e9;
+
+  std::ofstream *outFile;
+  if (!m_dlSummaries.empty ()
+      && (outFile = GetOutputStream (m_dlFile, GetDlOutputFilename (),
+                                     "% start\tcellId\tIMSI\tRNTI\tsamples\tmcsTb1\tsizeTb1\tmcsTb2\tsizeTb2\tccId")) != 0)
     {
-      outFile.open (GetUlOutputFilename ().c_str ());
-      if (!outFile.is_open ())
+      for (std::map<AggregateId, SchedulingSummary>::const_iterator it = m_dlSummaries.begin ();
+           it != m_dlSummaries.end (); ++it)
         {
-          NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
-          return;
+          *outFile << time << "\t";
+          *outFile << (uint32_t) it->first.cellId << "\t";
+          *outFile << it->first.imsi << "\t";
+          *outFile << it->first.rnti << "\t";
+          *outFile << it->second.samples << "\t";
+          *outFile << (double) it->second.mcsTb1 / it->second.samples << "\t";
+          *outFile << it->second.sizeTb1 << "\t";
+          *outFile << (double) it->second.mcsTb2 / it->second.samples << "\t";
+          *outFile << it->second.sizeTb2 << "\t";
+          *outFile << (uint32_t) it->first.componentCarrierId << "\n";
         }
-      m_ulFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcs\tsize\tccId";
-      outFile << std::endl;
     }
-  else
+  m_dlSummaries.clear ();
+
+  if (!m_ulSummaries.empty ()
+      && (outFile = GetOutputStream (m_ulFile, GetUlOutputFilename (),
+                                     "% start\tcellId\tIMSI\tRNTI\tsamples\tmcs\tsize\tccId")) != 0)
     {
-      outFile.open (GetUlOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
+      for (std::map<AggregateId, SchedulingSummary>::const_iterator it = m_ulSummaries.begin ();
+           it != m_ulSummaries.end (); ++it)
         {
-          NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
-          return;
+          *outFile << time << "\t";
+          *outFile << (uint32_t) it->first.cellId << "\t";
+          *outFile << it->first.imsi << "\t";
+          *outFile << it->first.rnti << "\t";
+          *outFile << it->second.samples << "\t";
+          *outFile << (double) it->second.mcsTb1 / it->second.samples << "\t";
+          *outFile << it->second.sizeTb1 << "\t";
+          *outFile << (uint32_t) it->first.componentCarrierId << "\n";
         }
     }
-
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << (uint32_t) cellId << "\t";
-  outFile << imsi << "\t";
-  outFile << frameNo << "\t";
-  outFile << subframeNo << "\t";
-  outFile << rnti << "\t";
-  outFile << (uint32_t) mcsTb << "\t";
-  outFile << size << "\t";
-  outFile << (uint32_t) componentCarrierId << std::endl;
-  outFile.close ();
+  m_ulSummaries.clear ();
 }
 
 void
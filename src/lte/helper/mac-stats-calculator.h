@@ -44,6 +44,10 @@ namespace ns3 {
  *   - Size of transport block 1
  *   - MCS for transport block 2 (0 if not used)
  *   - Size of transport block 2 (0 if not used)
+ *
+ * In aggregated mode, one row per epoch is written for each UE, with the
+ * number of allocations, the mean MCS and the total size of the
+ * transport blocks.
  */
 class MacStatsCalculator : public LteStatsCalculator
 {
@@ -149,22 +153,25 @@ public:
                              uint8_t mcs, uint16_t size, uint8_t componentCarrierId);
 
 
-private:
-  /**
-   * When writing DL MAC statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
-   */
-  bool m_dlFirstWrite;
+protected:
+  virtual void WriteAggregates (Time start);
 
-  /**
-   * When writing UL MAC statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
-   */
-  bool m_ulFirstWrite;
+private:
+  /// The sums of the allocations of an epoch
+  struct SchedulingSummary
+  {
+    uint32_t samples; //!< The number of allocations
+    uint64_t mcsTb1; //!< The sum of the MCS of transport block 1
+    uint64_t sizeTb1; //!< The total size of transport block 1
+    uint64_t mcsTb2; //!< The sum of the MCS of transport block 2
+    uint64_t sizeTb2; //!< The total size of transport block 2
+  };
+
+  OutputFile m_dlFile; //!< The DL output file
+  OutputFile m_ulFile; //!< The UL output file
+
+  std::map<AggregateId, SchedulingSummary> m_dlSummaries; //!< The DL summaries of the epoch
+  std::map<AggregateId, SchedulingSummary> m_ulSummaries; //!< The UL summaries of the epoch
 
 };
 
@@ -32,8 +32,6 @@ NS_LOG_COMPONENT_DEFINE ("PhyRxStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (PhyRxStatsCalculator);
 
 PhyRxStatsCalculator::PhyRxStatsCalculator ()
-  : m_dlRxFirstWrite (true),
-    m_ulRxFirstWrite (true)
 {
   NS_LOG_FUNCTION (this);
 
@@ -95,43 +93,26 @@ PhyRxStatsCalculator::DlPhyReception (PhyReceptionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi << params.m_correctness);
   NS_LOG_INFO ("Write DL Rx Phy Stats in " << GetDlRxOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_dlRxFirstWrite == true )
+  std::ofstream *outFile = GetOutputStream (m_dlRxFile, GetDlRxOutputFilename (),
+                                            "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId");
+  if (outFile == 0)
     {
-      outFile.open (GetDlRxOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlRxOutputFilename ().c_str ());
-          return;
-        }
-      m_dlRxFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId";
-      outFile << std::endl;
-    }
-  else
-    {
-      outFile.open (GetDlRxOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlRxOutputFilename ().c_str ());
-          return;
-        }
+      return;
     }
 
 //   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << params.m_timestamp << "\t";
-  outFile << (uint32_t) params.m_cellId << "\t";
-  outFile << params.m_imsi << "\t";
-  outFile << params.m_rnti << "\t";
-  outFile << (uint32_t) params.m_txMode << "\t";
-  outFile << (uint32_t) params.m_layer << "\t";
-  outFile << (uint32_t) params.m_mcs << "\t";
-  outFile << params.m_size << "\t";
-  outFile << (uint32_t) params.m_rv << "\t";
-  outFile << (uint32_t) params.m_ndi << "\t";
-  outFile << (uint32_t) params.m_correctness << "\t";
-  outFile << (uint32_t) params.m_ccId << std::endl;
-  outFile.close ();
+  *outFile << params.m_timestamp << "\t";
+  *outFile << (uint32_t) params.m_cellId << "\t";
+  *outFile << params.m_imsi << "\t";
+  *outFile << params.m_rnti << "\t";
+  *outFile << (uint32_t) params.m_txMode << "\t";
+  *outFile << (uint32_t) params.m_layer << "\t";
+  *outFile << (uint32_t) params.m_mcs << "\t";
+  *outFile << params.m_size << "\t";
+  *outFile << (uint32_t) params.m_rv << "\t";
+  *outFile << (uint32_t) params.m_ndi << "\t";
+  *outFile << (uint32_t) params.m_correctness << "\t";
+  *outFile << (uint32_t) params.m_ccId << "\n";
 }
 
 void
@@ -140,42 +121,25 @@ PhyRxStatsCalculator::UlPhyReception (PhyReceptionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi << params.m_correctness);
   NS_LOG_INFO ("Write UL Rx Phy Stats in " << GetUlRxOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_ulRxFirstWrite == true )
-    {
-      outFile.open (GetUlRxOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlRxOutputFilename ().c_str ());
-          return;
-        }
-      m_ulRxFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId";
-      outFile << std::endl;
-    }
-  else
+  std::ofstream *outFile = GetOutputStream (m_ulRxFile, GetUlRxOutputFilename (),
+                                            "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId");
+  if (outFile == 0)
     {
-      outFile.open (GetUlRxOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlRxOutputFilename ().c_str ());
-          return;
-        }
+      return;
     }
 
 //   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << params.m_timestamp << "\t";
-  outFile << (uint32_t) params.m_cellId << "\t";
-  outFile << params.m_imsi << "\t";
-  outFile << params.m_rnti << "\t";
-  outFile << (uint32_t) params.m_layer << "\t";
-  outFile << (uint32_t) params.m_mcs << "\t";
-  outFile << params.m_size << "\t";
-  outFile << (uint32_t) params.m_rv << "\t";
-  outFile << (uint32_t) params.m_ndi << "\t";
-  outFile << (uint32_t) params.m_correctness << "\t";
-  outFile << (uint32_t) params.m_ccId <<std::endl;
-  outFile.close ();
+  *outFile << params.m_timestamp << "\t";
+  *outFile << (uint32_t) params.m_cellId << "\t";
+  *outFile << params.m_imsi << "\t";
+  *outFile << params.m_rnti << "\t";
+  *outFile << (uint32_t) params.m_layer << "\t";
+  *outFile << (uint32_t) params.m_mcs << "\t";
+  *outFile << params.m_size << "\t";
+  *outFile << (uint32_t) params.m_rv << "\t";
+  *outFile << (uint32_t) params.m_ndi << "\t";
+  *outFile << (uint32_t) params.m_correctness << "\t";
+  *outFile << (uint32_t) params.m_ccId << "\n";
 }
 
 void
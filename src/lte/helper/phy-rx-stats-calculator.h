@@ -126,21 +126,9 @@ public:
                                std::string path, PhyReceptionStatParameters params);
 private:
 
-  /**
-   * When writing DL RX PHY statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
-   */
-  bool m_dlRxFirstWrite;
+  OutputFile m_dlRxFile; //!< The DL RX output file
 
-  /**
-   * When writing UL RX PHY statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
-   */
-  bool m_ulRxFirstWrite;
+  OutputFile m_ulRxFile; //!< The UL RX output file
 
 };
 
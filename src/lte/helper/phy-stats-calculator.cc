@@ -30,10 +30,24 @@ NS_LOG_COMPONENT_DEFINE ("PhyStatsCalculator");
 
 NS_OBJECT_ENSURE_REGISTERED (PhyStatsCalculator);
 
+/**
+ * Write the values of a SpectrumValue as its output operator does,
+ * without flushing the stream.
+ *
+ * \param os the stream
+ * \param value the SpectrumValue
+ */
+static void
+WriteSpectrumValue (std::ostream &os, const SpectrumValue &value)
+{
+  for (Values::const_iterator it = value.ConstValuesBegin (); it != value.ConstValuesEnd (); ++it)
+    {
+      os << *it << " ";
+    }
+  os << "\n";
+}
+
 PhyStatsCalculator::PhyStatsCalculator ()
-  :  m_RsrpSinrFirstWrite (true),
-    m_UeSinrFirstWrite (true),
-    m_InterferenceFirstWrite (true)
 {
   NS_LOG_FUNCTION (this);
 
@@ -115,37 +129,30 @@ PhyStatsCalculator::ReportCurrentCellRsrpSinr (uint16_t cellId, uint64_t imsi, u
   NS_LOG_FUNCTION (this << cellId <<  imsi << rnti  << rsrp << sinr);
   NS_LOG_INFO ("Write RSRP/SINR Phy Stats in " << GetCurrentCellRsrpSinrFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_RsrpSinrFirstWrite == true )
+  if (AggregateRecord ())
     {
-      outFile.open (GetCurrentCellRsrpSinrFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetCurrentCellRsrpSinrFilename ().c_str ());
-          return;
-        }
-      m_RsrpSinrFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\trsrp\tsinr\tComponentCarrierId";
-      outFile << std::endl;
+      AggregateId id = { cellId, imsi, rnti, componentCarrierId };
+      RsrpSinrSummary &summary = m_rsrpSinrSummaries[id];
+      summary.samples++;
+      summary.rsrp += rsrp;
+      summary.sinr += sinr;
+      return;
     }
-  else
+
+  std::ofstream *outFile = GetOutputStream (m_rsrpSinrFile, GetCurrentCellRsrpSinrFilename (),
+                                            "% time\tcellId\tIMSI\tRNTI\trsrp\tsinr\tComponentCarrierId");
+  if (outFile == 0)
     {
-      outFile.open (GetCurrentCellRsrpSinrFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetCurrentCellRsrpSinrFilename ().c_str ());
-          return;
-        }
+      return;
     }
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << cellId << "\t";
-  outFile << imsi << "\t";
-  outFile << rnti << "\t";
-  outFile << rsrp << "\t";
-  outFile << sinr << "\t";
-  outFile << (uint32_t)componentCarrierId << std::endl;
-  outFile.close ();
+  *outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
+  *outFile << cellId << "\t";
+  *outFile << imsi << "\t";
+  *outFile << rnti << "\t";
+  *outFile << rsrp << "\t";
+  *outFile << sinr << "\t";
+  *outFile << (uint32_t)componentCarrierId << "\n";
 }
 
 void
@@ -154,36 +161,28 @@ PhyStatsCalculator::ReportUeSinr (uint16_t cellId, uint64_t imsi, uint16_t rnti,
   NS_LOG_FUNCTION (this << cellId <<  imsi << rnti  << sinrLinear);
   NS_LOG_INFO ("Write SINR Linear Phy Stats in " << GetUeSinrFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_UeSinrFirstWrite == true )
+  if (AggregateRecord ())
     {
-      outFile.open (GetUeSinrFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUeSinrFilename ().c_str ());
-          return;
-        }
-      m_UeSinrFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\tsinrLinear\tcomponentCarrierId";
-      outFile << std::endl;
+      AggregateId id = { cellId, imsi, rnti, componentCarrierId };
+      UeSinrSummary &summary = m_ueSinrSummaries[id];
+      summary.samples++;
+      summary.sinr += sinrLinear;
+      return;
     }
-  else
+
+  std::ofstream *outFile = GetOutputStream (m_ueSinrFile, GetUeSinrFilename (),
+                                            "% time\tcellId\tIMSI\tRNTI\tsinrLinear\tcomponentCarrierId");
+  if (outFile == 0)
     {
-      outFile.open (GetUeSinrFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUeSinrFilename ().c_str ());
-          return;
-        }
+      return;
     }
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << cellId << "\t";
-  outFile << imsi << "\t";
-  outFile << rnti << "\t";
-  outFile << sinrLinear << "\t";
-  outFile << (uint32_t)componentCarrierId << std::endl;
-  outFile.close ();
+  *outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
+  *outFile << cellId << "\t";
+  *outFile << imsi << "\t";
+  *outFile << rnti << "\t";
+  *outFile << sinrLinear << "\t";
+  *outFile << (uint32_t)componentCarrierId << "\n";
 }
 
 void
@@ -192,33 +191,88 @@ PhyStatsCalculator::ReportInterference (uint16_t cellId, Ptr<SpectrumValue> inte
   NS_LOG_FUNCTION (this << cellId <<  interference);
   NS_LOG_INFO ("Write Interference Phy Stats in " << GetInterferenceFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_InterferenceFirstWrite == true )
+  if (AggregateRecord ())
     {
-      outFile.open (GetInterferenceFilename ().c_str ());
-      if (!outFile.is_open ())
+      InterferenceSummary &summary = m_interferenceSummaries[cellId];
+      if (summary.interference == 0)
         {
-          NS_LOG_ERROR ("Can't open file " << GetInterferenceFilename ().c_str ());
-          return;
+          summary.interference = Create<SpectrumValue> (interference->GetSpectrumModel ());
         }
-      m_InterferenceFirstWrite = false;
-      outFile << "% time\tcellId\tInterference";
-      outFile << std::endl;
+      summary.samples++;
+      *summary.interference += *interference;
+      return;
     }
-  else
+
+  std::ofstream *outFile = GetOutputStream (m_interferenceFile, GetInterferenceFilename (),
+                                            "% time\tcellId\tInterference");
+  if (outFile == 0)
+    {
+      return;
+    }
+
+  *outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
+  *outFile << cellId << "\t";
+  WriteSpectrumValue (*outFile, *interference);
+}
+
+void
+PhyStatsCalculator::WriteAggregates (Time start)
+{
+  NS_LOG_FUNCTION (this << start);
+  double time = start.GetNanoSeconds () / (double) 1e9;
+
+  std::ofstream *outFile;
+  if (!m_rsrpSinrSummaries.empty ()
+      && (outFile = GetOutputStream (m_rsrpSinrFile, GetCurrentCellRsrpSinrFilename (),
+                                     "% start\tcellId\tIMSI\tRNTI\tsamples\trsrp\tsinr\tComponentCarrierId")) != 0)
     {
-      outFile.open (GetInterferenceFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
+      for (std::map<AggregateId, RsrpSinrSummary>::const_iterator it = m_rsrpSinrSummaries.begin ();
+           it != m_rsrpSinrSummaries.end (); ++it)
         {
-          NS_LOG_ERROR ("Can't open file " << GetInterferenceFilename ().c_str ());
-          return;
+          *outFile << time << "\t";
+          *outFile << it->first.cellId << "\t";
+          *outFile << it->first.imsi << "\t";
+          *outFile << it->first.rnti << "\t";
+          *outFile << it->second.samples << "\t";
+          *outFile << it->second.rsrp / it->second.samples << "\t";
+          *outFile << it->second.sinr / it->second.samples << "\t";
+          *outFile << (uint32_t) it->first.componentCarrierId << "\n";
         }
     }
+  m_rsrpSinrSummaries.clear ();
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << cellId << "\t";
-  outFile << *interference;
-  outFile.close ();
+  if (!m_ueSinrSummaries.empty ()
+      && (outFile = GetOutputStream (m_ueSinrFile, GetUeSinrFilename (),
+                                     "% start\tcellId\tIMSI\tRNTI\tsamples\tsinrLinear\tcomponentCarrierId")) != 0)
+    {
+      for (std::map<AggregateId, UeSinrSummary>::const_iterator it = m_ueSinrSummaries.begin ();
+           it != m_ueSinrSummaries.end (); ++it)
+        {
+          *outFile << time << "\t";
+          *outFile << it->first.cellId << "\t";
+          *outFile << it->first.imsi << "\t";
+          *outFile << it->first.rnti << "\t";
+          *outFile << it->second.samples << "\t";
+          *outFile << it->second.sinr / it->second.samples << "\t";
+          *outFile << (uint32_t) it->first.componentCarrierId << "\n";
+        }
+    }
+  m_ueSinrSummaries.clear ();
+
+  if (!m_interferenceSummaries.empty ()
+      && (outFile = GetOutputStream (m_interferenceFile, GetInterferenceFilename (),
+                                     "% start\tcellId\tsamples\tInterference")) != 0)
+    {
+      for (std::map<uint16_t, InterferenceSummary>::const_iterator it = m_interferenceSummaries.begin ();
+           it != m_interferenceSummaries.end (); ++it)
+        {
+          *outFile << time << "\t";
+          *outFile << it->first << "\t";
+          *outFile << it->second.samples << "\t";
+          WriteSpectrumValue (*outFile, *it->second.interference / it->second.samples);
+        }
+    }
+  m_interferenceSummaries.clear ();
 }
 
 
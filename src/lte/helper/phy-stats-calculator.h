@@ -53,6 +53,10 @@ namespace ns3 {
  *   - IMSI of the scheduled UE
  *   - C-RNTI scheduled
  *   - Measured interference for each RB
+ *
+ * In aggregated mode, one row per epoch is written for each UE (for each
+ * cell for the interference), with the number of reports and the mean
+ * of the reported values.
  */
 class PhyStatsCalculator : public LteStatsCalculator
 {
@@ -181,30 +185,39 @@ public:
                            uint16_t cellId, Ptr<SpectrumValue> interference);
 
 
-private:
-  /**
-   * When writing RSRP SINR statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
-   */
-  bool m_RsrpSinrFirstWrite;
-
-  /**
-   * When writing UE SINR statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
-   */
-  bool m_UeSinrFirstWrite;
+protected:
+  virtual void WriteAggregates (Time start);
 
-  /**
-   * When writing interference statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
-   */
-  bool m_InterferenceFirstWrite;
+private:
+  /// The sums of the RSRP and SINR reports of an epoch
+  struct RsrpSinrSummary
+  {
+    uint32_t samples; //!< The number of reports
+    double rsrp; //!< The sum of the RSRP
+    double sinr; //!< The sum of the SINR
+  };
+
+  /// The sums of the UE SINR reports of an epoch
+  struct UeSinrSummary
+  {
+    uint32_t samples; //!< The number of reports
+    double sinr; //!< The sum of the SINR
+  };
+
+  /// The sum of the interference reports of an epoch
+  struct InterferenceSummary
+  {
+    uint32_t samples; //!< The number of reports
+    Ptr<SpectrumValue> interference; //!< The sum of the interference
+  };
+
+  OutputFile m_rsrpSinrFile; //!< The RSRP/SINR output file
+  OutputFile m_ueSinrFile; //!< The UE SINR output file
+  OutputFile m_interferenceFile; //!< The interference output file
+
+  std::map<AggregateId, RsrpSinrSummary> m_rsrpSinrSummaries; //!< The RSRP/SINR summaries of the epoch
+  std::map<AggregateId, UeSinrSummary> m_ueSinrSummaries; //!< The UE SINR summaries of the epoch
+  std::map<uint16_t, InterferenceSummary> m_interferenceSummaries; //!< The interference summaries of the epoch, by cell ID
 
   /**
    * Name of the file where the RSRP/SINR statistics will be saved
@@ -32,8 +32,6 @@ NS_LOG_COMPONENT_DEFINE ("PhyTxStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (PhyTxStatsCalculator);
 
 PhyTxStatsCalculator::PhyTxStatsCalculator ()
-  : m_dlTxFirstWrite (true),
-    m_ulTxFirstWrite (true)
 {
   NS_LOG_FUNCTION (this);
 
@@ -95,43 +93,25 @@ PhyTxStatsCalculator::DlPhyTransmission (PhyTransmissionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi);
   NS_LOG_INFO ("Write DL Tx Phy Stats in " << GetDlTxOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_dlTxFirstWrite == true )
+  std::ofstream *outFile = GetOutputStream (m_dlTxFile, GetDlTxOutputFilename (),
+                                            "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tccId");
+  if (outFile == 0)
     {
-      outFile.open (GetDlOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlTxOutputFilename ().c_str ());
-          return;
-        }
-      m_dlTxFirstWrite = false;
-      //outFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi"; // txMode is not available at dl tx side
-      outFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tccId";
-      outFile << std::endl;
-    }
-  else
-    {
-      outFile.open (GetDlTxOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlTxOutputFilename ().c_str ());
-          return;
-        }
+      return;
     }
 
 //   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << params.m_timestamp << "\t";
-  outFile << (uint32_t) params.m_cellId << "\t";
-  outFile << params.m_imsi << "\t";
-  outFile << params.m_rnti << "\t";
+  *outFile << params.m_timestamp << "\t";
+  *outFile << (uint32_t) params.m_cellId << "\t";
+  *outFile << params.m_imsi << "\t";
+  *outFile << params.m_rnti << "\t";
   //outFile << (uint32_t) params.m_txMode << "\t"; // txMode is not available at dl tx side
-  outFile << (uint32_t) params.m_layer << "\t";
-  outFile << (uint32_t) params.m_mcs << "\t";
-  outFile << params.m_size << "\t";
-  outFile << (uint32_t) params.m_rv << "\t";
-  outFile << (uint32_t) params.m_ndi << "\t";
-  outFile << (uint32_t) params.m_ccId << std::endl;
-  outFile.close ();
+  *outFile << (uint32_t) params.m_layer << "\t";
+  *outFile << (uint32_t) params.m_mcs << "\t";
+  *outFile << params.m_size << "\t";
+  *outFile << (uint32_t) params.m_rv << "\t";
+  *outFile << (uint32_t) params.m_ndi << "\t";
+  *outFile << (uint32_t) params.m_ccId << "\n";
 }
 
 void
@@ -140,43 +120,25 @@ PhyTxStatsCalculator::UlPhyTransmission (PhyTransmissionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi);
   NS_LOG_INFO ("Write UL Tx Phy Stats in " << GetUlTxOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_ulTxFirstWrite == true )
-    {
-      outFile.open (GetUlTxOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlTxOutputFilename ().c_str ());
-          return;
-        }
-      m_ulTxFirstWrite = false;
-//       outFile << "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi";
-      outFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tccId";
-      outFile << std::endl;
-    }
-  else
+  std::ofstream *outFile = GetOutputStream (m_ulTxFile, GetUlTxOutputFilename (),
+                                            "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tccId");
+  if (outFile == 0)
     {
-      outFile.open (GetUlTxOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlTxOutputFilename ().c_str ());
-          return;
-        }
+      return;
     }
 
 //   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << params.m_timestamp << "\t";
-  outFile << (uint32_t) params.m_cellId << "\t";
-  outFile << params.m_imsi << "\t";
-  outFile << params.m_rnti << "\t";
+  *outFile << params.m_timestamp << "\t";
+  *outFile << (uint32_t) params.m_cellId << "\t";
+  *outFile << params.m_imsi << "\t";
+  *outFile << params.m_rnti << "\t";
   //outFile << (uint32_t) params.m_txMode << "\t";
-  outFile << (uint32_t) params.m_layer << "\t";
-  outFile << (uint32_t) params.m_mcs << "\t";
-  outFile << params.m_size << "\t";
-  outFile << (uint32_t) params.m_rv << "\t";
-  outFile << (uint32_t) params.m_ndi << "\t";
-  outFile << (uint32_t) params.m_ccId << std::endl;
-  outFile.close ();
+  *outFile << (uint32_t) params.m_layer << "\t";
+  *outFile << (uint32_t) params.m_mcs << "\t";
+  *outFile << params.m_size << "\t";
+  *outFile << (uint32_t) params.m_rv << "\t";
+  *outFile << (uint32_t) params.m_ndi << "\t";
+  *outFile << (uint32_t) params.m_ccId << "\n";
 }
 
 void
@@ -127,21 +127,9 @@ public:
                                   std::string path, PhyTransmissionStatParameters params);
 
 private:
-  /**
-   * When writing DL TX PHY statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
-   */
-  bool m_dlTxFirstWrite;
+  OutputFile m_dlTxFile; //!< The DL TX output file
 
-  /**
-   * When writing UL TX PHY statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
-   */
-  bool m_ulTxFirstWrite;
+  OutputFile m_ulTxFile; //!< The UL TX output file
 
 };
 
@@ -0,0 +1,193 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "position-kd-tree.h"
+#include <ns3/assert.h>
+#include <ns3/log.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PositionKdTree");
+
+/**
+ * \param v a position
+ * \param axis the axis: 0, 1 or 2 for x, y or z
+ * \return the coordinate of the position along the axis
+ */
+static inline double
+GetCoordinate (const Vector &v, uint8_t axis)
+{
+  return (axis == 0) ? v.x : ((axis == 1) ? v.y : v.z);
+}
+
+/// Order the nodes of a k-d tree along an axis
+struct PositionKdTreeAxisLess
+{
+  /**
+   * Constructor
+   * \param axis the axis
+   */
+  PositionKdTreeAxisLess (uint8_t axis)
+    : m_axis (axis)
+  {
+  }
+  /**
+   * \param a a node
+   * \param b another node
+   * \return true if a is before b along the axis
+   */
+  template <class N>
+  bool operator() (const N &a, const N &b) const
+  {
+    return GetCoordinate (a.position, m_axis) < GetCoordinate (b.position, m_axis);
+  }
+  uint8_t m_axis; ///< the axis
+};
+
+PositionKdTree::PositionKdTree ()
+{
+}
+
+void
+PositionKdTree::Build (const std::vector<Vector> &positions)
+{
+  NS_LOG_FUNCTION (this << positions.size ());
+  m_nodes.resize (positions.size ());
+  for (uint32_t i = 0; i < positions.size (); i++)
+    {
+      m_nodes[i].position = positions[i];
+      m_nodes[i].index = i;
+      m_nodes[i].axis = 0;
+    }
+  Build (0, m_nodes.size ());
+}
+
+uint32_t
+PositionKdTree::GetN (void) const
+{
+  return m_nodes.size ();
+}
+
+void
+PositionKdTree::Build (uint32_t begin, uint32_t end)
+{
+  if (end - begin <= 1)
+    {
+      return;
+    }
+
+  // split along the axis along which the positions are the most spread
+  Vector min = m_nodes[begin].position;
+  Vector max = min;
+  for (uint32_t i = begin + 1; i < end; i++)
+    {
+      const Vector &v = m_nodes[i].position;
+      min.x = std::min (min.x, v.x);
+      min.y = std::min (min.y, v.y);
+      min.z = std::min (min.z, v.z);
+      max.x = std::max (max.x, v.x);
+      max.y = std::max (max.y, v.y);
+      max.z = std::max (max.z, v.z);
+    }
+  uint8_t axis = 0;
+  double spread = max.x - min.x;
+  if (max.y - min.y > spread)
+    {
+      axis = 1;
+      spread = max.y - min.y;
+    }
+  if (max.z - min.z > spread)
+    {
+      axis = 2;
+    }
+
+  // the median is the root of the subtree, the nodes before it are not
+  // after it along the axis, and the nodes after it are not before it
+  uint32_t mid = begin + (end - begin) / 2;
+  std::nth_element (m_nodes.begin () + begin, m_nodes.begin () + mid,
+                    m_nodes.begin () + end, PositionKdTreeAxisLess (axis));
+  m_nodes[mid].axis = axis;
+
+  Build (begin, mid);
+  Build (mid + 1, end);
+}
+
+uint32_t
+PositionKdTree::FindClosest (const Vector &position) const
+{
+  NS_ASSERT_MSG (!m_nodes.empty (), "empty k-d tree");
+  uint32_t bestIndex = std::numeric_limits<uint32_t>::max ();
+  double bestDistance = std::numeric_limits<double>::infinity ();
+  Search (0, m_nodes.size (), position, bestIndex, bestDistance);
+  return bestIndex;
+}
+
+void
+PositionKdTree::Search (uint32_t begin, uint32_t end, const Vector &position,
+                        uint32_t &bestIndex, double &bestDistance) const
+{
+  if (begin >= end)
+    {
+      return;
+    }
+
+  uint32_t mid = begin + (end - begin) / 2;
+  const Node &node = m_nodes[mid];
+  double distance = CalculateDistance (position, node.position);
+  if (distance < bestDistance
+      || (distance == bestDistance && node.index < bestIndex))
+    {
+      bestDistance = distance;
+      bestIndex = node.index;
+    }
+
+  if (end - begin == 1)
+    {
+      return;
+    }
+
+  // search first the side of the position
+  double diff = GetCoordinate (position, node.axis) - GetCoordinate (node.position, node.axis);
+  if (diff < 0)
+    {
+      Search (begin, mid, position, bestIndex, bestDistance);
+    }
+  else
+    {
+      Search (mid + 1, end, position, bestIndex, bestDistance);
+    }
+
+  // The positions on the other side are at least as far as the split
+  // plane.  The distance to the plane is computed as CalculateDistance
+  // would, so that the positions at the same distance as the best one,
+  // which may have a lower index, are not skipped.
+  if (std::sqrt (diff * diff) <= bestDistance)
+    {
+      if (diff < 0)
+        {
+          Search (mid + 1, end, position, bestIndex, bestDistance);
+        }
+      else
+        {
+          Search (begin, mid, position, bestIndex, bestDistance);
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,93 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef POSITION_KD_TREE_H
+#define POSITION_KD_TREE_H
+
+#include <ns3/vector.h>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * \brief Static k-d tree over a set of positions, to find the closest one
+ * to a given position.
+ *
+ * LteHelper::AttachToClosestEnb uses it to find the closest eNB of each
+ * UE in O(log(n)) instead of computing the distance to every eNB.
+ *
+ * The closest position is the one found by a linear search with
+ * CalculateDistance: among the positions at the smallest distance, the
+ * one added first is returned.
+ */
+class PositionKdTree
+{
+public:
+  PositionKdTree ();
+
+  /**
+   * Build the tree
+   * \param positions the positions, identified by their index
+   */
+  void Build (const std::vector<Vector> &positions);
+
+  /// \return the number of positions in the tree
+  uint32_t GetN (void) const;
+
+  /**
+   * Find the closest position
+   * \param position the position to search around
+   * \return the index of the closest position; the tree must not be empty
+   */
+  uint32_t FindClosest (const Vector &position) const;
+
+private:
+  /// Node of the tree, splitting the space in two along an axis
+  struct Node
+  {
+    Vector position; ///< the position
+    uint32_t index;  ///< the index of the position
+    uint8_t axis;    ///< the split axis: 0, 1 or 2 for x, y or z
+  };
+
+  /**
+   * Build the subtree of the nodes in [begin, end) of m_nodes, placing
+   * its root at the median
+   * \param begin the first node
+   * \param end one past the last node
+   */
+  void Build (uint32_t begin, uint32_t end);
+
+  /**
+   * Search the subtree of the nodes in [begin, end) of m_nodes
+   * \param begin the first node
+   * \param end one past the last node
+   * \param position the position to search around
+   * \param bestIndex the index of the closest position found so far
+   * \param bestDistance the distance of the closest position found so far
+   */
+  void Search (uint32_t begin, uint32_t end, const Vector &position,
+               uint32_t &bestIndex, double &bestDistance) const;
+
+  std::vector<Node> m_nodes; ///< the nodes, as an implicit balanced tree
+};
+
+} // namespace ns3
+
+#endif /* POSITION_KD_TREE_H */
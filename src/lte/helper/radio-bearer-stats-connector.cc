@@ -355,21 +355,22 @@ RadioBearerStatsConnector::ConnectTracesUe (std::string context, uint64_t imsi,
   NS_LOG_FUNCTION (this << context);
   NS_LOG_LOGIC (this << "expected context should match /NodeList/*/DeviceList/*/LteUeRrc/");
   std::string basePath = context.substr (0, context.rfind ("/"));
+  std::vector<std::string> paths;
+  std::vector<CallbackBase> cbs;
   if (m_rlcStats)
     {
       Ptr<BoundCallbackArgument> arg = Create<BoundCallbackArgument> ();
       arg->imsi = imsi;
       arg->cellId = cellId; 
       arg->stats = m_rlcStats;
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LteRlc/TxPDU",
-		       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LteRlc/RxPDU",
-		       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LteRlc/TxPDU",
-		       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LteRlc/RxPDU",
-		       MakeBoundCallback (&DlRxPduCallback, arg));
-
+      paths.push_back (basePath + "/DataRadioBearerMap/*/LteRlc/TxPDU");
+      cbs.push_back (MakeBoundCallback (&UlTxPduCallback, arg));
+      paths.push_back (basePath + "/DataRadioBearerMap/*/LteRlc/RxPDU");
+      cbs.push_back (MakeBoundCallback (&DlRxPduCallback, arg));
+      paths.push_back (basePath + "/Srb1/LteRlc/TxPDU");
+      cbs.push_back (MakeBoundCallback (&UlTxPduCallback, arg));
+      paths.push_back (basePath + "/Srb1/LteRlc/RxPDU");
+      cbs.push_back (MakeBoundCallback (&DlRxPduCallback, arg));
     }
   if (m_pdcpStats)
     {
@@ -377,15 +378,17 @@ RadioBearerStatsConnector::ConnectTracesUe (std::string context, uint64_t imsi,
       arg->imsi = imsi;
       arg->cellId = cellId; 
       arg->stats = m_pdcpStats;
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LtePdcp/RxPDU",
-		       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LtePdcp/TxPDU",
-		       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LtePdcp/RxPDU",
-		       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LtePdcp/TxPDU",
-		       MakeBoundCallback (&UlTxPduCallback, arg));
+      paths.push_back (basePath + "/DataRadioBearerMap/*/LtePdcp/RxPDU");
+      cbs.push_back (MakeBoundCallback (&DlRxPduCallback, arg));
+      paths.push_back (basePath + "/DataRadioBearerMap/*/LtePdcp/TxPDU");
+      cbs.push_back (MakeBoundCallback (&UlTxPduCallback, arg));
+      paths.push_back (basePath + "/Srb1/LtePdcp/RxPDU");
+      cbs.push_back (MakeBoundCallback (&DlRxPduCallback, arg));
+      paths.push_back (basePath + "/Srb1/LtePdcp/TxPDU");
+      cbs.push_back (MakeBoundCallback (&UlTxPduCallback, arg));
     }
+  // the Tx and Rx traces of every RLC and PDCP entity share their object path
+  Config::Connect (paths, cbs);
 }
 
 void 
@@ -395,24 +398,26 @@ RadioBearerStatsConnector::ConnectTracesEnb (std::string context, uint64_t imsi,
   NS_LOG_LOGIC (this << "expected context  should match /NodeList/*/DeviceList/*/LteEnbRrc/");
   std::ostringstream basePath;
   basePath <<  context.substr (0, context.rfind ("/")) << "/UeMap/" << (uint32_t) rnti;
+  std::vector<std::string> paths;
+  std::vector<CallbackBase> cbs;
   if (m_rlcStats)
     {
       Ptr<BoundCallbackArgument> arg = Create<BoundCallbackArgument> ();
       arg->imsi = imsi;
       arg->cellId = cellId; 
       arg->stats = m_rlcStats;
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LteRlc/RxPDU",
-		       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LteRlc/TxPDU",
-		       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb0/LteRlc/RxPDU",
-		       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb0/LteRlc/TxPDU",
-		       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LteRlc/RxPDU",
-		       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LteRlc/TxPDU",
-		       MakeBoundCallback (&DlTxPduCallback, arg));
+      paths.push_back (basePath.str () + "/DataRadioBearerMap/*/LteRlc/RxPDU");
+      cbs.push_back (MakeBoundCallback (&UlRxPduCallback, arg));
+      paths.push_back (basePath.str () + "/DataRadioBearerMap/*/LteRlc/TxPDU");
+      cbs.push_back (MakeBoundCallback (&DlTxPduCallback, arg));
+      paths.push_back (basePath.str () + "/Srb0/LteRlc/RxPDU");
+      cbs.push_back (MakeBoundCallback (&UlRxPduCallback, arg));
+      paths.push_back (basePath.str () + "/Srb0/LteRlc/TxPDU");
+      cbs.push_back (MakeBoundCallback (&DlTxPduCallback, arg));
+      paths.push_back (basePath.str () + "/Srb1/LteRlc/RxPDU");
+      cbs.push_back (MakeBoundCallback (&UlRxPduCallback, arg));
+      paths.push_back (basePath.str () + "/Srb1/LteRlc/TxPDU");
+      cbs.push_back (MakeBoundCallback (&DlTxPduCallback, arg));
     }
   if (m_pdcpStats)
     {
@@ -420,15 +425,17 @@ RadioBearerStatsConnector::ConnectTracesEnb (std::string context, uint64_t imsi,
       arg->imsi = imsi;
       arg->cellId = cellId; 
       arg->stats = m_pdcpStats;
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LtePdcp/TxPDU",
-		       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LtePdcp/RxPDU",
-		       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LtePdcp/TxPDU",
-		       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LtePdcp/RxPDU",
-		       MakeBoundCallback (&UlRxPduCallback, arg));
+      paths.push_back (basePath.str () + "/DataRadioBearerMap/*/LtePdcp/TxPDU");
+      cbs.push_back (MakeBoundCallback (&DlTxPduCallback, arg));
+      paths.push_back (basePath.str () + "/DataRadioBearerMap/*/LtePdcp/RxPDU");
+      cbs.push_back (MakeBoundCallback (&UlRxPduCallback, arg));
+      paths.push_back (basePath.str () + "/Srb1/LtePdcp/TxPDU");
+      cbs.push_back (MakeBoundCallback (&DlTxPduCallback, arg));
+      paths.push_back (basePath.str () + "/Srb1/LtePdcp/RxPDU");
+      cbs.push_back (MakeBoundCallback (&UlRxPduCallback, arg));
     }
+  // the Tx and Rx traces of every RLC and PDCP entity share their object path
+  Config::Connect (paths, cbs);
 }
 
 void 
@@ -37,9 +37,21 @@
 #include <ns3/node.h>
 #include <ns3/buildings-helper.h>
 #include <ns3/lte-spectrum-value-helper.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/spectrum-propagation-loss-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/antenna-model.h>
+#include <ns3/angles.h>
+#include <ns3/core-config.h>
+#ifdef HAVE_PTHREAD_H
+#include <ns3/system-thread.h>
+#endif
 
 #include <fstream>
 #include <limits>
+#include <cmath>
+#include <vector>
+#include <algorithm>
 
 namespace ns3 {
 
@@ -47,6 +59,156 @@ NS_LOG_COMPONENT_DEFINE ("RadioEnvironmentMapHelper");
 
 NS_OBJECT_ENSURE_REGISTERED (RadioEnvironmentMapHelper);
 
+/**
+ * \param model the first model of a chain of propagation loss models
+ * \return true if the models of the chain only depend on the positions of
+ * the mobility models, and can thus be evaluated concurrently with
+ * distinct mobility models; the models drawing random variables or
+ * keeping per-link state, such as the buildings-aware models with their
+ * shadowing, cannot
+ */
+static bool
+IsSafeForThreads (Ptr<PropagationLossModel> model)
+{
+  static const char *safeModels[] = {
+    "ns3::FriisPropagationLossModel",
+    "ns3::TwoRayGroundPropagationLossModel",
+    "ns3::LogDistancePropagationLossModel",
+    "ns3::ThreeLogDistancePropagationLossModel",
+    "ns3::FixedRssLossModel",
+    "ns3::RangePropagationLossModel",
+    "ns3::Cost231PropagationLossModel",
+    "ns3::OkumuraHataPropagationLossModel",
+    "ns3::ItuR1411LosPropagationLossModel",
+    "ns3::ItuR1411NlosOverRooftopPropagationLossModel",
+    "ns3::Kun2600MhzPropagationLossModel"
+  };
+  const char **safeModelsEnd = safeModels + sizeof (safeModels) / sizeof (safeModels[0]);
+  for (; model != 0; model = model->GetNext ())
+    {
+      std::string name = model->GetInstanceTypeId ().GetName ();
+      if (std::find (safeModels, safeModelsEnd, name) == safeModelsEnd)
+        {
+          NS_LOG_LOGIC (name << " cannot be evaluated concurrently");
+          return false;
+        }
+    }
+  return true;
+}
+
+/// A signal captured for the direct computation of the map.
+struct RemTransmitter
+{
+  Ptr<SpectrumSignalParameters> params;  ///< the signal, with its PSD over the RBs of the map
+  AntennaModel *antenna;                 ///< the antenna of the transmitter, if any
+  /**
+   * The mobility model of the transmitter for each thread: the one of the
+   * transmitter for the first thread, and copies of it for the others
+   */
+  std::vector<Ptr<MobilityModel> > mobility;
+};
+
+/**
+ * Compute the SINR of a range of points of the map, as RemSpectrumPhy
+ * would from the signals delivered by the channel. Each thread has its
+ * own worker, which only uses its own mobility models.
+ */
+struct RemWorker
+{
+  /// Compute the SINR of the points in [begin, end)
+  void Run (void);
+
+  uint32_t thread;  ///< the index of the thread
+  uint32_t begin;   ///< the first point
+  uint32_t end;     ///< one past the last point
+  const std::vector<RemTransmitter> *transmitters;  ///< the captured signals
+  std::vector<double> bandwidths;  ///< the width of each RB of the map
+  PropagationLossModel *loss;  ///< the propagation loss model of the channel
+  SpectrumPropagationLossModel *spectrumLoss;  ///< the spectrum propagation loss model of the channel
+  double maxLossDb;   ///< the `MaxLossDb` attribute of the channel
+  double noisePower;  ///< the noise power
+  int32_t rbId;       ///< the RB of the map, or -1 for all
+  bool makeConsistent;  ///< whether to update the building info of the points
+  const std::vector<Vector> *positions;  ///< the positions of the points
+  std::vector<Ptr<MobilityModel> > *points;  ///< the mobility models of the points
+  std::vector<double> *sinr;  ///< the computed SINR of the points
+};
+
+void
+RemWorker::Run (void)
+{
+  for (uint32_t k = begin; k < end; ++k)
+    {
+      const Ptr<MobilityModel> &rxMobility = (*points)[k];
+      rxMobility->SetPosition ((*positions)[k]);
+      if (makeConsistent)
+        {
+          BuildingsHelper::MakeConsistent (rxMobility);
+        }
+      double referenceSignalPower = 0;
+      double sumPower = 0;
+      for (std::vector<RemTransmitter>::const_iterator tx = transmitters->begin ();
+           tx != transmitters->end ();
+           ++tx)
+        {
+          const Ptr<MobilityModel> &txMobility = tx->mobility[thread];
+          const SpectrumValue &psd = *(tx->params->psd);
+          double pathGainLinear = 1.0;
+          Ptr<SpectrumValue> rxPsd;
+          if (txMobility)
+            {
+              // same computation as MultiModelSpectrumChannel::StartTx
+              double pathLossDb = 0;
+              if (tx->antenna != 0)
+                {
+                  Angles txAngles ((*positions)[k], txMobility->GetPosition ());
+                  pathLossDb -= tx->antenna->GetGainDb (txAngles);
+                }
+              if (loss != 0)
+                {
+                  pathLossDb -= loss->CalcRxPower (0, txMobility, rxMobility);
+                }
+              if (pathLossDb > maxLossDb)
+                {
+                  // beyond range
+                  continue;
+                }
+              pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
+              if (spectrumLoss != 0)
+                {
+                  rxPsd = Copy<SpectrumValue> (tx->params->psd);
+                  *rxPsd *= pathGainLinear;
+                  rxPsd = spectrumLoss->CalcRxPowerSpectralDensity (rxPsd, txMobility, rxMobility);
+                }
+            }
+
+          // same computation as RemSpectrumPhy::StartRx
+          double power = 0;
+          if (rxPsd != 0)
+            {
+              power = (rbId >= 0) ? (*rxPsd)[rbId] * 180000 : Integral (*rxPsd);
+            }
+          else if (rbId >= 0)
+            {
+              power = (psd[rbId] * pathGainLinear) * 180000;
+            }
+          else
+            {
+              for (uint32_t i = 0; i < bandwidths.size (); ++i)
+                {
+                  power += (psd[i] * pathGainLinear) * bandwidths[i];
+                }
+            }
+          sumPower += power;
+          if (power > referenceSignalPower)
+            {
+              referenceSignalPower = power;
+            }
+        }
+      (*sinr)[k] = referenceSignalPower / (sumPower - referenceSignalPower + noisePower);
+    }
+}
+
 RadioEnvironmentMapHelper::RadioEnvironmentMapHelper ()
 {
 }
@@ -62,6 +224,7 @@ void
 RadioEnvironmentMapHelper::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+  m_capturePhy = 0;
 }
 
 TypeId
@@ -117,7 +280,7 @@ RadioEnvironmentMapHelper::GetTypeId (void)
                    DoubleValue (1.4230e-13),
                    MakeDoubleAccessor (&RadioEnvironmentMapHelper::m_noisePower),
                    MakeDoubleChecker<double> ())
-    .AddAttribute ("MaxPointsPerIteration", "Maximum number of REM points to be calculated per iteration. Every point consumes approximately 5KB of memory.",
+    .AddAttribute ("MaxPointsPerIteration", "Maximum number of REM points to be calculated per iteration. Every point consumes approximately 5KB of memory, or a few hundred bytes if ComputeDirectly is true.",
                    UintegerValue (20000),
                    MakeUintegerAccessor (&RadioEnvironmentMapHelper::m_maxPointsPerIteration),
                    MakeUintegerChecker<uint32_t> (1,std::numeric_limits<uint32_t>::max ()))
@@ -144,6 +307,29 @@ RadioEnvironmentMapHelper::GetTypeId (void)
                    IntegerValue (-1),
                    MakeIntegerAccessor (&RadioEnvironmentMapHelper::m_rbId),
                    MakeIntegerChecker<int32_t> ())
+    .AddAttribute ("ComputeDirectly",
+                   "If true, the REM is computed at once from the signals transmitted "
+                   "on the channel and the propagation models of the channel, "
+                   "instead of by listeners moved over the map during the simulation",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RadioEnvironmentMapHelper::m_computeDirectly),
+                   MakeBooleanChecker ())
+    .AddAttribute ("NumThreads",
+                   "Number of threads computing the REM if ComputeDirectly is true. "
+                   "More than one thread is used only if the propagation loss models "
+                   "of the channel only depend on the positions (e.g., Friis, LogDistance, "
+                   "Cost231, OkumuraHata or ItuR1411) and there is no spectrum "
+                   "propagation loss model",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&RadioEnvironmentMapHelper::m_numThreads),
+                   MakeUintegerChecker<uint32_t> (1, 1024))
+    .AddAttribute ("BinaryOutput",
+                   "If true, each point of the REM is written to the output file as "
+                   "four doubles in the byte order of the host (x, y, z and SINR), "
+                   "instead of a line of text",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RadioEnvironmentMapHelper::m_binaryOutput),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -181,7 +367,7 @@ void
 RadioEnvironmentMapHelper::Install ()
 {
   NS_LOG_FUNCTION (this);
-  if (!m_rem.empty ())
+  if (m_channel != 0)
     {
       NS_FATAL_ERROR ("only one REM supported per instance of RadioEnvironmentMapHelper");
     }
@@ -193,7 +379,12 @@ RadioEnvironmentMapHelper::Install ()
   m_channel = match.Get (0)->GetObject<SpectrumChannel> ();
   NS_ABORT_MSG_IF (m_channel == 0, "object at " << m_channelPath << "is not of type SpectrumChannel");
 
-  m_outFile.open (m_outputFile.c_str ());
+  std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc;
+  if (m_binaryOutput)
+    {
+      mode |= std::ios_base::binary;
+    }
+  m_outFile.open (m_outputFile.c_str (), mode);
   if (!m_outFile.is_open ())
     {
       NS_FATAL_ERROR ("Can't open file " << (m_outputFile));
@@ -208,6 +399,18 @@ RadioEnvironmentMapHelper::Install ()
       startDelay = 0.5001;
     }
 
+  if (m_computeDirectly)
+    {
+      // capture the signals during the first iteration of the listeners
+      Simulator::Schedule (Seconds (startDelay + 0.0001),
+                           &RadioEnvironmentMapHelper::StartCapture,
+                           this);
+      Simulator::Schedule (Seconds (startDelay + 0.0006),
+                           &RadioEnvironmentMapHelper::ComputeDirectly,
+                           this);
+      return;
+    }
+
   Simulator::Schedule (Seconds (startDelay),
                        &RadioEnvironmentMapHelper::DelayedInstall,
                        this);
@@ -331,15 +534,173 @@ RadioEnvironmentMapHelper::PrintAndReset ()
                     << pos.y << "\t" 
                     << pos.z << "\t" 
                     << it->phy->GetSinr (m_noisePower));
-      m_outFile << pos.x << "\t" 
-                << pos.y << "\t" 
-                << pos.z << "\t" 
-                << it->phy->GetSinr (m_noisePower)
-                << std::endl;
+      WritePoint (pos, it->phy->GetSinr (m_noisePower));
       it->phy->Reset ();
     }
 }
 
+void
+RadioEnvironmentMapHelper::StartCapture ()
+{
+  NS_LOG_FUNCTION (this);
+  m_capturePhy = CreateObject<RemSpectrumPhy> ();
+  m_capturePhy->SetRxSpectrumModel (LteSpectrumValueHelper::GetSpectrumModel (m_earfcn, m_bandwidth));
+  m_capturePhy->SetUseDataChannel (m_useDataChannel);
+  m_capturePhy->SetRbId (m_rbId);
+  m_capturePhy->SetKeepRxSignals (true);
+  m_channel->AddRx (m_capturePhy);
+}
+
+void
+RadioEnvironmentMapHelper::ComputeDirectly ()
+{
+  NS_LOG_FUNCTION (this);
+  const std::vector<Ptr<SpectrumSignalParameters> > &signals = m_capturePhy->GetRxSignals ();
+  NS_LOG_LOGIC (signals.size () << " signals captured");
+
+  Ptr<PropagationLossModel> loss = m_channel->GetPropagationLossModel ();
+  Ptr<SpectrumPropagationLossModel> spectrumLoss = m_channel->GetSpectrumPropagationLossModel ();
+  uint32_t numThreads = m_numThreads;
+#ifndef HAVE_PTHREAD_H
+  if (numThreads > 1)
+    {
+      NS_LOG_WARN ("threads are not supported, using one thread");
+      numThreads = 1;
+    }
+#endif
+  if (numThreads > 1 && (spectrumLoss != 0 || !IsSafeForThreads (loss)))
+    {
+      NS_LOG_WARN ("the propagation models of the channel cannot be evaluated concurrently, using one thread");
+      numThreads = 1;
+    }
+
+  std::vector<RemTransmitter> transmitters (signals.size ());
+  for (uint32_t i = 0; i < signals.size (); ++i)
+    {
+      transmitters[i].params = signals[i];
+      transmitters[i].antenna = PeekPointer (signals[i]->txAntenna);
+      Ptr<MobilityModel> txMobility = signals[i]->txPhy->GetMobility ();
+      transmitters[i].mobility.push_back (txMobility);
+      for (uint32_t t = 1; t < numThreads; ++t)
+        {
+          Ptr<MobilityModel> copy;
+          if (txMobility)
+            {
+              copy = CreateObject<ConstantPositionMobilityModel> ();
+              copy->SetPosition (txMobility->GetPosition ());
+            }
+          transmitters[i].mobility.push_back (copy);
+        }
+    }
+
+  m_xStep = (m_xMax - m_xMin)/(m_xRes-1);
+  m_yStep = (m_yMax - m_yMin)/(m_yRes-1);
+  std::vector<double> xs;
+  std::vector<double> ys;
+  for (double x = m_xMin; x < m_xMax + 0.5*m_xStep; x += m_xStep)
+    {
+      xs.push_back (x);
+    }
+  for (double y = m_yMin; y < m_yMax + 0.5*m_yStep; y += m_yStep)
+    {
+      ys.push_back (y);
+    }
+  uint64_t numPoints = (uint64_t) xs.size () * ys.size ();
+  uint32_t numPointsPerIteration = std::min<uint64_t> (numPoints, m_maxPointsPerIteration);
+
+  std::vector<Vector> positions (numPointsPerIteration);
+  std::vector<Ptr<MobilityModel> > points (numPointsPerIteration);
+  std::vector<double> sinr (numPointsPerIteration);
+  for (uint32_t k = 0; k < numPointsPerIteration; ++k)
+    {
+      points[k] = CreateObject<ConstantPositionMobilityModel> ();
+      Ptr<MobilityBuildingInfo> buildingInfo = CreateObject<MobilityBuildingInfo> ();
+      points[k]->AggregateObject (buildingInfo); // operation usually done by BuildingsHelper::Install
+    }
+
+  DoubleValue maxLossDb (1.0e9);
+  m_channel->GetAttributeFailSafe ("MaxLossDb", maxLossDb);
+  std::vector<RemWorker> workers (numThreads);
+  Ptr<const SpectrumModel> rxSpectrumModel = LteSpectrumValueHelper::GetSpectrumModel (m_earfcn, m_bandwidth);
+  for (uint32_t t = 0; t < numThreads; ++t)
+    {
+      RemWorker &worker = workers[t];
+      worker.thread = t;
+      worker.transmitters = &transmitters;
+      for (Bands::const_iterator it = rxSpectrumModel->Begin (); it != rxSpectrumModel->End (); ++it)
+        {
+          worker.bandwidths.push_back (it->fh - it->fl);
+        }
+      worker.loss = PeekPointer (loss);
+      worker.spectrumLoss = PeekPointer (spectrumLoss);
+      worker.maxLossDb = maxLossDb.Get ();
+      worker.noisePower = m_noisePower;
+      worker.rbId = m_rbId;
+      // BuildingsHelper::MakeConsistent uses the global building list
+      worker.makeConsistent = (numThreads == 1);
+      worker.positions = &positions;
+      worker.points = &points;
+      worker.sinr = &sinr;
+    }
+
+  for (uint64_t first = 0; first < numPoints; first += numPointsPerIteration)
+    {
+      uint32_t n = std::min<uint64_t> (numPointsPerIteration, numPoints - first);
+      for (uint32_t k = 0; k < n; ++k)
+        {
+          positions[k] = Vector (xs[(first + k) / ys.size ()], ys[(first + k) % ys.size ()], m_z);
+        }
+      for (uint32_t t = 0; t < numThreads; ++t)
+        {
+          workers[t].begin = (uint64_t) n * t / numThreads;
+          workers[t].end = (uint64_t) n * (t + 1) / numThreads;
+        }
+
+#ifdef HAVE_PTHREAD_H
+      std::vector<Ptr<SystemThread> > threads;
+      for (uint32_t t = 1; t < numThreads; ++t)
+        {
+          threads.push_back (Create<SystemThread> (MakeCallback (&RemWorker::Run, &workers[t])));
+          threads.back ()->Start ();
+        }
+      workers[0].Run ();
+      for (uint32_t t = 0; t < threads.size (); ++t)
+        {
+          threads[t]->Join ();
+        }
+#else
+      workers[0].Run ();
+#endif
+
+      for (uint32_t k = 0; k < n; ++k)
+        {
+          WritePoint (positions[k], sinr[k]);
+        }
+    }
+
+  m_capturePhy->Deactivate ();
+  m_capturePhy->Reset ();
+  Finalize ();
+}
+
+void
+RadioEnvironmentMapHelper::WritePoint (const Vector &pos, double sinr)
+{
+  if (m_binaryOutput)
+    {
+      double record[4] = { pos.x, pos.y, pos.z, sinr };
+      m_outFile.write (reinterpret_cast<const char *> (record), sizeof (record));
+    }
+  else
+    {
+      m_outFile << pos.x << "\t"
+                << pos.y << "\t"
+                << pos.z << "\t"
+                << sinr
+                << "\n";
+    }
+}
+
 void 
 RadioEnvironmentMapHelper::Finalize ()
 {
@@ -24,6 +24,7 @@
 
 
 #include <ns3/object.h>
+#include <ns3/vector.h>
 #include <fstream>
 
 
@@ -105,6 +106,33 @@ private:
   /// Go through every listener, write the computed SINR, and then reset it.
   void PrintAndReset ();
 
+  /**
+   * Scheduled by Install() instead of DelayedInstall() if the
+   * `ComputeDirectly` attribute is true. Connect to the channel a single
+   * listener without position, to which the channel delivers the
+   * transmitted signals without any propagation loss.
+   */
+  void StartCapture ();
+
+  /**
+   * Scheduled by Install() 0.5 milliseconds after StartCapture(). Compute
+   * the whole map at once from the captured signals, by evaluating the
+   * antenna and propagation models of the channel at each point, as the
+   * channel does for a listener, and then call Finalize().
+   *
+   * The map is divided into parts of at most `MaxPointsPerIteration`
+   * points, which are computed by `NumThreads` threads and written to the
+   * output file one after the other.
+   */
+  void ComputeDirectly ();
+
+  /**
+   * Write a point of the map to the output file.
+   * \param pos the position of the point
+   * \param sinr the SINR at the point
+   */
+  void WritePoint (const Vector &pos, double sinr);
+
   /// Called when the map generation procedure has been completed.
   void Finalize ();
 
@@ -152,6 +180,13 @@ private:
   bool m_useDataChannel;  ///< The `UseDataChannel` attribute.
   int32_t m_rbId;         ///< The `RbId` attribute.
 
+  bool m_computeDirectly;  ///< The `ComputeDirectly` attribute.
+  uint32_t m_numThreads;   ///< The `NumThreads` attribute.
+  bool m_binaryOutput;     ///< The `BinaryOutput` attribute.
+
+  /// Listener capturing the transmitted signals if `ComputeDirectly` is true.
+  Ptr<RemSpectrumPhy> m_capturePhy;
+
 }; // end of `class RadioEnvironmentMapHelper`
 
 
@@ -40,7 +40,26 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EpcTftClassifier");
 
+bool
+EpcTftClassifier::FlowKey::operator== (const FlowKey &other) const
+{
+  return remotePort == other.remotePort && localPort == other.localPort
+         && remoteAddress == other.remoteAddress && localAddress == other.localAddress
+         && tos == other.tos && direction == other.direction && ipType == other.ipType;
+}
+
+size_t
+EpcTftClassifier::FlowKeyHash::operator() (const FlowKey &key) const
+{
+  size_t hash = key.remoteAddress;
+  hash = hash * 31 + key.localAddress;
+  hash = hash * 31 + ((static_cast<uint32_t> (key.remotePort) << 16) | key.localPort);
+  hash = hash * 31 + ((static_cast<uint32_t> (key.tos) << 16) | (key.direction << 8) | key.ipType);
+  return hash;
+}
+
 EpcTftClassifier::EpcTftClassifier ()
+  : m_compiled (true)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -50,6 +69,8 @@ EpcTftClassifier::Add (Ptr<EpcTft> tft, uint32_t id)
 {
   NS_LOG_FUNCTION (this << tft << id);
   m_tftMap[id] = tft;
+  m_compiled = false;
+  m_flows.clear ();
 
   // simple sanity check: there shouldn't be more than 16 bearers (hence TFTs) per UE
   NS_ASSERT (m_tftMap.size () <= 16);
@@ -60,6 +81,60 @@ EpcTftClassifier::Delete (uint32_t id)
 {
   NS_LOG_FUNCTION (this << id);
   m_tftMap.erase (id);
+  m_compiled = false;
+  m_flows.clear ();
+}
+
+void
+EpcTftClassifier::Compile ()
+{
+  NS_LOG_FUNCTION (this);
+  m_filters.clear ();
+  for (std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it = m_tftMap.rbegin ();
+       it != m_tftMap.rend (); ++it)
+    {
+      std::list<EpcTft::PacketFilter> filters = it->second->GetPacketFilters ();
+      for (std::list<EpcTft::PacketFilter>::const_iterator fit = filters.begin ();
+           fit != filters.end (); ++fit)
+        {
+          CompiledFilter f;
+          f.id = it->first;
+          f.direction = fit->direction;
+          f.remoteMask = fit->remoteMask.Get ();
+          f.remoteAddress = fit->remoteAddress.Get () & f.remoteMask;
+          f.localMask = fit->localMask.Get ();
+          f.localAddress = fit->localAddress.Get () & f.localMask;
+          f.remotePortStart = fit->remotePortStart;
+          f.remotePortEnd = fit->remotePortEnd;
+          f.localPortStart = fit->localPortStart;
+          f.localPortEnd = fit->localPortEnd;
+          f.typeOfServiceMask = fit->typeOfServiceMask;
+          f.typeOfService = fit->typeOfService & fit->typeOfServiceMask;
+          m_filters.push_back (f);
+        }
+    }
+  m_compiled = true;
+  NS_LOG_LOGIC ("TFT MAP size: " << m_tftMap.size () << " filters: " << m_filters.size ());
+}
+
+uint32_t
+EpcTftClassifier::Match (const FlowKey &key) const
+{
+  for (std::vector<CompiledFilter>::const_iterator it = m_filters.begin ();
+       it != m_filters.end (); ++it)
+    {
+      if ((key.direction & it->direction)
+          && key.remotePort >= it->remotePortStart && key.remotePort <= it->remotePortEnd
+          && key.localPort >= it->localPortStart && key.localPort <= it->localPortEnd
+          && (key.tos & it->typeOfServiceMask) == it->typeOfService
+          && (key.ipType != 0x04
+              || ((key.remoteAddress & it->remoteMask) == it->remoteAddress
+                  && (key.localAddress & it->localMask) == it->localAddress)))
+        {
+          return it->id;
+        }
+    }
+  return 0;
 }
 
  
@@ -261,6 +336,15 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
     }
 
 
+  FlowKey key;
+  key.remoteAddress = ipType == 0x04 ? remoteAddressIpv4.Get () : 0;
+  key.localAddress = ipType == 0x04 ? localAddressIpv4.Get () : 0;
+  key.remotePort = remotePort;
+  key.localPort = localPort;
+  key.tos = tos;
+  key.direction = direction;
+  key.ipType = ipType;
+
   if (ipType == 0x04)
     {
       NS_LOG_INFO ("Classifying packet:"
@@ -269,26 +353,8 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
           << " localPort="  << localPort
           << " remotePort=" << remotePort
           << " tos=0x" << (uint16_t) tos );
-
-      // now it is possible to classify the packet!
-      // we use a reverse iterator since filter priority is not implemented properly.
-      // This way, since the default bearer is expected to be added first, it will be evaluated last.
-      std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it;
-      NS_LOG_LOGIC ("TFT MAP size: " << m_tftMap.size ());
-
-      for (it = m_tftMap.rbegin (); it != m_tftMap.rend (); ++it)
-        {
-          NS_LOG_LOGIC ("TFT id: " << it->first );
-          NS_LOG_LOGIC (" Ptr<EpcTft>: " << it->second);
-          Ptr<EpcTft> tft = it->second;
-          if (tft->Matches (direction, remoteAddressIpv4, localAddressIpv4, remotePort, localPort, tos))
-            {
-              NS_LOG_LOGIC ("matches with TFT ID = " << it->first);
-              return it->first; // the id of the matching TFT
-            }
-        }
     }
-  else if (ipType == 0x06)
+  else
     {
       NS_LOG_INFO ("Classifying packet:"
           << " localAddr="  << localAddressIpv6
@@ -296,27 +362,36 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
           << " localPort="  << localPort
           << " remotePort=" << remotePort
           << " tos=0x" << (uint16_t) tos );
+    }
 
-      // now it is possible to classify the packet!
-      // we use a reverse iterator since filter priority is not implemented properly.
-      // This way, since the default bearer is expected to be added first, it will be evaluated last.
-      std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it;
-      NS_LOG_LOGIC ("TFT MAP size: " << m_tftMap.size ());
+  sgi::hash_map<FlowKey, uint32_t, FlowKeyHash>::const_iterator cached = m_flows.find (key);
+  if (cached != m_flows.end ())
+    {
+      NS_LOG_LOGIC ("cached flow, TFT ID = " << cached->second);
+      return cached->second;
+    }
 
-      for (it = m_tftMap.rbegin (); it != m_tftMap.rend (); ++it)
-        {
-          NS_LOG_LOGIC ("TFT id: " << it->first );
-          NS_LOG_LOGIC (" Ptr<EpcTft>: " << it->second);
-          Ptr<EpcTft> tft = it->second;
-          if (tft->Matches (direction, remoteAddressIpv6, localAddressIpv6, remotePort, localPort, tos))
-            {
-              NS_LOG_LOGIC ("matches with TFT ID = " << it->first);
-              return it->first; // the id of the matching TFT
-            }
-        }
+  // now it is possible to classify the packet!
+  if (!m_compiled)
+    {
+      Compile ();
+    }
+  uint32_t id = Match (key);
+  if (id == 0)
+    {
+      NS_LOG_LOGIC ("no match");
+    }
+  else
+    {
+      NS_LOG_LOGIC ("matches with TFT ID = " << id);
+    }
+
+  if (m_flows.size () >= MAX_CACHED_FLOWS)
+    {
+      m_flows.clear ();
     }
-  NS_LOG_LOGIC ("no match");
-  return 0;  // no match
+  m_flows[key] = id;
+  return id;
 }
 
 
@@ -25,9 +25,11 @@
 
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
+#include "ns3/sgi-hashmap.h"
 #include "ns3/epc-tft.h"
 
 #include <map>
+#include <vector>
 
 
 namespace ns3 {
@@ -50,6 +52,12 @@ class Packet;
  *
  * When we cannot cache the port info, the TFT of the default bearer is used. This may happen
  * if there is reordering or losses of IP packets.
+ *
+ * The packet filters of all the TFTs are flattened, in evaluation order,
+ * into a vector of plain filters the first time a packet is classified
+ * after a TFT was added or deleted, and the decision taken for each flow
+ * (direction, addresses, ports and type of service) is cached, so that
+ * only the first packet of a flow is matched against the filters.
  */
 class EpcTftClassifier : public SimpleRefCount<EpcTftClassifier>
 {
@@ -63,6 +71,8 @@ public:
    * \param tft the TFT to be added
    * \param id the ID of the bearer which will be classified by specified TFT classifier
    * 
+   * \note the packet filters of the TFT must not be changed once it is
+   * added to the classifier.
    */
   void Add (Ptr<EpcTft> tft, uint32_t id);
 
@@ -85,9 +95,88 @@ public:
   uint32_t Classify (Ptr<Packet> p, EpcTft::Direction direction);
   
 protected:
-  
+
+  /**
+   * \brief A packet filter flattened for evaluation.
+   */
+  struct CompiledFilter
+  {
+    uint32_t id;                //!< ID of the TFT the filter belongs to
+    uint8_t direction;          //!< directions matched by the filter
+    uint32_t remoteAddress;     //!< masked IPv4 address of the remote host
+    uint32_t remoteMask;        //!< IPv4 address mask of the remote host
+    uint32_t localAddress;      //!< masked IPv4 address of the UE
+    uint32_t localMask;         //!< IPv4 address mask of the UE
+    uint16_t remotePortStart;   //!< start of the remote port range
+    uint16_t remotePortEnd;     //!< end of the remote port range
+    uint16_t localPortStart;    //!< start of the local port range
+    uint16_t localPortEnd;      //!< end of the local port range
+    uint8_t typeOfService;      //!< masked type of service
+    uint8_t typeOfServiceMask;  //!< type of service mask
+  };
+
+  /**
+   * \brief The fields of a packet the TFTs are evaluated on.
+   *
+   * IPv6 packet filters do not match addresses, hence the addresses
+   * are left to zero for IPv6 packets.
+   */
+  struct FlowKey
+  {
+    uint32_t remoteAddress; //!< IPv4 address of the remote host
+    uint32_t localAddress;  //!< IPv4 address of the UE
+    uint16_t remotePort;    //!< port of the remote host
+    uint16_t localPort;     //!< port of the UE
+    uint8_t tos;            //!< type of service
+    uint8_t direction;      //!< direction
+    uint8_t ipType;         //!< IP version
+
+    /**
+     * \brief Comparison operator.
+     * \param other the other key
+     * \return true if the keys are equal
+     */
+    bool operator== (const FlowKey &other) const;
+  };
+
+  /**
+   * \brief Hash function of the flow keys.
+   */
+  struct FlowKeyHash
+  {
+    /**
+     * \brief Returns the hash of a flow key.
+     * \param key the flow key
+     * \return the hash
+     */
+    size_t operator() (const FlowKey &key) const;
+  };
+
+  /**
+   * \brief Flatten the packet filters of all the TFTs, in evaluation order.
+   *
+   * We use a reverse order of the TFT IDs since filter priority is not
+   * implemented properly.  This way, since the default bearer is expected
+   * to be added first, it will be evaluated last.
+   */
+  void Compile ();
+
+  /**
+   * \brief Match a flow against the flattened packet filters.
+   * \param key the flow
+   * \return the ID of the first TFT that matches, 0 if none
+   */
+  uint32_t Match (const FlowKey &key) const;
+
+  /// Maximum number of cached flow decisions
+  static const uint32_t MAX_CACHED_FLOWS = 4096;
+
   std::map <uint32_t, Ptr<EpcTft> > m_tftMap; ///< TFT map
 
+  std::vector<CompiledFilter> m_filters; ///< flattened packet filters
+  bool m_compiled; ///< true if m_filters is up to date with m_tftMap
+  sgi::hash_map<FlowKey, uint32_t, FlowKeyHash> m_flows; ///< TFT ID by flow
+
   std::map < std::tuple<uint32_t, uint32_t, uint8_t, uint16_t>,
              std::pair<uint32_t, uint32_t> >
       m_classifiedIpv4Fragments; ///< Map with already classified IPv4 Fragments
@@ -237,6 +237,13 @@ EpcTft::Add (PacketFilter f)
   return (m_numFilters - 1);
 }
 
+std::list<EpcTft::PacketFilter>
+EpcTft::GetPacketFilters () const
+{
+  NS_LOG_FUNCTION (this);
+  return m_filters;
+}
+
 bool 
 EpcTft::Matches (Direction direction,
                  Ipv4Address remoteAddress,
@@ -192,6 +192,12 @@ public:
 		  uint8_t typeOfService);
 
 
+    /**
+     * \brief Get the packet filters
+     * \return the packet filters of this TFT, in evaluation order
+     */
+    std::list<PacketFilter> GetPacketFilters () const;
+
 private:
 
   std::list<PacketFilter> m_filters; ///< packet filter list
@@ -0,0 +1,847 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ff-mac-sched-trace.h"
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <ns3/lte-vendor-specific-parameters.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FfMacSchedTrace");
+
+/// Magic number of the trace files, "FFMS" in little endian order
+static const uint32_t TRACE_MAGIC = 0x534d4646;
+/// Version of the trace format
+static const uint32_t TRACE_VERSION = 1;
+
+// ------------------------------------------------------------------------
+// FfMacSchedTraceWriter
+// ------------------------------------------------------------------------
+
+FfMacSchedTraceWriter::FfMacSchedTraceWriter ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+FfMacSchedTraceWriter::~FfMacSchedTraceWriter ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+void
+FfMacSchedTraceWriter::Open (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  Close ();
+  m_file.open (filename.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!m_file.is_open ())
+    {
+      NS_FATAL_ERROR ("Can't open scheduler trace file " << filename);
+    }
+  m_buffer.clear ();
+  Put (TRACE_MAGIC);
+  Put (TRACE_VERSION);
+  m_file.write (reinterpret_cast<const char *> (&m_buffer[0]), m_buffer.size ());
+  m_buffer.clear ();
+}
+
+void
+FfMacSchedTraceWriter::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_file.is_open ())
+    {
+      m_file.close ();
+    }
+}
+
+bool
+FfMacSchedTraceWriter::IsOpen (void) const
+{
+  return m_file.is_open ();
+}
+
+void
+FfMacSchedTraceWriter::Flush (FfMacSchedTracePrimitive_e primitive)
+{
+  uint8_t header[5];
+  uint32_t size = m_buffer.size ();
+  header[0] = primitive;
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      header[1 + i] = (size >> (8 * i)) & 0xff;
+    }
+  m_file.write (reinterpret_cast<const char *> (header), sizeof (header));
+  if (size > 0)
+    {
+      m_file.write (reinterpret_cast<const char *> (&m_buffer[0]), size);
+    }
+  m_buffer.clear ();
+}
+
+void
+FfMacSchedTraceWriter::Put (uint8_t value)
+{
+  m_buffer.push_back (value);
+}
+
+void
+FfMacSchedTraceWriter::Put (uint16_t value)
+{
+  m_buffer.push_back (value & 0xff);
+  m_buffer.push_back (value >> 8);
+}
+
+void
+FfMacSchedTraceWriter::Put (uint32_t value)
+{
+  Put (static_cast<uint16_t> (value & 0xffff));
+  Put (static_cast<uint16_t> (value >> 16));
+}
+
+void
+FfMacSchedTraceWriter::Put (uint64_t value)
+{
+  Put (static_cast<uint32_t> (value & 0xffffffff));
+  Put (static_cast<uint32_t> (value >> 32));
+}
+
+template <class T>
+void
+FfMacSchedTraceWriter::PutList (const std::vector<T> &values)
+{
+  Put (static_cast<uint32_t> (values.size ()));
+  for (uint32_t i = 0; i < values.size (); i++)
+    {
+      Put (values[i]);
+    }
+}
+
+void
+FfMacSchedTraceWriter::Write (const FfMacCschedSapProvider::CschedCellConfigReqParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+  Put (params.m_ulBandwidth);
+  Put (params.m_dlBandwidth);
+  Flush (TRACE_CSCHED_CELL_CONFIG_REQ);
+}
+
+void
+FfMacSchedTraceWriter::Write (const FfMacCschedSapProvider::CschedUeConfigReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_rnti);
+  Put (params.m_rnti);
+  Put (static_cast<uint8_t> (params.m_reconfigureFlag));
+  Put (params.m_transmissionMode);
+  Flush (TRACE_CSCHED_UE_CONFIG_REQ);
+}
+
+void
+FfMacSchedTraceWriter::Write (const FfMacCschedSapProvider::CschedLcConfigReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_rnti);
+  Put (params.m_rnti);
+  Put (static_cast<uint8_t> (params.m_reconfigureFlag));
+  Put (static_cast<uint32_t> (params.m_logicalChannelConfigList.size ()));
+  for (uint32_t i = 0; i < params.m_logicalChannelConfigList.size (); i++)
+    {
+      const LogicalChannelConfigListElement_s &lc = params.m_logicalChannelConfigList[i];
+      Put (lc.m_logicalChannelIdentity);
+      Put (lc.m_logicalChannelGroup);
+      Put (static_cast<uint8_t> (lc.m_direction));
+      Put (static_cast<uint8_t> (lc.m_qosBearerType));
+      Put (lc.m_qci);
+      Put (lc.m_eRabMaximulBitrateUl);
+      Put (lc.m_eRabMaximulBitrateDl);
+      Put (lc.m_eRabGuaranteedBitrateUl);
+      Put (lc.m_eRabGuaranteedBitrateDl);
+    }
+  Flush (TRACE_CSCHED_LC_CONFIG_REQ);
+}
+
+void
+FfMacSchedTraceWriter::Write (const FfMacCschedSapProvider::CschedLcReleaseReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_rnti);
+  Put (params.m_rnti);
+  PutList (params.m_logicalChannelIdentity);
+  Flush (TRACE_CSCHED_LC_RELEASE_REQ);
+}
+
+void
+FfMacSchedTraceWriter::Write (const FfMacCschedSapProvider::CschedUeReleaseReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_rnti);
+  Put (params.m_rnti);
+  Flush (TRACE_CSCHED_UE_RELEASE_REQ);
+}
+
+void
+FfMacSchedTraceWriter::Write (const FfMacSchedSapProvider::SchedDlRlcBufferReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_rnti);
+  Put (params.m_rnti);
+  Put (params.m_logicalChannelIdentity);
+  Put (params.m_rlcTransmissionQueueSize);
+  Put (params.m_rlcTransmissionQueueHolDelay);
+  Put (params.m_rlcRetransmissionQueueSize);
+  Put (params.m_rlcRetransmissionHolDelay);
+  Put (params.m_rlcStatusPduSize);
+  Flush (TRACE_SCHED_DL_RLC_BUFFER_REQ);
+}
+
+void
+FfMacSchedTraceWriter::Write (const FfMacSchedSapProvider::SchedDlMacBufferReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_rnti);
+  Put (params.m_rnti);
+  Put (static_cast<uint8_t> (params.m_ceBitmap));
+  Flush (TRACE_SCHED_DL_MAC_BUFFER_REQ);
+}
+
+void
+FfMacSchedTraceWriter::Write (const FfMacSchedSapProvider::SchedDlTriggerReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_sfnSf);
+  Put (params.m_sfnSf);
+  Put (static_cast<uint32_t> (params.m_dlInfoList.size ()));
+  for (uint32_t i = 0; i < params.m_dlInfoList.size (); i++)
+    {
+      const DlInfoListElement_s &info = params.m_dlInfoList[i];
+      Put (info.m_rnti);
+      Put (info.m_harqProcessId);
+      Put (static_cast<uint32_t> (info.m_harqStatus.size ()));
+      for (uint32_t j = 0; j < info.m_harqStatus.size (); j++)
+        {
+          Put (static_cast<uint8_t> (info.m_harqStatus[j]));
+        }
+    }
+  Flush (TRACE_SCHED_DL_TRIGGER_REQ);
+}
+
+void
+FfMacSchedTraceWriter::Write (const FfMacSchedSapProvider::SchedDlRachInfoReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_sfnSf);
+  Put (params.m_sfnSf);
+  Put (static_cast<uint32_t> (params.m_rachList.size ()));
+  for (uint32_t i = 0; i < params.m_rachList.size (); i++)
+    {
+      Put (params.m_rachList[i].m_rnti);
+      Put (params.m_rachList[i].m_estimatedSize);
+    }
+  Flush (TRACE_SCHED_DL_RACH_INFO_REQ);
+}
+
+void
+FfMacSchedTraceWriter::Write (const FfMacSchedSapProvider::SchedDlCqiInfoReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_sfnSf);
+  Put (params.m_sfnSf);
+  Put (static_cast<uint32_t> (params.m_cqiList.size ()));
+  for (uint32_t i = 0; i < params.m_cqiList.size (); i++)
+    {
+      const CqiListElement_s &cqi = params.m_cqiList[i];
+      Put (cqi.m_rnti);
+      Put (cqi.m_ri);
+      Put (static_cast<uint8_t> (cqi.m_cqiType));
+      PutList (cqi.m_wbCqi);
+      Put (cqi.m_wbPmi);
+      const SbMeasResult_s &sb = cqi.m_sbMeasResult;
+      PutList (sb.m_ueSelected.m_sbList);
+      Put (sb.m_ueSelected.m_sbPmi);
+      PutList (sb.m_ueSelected.m_sbCqi);
+      Put (static_cast<uint32_t> (sb.m_higherLayerSelected.size ()));
+      for (uint32_t j = 0; j < sb.m_higherLayerSelected.size (); j++)
+        {
+          Put (sb.m_higherLayerSelected[j].m_sbPmi);
+          PutList (sb.m_higherLayerSelected[j].m_sbCqi);
+        }
+      Put (sb.m_bwPart.m_bwPartIndex);
+      Put (sb.m_bwPart.m_sb);
+      Put (sb.m_bwPart.m_cqi);
+    }
+  Flush (TRACE_SCHED_DL_CQI_INFO_REQ);
+}
+
+void
+FfMacSchedTraceWriter::Write (const FfMacSchedSapProvider::SchedUlTriggerReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_sfnSf);
+  Put (params.m_sfnSf);
+  Put (static_cast<uint32_t> (params.m_ulInfoList.size ()));
+  for (uint32_t i = 0; i < params.m_ulInfoList.size (); i++)
+    {
+      const UlInfoListElement_s &info = params.m_ulInfoList[i];
+      Put (info.m_rnti);
+      PutList (info.m_ulReception);
+      Put (static_cast<uint8_t> (info.m_receptionStatus));
+      Put (info.m_tpc);
+    }
+  Flush (TRACE_SCHED_UL_TRIGGER_REQ);
+}
+
+void
+FfMacSchedTraceWriter::Write (const FfMacSchedSapProvider::SchedUlNoiseInterferenceReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_sfnSf);
+  Put (params.m_sfnSf);
+  Put (params.m_rip);
+  Put (params.m_tnp);
+  Flush (TRACE_SCHED_UL_NOISE_INTERFERENCE_REQ);
+}
+
+void
+FfMacSchedTraceWriter::Write (const FfMacSchedSapProvider::SchedUlSrInfoReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_sfnSf);
+  Put (params.m_sfnSf);
+  Put (static_cast<uint32_t> (params.m_srList.size ()));
+  for (uint32_t i = 0; i < params.m_srList.size (); i++)
+    {
+      Put (params.m_srList[i].m_rnti);
+    }
+  Flush (TRACE_SCHED_UL_SR_INFO_REQ);
+}
+
+void
+FfMacSchedTraceWriter::Write (const FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_sfnSf);
+  Put (params.m_sfnSf);
+  Put (static_cast<uint32_t> (params.m_macCeList.size ()));
+  for (uint32_t i = 0; i < params.m_macCeList.size (); i++)
+    {
+      const MacCeListElement_s &ce = params.m_macCeList[i];
+      Put (ce.m_rnti);
+      Put (static_cast<uint8_t> (ce.m_macCeType));
+      Put (ce.m_macCeValue.m_phr);
+      Put (ce.m_macCeValue.m_crnti);
+      PutList (ce.m_macCeValue.m_bufferStatus);
+    }
+  Flush (TRACE_SCHED_UL_MAC_CTRL_INFO_REQ);
+}
+
+void
+FfMacSchedTraceWriter::Write (const FfMacSchedSapProvider::SchedUlCqiInfoReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_sfnSf);
+  Put (params.m_sfnSf);
+  PutList (params.m_ulCqi.m_sinr);
+  Put (static_cast<uint8_t> (params.m_ulCqi.m_type));
+  // the RNTI of the SRS reports is the only vendor specific parameter
+  // used by the schedulers
+  std::vector<uint16_t> srsRntis;
+  for (uint32_t i = 0; i < params.m_vendorSpecificList.size (); i++)
+    {
+      if (params.m_vendorSpecificList[i].m_type == SRS_CQI_RNTI_VSP)
+        {
+          Ptr<SrsCqiRntiVsp> vsp = DynamicCast<SrsCqiRntiVsp> (params.m_vendorSpecificList[i].m_value);
+          srsRntis.push_back (vsp->GetRnti ());
+        }
+    }
+  PutList (srsRntis);
+  Flush (TRACE_SCHED_UL_CQI_INFO_REQ);
+}
+
+void
+FfMacSchedTraceWriter::Write (const FfMacSchedSapUser::SchedDlConfigIndParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+  Put (static_cast<uint32_t> (params.m_buildDataList.size ()));
+  for (uint32_t i = 0; i < params.m_buildDataList.size (); i++)
+    {
+      const BuildDataListElement_s &data = params.m_buildDataList[i];
+      Put (data.m_rnti);
+      Put (data.m_dci.m_rbBitmap);
+      Put (data.m_dci.m_harqProcess);
+      PutList (data.m_dci.m_tbsSize);
+      PutList (data.m_dci.m_mcs);
+      PutList (data.m_dci.m_ndi);
+      PutList (data.m_dci.m_rv);
+    }
+  Put (static_cast<uint32_t> (params.m_buildRarList.size ()));
+  for (uint32_t i = 0; i < params.m_buildRarList.size (); i++)
+    {
+      Put (params.m_buildRarList[i].m_rnti);
+      Put (params.m_buildRarList[i].m_grant.m_tbSize);
+    }
+  Put (params.m_nrOfPdcchOfdmSymbols);
+  Flush (TRACE_SCHED_DL_CONFIG_IND);
+}
+
+void
+FfMacSchedTraceWriter::Write (const FfMacSchedSapUser::SchedUlConfigIndParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+  Put (static_cast<uint32_t> (params.m_dciList.size ()));
+  for (uint32_t i = 0; i < params.m_dciList.size (); i++)
+    {
+      const UlDciListElement_s &dci = params.m_dciList[i];
+      Put (dci.m_rnti);
+      Put (dci.m_rbStart);
+      Put (dci.m_rbLen);
+      Put (dci.m_tbSize);
+      Put (dci.m_mcs);
+      Put (dci.m_ndi);
+    }
+  Put (static_cast<uint32_t> (params.m_phichList.size ()));
+  for (uint32_t i = 0; i < params.m_phichList.size (); i++)
+    {
+      Put (params.m_phichList[i].m_rnti);
+      Put (static_cast<uint8_t> (params.m_phichList[i].m_phich));
+    }
+  Flush (TRACE_SCHED_UL_CONFIG_IND);
+}
+
+// ------------------------------------------------------------------------
+// FfMacSchedTraceReader
+// ------------------------------------------------------------------------
+
+FfMacSchedTraceReader::FfMacSchedTraceReader ()
+  : m_primitive (TRACE_END),
+    m_pos (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+FfMacSchedTraceReader::~FfMacSchedTraceReader ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+void
+FfMacSchedTraceReader::Open (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  Close ();
+  m_file.open (filename.c_str (), std::ios::in | std::ios::binary);
+  if (!m_file.is_open ())
+    {
+      NS_FATAL_ERROR ("Can't open scheduler trace file " << filename);
+    }
+  m_buffer.resize (8);
+  m_pos = 0;
+  m_file.read (reinterpret_cast<char *> (&m_buffer[0]), m_buffer.size ());
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  if (m_file.gcount () == 8)
+    {
+      Take (magic);
+      Take (version);
+    }
+  if (magic != TRACE_MAGIC || version != TRACE_VERSION)
+    {
+      NS_FATAL_ERROR ("File " << filename << " is not a scheduler trace file of version " << TRACE_VERSION);
+    }
+  m_primitive = TRACE_END;
+}
+
+void
+FfMacSchedTraceReader::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_file.is_open ())
+    {
+      m_file.close ();
+    }
+}
+
+FfMacSchedTracePrimitive_e
+FfMacSchedTraceReader::Next (void)
+{
+  uint8_t header[5];
+  m_file.read (reinterpret_cast<char *> (header), sizeof (header));
+  if (m_file.gcount () == 0)
+    {
+      m_primitive = TRACE_END;
+      return m_primitive;
+    }
+  if (m_file.gcount () != sizeof (header) || header[0] == TRACE_END || header[0] > TRACE_SCHED_UL_CONFIG_IND)
+    {
+      NS_FATAL_ERROR ("Corrupted scheduler trace file");
+    }
+  uint32_t size = 0;
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      size |= static_cast<uint32_t> (header[1 + i]) << (8 * i);
+    }
+  m_buffer.resize (size);
+  m_pos = 0;
+  if (size > 0)
+    {
+      m_file.read (reinterpret_cast<char *> (&m_buffer[0]), size);
+      if (m_file.gcount () != static_cast<std::streamsize> (size))
+        {
+          NS_FATAL_ERROR ("Truncated scheduler trace file");
+        }
+    }
+  m_primitive = static_cast<FfMacSchedTracePrimitive_e> (header[0]);
+  return m_primitive;
+}
+
+void
+FfMacSchedTraceReader::Expect (FfMacSchedTracePrimitive_e primitive)
+{
+  NS_ABORT_MSG_IF (m_primitive != primitive,
+                   "The record holds primitive " << m_primitive << ", not " << primitive);
+  m_pos = 0;
+}
+
+void
+FfMacSchedTraceReader::Take (uint8_t &value)
+{
+  NS_ABORT_MSG_IF (m_pos + 1 > m_buffer.size (), "Truncated scheduler trace record");
+  value = m_buffer[m_pos++];
+}
+
+void
+FfMacSchedTraceReader::Take (uint16_t &value)
+{
+  NS_ABORT_MSG_IF (m_pos + 2 > m_buffer.size (), "Truncated scheduler trace record");
+  value = m_buffer[m_pos] | (m_buffer[m_pos + 1] << 8);
+  m_pos += 2;
+}
+
+void
+FfMacSchedTraceReader::Take (uint32_t &value)
+{
+  uint16_t low;
+  uint16_t high;
+  Take (low);
+  Take (high);
+  value = low | (static_cast<uint32_t> (high) << 16);
+}
+
+void
+FfMacSchedTraceReader::Take (uint64_t &value)
+{
+  uint32_t low;
+  uint32_t high;
+  Take (low);
+  Take (high);
+  value = low | (static_cast<uint64_t> (high) << 32);
+}
+
+uint32_t
+FfMacSchedTraceReader::TakeSize (void)
+{
+  uint32_t size;
+  Take (size);
+  // each element takes at least one byte: reject the corrupted sizes
+  // before allocating the list
+  NS_ABORT_MSG_IF (size > m_buffer.size () - m_pos, "Corrupted scheduler trace record");
+  return size;
+}
+
+template <class T>
+void
+FfMacSchedTraceReader::TakeList (std::vector<T> &values)
+{
+  values.resize (TakeSize ());
+  for (uint32_t i = 0; i < values.size (); i++)
+    {
+      Take (values[i]);
+    }
+}
+
+void
+FfMacSchedTraceReader::Get (FfMacCschedSapProvider::CschedCellConfigReqParameters& params)
+{
+  Expect (TRACE_CSCHED_CELL_CONFIG_REQ);
+  Take (params.m_ulBandwidth);
+  Take (params.m_dlBandwidth);
+}
+
+void
+FfMacSchedTraceReader::Get (FfMacCschedSapProvider::CschedUeConfigReqParameters& params)
+{
+  Expect (TRACE_CSCHED_UE_CONFIG_REQ);
+  uint8_t reconfigure;
+  Take (params.m_rnti);
+  Take (reconfigure);
+  params.m_reconfigureFlag = reconfigure;
+  Take (params.m_transmissionMode);
+}
+
+void
+FfMacSchedTraceReader::Get (FfMacCschedSapProvider::CschedLcConfigReqParameters& params)
+{
+  Expect (TRACE_CSCHED_LC_CONFIG_REQ);
+  uint8_t reconfigure;
+  Take (params.m_rnti);
+  Take (reconfigure);
+  params.m_reconfigureFlag = reconfigure;
+  params.m_logicalChannelConfigList.resize (TakeSize ());
+  for (uint32_t i = 0; i < params.m_logicalChannelConfigList.size (); i++)
+    {
+      LogicalChannelConfigListElement_s &lc = params.m_logicalChannelConfigList[i];
+      uint8_t direction;
+      uint8_t qosBearerType;
+      Take (lc.m_logicalChannelIdentity);
+      Take (lc.m_logicalChannelGroup);
+      Take (direction);
+      lc.m_direction = static_cast<LogicalChannelConfigListElement_s::Direction_e> (direction);
+      Take (qosBearerType);
+      lc.m_qosBearerType = static_cast<LogicalChannelConfigListElement_s::QosBearerType_e> (qosBearerType);
+      Take (lc.m_qci);
+      Take (lc.m_eRabMaximulBitrateUl);
+      Take (lc.m_eRabMaximulBitrateDl);
+      Take (lc.m_eRabGuaranteedBitrateUl);
+      Take (lc.m_eRabGuaranteedBitrateDl);
+    }
+}
+
+void
+FfMacSchedTraceReader::Get (FfMacCschedSapProvider::CschedLcReleaseReqParameters& params)
+{
+  Expect (TRACE_CSCHED_LC_RELEASE_REQ);
+  Take (params.m_rnti);
+  TakeList (params.m_logicalChannelIdentity);
+}
+
+void
+FfMacSchedTraceReader::Get (FfMacCschedSapProvider::CschedUeReleaseReqParameters& params)
+{
+  Expect (TRACE_CSCHED_UE_RELEASE_REQ);
+  Take (params.m_rnti);
+}
+
+void
+FfMacSchedTraceReader::Get (FfMacSchedSapProvider::SchedDlRlcBufferReqParameters& params)
+{
+  Expect (TRACE_SCHED_DL_RLC_BUFFER_REQ);
+  Take (params.m_rnti);
+  Take (params.m_logicalChannelIdentity);
+  Take (params.m_rlcTransmissionQueueSize);
+  Take (params.m_rlcTransmissionQueueHolDelay);
+  Take (params.m_rlcRetransmissionQueueSize);
+  Take (params.m_rlcRetransmissionHolDelay);
+  Take (params.m_rlcStatusPduSize);
+}
+
+void
+FfMacSchedTraceReader::Get (FfMacSchedSapProvider::SchedDlMacBufferReqParameters& params)
+{
+  Expect (TRACE_SCHED_DL_MAC_BUFFER_REQ);
+  uint8_t ceBitmap;
+  Take (params.m_rnti);
+  Take (ceBitmap);
+  params.m_ceBitmap = static_cast<CeBitmap_e> (ceBitmap);
+}
+
+void
+FfMacSchedTraceReader::Get (FfMacSchedSapProvider::SchedDlTriggerReqParameters& params)
+{
+  Expect (TRACE_SCHED_DL_TRIGGER_REQ);
+  Take (params.m_sfnSf);
+  params.m_dlInfoList.resize (TakeSize ());
+  for (uint32_t i = 0; i < params.m_dlInfoList.size (); i++)
+    {
+      DlInfoListElement_s &info = params.m_dlInfoList[i];
+      Take (info.m_rnti);
+      Take (info.m_harqProcessId);
+      info.m_harqStatus.resize (TakeSize ());
+      for (uint32_t j = 0; j < info.m_harqStatus.size (); j++)
+        {
+          uint8_t status;
+          Take (status);
+          info.m_harqStatus[j] = static_cast<DlInfoListElement_s::HarqStatus_e> (status);
+        }
+    }
+}
+
+void
+FfMacSchedTraceReader::Get (FfMacSchedSapProvider::SchedDlRachInfoReqParameters& params)
+{
+  Expect (TRACE_SCHED_DL_RACH_INFO_REQ);
+  Take (params.m_sfnSf);
+  params.m_rachList.resize (TakeSize ());
+  for (uint32_t i = 0; i < params.m_rachList.size (); i++)
+    {
+      Take (params.m_rachList[i].m_rnti);
+      Take (params.m_rachList[i].m_estimatedSize);
+    }
+}
+
+void
+FfMacSchedTraceReader::Get (FfMacSchedSapProvider::SchedDlCqiInfoReqParameters& params)
+{
+  Expect (TRACE_SCHED_DL_CQI_INFO_REQ);
+  Take (params.m_sfnSf);
+  params.m_cqiList.resize (TakeSize ());
+  for (uint32_t i = 0; i < params.m_cqiList.size (); i++)
+    {
+      CqiListElement_s &cqi = params.m_cqiList[i];
+      uint8_t cqiType;
+      Take (cqi.m_rnti);
+      Take (cqi.m_ri);
+      Take (cqiType);
+      cqi.m_cqiType = static_cast<CqiListElement_s::CqiType_e> (cqiType);
+      TakeList (cqi.m_wbCqi);
+      Take (cqi.m_wbPmi);
+      SbMeasResult_s &sb = cqi.m_sbMeasResult;
+      TakeList (sb.m_ueSelected.m_sbList);
+      Take (sb.m_ueSelected.m_sbPmi);
+      TakeList (sb.m_ueSelected.m_sbCqi);
+      sb.m_higherLayerSelected.resize (TakeSize ());
+      for (uint32_t j = 0; j < sb.m_higherLayerSelected.size (); j++)
+        {
+          Take (sb.m_higherLayerSelected[j].m_sbPmi);
+          TakeList (sb.m_higherLayerSelected[j].m_sbCqi);
+        }
+      Take (sb.m_bwPart.m_bwPartIndex);
+      Take (sb.m_bwPart.m_sb);
+      Take (sb.m_bwPart.m_cqi);
+    }
+}
+
+void
+FfMacSchedTraceReader::Get (FfMacSchedSapProvider::SchedUlTriggerReqParameters& params)
+{
+  Expect (TRACE_SCHED_UL_TRIGGER_REQ);
+  Take (params.m_sfnSf);
+  params.m_ulInfoList.resize (TakeSize ());
+  for (uint32_t i = 0; i < params.m_ulInfoList.size (); i++)
+    {
+      UlInfoListElement_s &info = params.m_ulInfoList[i];
+      uint8_t status;
+      Take (info.m_rnti);
+      TakeList (info.m_ulReception);
+      Take (status);
+      info.m_receptionStatus = static_cast<UlInfoListElement_s::ReceptionStatus_e> (status);
+      Take (info.m_tpc);
+    }
+}
+
+void
+FfMacSchedTraceReader::Get (FfMacSchedSapProvider::SchedUlNoiseInterferenceReqParameters& params)
+{
+  Expect (TRACE_SCHED_UL_NOISE_INTERFERENCE_REQ);
+  Take (params.m_sfnSf);
+  Take (params.m_rip);
+  Take (params.m_tnp);
+}
+
+void
+FfMacSchedTraceReader::Get (FfMacSchedSapProvider::SchedUlSrInfoReqParameters& params)
+{
+  Expect (TRACE_SCHED_UL_SR_INFO_REQ);
+  Take (params.m_sfnSf);
+  params.m_srList.resize (TakeSize ());
+  for (uint32_t i = 0; i < params.m_srList.size (); i++)
+    {
+      Take (params.m_srList[i].m_rnti);
+    }
+}
+
+void
+FfMacSchedTraceReader::Get (FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters& params)
+{
+  Expect (TRACE_SCHED_UL_MAC_CTRL_INFO_REQ);
+  Take (params.m_sfnSf);
+  params.m_macCeList.resize (TakeSize ());
+  for (uint32_t i = 0; i < params.m_macCeList.size (); i++)
+    {
+      MacCeListElement_s &ce = params.m_macCeList[i];
+      uint8_t type;
+      Take (ce.m_rnti);
+      Take (type);
+      ce.m_macCeType = static_cast<MacCeListElement_s::MacCeType_e> (type);
+      Take (ce.m_macCeValue.m_phr);
+      Take (ce.m_macCeValue.m_crnti);
+      TakeList (ce.m_macCeValue.m_bufferStatus);
+    }
+}
+
+void
+FfMacSchedTraceReader::Get (FfMacSchedSapProvider::SchedUlCqiInfoReqParameters& params)
+{
+  Expect (TRACE_SCHED_UL_CQI_INFO_REQ);
+  uint8_t type;
+  std::vector<uint16_t> srsRntis;
+  Take (params.m_sfnSf);
+  TakeList (params.m_ulCqi.m_sinr);
+  Take (type);
+  params.m_ulCqi.m_type = static_cast<UlCqi_s::Type_e> (type);
+  TakeList (srsRntis);
+  params.m_vendorSpecificList.clear ();
+  for (uint32_t i = 0; i < srsRntis.size (); i++)
+    {
+      VendorSpecificListElement_s vsp;
+      vsp.m_type = SRS_CQI_RNTI_VSP;
+      vsp.m_length = sizeof (SrsCqiRntiVsp);
+      vsp.m_value = Create<SrsCqiRntiVsp> (srsRntis[i]);
+      params.m_vendorSpecificList.push_back (vsp);
+    }
+}
+
+void
+FfMacSchedTraceReader::Get (FfMacSchedSapUser::SchedDlConfigIndParameters& params)
+{
+  Expect (TRACE_SCHED_DL_CONFIG_IND);
+  params.m_buildDataList.resize (TakeSize ());
+  for (uint32_t i = 0; i < params.m_buildDataList.size (); i++)
+    {
+      BuildDataListElement_s &data = params.m_buildDataList[i];
+      Take (data.m_rnti);
+      data.m_dci.m_rnti = data.m_rnti;
+      Take (data.m_dci.m_rbBitmap);
+      Take (data.m_dci.m_harqProcess);
+      TakeList (data.m_dci.m_tbsSize);
+      TakeList (data.m_dci.m_mcs);
+      TakeList (data.m_dci.m_ndi);
+      TakeList (data.m_dci.m_rv);
+    }
+  params.m_buildRarList.resize (TakeSize ());
+  for (uint32_t i = 0; i < params.m_buildRarList.size (); i++)
+    {
+      Take (params.m_buildRarList[i].m_rnti);
+      params.m_buildRarList[i].m_grant.m_rnti = params.m_buildRarList[i].m_rnti;
+      Take (params.m_buildRarList[i].m_grant.m_tbSize);
+    }
+  Take (params.m_nrOfPdcchOfdmSymbols);
+}
+
+void
+FfMacSchedTraceReader::Get (FfMacSchedSapUser::SchedUlConfigIndParameters& params)
+{
+  Expect (TRACE_SCHED_UL_CONFIG_IND);
+  params.m_dciList.resize (TakeSize ());
+  for (uint32_t i = 0; i < params.m_dciList.size (); i++)
+    {
+      UlDciListElement_s &dci = params.m_dciList[i];
+      Take (dci.m_rnti);
+      Take (dci.m_rbStart);
+      Take (dci.m_rbLen);
+      Take (dci.m_tbSize);
+      Take (dci.m_mcs);
+      Take (dci.m_ndi);
+    }
+  params.m_phichList.resize (TakeSize ());
+  for (uint32_t i = 0; i < params.m_phichList.size (); i++)
+    {
+      uint8_t phich;
+      Take (params.m_phichList[i].m_rnti);
+      Take (phich);
+      params.m_phichList[i].m_phich = static_cast<PhichListElement_s::Phich_e> (phich);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,375 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FF_MAC_SCHED_TRACE_H
+#define FF_MAC_SCHED_TRACE_H
+
+#include <stdint.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <ns3/ff-mac-csched-sap.h>
+#include <ns3/ff-mac-sched-sap.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup ff-api
+ *
+ * The primitives of the FF MAC Scheduler API stored in a scheduler
+ * trace file.
+ */
+enum FfMacSchedTracePrimitive_e
+{
+  TRACE_END = 0,                           ///< end of the trace
+  TRACE_CSCHED_CELL_CONFIG_REQ,            ///< CschedCellConfigReq
+  TRACE_CSCHED_UE_CONFIG_REQ,              ///< CschedUeConfigReq
+  TRACE_CSCHED_LC_CONFIG_REQ,              ///< CschedLcConfigReq
+  TRACE_CSCHED_LC_RELEASE_REQ,             ///< CschedLcReleaseReq
+  TRACE_CSCHED_UE_RELEASE_REQ,             ///< CschedUeReleaseReq
+  TRACE_SCHED_DL_RLC_BUFFER_REQ,           ///< SchedDlRlcBufferReq
+  TRACE_SCHED_DL_MAC_BUFFER_REQ,           ///< SchedDlMacBufferReq
+  TRACE_SCHED_DL_TRIGGER_REQ,              ///< SchedDlTriggerReq
+  TRACE_SCHED_DL_RACH_INFO_REQ,            ///< SchedDlRachInfoReq
+  TRACE_SCHED_DL_CQI_INFO_REQ,             ///< SchedDlCqiInfoReq
+  TRACE_SCHED_UL_TRIGGER_REQ,              ///< SchedUlTriggerReq
+  TRACE_SCHED_UL_NOISE_INTERFERENCE_REQ,   ///< SchedUlNoiseInterferenceReq
+  TRACE_SCHED_UL_SR_INFO_REQ,              ///< SchedUlSrInfoReq
+  TRACE_SCHED_UL_MAC_CTRL_INFO_REQ,        ///< SchedUlMacCtrlInfoReq
+  TRACE_SCHED_UL_CQI_INFO_REQ,             ///< SchedUlCqiInfoReq
+  TRACE_SCHED_DL_CONFIG_IND,               ///< SchedDlConfigInd
+  TRACE_SCHED_UL_CONFIG_IND                ///< SchedUlConfigInd
+};
+
+/**
+ * \ingroup ff-api
+ *
+ * \brief Writer of the FF MAC Scheduler API calls to a trace file.
+ *
+ * The trace file is a compact binary file: a header, followed by one
+ * record per call, made of the primitive (1 byte), the size of the
+ * payload (4 bytes) and the payload.  All the integers are stored in
+ * little endian order, and each list is stored as its number of
+ * elements followed by the elements.
+ *
+ * The records hold the fields of the requests which are used by the
+ * schedulers of this module; the vendor specific parameters are
+ * limited to the RNTI of the SRS UL CQIs.  The indications hold the
+ * allocation outcome of each UE: its resources, transport blocks and
+ * HARQ process.
+ */
+class FfMacSchedTraceWriter
+{
+public:
+  FfMacSchedTraceWriter ();
+  ~FfMacSchedTraceWriter ();
+
+  /**
+   * Create a trace file, or truncate it, and write its header.
+   * \param filename the name of the file
+   */
+  void Open (std::string filename);
+  /// Close the trace file
+  void Close (void);
+  /// \return true if the trace file is open
+  bool IsOpen (void) const;
+
+  /**
+   * Write a call
+   * \param params the parameters of the call
+   */
+  void Write (const FfMacCschedSapProvider::CschedCellConfigReqParameters& params);
+  /**
+   * Write a call
+   * \param params the parameters of the call
+   */
+  void Write (const FfMacCschedSapProvider::CschedUeConfigReqParameters& params);
+  /**
+   * Write a call
+   * \param params the parameters of the call
+   */
+  void Write (const FfMacCschedSapProvider::CschedLcConfigReqParameters& params);
+  /**
+   * Write a call
+   * \param params the parameters of the call
+   */
+  void Write (const FfMacCschedSapProvider::CschedLcReleaseReqParameters& params);
+  /**
+   * Write a call
+   * \param params the parameters of the call
+   */
+  void Write (const FfMacCschedSapProvider::CschedUeReleaseReqParameters& params);
+  /**
+   * Write a call
+   * \param params the parameters of the call
+   */
+  void Write (const FfMacSchedSapProvider::SchedDlRlcBufferReqParameters& params);
+  /**
+   * Write a call
+   * \param params the parameters of the call
+   */
+  void Write (const FfMacSchedSapProvider::SchedDlMacBufferReqParameters& params);
+  /**
+   * Write a call
+   * \param params the parameters of the call
+   */
+  void Write (const FfMacSchedSapProvider::SchedDlTriggerReqParameters& params);
+  /**
+   * Write a call
+   * \param params the parameters of the call
+   */
+  void Write (const FfMacSchedSapProvider::SchedDlRachInfoReqParameters& params);
+  /**
+   * Write a call
+   * \param params the parameters of the call
+   */
+  void Write (const FfMacSchedSapProvider::SchedDlCqiInfoReqParameters& params);
+  /**
+   * Write a call
+   * \param params the parameters of the call
+   */
+  void Write (const FfMacSchedSapProvider::SchedUlTriggerReqParameters& params);
+  /**
+   * Write a call
+   * \param params the parameters of the call
+   */
+  void Write (const FfMacSchedSapProvider::SchedUlNoiseInterferenceReqParameters& params);
+  /**
+   * Write a call
+   * \param params the parameters of the call
+   */
+  void Write (const FfMacSchedSapProvider::SchedUlSrInfoReqParameters& params);
+  /**
+   * Write a call
+   * \param params the parameters of the call
+   */
+  void Write (const FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters& params);
+  /**
+   * Write a call
+   * \param params the parameters of the call
+   */
+  void Write (const FfMacSchedSapProvider::SchedUlCqiInfoReqParameters& params);
+  /**
+   * Write a call
+   * \param params the parameters of the call
+   */
+  void Write (const FfMacSchedSapUser::SchedDlConfigIndParameters& params);
+  /**
+   * Write a call
+   * \param params the parameters of the call
+   */
+  void Write (const FfMacSchedSapUser::SchedUlConfigIndParameters& params);
+
+private:
+  /**
+   * Write the record held in m_buffer.
+   * \param primitive the primitive of the record
+   */
+  void Flush (FfMacSchedTracePrimitive_e primitive);
+  /**
+   * Append an integer to the record.
+   * \param value the integer
+   */
+  void Put (uint8_t value);
+  /**
+   * Append an integer to the record.
+   * \param value the integer
+   */
+  void Put (uint16_t value);
+  /**
+   * Append an integer to the record.
+   * \param value the integer
+   */
+  void Put (uint32_t value);
+  /**
+   * Append an integer to the record.
+   * \param value the integer
+   */
+  void Put (uint64_t value);
+  /**
+   * Append a list of integers to the record.
+   * \param values the integers
+   */
+  template <class T>
+  void PutList (const std::vector<T> &values);
+
+  std::ofstream m_file;            ///< the trace file
+  std::vector<uint8_t> m_buffer;   ///< the payload of the current record
+};
+
+/**
+ * \ingroup ff-api
+ *
+ * \brief Reader of the trace files written by FfMacSchedTraceWriter.
+ *
+ * The records are read one by one with Next (), which returns their
+ * primitive; the parameters of the call are then decoded with the Get
+ * method which matches the primitive.  The fields which are not stored
+ * in the trace are left to their default value.
+ */
+class FfMacSchedTraceReader
+{
+public:
+  FfMacSchedTraceReader ();
+  ~FfMacSchedTraceReader ();
+
+  /**
+   * Open a trace file and check its header.
+   * \param filename the name of the file
+   */
+  void Open (std::string filename);
+  /// Close the trace file
+  void Close (void);
+
+  /**
+   * Read the next record.
+   * \return the primitive of the record, or TRACE_END at the end of the file
+   */
+  FfMacSchedTracePrimitive_e Next (void);
+
+  /**
+   * Decode the current record.
+   * \param params the parameters of the call
+   */
+  void Get (FfMacCschedSapProvider::CschedCellConfigReqParameters& params);
+  /**
+   * Decode the current record.
+   * \param params the parameters of the call
+   */
+  void Get (FfMacCschedSapProvider::CschedUeConfigReqParameters& params);
+  /**
+   * Decode the current record.
+   * \param params the parameters of the call
+   */
+  void Get (FfMacCschedSapProvider::CschedLcConfigReqParameters& params);
+  /**
+   * Decode the current record.
+   * \param params the parameters of the call
+   */
+  void Get (FfMacCschedSapProvider::CschedLcReleaseReqParameters& params);
+  /**
+   * Decode the current record.
+   * \param params the parameters of the call
+   */
+  void Get (FfMacCschedSapProvider::CschedUeReleaseReqParameters& params);
+  /**
+   * Decode the current record.
+   * \param params the parameters of the call
+   */
+  void Get (FfMacSchedSapProvider::SchedDlRlcBufferReqParameters& params);
+  /**
+   * Decode the current record.
+   * \param params the parameters of the call
+   */
+  void Get (FfMacSchedSapProvider::SchedDlMacBufferReqParameters& params);
+  /**
+   * Decode the current record.
+   * \param params the parameters of the call
+   */
+  void Get (FfMacSchedSapProvider::SchedDlTriggerReqParameters& params);
+  /**
+   * Decode the current record.
+   * \param params the parameters of the call
+   */
+  void Get (FfMacSchedSapProvider::SchedDlRachInfoReqParameters& params);
+  /**
+   * Decode the current record.
+   * \param params the parameters of the call
+   */
+  void Get (FfMacSchedSapProvider::SchedDlCqiInfoReqParameters& params);
+  /**
+   * Decode the current record.
+   * \param params the parameters of the call
+   */
+  void Get (FfMacSchedSapProvider::SchedUlTriggerReqParameters& params);
+  /**
+   * Decode the current record.
+   * \param params the parameters of the call
+   */
+  void Get (FfMacSchedSapProvider::SchedUlNoiseInterferenceReqParameters& params);
+  /**
+   * Decode the current record.
+   * \param params the parameters of the call
+   */
+  void Get (FfMacSchedSapProvider::SchedUlSrInfoReqParameters& params);
+  /**
+   * Decode the current record.
+   * \param params the parameters of the call
+   */
+  void Get (FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters& params);
+  /**
+   * Decode the current record.
+   * \param params the parameters of the call
+   */
+  void Get (FfMacSchedSapProvider::SchedUlCqiInfoReqParameters& params);
+  /**
+   * Decode the current record.
+   * \param params the parameters of the call
+   */
+  void Get (FfMacSchedSapUser::SchedDlConfigIndParameters& params);
+  /**
+   * Decode the current record.
+   * \param params the parameters of the call
+   */
+  void Get (FfMacSchedSapUser::SchedUlConfigIndParameters& params);
+
+private:
+  /**
+   * Start decoding the current record.
+   * \param primitive the expected primitive of the record
+   */
+  void Expect (FfMacSchedTracePrimitive_e primitive);
+  /**
+   * Decode an integer of the record.
+   * \param value the integer
+   */
+  void Take (uint8_t &value);
+  /**
+   * Decode an integer of the record.
+   * \param value the integer
+   */
+  void Take (uint16_t &value);
+  /**
+   * Decode an integer of the record.
+   * \param value the integer
+   */
+  void Take (uint32_t &value);
+  /**
+   * Decode an integer of the record.
+   * \param value the integer
+   */
+  void Take (uint64_t &value);
+  /**
+   * Decode a list of integers of the record.
+   * \param values the integers
+   */
+  template <class T>
+  void TakeList (std::vector<T> &values);
+  /**
+   * Decode the number of elements of a list of the record.
+   * \return the number of elements
+   */
+  uint32_t TakeSize (void);
+
+  std::ifstream m_file;                     ///< the trace file
+  FfMacSchedTracePrimitive_e m_primitive;   ///< the primitive of the current record
+  std::vector<uint8_t> m_buffer;            ///< the payload of the current record
+  uint32_t m_pos;                           ///< the position of the decoder in m_buffer
+};
+
+} // namespace ns3
+
+#endif /* FF_MAC_SCHED_TRACE_H */
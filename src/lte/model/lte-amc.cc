@@ -26,6 +26,7 @@
 #include <ns3/assert.h>
 #include <ns3/math.h>
 #include <vector>
+#include <algorithm>
 #include <ns3/spectrum-value.h>
 #include <ns3/double.h>
 #include "ns3/enum.h"
@@ -231,6 +232,7 @@ static const int TransportBlockSizeTable [110][27] = {
 
 
 LteAmc::LteAmc ()
+  : m_cqiSinrThresholdsBer (-1.0)
 {
 }
 
@@ -266,11 +268,9 @@ LteAmc::GetCqiFromSpectralEfficiency (double s)
 {
   NS_LOG_FUNCTION (s);
   NS_ASSERT_MSG (s >= 0.0, "negative spectral efficiency = " << s);
-  int cqi = 0;
-  while ((cqi < 15) && (SpectralEfficiencyForCqi[cqi + 1] < s))
-    {
-      ++cqi;
-    }
+  // the highest CQI whose spectral efficiency is lower than s
+  int cqi = std::lower_bound (SpectralEfficiencyForCqi + 1, SpectralEfficiencyForCqi + 16, s)
+    - (SpectralEfficiencyForCqi + 1);
   NS_LOG_LOGIC ("cqi = " << cqi);
   return cqi;
 }
@@ -282,11 +282,9 @@ LteAmc::GetMcsFromCqi (int cqi)
   NS_LOG_FUNCTION (cqi);
   NS_ASSERT_MSG (cqi >= 0 && cqi <= 15, "CQI must be in [0..15] = " << cqi);
   double spectralEfficiency = SpectralEfficiencyForCqi[cqi];
-  int mcs = 0;
-  while ((mcs < 28) && (SpectralEfficiencyForMcs[mcs + 1] <= spectralEfficiency))
-    {
-      ++mcs;
-    }
+  // the highest MCS whose spectral efficiency is not higher than the one of the CQI
+  int mcs = std::upper_bound (SpectralEfficiencyForMcs + 1, SpectralEfficiencyForMcs + 29, spectralEfficiency)
+    - (SpectralEfficiencyForMcs + 1);
   NS_LOG_LOGIC ("mcs = " << mcs);
   return mcs;
 }
@@ -326,6 +324,28 @@ LteAmc::GetSpectralEfficiencyFromCqi (int cqi)
 }
 
 
+void
+LteAmc::UpdateCqiSinrThresholds ()
+{
+  NS_LOG_FUNCTION (this << m_ber);
+  /*
+   * The spectral efficiency of a SINR is
+   *                                        SINR
+   * spectralEfficiency = log2 (1 + -------------------- )
+   *                                    -ln(5*BER)/1.5
+   * hence the spectral efficiency of a CQI is exceeded above the SINR
+   * (2^spectralEfficiency - 1) * (-ln(5*BER)/1.5), in linear units.
+   */
+  double gap = (-std::log (5.0 * m_ber)) / 1.5;
+  m_cqiSinrThresholds.resize (16);
+  for (uint32_t cqi = 0; cqi < 16; cqi++)
+    {
+      m_cqiSinrThresholds[cqi] = (std::pow (2.0, SpectralEfficiencyForCqi[cqi]) - 1) * gap;
+    }
+  m_cqiSinrThresholdsBer = m_ber;
+}
+
+
 std::vector<int>
 LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
 {
@@ -336,7 +356,16 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
   
   if (m_amcModel == PiroEW2010)
     {
-
+      if (m_cqiSinrThresholdsBer != m_ber)
+        {
+          UpdateCqiSinrThresholds ();
+        }
+      // the CQI of a RB is the number of CQIs whose SINR threshold is
+      // below the SINR of the RB: compare the SINRs with the thresholds
+      // instead of evaluating the spectral efficiency of every RB
+      const double *first = &m_cqiSinrThresholds[1];
+      const double *last = first + 15;
+      cqi.reserve (sinr.GetSpectrumModel ()->GetNumBands ());
       for (it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
         {
           double sinr_ = (*it);
@@ -346,22 +375,12 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
             }
           else
             {
-              /*
-              * Compute the spectral efficiency from the SINR
-              *                                        SINR
-              * spectralEfficiency = log2 (1 + -------------------- )
-              *                                    -ln(5*BER)/1.5
-              * NB: SINR must be expressed in linear units
-              */
-
-              double s = log2 ( 1 + ( sinr_ / ( (-std::log (5.0 * m_ber )) / 1.5) ));
-
-              int cqi_ = GetCqiFromSpectralEfficiency (s);
+              int cqi_ = std::lower_bound (first, last, sinr_) - first;
 
               NS_LOG_LOGIC (" PRB =" << cqi.size ()
                                     << ", sinr = " << sinr_
                                     << " (=" << 10 * std::log10 (sinr_) << " dB)"
-                                    << ", spectral efficiency =" << s
+                                    << ", spectral efficiency =" << log2 (1 + sinr_ / ((-std::log (5.0 * m_ber)) / 1.5))
                                     << ", CQI = " << cqi_ << ", BER = " << m_ber);
 
               cqi.push_back (cqi_);
@@ -373,18 +392,26 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
       NS_LOG_DEBUG (this << " AMC-VIENNA RBG size " << (uint16_t)rbgSize);
       NS_ASSERT_MSG (rbgSize > 0, " LteAmc-Vienna: RBG size must be greater than 0");
       std::vector <int> rbgMap;
+      HarqProcessInfoList_t harqInfoList;
       int rbId = 0;
       for (it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
       {
         rbgMap.push_back (rbId++);
         if ((rbId % rbgSize == 0)||((it+1)==sinr.ConstValuesEnd ()))
          {
+            // the MI of the RBG only depends on the modulation: evaluate
+            // it once for QPSK, 16-QAM and 64-QAM rather than for every MCS
+            double mi[3] = {
+              LteMiErrorModel::Mib (sinr, rbgMap, 0),
+              LteMiErrorModel::Mib (sinr, rbgMap, MI_QPSK_MAX_ID + 1),
+              LteMiErrorModel::Mib (sinr, rbgMap, MI_16QAM_MAX_ID + 1)
+            };
             uint8_t mcs = 0;
             TbStats_t tbStats;
             while (mcs <= 28)
               {
-                HarqProcessInfoList_t harqInfoList;
-                tbStats = LteMiErrorModel::GetTbDecodificationStats (sinr, rbgMap, (uint16_t)GetDlTbSizeFromMcs (mcs, rbgSize) / 8, mcs, harqInfoList);
+                double tbMi = mi[mcs <= MI_QPSK_MAX_ID ? 0 : (mcs <= MI_16QAM_MAX_ID ? 1 : 2)];
+                tbStats = LteMiErrorModel::GetTbDecodificationStats (tbMi, (uint16_t)GetDlTbSizeFromMcs (mcs, rbgSize) / 8, mcs, harqInfoList);
                 if (tbStats.tbler > 0.1)
                   {
                     break;
@@ -408,19 +435,11 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
               }
             else
               {
-                double s = SpectralEfficiencyForMcs[mcs];
-                rbgCqi = 0;
-                while ((rbgCqi < 15) && (SpectralEfficiencyForCqi[rbgCqi + 1] < s))
-                {
-                  ++rbgCqi;
-                }
+                rbgCqi = GetCqiFromSpectralEfficiency (SpectralEfficiencyForMcs[mcs]);
               }
             NS_LOG_DEBUG (this << "\t MCS " << (uint16_t)mcs << "-> CQI " << rbgCqi);
             // fill the cqi vector (per RB basis)
-            for (uint8_t j = 0; j < rbgSize; j++)
-              {
-                cqi.push_back (rbgCqi);
-              }
+            cqi.insert (cqi.end (), rbgSize, rbgCqi);
             rbgMap.clear ();
          }
         
@@ -118,6 +118,12 @@ public:
   int GetCqiFromSpectralEfficiency (double s);
   
 private:
+
+  /**
+   * \brief Compute the SINR above which the spectral efficiency of each
+   * CQI is exceeded with the PiroEW2010 model, for the current BER.
+   */
+  void UpdateCqiSinrThresholds ();
   
   /**
    * The `Ber` attribute.
@@ -133,6 +139,11 @@ private:
    */
   AmcModel m_amcModel;
 
+  /// The SINR thresholds of the CQIs, in linear units, by CQI
+  std::vector<double> m_cqiSinrThresholds;
+  /// The BER the SINR thresholds were computed for
+  double m_cqiSinrThresholdsBer;
+
 }; // end of `class LteAmc`
 
 
@@ -23,7 +23,7 @@
 
 #include <stdio.h>
 #include <sstream>
-#include <cmath>
+#include <algorithm>
 
 namespace ns3 {
 
@@ -31,6 +31,9 @@ NS_LOG_COMPONENT_DEFINE ("Asn1Header");
 
 NS_OBJECT_ENSURE_REGISTERED (Asn1Header);
 
+/// Size of the largest IE serialized so far, reserved for the next ones
+static uint32_t g_maxSerializedSize = 64;
+
 TypeId
 Asn1Header::GetTypeId (void)
 {
@@ -52,6 +55,8 @@ Asn1Header::Asn1Header ()
   m_serializationPendingBits = 0x00;
   m_numSerializationPendingBits = 0;
   m_isDataSerialized = false;
+  m_serializationWord = 0;
+  m_numSerializationWordBits = 0;
 }
 
 Asn1Header::~Asn1Header ()
@@ -65,7 +70,7 @@ Asn1Header::GetSerializedSize (void) const
     {
       PreSerialize ();
     }
-  return m_serializationResult.GetSize ();
+  return m_serializationResult.size ();
 }
 
 void Asn1Header::Serialize (Buffer::Iterator bIterator) const
@@ -74,98 +79,73 @@ void Asn1Header::Serialize (Buffer::Iterator bIterator) const
     {
       PreSerialize ();
     }
-  bIterator.Write (m_serializationResult.Begin (),m_serializationResult.End ());
+  if (!m_serializationResult.empty ())
+    {
+      bIterator.Write (&m_serializationResult[0], m_serializationResult.size ());
+    }
+}
+
+void Asn1Header::StartSerialization () const
+{
+  m_serializationResult.clear ();
+  m_serializationResult.reserve (g_maxSerializedSize);
+  m_serializationWord = 0;
+  m_numSerializationWordBits = 0;
 }
 
 void Asn1Header::WriteOctet (uint8_t octet) const
 {
-  m_serializationResult.AddAtEnd (1);
-  Buffer::Iterator bIterator = m_serializationResult.End ();
-  bIterator.Prev ();
-  bIterator.WriteU8 (octet);
+  WriteBits (octet, 8);
 }
 
-template <int N>
-void Asn1Header::SerializeBitset (std::bitset<N> data) const
+void Asn1Header::WriteBits (uint32_t bits, uint8_t numBits) const
 {
+  NS_ASSERT (numBits <= 32);
+  if (numBits < 32)
+    {
+      bits &= (1U << numBits) - 1;
+    }
+
+  // The word holds less than 32 bits, so the new ones always fit in
+  m_serializationWord = (m_serializationWord << numBits) | bits;
+  m_numSerializationWordBits += numBits;
 
-  size_t dataSize = data.size ();
-  uint8_t pendingBits = dataSize;
-  uint8_t mask = 1;
-  int j;
+  if (m_numSerializationWordBits >= 32)
+    {
+      m_numSerializationWordBits -= 32;
+      uint32_t word = m_serializationWord >> m_numSerializationWordBits;
+      size_t size = m_serializationResult.size ();
+      m_serializationResult.resize (size + 4);
+      m_serializationResult[size] = word >> 24;
+      m_serializationResult[size + 1] = word >> 16;
+      m_serializationResult[size + 2] = word >> 8;
+      m_serializationResult[size + 3] = word;
+    }
+}
 
+template <int N>
+void Asn1Header::SerializeBitset (std::bitset<N> data) const
+{
   // No extension marker (Clause 16.7 ITU-T X.691),
   // as 3GPP TS 36.331 does not use it in its IE's.
 
-  // Clause 16.8 ITU-T X.691
-  if (dataSize == 0)
+  // Clause 16.8 ITU-T X.691: nothing is written for N = 0
+
+  // Clause 16.11 ITU-T X.691
+  if (N > 65536)
     {
+      printf ("FRAGMENTATION NEEDED!\n");
       return;
     }
 
   // Clause 16.9 ITU-T X.691
   // Clause 16.10 ITU-T X.691
-  if (dataSize <= 65536)
+  // Write the bits 32 at a time, most significant first
+  const std::bitset<N> mask (0xffffffff);
+  for (int high = N; high > 0; high -= 32)
     {
-      // If there are bits pending to be processed,
-      // append first bits in data to complete an octet.
-      if (m_numSerializationPendingBits > 0)
-        {
-          mask = 0x80 >> m_numSerializationPendingBits;
-          while (pendingBits > 0 && m_numSerializationPendingBits < 8)
-            {
-              m_serializationPendingBits |= (data[pendingBits - 1]) ? mask : 0;
-              pendingBits--;
-              m_numSerializationPendingBits++;
-              mask = (mask >> 1) & (~mask);
-            }
-
-          if (m_numSerializationPendingBits >= 8)
-            {
-              WriteOctet (m_serializationPendingBits);
-              m_numSerializationPendingBits = 0;
-              m_serializationPendingBits = 0;
-            }
-        }
-
-      while (pendingBits > 0)
-        {
-          mask = 1;
-          j = 8;
-
-          // If there are less than 8 remaining bits,
-          // store it to m_serializationPendingBits.
-          if (pendingBits < 8)
-            {
-              mask = 0x80;
-              m_numSerializationPendingBits = pendingBits;
-              while (pendingBits > 0)
-                {
-                  m_serializationPendingBits |= (data[pendingBits - 1]) ? mask : 0;
-                  mask = (mask >> 1) & (~mask);
-                  pendingBits--;
-                }
-            }
-
-          // Write the data to buffer
-          else
-            {
-              uint8_t octetToWrite = 0;
-              for (; j > 0; j--)
-                {
-                  octetToWrite |= (data[pendingBits - j]) ? mask : 0;
-                  mask = (mask << 1) & (~mask);
-                }
-              WriteOctet (octetToWrite);
-              pendingBits -= 8;
-            }
-        }
-    }
-
-  // Clause 16.11 ITU-T X.691
-  else
-    {
-      printf ("FRAGMENTATION NEEDED!\n");
+      int numBits = (high < 32) ? high : 32;
+      WriteBits (((data >> (high - numBits)) & mask).to_ulong (), numBits);
     }
 }
 
@@ -336,76 +316,18 @@ void Asn1Header::SerializeInteger (int n, int nmin, int nmax) const
     }
 
   // Clause 11.5.6 ITU-T X.691
-  int requiredBits = std::ceil (std::log (range) / std::log (2.0));
+  uint8_t requiredBits = 1;
+  while ((1 << requiredBits) < range)
+    {
+      requiredBits++;
+    }
 
-  switch (requiredBits)
+  if (requiredBits > 20)
     {
-    case 1:
-      SerializeBitset<1> (std::bitset<1> (n));
-      break;
-    case 2:
-      SerializeBitset<2> (std::bitset<2> (n));
-      break;
-    case 3:
-      SerializeBitset<3> (std::bitset<3> (n));
-      break;
-    case 4:
-      SerializeBitset<4> (std::bitset<4> (n));
-      break;
-    case 5:
-      SerializeBitset<5> (std::bitset<5> (n));
-      break;
-    case 6:
-      SerializeBitset<6> (std::bitset<6> (n));
-      break;
-    case 7:
-      SerializeBitset<7> (std::bitset<7> (n));
-      break;
-    case 8:
-      SerializeBitset<8> (std::bitset<8> (n));
-      break;
-    case 9:
-      SerializeBitset<9> (std::bitset<9> (n));
-      break;
-    case 10:
-      SerializeBitset<10> (std::bitset<10> (n));
-      break;
-    case 11:
-      SerializeBitset<11> (std::bitset<11> (n));
-      break;
-    case 12:
-      SerializeBitset<12> (std::bitset<12> (n));
-      break;
-    case 13:
-      SerializeBitset<13> (std::bitset<13> (n));
-      break;
-    case 14:
-      SerializeBitset<14> (std::bitset<14> (n));
-      break;
-    case 15:
-      SerializeBitset<15> (std::bitset<15> (n));
-      break;
-    case 16:
-      SerializeBitset<16> (std::bitset<16> (n));
-      break;
-    case 17:
-      SerializeBitset<17> (std::bitset<17> (n));
-      break;
-    case 18:
-      SerializeBitset<18> (std::bitset<18> (n));
-      break;
-    case 19:
-      SerializeBitset<19> (std::bitset<19> (n));
-      break;
-    case 20:
-      SerializeBitset<20> (std::bitset<20> (n));
-      break;
-    default:
-      {
-        std::cout << "SerializeInteger " << requiredBits << " Out of range!!" << std::endl;
-        exit (1);
-      }
+      std::cout << "SerializeInteger " << (int) requiredBits << " Out of range!!" << std::endl;
+      exit (1);
     }
+  WriteBits (n, requiredBits);
 }
 
 void Asn1Header::SerializeNull () const
@@ -416,64 +338,68 @@ void Asn1Header::SerializeNull () const
 
 void Asn1Header::FinalizeSerialization () const
 {
-  if (m_numSerializationPendingBits > 0)
+  // Complete the last octet with zeros and write the remaining octets
+  uint8_t padding = (8 - m_numSerializationWordBits % 8) % 8;
+  m_serializationWord <<= padding;
+  m_numSerializationWordBits += padding;
+  while (m_numSerializationWordBits > 0)
+    {
+      m_numSerializationWordBits -= 8;
+      m_serializationResult.push_back (m_serializationWord >> m_numSerializationWordBits);
+    }
+
+  if (m_serializationResult.size () > g_maxSerializedSize)
     {
-      m_numSerializationPendingBits = 0;
-      SerializeBitset<8> (std::bitset<8> (m_serializationPendingBits));
+      g_maxSerializedSize = m_serializationResult.size ();
     }
   m_isDataSerialized = true;
 }
 
-template <int N>
-Buffer::Iterator Asn1Header::DeserializeBitset (std::bitset<N> *data, Buffer::Iterator bIterator)
+uint32_t Asn1Header::ReadBits (uint8_t numBits, Buffer::Iterator &bIterator)
 {
-
-  int bitsToRead = N;
-  uint8_t mask;
+  NS_ASSERT (numBits <= 32);
+  uint32_t bits = 0;
 
   // Read bits from pending bits
   if (m_numSerializationPendingBits > 0)
     {
-      while (bitsToRead > 0 && m_numSerializationPendingBits > 0)
-        {
-          data->set (bitsToRead - 1,(m_serializationPendingBits & 0x80) ? 1 : 0);
-          bitsToRead--;
-          m_numSerializationPendingBits--;
-          m_serializationPendingBits = m_serializationPendingBits << 1;
-        }
+      uint8_t n = std::min (numBits, m_numSerializationPendingBits);
+      bits = m_serializationPendingBits >> (8 - n);
+      m_serializationPendingBits <<= n;
+      m_numSerializationPendingBits -= n;
+      numBits -= n;
     }
 
-  // Read bits from buffer
-  while (bitsToRead > 0)
+  // Read whole octets from buffer
+  while (numBits >= 8)
+    {
+      bits = (bits << 8) | bIterator.ReadU8 ();
+      numBits -= 8;
+    }
+
+  // Read the first bits of the next octet, and save the remaining ones
+  if (numBits > 0)
     {
       uint8_t octet = bIterator.ReadU8 ();
-      // If 8 bits can be allocated to the bitset, set the bits
-      if (bitsToRead >= 8)
-        {
-          mask = 0x80;
-          for (int j = 0; j < 8; j++)
-            {
-              data->set (bitsToRead - 1,(octet & mask) ? 1 : 0);
-              bitsToRead--;
-              mask = mask >> 1;
-            }
-        }
-
-      // Otherwise, we'll have to save the remaining bits
-      else
-        {
-          mask = 0x80;
-          m_numSerializationPendingBits = 8 - bitsToRead;
-          m_serializationPendingBits = octet << bitsToRead;
-          while (bitsToRead > 0)
-            {
-              data->set (bitsToRead - 1,(octet & mask) ? 1 : 0);
-              bitsToRead--;
-              mask = mask >> 1;
-            }
-        }
+      bits = (bits << numBits) | (octet >> (8 - numBits));
+      m_serializationPendingBits = octet << numBits;
+      m_numSerializationPendingBits = 8 - numBits;
     }
 
+  return bits;
+}
+
+template <int N>
+Buffer::Iterator Asn1Header::DeserializeBitset (std::bitset<N> *data, Buffer::Iterator bIterator)
+{
+  // Read the bits 32 at a time, most significant first
+  data->reset ();
+  for (int high = N; high > 0; high -= 32)
+    {
+      int numBits = (high < 32) ? high : 32;
+      *data <<= numBits;
+      *data |= std::bitset<N> (ReadBits (numBits, bIterator));
+    }
   return bIterator;
 }
 
@@ -548,117 +474,18 @@ Buffer::Iterator Asn1Header::DeserializeInteger (int *n, int nmin, int nmax, Buf
       return bIterator;
     }
 
-  int requiredBits = std::ceil (std::log (range) / std::log (2.0));
-
-  std::bitset<1> bitsRead1;
-  std::bitset<2> bitsRead2;
-  std::bitset<3> bitsRead3;
-  std::bitset<4> bitsRead4;
-  std::bitset<5> bitsRead5;
-  std::bitset<6> bitsRead6;
-  std::bitset<7> bitsRead7;
-  std::bitset<8> bitsRead8;
-  std::bitset<9> bitsRead9;
-  std::bitset<10> bitsRead10;
-  std::bitset<11> bitsRead11;
-  std::bitset<12> bitsRead12;
-  std::bitset<13> bitsRead13;
-  std::bitset<14> bitsRead14;
-  std::bitset<15> bitsRead15;
-  std::bitset<16> bitsRead16;
-  std::bitset<17> bitsRead17;
-  std::bitset<18> bitsRead18;
-  std::bitset<19> bitsRead19;
-  std::bitset<20> bitsRead20;
-
-  switch (requiredBits)
+  uint8_t requiredBits = 1;
+  while ((1 << requiredBits) < range)
+    {
+      requiredBits++;
+    }
+
+  if (requiredBits > 20)
     {
-    case 1:
-      bIterator = DeserializeBitset<1> (&bitsRead1,bIterator);
-      *n = (int)bitsRead1.to_ulong ();
-      break;
-    case 2: 
-      bIterator = DeserializeBitset<2> (&bitsRead2,bIterator);
-      *n = (int)bitsRead2.to_ulong ();
-      break;
-    case 3: 
-      bIterator = DeserializeBitset<3> (&bitsRead3,bIterator);
-      *n = (int)bitsRead3.to_ulong ();
-      break;
-    case 4: 
-      bIterator = DeserializeBitset<4> (&bitsRead4,bIterator);
-      *n = (int)bitsRead4.to_ulong ();
-      break;
-    case 5:
-      bIterator = DeserializeBitset<5> (&bitsRead5,bIterator);
-      *n = (int)bitsRead5.to_ulong ();
-      break;
-    case 6:
-      bIterator = DeserializeBitset<6> (&bitsRead6,bIterator);
-      *n = (int)bitsRead6.to_ulong ();
-      break;
-    case 7:
-      bIterator = DeserializeBitset<7> (&bitsRead7,bIterator);
-      *n = (int)bitsRead7.to_ulong ();
-      break;
-    case 8:
-      bIterator = DeserializeBitset<8> (&bitsRead8,bIterator);
-      *n = (int)bitsRead8.to_ulong ();
-      break;
-    case 9:
-      bIterator = DeserializeBitset<9> (&bitsRead9,bIterator);
-      *n = (int)bitsRead9.to_ulong ();
-      break;
-    case 10:
-      bIterator = DeserializeBitset<10> (&bitsRead10,bIterator);
-      *n = (int)bitsRead10.to_ulong ();
-      break;
-    case 11:
-      bIterator = DeserializeBitset<11> (&bitsRead11,bIterator);
-      *n = (int)bitsRead11.to_ulong ();
-      break;
-    case 12:
-      bIterator = DeserializeBitset<12> (&bitsRead12,bIterator);
-      *n = (int)bitsRead12.to_ulong ();
-      break;
-    case 13:
-      bIterator = DeserializeBitset<13> (&bitsRead13,bIterator);
-      *n = (int)bitsRead13.to_ulong ();
-      break;
-    case 14:
-      bIterator = DeserializeBitset<14> (&bitsRead14,bIterator);
-      *n = (int)bitsRead14.to_ulong ();
-      break;
-    case 15:
-      bIterator = DeserializeBitset<15> (&bitsRead15,bIterator);
-      *n = (int)bitsRead15.to_ulong ();
-      break;
-    case 16:
-      bIterator = DeserializeBitset<16> (&bitsRead16,bIterator);
-      *n = (int)bitsRead16.to_ulong ();
-      break;
-    case 17:
-      bIterator = DeserializeBitset<17> (&bitsRead17,bIterator);
-      *n = (int)bitsRead17.to_ulong ();
-      break;
-    case 18:
-      bIterator = DeserializeBitset<18> (&bitsRead18,bIterator);
-      *n = (int)bitsRead18.to_ulong ();
-      break;
-    case 19:
-      bIterator = DeserializeBitset<19> (&bitsRead19,bIterator);
-      *n = (int)bitsRead19.to_ulong ();
-      break;
-    case 20:
-      bIterator = DeserializeBitset<20> (&bitsRead20,bIterator);
-      *n = (int)bitsRead20.to_ulong ();
-      break;
-    default:
-      {
-        std::cout << "SerializeInteger Out of range!!" << std::endl;
-        exit (1);
-      }
+      std::cout << "SerializeInteger Out of range!!" << std::endl;
+      exit (1);
     }
+  *n = ReadBits (requiredBits, bIterator);
 
   *n += nmin;
 
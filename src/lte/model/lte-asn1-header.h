@@ -25,6 +25,7 @@
 
 #include <bitset>
 #include <string>
+#include <vector>
 
 namespace ns3 {
 
@@ -32,6 +33,11 @@ namespace ns3 {
  * This class has the purpose to encode Information Elements according
  * to ASN.1 syntax, as defined in ITU-T  X-691.
  * IMPORTANT: The encoding is done following the UNALIGNED variant.
+ *
+ * The bits are packed into a 64 bit word, which is flushed 32 bits at a
+ * time to a byte vector.  The vector is reserved, when the serialization
+ * starts, with the size of the largest IE serialized so far, so that the
+ * serialization of a header does not reallocate it.
  */
 class Asn1Header : public Header
 {
@@ -55,7 +61,7 @@ public:
     
   /**
    * This function serializes class attributes to m_serializationResult
-   * local Buffer.  As ASN1 encoding produces a bitstream that does not have
+   * local byte vector.  As ASN1 encoding produces a bitstream that does not have
    * a fixed length, this function is needed to store the result, so
    * its length can be retrieved with Header::GetSerializedSize() function.
    * This method is pure virtual in this class (needs to be implemented
@@ -65,16 +71,35 @@ public:
   virtual void PreSerialize (void) const = 0;
 
 protected:
-  mutable uint8_t m_serializationPendingBits; //!< pending bits
+  mutable uint8_t m_serializationPendingBits; //!< bits of the last octet read, not yet deserialized
   mutable uint8_t m_numSerializationPendingBits; //!< number of pending bits
   mutable bool m_isDataSerialized; //!< true if data is serialized
-  mutable Buffer m_serializationResult; //!< serialization result
+  mutable std::vector<uint8_t> m_serializationResult; //!< serialization result
+  mutable uint64_t m_serializationWord; //!< bits serialized but not yet written to m_serializationResult
+  mutable uint8_t m_numSerializationWordBits; //!< number of bits in m_serializationWord
 
   /**
-   * Function to write in m_serializationResult, after resizing its size
+   * Starts a new serialization, discarding the result of the previous one.
+   */
+  void StartSerialization () const;
+  /**
+   * Function to write in m_serializationResult
    * \param octet bits to write
    */
   void WriteOctet (uint8_t octet) const;
+  /**
+   * Append bits to the serialization result
+   * \param bits the bits to write, in the least significant bits
+   * \param numBits the number of bits to write, at most 32
+   */
+  void WriteBits (uint32_t bits, uint8_t numBits) const;
+  /**
+   * Read bits from the pending bits and the buffer
+   * \param numBits the number of bits to read, at most 32
+   * \param bIterator buffer iterator, advanced past the octets read
+   * \returns the bits read, in the least significant bits
+   */
+  uint32_t ReadBits (uint8_t numBits, Buffer::Iterator &bIterator);
 
   // Serialization functions
 
@@ -331,107 +331,99 @@ static const double cEcrTable [9][38] = {
 };
 
 
+/**
+ * Map a SINR to the mutual information of a modulation.
+ *
+ * Since the values of the axis of the MI maps are uniformly spaced, the
+ * index of a SINR is ((sinrLin - axis[0]) / (axis[SIZE-1] - axis[0])) * (SIZE-1),
+ * where the scaling coefficient only depends on the map.
+ */
+struct MiMap
+{
+  const double *mi;       ///< the MI values
+  const double *axis;     ///< the SINR values, in linear units
+  uint16_t size;          ///< the number of values
+  double scalingCoeff;    ///< (size - 1) / (axis[size-1] - axis[0])
+};
+
+/// The MI maps of QPSK, 16-QAM and 64-QAM
+static const MiMap g_miMaps[3] = {
+  { MI_map_qpsk, MI_map_qpsk_axis, MI_MAP_QPSK_SIZE,
+    (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]) },
+  { MI_map_16qam, MI_map_16qam_axis, MI_MAP_16QAM_SIZE,
+    (MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1] - MI_map_16qam_axis[0]) },
+  { MI_map_64qam, MI_map_64qam_axis, MI_MAP_64QAM_SIZE,
+    (MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1] - MI_map_64qam_axis[0]) }
+};
+
+/**
+ * Get the mutual information of a SINR.
+ * \param map the MI map of the modulation
+ * \param sinrLin the SINR, in linear units
+ * \return the MI
+ */
+static inline double
+GetMi (const MiMap &map, double sinrLin)
+{
+  if (sinrLin > map.axis[map.size - 1])
+    {
+      return 1;
+    }
+  double sinrIndexDouble = (sinrLin - map.axis[0]) * map.scalingCoeff + 1;
+  uint32_t sinrIndex = std::max (0.0, std::floor (sinrIndexDouble));
+  NS_ASSERT_MSG (sinrIndex < map.size, "MI map out of data");
+  return map.mi[sinrIndex];
+}
+
+
 double 
 LteMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
-  
-  double MI;
+
+  // the modulation is the same for all the RBs of the TB
+  const MiMap &miMap = g_miMaps[mcs <= MI_QPSK_MAX_ID ? 0 : (mcs <= MI_16QAM_MAX_ID ? 1 : 2)];
+  Values::const_iterator values = sinr.ConstValuesBegin ();
   double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  
-  for (uint32_t i = 0; i < map.size (); i++)
+  for (std::vector<int>::const_iterator it = map.begin (); it != map.end (); ++it)
     {
-      double sinrLin = sinrCopy[map.at (i)];
-      if (mcs <= MI_QPSK_MAX_ID) // QPSK
-        {
-
-          if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
-            {
-              MI = 1;
-            }
-          else 
-            { 
-              // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-              // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-              static const double scalingCoeffQpsk = 
-                (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-              double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-              uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-              NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-              MI = MI_map_qpsk[sinrIndex];
-            }
-        }
-      else
-        {
-          if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID )	// 16-QAM
-            {
-              if (sinrLin > MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else 
-                {
-                  // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff16qam = 
-                    (MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1] - MI_map_16qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_16QAM_SIZE, "MI map out of data");
-                  MI = MI_map_16qam[sinrIndex];
-                }
-            }
-          else // 64-QAM
-            {
-              if (sinrLin > MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else
-                {
-                  // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff64qam = 
-                    (MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1] - MI_map_64qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_64QAM_SIZE, "MI map out of data");
-                  MI = MI_map_64qam[sinrIndex];
-                }
-            }
-        }
-      NS_LOG_LOGIC (" RB " << map.at (i) << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
+      double sinrLin = values[*it];
+      double MI = GetMi (miMap, sinrLin);
+      NS_LOG_LOGIC (" RB " << *it << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
       MIsum += MI;
     }
-  MI = MIsum / map.size ();
+  double MI = MIsum / map.size ();
   NS_LOG_LOGIC (" MI = " << MI);
   return MI;
 }
 
 
-double 
-LteMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint16_t cbSize)
+/**
+ * Get the index of the BLER curves of a CB size in cbMiSizeTable.
+ * \param cbSize the size of the CB
+ * \return the index of the largest curve CB size not larger than cbSize
+ */
+static int
+GetCbMiSizeIndex (uint16_t cbSize)
 {
-  NS_LOG_FUNCTION (mib << (uint32_t) ecrId << (uint32_t) cbSize);
-  double b = 0;
-  double c = 0;
-
-  NS_ASSERT_MSG (ecrId <= MI_64QAM_BLER_MAX_ID, "ECR out of range [0..37]: " << (uint16_t) ecrId);
   int cbIndex = 1;
   while ((cbIndex < 9)&&(cbMiSizeTable[cbIndex]<= cbSize))
     {
       cbIndex++;
     }
-  cbIndex--;
-  NS_LOG_LOGIC (" ECRid " << (uint16_t)ecrId << " ECR " << BlerCurvesEcrMap[ecrId] << " CB size " << cbSize << " CB size curve " << cbMiSizeTable[cbIndex]);
+  return cbIndex - 1;
+}
 
+/**
+ * Get the parameters of a BLER curve.
+ * \param ecrId Effective Code Rate ID
+ * \param cbIndex the index of the CB size in cbMiSizeTable
+ * \param b the mean of the curve
+ * \param c the standard deviation of the curve
+ */
+static void
+GetBlerCurve (uint8_t ecrId, int cbIndex, double &b, double &c)
+{
   b = bEcrTable[cbIndex][ecrId];
   if (b<0.0)
     {
@@ -454,6 +446,99 @@ LteMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint16_t cbSize)
           c = cEcrTable[i++][ecrId];
         }
     }
+}
+
+/**
+ * A BLER curve sampled at uniformly spaced MIs.
+ *
+ * The samples span b +/- BLER_TABLE_WIDTH c: further away, the BLER is
+ * 0 or 1 within double precision.  The spacing is thus proportional to
+ * the width c of the curve, which keeps the error of the linear
+ * interpolation the same for steep and flat curves.
+ */
+struct BlerTable
+{
+  double first;              ///< the MI of the first sample
+  double scale;              ///< the number of samples per unit of MI
+  std::vector<double> bler;  ///< the BLER samples
+};
+
+/// Half width of a BLER table, in standard deviations of the curve
+static const double BLER_TABLE_WIDTH = 8.5;
+/// Number of intervals between the samples of a BLER table
+static const uint32_t BLER_TABLE_INTERVALS = 512;
+
+/// The BLER tables, by CB size index and ECR, built when first used
+static BlerTable g_blerTables[9][MI_64QAM_BLER_MAX_ID + 1];
+
+/**
+ * Get the BLER table of a curve, building it when first used.
+ * \param ecrId Effective Code Rate ID
+ * \param cbIndex the index of the CB size in cbMiSizeTable
+ * \return the BLER table
+ */
+static const BlerTable &
+GetBlerTable (uint8_t ecrId, int cbIndex)
+{
+  BlerTable &table = g_blerTables[cbIndex][ecrId];
+  if (table.bler.empty ())
+    {
+      double b;
+      double c;
+      GetBlerCurve (ecrId, cbIndex, b, c);
+      table.first = b - BLER_TABLE_WIDTH * c;
+      table.scale = BLER_TABLE_INTERVALS / (2 * BLER_TABLE_WIDTH * c);
+      table.bler.reserve (BLER_TABLE_INTERVALS + 1);
+      for (uint32_t i = 0; i <= BLER_TABLE_INTERVALS; i++)
+        {
+          double mib = table.first + i / table.scale;
+          table.bler.push_back (0.5*( 1 - erf ((mib-b)/(sqrt (2)*c)) ));
+        }
+    }
+  return table;
+}
+
+
+double 
+LteMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint16_t cbSize)
+{
+  NS_LOG_FUNCTION (mib << (uint32_t) ecrId << (uint32_t) cbSize);
+  NS_ASSERT_MSG (ecrId <= MI_64QAM_BLER_MAX_ID, "ECR out of range [0..37]: " << (uint16_t) ecrId);
+  const BlerTable &table = GetBlerTable (ecrId, GetCbMiSizeIndex (cbSize));
+
+  double x = (mib - table.first) * table.scale;
+  double bler;
+  if (x <= 0)
+    {
+      bler = table.bler.front ();
+    }
+  else if (x >= BLER_TABLE_INTERVALS)
+    {
+      bler = table.bler.back ();
+    }
+  else
+    {
+      uint32_t i = static_cast<uint32_t> (x);
+      double frac = x - i;
+      bler = table.bler[i] + frac * (table.bler[i + 1] - table.bler[i]);
+    }
+  NS_LOG_LOGIC ("MIB: " << mib << " BLER:" << bler);
+  return bler;
+}
+
+
+double 
+LteMiErrorModel::EvaluateMiBler (double mib, uint8_t ecrId, uint16_t cbSize)
+{
+  NS_LOG_FUNCTION (mib << (uint32_t) ecrId << (uint32_t) cbSize);
+  double b = 0;
+  double c = 0;
+
+  NS_ASSERT_MSG (ecrId <= MI_64QAM_BLER_MAX_ID, "ECR out of range [0..37]: " << (uint16_t) ecrId);
+  int cbIndex = GetCbMiSizeIndex (cbSize);
+  NS_LOG_LOGIC (" ECRid " << (uint16_t)ecrId << " ECR " << BlerCurvesEcrMap[ecrId] << " CB size " << cbSize << " CB size curve " << cbMiSizeTable[cbIndex]);
+
+  GetBlerCurve (ecrId, cbIndex, b, c);
   // see IEEE802.16m EMD formula 55 of section 4.3.2.1
   double bler = 0.5*( 1 - erf((mib-b)/(sqrt(2)*c)) );
   NS_LOG_LOGIC ("MIB: " << mib << " BLER:" << bler << " b:" << b << " c:" << c);
@@ -468,31 +553,12 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
   NS_LOG_FUNCTION (sinr);
   double MI;
   double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  Values::iterator sinrIt = sinrCopy.ValuesBegin ();
+  Values::const_iterator sinrIt = sinr.ConstValuesBegin ();
   uint16_t rb = 0;
-  NS_ASSERT (sinrIt!=sinrCopy.ValuesEnd ());
-  while (sinrIt!=sinrCopy.ValuesEnd ())
+  NS_ASSERT (sinrIt!=sinr.ConstValuesEnd ());
+  while (sinrIt!=sinr.ConstValuesEnd ())
     {
-      double sinrLin = *sinrIt;
-      if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
-        {
-          MI = 1;
-        }
-      else 
-        { 
-          // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-          // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-          static const double scalingCoeffQpsk = 
-            (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-          double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-          uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-          NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-          MI = MI_map_qpsk[sinrIndex];
-        }
-      MIsum += MI;
+      MIsum += GetMi (g_miMaps[0], *sinrIt);
       sinrIt++;
       rb++;
     }
@@ -554,11 +620,19 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
 
 
 TbStats_t
-LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, HarqProcessInfoList_t miHistory)
+LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t &miHistory)
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) size << (uint32_t) mcs);
 
-  double tbMi = Mib(sinr, map, mcs);
+  return GetTbDecodificationStats (Mib (sinr, map, mcs), size, mcs, miHistory);
+}
+
+
+TbStats_t
+LteMiErrorModel::GetTbDecodificationStats (double tbMi, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t &miHistory)
+{
+  NS_LOG_FUNCTION (tbMi << (uint32_t) size << (uint32_t) mcs);
+
   double MI = 0.0;
   double Reff = 0.0;
   NS_ASSERT (mcs < 29);
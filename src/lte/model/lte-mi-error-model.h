@@ -93,12 +93,24 @@ public:
   static double Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs);
   /** 
    * \brief map the mmib (mean mutual information per bit) for different MCS
+   *
+   * The BLER curves are sampled once, the first time they are used, and
+   * interpolated linearly: the result is within 1e-4 of EvaluateMiBler.
+   *
    * \param mib mean mutual information per bit of a code-block
    * \param ecrId Effective Code Rate ID
    * \param cbSize the size of the CB
    * \return the code block error rate
    */
   static double MappingMiBler (double mib, uint8_t ecrId, uint16_t cbSize);
+  /** 
+   * \brief evaluate the BLER curve of an MCS at a mmib (mean mutual information per bit)
+   * \param mib mean mutual information per bit of a code-block
+   * \param ecrId Effective Code Rate ID
+   * \param cbSize the size of the CB
+   * \return the code block error rate
+   */
+  static double EvaluateMiBler (double mib, uint8_t ecrId, uint16_t cbSize);
 
   /**
    * \brief run the error-model algorithm for the specified TB
@@ -109,7 +121,21 @@ public:
    * \param miHistory  MI of past transmissions (in case of retx)
    * \return the TB error rate and MI
    */
-  static TbStats_t GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, HarqProcessInfoList_t miHistory);
+  static TbStats_t GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t &miHistory);
+
+  /**
+   * \brief run the error-model algorithm for a TB whose MI is known
+   *
+   * The MI only depends on the modulation of the MCS, hence it can be
+   * evaluated once with Mib for all the MCSs of a same modulation.
+   *
+   * \param tbMi the mmib of the TB, as returned by Mib
+   * \param size the size in bytes of the TB
+   * \param mcs the MCS of the TB
+   * \param miHistory  MI of past transmissions (in case of retx)
+   * \return the TB error rate and MI
+   */
+  static TbStats_t GetTbDecodificationStats (double tbMi, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t &miHistory);
   
   /** 
   * \brief run the error-model algorithm for the specified PCFICH+PDCCH channels
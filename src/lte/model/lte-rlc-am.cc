@@ -26,6 +26,7 @@
 #include "ns3/lte-rlc-am.h"
 #include "ns3/lte-rlc-sdu-status-tag.h"
 #include "ns3/lte-rlc-tag.h"
+#include <algorithm>
 
 
 namespace ns3 {
@@ -45,6 +46,7 @@ LteRlcAm::LteRlcAm ()
   m_retxBufferSize = 0;
   m_txedBuffer.resize (1024);
   m_txedBufferSize = 0;
+  m_rxonBuffer.resize (1024);
 
   m_statusPduRequested = false;
   m_statusPduBufferSize = 0;
@@ -139,7 +141,8 @@ LteRlcAm::DoDispose ()
   m_txedBufferSize = 0;
   m_retxBuffer.clear ();
   m_retxBufferSize = 0;
-  m_rxonBuffer.clear ();
+  // keep an entry per SN, the reception procedures index the buffer by SN
+  std::fill (m_rxonBuffer.begin (), m_rxonBuffer.end (), PduBuffer ());
   m_sdusBuffer.clear ();
   m_keepS0 = 0;
   m_controlPduBuffer = 0;
@@ -220,7 +223,6 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
       NS_LOG_LOGIC ("Check for SNs to NACK from " << m_vrR.GetValue() << " to " << m_vrMs.GetValue());
       SequenceNumber10 sn;
       sn.SetModulusBase (m_vrR);
-      std::map<uint16_t, PduBuffer>::iterator pduIt;
       for (sn = m_vrR; sn < m_vrMs; sn++) 
         {
           NS_LOG_LOGIC ("SN = " << sn);          
@@ -229,8 +231,7 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
               NS_LOG_LOGIC ("Can't fit more NACKs in STATUS PDU");
               break;
             }          
-          pduIt = m_rxonBuffer.find (sn.GetValue ());
-          if (pduIt == m_rxonBuffer.end () || (!(pduIt->second.m_pduComplete)))
+          if (!m_rxonBuffer[sn.GetValue ()].m_pduComplete)
             {
               NS_LOG_LOGIC ("adding NACK_SN " << sn.GetValue ());
               rlcAmHeader.PushNack (sn.GetValue ());              
@@ -240,13 +241,11 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
       // 3GPP TS 36.322 section 6.2.2.1.4 ACK SN
       // find the  SN of the next not received RLC Data PDU 
       // which is not reported as missing in the STATUS PDU. 
-      pduIt = m_rxonBuffer.find (sn.GetValue ());
-      while ((sn < m_vrMs) && (pduIt != m_rxonBuffer.end ()) && (pduIt->second.m_pduComplete))            
+      while ((sn < m_vrMs) && m_rxonBuffer[sn.GetValue ()].m_pduComplete)
         {
           NS_LOG_LOGIC ("SN = " << sn << " < " << m_vrMs << " = " << (sn < m_vrMs));
           sn++;
           NS_LOG_LOGIC ("SN = " << sn);
-          pduIt = m_rxonBuffer.find (sn.GetValue ());
         }
       
       NS_ASSERT_MSG (sn <= m_vrMs, "first SN not reported as missing = " << sn << ", VR(MS) = " << m_vrMs);      
@@ -448,7 +447,7 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
   Ptr<Packet> firstSegment = (*(m_txonBuffer.begin ()))->Copy ();
   m_txonBufferSize -= (*(m_txonBuffer.begin()))->GetSize ();
   NS_LOG_LOGIC ("txBufferSize      = " << m_txonBufferSize );
-  m_txonBuffer.erase (m_txonBuffer.begin ());
+  m_txonBuffer.pop_front ();
 
   while ( firstSegment && (firstSegment->GetSize () > 0) && (nextSegmentSize > 0) )
     {
@@ -496,7 +495,7 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
             {
               firstSegment->AddPacketTag (oldTag);
 
-              m_txonBuffer.insert (m_txonBuffer.begin (), firstSegment);
+              m_txonBuffer.push_front (firstSegment);
               m_txonBufferSize += (*(m_txonBuffer.begin()))->GetSize ();
 
               NS_LOG_LOGIC ("    Txon buffer: Give back the remaining segment");
@@ -602,7 +601,7 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
           // (more segments)
           firstSegment = (*(m_txonBuffer.begin ()))->Copy ();
           m_txonBufferSize -= (*(m_txonBuffer.begin()))->GetSize ();
-          m_txonBuffer.erase (m_txonBuffer.begin ());
+          m_txonBuffer.pop_front ();
           NS_LOG_LOGIC ("        txBufferSize = " << m_txonBufferSize );
         }
 
@@ -879,18 +878,19 @@ LteRlcAm::DoReceivePdu (Ptr<Packet> p, uint16_t rnti, uint8_t lcid)
           //         - discard the duplicate byte segments.
           // note: re-segmentation of AMD PDU is currently not supported, 
           // so we just check that the segment was not received before
-          std::map <uint16_t, PduBuffer>::iterator it = m_rxonBuffer.find (seqNumber.GetValue ());
-          if (it != m_rxonBuffer.end () )
+          PduBuffer &pdu = m_rxonBuffer[seqNumber.GetValue ()];
+          if (pdu.m_pduComplete)
             {
-              NS_ASSERT (it->second.m_byteSegments.size () > 0);
-              NS_ASSERT_MSG (it->second.m_byteSegments.size () == 1, "re-segmentation not supported");
+              NS_ASSERT (pdu.m_byteSegments.size () > 0);
+              NS_ASSERT_MSG (pdu.m_byteSegments.size () == 1, "re-segmentation not supported");
               NS_LOG_LOGIC ("PDU segment already received, discarded");
             }
           else
             {
               NS_LOG_LOGIC ("Place PDU in the reception buffer ( SN = " << seqNumber << " )");
-              m_rxonBuffer[ seqNumber.GetValue () ].m_byteSegments.push_back (p);
-              m_rxonBuffer[ seqNumber.GetValue () ].m_pduComplete = true;
+              pdu.m_seqNumber = seqNumber;
+              pdu.m_byteSegments.push_back (p);
+              pdu.m_pduComplete = true;
             }
 
 
@@ -913,16 +913,12 @@ LteRlcAm::DoReceivePdu (Ptr<Packet> p, uint16_t rnti, uint8_t lcid)
       //     - update VR(MS) to the SN of the first AMD PDU with SN > current VR(MS) for
       //       which not all byte segments have been received;
 
-      std::map <uint16_t, PduBuffer>::iterator it = m_rxonBuffer.find (m_vrMs.GetValue ());
-      if ( it != m_rxonBuffer.end () &&
-           it->second.m_pduComplete )
+      if (m_rxonBuffer[m_vrMs.GetValue ()].m_pduComplete)
         {
           int firstVrMs = m_vrMs.GetValue ();
-          while ( it != m_rxonBuffer.end () &&
-                  it->second.m_pduComplete )
+          while (m_rxonBuffer[m_vrMs.GetValue ()].m_pduComplete)
             {
               m_vrMs++;
-              it = m_rxonBuffer.find (m_vrMs.GetValue ());
               NS_LOG_LOGIC ("Incr VR(MS) = " << m_vrMs);
 
               NS_ASSERT_MSG (firstVrMs != m_vrMs.GetValue (), "Infinite loop in RxonBuffer");
@@ -938,27 +934,25 @@ LteRlcAm::DoReceivePdu (Ptr<Packet> p, uint16_t rnti, uint8_t lcid)
 
       if ( seqNumber == m_vrR )
         {
-          std::map <uint16_t, PduBuffer>::iterator it = m_rxonBuffer.find (seqNumber.GetValue ());
-          if ( it != m_rxonBuffer.end () &&
-               it->second.m_pduComplete )
+          if (m_rxonBuffer[seqNumber.GetValue ()].m_pduComplete)
             {
-              it = m_rxonBuffer.find (m_vrR.GetValue ());
               int firstVrR = m_vrR.GetValue ();
-              while ( it != m_rxonBuffer.end () &&
-                      it->second.m_pduComplete )
+              while (m_rxonBuffer[m_vrR.GetValue ()].m_pduComplete)
                 {
                   NS_LOG_LOGIC ("Reassemble and Deliver ( SN = " << m_vrR << " )");
-                  NS_ASSERT_MSG (it->second.m_byteSegments.size () == 1,
+                  PduBuffer &pdu = m_rxonBuffer[m_vrR.GetValue ()];
+                  NS_ASSERT_MSG (pdu.m_byteSegments.size () == 1,
                                 "Too many segments. PDU Reassembly process didn't work");
-                  ReassembleAndDeliver (it->second.m_byteSegments.front ());
-                  m_rxonBuffer.erase (m_vrR.GetValue ());
+                  Ptr<Packet> packet = pdu.m_byteSegments.front ();
+                  pdu.m_byteSegments.clear ();
+                  pdu.m_pduComplete = false;
+                  ReassembleAndDeliver (packet);
 
                   m_vrR++;
                   m_vrR.SetModulusBase (m_vrR);
                   m_vrX.SetModulusBase (m_vrR);
                   m_vrMs.SetModulusBase (m_vrR);
                   m_vrH.SetModulusBase (m_vrR);
-                  it = m_rxonBuffer.find (m_vrR.GetValue ());
 
                   NS_ASSERT_MSG (firstVrR != m_vrR.GetValue (), "Infinite loop in RxonBuffer");
                 }
@@ -1191,7 +1185,7 @@ LteRlcAm::ReassembleAndDeliver (Ptr<Packet> packet)
     }
   while ( extensionBit == 1 );
 
-  std::list < Ptr<Packet> >::iterator it;
+  std::deque < Ptr<Packet> >::iterator it;
 
   // Current reassembling state
   if (m_reassemblingState == WAITING_S0_FULL)       NS_LOG_LOGIC ("Reassembling State = 'WAITING_S0_FULL'");
@@ -1644,12 +1638,9 @@ LteRlcAm::ExpireReorderingTimer (void)
 
   m_vrMs = m_vrX;
   int firstVrMs = m_vrMs.GetValue ();
-  std::map <uint16_t, PduBuffer>::iterator it = m_rxonBuffer.find (m_vrMs.GetValue ());
-  while ( it != m_rxonBuffer.end () &&
-          it->second.m_pduComplete )
+  while (m_rxonBuffer[m_vrMs.GetValue ()].m_pduComplete)
     {
       m_vrMs++;
-      it = m_rxonBuffer.find (m_vrMs.GetValue ());
 
       NS_ASSERT_MSG (firstVrMs != m_vrMs.GetValue (), "Infinite loop in ExpireReorderingTimer");
     }
@@ -26,7 +26,8 @@
 #include <ns3/lte-rlc.h>
 
 #include <vector>
-#include <map>
+#include <deque>
+#include <list>
 
 namespace ns3 {
 
@@ -112,7 +113,7 @@ private:
   void DoReportBufferStatus ();
 
 private:
-    std::vector < Ptr<Packet> > m_txonBuffer; ///< Transmission buffer
+    std::deque < Ptr<Packet> > m_txonBuffer; ///< Transmission buffer
 
     /// RetxPdu structure
     struct RetxPdu
@@ -140,16 +141,27 @@ private:
       std::list < Ptr<Packet> >  m_byteSegments; ///< byte segments
 
       bool      m_pduComplete; ///< PDU complete?
+
+      /// Constructor of an empty entry of the reception buffer
+      PduBuffer ()
+        : m_pduComplete (false)
+      {
+      }
     };
 
-    std::map <uint16_t, PduBuffer > m_rxonBuffer; ///< Reception buffer
+    /**
+     * Reception buffer, indexed by SN, where only the complete PDUs are
+     * present. It always holds an entry per SN, i.e., 1024 entries of
+     * about 40 bytes on 64-bit hosts, whatever the traffic of the bearer.
+     */
+    std::vector <PduBuffer> m_rxonBuffer;
 
     Ptr<Packet> m_controlPduBuffer;               ///< Control PDU buffer (just one PDU)
 
     // SDU reassembly
 //   std::vector < Ptr<Packet> > m_reasBuffer;     // Reassembling buffer
 // 
-    std::list < Ptr<Packet> > m_sdusBuffer;       ///< List of SDUs in a packet (PDU)
+    std::deque < Ptr<Packet> > m_sdusBuffer;      ///< List of SDUs in a packet (PDU)
 
   /**
    * State variables. See section 7.1 in TS 36.322
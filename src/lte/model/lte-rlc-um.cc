@@ -44,6 +44,7 @@ LteRlcUm::LteRlcUm ()
 {
   NS_LOG_FUNCTION (this);
   m_reassemblingState = WAITING_S0_FULL;
+  m_rxBuffer.resize (1024);
 }
 
 LteRlcUm::~LteRlcUm ()
@@ -161,7 +162,7 @@ LteRlcUm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
   Ptr<Packet> firstSegment = (*(m_txBuffer.begin ()))->Copy ();
   m_txBufferSize -= (*(m_txBuffer.begin()))->GetSize ();
   NS_LOG_LOGIC ("txBufferSize      = " << m_txBufferSize );
-  m_txBuffer.erase (m_txBuffer.begin ());
+  m_txBuffer.pop_front ();
 
   while ( firstSegment && (firstSegment->GetSize () > 0) && (nextSegmentSize > 0) )
     {
@@ -209,7 +210,7 @@ LteRlcUm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
             {
               firstSegment->AddPacketTag (oldTag);
 
-              m_txBuffer.insert (m_txBuffer.begin (), firstSegment);
+              m_txBuffer.push_front (firstSegment);
               m_txBufferSize += (*(m_txBuffer.begin()))->GetSize ();
 
               NS_LOG_LOGIC ("    TX buffer: Give back the remaining segment");
@@ -314,7 +315,7 @@ LteRlcUm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
           // (more segments)
           firstSegment = (*(m_txBuffer.begin ()))->Copy ();
           m_txBufferSize -= (*(m_txBuffer.begin()))->GetSize ();
-          m_txBuffer.erase (m_txBuffer.begin ());
+          m_txBuffer.pop_front ();
           NS_LOG_LOGIC ("        txBufferSize = " << m_txBufferSize );
         }
 
@@ -455,7 +456,7 @@ LteRlcUm::DoReceivePdu (Ptr<Packet> p, uint16_t rnti, uint8_t lcid)
   m_vrUh.SetModulusBase (m_vrUh - m_windowSize);
   seqNumber.SetModulusBase (m_vrUh - m_windowSize);
 
-  if ( ( (m_vrUr < seqNumber) && (seqNumber < m_vrUh) && (m_rxBuffer.count (seqNumber.GetValue ()) > 0) ) ||
+  if ( ( (m_vrUr < seqNumber) && (seqNumber < m_vrUh) && (m_rxBuffer[seqNumber.GetValue ()] != 0) ) ||
        ( ((m_vrUh - m_windowSize) <= seqNumber) && (seqNumber < m_vrUr) )
      )
     {
@@ -504,17 +505,13 @@ LteRlcUm::DoReceivePdu (Ptr<Packet> p, uint16_t rnti, uint8_t lcid)
   //      so and deliver the reassembled RLC SDUs to upper layer in ascending order of the RLC SN if not delivered
   //      before;
 
-  if ( m_rxBuffer.count (m_vrUr.GetValue ()) > 0 )
+  if (m_rxBuffer[m_vrUr.GetValue ()] != 0)
     {
       NS_LOG_LOGIC ("Reception buffer contains SN = " << m_vrUr);
 
-      std::map <uint16_t, Ptr<Packet> >::iterator it;
-      uint16_t newVrUr;
       SequenceNumber10 oldVrUr = m_vrUr;
-
-      it = m_rxBuffer.find (m_vrUr.GetValue ());
-      newVrUr = (it->first) + 1;
-      while ( m_rxBuffer.count (newVrUr) > 0 )
+      SequenceNumber10 newVrUr = m_vrUr + 1;
+      while (m_rxBuffer[newVrUr.GetValue ()] != 0)
         {
           newVrUr++;
         }
@@ -645,7 +642,7 @@ LteRlcUm::ReassembleAndDeliver (Ptr<Packet> packet)
     }
   while ( extensionBit == 1 );
 
-  std::list < Ptr<Packet> >::iterator it;
+  std::deque < Ptr<Packet> >::iterator it;
 
   // Current reassembling state
   if (m_reassemblingState == WAITING_S0_FULL)       NS_LOG_LOGIC ("Reassembling State = 'WAITING_S0_FULL'");
@@ -1063,24 +1060,21 @@ LteRlcUm::ReassembleOutsideWindow (void)
 {
   NS_LOG_LOGIC ("Reassemble Outside Window");
 
-  std::map <uint16_t, Ptr<Packet> >::iterator it;
-  it = m_rxBuffer.begin ();
-
-  while ( (it != m_rxBuffer.end ()) && ! IsInsideReorderingWindow (SequenceNumber10 (it->first)) )
+  // the received PDUs have SN >= VR(UR), so those outside of the window
+  // are between VR(UR) and VR(UH) - UM_Window_Size
+  SequenceNumber10 sn = m_vrUr;
+  while (! IsInsideReorderingWindow (sn))
     {
-      NS_LOG_LOGIC ("SN = " << it->first);
-
-      // Reassemble RLC SDUs and deliver the PDCP PDU to upper layer
-      ReassembleAndDeliver (it->second);
-
-      std::map <uint16_t, Ptr<Packet> >::iterator it_tmp = it;
-      ++it;
-      m_rxBuffer.erase (it_tmp);
-    }
+      Ptr<Packet> packet = m_rxBuffer[sn.GetValue ()];
+      if (packet != 0)
+        {
+          NS_LOG_LOGIC ("SN = " << sn);
 
-  if (it != m_rxBuffer.end ())
-    {
-      NS_LOG_LOGIC ("(SN = " << it->first << ") is inside the reordering window");
+          // Reassemble RLC SDUs and deliver the PDCP PDU to upper layer
+          m_rxBuffer[sn.GetValue ()] = 0;
+          ReassembleAndDeliver (packet);
+        }
+      sn++;
     }
 }
 
@@ -1089,25 +1083,20 @@ LteRlcUm::ReassembleSnInterval (SequenceNumber10 lowSeqNumber, SequenceNumber10
 {
   NS_LOG_LOGIC ("Reassemble SN between " << lowSeqNumber << " and " << highSeqNumber);
 
-  std::map <uint16_t, Ptr<Packet> >::iterator it;
-
   SequenceNumber10 reassembleSn = lowSeqNumber;
   NS_LOG_LOGIC ("reassembleSN = " << reassembleSn);
   NS_LOG_LOGIC ("highSeqNumber = " << highSeqNumber);
   while (reassembleSn < highSeqNumber)
     {
       NS_LOG_LOGIC ("reassembleSn < highSeqNumber");
-      it = m_rxBuffer.find (reassembleSn.GetValue ());
-      NS_LOG_LOGIC ("it->first  = " << it->first);
-      NS_LOG_LOGIC ("it->second = " << it->second);
-      if (it != m_rxBuffer.end () )
+      Ptr<Packet> packet = m_rxBuffer[reassembleSn.GetValue ()];
+      if (packet != 0)
         {
-          NS_LOG_LOGIC ("SN = " << it->first);
+          NS_LOG_LOGIC ("SN = " << reassembleSn);
 
           // Reassemble RLC SDUs and deliver the PDCP PDU to upper layer
-          ReassembleAndDeliver (it->second);
-
-          m_rxBuffer.erase (it);
+          m_rxBuffer[reassembleSn.GetValue ()] = 0;
+          ReassembleAndDeliver (packet);
         }
         
       reassembleSn++;
@@ -1160,10 +1149,9 @@ LteRlcUm::ExpireReorderingTimer (void)
   //    - start t-Reordering;
   //    - set VR(UX) to VR(UH).
 
-  std::map <uint16_t, Ptr<Packet> >::iterator it;
   SequenceNumber10 newVrUr = m_vrUx;
 
-  while ( (it = m_rxBuffer.find (newVrUr.GetValue ())) != m_rxBuffer.end () )
+  while (m_rxBuffer[newVrUr.GetValue ()] != 0)
     {
       newVrUr++;
     }
@@ -25,7 +25,8 @@
 #include "ns3/lte-rlc.h"
 
 #include <ns3/event-id.h>
-#include <map>
+#include <vector>
+#include <deque>
 
 namespace ns3 {
 
@@ -102,11 +103,16 @@ private:
 private:
   uint32_t m_maxTxBufferSize; ///< maximum transmit buffer status
   uint32_t m_txBufferSize; ///< transmit buffer size
-  std::vector < Ptr<Packet> > m_txBuffer;       ///< Transmission buffer
-  std::map <uint16_t, Ptr<Packet> > m_rxBuffer; ///< Reception buffer
+  std::deque < Ptr<Packet> > m_txBuffer;        ///< Transmission buffer
+  /**
+   * Reception buffer, indexed by SN, where null marks a missing PDU. It
+   * always holds an entry per SN, i.e., 1024 pointers, whatever the
+   * traffic of the bearer.
+   */
+  std::vector < Ptr<Packet> > m_rxBuffer;
   std::vector < Ptr<Packet> > m_reasBuffer;     ///< Reassembling buffer
 
-  std::list < Ptr<Packet> > m_sdusBuffer;       ///< List of SDUs in a packet
+  std::deque < Ptr<Packet> > m_sdusBuffer;      ///< List of SDUs in a packet
 
   /**
    * State variables. See section 7.1 in TS 36.322
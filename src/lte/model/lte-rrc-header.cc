@@ -4557,7 +4557,7 @@ RrcConnectionRequestHeader::Print (std::ostream &os) const
 void
 RrcConnectionRequestHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
+  StartSerialization ();
 
   SerializeUlCcchMessage (1);
 
@@ -4686,7 +4686,7 @@ RrcConnectionSetupHeader::Print (std::ostream &os) const
 void
 RrcConnectionSetupHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
+  StartSerialization ();
 
   SerializeDlCcchMessage (3);
 
@@ -4857,7 +4857,7 @@ RrcConnectionSetupCompleteHeader::~RrcConnectionSetupCompleteHeader ()
 void
 RrcConnectionSetupCompleteHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
+  StartSerialization ();
 
   // Serialize DCCH message
   SerializeUlDcchMessage (4);
@@ -4963,7 +4963,7 @@ RrcConnectionReconfigurationCompleteHeader::~RrcConnectionReconfigurationComplet
 void
 RrcConnectionReconfigurationCompleteHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
+  StartSerialization ();
 
   // Serialize DCCH message
   SerializeUlDcchMessage (2);
@@ -5054,7 +5054,7 @@ RrcConnectionReconfigurationHeader::~RrcConnectionReconfigurationHeader ()
 void
 RrcConnectionReconfigurationHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
+  StartSerialization ();
 
   SerializeDlDcchMessage (4);
 
@@ -5685,7 +5685,7 @@ HandoverPreparationInfoHeader::HandoverPreparationInfoHeader ()
 void
 HandoverPreparationInfoHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
+  StartSerialization ();
 
   // Serialize HandoverPreparationInformation sequence:
   // no default or optional fields. Extension marker not present.
@@ -5921,7 +5921,7 @@ RrcConnectionReestablishmentRequestHeader::~RrcConnectionReestablishmentRequestH
 void
 RrcConnectionReestablishmentRequestHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
+  StartSerialization ();
 
   SerializeUlCcchMessage (0);
 
@@ -6087,7 +6087,7 @@ RrcConnectionReestablishmentHeader::~RrcConnectionReestablishmentHeader ()
 void
 RrcConnectionReestablishmentHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
+  StartSerialization ();
 
   SerializeDlCcchMessage (0);
 
@@ -6215,7 +6215,7 @@ RrcConnectionReestablishmentCompleteHeader::RrcConnectionReestablishmentComplete
 void
 RrcConnectionReestablishmentCompleteHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
+  StartSerialization ();
 
   // Serialize DCCH message
   SerializeUlDcchMessage (3);
@@ -6317,7 +6317,7 @@ RrcConnectionReestablishmentRejectHeader::~RrcConnectionReestablishmentRejectHea
 void
 RrcConnectionReestablishmentRejectHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
+  StartSerialization ();
 
   // Serialize CCCH message
   SerializeDlCcchMessage (1);
@@ -6402,7 +6402,7 @@ RrcConnectionReleaseHeader::~RrcConnectionReleaseHeader ()
 void
 RrcConnectionReleaseHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
+  StartSerialization ();
 
   // Serialize DCCH message
   SerializeDlDcchMessage (5);
@@ -6527,7 +6527,7 @@ RrcConnectionRejectHeader::~RrcConnectionRejectHeader ()
 void
 RrcConnectionRejectHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
+  StartSerialization ();
 
   // Serialize CCCH message
   SerializeDlCcchMessage (2);
@@ -6635,7 +6635,7 @@ MeasurementReportHeader::~MeasurementReportHeader ()
 void
 MeasurementReportHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
+  StartSerialization ();
 
   // Serialize DCCH message
   SerializeUlDcchMessage (1);
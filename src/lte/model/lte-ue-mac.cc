@@ -177,6 +177,7 @@ public:
   virtual void ReceivePhyPdu (Ptr<Packet> p);
   virtual void SubframeIndication (uint32_t frameNo, uint32_t subframeNo);
   virtual void ReceiveLteControlMessage (Ptr<LteControlMessage> msg);
+  virtual bool IsIdle ();
 
 private:
   LteUeMac* m_mac; ///< the UE MAC
@@ -206,6 +207,12 @@ UeMemberLteUePhySapUser::ReceiveLteControlMessage (Ptr<LteControlMessage> msg)
   m_mac->DoReceiveLteControlMessage (msg);
 }
 
+bool
+UeMemberLteUePhySapUser::IsIdle ()
+{
+  return m_mac->DoIsIdle ();
+}
+
 
 
 
@@ -327,6 +334,9 @@ LteUeMac::DoReportBufferStatus (LteMacSapProvider::ReportBufferStatusParameters
   std::map <uint8_t, LteMacSapProvider::ReportBufferStatusParameters>::iterator it;
   
   
+  // make sure that the subframe indications will deliver the BSR
+  m_uePhySapProvider->WakeUp ();
+
   it = m_ulBsrReceived.find (params.lcid);
   if (it != m_ulBsrReceived.end ())
     {
@@ -414,6 +424,7 @@ LteUeMac::SendRaPreamble (bool contention)
   // bypass the m_ulConfigured flag. This is reasonable, since In fact
   // the RACH preamble is sent on 6RB bandwidth so the uplink
   // bandwidth does not need to be configured. 
+  m_uePhySapProvider->WakeUp (); // m_subframeNo must be up to date
   NS_ASSERT (m_subframeNo > 0); // sanity check for subframe starting at 1
   m_raRnti = m_subframeNo - 1;
   m_uePhySapProvider->SendRachPreamble (m_raPreambleId, m_raRnti);
@@ -827,10 +838,29 @@ LteUeMac::DoSubframeIndication (uint32_t frameNo, uint32_t subframeNo)
       m_bsrLast = Simulator::Now ();
       m_freshUlBsr = false;
     }
+  // the PHY skips the indications only while no HARQ process is running
+  // (see DoIsIdle), so the process ids need not follow the skipped subframes
   m_harqProcessId = (m_harqProcessId + 1) % HARQ_PERIOD;
 
 }
 
+bool
+LteUeMac::DoIsIdle (void) const
+{
+  if (m_freshUlBsr)
+    {
+      return false;
+    }
+  for (uint16_t i = 0; i < m_miUlHarqProcessesPacketTimer.size (); i++)
+    {
+      if (m_miUlHarqProcessesPacketTimer.at (i) > 0)
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
 int64_t
 LteUeMac::AssignStreams (int64_t stream)
 {
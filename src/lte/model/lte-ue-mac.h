@@ -102,6 +102,14 @@ public:
   */
   void DoSubframeIndication (uint32_t frameNo, uint32_t subframeNo);
 
+  /**
+  * \brief Forwarded from LteUePhySapUser: check whether the MAC needs the
+  * next subframe indications
+  *
+  * \return true if no BSR is pending and no UL HARQ process is running
+  */
+  bool DoIsIdle (void) const;
+
  /**
   * Assign a fixed random variable stream number to the random variables
   * used by this model.  Return the number of streams (possibly zero) that
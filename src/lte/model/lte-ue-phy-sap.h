@@ -61,6 +61,19 @@ public:
    */
   virtual void SendRachPreamble (uint32_t prachId, uint32_t raRnti) = 0;
 
+  /**
+   * \brief Resume the subframe indications of an idle UE
+   *
+   * If the PHY has stopped the subframe indications because both the PHY
+   * and the MAC were idle (see LteUePhy::EnableIdleSubframeSkipping), the
+   * MAC is first brought up to date with a SubframeIndication for the
+   * current subframe, and the indications are then resumed from the next
+   * subframe. The MAC calls this method before it starts any activity that
+   * depends on the subframe timing. It has no effect if the indications
+   * are running.
+   */
+  virtual void WakeUp () = 0;
+
 };
 
 
@@ -96,6 +109,15 @@ public:
   */
   virtual void ReceiveLteControlMessage (Ptr<LteControlMessage> msg) = 0;
 
+  /**
+   * \brief Check whether the MAC needs the next subframe indications
+   *
+   * \return true if the MAC has no pending buffer status report and no
+   * running HARQ process, i.e., if the subframe indications can be skipped
+   * until the next WakeUp
+   */
+  virtual bool IsIdle () = 0;
+
 };
 
 
@@ -85,6 +85,7 @@ public:
   virtual void SendMacPdu (Ptr<Packet> p);
   virtual void SendLteControlMessage (Ptr<LteControlMessage> msg);
   virtual void SendRachPreamble (uint32_t prachId, uint32_t raRnti);
+  virtual void WakeUp ();
 
 private:
   LteUePhy* m_phy; ///< the Phy
@@ -113,6 +114,12 @@ UeMemberLteUePhySapProvider::SendRachPreamble (uint32_t prachId, uint32_t raRnti
   m_phy->DoSendRachPreamble (prachId, raRnti);
 }
 
+void
+UeMemberLteUePhySapProvider::WakeUp ()
+{
+  m_phy->DoWakeUp ();
+}
+
 
 ////////////////////////////////////////
 // LteUePhy methods
@@ -165,6 +172,9 @@ LteUePhy::LteUePhy (Ptr<LteSpectrumPhy> dlPhy, Ptr<LteSpectrumPhy> ulPhy)
   m_uePhySapProvider = new UeMemberLteUePhySapProvider (this);
   m_ueCphySapProvider = new MemberLteUeCphySapProvider<LteUePhy> (this);
   m_macChTtiDelay = UL_PUSCH_TTIS_DELAY;
+  m_enableIdleSubframeSkipping = false;
+  m_subframesSkipped = false;
+  m_nextSubframeIndex = 0;
 
   NS_ASSERT_MSG (Simulator::Now ().GetNanoSeconds () == 0,
                  "Cannot create UE devices after simulation started");
@@ -280,6 +290,15 @@ LteUePhy::GetTypeId (void)
                    DoubleValue (-1000.0),
                    MakeDoubleAccessor (&LteUePhy::m_pssReceptionThreshold),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("CellSearchRsrpThreshold",
+                   "Cells whose PSS is received with a lower RSRP [dBm] are "
+                   "ignored during the cell search, so that the initial cell "
+                   "selection only considers the cells with a low enough "
+                   "pathloss. The cells are measured normally once the UE "
+                   "is synchronized.",
+                   DoubleValue (-1000.0),
+                   MakeDoubleAccessor (&LteUePhy::m_cellSearchRsrpThreshold),
+                   MakeDoubleChecker<double> ())
     .AddAttribute ("UeMeasurementsFilterPeriod",
                    "Time period for reporting UE measurements, i.e., the"
                    "length of layer-1 filtering.",
@@ -299,6 +318,15 @@ LteUePhy::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&LteUePhy::m_enableUplinkPowerControl),
                    MakeBooleanChecker ())
+    .AddAttribute ("EnableIdleSubframeSkipping",
+                   "If true, the subframe indications are not scheduled while "
+                   "the UE has nothing to transmit and no MAC procedure "
+                   "running, except in the subframes of its periodic SRS. "
+                   "Any activity (UL grant, control message, buffer status "
+                   "report, random access) resumes them.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LteUePhy::m_enableIdleSubframeSkipping),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -417,6 +445,7 @@ LteUePhy::DoSendMacPdu (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this);
 
+  DoWakeUp ();
   SetMacPdu (p);
 }
 
@@ -488,6 +517,7 @@ LteUePhy::GenerateCqiRsrpRsrq (const SpectrumValue& sinr)
 
   NS_ASSERT (m_state != CELL_SEARCH);
   NS_ASSERT (m_cellId > 0);
+  ResetSkippedSubframeFlags ();
 
   if (m_dlConfigured && m_ulConfigured && (m_rnti > 0))
     {
@@ -662,6 +692,7 @@ void
 LteUePhy::ReportInterference (const SpectrumValue& interf)
 {
   NS_LOG_FUNCTION (this << interf);
+  ResetSkippedSubframeFlags ();
   m_rsInterferencePowerUpdated = true;
   m_rsInterferencePower = interf;
 }
@@ -679,6 +710,7 @@ void
 LteUePhy::ReportRsReceivedPower (const SpectrumValue& power)
 {
   NS_LOG_FUNCTION (this << power);
+  ResetSkippedSubframeFlags ();
   m_rsReceivedPowerUpdated = true;
   m_rsReceivedPower = power;
 
@@ -848,6 +880,7 @@ LteUePhy::DoSendLteControlMessage (Ptr<LteControlMessage> msg)
 {
   NS_LOG_FUNCTION (this << msg);
 
+  DoWakeUp ();
   SetControlMessages (msg);
 }
 
@@ -857,6 +890,7 @@ LteUePhy::DoSendRachPreamble (uint32_t raPreambleId, uint32_t raRnti)
   NS_LOG_FUNCTION (this << raPreambleId);
 
   // unlike other control messages, RACH preamble is sent ASAP
+  DoWakeUp ();
   Ptr<RachPreambleLteControlMessage> msg = Create<RachPreambleLteControlMessage> ();
   msg->SetRapId (raPreambleId);
   m_raPreambleId = raPreambleId;
@@ -886,6 +920,8 @@ LteUePhy::ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> > msgLi
               // DCI not for me
               continue;
             }
+          // the PHY must follow the subframes of the scheduled transmission
+          DoWakeUp ();
 
           if (dci.m_resAlloc != 0)
             {
@@ -1010,6 +1046,7 @@ LteUePhy::ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> > msgLi
       else
         {
           // pass the message to UE-MAC
+          DoWakeUp ();
           m_uePhySapUser->ReceiveLteControlMessage (msg);
         }
 
@@ -1041,6 +1078,12 @@ LteUePhy::ReceivePss (uint16_t cellId, Ptr<SpectrumValue> p)
                     << " has RSRP " << rsrp_dBm << " and RBnum " << nRB);
   // note that m_pssReceptionThreshold does not apply here
 
+  if (m_state == CELL_SEARCH && rsrp_dBm < m_cellSearchRsrpThreshold)
+    {
+      NS_LOG_LOGIC (this << " ignoring cellId " << cellId << " during cell search");
+      return;
+    }
+
   // store measurements
   std::map <uint16_t, UeMeasurementsElement>::iterator itMeasMap = m_ueMeasurementsMap.find (cellId);
   if (itMeasMap == m_ueMeasurementsMap.end ())
@@ -1063,6 +1106,7 @@ LteUePhy::ReceivePss (uint16_t cellId, Ptr<SpectrumValue> p)
    * Collect the PSS for later processing in GenerateCtrlCqiReport()
    * (to be called from ChunkProcessor after RX is finished).
    */
+  ResetSkippedSubframeFlags ();
   m_pssReceived = true;
   PssElement el;
   el.cellId = cellId;
@@ -1076,6 +1120,7 @@ LteUePhy::ReceivePss (uint16_t cellId, Ptr<SpectrumValue> p)
 void
 LteUePhy::QueueSubChannelsForTransmission (std::vector <int> rbMap)
 {
+  DoWakeUp ();
   m_subChannelsForTransmissionQueue.at (m_macChTtiDelay - 1) = rbMap;
 }
 
@@ -1087,10 +1132,14 @@ LteUePhy::SubframeIndication (uint32_t frameNo, uint32_t subframeNo)
 
   NS_ASSERT_MSG (frameNo > 0, "the SRS index check code assumes that frameNo starts at 1");
 
+  // this may be the subframe of a periodic SRS while skipping idle subframes
+  m_subframesSkipped = false;
+
   // refresh internal variables
   m_rsReceivedPowerUpdated = false;
   m_rsInterferencePowerUpdated = false;
   m_pssReceived = false;
+  m_lastSubframeStart = Simulator::Now ();
 
   if (m_ulConfigured)
     {
@@ -1167,7 +1216,129 @@ LteUePhy::SubframeIndication (uint32_t frameNo, uint32_t subframeNo)
     }
 
   // schedule next subframe indication
-  Simulator::Schedule (Seconds (GetTti ()), &LteUePhy::SubframeIndication, this, frameNo, subframeNo);
+  if (m_enableIdleSubframeSkipping && IsSubframeIdle ())
+    {
+      SkipIdleSubframes (frameNo, subframeNo);
+    }
+  else
+    {
+      Simulator::Schedule (Seconds (GetTti ()), &LteUePhy::SubframeIndication, this, frameNo, subframeNo);
+    }
+}
+
+bool
+LteUePhy::IsSubframeIdle () const
+{
+  for (uint8_t i = 0; i < m_packetBurstQueue.size (); i++)
+    {
+      if (m_packetBurstQueue.at (i)->GetNPackets () > 0)
+        {
+          return false;
+        }
+    }
+  for (uint8_t i = 0; i < m_controlMessagesQueue.size (); i++)
+    {
+      if (!m_controlMessagesQueue.at (i).empty ())
+        {
+          return false;
+        }
+    }
+  for (uint8_t i = 0; i < m_subChannelsForTransmissionQueue.size (); i++)
+    {
+      if (!m_subChannelsForTransmissionQueue.at (i).empty ())
+        {
+          return false;
+        }
+    }
+  return m_uePhySapUser->IsIdle ();
+}
+
+void
+LteUePhy::SkipIdleSubframes (uint32_t frameNo, uint32_t subframeNo)
+{
+  NS_LOG_FUNCTION (this << frameNo << subframeNo);
+
+  Time tti = Seconds (GetTti ());
+  m_subframesSkipped = true;
+  m_nextSubframeTime = Simulator::Now () + tti;
+  m_nextSubframeIndex = (uint64_t) (frameNo - 1) * 10 + (subframeNo - 1);
+
+  if (m_ulConfigured && m_srsConfigured)
+    {
+      // the periodic SRS must be sent anyway: jump to its subframe
+      uint32_t skip = (m_srsSubframeOffset + m_srsPeriodicity
+                       - m_nextSubframeIndex % m_srsPeriodicity) % m_srsPeriodicity;
+      uint64_t index = m_nextSubframeIndex + skip;
+      NS_LOG_LOGIC (this << " UE idle, next subframe indication for SRS in " << skip + 1 << " TTIs");
+      m_srsSubframeEvent = Simulator::Schedule (tti * (skip + 1), &LteUePhy::SubframeIndication,
+                                                this, index / 10 + 1, index % 10 + 1);
+    }
+  else
+    {
+      NS_LOG_LOGIC (this << " UE idle, skipping subframe indications");
+    }
+}
+
+void
+LteUePhy::DoWakeUp ()
+{
+  if (!m_subframesSkipped)
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this);
+
+  ResetSkippedSubframeFlags ();
+  m_subframesSkipped = false;
+  m_srsSubframeEvent.Cancel ();
+
+  Time tti = Seconds (GetTti ());
+  uint64_t index = m_nextSubframeIndex;
+  Time next = m_nextSubframeTime;
+  if (Simulator::Now () >= next)
+    {
+      // The subframes up to the current one have been skipped. None of
+      // them had anything to do, so it is enough to tell the MAC about
+      // the current one. A wake up at the very start of a subframe is
+      // handled as if the indication of that subframe had already run,
+      // which is what happens without skipping unless the waking event
+      // was scheduled more than one TTI in advance.
+      int64_t skipped = (Simulator::Now () - next) / tti + 1;
+      index += skipped;
+      next += tti * skipped;
+      uint64_t current = index - 1;
+      m_subframeNo = current % 10 + 1;
+      m_uePhySapUser->SubframeIndication (current / 10 + 1, current % 10 + 1);
+    }
+
+  NS_LOG_LOGIC (this << " UE woken up, next subframe indication at " << next);
+  // the wake up may come from another node (e.g., an ideal RRC message)
+  uint32_t nodeId = Simulator::GetContext ();
+  if (m_netDevice != 0 && m_netDevice->GetNode () != 0)
+    {
+      nodeId = m_netDevice->GetNode ()->GetId ();
+    }
+  Simulator::ScheduleWithContext (nodeId, next - Simulator::Now (), &LteUePhy::SubframeIndication,
+                                  this, index / 10 + 1, index % 10 + 1);
+}
+
+void
+LteUePhy::ResetSkippedSubframeFlags ()
+{
+  if (!m_subframesSkipped || Simulator::Now () < m_nextSubframeTime)
+    {
+      return;
+    }
+  // start of the current (skipped) subframe
+  Time tti = Seconds (GetTti ());
+  Time start = m_nextSubframeTime + tti * ((Simulator::Now () - m_nextSubframeTime) / tti);
+  if (start > m_lastSubframeStart)
+    {
+      m_rsReceivedPowerUpdated = false;
+      m_rsInterferencePowerUpdated = false;
+      m_pssReceived = false;
+      m_lastSubframeStart = start;
+    }
 }
 
 
@@ -1198,6 +1369,8 @@ LteUePhy::DoReset ()
 {
   NS_LOG_FUNCTION (this);
 
+  DoWakeUp ();
+
   m_rnti = 0;
   m_transmissionMode = 0;
   m_srsPeriodicity = 0;
@@ -1304,6 +1477,7 @@ LteUePhy::DoSetDlBandwidth (uint8_t dlBandwidth)
 void 
 LteUePhy::DoConfigureUplink (uint32_t ulEarfcn, uint8_t ulBandwidth)
 {
+  DoWakeUp ();
   m_ulEarfcn = ulEarfcn;
   m_ulBandwidth = ulBandwidth;
   m_ulConfigured = true;
@@ -1338,6 +1512,7 @@ void
 LteUePhy::DoSetSrsConfigurationIndex (uint16_t srcCi)
 {
   NS_LOG_FUNCTION (this << srcCi);
+  DoWakeUp (); // the next SRS subframe may change
   m_srsPeriodicity = GetSrsPeriodicity (srcCi);
   m_srsSubframeOffset = GetSrsSubframeOffset (srcCi);
   m_srsConfigured = true;
@@ -1435,6 +1610,7 @@ LteUePhy::ReceiveLteDlHarqFeedback (DlInfoListElement_s m)
   // generate feedback to eNB and send it through ideal PUCCH
   Ptr<DlHarqFeedbackLteControlMessage> msg = Create<DlHarqFeedbackLteControlMessage> ();
   msg->SetDlHarqFeedback (m);
+  DoWakeUp ();
   SetControlMessages (msg);
 }
 
@@ -248,6 +248,34 @@ public:
    */
   void SendSrs ();
 
+  /**
+   * \brief Check whether the subframe indications can be skipped
+   *
+   * The UE is idle when nothing is queued for transmission in the next
+   * subframes (MAC PDUs, control messages or UL grants) and the MAC is idle
+   * as well.
+   *
+   * \return true if the UE is idle
+   */
+  bool IsSubframeIdle () const;
+
+  /**
+   * \brief Stop the subframe indications of an idle UE
+   *
+   * Only the subframes where a periodic SRS is due are still scheduled;
+   * any other activity resumes the indications through DoWakeUp.
+   *
+   * \param frameNo the frame number of the next subframe
+   * \param subframeNo the number of the next subframe
+   */
+  void SkipIdleSubframes (uint32_t frameNo, uint32_t subframeNo);
+
+  /**
+   * \brief Reset the per-subframe measurement flags if a subframe boundary
+   * has been skipped since the last reset
+   */
+  void ResetSkippedSubframeFlags ();
+
   /**
    * \brief PhySpectrum generated a new DL HARQ feedback
    * \param mes the DlInfoListElement_s
@@ -456,6 +484,11 @@ private:
    * \param raRnti the rnti
    */
   virtual void DoSendRachPreamble (uint32_t prachId, uint32_t raRnti);
+  /**
+   * Resume the subframe indications if they have been skipped because the
+   * UE was idle
+   */
+  void DoWakeUp ();
 
   /// A list of sub channels to use in TX.
   std::vector <int> m_subChannelsForTransmission;
@@ -544,6 +577,12 @@ private:
    */
   double m_pssReceptionThreshold;
 
+  /**
+   * The `CellSearchRsrpThreshold` attribute. Cells whose PSS is received
+   * with a lower RSRP, in dBm, are ignored during the cell search.
+   */
+  double m_cellSearchRsrpThreshold;
+
   /// Summary results of measuring a specific cell. Used for layer-1 filtering.
   struct UeMeasurementsElement
   {
@@ -598,6 +637,17 @@ private:
 
   EventId m_sendSrsEvent; ///< send SRS event
 
+  /**
+   * The `EnableIdleSubframeSkipping` attribute. If true, the subframe
+   * indications are not scheduled while the UE is idle.
+   */
+  bool m_enableIdleSubframeSkipping;
+  bool m_subframesSkipped; ///< true if the subframe indications are stopped
+  EventId m_srsSubframeEvent; ///< subframe indication of the next SRS while skipping subframes
+  Time m_nextSubframeTime; ///< time of the first skipped subframe
+  uint64_t m_nextSubframeIndex; ///< index, counted from frame 1 subframe 1, of the first skipped subframe
+  Time m_lastSubframeStart; ///< start of the subframe of the last reset of the measurement flags
+
   /**
    * The `UlPhyTransmission` trace source. Contains trace information regarding
    * PHY stats from UL Tx perspective. Exporting a structure with type
@@ -0,0 +1,329 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/string.h>
+#include <ns3/object-factory.h>
+#include <ns3/recording-ff-mac-scheduler.h>
+#include <sstream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("RecordingFfMacScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (RecordingFfMacScheduler);
+
+/**
+ * \ingroup ff-api
+ *
+ * Sched SAP user given to the recorded scheduler, which records its
+ * allocations before passing them to the MAC.
+ */
+class RecordingSchedSapUser : public FfMacSchedSapUser
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param recorder the recording scheduler
+   */
+  RecordingSchedSapUser (RecordingFfMacScheduler* recorder);
+
+  virtual void SchedDlConfigInd (const struct SchedDlConfigIndParameters& params);
+  virtual void SchedUlConfigInd (const struct SchedUlConfigIndParameters& params);
+
+private:
+  RecordingFfMacScheduler* m_recorder; ///< the recording scheduler
+};
+
+RecordingSchedSapUser::RecordingSchedSapUser (RecordingFfMacScheduler* recorder)
+  : m_recorder (recorder)
+{
+}
+
+void
+RecordingSchedSapUser::SchedDlConfigInd (const struct SchedDlConfigIndParameters& params)
+{
+  m_recorder->DoSchedDlConfigInd (params);
+}
+
+void
+RecordingSchedSapUser::SchedUlConfigInd (const struct SchedUlConfigIndParameters& params)
+{
+  m_recorder->DoSchedUlConfigInd (params);
+}
+
+
+RecordingFfMacScheduler::RecordingFfMacScheduler ()
+  : m_macSchedSapUser (0)
+{
+  NS_LOG_FUNCTION (this);
+  m_cschedSapProvider = new MemberCschedSapProvider<RecordingFfMacScheduler> (this);
+  m_schedSapProvider = new MemberSchedSapProvider<RecordingFfMacScheduler> (this);
+  m_schedSapUser = new RecordingSchedSapUser (this);
+}
+
+RecordingFfMacScheduler::~RecordingFfMacScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+RecordingFfMacScheduler::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_writer.Close ();
+  if (m_scheduler != 0)
+    {
+      m_scheduler->Dispose ();
+      m_scheduler = 0;
+    }
+  delete m_cschedSapProvider;
+  delete m_schedSapProvider;
+  delete m_schedSapUser;
+  FfMacScheduler::DoDispose ();
+}
+
+TypeId
+RecordingFfMacScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::RecordingFfMacScheduler")
+    .SetParent<FfMacScheduler> ()
+    .SetGroupName("Lte")
+    .AddConstructor<RecordingFfMacScheduler> ()
+    .AddAttribute ("SchedulerType",
+                   "The type of the recorded scheduler",
+                   StringValue ("ns3::PfFfMacScheduler"),
+                   MakeStringAccessor (&RecordingFfMacScheduler::m_schedulerType),
+                   MakeStringChecker ())
+    .AddAttribute ("TraceFilePrefix",
+                   "The prefix of the name of the trace files, which is followed by "
+                   "the number of the instance and by \".trace\"",
+                   StringValue ("ff-mac-sched"),
+                   MakeStringAccessor (&RecordingFfMacScheduler::m_filePrefix),
+                   MakeStringChecker ())
+  ;
+  return tid;
+}
+
+void
+RecordingFfMacScheduler::NotifyConstructionCompleted (void)
+{
+  NS_LOG_FUNCTION (this);
+  static uint32_t instances = 0;
+  ObjectFactory factory;
+  factory.SetTypeId (m_schedulerType);
+  m_scheduler = factory.Create<FfMacScheduler> ();
+  m_scheduler->SetFfMacSchedSapUser (m_schedSapUser);
+  std::ostringstream filename;
+  filename << m_filePrefix << "-" << instances++ << ".trace";
+  m_fileName = filename.str ();
+  m_writer.Open (m_fileName);
+  FfMacScheduler::NotifyConstructionCompleted ();
+}
+
+Ptr<FfMacScheduler>
+RecordingFfMacScheduler::GetScheduler (void) const
+{
+  return m_scheduler;
+}
+
+std::string
+RecordingFfMacScheduler::GetTraceFileName (void) const
+{
+  return m_fileName;
+}
+
+void
+RecordingFfMacScheduler::SetFfMacCschedSapUser (FfMacCschedSapUser* s)
+{
+  m_scheduler->SetFfMacCschedSapUser (s);
+}
+
+void
+RecordingFfMacScheduler::SetFfMacSchedSapUser (FfMacSchedSapUser* s)
+{
+  m_macSchedSapUser = s;
+}
+
+FfMacCschedSapProvider*
+RecordingFfMacScheduler::GetFfMacCschedSapProvider ()
+{
+  return m_cschedSapProvider;
+}
+
+FfMacSchedSapProvider*
+RecordingFfMacScheduler::GetFfMacSchedSapProvider ()
+{
+  return m_schedSapProvider;
+}
+
+void
+RecordingFfMacScheduler::SetLteFfrSapProvider (LteFfrSapProvider* s)
+{
+  m_scheduler->SetLteFfrSapProvider (s);
+}
+
+LteFfrSapUser*
+RecordingFfMacScheduler::GetLteFfrSapUser ()
+{
+  return m_scheduler->GetLteFfrSapUser ();
+}
+
+void
+RecordingFfMacScheduler::DoCschedCellConfigReq (const struct FfMacCschedSapProvider::CschedCellConfigReqParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+  m_writer.Write (params);
+  m_scheduler->GetFfMacCschedSapProvider ()->CschedCellConfigReq (params);
+}
+
+void
+RecordingFfMacScheduler::DoCschedUeConfigReq (const struct FfMacCschedSapProvider::CschedUeConfigReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_rnti);
+  m_writer.Write (params);
+  m_scheduler->GetFfMacCschedSapProvider ()->CschedUeConfigReq (params);
+}
+
+void
+RecordingFfMacScheduler::DoCschedLcConfigReq (const struct FfMacCschedSapProvider::CschedLcConfigReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_rnti);
+  m_writer.Write (params);
+  m_scheduler->GetFfMacCschedSapProvider ()->CschedLcConfigReq (params);
+}
+
+void
+RecordingFfMacScheduler::DoCschedLcReleaseReq (const struct FfMacCschedSapProvider::CschedLcReleaseReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_rnti);
+  m_writer.Write (params);
+  m_scheduler->GetFfMacCschedSapProvider ()->CschedLcReleaseReq (params);
+}
+
+void
+RecordingFfMacScheduler::DoCschedUeReleaseReq (const struct FfMacCschedSapProvider::CschedUeReleaseReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_rnti);
+  m_writer.Write (params);
+  m_scheduler->GetFfMacCschedSapProvider ()->CschedUeReleaseReq (params);
+}
+
+void
+RecordingFfMacScheduler::DoSchedDlRlcBufferReq (const struct FfMacSchedSapProvider::SchedDlRlcBufferReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_rnti);
+  m_writer.Write (params);
+  m_scheduler->GetFfMacSchedSapProvider ()->SchedDlRlcBufferReq (params);
+}
+
+void
+RecordingFfMacScheduler::DoSchedDlPagingBufferReq (const struct FfMacSchedSapProvider::SchedDlPagingBufferReqParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+  m_scheduler->GetFfMacSchedSapProvider ()->SchedDlPagingBufferReq (params);
+}
+
+void
+RecordingFfMacScheduler::DoSchedDlMacBufferReq (const struct FfMacSchedSapProvider::SchedDlMacBufferReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_rnti);
+  m_writer.Write (params);
+  m_scheduler->GetFfMacSchedSapProvider ()->SchedDlMacBufferReq (params);
+}
+
+void
+RecordingFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::SchedDlTriggerReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_sfnSf);
+  m_writer.Write (params);
+  m_scheduler->GetFfMacSchedSapProvider ()->SchedDlTriggerReq (params);
+}
+
+void
+RecordingFfMacScheduler::DoSchedDlRachInfoReq (const struct FfMacSchedSapProvider::SchedDlRachInfoReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_sfnSf);
+  m_writer.Write (params);
+  m_scheduler->GetFfMacSchedSapProvider ()->SchedDlRachInfoReq (params);
+}
+
+void
+RecordingFfMacScheduler::DoSchedDlCqiInfoReq (const struct FfMacSchedSapProvider::SchedDlCqiInfoReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_sfnSf);
+  m_writer.Write (params);
+  m_scheduler->GetFfMacSchedSapProvider ()->SchedDlCqiInfoReq (params);
+}
+
+void
+RecordingFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::SchedUlTriggerReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_sfnSf);
+  m_writer.Write (params);
+  m_scheduler->GetFfMacSchedSapProvider ()->SchedUlTriggerReq (params);
+}
+
+void
+RecordingFfMacScheduler::DoSchedUlNoiseInterferenceReq (const struct FfMacSchedSapProvider::SchedUlNoiseInterferenceReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_sfnSf);
+  m_writer.Write (params);
+  m_scheduler->GetFfMacSchedSapProvider ()->SchedUlNoiseInterferenceReq (params);
+}
+
+void
+RecordingFfMacScheduler::DoSchedUlSrInfoReq (const struct FfMacSchedSapProvider::SchedUlSrInfoReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_sfnSf);
+  m_writer.Write (params);
+  m_scheduler->GetFfMacSchedSapProvider ()->SchedUlSrInfoReq (params);
+}
+
+void
+RecordingFfMacScheduler::DoSchedUlMacCtrlInfoReq (const struct FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_sfnSf);
+  m_writer.Write (params);
+  m_scheduler->GetFfMacSchedSapProvider ()->SchedUlMacCtrlInfoReq (params);
+}
+
+void
+RecordingFfMacScheduler::DoSchedUlCqiInfoReq (const struct FfMacSchedSapProvider::SchedUlCqiInfoReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_sfnSf);
+  m_writer.Write (params);
+  m_scheduler->GetFfMacSchedSapProvider ()->SchedUlCqiInfoReq (params);
+}
+
+void
+RecordingFfMacScheduler::DoSchedDlConfigInd (const struct FfMacSchedSapUser::SchedDlConfigIndParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+  m_writer.Write (params);
+  m_macSchedSapUser->SchedDlConfigInd (params);
+}
+
+void
+RecordingFfMacScheduler::DoSchedUlConfigInd (const struct FfMacSchedSapUser::SchedUlConfigIndParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+  m_writer.Write (params);
+  m_macSchedSapUser->SchedUlConfigInd (params);
+}
+
+} // namespace ns3
@@ -0,0 +1,194 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RECORDING_FF_MAC_SCHEDULER_H
+#define RECORDING_FF_MAC_SCHEDULER_H
+
+#include <ns3/ff-mac-csched-sap.h>
+#include <ns3/ff-mac-sched-sap.h>
+#include <ns3/ff-mac-scheduler.h>
+#include <ns3/ff-mac-sched-trace.h>
+#include <string>
+
+namespace ns3 {
+
+class RecordingSchedSapUser;
+
+/**
+ * \ingroup ff-api
+ *
+ * \brief Scheduler which records the FF MAC Scheduler API calls of
+ * another scheduler.
+ *
+ * RecordingFfMacScheduler creates the scheduler set by its
+ * SchedulerType attribute, forwards all the calls of the MAC to it, and
+ * writes them, together with the allocations of the scheduler, to a
+ * trace file (see FfMacSchedTraceWriter).  Each instance writes its own
+ * file, named after the TraceFilePrefix attribute and the instance
+ * number.  The trace can then be replayed against any scheduler, without
+ * the PHY, the channel and the RLC, with utils/bench-lte-scheduler.
+ *
+ * The FFR algorithm is connected directly to the recorded scheduler.
+ */
+class RecordingFfMacScheduler : public FfMacScheduler
+{
+public:
+  RecordingFfMacScheduler ();
+  virtual ~RecordingFfMacScheduler ();
+
+  // inherited from Object
+  virtual void DoDispose (void);
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  // inherited from FfMacScheduler
+  virtual void SetFfMacCschedSapUser (FfMacCschedSapUser* s);
+  virtual void SetFfMacSchedSapUser (FfMacSchedSapUser* s);
+  virtual FfMacCschedSapProvider* GetFfMacCschedSapProvider ();
+  virtual FfMacSchedSapProvider* GetFfMacSchedSapProvider ();
+
+  // FFR SAPs
+  virtual void SetLteFfrSapProvider (LteFfrSapProvider* s);
+  virtual LteFfrSapUser* GetLteFfrSapUser ();
+
+  /// \return the recorded scheduler
+  Ptr<FfMacScheduler> GetScheduler (void) const;
+  /// \return the name of the trace file
+  std::string GetTraceFileName (void) const;
+
+  /// allow MemberCschedSapProvider<RecordingFfMacScheduler> class friend access
+  friend class MemberCschedSapProvider<RecordingFfMacScheduler>;
+  /// allow MemberSchedSapProvider<RecordingFfMacScheduler> class friend access
+  friend class MemberSchedSapProvider<RecordingFfMacScheduler>;
+  /// allow RecordingSchedSapUser class friend access
+  friend class RecordingSchedSapUser;
+
+protected:
+  // inherited from ObjectBase
+  virtual void NotifyConstructionCompleted (void);
+
+private:
+  /**
+   * \brief Csched cell config request
+   * \param params FfMacCschedSapProvider::CschedCellConfigReqParameters
+   */
+  void DoCschedCellConfigReq (const struct FfMacCschedSapProvider::CschedCellConfigReqParameters& params);
+  /**
+   * \brief Csched UE config request
+   * \param params FfMacCschedSapProvider::CschedUeConfigReqParameters
+   */
+  void DoCschedUeConfigReq (const struct FfMacCschedSapProvider::CschedUeConfigReqParameters& params);
+  /**
+   * \brief Csched LC config request
+   * \param params FfMacCschedSapProvider::CschedLcConfigReqParameters
+   */
+  void DoCschedLcConfigReq (const struct FfMacCschedSapProvider::CschedLcConfigReqParameters& params);
+  /**
+   * \brief Csched LC release request
+   * \param params FfMacCschedSapProvider::CschedLcReleaseReqParameters
+   */
+  void DoCschedLcReleaseReq (const struct FfMacCschedSapProvider::CschedLcReleaseReqParameters& params);
+  /**
+   * \brief Csched UE release request
+   * \param params FfMacCschedSapProvider::CschedUeReleaseReqParameters
+   */
+  void DoCschedUeReleaseReq (const struct FfMacCschedSapProvider::CschedUeReleaseReqParameters& params);
+
+  /**
+   * \brief Sched DL RLC buffer request
+   * \param params FfMacSchedSapProvider::SchedDlRlcBufferReqParameters
+   */
+  void DoSchedDlRlcBufferReq (const struct FfMacSchedSapProvider::SchedDlRlcBufferReqParameters& params);
+  /**
+   * \brief Sched DL paging buffer request, forwarded without being recorded
+   * \param params FfMacSchedSapProvider::SchedDlPagingBufferReqParameters
+   */
+  void DoSchedDlPagingBufferReq (const struct FfMacSchedSapProvider::SchedDlPagingBufferReqParameters& params);
+  /**
+   * \brief Sched DL MAC buffer request
+   * \param params FfMacSchedSapProvider::SchedDlMacBufferReqParameters
+   */
+  void DoSchedDlMacBufferReq (const struct FfMacSchedSapProvider::SchedDlMacBufferReqParameters& params);
+  /**
+   * \brief Sched DL trigger request
+   * \param params FfMacSchedSapProvider::SchedDlTriggerReqParameters
+   */
+  void DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::SchedDlTriggerReqParameters& params);
+  /**
+   * \brief Sched DL RACH info request
+   * \param params FfMacSchedSapProvider::SchedDlRachInfoReqParameters
+   */
+  void DoSchedDlRachInfoReq (const struct FfMacSchedSapProvider::SchedDlRachInfoReqParameters& params);
+  /**
+   * \brief Sched DL CQI info request
+   * \param params FfMacSchedSapProvider::SchedDlCqiInfoReqParameters
+   */
+  void DoSchedDlCqiInfoReq (const struct FfMacSchedSapProvider::SchedDlCqiInfoReqParameters& params);
+  /**
+   * \brief Sched UL trigger request
+   * \param params FfMacSchedSapProvider::SchedUlTriggerReqParameters
+   */
+  void DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::SchedUlTriggerReqParameters& params);
+  /**
+   * \brief Sched UL noise interference request
+   * \param params FfMacSchedSapProvider::SchedUlNoiseInterferenceReqParameters
+   */
+  void DoSchedUlNoiseInterferenceReq (const struct FfMacSchedSapProvider::SchedUlNoiseInterferenceReqParameters& params);
+  /**
+   * \brief Sched UL SR info request
+   * \param params FfMacSchedSapProvider::SchedUlSrInfoReqParameters
+   */
+  void DoSchedUlSrInfoReq (const struct FfMacSchedSapProvider::SchedUlSrInfoReqParameters& params);
+  /**
+   * \brief Sched UL MAC control info request
+   * \param params FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters
+   */
+  void DoSchedUlMacCtrlInfoReq (const struct FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters& params);
+  /**
+   * \brief Sched UL CQI info request
+   * \param params FfMacSchedSapProvider::SchedUlCqiInfoReqParameters
+   */
+  void DoSchedUlCqiInfoReq (const struct FfMacSchedSapProvider::SchedUlCqiInfoReqParameters& params);
+
+  /**
+   * \brief Sched DL config indication of the recorded scheduler
+   * \param params FfMacSchedSapUser::SchedDlConfigIndParameters
+   */
+  void DoSchedDlConfigInd (const struct FfMacSchedSapUser::SchedDlConfigIndParameters& params);
+  /**
+   * \brief Sched UL config indication of the recorded scheduler
+   * \param params FfMacSchedSapUser::SchedUlConfigIndParameters
+   */
+  void DoSchedUlConfigInd (const struct FfMacSchedSapUser::SchedUlConfigIndParameters& params);
+
+  std::string m_schedulerType;   ///< the type of the recorded scheduler
+  std::string m_filePrefix;      ///< the prefix of the trace file name
+  std::string m_fileName;        ///< the name of the trace file
+  Ptr<FfMacScheduler> m_scheduler;   ///< the recorded scheduler
+  FfMacSchedTraceWriter m_writer;    ///< the trace file
+
+  FfMacCschedSapProvider* m_cschedSapProvider; ///< CSched SAP provider
+  FfMacSchedSapProvider* m_schedSapProvider;   ///< Sched SAP provider
+  FfMacSchedSapUser* m_schedSapUser;           ///< Sched SAP user of the recorded scheduler
+  FfMacSchedSapUser* m_macSchedSapUser;        ///< Sched SAP user of the MAC
+};
+
+} // namespace ns3
+
+#endif /* RECORDING_FF_MAC_SCHEDULER_H */
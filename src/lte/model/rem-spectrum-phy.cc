@@ -43,7 +43,8 @@ RemSpectrumPhy::RemSpectrumPhy ()
     m_sumPower (0),
     m_active (true),
     m_useDataChannel (false),
-    m_rbId (-1)
+    m_rbId (-1),
+    m_keepRxSignals (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -60,6 +61,7 @@ RemSpectrumPhy::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
   m_mobility = 0;
+  m_rxSignals.clear ();
   SpectrumPhy::DoDispose ();
 }
 
@@ -149,6 +151,10 @@ RemSpectrumPhy::StartRx (Ptr<SpectrumSignalParameters> params)
                 {
                   m_referenceSignalPower = power;
                 }
+              if (m_keepRxSignals)
+                {
+                  m_rxSignals.push_back (params);
+                }
             }
         }
       else
@@ -172,6 +178,10 @@ RemSpectrumPhy::StartRx (Ptr<SpectrumSignalParameters> params)
                 {
                   m_referenceSignalPower = power;
                 }
+              if (m_keepRxSignals)
+                {
+                  m_rxSignals.push_back (params);
+                }
             }
         }
     }
@@ -207,6 +217,7 @@ RemSpectrumPhy::Reset ()
 {
   m_referenceSignalPower = 0;
   m_sumPower = 0;
+  m_rxSignals.clear ();
 }
 
 void
@@ -221,5 +232,17 @@ RemSpectrumPhy::SetRbId (int32_t rbId)
   m_rbId = rbId;
 }
 
+void
+RemSpectrumPhy::SetKeepRxSignals (bool value)
+{
+  m_keepRxSignals = value;
+}
+
+const std::vector<Ptr<SpectrumSignalParameters> > &
+RemSpectrumPhy::GetRxSignals () const
+{
+  return m_rxSignals;
+}
+
 
 } // namespace ns3
@@ -31,6 +31,7 @@
 #include <ns3/spectrum-channel.h>
 #include <string>
 #include <fstream>
+#include <vector>
 
 namespace ns3 {
 
@@ -119,6 +120,20 @@ public:
    */
   void SetRbId (int32_t rbId);
 
+  /**
+   * set whether the processed signals are kept
+   *
+   * \param value if true, the signals processed from now on are kept
+   * until the next Reset, see GetRxSignals
+   */
+  void SetKeepRxSignals (bool value);
+
+  /**
+   *
+   * \return the signals processed and kept since the last Reset
+   */
+  const std::vector<Ptr<SpectrumSignalParameters> > & GetRxSignals () const;
+
 private:
   Ptr<MobilityModel> m_mobility; ///< the mobility model
   Ptr<const SpectrumModel> m_rxSpectrumModel; ///< receive spectrum model
@@ -131,6 +146,9 @@ private:
   bool m_useDataChannel; ///< use data channel
   int32_t m_rbId; ///< RBID
 
+  bool m_keepRxSignals; ///< keep the processed signals?
+  std::vector<Ptr<SpectrumSignalParameters> > m_rxSignals; ///< the processed signals
+
 };
 
 
@@ -0,0 +1,398 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RNTI_MAP_H
+#define RNTI_MAP_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * \brief Dense per-UE state table, indexed by RNTI.
+ *
+ * The MAC schedulers keep many per-UE tables, which are looked up by
+ * RNTI several times per UE and per RBG at each TTI. RntiMap stores
+ * the values of such a table contiguously, in slots which are reused
+ * when UEs are released, and finds the slot of a RNTI with a single
+ * array access. Each per-UE field of a scheduler being kept in its own
+ * RntiMap, the hot fields are laid out as a struct of arrays.
+ *
+ * RntiMap provides the subset of the std::map <uint16_t, T> interface
+ * used by the schedulers, with the same semantics:
+ * - iteration visits the UEs in increasing RNTI order;
+ * - inserting or erasing an element does not invalidate the iterators
+ *   to the other elements.
+ *
+ * Finding a RNTI takes constant time; inserting or erasing a UE takes
+ * a time linear in the number of UEs.
+ *
+ * The slots of the RNTIs are indexed by pages of 256 RNTIs, allocated
+ * only while one of their RNTIs is stored. Besides the values, a map
+ * thus uses 1 KiB per page holding a stored RNTI, plus a table of the
+ * pages which grows with the highest RNTI stored, up to 6 KiB. The eNB
+ * allocates the RNTIs in increasing order, so the RNTIs in use stay in
+ * a few pages even after many UEs were released.
+ *
+ * \tparam T the type of the per-UE value
+ */
+template <class T>
+class RntiMap
+{
+public:
+  /// Key type
+  typedef uint16_t key_type;
+  /// Value type
+  typedef T mapped_type;
+  /// Element type, the key is not meant to be modified
+  typedef std::pair<uint16_t, T> value_type;
+
+private:
+  /// Index of the keys which are not in the table
+  static const uint32_t NO_SLOT = 0xffffffff;
+  /// Key of the end iterators
+  static const uint32_t END_KEY = 0x10000;
+  /// Number of bits of a RNTI giving its position in its page
+  static const uint32_t PAGE_BITS = 8;
+  /// Number of RNTIs per page
+  static const uint32_t PAGE_SIZE = 1 << PAGE_BITS;
+
+  /**
+   * Iterator over the elements, in increasing RNTI order.
+   *
+   * An iterator holds the key of its element, together with a hint of
+   * the position of the key in the sorted keys, and thus survives the
+   * insertion and the removal of the other elements.
+   *
+   * \tparam M the (const) container type
+   * \tparam V the (const) element type
+   */
+  template <class M, class V>
+  class Iterator
+  {
+    template <class M2, class V2> friend class Iterator;
+    friend class RntiMap;
+public:
+    /// Create an iterator which points nowhere
+    Iterator ()
+      : m_map (0),
+        m_key (END_KEY),
+        m_pos (0)
+    {
+    }
+    /**
+     * Convert from an iterator to a const iterator
+     * \param o the iterator to convert
+     */
+    template <class M2, class V2>
+    Iterator (const Iterator<M2, V2> &o)
+      : m_map (o.m_map),
+        m_key (o.m_key),
+        m_pos (o.m_pos)
+    {
+    }
+    /// \return the element
+    V & operator* () const
+    {
+      return m_map->m_values[m_map->Slot (m_key)];
+    }
+    /// \return a pointer to the element
+    V * operator-> () const
+    {
+      return &m_map->m_values[m_map->Slot (m_key)];
+    }
+    /// \return this iterator, moved to the next element
+    Iterator & operator++ ()
+    {
+      m_map->Next (m_key, m_pos);
+      return *this;
+    }
+    /// \return a copy of this iterator, before moving it to the next element
+    Iterator operator++ (int)
+    {
+      Iterator tmp = *this;
+      m_map->Next (m_key, m_pos);
+      return tmp;
+    }
+    /**
+     * \param o the other iterator
+     * \return true if both iterators point to the same element
+     */
+    template <class M2, class V2>
+    bool operator== (const Iterator<M2, V2> &o) const
+    {
+      return m_key == o.m_key;
+    }
+    /**
+     * \param o the other iterator
+     * \return true if the iterators point to different elements
+     */
+    template <class M2, class V2>
+    bool operator!= (const Iterator<M2, V2> &o) const
+    {
+      return m_key != o.m_key;
+    }
+private:
+    /**
+     * Create an iterator
+     * \param map the container
+     * \param key the key of the element, or END_KEY
+     * \param pos the position of the key in the sorted keys
+     */
+    Iterator (M *map, uint32_t key, uint32_t pos)
+      : m_map (map),
+        m_key (key),
+        m_pos (pos)
+    {
+    }
+    M *m_map;         //!< the container
+    uint32_t m_key;   //!< the key of the element
+    uint32_t m_pos;   //!< the position of the key in the sorted keys, if still valid
+  };
+
+public:
+  /// Iterator
+  typedef Iterator<RntiMap, value_type> iterator;
+  /// Const iterator
+  typedef Iterator<const RntiMap, const value_type> const_iterator;
+
+  /// \return an iterator to the element with the lowest RNTI
+  iterator begin ()
+  {
+    return iterator (this, m_keys.empty () ? END_KEY : m_keys[0], 0);
+  }
+  /// \return a const iterator to the element with the lowest RNTI
+  const_iterator begin () const
+  {
+    return const_iterator (this, m_keys.empty () ? END_KEY : m_keys[0], 0);
+  }
+  /// \return the past-the-end iterator
+  iterator end ()
+  {
+    return iterator (this, END_KEY, 0);
+  }
+  /// \return the past-the-end const iterator
+  const_iterator end () const
+  {
+    return const_iterator (this, END_KEY, 0);
+  }
+
+  /**
+   * \param rnti the RNTI
+   * \return an iterator to the element of the RNTI, or end ()
+   */
+  iterator find (uint16_t rnti)
+  {
+    return iterator (this, Contains (rnti) ? rnti : END_KEY, NO_SLOT);
+  }
+  /**
+   * \param rnti the RNTI
+   * \return a const iterator to the element of the RNTI, or end ()
+   */
+  const_iterator find (uint16_t rnti) const
+  {
+    return const_iterator (this, Contains (rnti) ? rnti : END_KEY, NO_SLOT);
+  }
+  /**
+   * \param rnti the RNTI
+   * \return 1 if the RNTI has an element, 0 otherwise
+   */
+  std::size_t count (uint16_t rnti) const
+  {
+    return Contains (rnti) ? 1 : 0;
+  }
+  /// \return the number of elements
+  std::size_t size () const
+  {
+    return m_keys.size ();
+  }
+  /// \return true if there is no element
+  bool empty () const
+  {
+    return m_keys.empty ();
+  }
+
+  /**
+   * Insert an element, unless its RNTI already has one.
+   * \param value the element
+   * \return an iterator to the element of the RNTI, and whether the
+   * element was inserted
+   */
+  std::pair<iterator, bool> insert (const value_type &value)
+  {
+    uint16_t rnti = value.first;
+    if (Contains (rnti))
+      {
+        return std::make_pair (find (rnti), false);
+      }
+    uint32_t slot;
+    if (m_free.empty ())
+      {
+        slot = m_values.size ();
+        m_values.push_back (value);
+      }
+    else
+      {
+        slot = m_free.back ();
+        m_free.pop_back ();
+        m_values[slot] = value;
+      }
+    uint32_t page = rnti >> PAGE_BITS;
+    if (page >= m_pages.size ())
+      {
+        m_pages.resize (page + 1);
+      }
+    if (m_pages[page].empty ())
+      {
+        m_pages[page].resize (PAGE_SIZE, NO_SLOT);
+      }
+    m_pages[page][rnti & (PAGE_SIZE - 1)] = slot;
+    std::vector<uint16_t>::iterator it = std::lower_bound (m_keys.begin (), m_keys.end (), rnti);
+    uint32_t pos = it - m_keys.begin ();
+    m_keys.insert (it, rnti);
+    return std::make_pair (iterator (this, rnti, pos), true);
+  }
+  /**
+   * \param rnti the RNTI
+   * \return the value of the RNTI, inserted with its default value if
+   * the RNTI had no element
+   */
+  T & operator[] (uint16_t rnti)
+  {
+    if (!Contains (rnti))
+      {
+        insert (value_type (rnti, T ()));
+      }
+    return m_values[Slot (rnti)].second;
+  }
+
+  /**
+   * Remove an element.
+   * \param it an iterator to the element
+   */
+  void erase (iterator it)
+  {
+    erase (static_cast<uint16_t> (it.m_key));
+  }
+  /**
+   * Remove the element of a RNTI, if any.
+   * \param rnti the RNTI
+   * \return the number of elements removed
+   */
+  std::size_t erase (uint16_t rnti)
+  {
+    if (!Contains (rnti))
+      {
+        return 0;
+      }
+    uint32_t page = rnti >> PAGE_BITS;
+    uint32_t slot = m_pages[page][rnti & (PAGE_SIZE - 1)];
+    // release the resources held by the value now, as std::map would
+    m_values[slot].second = T ();
+    m_free.push_back (slot);
+    m_pages[page][rnti & (PAGE_SIZE - 1)] = NO_SLOT;
+    std::vector<uint16_t>::iterator it = m_keys.erase (std::lower_bound (m_keys.begin (), m_keys.end (), rnti));
+    // release the page once none of its RNTIs is stored: its RNTIs
+    // would be next to the removed one in the sorted keys
+    if ((it == m_keys.begin () || (*(it - 1) >> PAGE_BITS) != page)
+        && (it == m_keys.end () || (*it >> PAGE_BITS) != page))
+      {
+        std::vector<uint32_t> ().swap (m_pages[page]);
+        while (!m_pages.empty () && m_pages.back ().empty ())
+          {
+            m_pages.pop_back ();
+          }
+      }
+    return 1;
+  }
+  /// Remove all the elements
+  void clear ()
+  {
+    m_values.clear ();
+    m_free.clear ();
+    m_pages.clear ();
+    m_keys.clear ();
+  }
+
+private:
+  /**
+   * \param rnti the RNTI
+   * \return true if the RNTI has an element
+   */
+  bool Contains (uint16_t rnti) const
+  {
+    uint32_t page = rnti >> PAGE_BITS;
+    return page < m_pages.size () && !m_pages[page].empty ()
+           && m_pages[page][rnti & (PAGE_SIZE - 1)] != NO_SLOT;
+  }
+  /**
+   * \param rnti a RNTI which has an element
+   * \return the slot of the element
+   */
+  uint32_t Slot (uint32_t rnti) const
+  {
+    return m_pages[rnti >> PAGE_BITS][rnti & (PAGE_SIZE - 1)];
+  }
+  /**
+   * Move an iterator to the next element.
+   * \param key the key of the element, replaced by the next key or END_KEY
+   * \param pos the position hint, replaced by the position of the next key
+   */
+  void Next (uint32_t &key, uint32_t &pos) const
+  {
+    if (key == END_KEY)
+      {
+        return;
+      }
+    if (pos < m_keys.size () && m_keys[pos] == key)
+      {
+        pos++;
+      }
+    else
+      {
+        // the hint is stale: the elements changed, or the iterator
+        // was returned by find
+        pos = std::upper_bound (m_keys.begin (), m_keys.end (), key) - m_keys.begin ();
+      }
+    key = pos < m_keys.size () ? m_keys[pos] : END_KEY;
+  }
+
+  std::vector<value_type> m_values;             //!< the elements, in slots
+  std::vector<uint32_t> m_free;                 //!< the unused slots
+  std::vector<std::vector<uint32_t> > m_pages;  //!< the slot of each RNTI, or NO_SLOT, by page; empty if none is stored
+  std::vector<uint16_t> m_keys;                 //!< the RNTIs of the elements, sorted
+};
+
+template <class T>
+const uint32_t RntiMap<T>::NO_SLOT;
+
+template <class T>
+const uint32_t RntiMap<T>::END_KEY;
+
+template <class T>
+const uint32_t RntiMap<T>::PAGE_BITS;
+
+template <class T>
+const uint32_t RntiMap<T>::PAGE_SIZE;
+
+} // namespace ns3
+
+#endif /* RNTI_MAP_H */
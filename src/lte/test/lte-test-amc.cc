@@ -0,0 +1,229 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/enum.h"
+#include "ns3/spectrum-model.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/lte-amc.h"
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestAmc");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case that checks the CQI of spectral efficiencies and the
+ * MCS of CQIs against a linear search of the tables.
+ */
+class LteAmcTablesTestCase : public TestCase
+{
+public:
+  LteAmcTablesTestCase ();
+  virtual ~LteAmcTablesTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteAmcTablesTestCase::LteAmcTablesTestCase ()
+  : TestCase ("CQI and MCS tables")
+{
+}
+
+LteAmcTablesTestCase::~LteAmcTablesTestCase ()
+{
+}
+
+void
+LteAmcTablesTestCase::DoRun (void)
+{
+  Ptr<LteAmc> amc = CreateObject<LteAmc> ();
+
+  // spectral efficiencies between and on the ones of the CQIs
+  for (uint32_t i = 0; i <= 6000; i++)
+    {
+      double s = i / 1000.0;
+      int expected = 0;
+      while ((expected < 15) && (amc->GetSpectralEfficiencyFromCqi (expected + 1) < s))
+        {
+          ++expected;
+        }
+      NS_TEST_ASSERT_MSG_EQ (amc->GetCqiFromSpectralEfficiency (s), expected,
+                             "Wrong CQI for spectral efficiency " << s);
+    }
+  for (int cqi = 0; cqi <= 15; cqi++)
+    {
+      double s = amc->GetSpectralEfficiencyFromCqi (cqi);
+      NS_TEST_ASSERT_MSG_EQ (amc->GetCqiFromSpectralEfficiency (s), (cqi > 0 ? cqi - 1 : 0),
+                             "Wrong CQI for the spectral efficiency of CQI " << cqi);
+    }
+
+  // the MCS of a CQI is the highest one with no higher spectral efficiency
+  const int mcsForCqi[16] = { 0, 0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28 };
+  for (int cqi = 0; cqi <= 15; cqi++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (amc->GetMcsFromCqi (cqi), mcsForCqi[cqi], "Wrong MCS for CQI " << cqi);
+    }
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case that checks the CQI feedbacks created for a SINR
+ * vector against the feedbacks of the AMC which evaluated the spectral
+ * efficiency of every RB, and the MI of every MCS.
+ */
+class LteAmcCqiFeedbacksTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param model the AMC model
+   * \param rbs the number of RBs
+   * \param rbgSize the RBG size
+   * \param sinrDb the mean SINR, in dB
+   * \param expected the expected CQIs, separated by spaces
+   */
+  LteAmcCqiFeedbacksTestCase (LteAmc::AmcModel model, uint32_t rbs, uint8_t rbgSize,
+                              double sinrDb, std::string expected);
+  virtual ~LteAmcCqiFeedbacksTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Build the name of the test case
+   *
+   * \param model the AMC model
+   * \param rbs the number of RBs
+   * \param rbgSize the RBG size
+   * \return the name
+   */
+  static std::string BuildNameString (LteAmc::AmcModel model, uint32_t rbs, uint8_t rbgSize);
+
+  LteAmc::AmcModel m_model; ///< the AMC model
+  uint32_t m_rbs;           ///< the number of RBs
+  uint8_t m_rbgSize;        ///< the RBG size
+  double m_sinrDb;          ///< the mean SINR, in dB
+  std::string m_expected;   ///< the expected CQIs
+};
+
+std::string
+LteAmcCqiFeedbacksTestCase::BuildNameString (LteAmc::AmcModel model, uint32_t rbs, uint8_t rbgSize)
+{
+  std::ostringstream oss;
+  oss << "CQI feedbacks, " << (model == LteAmc::PiroEW2010 ? "PiroEW2010" : "MiErrorModel")
+      << ", " << rbs << " RBs, RBG size " << (uint16_t) rbgSize;
+  return oss.str ();
+}
+
+LteAmcCqiFeedbacksTestCase::LteAmcCqiFeedbacksTestCase (LteAmc::AmcModel model, uint32_t rbs, uint8_t rbgSize,
+                                                        double sinrDb, std::string expected)
+  : TestCase (BuildNameString (model, rbs, rbgSize)),
+    m_model (model),
+    m_rbs (rbs),
+    m_rbgSize (rbgSize),
+    m_sinrDb (sinrDb),
+    m_expected (expected)
+{
+}
+
+LteAmcCqiFeedbacksTestCase::~LteAmcCqiFeedbacksTestCase ()
+{
+}
+
+void
+LteAmcCqiFeedbacksTestCase::DoRun (void)
+{
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < m_rbs; i++)
+    {
+      freqs.push_back (2.12e9 + i * 180e3);
+    }
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (freqs);
+
+  // a frequency selective SINR, with no signal in some RBs
+  SpectrumValue sinr (model);
+  for (uint32_t i = 0; i < m_rbs; i++)
+    {
+      double sinrDb = m_sinrDb + 12 * std::sin (0.21 * i) + 3 * std::cos (1.3 * i);
+      sinr[i] = (i % 17 == 16) ? 0.0 : std::pow (10.0, sinrDb / 10.0);
+    }
+
+  Ptr<LteAmc> amc = CreateObject<LteAmc> ();
+  amc->SetAttribute ("AmcModel", EnumValue (m_model));
+  std::vector<int> cqi = amc->CreateCqiFeedbacks (sinr, m_rbgSize);
+
+  std::istringstream iss (m_expected);
+  std::vector<int> expected;
+  int value;
+  while (iss >> value)
+    {
+      expected.push_back (value);
+    }
+  NS_TEST_ASSERT_MSG_EQ (cqi.size (), expected.size (), "Wrong number of CQIs");
+  for (uint32_t i = 0; i < cqi.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (cqi[i], expected[i], "Wrong CQI for RB " << i);
+    }
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of the AMC.
+ */
+class LteAmcTestSuite : public TestSuite
+{
+public:
+  LteAmcTestSuite ();
+};
+
+LteAmcTestSuite::LteAmcTestSuite ()
+  : TestSuite ("lte-amc", UNIT)
+{
+  AddTestCase (new LteAmcTablesTestCase, TestCase::QUICK);
+  // the last RBG of 50 RBs in RBGs of 3 RBs is 2 RBs only, but gets 3 CQIs
+  AddTestCase (new LteAmcCqiFeedbacksTestCase (LteAmc::PiroEW2010, 50, 0, 8,
+    "7 7 7 8 11 13 12 11 11 13 13 10 8 7 8 7 -1 2 2 2 1 0 0 0 1 1 0 1 3 6 6 5 7 -1 12 11 10 11 13 13 11 8 8 10 8 4 3 3 3 2"),
+               TestCase::QUICK);
+  AddTestCase (new LteAmcCqiFeedbacksTestCase (LteAmc::MiErrorModel, 50, 3, 8,
+    "9 9 9 12 12 12 13 13 13 14 14 14 10 10 10 3 3 3 4 4 4 0 0 0 2 2 2 5 5 5 8 8 8 8 8 8 13 13 13 13 13 13 11 11 11 5 5 5 5 5 5"),
+               TestCase::QUICK);
+  AddTestCase (new LteAmcCqiFeedbacksTestCase (LteAmc::MiErrorModel, 25, 25, 5,
+    "7 7 7 7 7 7 7 7 7 7 7 7 7 7 7 7 7 7 7 7 7 7 7 7 7"),
+               TestCase::QUICK);
+  AddTestCase (new LteAmcCqiFeedbacksTestCase (LteAmc::MiErrorModel, 100, 4, 10,
+    "10 10 10 10 15 15 15 15 15 15 15 15 11 11 11 11 4 4 4 4 2 2 2 2 4 4 4 4 8 8 8 8 10 10 10 10 15 15 15 15 12 12 12 12 "
+    "8 8 8 8 3 3 3 3 3 3 3 3 6 6 6 6 11 11 11 11 11 11 11 11 14 14 14 14 10 10 10 10 6 6 6 6 3 3 3 3 3 3 3 3 8 8 8 8 "
+    "13 13 13 13 15 15 15 15"),
+               TestCase::QUICK);
+}
+
+static LteAmcTestSuite g_lteAmcTestSuite; ///< the test suite
@@ -40,6 +40,7 @@
 #include <ns3/ipv4-interface-container.h>
 
 #include <ns3/lte-ue-net-device.h>
+#include <ns3/lte-ue-phy.h>
 #include <ns3/lte-ue-rrc.h>
 #include <ns3/lte-enb-net-device.h>
 
@@ -103,6 +104,19 @@ LteCellSelectionTestSuite::LteCellSelectionTestSuite ()
                //                                        isd      rngrun
                TestCase::QUICK);
 
+  // RSRP THRESHOLD OF THE CELL SEARCH
+
+  // the UE receives the cell with an RSRP of about -94 dBm
+  AddTestCase (new LteCellSearchRsrpThresholdTestCase ("RSRP threshold, default",
+                                                       false, 0.0, 1),
+               TestCase::QUICK);
+  AddTestCase (new LteCellSearchRsrpThresholdTestCase ("RSRP threshold, cell above",
+                                                       true, -100.0, 1),
+               TestCase::QUICK);
+  AddTestCase (new LteCellSearchRsrpThresholdTestCase ("RSRP threshold, cell below",
+                                                       true, -85.0, 0),
+               TestCase::QUICK);
+
 } // end of LteCellSelectionTestSuite::LteCellSelectionTestSuite ()
 
 
@@ -424,3 +438,99 @@ LteCellSelectionTestCase::ConnectionEstablishedCallback (
 {
   NS_LOG_FUNCTION (this << imsi << cellId << rnti);
 }
+
+
+
+/*
+ * Test Case of the RSRP threshold of the cell search
+ */
+
+
+LteCellSearchRsrpThresholdTestCase::LteCellSearchRsrpThresholdTestCase (
+  std::string name, bool setThreshold, double threshold,
+  uint16_t expectedCellId)
+  : TestCase (name),
+    m_setThreshold (setThreshold),
+    m_threshold (threshold),
+    m_expectedCellId (expectedCellId)
+{
+  NS_LOG_FUNCTION (this << GetName ());
+}
+
+
+LteCellSearchRsrpThresholdTestCase::~LteCellSearchRsrpThresholdTestCase ()
+{
+  NS_LOG_FUNCTION (this << GetName ());
+}
+
+
+void
+LteCellSearchRsrpThresholdTestCase::DoRun ()
+{
+  NS_LOG_FUNCTION (this << GetName ());
+
+  Config::SetGlobal ("RngRun", UintegerValue (1));
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("PathlossModel",
+                           StringValue ("ns3::FriisSpectrumPropagationLossModel"));
+  Ptr<PointToPointEpcHelper> epcHelper = CreateObject<PointToPointEpcHelper> ();
+  lteHelper->SetEpcHelper (epcHelper);
+
+  // one eNodeB, and one UE 1000 m away from it
+  NodeContainer enbNodes;
+  enbNodes.Create (1);
+  NodeContainer ueNodes;
+  ueNodes.Create (1);
+
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (1000.0, 0.0, 0.0));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  Ptr<LteUeNetDevice> ueDev = ueDevs.Get (0)->GetObject<LteUeNetDevice> ();
+  if (m_setThreshold)
+    {
+      ueDev->GetPhy ()->SetAttribute ("CellSearchRsrpThreshold",
+                                      DoubleValue (m_threshold));
+    }
+
+  int64_t stream = 1;
+  stream += lteHelper->AssignStreams (enbDevs, stream);
+  stream += lteHelper->AssignStreams (ueDevs, stream);
+
+  InternetStackHelper internet;
+  internet.Install (ueNodes);
+  epcHelper->AssignUeIpv4Address (ueDevs);
+
+  // Enable Idle mode cell selection
+  lteHelper->Attach (ueDevs);
+
+  Simulator::Schedule (MilliSeconds (283),
+                       &LteCellSearchRsrpThresholdTestCase::CheckPoint,
+                       this, ueDev);
+  Simulator::Stop (MilliSeconds (283));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+} // end of void LteCellSearchRsrpThresholdTestCase::DoRun ()
+
+
+void
+LteCellSearchRsrpThresholdTestCase::CheckPoint (Ptr<LteUeNetDevice> ueDev)
+{
+  NS_TEST_ASSERT_MSG_EQ (ueDev->GetRrc ()->GetCellId (), m_expectedCellId,
+                         "IMSI " << ueDev->GetImsi ()
+                                 << " has selected an unexpected cell");
+  LteUeRrc::State expectedState = m_expectedCellId > 0 ?
+    LteUeRrc::CONNECTED_NORMALLY : LteUeRrc::IDLE_CELL_SEARCH;
+  NS_TEST_ASSERT_MSG_EQ (ueDev->GetRrc ()->GetState (), expectedState,
+                         "IMSI " << ueDev->GetImsi ()
+                                 << " is in an unexpected state");
+}
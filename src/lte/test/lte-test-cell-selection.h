@@ -170,4 +170,46 @@ private:
 
 }; // end of class LteCellSelectionTestCase
 
+
+/**
+ * \ingroup lte
+ *
+ * \brief Testing the RSRP threshold of the cell search: a single UE, far
+ *        from a single eNodeB, must select its cell unless the RSRP of the
+ *        cell is below the CellSearchRsrpThreshold attribute of the UE PHY.
+ */
+class LteCellSearchRsrpThresholdTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Creates an instance of the cell search threshold test case.
+   * \param name name of this test
+   * \param setThreshold if false, the attribute keeps its default value
+   * \param threshold the value of the CellSearchRsrpThreshold attribute [dBm]
+   * \param expectedCellId the cell ID that the UE is expected to attach to
+   *                       (0 means that the UE should not select any cell)
+   */
+  LteCellSearchRsrpThresholdTestCase (std::string name, bool setThreshold,
+                                      double threshold, uint16_t expectedCellId);
+
+  virtual ~LteCellSearchRsrpThresholdTestCase ();
+
+private:
+  /**
+   * \brief Setup the simulation, run it, and verify the result.
+   */
+  virtual void DoRun ();
+
+  /**
+   * \brief Verifies the cell and the state of the UE.
+   * \param ueDev the UE device
+   */
+  void CheckPoint (Ptr<LteUeNetDevice> ueDev);
+
+  bool m_setThreshold; ///< whether the attribute is set
+  double m_threshold; ///< the value of the attribute [dBm]
+  uint16_t m_expectedCellId; ///< the expected cell ID
+
+}; // end of class LteCellSearchRsrpThresholdTestCase
+
 #endif /* LTE_TEST_CELL_SELECTION_H */
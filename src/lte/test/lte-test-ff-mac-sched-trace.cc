@@ -0,0 +1,516 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/config.h>
+#include <ns3/boolean.h>
+#include <ns3/double.h>
+#include <ns3/string.h>
+#include <ns3/node-container.h>
+#include <ns3/net-device-container.h>
+#include <ns3/mobility-helper.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/lte-helper.h>
+#include <ns3/lte-enb-net-device.h>
+#include <ns3/lte-ue-net-device.h>
+#include <ns3/component-carrier-enb.h>
+#include <ns3/eps-bearer.h>
+#include <ns3/ff-mac-sched-trace.h>
+#include <ns3/recording-ff-mac-scheduler.h>
+#include <ns3/pf-ff-mac-scheduler.h>
+#include <ns3/lte-fr-no-op-algorithm.h>
+#include <ns3/lte-vendor-specific-parameters.h>
+#include <set>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestFfMacSchedTrace");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case that writes the FF MAC Scheduler API calls to a trace
+ * file and reads them back.
+ */
+class LteFfMacSchedTraceTestCase : public TestCase
+{
+public:
+  LteFfMacSchedTraceTestCase ();
+  virtual ~LteFfMacSchedTraceTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteFfMacSchedTraceTestCase::LteFfMacSchedTraceTestCase ()
+  : TestCase ("Write and read a scheduler trace")
+{
+}
+
+LteFfMacSchedTraceTestCase::~LteFfMacSchedTraceTestCase ()
+{
+}
+
+void
+LteFfMacSchedTraceTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("sched.trace");
+
+  FfMacCschedSapProvider::CschedLcConfigReqParameters lc;
+  lc.m_rnti = 0x1234;
+  lc.m_reconfigureFlag = true;
+  LogicalChannelConfigListElement_s lcInfo;
+  lcInfo.m_logicalChannelIdentity = 3;
+  lcInfo.m_logicalChannelGroup = 1;
+  lcInfo.m_direction = LogicalChannelConfigListElement_s::DIR_BOTH;
+  lcInfo.m_qosBearerType = LogicalChannelConfigListElement_s::QBT_GBR;
+  lcInfo.m_qci = 1;
+  lcInfo.m_eRabMaximulBitrateUl = 0x123456789aULL;
+  lcInfo.m_eRabMaximulBitrateDl = 2;
+  lcInfo.m_eRabGuaranteedBitrateUl = 3;
+  lcInfo.m_eRabGuaranteedBitrateDl = 4;
+  lc.m_logicalChannelConfigList.push_back (lcInfo);
+
+  FfMacSchedSapProvider::SchedDlRlcBufferReqParameters rlc;
+  rlc.m_rnti = 7;
+  rlc.m_logicalChannelIdentity = 3;
+  rlc.m_rlcTransmissionQueueSize = 100000;
+  rlc.m_rlcTransmissionQueueHolDelay = 12;
+  rlc.m_rlcRetransmissionQueueSize = 30;
+  rlc.m_rlcRetransmissionHolDelay = 4;
+  rlc.m_rlcStatusPduSize = 2;
+
+  FfMacSchedSapProvider::SchedDlCqiInfoReqParameters cqiReq;
+  cqiReq.m_sfnSf = 0x123;
+  CqiListElement_s cqi;
+  cqi.m_rnti = 7;
+  cqi.m_ri = 1;
+  cqi.m_cqiType = CqiListElement_s::A30;
+  cqi.m_wbCqi.push_back (11);
+  cqi.m_wbPmi = 0;
+  for (uint8_t i = 0; i < 25; i++)
+    {
+      HigherLayerSelected_s sb;
+      sb.m_sbPmi = 0;
+      sb.m_sbCqi.push_back (i % 16);
+      cqi.m_sbMeasResult.m_higherLayerSelected.push_back (sb);
+    }
+  cqiReq.m_cqiList.push_back (cqi);
+
+  FfMacSchedSapProvider::SchedDlTriggerReqParameters dl;
+  dl.m_sfnSf = 0x124;
+  DlInfoListElement_s info;
+  info.m_rnti = 7;
+  info.m_harqProcessId = 5;
+  info.m_harqStatus.push_back (DlInfoListElement_s::NACK);
+  info.m_harqStatus.push_back (DlInfoListElement_s::ACK);
+  dl.m_dlInfoList.push_back (info);
+
+  FfMacSchedSapProvider::SchedUlCqiInfoReqParameters ulCqi;
+  ulCqi.m_sfnSf = 0x125;
+  ulCqi.m_ulCqi.m_type = UlCqi_s::SRS;
+  ulCqi.m_ulCqi.m_sinr.assign (25, 0xfedc);
+  VendorSpecificListElement_s vsp;
+  vsp.m_type = SRS_CQI_RNTI_VSP;
+  vsp.m_length = sizeof (SrsCqiRntiVsp);
+  vsp.m_value = Create<SrsCqiRntiVsp> (7);
+  ulCqi.m_vendorSpecificList.push_back (vsp);
+
+  FfMacSchedSapUser::SchedUlConfigIndParameters ulInd;
+  UlDciListElement_s dci;
+  dci.m_rnti = 7;
+  dci.m_rbStart = 3;
+  dci.m_rbLen = 9;
+  dci.m_tbSize = 777;
+  dci.m_mcs = 20;
+  dci.m_ndi = 1;
+  ulInd.m_dciList.push_back (dci);
+
+  FfMacSchedTraceWriter writer;
+  writer.Open (filename);
+  writer.Write (lc);
+  writer.Write (rlc);
+  writer.Write (cqiReq);
+  writer.Write (dl);
+  writer.Write (ulCqi);
+  writer.Write (ulInd);
+  writer.Close ();
+
+  FfMacSchedTraceReader reader;
+  reader.Open (filename);
+
+  NS_TEST_ASSERT_MSG_EQ (reader.Next (), TRACE_CSCHED_LC_CONFIG_REQ, "Wrong primitive");
+  FfMacCschedSapProvider::CschedLcConfigReqParameters lc2;
+  reader.Get (lc2);
+  NS_TEST_ASSERT_MSG_EQ (lc2.m_rnti, lc.m_rnti, "Wrong RNTI");
+  NS_TEST_ASSERT_MSG_EQ (lc2.m_reconfigureFlag, true, "Wrong reconfigure flag");
+  NS_TEST_ASSERT_MSG_EQ (lc2.m_logicalChannelConfigList.size (), 1, "Wrong number of LCs");
+  NS_TEST_ASSERT_MSG_EQ (lc2.m_logicalChannelConfigList[0].m_qosBearerType, LogicalChannelConfigListElement_s::QBT_GBR, "Wrong bearer type");
+  NS_TEST_ASSERT_MSG_EQ (lc2.m_logicalChannelConfigList[0].m_eRabMaximulBitrateUl, lcInfo.m_eRabMaximulBitrateUl, "Wrong bitrate");
+  NS_TEST_ASSERT_MSG_EQ (lc2.m_logicalChannelConfigList[0].m_eRabGuaranteedBitrateDl, 4, "Wrong bitrate");
+
+  NS_TEST_ASSERT_MSG_EQ (reader.Next (), TRACE_SCHED_DL_RLC_BUFFER_REQ, "Wrong primitive");
+  FfMacSchedSapProvider::SchedDlRlcBufferReqParameters rlc2;
+  reader.Get (rlc2);
+  NS_TEST_ASSERT_MSG_EQ (rlc2.m_rlcTransmissionQueueSize, 100000, "Wrong queue size");
+  NS_TEST_ASSERT_MSG_EQ (rlc2.m_rlcTransmissionQueueHolDelay, 12, "Wrong HOL delay");
+  NS_TEST_ASSERT_MSG_EQ (rlc2.m_rlcRetransmissionQueueSize, 30, "Wrong queue size");
+  NS_TEST_ASSERT_MSG_EQ (rlc2.m_rlcStatusPduSize, 2, "Wrong status PDU size");
+
+  NS_TEST_ASSERT_MSG_EQ (reader.Next (), TRACE_SCHED_DL_CQI_INFO_REQ, "Wrong primitive");
+  FfMacSchedSapProvider::SchedDlCqiInfoReqParameters cqiReq2;
+  reader.Get (cqiReq2);
+  NS_TEST_ASSERT_MSG_EQ (cqiReq2.m_sfnSf, 0x123, "Wrong sfnSf");
+  NS_TEST_ASSERT_MSG_EQ (cqiReq2.m_cqiList.size (), 1, "Wrong number of CQIs");
+  NS_TEST_ASSERT_MSG_EQ (cqiReq2.m_cqiList[0].m_cqiType, CqiListElement_s::A30, "Wrong CQI type");
+  NS_TEST_ASSERT_MSG_EQ ((cqiReq2.m_cqiList[0].m_wbCqi == cqi.m_wbCqi), true, "Wrong wideband CQI");
+  NS_TEST_ASSERT_MSG_EQ (cqiReq2.m_cqiList[0].m_sbMeasResult.m_higherLayerSelected.size (), 25, "Wrong number of subbands");
+  for (uint32_t i = 0; i < 25; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((cqiReq2.m_cqiList[0].m_sbMeasResult.m_higherLayerSelected[i].m_sbCqi
+                              == cqi.m_sbMeasResult.m_higherLayerSelected[i].m_sbCqi), true, "Wrong subband CQI");
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (reader.Next (), TRACE_SCHED_DL_TRIGGER_REQ, "Wrong primitive");
+  FfMacSchedSapProvider::SchedDlTriggerReqParameters dl2;
+  reader.Get (dl2);
+  NS_TEST_ASSERT_MSG_EQ (dl2.m_sfnSf, 0x124, "Wrong sfnSf");
+  NS_TEST_ASSERT_MSG_EQ (dl2.m_dlInfoList.size (), 1, "Wrong number of HARQ feedbacks");
+  NS_TEST_ASSERT_MSG_EQ (dl2.m_dlInfoList[0].m_harqProcessId, 5, "Wrong HARQ process");
+  NS_TEST_ASSERT_MSG_EQ ((dl2.m_dlInfoList[0].m_harqStatus == info.m_harqStatus), true, "Wrong HARQ status");
+
+  NS_TEST_ASSERT_MSG_EQ (reader.Next (), TRACE_SCHED_UL_CQI_INFO_REQ, "Wrong primitive");
+  FfMacSchedSapProvider::SchedUlCqiInfoReqParameters ulCqi2;
+  reader.Get (ulCqi2);
+  NS_TEST_ASSERT_MSG_EQ (ulCqi2.m_ulCqi.m_type, UlCqi_s::SRS, "Wrong UL CQI type");
+  NS_TEST_ASSERT_MSG_EQ ((ulCqi2.m_ulCqi.m_sinr == ulCqi.m_ulCqi.m_sinr), true, "Wrong SINR");
+  NS_TEST_ASSERT_MSG_EQ (ulCqi2.m_vendorSpecificList.size (), 1, "Wrong number of vendor specific parameters");
+  NS_TEST_ASSERT_MSG_EQ (ulCqi2.m_vendorSpecificList[0].m_type, SRS_CQI_RNTI_VSP, "Wrong vendor specific parameter");
+  Ptr<SrsCqiRntiVsp> vsp2 = DynamicCast<SrsCqiRntiVsp> (ulCqi2.m_vendorSpecificList[0].m_value);
+  NS_TEST_ASSERT_MSG_EQ (vsp2->GetRnti (), 7, "Wrong SRS RNTI");
+
+  NS_TEST_ASSERT_MSG_EQ (reader.Next (), TRACE_SCHED_UL_CONFIG_IND, "Wrong primitive");
+  FfMacSchedSapUser::SchedUlConfigIndParameters ulInd2;
+  reader.Get (ulInd2);
+  NS_TEST_ASSERT_MSG_EQ (ulInd2.m_dciList.size (), 1, "Wrong number of UL DCIs");
+  NS_TEST_ASSERT_MSG_EQ (ulInd2.m_dciList[0].m_rbStart, 3, "Wrong RB start");
+  NS_TEST_ASSERT_MSG_EQ (ulInd2.m_dciList[0].m_rbLen, 9, "Wrong RB length");
+  NS_TEST_ASSERT_MSG_EQ (ulInd2.m_dciList[0].m_tbSize, 777, "Wrong TB size");
+
+  NS_TEST_ASSERT_MSG_EQ (reader.Next (), TRACE_END, "Missing end of trace");
+  reader.Close ();
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief MAC side of the scheduler SAPs, which keeps the last
+ * allocations of the scheduler.
+ */
+class LteFfMacSchedTraceSapUser : public FfMacSchedSapUser,
+                                  public FfMacCschedSapUser
+{
+public:
+  virtual void SchedDlConfigInd (const struct SchedDlConfigIndParameters& params)
+  {
+    m_dl = params;
+  }
+  virtual void SchedUlConfigInd (const struct SchedUlConfigIndParameters& params)
+  {
+    m_ul = params;
+  }
+  virtual void CschedCellConfigCnf (const struct CschedCellConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedUeConfigCnf (const struct CschedUeConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedLcConfigCnf (const struct CschedLcConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedLcReleaseCnf (const struct CschedLcReleaseCnfParameters& params)
+  {
+  }
+  virtual void CschedUeReleaseCnf (const struct CschedUeReleaseCnfParameters& params)
+  {
+  }
+  virtual void CschedUeConfigUpdateInd (const struct CschedUeConfigUpdateIndParameters& params)
+  {
+  }
+  virtual void CschedCellConfigUpdateInd (const struct CschedCellConfigUpdateIndParameters& params)
+  {
+  }
+
+  SchedDlConfigIndParameters m_dl;   ///< the last DL allocations
+  SchedUlConfigIndParameters m_ul;   ///< the last UL allocations
+};
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case that records the scheduler calls of a LTE cell with
+ * RecordingFfMacScheduler, and checks that a scheduler of the same type
+ * fed with the recorded requests makes the recorded allocations.
+ */
+class LteRecordingFfMacSchedulerTestCase : public TestCase
+{
+public:
+  LteRecordingFfMacSchedulerTestCase ();
+  virtual ~LteRecordingFfMacSchedulerTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /// Record the scheduler calls of a cell in m_filename
+  void Record (void);
+
+  std::string m_filename;   ///< the name of the trace file
+};
+
+LteRecordingFfMacSchedulerTestCase::LteRecordingFfMacSchedulerTestCase ()
+  : TestCase ("Record and replay the scheduler calls of a cell")
+{
+}
+
+LteRecordingFfMacSchedulerTestCase::~LteRecordingFfMacSchedulerTestCase ()
+{
+}
+
+void
+LteRecordingFfMacSchedulerTestCase::Record (void)
+{
+  Config::SetDefault ("ns3::LteHelper::UseIdealRrc", BooleanValue (true));
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("PathlossModel", StringValue ("ns3::FriisSpectrumPropagationLossModel"));
+  lteHelper->SetSchedulerType ("ns3::RecordingFfMacScheduler");
+  lteHelper->SetSchedulerAttribute ("SchedulerType", StringValue ("ns3::PfFfMacScheduler"));
+  lteHelper->SetSchedulerAttribute ("TraceFilePrefix", StringValue (CreateTempDirFilename ("cell")));
+
+  NodeContainer enbNodes;
+  NodeContainer ueNodes;
+  enbNodes.Create (1);
+  ueNodes.Create (4);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+  for (uint32_t i = 0; i < ueNodes.GetN (); i++)
+    {
+      ueNodes.Get (i)->GetObject<ConstantPositionMobilityModel> ()->SetPosition (Vector (1000.0 * (i + 1), 0.0, 0.0));
+    }
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  lteHelper->Attach (ueDevs, enbDevs.Get (0));
+  EpsBearer bearer (EpsBearer::GBR_CONV_VOICE);
+  lteHelper->ActivateDataRadioBearer (ueDevs, bearer);
+
+  Ptr<LteEnbNetDevice> enbDev = enbDevs.Get (0)->GetObject<LteEnbNetDevice> ();
+  Ptr<RecordingFfMacScheduler> recorder =
+    DynamicCast<RecordingFfMacScheduler> (enbDev->GetCcMap ()[0]->GetFfMacScheduler ());
+  NS_TEST_ASSERT_MSG_NE (recorder, 0, "The scheduler is not recorded");
+  m_filename = recorder->GetTraceFileName ();
+
+  Simulator::Stop (Seconds (0.5));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+LteRecordingFfMacSchedulerTestCase::DoRun (void)
+{
+  Record ();
+
+  Ptr<FfMacScheduler> sched = CreateObject<PfFfMacScheduler> ();
+  Ptr<LteFfrAlgorithm> ffr = CreateObject<LteFrNoOpAlgorithm> ();
+  LteFfMacSchedTraceSapUser sapUser;
+  sched->SetFfMacCschedSapUser (&sapUser);
+  sched->SetFfMacSchedSapUser (&sapUser);
+  sched->SetLteFfrSapProvider (ffr->GetLteFfrSapProvider ());
+  ffr->SetLteFfrSapUser (sched->GetLteFfrSapUser ());
+  FfMacCschedSapProvider *csched = sched->GetFfMacCschedSapProvider ();
+  FfMacSchedSapProvider *schedSap = sched->GetFfMacSchedSapProvider ();
+
+  FfMacSchedTraceReader reader;
+  reader.Open (m_filename);
+  std::set<uint16_t> ues;
+  uint32_t dlTriggers = 0;
+  uint32_t dlAllocations = 0;
+  uint32_t ulAllocations = 0;
+  FfMacSchedTracePrimitive_e primitive;
+  while ((primitive = reader.Next ()) != TRACE_END)
+    {
+      switch (primitive)
+        {
+        case TRACE_CSCHED_CELL_CONFIG_REQ:
+          {
+            FfMacCschedSapProvider::CschedCellConfigReqParameters params;
+            reader.Get (params);
+            ffr->SetDlBandwidth (params.m_dlBandwidth);
+            ffr->SetUlBandwidth (params.m_ulBandwidth);
+            csched->CschedCellConfigReq (params);
+          }
+          break;
+        case TRACE_CSCHED_UE_CONFIG_REQ:
+          {
+            FfMacCschedSapProvider::CschedUeConfigReqParameters params;
+            reader.Get (params);
+            ues.insert (params.m_rnti);
+            csched->CschedUeConfigReq (params);
+          }
+          break;
+        case TRACE_CSCHED_LC_CONFIG_REQ:
+          {
+            FfMacCschedSapProvider::CschedLcConfigReqParameters params;
+            reader.Get (params);
+            csched->CschedLcConfigReq (params);
+          }
+          break;
+        case TRACE_SCHED_DL_RLC_BUFFER_REQ:
+          {
+            FfMacSchedSapProvider::SchedDlRlcBufferReqParameters params;
+            reader.Get (params);
+            schedSap->SchedDlRlcBufferReq (params);
+          }
+          break;
+        case TRACE_SCHED_DL_TRIGGER_REQ:
+          {
+            FfMacSchedSapProvider::SchedDlTriggerReqParameters params;
+            reader.Get (params);
+            dlTriggers++;
+            sapUser.m_dl = FfMacSchedSapUser::SchedDlConfigIndParameters ();
+            schedSap->SchedDlTriggerReq (params);
+          }
+          break;
+        case TRACE_SCHED_DL_RACH_INFO_REQ:
+          {
+            FfMacSchedSapProvider::SchedDlRachInfoReqParameters params;
+            reader.Get (params);
+            schedSap->SchedDlRachInfoReq (params);
+          }
+          break;
+        case TRACE_SCHED_DL_CQI_INFO_REQ:
+          {
+            FfMacSchedSapProvider::SchedDlCqiInfoReqParameters params;
+            reader.Get (params);
+            schedSap->SchedDlCqiInfoReq (params);
+          }
+          break;
+        case TRACE_SCHED_UL_TRIGGER_REQ:
+          {
+            FfMacSchedSapProvider::SchedUlTriggerReqParameters params;
+            reader.Get (params);
+            sapUser.m_ul = FfMacSchedSapUser::SchedUlConfigIndParameters ();
+            schedSap->SchedUlTriggerReq (params);
+          }
+          break;
+        case TRACE_SCHED_UL_SR_INFO_REQ:
+          {
+            FfMacSchedSapProvider::SchedUlSrInfoReqParameters params;
+            reader.Get (params);
+            schedSap->SchedUlSrInfoReq (params);
+          }
+          break;
+        case TRACE_SCHED_UL_MAC_CTRL_INFO_REQ:
+          {
+            FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters params;
+            reader.Get (params);
+            schedSap->SchedUlMacCtrlInfoReq (params);
+          }
+          break;
+        case TRACE_SCHED_UL_CQI_INFO_REQ:
+          {
+            FfMacSchedSapProvider::SchedUlCqiInfoReqParameters params;
+            reader.Get (params);
+            schedSap->SchedUlCqiInfoReq (params);
+          }
+          break;
+        case TRACE_SCHED_DL_CONFIG_IND:
+          {
+            FfMacSchedSapUser::SchedDlConfigIndParameters params;
+            reader.Get (params);
+            NS_TEST_ASSERT_MSG_EQ (sapUser.m_dl.m_buildDataList.size (), params.m_buildDataList.size (),
+                                   "Wrong number of DL allocations in DL trigger " << dlTriggers);
+            for (uint32_t i = 0; i < params.m_buildDataList.size (); i++)
+              {
+                const DlDciListElement_s &dci = sapUser.m_dl.m_buildDataList[i].m_dci;
+                NS_TEST_ASSERT_MSG_EQ (dci.m_rnti, params.m_buildDataList[i].m_rnti, "Wrong DL RNTI");
+                NS_TEST_ASSERT_MSG_EQ (dci.m_rbBitmap, params.m_buildDataList[i].m_dci.m_rbBitmap, "Wrong DL RBGs");
+                NS_TEST_ASSERT_MSG_EQ (dci.m_harqProcess, params.m_buildDataList[i].m_dci.m_harqProcess, "Wrong HARQ process");
+                NS_TEST_ASSERT_MSG_EQ ((dci.m_tbsSize == params.m_buildDataList[i].m_dci.m_tbsSize), true, "Wrong DL TB size");
+              }
+            dlAllocations += params.m_buildDataList.size ();
+          }
+          break;
+        case TRACE_SCHED_UL_CONFIG_IND:
+          {
+            FfMacSchedSapUser::SchedUlConfigIndParameters params;
+            reader.Get (params);
+            NS_TEST_ASSERT_MSG_EQ (sapUser.m_ul.m_dciList.size (), params.m_dciList.size (),
+                                   "Wrong number of UL allocations after DL trigger " << dlTriggers);
+            for (uint32_t i = 0; i < params.m_dciList.size (); i++)
+              {
+                const UlDciListElement_s &dci = sapUser.m_ul.m_dciList[i];
+                NS_TEST_ASSERT_MSG_EQ (dci.m_rnti, params.m_dciList[i].m_rnti, "Wrong UL RNTI");
+                NS_TEST_ASSERT_MSG_EQ ((uint32_t) dci.m_rbStart, (uint32_t) params.m_dciList[i].m_rbStart, "Wrong UL RB start");
+                NS_TEST_ASSERT_MSG_EQ ((uint32_t) dci.m_rbLen, (uint32_t) params.m_dciList[i].m_rbLen, "Wrong UL RB length");
+                NS_TEST_ASSERT_MSG_EQ (dci.m_tbSize, params.m_dciList[i].m_tbSize, "Wrong UL TB size");
+              }
+            ulAllocations += params.m_dciList.size ();
+          }
+          break;
+        default:
+          NS_TEST_ASSERT_MSG_EQ (true, false, "Unexpected primitive " << primitive);
+          break;
+        }
+    }
+  reader.Close ();
+  sched->Dispose ();
+  ffr->Dispose ();
+
+  NS_TEST_ASSERT_MSG_EQ (ues.size (), 4, "Wrong number of UEs");
+  NS_TEST_ASSERT_MSG_GT (dlTriggers, 400, "Missing DL triggers");
+  NS_TEST_ASSERT_MSG_GT (dlAllocations, 0, "No DL allocation");
+  NS_TEST_ASSERT_MSG_GT (ulAllocations, 0, "No UL allocation");
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of the scheduler traces.
+ */
+class LteFfMacSchedTraceTestSuite : public TestSuite
+{
+public:
+  LteFfMacSchedTraceTestSuite ();
+};
+
+LteFfMacSchedTraceTestSuite::LteFfMacSchedTraceTestSuite ()
+  : TestSuite ("lte-ff-mac-sched-trace", UNIT)
+{
+  AddTestCase (new LteFfMacSchedTraceTestCase, TestCase::QUICK);
+  AddTestCase (new LteRecordingFfMacSchedulerTestCase, TestCase::QUICK);
+}
+
+static LteFfMacSchedTraceTestSuite g_lteFfMacSchedTraceTestSuite; ///< the test suite
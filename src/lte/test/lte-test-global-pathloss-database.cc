@@ -0,0 +1,326 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/position-allocator.h"
+#include "ns3/lte-helper.h"
+#include "ns3/lte-enb-net-device.h"
+#include "ns3/lte-ue-net-device.h"
+#include "ns3/spectrum-channel.h"
+#include "ns3/lte-global-pathloss-database.h"
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <limits>
+#include <cmath>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestGlobalPathlossDatabase");
+
+/**
+ * A snapshot read from the binary export of a LteGlobalPathlossDatabase
+ */
+struct PathlossSnapshot
+{
+  uint32_t numRows;             ///< the number of rows, one per cell ID
+  uint32_t numColumns;          ///< the number of columns, one per IMSI
+  uint32_t bytesPerValue;       ///< the size of each value
+  double time;                  ///< the simulation time of the snapshot
+  std::vector<double> pathloss; ///< the values, row by row
+};
+
+/**
+ * \param is the input stream
+ * \param snapshot the snapshot read
+ * \return false if no complete snapshot could be read
+ */
+static bool
+ReadSnapshot (std::istream &is, PathlossSnapshot &snapshot)
+{
+  uint32_t header[3];
+  if (!is.read (reinterpret_cast<char *> (header), sizeof (header))
+      || !is.read (reinterpret_cast<char *> (&snapshot.time), sizeof (snapshot.time)))
+    {
+      return false;
+    }
+  snapshot.numRows = header[0];
+  snapshot.numColumns = header[1];
+  snapshot.bytesPerValue = header[2];
+  snapshot.pathloss.resize (snapshot.numRows * snapshot.numColumns);
+  for (uint32_t i = 0; i < snapshot.pathloss.size (); i++)
+    {
+      if (snapshot.bytesPerValue == sizeof (float))
+        {
+          float value;
+          is.read (reinterpret_cast<char *> (&value), sizeof (value));
+          snapshot.pathloss[i] = value;
+        }
+      else
+        {
+          is.read (reinterpret_cast<char *> (&snapshot.pathloss[i]), sizeof (double));
+        }
+    }
+  return bool (is);
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case that stores the pathloss reported by the PathLoss trace
+ * of the channels and the pathloss of the snapshots of the channel models,
+ * in double and in float, and checks that they are the same, and that the
+ * binary exports contain them.
+ */
+class LteGlobalPathlossDatabaseTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param singlePrecision whether the snapshots are stored as float
+   */
+  LteGlobalPathlossDatabaseTestCase (bool singlePrecision);
+  virtual ~LteGlobalPathlossDatabaseTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Check the values of the snapshots against the traced ones
+   * \param traced the database fed by the PathLoss trace
+   * \param snapshot the database of the snapshots
+   * \param enbDevs the eNB devices
+   * \param ueDevs the UE devices
+   * \param direction "DL" or "UL"
+   */
+  void Check (LteGlobalPathlossDatabase &traced, LteGlobalPathlossDatabase &snapshot,
+              NetDeviceContainer enbDevs, NetDeviceContainer ueDevs, std::string direction);
+
+  bool m_singlePrecision; ///< whether the snapshots are stored as float
+};
+
+LteGlobalPathlossDatabaseTestCase::LteGlobalPathlossDatabaseTestCase (bool singlePrecision)
+  : TestCase (singlePrecision ? "pathloss snapshots in float" : "pathloss snapshots in double"),
+    m_singlePrecision (singlePrecision)
+{
+}
+
+LteGlobalPathlossDatabaseTestCase::~LteGlobalPathlossDatabaseTestCase ()
+{
+}
+
+void
+LteGlobalPathlossDatabaseTestCase::Check (LteGlobalPathlossDatabase &traced, LteGlobalPathlossDatabase &snapshot,
+                                          NetDeviceContainer enbDevs, NetDeviceContainer ueDevs, std::string direction)
+{
+  for (uint32_t i = 0; i < enbDevs.GetN (); i++)
+    {
+      uint16_t cellId = enbDevs.Get (i)->GetObject<LteEnbNetDevice> ()->GetCellId ();
+      for (uint32_t j = 0; j < ueDevs.GetN (); j++)
+        {
+          uint64_t imsi = ueDevs.Get (j)->GetObject<LteUeNetDevice> ()->GetImsi ();
+          double expected = traced.GetPathloss (cellId, imsi);
+          NS_TEST_ASSERT_MSG_NE (expected, std::numeric_limits<double>::infinity (),
+                                 direction << " pathloss of cell " << cellId << " IMSI " << imsi << " not traced");
+          double tol = m_singlePrecision ? 1e-6 * std::fabs (expected) : 0.0;
+          NS_TEST_ASSERT_MSG_EQ_TOL (snapshot.GetPathloss (cellId, imsi), expected, tol,
+                                     "different " << direction << " pathloss of cell " << cellId << " IMSI " << imsi);
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (snapshot.GetPathloss (0, 1), std::numeric_limits<double>::infinity (),
+                         "pathloss of a missing cell");
+  NS_TEST_ASSERT_MSG_EQ (snapshot.GetPathloss (1, 1000), std::numeric_limits<double>::infinity (),
+                         "pathloss of a missing IMSI");
+}
+
+void
+LteGlobalPathlossDatabaseTestCase::DoRun (void)
+{
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  // directional antennas, so that the gains of both ends matter
+  lteHelper->SetEnbAntennaModelType ("ns3::CosineAntennaModel");
+  lteHelper->SetEnbAntennaModelAttribute ("Beamwidth", DoubleValue (90.0));
+
+  NodeContainer enbNodes;
+  enbNodes.Create (2);
+  NodeContainer ueNodes;
+  ueNodes.Create (3);
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 30.0));
+  positionAlloc->Add (Vector (500.0, 0.0, 30.0));
+  positionAlloc->Add (Vector (100.0, 50.0, 1.5));
+  positionAlloc->Add (Vector (300.0, -80.0, 1.5));
+  positionAlloc->Add (Vector (450.0, 200.0, 1.5));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  lteHelper->Attach (ueDevs.Get (0), enbDevs.Get (0));
+  lteHelper->Attach (ueDevs.Get (1), enbDevs.Get (1));
+  lteHelper->Attach (ueDevs.Get (2), enbDevs.Get (1));
+
+  DownlinkLteGlobalPathlossDatabase dlTraced;
+  UplinkLteGlobalPathlossDatabase ulTraced;
+  std::ostringstream dlPath;
+  dlPath << "/ChannelList/" << lteHelper->GetDownlinkSpectrumChannel ()->GetId () << "/PathLoss";
+  std::ostringstream ulPath;
+  ulPath << "/ChannelList/" << lteHelper->GetUplinkSpectrumChannel ()->GetId () << "/PathLoss";
+  Config::Connect (dlPath.str (), MakeCallback (&DownlinkLteGlobalPathlossDatabase::UpdatePathloss, &dlTraced));
+  Config::Connect (ulPath.str (), MakeCallback (&UplinkLteGlobalPathlossDatabase::UpdatePathloss, &ulTraced));
+
+  DownlinkLteGlobalPathlossDatabase dlSnapshot (m_singlePrecision);
+  UplinkLteGlobalPathlossDatabase ulSnapshot (m_singlePrecision);
+  dlSnapshot.Reserve (2, 3);
+  std::string snapshotFile = CreateTempDirFilename ("pathloss-snapshots.bin");
+  dlSnapshot.EnablePeriodicSnapshots (enbDevs, ueDevs, MilliSeconds (40), snapshotFile);
+  ulSnapshot.EnablePeriodicSnapshots (enbDevs, ueDevs, MilliSeconds (40));
+
+  Simulator::Stop (MilliSeconds (100));
+  Simulator::Run ();
+
+  Check (dlTraced, dlSnapshot, enbDevs, ueDevs, "DL");
+  Check (ulTraced, ulSnapshot, enbDevs, ueDevs, "UL");
+
+  std::ostringstream exported;
+  dlSnapshot.ExportBinary (exported);
+  Simulator::Destroy ();
+
+  // the snapshots at 0, 40 and 80 ms, and the export at the end
+  std::ifstream file (snapshotFile.c_str (), std::ios_base::binary);
+  std::vector<PathlossSnapshot> snapshots;
+  PathlossSnapshot snapshot;
+  while (ReadSnapshot (file, snapshot))
+    {
+      snapshots.push_back (snapshot);
+    }
+  std::istringstream exportedStream (exported.str ());
+  NS_TEST_ASSERT_MSG_EQ (ReadSnapshot (exportedStream, snapshot), true, "cannot read the export");
+  snapshots.push_back (snapshot);
+  NS_TEST_ASSERT_MSG_EQ (snapshots.size (), 4, "wrong number of snapshots");
+
+  for (uint32_t s = 0; s < snapshots.size (); s++)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (snapshots[s].time, std::min (0.04 * s, 0.1), 1e-9, "wrong time of snapshot " << s);
+      NS_TEST_ASSERT_MSG_EQ (snapshots[s].numRows, 3, "wrong number of rows of snapshot " << s);
+      NS_TEST_ASSERT_MSG_EQ (snapshots[s].numColumns, 4, "wrong number of columns of snapshot " << s);
+      NS_TEST_ASSERT_MSG_EQ (snapshots[s].bytesPerValue, (m_singlePrecision ? 4 : 8), "wrong size of the values");
+      for (uint16_t cellId = 0; cellId < 3; cellId++)
+        {
+          for (uint64_t imsi = 0; imsi < 4; imsi++)
+            {
+              NS_TEST_ASSERT_MSG_EQ (snapshots[s].pathloss[cellId * 4 + imsi], dlSnapshot.GetPathloss (cellId, imsi),
+                                     "wrong exported pathloss of cell " << cellId << " IMSI " << imsi);
+            }
+        }
+    }
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case that stores pathloss values in an order that grows the
+ * matrix of a LteGlobalPathlossDatabase in both dimensions, and checks that
+ * no value is lost.
+ */
+class LteGlobalPathlossDatabaseGrowthTestCase : public TestCase
+{
+public:
+  LteGlobalPathlossDatabaseGrowthTestCase ();
+  virtual ~LteGlobalPathlossDatabaseGrowthTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+/**
+ * A database that stores the values given to UpdatePathloss directly
+ */
+class TestLteGlobalPathlossDatabase : public DownlinkLteGlobalPathlossDatabase
+{
+public:
+  /**
+   * Store a pathloss value
+   * \param cellId the id of the eNB
+   * \param imsi the id of the UE
+   * \param lossDb the loss in dB
+   */
+  void Set (uint16_t cellId, uint64_t imsi, double lossDb)
+  {
+    SetPathloss (cellId, imsi, lossDb);
+  }
+};
+
+LteGlobalPathlossDatabaseGrowthTestCase::LteGlobalPathlossDatabaseGrowthTestCase ()
+  : TestCase ("growth of the pathloss matrix")
+{
+}
+
+LteGlobalPathlossDatabaseGrowthTestCase::~LteGlobalPathlossDatabaseGrowthTestCase ()
+{
+}
+
+void
+LteGlobalPathlossDatabaseGrowthTestCase::DoRun (void)
+{
+  TestLteGlobalPathlossDatabase db;
+  NS_TEST_ASSERT_MSG_EQ (db.GetPathloss (1, 1), std::numeric_limits<double>::infinity (), "pathloss of an empty database");
+  const uint32_t cellIds[] = { 1, 3, 2, 17, 5, 40, 40 };
+  const uint32_t imsis[] = { 1, 1, 9, 2, 100, 3, 250 };
+  for (uint32_t i = 0; i < 7; i++)
+    {
+      db.Set (cellIds[i], imsis[i], 60.0 + i);
+    }
+  db.Set (3, 1, 100.0);
+  for (uint32_t i = 0; i < 7; i++)
+    {
+      double expected = (cellIds[i] == 3 && imsis[i] == 1) ? 100.0 : 60.0 + i;
+      NS_TEST_ASSERT_MSG_EQ (db.GetPathloss (cellIds[i], imsis[i]), expected,
+                             "wrong pathloss of cell " << cellIds[i] << " IMSI " << imsis[i]);
+    }
+  NS_TEST_ASSERT_MSG_EQ (db.GetPathloss (17, 100), std::numeric_limits<double>::infinity (), "pathloss of a missing pair");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of the LteGlobalPathlossDatabase.
+ */
+class LteGlobalPathlossDatabaseTestSuite : public TestSuite
+{
+public:
+  LteGlobalPathlossDatabaseTestSuite ();
+};
+
+LteGlobalPathlossDatabaseTestSuite::LteGlobalPathlossDatabaseTestSuite ()
+  : TestSuite ("lte-global-pathloss-database", SYSTEM)
+{
+  AddTestCase (new LteGlobalPathlossDatabaseGrowthTestCase (), TestCase::QUICK);
+  AddTestCase (new LteGlobalPathlossDatabaseTestCase (false), TestCase::QUICK);
+  AddTestCase (new LteGlobalPathlossDatabaseTestCase (true), TestCase::QUICK);
+}
+
+static LteGlobalPathlossDatabaseTestSuite g_lteGlobalPathlossDatabaseTestSuite; ///< the test suite
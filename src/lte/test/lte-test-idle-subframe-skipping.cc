@@ -0,0 +1,347 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/boolean.h>
+#include <ns3/string.h>
+#include <ns3/uinteger.h>
+#include <ns3/mobility-helper.h>
+#include <ns3/lte-helper.h>
+#include <ns3/point-to-point-epc-helper.h>
+#include <ns3/internet-stack-helper.h>
+#include <ns3/point-to-point-helper.h>
+#include <ns3/ipv4-address-helper.h>
+#include <ns3/ipv4-static-routing-helper.h>
+#include <ns3/udp-client-server-helper.h>
+#include <ns3/lte-enb-net-device.h>
+#include <ns3/lte-ue-net-device.h>
+#include <ns3/lte-enb-mac.h>
+#include <ns3/lte-enb-phy.h>
+#include <ns3/lte-ue-phy.h>
+#include <ns3/epc-ue-nas.h>
+#include <ns3/lte-enb-phy-sap.h>
+#include <ns3/lte-control-messages.h>
+#include <ns3/lte-vendor-specific-parameters.h>
+#include <vector>
+#include <algorithm>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestIdleSubframeSkipping");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief The PHY SAP user of an eNB MAC, wrapped to record the uplink
+ * feedback of the UEs before forwarding everything to the MAC.
+ */
+class LteIdleSubframeSkippingEnbPhySapUser : public LteEnbPhySapUser
+{
+public:
+  /// A feedback received by the eNB
+  struct Feedback
+  {
+    int64_t time;  ///< the reception time, in ns
+    uint16_t rnti; ///< the RNTI of the UE
+    int type;      ///< the LteControlMessage type, or -1 for a SRS
+
+    /**
+     * \param other the other feedback
+     * \return true if this feedback sorts before the other one
+     */
+    bool operator< (const Feedback &other) const
+    {
+      return time < other.time
+             || (time == other.time && (rnti < other.rnti
+                                        || (rnti == other.rnti && type < other.type)));
+    }
+  };
+
+  /**
+   * Constructor
+   * \param mac the PHY SAP user of the eNB MAC
+   */
+  LteIdleSubframeSkippingEnbPhySapUser (LteEnbPhySapUser *mac)
+    : m_mac (mac)
+  {
+  }
+
+  // inherited from LteEnbPhySapUser
+  virtual void ReceivePhyPdu (Ptr<Packet> p)
+  {
+    m_mac->ReceivePhyPdu (p);
+  }
+  virtual void SubframeIndication (uint32_t frameNo, uint32_t subframeNo)
+  {
+    m_mac->SubframeIndication (frameNo, subframeNo);
+  }
+  virtual void ReceiveLteControlMessage (Ptr<LteControlMessage> msg)
+  {
+    if (msg->GetMessageType () == LteControlMessage::DL_CQI)
+      {
+        Record (DynamicCast<DlCqiLteControlMessage> (msg)->GetDlCqi ().m_rnti, msg->GetMessageType ());
+      }
+    else if (msg->GetMessageType () == LteControlMessage::DL_HARQ)
+      {
+        Record (DynamicCast<DlHarqFeedbackLteControlMessage> (msg)->GetDlHarqFeedback ().m_rnti, msg->GetMessageType ());
+      }
+    m_mac->ReceiveLteControlMessage (msg);
+  }
+  virtual void ReceiveRachPreamble (uint32_t prachId)
+  {
+    m_mac->ReceiveRachPreamble (prachId);
+  }
+  virtual void UlCqiReport (FfMacSchedSapProvider::SchedUlCqiInfoReqParameters ulcqi)
+  {
+    if (ulcqi.m_ulCqi.m_type == UlCqi_s::SRS)
+      {
+        for (std::vector<VendorSpecificListElement_s>::iterator it = ulcqi.m_vendorSpecificList.begin ();
+             it != ulcqi.m_vendorSpecificList.end (); it++)
+          {
+            if (it->m_type == SRS_CQI_RNTI_VSP)
+              {
+                Record (DynamicCast<SrsCqiRntiVsp> (it->m_value)->GetRnti (), -1);
+              }
+          }
+      }
+    m_mac->UlCqiReport (ulcqi);
+  }
+  virtual void UlInfoListElementHarqFeeback (UlInfoListElement_s params)
+  {
+    m_mac->UlInfoListElementHarqFeeback (params);
+  }
+  virtual void DlInfoListElementHarqFeeback (DlInfoListElement_s params)
+  {
+    m_mac->DlInfoListElementHarqFeeback (params);
+  }
+
+  /**
+   * \param rnti the RNTI of the UE
+   * \param type the type of the feedback
+   */
+  void Record (uint16_t rnti, int type)
+  {
+    Feedback f;
+    f.time = Simulator::Now ().GetNanoSeconds ();
+    f.rnti = rnti;
+    f.type = type;
+    m_feedback.push_back (f);
+  }
+
+  LteEnbPhySapUser *m_mac;           ///< the PHY SAP user of the eNB MAC
+  std::vector<Feedback> m_feedback;  ///< the feedback received so far
+};
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case that runs the same cell twice, with the
+ * EnableIdleSubframeSkipping attribute of the UE PHYs off and on, and
+ * checks that the eNB receives the CQIs, the SRSs and the DL HARQ
+ * feedback of the UEs in the same subframes.
+ *
+ * The UEs stay camped on the cell for a while before connecting, and
+ * then exchange sparse downlink and uplink traffic.
+ */
+class LteIdleSubframeSkippingTestCase : public TestCase
+{
+public:
+  LteIdleSubframeSkippingTestCase ();
+  virtual ~LteIdleSubframeSkippingTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Run the scenario
+   * \param skip the value of the EnableIdleSubframeSkipping attribute
+   * \return the feedback received by the eNB
+   */
+  std::vector<LteIdleSubframeSkippingEnbPhySapUser::Feedback> RunScenario (bool skip);
+};
+
+LteIdleSubframeSkippingTestCase::LteIdleSubframeSkippingTestCase ()
+  : TestCase ("Same UE feedback with and without idle subframe skipping")
+{
+}
+
+LteIdleSubframeSkippingTestCase::~LteIdleSubframeSkippingTestCase ()
+{
+}
+
+std::vector<LteIdleSubframeSkippingEnbPhySapUser::Feedback>
+LteIdleSubframeSkippingTestCase::RunScenario (bool skip)
+{
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  Ptr<PointToPointEpcHelper> epcHelper = CreateObject<PointToPointEpcHelper> ();
+  lteHelper->SetEpcHelper (epcHelper);
+  lteHelper->SetAttribute ("PathlossModel", StringValue ("ns3::FriisSpectrumPropagationLossModel"));
+  lteHelper->SetAttribute ("UseIdealRrc", BooleanValue (false));
+
+  NodeContainer enbNodes;
+  enbNodes.Create (1);
+  NodeContainer ueNodes;
+  ueNodes.Create (3);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (100.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (0.0, 300.0, 0.0));
+  positionAlloc->Add (Vector (-800.0, 0.0, 0.0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  for (uint32_t i = 0; i < ueDevs.GetN (); i++)
+    {
+      ueDevs.Get (i)->GetObject<LteUeNetDevice> ()->GetPhy ()
+        ->SetAttribute ("EnableIdleSubframeSkipping", BooleanValue (skip));
+    }
+
+  Ptr<LteEnbNetDevice> enbDev = enbDevs.Get (0)->GetObject<LteEnbNetDevice> ();
+  LteIdleSubframeSkippingEnbPhySapUser sapUser (enbDev->GetMac ()->GetLteEnbPhySapUser ());
+  enbDev->GetPhy ()->SetLteEnbPhySapUser (&sapUser);
+
+  // the remote host
+  Ptr<Node> pgw = epcHelper->GetPgwNode ();
+  NodeContainer remoteHostContainer;
+  remoteHostContainer.Create (1);
+  Ptr<Node> remoteHost = remoteHostContainer.Get (0);
+  InternetStackHelper internet;
+  internet.Install (remoteHostContainer);
+  PointToPointHelper p2ph;
+  p2ph.SetDeviceAttribute ("DataRate", DataRateValue (DataRate ("100Gb/s")));
+  p2ph.SetChannelAttribute ("Delay", TimeValue (MilliSeconds (10)));
+  NetDeviceContainer internetDevices = p2ph.Install (pgw, remoteHost);
+  Ipv4AddressHelper ipv4h;
+  ipv4h.SetBase ("1.0.0.0", "255.0.0.0");
+  Ipv4InterfaceContainer internetIpIfaces = ipv4h.Assign (internetDevices);
+  Ipv4Address remoteHostAddr = internetIpIfaces.GetAddress (1);
+  Ipv4StaticRoutingHelper ipv4RoutingHelper;
+  Ptr<Ipv4StaticRouting> remoteHostStaticRouting = ipv4RoutingHelper.GetStaticRouting (remoteHost->GetObject<Ipv4> ());
+  remoteHostStaticRouting->AddNetworkRouteTo (Ipv4Address ("7.0.0.0"), Ipv4Mask ("255.0.0.0"), 1);
+
+  internet.Install (ueNodes);
+  Ipv4InterfaceContainer ueIpIfaces = epcHelper->AssignUeIpv4Address (ueDevs);
+  for (uint32_t i = 0; i < ueNodes.GetN (); i++)
+    {
+      Ptr<Ipv4StaticRouting> ueStaticRouting = ipv4RoutingHelper.GetStaticRouting (ueNodes.Get (i)->GetObject<Ipv4> ());
+      ueStaticRouting->SetDefaultRoute (epcHelper->GetUeDefaultGatewayAddress (), 1);
+    }
+
+  // the UEs camp on the cell and connect one after the other, so that
+  // they spend some time idle and then wake up for the random access; the
+  // connections start within a subframe, as the order of the events at the
+  // start of a subframe is not the same when the subframe indication of an
+  // idle UE is skipped
+  void (EpcUeNas::*connect) (void) = &EpcUeNas::Connect;
+  for (uint32_t i = 0; i < ueDevs.GetN (); i++)
+    {
+      Ptr<LteUeNetDevice> ueDev = ueDevs.Get (i)->GetObject<LteUeNetDevice> ();
+      ueDev->GetNas ()->StartCellSelection (ueDev->GetDlEarfcn ());
+      Simulator::Schedule (MicroSeconds (100500 + 150000 * i), connect, ueDev->GetNas ());
+      epcHelper->ActivateEpsBearer (ueDev, ueDev->GetImsi (), EpcTft::Default (),
+                                    EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+    }
+
+  // sparse traffic with a different period for each UE
+  ApplicationContainer apps;
+  for (uint32_t i = 0; i < ueNodes.GetN (); i++)
+    {
+      UdpServerHelper dlServer (1000);
+      apps.Add (dlServer.Install (ueNodes.Get (i)));
+      UdpClientHelper dlClient (ueIpIfaces.GetAddress (i), 1000);
+      dlClient.SetAttribute ("Interval", TimeValue (MilliSeconds (37 + 11 * i)));
+      dlClient.SetAttribute ("PacketSize", UintegerValue (200 + 300 * i));
+      apps.Add (dlClient.Install (remoteHost));
+      UdpServerHelper ulServer (2000 + i);
+      apps.Add (ulServer.Install (remoteHost));
+      UdpClientHelper ulClient (remoteHostAddr, 2000 + i);
+      ulClient.SetAttribute ("Interval", TimeValue (MilliSeconds (53 + 7 * i)));
+      ulClient.SetAttribute ("PacketSize", UintegerValue (100 + 400 * i));
+      apps.Add (ulClient.Install (ueNodes.Get (i)));
+    }
+  apps.Start (MilliSeconds (100));
+
+  // same random numbers in both runs
+  int64_t stream = 1;
+  stream += lteHelper->AssignStreams (enbDevs, stream);
+  stream += lteHelper->AssignStreams (ueDevs, stream);
+  stream += internet.AssignStreams (ueNodes, stream);
+  stream += internet.AssignStreams (remoteHostContainer, stream);
+
+  Simulator::Stop (Seconds (1));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return sapUser.m_feedback;
+}
+
+void
+LteIdleSubframeSkippingTestCase::DoRun (void)
+{
+  std::vector<LteIdleSubframeSkippingEnbPhySapUser::Feedback> expected = RunScenario (false);
+  std::vector<LteIdleSubframeSkippingEnbPhySapUser::Feedback> actual = RunScenario (true);
+  // the order of the receptions within a subframe does not matter
+  std::sort (expected.begin (), expected.end ());
+  std::sort (actual.begin (), actual.end ());
+
+  uint32_t counts[3] = { 0, 0, 0 };
+  for (uint32_t i = 0; i < expected.size (); i++)
+    {
+      counts[expected[i].type == -1 ? 0 : (expected[i].type == LteControlMessage::DL_CQI ? 1 : 2)]++;
+    }
+  NS_LOG_INFO (counts[0] << " SRS, " << counts[1] << " CQI, " << counts[2] << " DL HARQ feedback");
+  NS_TEST_ASSERT_MSG_GT (counts[0], 0, "no SRS received");
+  NS_TEST_ASSERT_MSG_GT (counts[1], 0, "no CQI received");
+  NS_TEST_ASSERT_MSG_GT (counts[2], 0, "no DL HARQ feedback received");
+
+  NS_TEST_ASSERT_MSG_EQ (actual.size (), expected.size (), "different number of feedback");
+  for (uint32_t i = 0; i < expected.size () && i < actual.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (actual[i].time, expected[i].time, "feedback " << i << " received at another time");
+      NS_TEST_ASSERT_MSG_EQ (actual[i].rnti, expected[i].rnti, "feedback " << i << " from another UE");
+      NS_TEST_ASSERT_MSG_EQ (actual[i].type, expected[i].type, "feedback " << i << " of another type");
+    }
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of the idle subframe skipping of the UE PHY
+ */
+class LteIdleSubframeSkippingTestSuite : public TestSuite
+{
+public:
+  LteIdleSubframeSkippingTestSuite ();
+};
+
+LteIdleSubframeSkippingTestSuite::LteIdleSubframeSkippingTestSuite ()
+  : TestSuite ("lte-idle-subframe-skipping", SYSTEM)
+{
+  AddTestCase (new LteIdleSubframeSkippingTestCase (), TestCase::QUICK);
+}
+
+static LteIdleSubframeSkippingTestSuite g_lteIdleSubframeSkippingTestSuite; ///< the test suite
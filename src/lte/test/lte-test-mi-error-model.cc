@@ -0,0 +1,202 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/spectrum-model.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/lte-mi-error-model.h"
+#include <cmath>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestMiErrorModel");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case that checks the sampled BLER curves against the
+ * BLER curves evaluated at every MI, for all the ECRs and CB sizes.
+ */
+class LteMiBlerTableTestCase : public TestCase
+{
+public:
+  LteMiBlerTableTestCase ();
+  virtual ~LteMiBlerTableTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteMiBlerTableTestCase::LteMiBlerTableTestCase ()
+  : TestCase ("Sampled BLER curves")
+{
+}
+
+LteMiBlerTableTestCase::~LteMiBlerTableTestCase ()
+{
+}
+
+void
+LteMiBlerTableTestCase::DoRun (void)
+{
+  // the CB sizes of the curves, and some sizes in between
+  const uint16_t cbSizes[] = { 40, 72, 104, 160, 256, 400, 512, 1024, 2048,
+                               2560, 4032, 5000, 6144 };
+  double maxError = 0;
+  for (uint8_t ecrId = 0; ecrId <= MI_64QAM_BLER_MAX_ID; ecrId++)
+    {
+      for (uint32_t k = 0; k < sizeof (cbSizes) / sizeof (cbSizes[0]); k++)
+        {
+          // MIs which do not fall on the samples
+          for (uint32_t i = 0; i <= 10000; i++)
+            {
+              double mib = i / 10000.0 + 1e-6 * (i % 7);
+              double bler = LteMiErrorModel::MappingMiBler (mib, ecrId, cbSizes[k]);
+              double expected = LteMiErrorModel::EvaluateMiBler (mib, ecrId, cbSizes[k]);
+              maxError = std::max (maxError, std::fabs (bler - expected));
+              NS_TEST_ASSERT_MSG_EQ_TOL (bler, expected, 1e-4,
+                                         "Wrong BLER for ECR " << (uint16_t) ecrId
+                                         << " CB size " << cbSizes[k] << " MI " << mib);
+            }
+        }
+    }
+  NS_LOG_INFO ("Maximum error " << maxError);
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case that checks the MI and the BLER of TBs against the
+ * values of the error model which evaluated the BLER curves for every
+ * code block.
+ */
+class LteMiTbStatsTestCase : public TestCase
+{
+public:
+  LteMiTbStatsTestCase ();
+  virtual ~LteMiTbStatsTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteMiTbStatsTestCase::LteMiTbStatsTestCase ()
+  : TestCase ("TB decodification stats")
+{
+}
+
+LteMiTbStatsTestCase::~LteMiTbStatsTestCase ()
+{
+}
+
+/// The stats of a TB, with the SINR it was received with
+struct MiTbStatsVector
+{
+  uint8_t mcs;     ///< the MCS
+  double sinrDb;   ///< the SINR of the first RB, in dB
+  uint16_t size;   ///< the TB size, in bytes
+  uint16_t rbs;    ///< the number of RBs
+  double mi;       ///< the expected MI
+  double tbler;    ///< the expected TB error rate
+};
+
+void
+LteMiTbStatsTestCase::DoRun (void)
+{
+  const MiTbStatsVector vectors[] = {
+    { 0, -8, 20, 25, 0.12871628000000002, 0.66484210705235258 },
+    { 0, -8.25, 400, 50, 0.12365784000000003, 0.26126186364263571 },
+    { 0, -8.25, 2000, 75, 0.12355180000000007, 0.47816828740182382 },
+    { 5, -3, 20, 25, 0.34061400000000008, 0.56376317946718491 },
+    { 5, -3.5, 400, 50, 0.31433045999999992, 0.55981449116993753 },
+    { 5, -3.25, 2000, 75, 0.32883226666666665, 0.087579297585240301 },
+    { 9, 0.75, 20, 25, 0.60911411999999998, 0.48614746478872495 },
+    { 9, 0.5, 400, 50, 0.59368291999999978, 0.39358251230883889 },
+    { 9, 0.5, 2000, 75, 0.59350846666666679, 0.66899429689778289 },
+    { 10, 2.5, 20, 25, 0.37924828000000005, 0.4812787089482583 },
+    { 10, 2.25, 400, 50, 0.36926057999999989, 0.66948238917339364 },
+    { 10, 2.75, 2000, 75, 0.39510349333333311, 0.43247251600888215 },
+    { 13, 4.75, 20, 25, 0.50258040000000004, 0.4144209020135764 },
+    { 13, 4.5, 400, 50, 0.49145092000000007, 0.26676081742028196 },
+    { 13, 4.5, 2000, 75, 0.49132381333333353, 0.68476705598505694 },
+    { 16, 7.5, 20, 25, 0.66535087999999998, 0.42718032416460627 },
+    { 16, 7.25, 400, 50, 0.65347093999999983, 0.5643887629899188 },
+    { 16, 7.5, 2000, 75, 0.66848591999999984, 0.12379007823244137 },
+    { 17, 9, 20, 25, 0.51011931999999993, 0.41657024813751303 },
+    { 17, 8.75, 400, 50, 0.50064324000000004, 0.48476587105396207 },
+    { 17, 9, 2000, 75, 0.5123976800000003, 0.32460442311306192 },
+    { 22, 13.25, 20, 25, 0.70772604000000006, 0.44056932669578003 },
+    { 22, 13, 400, 50, 0.69794873999999973, 0.50928048108858037 },
+    { 22, 13, 2000, 75, 0.69784328000000007, 0.88325127554894989 },
+    { 28, 18.75, 20, 25, 0.94055759999999977, 0.33348657434155893 },
+    { 28, 18.5, 400, 50, 0.93512731999999976, 0.58260045642248581 },
+    { 28, 18.75, 2000, 75, 0.94191468000000023, 0.34032726899356913 },
+    { 28, 30, 2000, 75, 1, 0 }
+  };
+
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      freqs.push_back (2.12e9 + i * 180e3);
+    }
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (freqs);
+
+  for (uint32_t k = 0; k < sizeof (vectors) / sizeof (vectors[0]); k++)
+    {
+      const MiTbStatsVector &v = vectors[k];
+      SpectrumValue sinr (model);
+      for (uint32_t i = 0; i < 100; i++)
+        {
+          sinr[i] = std::pow (10.0, (v.sinrDb + 0.3 * (i % 7)) / 10.0);
+        }
+      std::vector<int> map;
+      for (int i = 7; i < 7 + v.rbs; i++)
+        {
+          map.push_back (i);
+        }
+      HarqProcessInfoList_t history;
+      TbStats_t stats = LteMiErrorModel::GetTbDecodificationStats (sinr, map, v.size, v.mcs, history);
+      NS_TEST_ASSERT_MSG_EQ_TOL (stats.mi, v.mi, 1e-12, "Wrong MI for MCS " << (uint16_t) v.mcs);
+      NS_TEST_ASSERT_MSG_EQ_TOL (stats.tbler, v.tbler, 1e-3, "Wrong TB error rate for MCS " << (uint16_t) v.mcs);
+    }
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of the MI error model.
+ */
+class LteMiErrorModelTestSuite : public TestSuite
+{
+public:
+  LteMiErrorModelTestSuite ();
+};
+
+LteMiErrorModelTestSuite::LteMiErrorModelTestSuite ()
+  : TestSuite ("lte-mi-error-model", UNIT)
+{
+  AddTestCase (new LteMiBlerTableTestCase, TestCase::QUICK);
+  AddTestCase (new LteMiTbStatsTestCase, TestCase::QUICK);
+}
+
+static LteMiErrorModelTestSuite g_lteMiErrorModelTestSuite; ///< the test suite
@@ -0,0 +1,167 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/position-kd-tree.h"
+#include <limits>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestPositionKdTree");
+
+/**
+ * \param positions the positions
+ * \param position the position to search around
+ * \return the index of the first position at the smallest distance
+ */
+static uint32_t
+FindClosestLinear (const std::vector<Vector> &positions, const Vector &position)
+{
+  double minDistance = std::numeric_limits<double>::infinity ();
+  uint32_t closest = 0;
+  for (uint32_t i = 0; i < positions.size (); i++)
+    {
+      double distance = CalculateDistance (position, positions[i]);
+      if (distance < minDistance)
+        {
+          minDistance = distance;
+          closest = i;
+        }
+    }
+  return closest;
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case that searches the closest position in a PositionKdTree
+ * and with a linear search, and checks that they find the same one.
+ */
+class LtePositionKdTreeTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param grid if true, the positions are on a grid with duplicates, and
+   * the searched positions are on the grid and between its points, so that
+   * most searches have ties; otherwise they are uniformly distributed
+   */
+  LtePositionKdTreeTestCase (bool grid);
+  virtual ~LtePositionKdTreeTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Search positions in a tree of positions
+   * \param positions the positions of the tree
+   * \param searched the searched positions
+   */
+  void Check (const std::vector<Vector> &positions, const std::vector<Vector> &searched);
+
+  bool m_grid; ///< whether the positions are on a grid
+};
+
+LtePositionKdTreeTestCase::LtePositionKdTreeTestCase (bool grid)
+  : TestCase (grid ? "PositionKdTree on a grid" : "PositionKdTree on random positions"),
+    m_grid (grid)
+{
+}
+
+LtePositionKdTreeTestCase::~LtePositionKdTreeTestCase ()
+{
+}
+
+void
+LtePositionKdTreeTestCase::Check (const std::vector<Vector> &positions, const std::vector<Vector> &searched)
+{
+  PositionKdTree tree;
+  tree.Build (positions);
+  NS_TEST_ASSERT_MSG_EQ (tree.GetN (), positions.size (), "wrong number of positions");
+  for (uint32_t i = 0; i < searched.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (tree.FindClosest (searched[i]), FindClosestLinear (positions, searched[i]),
+                             "different closest position of " << searched[i]
+                             << " among " << positions.size ());
+    }
+}
+
+void
+LtePositionKdTreeTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> rv = CreateObject<UniformRandomVariable> ();
+  rv->SetStream (1);
+
+  const uint32_t sizes[] = { 1, 2, 3, 7, 64, 500 };
+  for (uint32_t s = 0; s < 6; s++)
+    {
+      std::vector<Vector> positions;
+      std::vector<Vector> searched;
+      if (m_grid)
+        {
+          // 10 m grid, each point repeated up to 3 times, in random order
+          for (uint32_t i = 0; i < sizes[s]; i++)
+            {
+              uint32_t point = rv->GetInteger (0, sizes[s] / 3 + 1);
+              positions.push_back (Vector (10.0 * (point % 5), 10.0 * (point / 5), 0.0));
+            }
+          for (uint32_t x = 0; x < 12; x++)
+            {
+              for (uint32_t y = 0; y < 2 * sizes[s] / 15 + 4; y++)
+                {
+                  searched.push_back (Vector (5.0 * x - 5.0, 5.0 * y - 5.0, 0.0));
+                }
+            }
+        }
+      else
+        {
+          // eNBs at 30 m of height in a 5 km wide area, UEs on the ground
+          for (uint32_t i = 0; i < sizes[s]; i++)
+            {
+              positions.push_back (Vector (rv->GetValue (0, 5000), rv->GetValue (0, 5000), 30.0));
+            }
+          for (uint32_t i = 0; i < 1000; i++)
+            {
+              searched.push_back (Vector (rv->GetValue (-500, 5500), rv->GetValue (-500, 5500), 1.5));
+            }
+        }
+      Check (positions, searched);
+    }
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of the k-d tree used to attach the UEs to the closest eNB.
+ */
+class LtePositionKdTreeTestSuite : public TestSuite
+{
+public:
+  LtePositionKdTreeTestSuite ();
+};
+
+LtePositionKdTreeTestSuite::LtePositionKdTreeTestSuite ()
+  : TestSuite ("lte-position-kd-tree", UNIT)
+{
+  AddTestCase (new LtePositionKdTreeTestCase (false), TestCase::QUICK);
+  AddTestCase (new LtePositionKdTreeTestCase (true), TestCase::QUICK);
+}
+
+static LtePositionKdTreeTestSuite g_ltePositionKdTreeTestSuite; ///< the test suite
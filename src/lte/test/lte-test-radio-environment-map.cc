@@ -0,0 +1,258 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/integer.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/position-allocator.h"
+#include "ns3/lte-helper.h"
+#include "ns3/spectrum-channel.h"
+#include "ns3/eps-bearer.h"
+#include "ns3/radio-environment-map-helper.h"
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <cmath>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestRadioEnvironmentMap");
+
+/**
+ * \param filename the REM file
+ * \param binary whether it was written with the BinaryOutput attribute
+ * \return the values of the points of the REM: x, y, z and SINR of each
+ */
+static std::vector<double>
+ReadRem (std::string filename, bool binary)
+{
+  std::vector<double> values;
+  std::ifstream file (filename.c_str (), binary ? std::ios_base::binary : std::ios_base::in);
+  double value;
+  if (binary)
+    {
+      while (file.read (reinterpret_cast<char *> (&value), sizeof (value)))
+        {
+          values.push_back (value);
+        }
+    }
+  else
+    {
+      while (file >> value)
+        {
+          values.push_back (value);
+        }
+    }
+  return values;
+}
+
+/**
+ * \param useDataChannel the `UseDataChannel` attribute of the REMs
+ * \param rbId the `RbId` attribute of the REMs
+ * \param antenna the antenna model of the eNBs
+ * \return the name of the test case
+ */
+static std::string
+BuildNameString (bool useDataChannel, int32_t rbId, std::string antenna)
+{
+  std::ostringstream oss;
+  oss << "REM of the " << (useDataChannel ? "data" : "control") << " channel with "
+      << antenna << ", RB " << rbId;
+  return oss.str ();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case that generates the same REM with the listeners and with
+ * the direct computation, in text and in binary, with one and several
+ * threads, and checks that they are the same.
+ */
+class LteRadioEnvironmentMapTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param useDataChannel the `UseDataChannel` attribute of the REMs
+   * \param rbId the `RbId` attribute of the REMs
+   * \param antenna the antenna model of the eNBs
+   */
+  LteRadioEnvironmentMapTestCase (bool useDataChannel, int32_t rbId, std::string antenna);
+  virtual ~LteRadioEnvironmentMapTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Create a REM of the downlink channel
+   * \param channelPath the path of the downlink channel
+   * \param filename the output file of the REM
+   * \param computeDirectly the `ComputeDirectly` attribute
+   * \param numThreads the `NumThreads` attribute
+   * \param binaryOutput the `BinaryOutput` attribute
+   * \return the REM helper
+   */
+  Ptr<RadioEnvironmentMapHelper> CreateRem (std::string channelPath, std::string filename,
+                                            bool computeDirectly, uint32_t numThreads,
+                                            bool binaryOutput);
+
+  bool m_useDataChannel; ///< the `UseDataChannel` attribute of the REMs
+  int32_t m_rbId;        ///< the `RbId` attribute of the REMs
+  std::string m_antenna; ///< the antenna model of the eNBs
+};
+
+LteRadioEnvironmentMapTestCase::LteRadioEnvironmentMapTestCase (bool useDataChannel, int32_t rbId, std::string antenna)
+  : TestCase (BuildNameString (useDataChannel, rbId, antenna)),
+    m_useDataChannel (useDataChannel),
+    m_rbId (rbId),
+    m_antenna (antenna)
+{
+}
+
+LteRadioEnvironmentMapTestCase::~LteRadioEnvironmentMapTestCase ()
+{
+}
+
+Ptr<RadioEnvironmentMapHelper>
+LteRadioEnvironmentMapTestCase::CreateRem (std::string channelPath, std::string filename,
+                                           bool computeDirectly, uint32_t numThreads,
+                                           bool binaryOutput)
+{
+  Ptr<RadioEnvironmentMapHelper> remHelper = CreateObject<RadioEnvironmentMapHelper> ();
+  remHelper->SetAttribute ("ChannelPath", StringValue (channelPath));
+  remHelper->SetAttribute ("OutputFile", StringValue (filename));
+  remHelper->SetAttribute ("XMin", DoubleValue (-300.0));
+  remHelper->SetAttribute ("XMax", DoubleValue (700.0));
+  remHelper->SetAttribute ("XRes", UintegerValue (13));
+  remHelper->SetAttribute ("YMin", DoubleValue (-200.0));
+  remHelper->SetAttribute ("YMax", DoubleValue (300.0));
+  remHelper->SetAttribute ("YRes", UintegerValue (9));
+  remHelper->SetAttribute ("Z", DoubleValue (1.5));
+  remHelper->SetAttribute ("StopWhenDone", BooleanValue (false));
+  remHelper->SetAttribute ("UseDataChannel", BooleanValue (m_useDataChannel));
+  remHelper->SetAttribute ("RbId", IntegerValue (m_rbId));
+  remHelper->SetAttribute ("ComputeDirectly", BooleanValue (computeDirectly));
+  remHelper->SetAttribute ("NumThreads", UintegerValue (numThreads));
+  remHelper->SetAttribute ("BinaryOutput", BooleanValue (binaryOutput));
+  if (computeDirectly)
+    {
+      // several parts, the last one incomplete
+      remHelper->SetAttribute ("MaxPointsPerIteration", UintegerValue (10));
+    }
+  remHelper->Install ();
+  return remHelper;
+}
+
+void
+LteRadioEnvironmentMapTestCase::DoRun (void)
+{
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetEnbAntennaModelType (m_antenna);
+
+  NodeContainer enbNodes;
+  enbNodes.Create (3);
+  NodeContainer ueNodes;
+  ueNodes.Create (3);
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 30.0));
+  positionAlloc->Add (Vector (400.0, 0.0, 30.0));
+  positionAlloc->Add (Vector (200.0, 150.0, 30.0));
+  positionAlloc->Add (Vector (20.0, 10.0, 1.5));
+  positionAlloc->Add (Vector (380.0, -10.0, 1.5));
+  positionAlloc->Add (Vector (200.0, 120.0, 1.5));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  for (uint32_t i = 0; i < ueDevs.GetN (); i++)
+    {
+      lteHelper->Attach (ueDevs.Get (i), enbDevs.Get (i));
+    }
+  // saturation traffic, so that the data channel is used
+  lteHelper->ActivateDataRadioBearer (ueDevs, EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+
+  std::ostringstream channelPath;
+  channelPath << "/ChannelList/" << lteHelper->GetDownlinkSpectrumChannel ()->GetId ();
+  std::string listenersFile = CreateTempDirFilename ("rem-listeners.out");
+  std::string directFile = CreateTempDirFilename ("rem-direct.out");
+  std::string binaryFile = CreateTempDirFilename ("rem-direct-binary.out");
+  std::string threadsFile = CreateTempDirFilename ("rem-direct-threads.out");
+  // the helpers must live until the REMs are generated
+  Ptr<RadioEnvironmentMapHelper> listenersRem = CreateRem (channelPath.str (), listenersFile, false, 1, false);
+  Ptr<RadioEnvironmentMapHelper> directRem = CreateRem (channelPath.str (), directFile, true, 1, false);
+  Ptr<RadioEnvironmentMapHelper> binaryRem = CreateRem (channelPath.str (), binaryFile, true, 1, true);
+  Ptr<RadioEnvironmentMapHelper> threadsRem = CreateRem (channelPath.str (), threadsFile, true, 3, true);
+
+  Simulator::Stop (Seconds (m_useDataChannel ? 0.51 : 0.01));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::vector<double> listeners = ReadRem (listenersFile, false);
+  std::vector<double> direct = ReadRem (directFile, false);
+  std::vector<double> binary = ReadRem (binaryFile, true);
+  std::vector<double> threads = ReadRem (threadsFile, true);
+
+  NS_TEST_ASSERT_MSG_EQ (listeners.size (), 13 * 9 * 4, "wrong size of the REM of the listeners");
+  NS_TEST_ASSERT_MSG_EQ (direct.size (), listeners.size (), "wrong size of the direct REM");
+  NS_TEST_ASSERT_MSG_EQ (binary.size (), listeners.size (), "wrong size of the binary REM");
+  NS_TEST_ASSERT_MSG_EQ (threads.size (), listeners.size (), "wrong size of the REM of the threads");
+  double maxSinr = 0;
+  for (uint32_t i = 0; i < listeners.size (); i++)
+    {
+      // the text output has 6 significant digits
+      double tol = 1e-5 * std::fabs (listeners[i]);
+      NS_TEST_ASSERT_MSG_EQ_TOL (direct[i], listeners[i], tol, "different direct REM at value " << i);
+      NS_TEST_ASSERT_MSG_EQ_TOL (binary[i], listeners[i], tol, "different binary REM at value " << i);
+      NS_TEST_ASSERT_MSG_EQ (threads[i], binary[i], "different REM of the threads at value " << i);
+      if (i % 4 == 3)
+        {
+          maxSinr = std::max (maxSinr, listeners[i]);
+        }
+    }
+  NS_TEST_ASSERT_MSG_GT (maxSinr, 1.0, "no signal received");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of the direct computation of the REM.
+ */
+class LteRadioEnvironmentMapTestSuite : public TestSuite
+{
+public:
+  LteRadioEnvironmentMapTestSuite ();
+};
+
+LteRadioEnvironmentMapTestSuite::LteRadioEnvironmentMapTestSuite ()
+  : TestSuite ("lte-radio-environment-map", SYSTEM)
+{
+  AddTestCase (new LteRadioEnvironmentMapTestCase (false, -1, "ns3::IsotropicAntennaModel"), TestCase::QUICK);
+  AddTestCase (new LteRadioEnvironmentMapTestCase (false, 3, "ns3::CosineAntennaModel"), TestCase::QUICK);
+  AddTestCase (new LteRadioEnvironmentMapTestCase (true, -1, "ns3::IsotropicAntennaModel"), TestCase::QUICK);
+}
+
+static LteRadioEnvironmentMapTestSuite g_lteRadioEnvironmentMapTestSuite; ///< the test suite
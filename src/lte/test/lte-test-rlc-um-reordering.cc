@@ -0,0 +1,193 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/lte-rlc-um.h"
+#include "ns3/lte-rlc-sap.h"
+#include "ns3/lte-mac-sap.h"
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestRlcUmReordering");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief MAC SAP of a RLC entity, which keeps the transmitted PDUs.
+ */
+class LteRlcUmReorderingTestMac : public LteMacSapProvider
+{
+public:
+  // inherited from LteMacSapProvider
+  virtual void TransmitPdu (TransmitPduParameters params)
+  {
+    m_pdus.push_back (params.pdu);
+  }
+
+  // inherited from LteMacSapProvider
+  virtual void ReportBufferStatus (ReportBufferStatusParameters params)
+  {
+  }
+
+  std::vector<Ptr<Packet> > m_pdus; ///< the transmitted PDUs, in SN order
+};
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief RLC SAP of a RLC entity, which keeps the index carried by each
+ * delivered SDU.
+ */
+class LteRlcUmReorderingTestSink : public LteRlcSapUser
+{
+public:
+  // inherited from LteRlcSapUser
+  virtual void ReceivePdcpPdu (Ptr<Packet> p)
+  {
+    uint32_t index;
+    p->CopyData ((uint8_t *) &index, sizeof (index));
+    m_indexes.push_back (index);
+  }
+
+  std::vector<uint32_t> m_indexes; ///< the indexes of the delivered SDUs
+};
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case that delivers the PDUs of a RLC UM entity to a peer
+ * entity with a missing SN just before the wrap-around of the SNs, then
+ * a PDU outside of the reordering window, and checks that the PDUs
+ * pushed out of the window are delivered in SN order across the
+ * wrap-around.
+ */
+class LteRlcUmReorderingWrapAroundTestCase : public TestCase
+{
+public:
+  LteRlcUmReorderingWrapAroundTestCase ();
+  virtual ~LteRlcUmReorderingWrapAroundTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteRlcUmReorderingWrapAroundTestCase::LteRlcUmReorderingWrapAroundTestCase ()
+  : TestCase ("Out-of-window PDU after a SN wrap-around")
+{
+}
+
+LteRlcUmReorderingWrapAroundTestCase::~LteRlcUmReorderingWrapAroundTestCase ()
+{
+}
+
+void
+LteRlcUmReorderingWrapAroundTestCase::DoRun (void)
+{
+  uint16_t rnti = 1;
+  uint8_t lcid = 3;
+
+  // the transmitter sends one SDU per PDU, the SDU carrying the index
+  // of the PDU, whose SN is thus the index modulo 1024
+  Ptr<LteRlcUm> tx = CreateObject<LteRlcUm> ();
+  LteRlcUmReorderingTestMac txMac;
+  LteRlcUmReorderingTestSink txSink;
+  tx->SetRnti (rnti);
+  tx->SetLcId (lcid);
+  tx->SetLteRlcSapUser (&txSink);
+  tx->SetLteMacSapProvider (&txMac);
+  const uint32_t numPdus = 1540;
+  for (uint32_t index = 0; index < numPdus; index++)
+    {
+      LteRlcSapProvider::TransmitPdcpPduParameters params;
+      params.pdcpPdu = Create<Packet> ((uint8_t *) &index, sizeof (index));
+      params.rnti = rnti;
+      params.lcid = lcid;
+      tx->GetLteRlcSapProvider ()->TransmitPdcpPdu (params);
+      // a 2 bytes header and the SDU
+      tx->GetLteMacSapUser ()->NotifyTxOpportunity (2 + sizeof (index), 0, 0, 0, rnti, lcid);
+    }
+  NS_TEST_ASSERT_MSG_EQ (txMac.m_pdus.size (), numPdus, "Wrong number of PDUs");
+
+  Ptr<LteRlcUm> rx = CreateObject<LteRlcUm> ();
+  LteRlcUmReorderingTestMac rxMac;
+  LteRlcUmReorderingTestSink rxSink;
+  rx->SetRnti (rnti);
+  rx->SetLcId (lcid);
+  rx->SetLteRlcSapUser (&rxSink);
+  rx->SetLteMacSapProvider (&rxMac);
+  std::vector<uint32_t> expected;
+
+  // SN 0 to 998 are received in order and delivered right away; SN 999
+  // is lost
+  for (uint32_t index = 0; index < 999; index++)
+    {
+      rx->GetLteMacSapUser ()->ReceivePdu (txMac.m_pdus[index], rnti, lcid);
+      expected.push_back (index);
+    }
+  NS_TEST_ASSERT_MSG_EQ (rxSink.m_indexes.size (), expected.size (), "Wrong number of SDUs before the missing SN");
+
+  // SN 1000 to 1023, then 0 to 5 after the wrap-around, wait for SN 999
+  for (uint32_t index = 1000; index < 1030; index++)
+    {
+      rx->GetLteMacSapUser ()->ReceivePdu (txMac.m_pdus[index], rnti, lcid);
+    }
+  NS_TEST_ASSERT_MSG_EQ (rxSink.m_indexes.size (), expected.size (), "SDUs delivered before the missing SN");
+
+  // SN 515 moves the reordering window to [4, 516): SN 1000 to 1023 and
+  // 0 to 3 are now outside of it and must be delivered, then SN 4 and 5
+  // which follow the new VR(UR)
+  rx->GetLteMacSapUser ()->ReceivePdu (txMac.m_pdus[1539], rnti, lcid);
+  for (uint32_t index = 1000; index < 1030; index++)
+    {
+      expected.push_back (index);
+    }
+  NS_TEST_ASSERT_MSG_EQ (rxSink.m_indexes.size (), expected.size (), "Wrong number of SDUs delivered");
+  for (uint32_t i = 0; i < expected.size () && i < rxSink.m_indexes.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (rxSink.m_indexes[i], expected[i], "Wrong SDU delivered at position " << i);
+    }
+
+  tx->Dispose ();
+  rx->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of the reordering of the RLC UM receiver.
+ */
+class LteRlcUmReorderingTestSuite : public TestSuite
+{
+public:
+  LteRlcUmReorderingTestSuite ();
+};
+
+LteRlcUmReorderingTestSuite::LteRlcUmReorderingTestSuite ()
+  : TestSuite ("lte-rlc-um-reordering", UNIT)
+{
+  AddTestCase (new LteRlcUmReorderingWrapAroundTestCase, TestCase::QUICK);
+}
+
+static LteRlcUmReorderingTestSuite g_lteRlcUmReorderingTestSuite; ///< the test suite
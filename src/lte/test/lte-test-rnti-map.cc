@@ -0,0 +1,208 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rnti-map.h"
+#include <map>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestRntiMap");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case that applies random insertions, lookups and
+ * removals to a RntiMap and to a std::map, and checks that they hold
+ * the same elements in the same order.
+ */
+class LteRntiMapTestCase : public TestCase
+{
+public:
+  LteRntiMapTestCase ();
+  virtual ~LteRntiMapTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Check that both containers hold the same elements, in the same order.
+   * \param map the RntiMap
+   * \param ref the std::map
+   */
+  void Compare (const RntiMap<std::vector<uint16_t> > &map,
+                const std::map<uint16_t, std::vector<uint16_t> > &ref);
+};
+
+LteRntiMapTestCase::LteRntiMapTestCase ()
+  : TestCase ("RntiMap against std::map")
+{
+}
+
+LteRntiMapTestCase::~LteRntiMapTestCase ()
+{
+}
+
+void
+LteRntiMapTestCase::Compare (const RntiMap<std::vector<uint16_t> > &map,
+                             const std::map<uint16_t, std::vector<uint16_t> > &ref)
+{
+  NS_TEST_ASSERT_MSG_EQ (map.size (), ref.size (), "Wrong size");
+  NS_TEST_ASSERT_MSG_EQ (map.empty (), ref.empty (), "Wrong emptiness");
+  RntiMap<std::vector<uint16_t> >::const_iterator it = map.begin ();
+  std::map<uint16_t, std::vector<uint16_t> >::const_iterator itRef = ref.begin ();
+  for (; itRef != ref.end (); itRef++, it++)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((it != map.end ()), true, "Missing RNTI " << itRef->first);
+      NS_TEST_ASSERT_MSG_EQ (it->first, itRef->first, "Wrong order");
+      NS_TEST_ASSERT_MSG_EQ (((*it).second == itRef->second), true, "Wrong value of RNTI " << itRef->first);
+    }
+  NS_TEST_ASSERT_MSG_EQ ((it == map.end ()), true, "Extra RNTI " << it->first);
+}
+
+void
+LteRntiMapTestCase::DoRun (void)
+{
+  RntiMap<std::vector<uint16_t> > map;
+  std::map<uint16_t, std::vector<uint16_t> > ref;
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable> ();
+  rand->SetStream (1);
+
+  Compare (map, ref);
+  NS_TEST_ASSERT_MSG_EQ ((map.find (1) == map.end ()), true, "Found RNTI in an empty map");
+
+  // RNTIs are allocated in increasing order, but some are released
+  // early and some stay: the map becomes sparse over time
+  uint16_t nextRnti = 1;
+  for (uint32_t step = 0; step < 5000; step++)
+    {
+      uint32_t op = rand->GetInteger (0, 9);
+      uint16_t rnti = static_cast<uint16_t> (rand->GetInteger (0, nextRnti - 1));
+      if (op < 3)
+        {
+          std::vector<uint16_t> value (1 + rnti % 4, rnti);
+          std::pair<RntiMap<std::vector<uint16_t> >::iterator, bool> ret =
+            map.insert (std::pair<uint16_t, std::vector<uint16_t> > (nextRnti, value));
+          ref.insert (std::pair<uint16_t, std::vector<uint16_t> > (nextRnti, value));
+          NS_TEST_ASSERT_MSG_EQ (ret.second, true, "RNTI " << nextRnti << " not inserted");
+          NS_TEST_ASSERT_MSG_EQ (ret.first->first, nextRnti, "Wrong inserted RNTI");
+          ret = map.insert (std::pair<uint16_t, std::vector<uint16_t> > (nextRnti, std::vector<uint16_t> ()));
+          NS_TEST_ASSERT_MSG_EQ (ret.second, false, "RNTI " << nextRnti << " inserted twice");
+          nextRnti++;
+        }
+      else if (op < 5)
+        {
+          NS_TEST_ASSERT_MSG_EQ (map.erase (rnti), ref.erase (rnti), "Wrong erase of RNTI " << rnti);
+        }
+      else if (op < 7)
+        {
+          map[rnti].push_back (step);
+          ref[rnti].push_back (step);
+        }
+      else if (op < 8)
+        {
+          // remove while iterating, as the schedulers refresh their timers
+          RntiMap<std::vector<uint16_t> >::iterator it = map.begin ();
+          while (it != map.end ())
+            {
+              if ((*it).second.size () > 4)
+                {
+                  RntiMap<std::vector<uint16_t> >::iterator temp = it;
+                  it++;
+                  map.erase (temp);
+                }
+              else
+                {
+                  it++;
+                }
+            }
+          std::map<uint16_t, std::vector<uint16_t> >::iterator itRef = ref.begin ();
+          while (itRef != ref.end ())
+            {
+              if ((*itRef).second.size () > 4)
+                {
+                  ref.erase (itRef++);
+                }
+              else
+                {
+                  itRef++;
+                }
+            }
+        }
+      else
+        {
+          RntiMap<std::vector<uint16_t> >::iterator it = map.find (rnti);
+          NS_TEST_ASSERT_MSG_EQ (map.count (rnti), ref.count (rnti), "Wrong count of RNTI " << rnti);
+          NS_TEST_ASSERT_MSG_EQ ((it != map.end ()), (ref.find (rnti) != ref.end ()), "Wrong find of RNTI " << rnti);
+          if (it != map.end ())
+            {
+              // an iterator returned by find walks the next elements
+              std::map<uint16_t, std::vector<uint16_t> >::iterator itRef = ref.find (rnti);
+              it++;
+              itRef++;
+              NS_TEST_ASSERT_MSG_EQ ((it == map.end ()), (itRef == ref.end ()), "Wrong end after RNTI " << rnti);
+              if (it != map.end ())
+                {
+                  NS_TEST_ASSERT_MSG_EQ (it->first, itRef->first, "Wrong RNTI after RNTI " << rnti);
+                }
+            }
+        }
+      Compare (map, ref);
+    }
+
+  // the lowest and highest RNTIs, in pages of their own
+  uint16_t extremes[2] = { 0, 65535 };
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      map[extremes[i]].push_back (i);
+      ref[extremes[i]].push_back (i);
+      Compare (map, ref);
+    }
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (map.erase (extremes[i]), 1, "Wrong erase of RNTI " << extremes[i]);
+      ref.erase (extremes[i]);
+      NS_TEST_ASSERT_MSG_EQ (map.count (extremes[i]), 0, "RNTI " << extremes[i] << " still found");
+      Compare (map, ref);
+    }
+
+  map.clear ();
+  ref.clear ();
+  Compare (map, ref);
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of the RntiMap per-UE state table.
+ */
+class LteRntiMapTestSuite : public TestSuite
+{
+public:
+  LteRntiMapTestSuite ();
+};
+
+LteRntiMapTestSuite::LteRntiMapTestSuite ()
+  : TestSuite ("lte-rnti-map", UNIT)
+{
+  AddTestCase (new LteRntiMapTestCase, TestCase::QUICK);
+}
+
+static LteRntiMapTestSuite g_lteRntiMapTestSuite; ///< the test suite
@@ -0,0 +1,179 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/mac-stats-calculator.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestStatsCalculator");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case that checks the rows written by the MAC stats
+ * calculator, one per record or one per aggregation epoch, once the
+ * simulation is destroyed.
+ */
+class LteStatsCalculatorTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param epoch the aggregation epoch, or zero
+   */
+  LteStatsCalculatorTestCase (Time epoch);
+  virtual ~LteStatsCalculatorTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Report the UL allocations of a subframe
+   *
+   * \param macStats the MAC stats calculator
+   * \param i the index of the subframe
+   */
+  static void UlScheduling (Ptr<MacStatsCalculator> macStats, uint32_t i);
+
+  /**
+   * Read the rows of a file
+   *
+   * \param filename the name of the file
+   * \return the rows, split in columns
+   */
+  static std::vector<std::vector<double> > ReadRows (std::string filename);
+
+  Time m_epoch; ///< the aggregation epoch
+};
+
+LteStatsCalculatorTestCase::LteStatsCalculatorTestCase (Time epoch)
+  : TestCase (epoch.IsZero () ? "MAC stats, one row per record" : "MAC stats, one row per epoch"),
+    m_epoch (epoch)
+{
+}
+
+LteStatsCalculatorTestCase::~LteStatsCalculatorTestCase ()
+{
+}
+
+void
+LteStatsCalculatorTestCase::UlScheduling (Ptr<MacStatsCalculator> macStats, uint32_t i)
+{
+  macStats->UlScheduling (1, 1, i / 10, i % 10, 1, i, 100, 0);
+  macStats->UlScheduling (1, 2, i / 10, i % 10, 2, 5, 50, 0);
+}
+
+std::vector<std::vector<double> >
+LteStatsCalculatorTestCase::ReadRows (std::string filename)
+{
+  std::vector<std::vector<double> > rows;
+  std::ifstream file (filename.c_str ());
+  std::string line;
+  while (std::getline (file, line))
+    {
+      if (line.empty () || line[0] == '%')
+        {
+          continue;
+        }
+      std::istringstream iss (line);
+      std::vector<double> row;
+      double value;
+      while (iss >> value)
+        {
+          row.push_back (value);
+        }
+      rows.push_back (row);
+    }
+  return rows;
+}
+
+void
+LteStatsCalculatorTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("UlMacStats.txt");
+  Ptr<MacStatsCalculator> macStats = CreateObject<MacStatsCalculator> ();
+  macStats->SetAttribute ("UlOutputFilename", StringValue (filename));
+  macStats->SetAttribute ("AggregationEpoch", TimeValue (m_epoch));
+
+  // two UEs, allocated every 10 ms for 250 ms, with the MCS of the
+  // first UE increasing with time
+  for (uint32_t i = 1; i <= 25; i++)
+    {
+      Simulator::Schedule (MilliSeconds (10 * i), &LteStatsCalculatorTestCase::UlScheduling,
+                           macStats, i);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::vector<std::vector<double> > rows = ReadRows (filename);
+  if (m_epoch.IsZero ())
+    {
+      NS_TEST_ASSERT_MSG_EQ (rows.size (), 50, "One row per record expected");
+      NS_TEST_ASSERT_MSG_EQ (rows.back ().size (), 9, "Wrong number of columns");
+      NS_TEST_ASSERT_MSG_EQ_TOL (rows.back ()[0], 0.25, 1e-9, "Wrong time");
+      NS_TEST_ASSERT_MSG_EQ (rows.back ()[2], 2, "Wrong IMSI");
+      return;
+    }
+
+  // epochs starting at 0, 100 and 200 ms, with 9, 10 and 6 allocations
+  NS_TEST_ASSERT_MSG_EQ (rows.size (), 6, "One row per UE and epoch expected");
+  const double samples[] = { 9, 10, 6 };
+  const double mcs[] = { 5, 14.5, 22.5 };
+  for (uint32_t epoch = 0; epoch < 3; epoch++)
+    {
+      for (uint32_t ue = 0; ue < 2; ue++)
+        {
+          const std::vector<double> &row = rows[2 * epoch + ue];
+          NS_TEST_ASSERT_MSG_EQ (row.size (), 8, "Wrong number of columns");
+          NS_TEST_ASSERT_MSG_EQ_TOL (row[0], 0.1 * epoch, 1e-9, "Wrong epoch start");
+          NS_TEST_ASSERT_MSG_EQ (row[2], ue + 1, "Wrong IMSI");
+          NS_TEST_ASSERT_MSG_EQ (row[4], samples[epoch], "Wrong number of allocations");
+          NS_TEST_ASSERT_MSG_EQ_TOL (row[5], (ue == 0 ? mcs[epoch] : 5), 1e-9, "Wrong mean MCS");
+          NS_TEST_ASSERT_MSG_EQ (row[6], (samples[epoch] * (ue == 0 ? 100 : 50)), "Wrong size");
+        }
+    }
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite for the output of the LTE stats calculators.
+ */
+class LteStatsCalculatorTestSuite : public TestSuite
+{
+public:
+  LteStatsCalculatorTestSuite ();
+};
+
+LteStatsCalculatorTestSuite::LteStatsCalculatorTestSuite ()
+  : TestSuite ("lte-stats-calculator", UNIT)
+{
+  AddTestCase (new LteStatsCalculatorTestCase (Time (0)), TestCase::QUICK);
+  AddTestCase (new LteStatsCalculatorTestCase (MilliSeconds (100)), TestCase::QUICK);
+}
+
+static LteStatsCalculatorTestSuite g_lteStatsCalculatorTestSuite; ///< the test suite
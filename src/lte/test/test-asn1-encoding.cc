@@ -52,7 +52,8 @@ public:
   {
     uint32_t psize = pkt->GetSize ();
     uint8_t buffer[psize];
-    char sbuffer[psize * 3];
+    char sbuffer[psize * 3 + 1];
+    sbuffer[0] = 0;
     pkt->CopyData (buffer, psize);
     for (uint32_t i = 0; i < psize; i++)
       {
@@ -133,6 +134,11 @@ public:
    * \param rrcd2 LteRrcSap::RadioResourceConfigDedicated # 2
    */
   void AssertEqualRadioResourceConfigDedicated (LteRrcSap::RadioResourceConfigDedicated rrcd1, LteRrcSap::RadioResourceConfigDedicated rrcd2);
+  /**
+   * \brief Assert that the packet holds the expected encoding
+   * \param expectedHex the expected packet contents, in hex format
+   */
+  void AssertEqualEncoding (std::string expectedHex);
 
 protected:
   Ptr<Packet> packet; ///< the packet
@@ -291,6 +297,12 @@ RrcHeaderTestCase::AssertEqualRadioResourceConfigDedicated (LteRrcSap::RadioReso
     }
 }
 
+void
+RrcHeaderTestCase::AssertEqualEncoding (std::string expectedHex)
+{
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet), expectedHex, "Different encoding!");
+}
+
 /**
  * \ingroup lte-test
  * \ingroup tests
@@ -329,9 +341,13 @@ RrcConnectionRequestTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check the encoding against the reference one
+  AssertEqualEncoding ("48 3f ec af ec a6 ");
+
   // Remove header
   RrcConnectionRequestHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "Header not fully removed!");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionRequestHeader> (destination,"DESTINATION");
@@ -382,9 +398,14 @@ RrcConnectionSetupTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check the encoding against the reference one
+  AssertEqualEncoding ("7f 81 c8 ce 14 e0 b8 80 80 4d 98 46 10 84 28 1a "
+                       "60 00 30 04 00 ");
+
   // remove header
   RrcConnectionSetupHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "Header not fully removed!");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionSetupHeader> (destination,"DESTINATION");
@@ -435,9 +456,13 @@ RrcConnectionSetupCompleteTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check the encoding against the reference one
+  AssertEqualEncoding ("26 40 ");
+
   // Remove header
   RrcConnectionSetupCompleteHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "Header not fully removed!");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionSetupCompleteHeader> (destination,"DESTINATION");
@@ -487,9 +512,13 @@ RrcConnectionReconfigurationCompleteTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check the encoding against the reference one
+  AssertEqualEncoding ("15 ");
+
   // remove header
   RrcConnectionReconfigurationCompleteHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "Header not fully removed!");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionReconfigurationCompleteHeader> (destination,"DESTINATION");
@@ -650,9 +679,17 @@ RrcConnectionReconfigurationTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check the encoding against the reference one
+  AssertEqualEncoding ("24 1a 3f e8 6c c0 08 3e 00 0a 9e 60 90 20 98 3b "
+                       "a0 00 23 40 53 e8 26 78 2a 04 3e 49 4c 81 1c 42 "
+                       "62 90 67 5a 21 e2 ae 70 a6 13 40 90 00 0c 00 05 "
+                       "99 00 00 b4 00 00 02 00 00 00 00 08 08 9c 8c e1 "
+                       "4e 0b 88 08 04 d9 84 61 08 42 81 a6 00 03 00 40 ");
+
   // remove header
   RrcConnectionReconfigurationHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "Header not fully removed!");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionReconfigurationHeader> (destination,"DESTINATION");
@@ -768,9 +805,17 @@ HandoverPreparationInfoTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check the encoding against the reference one
+  AssertEqualEncoding ("08 00 00 39 19 c2 9c 17 10 10 09 b3 08 c2 10 85 "
+                       "03 4c 00 06 00 80 00 05 b0 02 a0 88 44 8c 00 00 "
+                       "00 00 00 a4 00 00 02 14 00 00 00 00 00 01 00 00 "
+                       "00 1e 00 00 00 00 00 00 7e 11 00 08 00 00 60 00 "
+                       "55 e0 00 00 30 ");
+
   // remove header
   HandoverPreparationInfoHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "Header not fully removed!");
 
   // Log destination info
   TestUtils::LogPacketInfo<HandoverPreparationInfoHeader> (destination,"DESTINATION");
@@ -829,9 +874,13 @@ RrcConnectionReestablishmentRequestTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check the encoding against the reference one
+  AssertEqualEncoding ("00 01 81 50 00 04 ");
+
   // remove header
   RrcConnectionReestablishmentRequestHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "Header not fully removed!");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionReestablishmentRequestHeader> (destination,"DESTINATION");
@@ -883,9 +932,13 @@ RrcConnectionReestablishmentTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check the encoding against the reference one
+  AssertEqualEncoding ("10 1c 8c e1 4e 0b 88 08 04 d9 84 61 08 42 81 a6 00 03 00 40 ");
+
   // remove header
   RrcConnectionReestablishmentHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "Header not fully removed!");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionReestablishmentHeader> (destination,"DESTINATION");
@@ -935,9 +988,13 @@ RrcConnectionReestablishmentCompleteTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check the encoding against the reference one
+  AssertEqualEncoding ("1e 00 ");
+
   // remove header
   RrcConnectionReestablishmentCompleteHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "Header not fully removed!");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionReestablishmentCompleteHeader> (destination,"DESTINATION");
@@ -948,6 +1005,114 @@ RrcConnectionReestablishmentCompleteTestCase::DoRun (void)
   packet = 0;
 }
 
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Rrc Connection Reestablishment Reject Test Case
+ */
+class RrcConnectionReestablishmentRejectTestCase : public RrcHeaderTestCase
+{
+public:
+  RrcConnectionReestablishmentRejectTestCase ();
+  virtual void DoRun (void);
+};
+
+RrcConnectionReestablishmentRejectTestCase::RrcConnectionReestablishmentRejectTestCase () : RrcHeaderTestCase ("Testing RrcConnectionReestablishmentRejectTestCase")
+{
+}
+
+void
+RrcConnectionReestablishmentRejectTestCase::DoRun (void)
+{
+  packet = Create<Packet> ();
+  NS_LOG_DEBUG ("============= RrcConnectionReestablishmentRejectTestCase ===========");
+
+  LteRrcSap::RrcConnectionReestablishmentReject msg;
+
+  RrcConnectionReestablishmentRejectHeader source;
+  source.SetMessage (msg);
+
+  // Log source info
+  TestUtils::LogPacketInfo<RrcConnectionReestablishmentRejectHeader> (source,"SOURCE");
+
+  // Add header
+  packet->AddHeader (source);
+
+  // Log serialized packet contents
+  TestUtils::LogPacketContents (packet);
+
+  // Check the encoding against the reference one
+  AssertEqualEncoding ("20 ");
+
+  // remove header
+  RrcConnectionReestablishmentRejectHeader destination;
+  packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "Header not fully removed!");
+
+  // Log destination info
+  TestUtils::LogPacketInfo<RrcConnectionReestablishmentRejectHeader> (destination,"DESTINATION");
+
+  packet = 0;
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Rrc Connection Release Test Case
+ */
+class RrcConnectionReleaseTestCase : public RrcHeaderTestCase
+{
+public:
+  RrcConnectionReleaseTestCase ();
+  virtual void DoRun (void);
+};
+
+RrcConnectionReleaseTestCase::RrcConnectionReleaseTestCase () : RrcHeaderTestCase ("Testing RrcConnectionReleaseTestCase")
+{
+}
+
+void
+RrcConnectionReleaseTestCase::DoRun (void)
+{
+  packet = Create<Packet> ();
+  NS_LOG_DEBUG ("============= RrcConnectionReleaseTestCase ===========");
+
+  LteRrcSap::RrcConnectionRelease msg;
+  msg.rrcTransactionIdentifier = 2;
+
+  RrcConnectionReleaseHeader source;
+  source.SetMessage (msg);
+
+  // Log source info
+  TestUtils::LogPacketInfo<RrcConnectionReleaseHeader> (source,"SOURCE");
+
+  // Add header
+  packet->AddHeader (source);
+
+  // Log serialized packet contents
+  TestUtils::LogPacketContents (packet);
+
+  // Check the encoding against the reference one
+  AssertEqualEncoding ("2c 02 ");
+
+  // remove header
+  RrcConnectionReleaseHeader destination;
+  packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "Header not fully removed!");
+
+  // Log destination info
+  TestUtils::LogPacketInfo<RrcConnectionReleaseHeader> (destination,"DESTINATION");
+
+  // Check that the destination and source headers contain the same values
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) source.GetMessage ().rrcTransactionIdentifier,
+                         (uint16_t) destination.GetMessage ().rrcTransactionIdentifier,
+                         "Different rrcTransactionIdentifier!");
+
+  packet = 0;
+}
+
 /**
  * \ingroup lte-test
  * \ingroup tests
@@ -986,9 +1151,13 @@ RrcConnectionRejectTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check the encoding against the reference one
+  AssertEqualEncoding ("40 20 ");
+
   // remove header
   RrcConnectionRejectHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "Header not fully removed!");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionRejectHeader> (destination,"DESTINATION");
@@ -1054,9 +1223,13 @@ MeasurementReportTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check the encoding against the reference one
+  AssertEqualEncoding ("08 02 42 4a 82 09 00 e0 00 00 06 00 05 68 56 ");
+
   // remove header
   MeasurementReportHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "Header not fully removed!");
 
   // Log destination info
   TestUtils::LogPacketInfo<MeasurementReportHeader> (destination,"DESTINATION");
@@ -1115,6 +1288,171 @@ MeasurementReportTestCase::DoRun (void)
   packet = 0;
 }
 
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Header serializing integers of every size from 1 to 20 bits and
+ * bit strings, after a given number of booleans.
+ */
+class Asn1BitPackingHeader : public Asn1Header
+{
+public:
+  /**
+   * Constructor
+   * \param offset the number of booleans serialized first
+   */
+  Asn1BitPackingHeader (uint8_t offset);
+
+  // Inherited from Asn1Header
+  void PreSerialize (void) const;
+  uint32_t Deserialize (Buffer::Iterator bIterator);
+  void Print (std::ostream &os) const;
+
+  uint8_t m_offset; ///< the number of booleans serialized first
+  std::vector<int> m_integers; ///< the integers, the i-th one in [-5, 2^(i+1) - 6]
+  std::bitset<32> m_bits32; ///< a 32 bits string
+  std::bitset<27> m_bits27; ///< a 27 bits string
+  std::bitset<10> m_bits10; ///< a 10 bits string
+  std::bitset<2> m_bits2; ///< a 2 bits string
+};
+
+Asn1BitPackingHeader::Asn1BitPackingHeader (uint8_t offset)
+  : m_offset (offset),
+    m_integers (20, 0)
+{
+}
+
+void
+Asn1BitPackingHeader::PreSerialize (void) const
+{
+  StartSerialization ();
+  for (uint8_t i = 0; i < m_offset; i++)
+    {
+      SerializeBoolean (i % 2);
+    }
+  for (int i = 0; i < 20; i++)
+    {
+      SerializeInteger (m_integers[i], -5, (1 << (i + 1)) - 6);
+      if (i == 4)
+        {
+          SerializeBitstring (m_bits32);
+        }
+      else if (i == 9)
+        {
+          SerializeBitstring (m_bits27);
+        }
+      else if (i == 14)
+        {
+          SerializeBitstring (m_bits10);
+        }
+    }
+  SerializeBitstring (m_bits2);
+  FinalizeSerialization ();
+}
+
+uint32_t
+Asn1BitPackingHeader::Deserialize (Buffer::Iterator bIterator)
+{
+  for (uint8_t i = 0; i < m_offset; i++)
+    {
+      bool value;
+      bIterator = DeserializeBoolean (&value, bIterator);
+    }
+  for (int i = 0; i < 20; i++)
+    {
+      bIterator = DeserializeInteger (&m_integers[i], -5, (1 << (i + 1)) - 6, bIterator);
+      if (i == 4)
+        {
+          bIterator = DeserializeBitstring (&m_bits32, bIterator);
+        }
+      else if (i == 9)
+        {
+          bIterator = DeserializeBitstring (&m_bits27, bIterator);
+        }
+      else if (i == 14)
+        {
+          bIterator = DeserializeBitstring (&m_bits10, bIterator);
+        }
+    }
+  bIterator = DeserializeBitstring (&m_bits2, bIterator);
+  return GetSerializedSize ();
+}
+
+void
+Asn1BitPackingHeader::Print (std::ostream &os) const
+{
+  for (int i = 0; i < 20; i++)
+    {
+      os << m_integers[i] << " ";
+    }
+  os << m_bits32 << " " << m_bits27 << " " << m_bits10 << " " << m_bits2;
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the packing of the bits of integers and bit strings of
+ * every size, at every bit offset.
+ */
+class Asn1BitPackingTestCase : public TestCase
+{
+public:
+  Asn1BitPackingTestCase ();
+  virtual void DoRun (void);
+};
+
+Asn1BitPackingTestCase::Asn1BitPackingTestCase () : TestCase ("Testing the packing of the bits")
+{
+}
+
+void
+Asn1BitPackingTestCase::DoRun (void)
+{
+  uint32_t state = 12345;
+  for (uint8_t offset = 0; offset < 8; offset++)
+    {
+      for (int k = 0; k < 16; k++)
+        {
+          Asn1BitPackingHeader source (offset);
+          for (int i = 0; i < 20; i++)
+            {
+              state = state * 1103515245 + 12345;
+              // alternate the extreme values and pseudo random ones
+              int range = 1 << (i + 1);
+              int value = (k == 0) ? 0 : (k == 1) ? range - 1 : (state >> 8) % range;
+              source.m_integers[i] = value - 5;
+            }
+          state = state * 1103515245 + 12345;
+          source.m_bits32 = std::bitset<32> ((k == 1) ? 0xffffffff : state);
+          source.m_bits27 = std::bitset<27> ((k == 1) ? 0xffffffff : ~state);
+          source.m_bits10 = std::bitset<10> (state >> 7);
+          source.m_bits2 = std::bitset<2> (state >> 21);
+
+          Ptr<Packet> packet = Create<Packet> ();
+          packet->AddHeader (source);
+
+          // 210 bits of integers and 71 bits of bit strings
+          uint32_t bits = offset + 210 + 71;
+          NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), (bits + 7) / 8, "Different size!");
+
+          Asn1BitPackingHeader destination (offset);
+          packet->RemoveHeader (destination);
+          NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "Header not fully removed!");
+
+          for (int i = 0; i < 20; i++)
+            {
+              NS_TEST_ASSERT_MSG_EQ (source.m_integers[i], destination.m_integers[i], "Different integer of " << i + 1 << " bits!");
+            }
+          NS_TEST_ASSERT_MSG_EQ (source.m_bits32, destination.m_bits32, "Different m_bits32!");
+          NS_TEST_ASSERT_MSG_EQ (source.m_bits27, destination.m_bits27, "Different m_bits27!");
+          NS_TEST_ASSERT_MSG_EQ (source.m_bits10, destination.m_bits10, "Different m_bits10!");
+          NS_TEST_ASSERT_MSG_EQ (source.m_bits2, destination.m_bits2, "Different m_bits2!");
+        }
+    }
+}
+
 /**
  * \ingroup lte-test
  * \ingroup tests
@@ -1140,8 +1478,11 @@ Asn1EncodingSuite::Asn1EncodingSuite ()
   AddTestCase (new RrcConnectionReestablishmentRequestTestCase (), TestCase::QUICK);
   AddTestCase (new RrcConnectionReestablishmentTestCase (), TestCase::QUICK);
   AddTestCase (new RrcConnectionReestablishmentCompleteTestCase (), TestCase::QUICK);
+  AddTestCase (new RrcConnectionReestablishmentRejectTestCase (), TestCase::QUICK);
+  AddTestCase (new RrcConnectionReleaseTestCase (), TestCase::QUICK);
   AddTestCase (new RrcConnectionRejectTestCase (), TestCase::QUICK);
   AddTestCase (new MeasurementReportTestCase (), TestCase::QUICK);
+  AddTestCase (new Asn1BitPackingTestCase (), TestCase::QUICK);
 }
 
 Asn1EncodingSuite asn1EncodingSuite;
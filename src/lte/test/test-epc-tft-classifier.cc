@@ -169,6 +169,80 @@ EpcTftClassifierTestCase::DoRun (void)
 
 
 
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case to check that the flow decisions cached by the Tft
+ * Classifier follow the addition and removal of TFTs.
+ */
+class EpcTftClassifierCacheTestCase : public TestCase
+{
+public:
+  EpcTftClassifierCacheTestCase ();
+
+private:
+  /**
+   * Classify a downlink UDP packet
+   * \param c the EPC TFT classifier
+   * \param sp the source port
+   * \returns the TFT ID
+   */
+  static uint32_t Classify (Ptr<EpcTftClassifier> c, uint16_t sp);
+  virtual void DoRun (void);
+};
+
+EpcTftClassifierCacheTestCase::EpcTftClassifierCacheTestCase ()
+  : TestCase ("Cached flow decisions follow TFT changes")
+{
+}
+
+uint32_t
+EpcTftClassifierCacheTestCase::Classify (Ptr<EpcTftClassifier> c, uint16_t sp)
+{
+  Ipv4Header ipHeader;
+  ipHeader.SetSource (Ipv4Address ("9.1.1.1"));
+  ipHeader.SetDestination (Ipv4Address ("8.1.1.1"));
+  ipHeader.SetPayloadSize (8);
+  ipHeader.SetProtocol (UdpL4Protocol::PROT_NUMBER);
+  UdpHeader udpHeader;
+  udpHeader.SetSourcePort (sp);
+  udpHeader.SetDestinationPort (4);
+
+  Ptr<Packet> udpPacket = Create<Packet> ();
+  udpPacket->AddHeader (udpHeader);
+  udpPacket->AddHeader (ipHeader);
+  return c->Classify (udpPacket, EpcTft::DOWNLINK);
+}
+
+void
+EpcTftClassifierCacheTestCase::DoRun (void)
+{
+  Ptr<EpcTftClassifier> c = Create<EpcTftClassifier> ();
+  c->Add (EpcTft::Default (), 1);
+
+  Ptr<EpcTft> tft = Create<EpcTft> ();
+  EpcTft::PacketFilter pf;
+  pf.remotePortStart = 1024;
+  pf.remotePortEnd = 1035;
+  tft->Add (pf);
+  c->Add (tft, 2);
+
+  NS_TEST_ASSERT_MSG_EQ (Classify (c, 1030), 2, "bad classification of the first packet of a flow");
+  NS_TEST_ASSERT_MSG_EQ (Classify (c, 1030), 2, "bad classification of a cached flow");
+  NS_TEST_ASSERT_MSG_EQ (Classify (c, 2000), 1, "bad classification of a default bearer flow");
+
+  c->Delete (2);
+  NS_TEST_ASSERT_MSG_EQ (Classify (c, 1030), 1, "cached flow not updated after TFT removal");
+
+  c->Add (tft, 3);
+  NS_TEST_ASSERT_MSG_EQ (Classify (c, 1030), 3, "cached flow not updated after TFT addition");
+  NS_TEST_ASSERT_MSG_EQ (Classify (c, 2000), 1, "bad classification of a default bearer flow");
+
+  c->Delete (1);
+  NS_TEST_ASSERT_MSG_EQ (Classify (c, 2000), 0, "cached flow not updated after TFT removal");
+}
+
 
 /**
  * \ingroup lte-test
@@ -368,4 +442,11 @@ EpcTftClassifierTestSuite::EpcTftClassifierTestSuite ()
   AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::UPLINK,   Ipv4Address ("9.1.1.1"), Ipv4Address ("8.1.1.1"),     9,     5897,     0,    2), TestCase::QUICK);
   AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::DOWNLINK, Ipv4Address ("9.1.1.1"), Ipv4Address ("8.1.1.1"),  5897,       10,     0,    2), TestCase::QUICK);
 
+
+  ///////////////////////////////////////////
+  // check the cached flow decisions
+  ///////////////////////////////////////////
+
+  AddTestCase (new EpcTftClassifierCacheTestCase, TestCase::QUICK);
+
 }
@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "batch-mobility-model.h"
+#include "ns3/pointer.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("BatchMobilityModel");
+
+NS_OBJECT_ENSURE_REGISTERED (BatchMobilityModel);
+
+TypeId
+BatchMobilityModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::BatchMobilityModel")
+    .SetParent<MobilityModel> ()
+    .SetGroupName ("Mobility")
+    .AddConstructor<BatchMobilityModel> ()
+    .AddAttribute ("Batch",
+                   "The batch moving this node.",
+                   PointerValue (0),
+                   MakePointerAccessor (&BatchMobilityModel::SetBatch,
+                                        &BatchMobilityModel::GetBatch),
+                   MakePointerChecker<MobilityBatch> ())
+  ;
+  return tid;
+}
+
+BatchMobilityModel::BatchMobilityModel ()
+  : m_index (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+BatchMobilityModel::~BatchMobilityModel ()
+{
+  NS_LOG_FUNCTION (this);
+  // the batch keeps a raw pointer to this model
+  if (m_batch != 0)
+    {
+      m_batch->Remove (m_index);
+    }
+}
+
+void
+BatchMobilityModel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  SetBatch (0);
+  MobilityModel::DoDispose ();
+}
+
+void
+BatchMobilityModel::DoInitialize (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_batch != 0)
+    {
+      m_batch->Start (m_index);
+    }
+  MobilityModel::DoInitialize ();
+}
+
+void
+BatchMobilityModel::SetBatch (Ptr<MobilityBatch> batch)
+{
+  NS_LOG_FUNCTION (this << batch);
+  if (m_batch != 0)
+    {
+      m_batch->Remove (m_index);
+    }
+  m_batch = batch;
+  if (m_batch != 0)
+    {
+      m_index = m_batch->Add (this);
+    }
+}
+
+Ptr<MobilityBatch>
+BatchMobilityModel::GetBatch (void) const
+{
+  return m_batch;
+}
+
+Vector
+BatchMobilityModel::DoGetPosition (void) const
+{
+  NS_ASSERT_MSG (m_batch != 0, "BatchMobilityModel without a batch");
+  return m_batch->GetPosition (m_index);
+}
+
+void
+BatchMobilityModel::DoSetPosition (const Vector &position)
+{
+  NS_ASSERT_MSG (m_batch != 0, "BatchMobilityModel without a batch");
+  m_batch->SetPosition (m_index, position);
+  NotifyCourseChange ();
+}
+
+Vector
+BatchMobilityModel::DoGetVelocity (void) const
+{
+  NS_ASSERT_MSG (m_batch != 0, "BatchMobilityModel without a batch");
+  return m_batch->GetVelocity (m_index);
+}
+
+int64_t
+BatchMobilityModel::DoAssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  if (m_batch == 0)
+    {
+      return 0;
+    }
+  return m_batch->AssignStreams (stream);
+}
+
+} // namespace ns3
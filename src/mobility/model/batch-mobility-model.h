@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef BATCH_MOBILITY_MODEL_H
+#define BATCH_MOBILITY_MODEL_H
+
+#include "mobility-model.h"
+#include "mobility-batch.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup mobility
+ * \brief Mobility model of a node moved by a MobilityBatch.
+ *
+ * The position and velocity are kept by the batch, which moves all
+ * its nodes at once.  The node starts walking when it is initialized,
+ * so that the streams assigned by MobilityHelper::AssignStreams are
+ * used from the start.
+ */
+class BatchMobilityModel : public MobilityModel
+{
+public:
+  /**
+   * Register this type with the TypeId system.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  BatchMobilityModel ();
+  virtual ~BatchMobilityModel ();
+
+  /**
+   * Add this node to a batch.
+   * \param batch the batch.
+   */
+  void SetBatch (Ptr<MobilityBatch> batch);
+  /**
+   * \return the batch moving this node.
+   */
+  Ptr<MobilityBatch> GetBatch (void) const;
+
+private:
+  friend class MobilityBatch;
+
+  virtual void DoDispose (void);
+  virtual void DoInitialize (void);
+  virtual Vector DoGetPosition (void) const;
+  virtual void DoSetPosition (const Vector &position);
+  virtual Vector DoGetVelocity (void) const;
+  /**
+   * Assign the streams of the batch. As all the node models of a batch
+   * share its random variables, the batch uses the streams of the last
+   * node model whose streams were assigned.
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned
+   */
+  virtual int64_t DoAssignStreams (int64_t stream);
+
+  Ptr<MobilityBatch> m_batch; //!< the batch moving this node
+  uint32_t m_index; //!< the index of this node in the batch
+};
+
+} // namespace ns3
+
+#endif /* BATCH_MOBILITY_MODEL_H */
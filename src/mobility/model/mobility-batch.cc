@@ -0,0 +1,260 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "mobility-batch.h"
+#include "batch-mobility-model.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/log.h"
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MobilityBatch");
+
+NS_OBJECT_ENSURE_REGISTERED (MobilityBatch);
+
+TypeId
+MobilityBatch::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MobilityBatch")
+    .SetParent<Object> ()
+    .SetGroupName ("Mobility")
+    .AddConstructor<MobilityBatch> ()
+    .AddAttribute ("Bounds",
+                   "Bounds of the area to cruise.",
+                   RectangleValue (Rectangle (0.0, 100.0, 0.0, 100.0)),
+                   MakeRectangleAccessor (&MobilityBatch::m_bounds),
+                   MakeRectangleChecker ())
+    .AddAttribute ("Interval",
+                   "Change the direction and speed of all the nodes after this delay.",
+                   TimeValue (Seconds (1.0)),
+                   MakeTimeAccessor (&MobilityBatch::m_interval),
+                   MakeTimeChecker (TimeStep (1)))
+    .AddAttribute ("Direction",
+                   "A random variable used to pick the direction (radians).",
+                   StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=6.283184]"),
+                   MakePointerAccessor (&MobilityBatch::m_direction),
+                   MakePointerChecker<RandomVariableStream> ())
+    .AddAttribute ("Speed",
+                   "A random variable used to pick the speed (m/s).",
+                   StringValue ("ns3::UniformRandomVariable[Min=2.0|Max=4.0]"),
+                   MakePointerAccessor (&MobilityBatch::m_speed),
+                   MakePointerChecker<RandomVariableStream> ())
+    .AddAttribute ("NotifyEachNode",
+                   "Notify the course changes through the CourseChange trace "
+                   "source of each node, in addition to the one of the batch.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&MobilityBatch::m_notifyEachNode),
+                   MakeBooleanChecker ())
+    .AddTraceSource ("CourseChange",
+                     "The nodes of the batch changed course.",
+                     MakeTraceSourceAccessor (&MobilityBatch::m_courseChangeTrace),
+                     "ns3::MobilityBatch::TracedCallback")
+  ;
+  return tid;
+}
+
+MobilityBatch::MobilityBatch ()
+  : m_active (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MobilityBatch::~MobilityBatch ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MobilityBatch::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_event.Cancel ();
+  m_models.clear ();
+  m_position.clear ();
+  m_velocity.clear ();
+  m_start.clear ();
+  m_active = 0;
+  Object::DoDispose ();
+}
+
+uint32_t
+MobilityBatch::Add (BatchMobilityModel *model)
+{
+  NS_LOG_FUNCTION (this << model);
+  uint32_t index = m_models.size ();
+  m_models.push_back (model);
+  m_position.push_back (Vector ());
+  m_velocity.push_back (Vector ());
+  m_start.push_back (Simulator::Now ().GetSeconds ());
+  if (m_active++ == 0)
+    {
+      m_event = Simulator::Schedule (m_interval, &MobilityBatch::Tick, this);
+    }
+  return index;
+}
+
+void
+MobilityBatch::Remove (uint32_t index)
+{
+  NS_LOG_FUNCTION (this << index);
+  if (index < m_models.size () && m_models[index] != 0)
+    {
+      m_models[index] = 0;
+      if (--m_active == 0)
+        {
+          m_event.Cancel ();
+        }
+    }
+}
+
+uint32_t
+MobilityBatch::GetN (void) const
+{
+  return m_models.size ();
+}
+
+void
+MobilityBatch::Fold (double &position, double &speed, double min, double max)
+{
+  double length = max - min;
+  if (length <= 0)
+    {
+      position = min;
+      return;
+    }
+  // the reflections on both bounds repeat every twice the length
+  double offset = std::fmod (position - min, 2 * length);
+  if (offset < 0)
+    {
+      offset += 2 * length;
+    }
+  if (offset > length)
+    {
+      position = max - (offset - length);
+      speed = -speed;
+    }
+  else
+    {
+      position = min + offset;
+    }
+}
+
+void
+MobilityBatch::Advance (uint32_t index, Vector &position, Vector &velocity) const
+{
+  NS_ASSERT (index < m_position.size ());
+  double elapsed = Simulator::Now ().GetSeconds () - m_start[index];
+  position = m_position[index];
+  velocity = m_velocity[index];
+  position.x += velocity.x * elapsed;
+  position.y += velocity.y * elapsed;
+  Fold (position.x, velocity.x, m_bounds.xMin, m_bounds.xMax);
+  Fold (position.y, velocity.y, m_bounds.yMin, m_bounds.yMax);
+}
+
+Vector
+MobilityBatch::GetPosition (uint32_t index) const
+{
+  Vector position;
+  Vector velocity;
+  Advance (index, position, velocity);
+  return position;
+}
+
+Vector
+MobilityBatch::GetVelocity (uint32_t index) const
+{
+  Vector position;
+  Vector velocity;
+  Advance (index, position, velocity);
+  return velocity;
+}
+
+void
+MobilityBatch::SetPosition (uint32_t index, const Vector &position)
+{
+  NS_LOG_FUNCTION (this << index << position);
+  NS_ASSERT (index < m_position.size ());
+  NS_ASSERT (m_bounds.IsInside (position));
+  m_velocity[index] = GetVelocity (index);
+  m_position[index] = position;
+  m_start[index] = Simulator::Now ().GetSeconds ();
+}
+
+void
+MobilityBatch::Start (uint32_t index)
+{
+  NS_LOG_FUNCTION (this << index);
+  NS_ASSERT (index < m_position.size ());
+  m_position[index] = GetPosition (index);
+  Walk (index);
+}
+
+void
+MobilityBatch::Walk (uint32_t index)
+{
+  double speed = m_speed->GetValue ();
+  double direction = m_direction->GetValue ();
+  m_velocity[index] = Vector (std::cos (direction) * speed,
+                              std::sin (direction) * speed,
+                              0.0);
+  m_start[index] = Simulator::Now ().GetSeconds ();
+}
+
+void
+MobilityBatch::Tick (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (uint32_t i = 0; i < m_models.size (); i++)
+    {
+      if (m_models[i] != 0)
+        {
+          m_position[i] = GetPosition (i);
+          Walk (i);
+        }
+    }
+  if (m_notifyEachNode)
+    {
+      for (uint32_t i = 0; i < m_models.size (); i++)
+        {
+          if (m_models[i] != 0)
+            {
+              Ptr<Node> node = m_models[i]->GetObject<Node> ();
+              uint32_t context = node != 0 ? node->GetId () : Simulator::NO_CONTEXT;
+              Simulator::ScheduleWithContext (context, Seconds (0),
+                                              &BatchMobilityModel::NotifyCourseChange,
+                                              Ptr<BatchMobilityModel> (m_models[i]));
+            }
+        }
+    }
+  m_courseChangeTrace (this);
+  m_event = Simulator::Schedule (m_interval, &MobilityBatch::Tick, this);
+}
+
+int64_t
+MobilityBatch::AssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  m_speed->SetStream (stream);
+  m_direction->SetStream (stream + 1);
+  return 2;
+}
+
+} // namespace ns3
@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef MOBILITY_BATCH_H
+#define MOBILITY_BATCH_H
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/vector.h"
+#include "ns3/rectangle.h"
+#include "ns3/traced-callback.h"
+#include "ns3/random-variable-stream.h"
+#include <vector>
+
+namespace ns3 {
+
+class BatchMobilityModel;
+
+/**
+ * \ingroup mobility
+ * \brief Move many nodes with a 2D random walk, in one event per interval.
+ *
+ * Each node of the batch moves with a speed and direction chosen at
+ * random when its model is initialized, which are chosen again for all
+ * the nodes at once every Interval, like a RandomWalk2dMobilityModel in
+ * time mode.  The nodes rebound on the boundaries of the area with a
+ * reflexive angle.
+ *
+ * The positions and velocities are stored in contiguous arrays, and
+ * a position is only computed when it is requested: the rebounds need
+ * no events, so a batch schedules a single event per interval however
+ * many nodes it moves, where the per-node models schedule one or more
+ * events per node.  The course changes are notified once per interval
+ * through the CourseChange trace source of the batch and, unless
+ * NotifyEachNode is false, through the CourseChange trace source of
+ * each node model, which takes an event per node so as to run in the
+ * context of the node.  Rebounds are not notified.
+ *
+ * The nodes use a BatchMobilityModel pointing to the batch:
+ * \code
+ *   Ptr<MobilityBatch> batch = CreateObject<MobilityBatch> ();
+ *   MobilityHelper mobility;
+ *   mobility.SetMobilityModel ("ns3::BatchMobilityModel",
+ *                              "Batch", PointerValue (batch));
+ *   mobility.Install (nodes);
+ * \endcode
+ */
+class MobilityBatch : public Object
+{
+public:
+  /**
+   * Register this type with the TypeId system.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  MobilityBatch ();
+  virtual ~MobilityBatch ();
+
+  /**
+   * Add a node model to the batch.
+   * \param model the node model.
+   * \return the index of the node in the batch.
+   */
+  uint32_t Add (BatchMobilityModel *model);
+  /**
+   * Remove a node model from the batch.
+   * \param index the index of the node in the batch.
+   */
+  void Remove (uint32_t index);
+  /**
+   * \return the number of nodes added to the batch.
+   */
+  uint32_t GetN (void) const;
+  /**
+   * \param index the index of a node in the batch.
+   * \return the current position of the node.
+   */
+  Vector GetPosition (uint32_t index) const;
+  /**
+   * \param index the index of a node in the batch.
+   * \param position the position to set.
+   */
+  void SetPosition (uint32_t index, const Vector &position);
+  /**
+   * \param index the index of a node in the batch.
+   * \return the current velocity of the node.
+   */
+  Vector GetVelocity (uint32_t index) const;
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by this batch. Return the number of streams (possibly zero) that
+   * have been assigned.
+   *
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned by this batch
+   */
+  int64_t AssignStreams (int64_t stream);
+
+  /**
+   *  TracedCallback signature.
+   *
+   * \param [in] batch The MobilityBatch whose nodes changed course.
+   */
+  typedef void (* TracedCallback)(Ptr<const MobilityBatch> batch);
+
+private:
+  friend class BatchMobilityModel;
+
+  virtual void DoDispose (void);
+  /**
+   * Start the walk of a node, from its current position.
+   * \param index the index of the node in the batch.
+   */
+  void Start (uint32_t index);
+  /**
+   * Choose a new speed and direction for a node.
+   * \param index the index of the node in the batch.
+   */
+  void Walk (uint32_t index);
+  /// Choose a new speed and direction for all the nodes.
+  void Tick (void);
+  /**
+   * Compute the current position and velocity of a node.
+   * \param [in] index the index of the node in the batch.
+   * \param [out] position the current position.
+   * \param [out] velocity the current velocity.
+   */
+  void Advance (uint32_t index, Vector &position, Vector &velocity) const;
+  /**
+   * Fold a coordinate moving along an axis into the bounds of the area.
+   * \param [in,out] position the coordinate, folded.
+   * \param [in,out] speed the speed along the axis, reversed if
+   *                 the coordinate was folded an odd number of times.
+   * \param min the lower bound.
+   * \param max the upper bound.
+   */
+  static void Fold (double &position, double &speed, double min, double max);
+
+  Time m_interval; //!< Change the direction and speed after this delay
+  bool m_notifyEachNode; //!< Whether to notify the course changes through each node model
+  Ptr<RandomVariableStream> m_speed; //!< rv for picking speed
+  Ptr<RandomVariableStream> m_direction; //!< rv for picking direction
+  Rectangle m_bounds; //!< Bounds of the area to cruise
+  EventId m_event; //!< The next tick
+
+  std::vector<BatchMobilityModel *> m_models; //!< The node models, or 0 once removed
+  std::vector<Vector> m_position; //!< The position of each node at its start time
+  std::vector<Vector> m_velocity; //!< The velocity of each node at its start time
+  std::vector<double> m_start; //!< The start time of each node walk, in seconds
+  uint32_t m_active; //!< The number of node models not removed
+
+  /// The CourseChange trace source, fired once per interval.
+  ns3::TracedCallback<Ptr<const MobilityBatch> > m_courseChangeTrace;
+};
+
+} // namespace ns3
+
+#endif /* MOBILITY_BATCH_H */
@@ -0,0 +1,303 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/pointer.h"
+#include "ns3/string.h"
+#include "ns3/config.h"
+#include "ns3/node-container.h"
+#include "ns3/node.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/mobility-batch.h"
+#include "ns3/batch-mobility-model.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Check the lazy positions of a node rebounding on the bounds
+ */
+class MobilityBatchReboundTest : public TestCase
+{
+public:
+  MobilityBatchReboundTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Check the position and velocity of a node
+   * \param model the node model
+   * \param x the expected x coordinate
+   * \param speed the expected speed along x
+   */
+  void Check (Ptr<MobilityModel> model, double x, double speed);
+};
+
+MobilityBatchReboundTest::MobilityBatchReboundTest ()
+  : TestCase ("Check the rebounds of the MobilityBatch nodes")
+{
+}
+
+void
+MobilityBatchReboundTest::Check (Ptr<MobilityModel> model, double x, double speed)
+{
+  Vector position = model->GetPosition ();
+  Vector velocity = model->GetVelocity ();
+  NS_TEST_ASSERT_MSG_EQ_TOL (position.x, x, 1e-9, "Wrong x at " << Simulator::Now ().GetSeconds ());
+  NS_TEST_ASSERT_MSG_EQ_TOL (position.y, 5, 1e-9, "Wrong y at " << Simulator::Now ().GetSeconds ());
+  NS_TEST_ASSERT_MSG_EQ_TOL (velocity.x, speed, 1e-9, "Wrong speed at " << Simulator::Now ().GetSeconds ());
+}
+
+void
+MobilityBatchReboundTest::DoRun (void)
+{
+  // 2 m/s eastward in a 10 m square: the node rebounds after 2.5 s on
+  // the right side, and after 7.5 s on the left side
+  Ptr<MobilityBatch> batch = CreateObject<MobilityBatch> ();
+  batch->SetAttribute ("Bounds", RectangleValue (Rectangle (0, 10, 0, 10)));
+  batch->SetAttribute ("Interval", TimeValue (Seconds (100)));
+  batch->SetAttribute ("Speed", StringValue ("ns3::ConstantRandomVariable[Constant=2.0]"));
+  batch->SetAttribute ("Direction", StringValue ("ns3::ConstantRandomVariable[Constant=0.0]"));
+  Ptr<BatchMobilityModel> model = CreateObject<BatchMobilityModel> ();
+  model->SetBatch (batch);
+  model->SetPosition (Vector (5, 5, 0));
+  model->Initialize ();
+
+  Simulator::Schedule (Seconds (1), &MobilityBatchReboundTest::Check, this, model, 7, 2);
+  Simulator::Schedule (Seconds (4), &MobilityBatchReboundTest::Check, this, model, 7, -2);
+  Simulator::Schedule (Seconds (7), &MobilityBatchReboundTest::Check, this, model, 1, -2);
+  Simulator::Schedule (Seconds (9), &MobilityBatchReboundTest::Check, this, model, 3, 2);
+  Simulator::Stop (Seconds (10));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Check that a MobilityBatch moves all its nodes in one event
+ */
+class MobilityBatchTickTest : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param notifyEachNode whether the course changes are notified
+   *        through each node model
+   */
+  MobilityBatchTickTest (bool notifyEachNode);
+
+private:
+  virtual void DoRun (void);
+  /// Check that the nodes are inside the bounds
+  void CheckBounds (void);
+  /**
+   * Course change callback of the batch
+   * \param batch the batch
+   */
+  void BatchCourseChange (Ptr<const MobilityBatch> batch);
+  /**
+   * Course change callback of the nodes
+   * \param model the node model
+   */
+  void NodeCourseChange (Ptr<const MobilityModel> model);
+
+  bool m_notifyEachNode; //!< whether to notify through each node model
+  NodeContainer m_nodes; //!< the nodes
+  uint32_t m_batchChanges; //!< the course changes of the batch
+  uint32_t m_nodeChanges; //!< the course changes of the nodes
+};
+
+MobilityBatchTickTest::MobilityBatchTickTest (bool notifyEachNode)
+  : TestCase (notifyEachNode ? "Check the MobilityBatch ticks, notifying each node"
+              : "Check the MobilityBatch ticks, notifying the batch"),
+    m_notifyEachNode (notifyEachNode),
+    m_batchChanges (0),
+    m_nodeChanges (0)
+{
+}
+
+void
+MobilityBatchTickTest::CheckBounds (void)
+{
+  for (uint32_t i = 0; i < m_nodes.GetN (); i++)
+    {
+      Vector position = m_nodes.Get (i)->GetObject<MobilityModel> ()->GetPosition ();
+      NS_TEST_ASSERT_MSG_EQ (Rectangle (0, 20, 0, 20).IsInside (position), true,
+                             "Node " << i << " out of bounds");
+    }
+}
+
+void
+MobilityBatchTickTest::BatchCourseChange (Ptr<const MobilityBatch> batch)
+{
+  NS_TEST_ASSERT_MSG_EQ (batch->GetN (), m_nodes.GetN (), "Wrong number of nodes");
+  m_batchChanges++;
+}
+
+void
+MobilityBatchTickTest::NodeCourseChange (Ptr<const MobilityModel> model)
+{
+  NS_TEST_ASSERT_MSG_EQ (Simulator::GetContext (), model->GetObject<Node> ()->GetId (),
+                         "Course change out of the node context");
+  m_nodeChanges++;
+}
+
+void
+MobilityBatchTickTest::DoRun (void)
+{
+  Ptr<MobilityBatch> batch = CreateObject<MobilityBatch> ();
+  batch->SetAttribute ("Bounds", RectangleValue (Rectangle (0, 20, 0, 20)));
+  batch->SetAttribute ("NotifyEachNode", BooleanValue (m_notifyEachNode));
+  batch->AssignStreams (1);
+  batch->TraceConnectWithoutContext ("CourseChange",
+                                     MakeCallback (&MobilityBatchTickTest::BatchCourseChange, this));
+
+  m_nodes.Create (100);
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::RandomRectanglePositionAllocator",
+                                 "X", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=20.0]"),
+                                 "Y", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=20.0]"));
+  mobility.SetMobilityModel ("ns3::BatchMobilityModel", "Batch", PointerValue (batch));
+  mobility.Install (m_nodes);
+  for (uint32_t i = 0; i < m_nodes.GetN (); i++)
+    {
+      m_nodes.Get (i)->GetObject<MobilityModel> ()->TraceConnectWithoutContext
+        ("CourseChange", MakeCallback (&MobilityBatchTickTest::NodeCourseChange, this));
+    }
+  const uint32_t numChecks = 40;
+  for (uint32_t i = 0; i < numChecks; i++)
+    {
+      Simulator::Schedule (MilliSeconds (250 * i + 125), &MobilityBatchTickTest::CheckBounds, this);
+    }
+
+  Simulator::Stop (Seconds (10.5));
+  Simulator::Run ();
+  // the events of the setup: the initialization of each node, scheduled
+  // when the node is created, and the checks
+  uint64_t events = Simulator::GetEventCount () - m_nodes.GetN () - numChecks;
+  Simulator::Destroy ();
+
+  // one tick per second and the stop event, plus one notification per
+  // node and per tick if each node is notified
+  uint32_t nodeChanges = m_notifyEachNode ? 10 * m_nodes.GetN () : 0;
+  uint64_t expectedEvents = 10 + 1 + nodeChanges;
+  m_nodes = NodeContainer ();
+
+  NS_TEST_ASSERT_MSG_EQ (events, expectedEvents, "One event per tick expected");
+  NS_TEST_ASSERT_MSG_EQ (m_batchChanges, 10, "One batch course change per tick expected");
+  NS_TEST_ASSERT_MSG_EQ (m_nodeChanges, nodeChanges, "Wrong number of node course changes");
+}
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Check that MobilityHelper::AssignStreams reaches the random
+ * variables of a MobilityBatch
+ */
+class MobilityBatchStreamsTest : public TestCase
+{
+public:
+  MobilityBatchStreamsTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Move a few nodes for a while
+   * \param stream the first stream assigned to the nodes
+   * \return the final positions of the nodes
+   */
+  std::vector<Vector> Run (int64_t stream);
+};
+
+MobilityBatchStreamsTest::MobilityBatchStreamsTest ()
+  : TestCase ("Check the MobilityBatch stream assignment")
+{
+}
+
+std::vector<Vector>
+MobilityBatchStreamsTest::Run (int64_t stream)
+{
+  Ptr<MobilityBatch> batch = CreateObject<MobilityBatch> ();
+  batch->SetAttribute ("Bounds", RectangleValue (Rectangle (0, 100, 0, 100)));
+  NodeContainer nodes;
+  nodes.Create (10);
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "MinX", DoubleValue (10.0),
+                                 "MinY", DoubleValue (10.0),
+                                 "DeltaX", DoubleValue (10.0),
+                                 "DeltaY", DoubleValue (10.0));
+  mobility.SetMobilityModel ("ns3::BatchMobilityModel", "Batch", PointerValue (batch));
+  mobility.Install (nodes);
+  mobility.AssignStreams (nodes, stream);
+
+  Simulator::Stop (Seconds (5.5));
+  Simulator::Run ();
+  std::vector<Vector> positions;
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      positions.push_back (nodes.Get (i)->GetObject<MobilityModel> ()->GetPosition ());
+    }
+  Simulator::Destroy ();
+  return positions;
+}
+
+void
+MobilityBatchStreamsTest::DoRun (void)
+{
+  std::vector<Vector> first = Run (1);
+  std::vector<Vector> same = Run (1);
+  std::vector<Vector> other = Run (100);
+  bool differ = false;
+  for (uint32_t i = 0; i < first.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (first[i].x, same[i].x, "Node " << i << " moved differently with the same streams");
+      NS_TEST_ASSERT_MSG_EQ (first[i].y, same[i].y, "Node " << i << " moved differently with the same streams");
+      differ = differ || first[i].x != other[i].x || first[i].y != other[i].y;
+    }
+  NS_TEST_ASSERT_MSG_EQ (differ, true, "The nodes moved the same with other streams");
+}
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief MobilityBatch Test Suite
+ */
+class MobilityBatchTestSuite : public TestSuite
+{
+public:
+  MobilityBatchTestSuite ();
+};
+
+MobilityBatchTestSuite::MobilityBatchTestSuite ()
+  : TestSuite ("mobility-batch", UNIT)
+{
+  AddTestCase (new MobilityBatchReboundTest, TestCase::QUICK);
+  AddTestCase (new MobilityBatchTickTest (true), TestCase::QUICK);
+  AddTestCase (new MobilityBatchTickTest (false), TestCase::QUICK);
+  AddTestCase (new MobilityBatchStreamsTest, TestCase::QUICK);
+}
+
+static MobilityBatchTestSuite g_mobilityBatchTestSuite; ///< the test suite
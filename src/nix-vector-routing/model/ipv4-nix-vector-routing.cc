@@ -18,12 +18,14 @@
  * Authors: Josh Pelkey <jpelkey@gatech.edu>
  */
 
-#include <queue>
 #include <iomanip>
+#include <limits>
 
 #include "ns3/log.h"
 #include "ns3/abort.h"
 #include "ns3/names.h"
+#include "ns3/global-value.h"
+#include "ns3/uinteger.h"
 #include "ns3/ipv4-list-routing.h"
 
 #include "ipv4-nix-vector-routing.h"
@@ -35,6 +37,21 @@ NS_LOG_COMPONENT_DEFINE ("Ipv4NixVectorRouting");
 NS_OBJECT_ENSURE_REGISTERED (Ipv4NixVectorRouting);
 
 bool Ipv4NixVectorRouting::g_isCacheDirty = false;
+bool Ipv4NixVectorRouting::g_isTopologyDirty = true;
+Ipv4NixVectorRouting::NixTopology Ipv4NixVectorRouting::g_topology;
+Ipv4NixVectorRouting::NixCache_t Ipv4NixVectorRouting::g_nixCache;
+std::list<Ipv4NixVectorRouting::NixCacheKey_t> Ipv4NixVectorRouting::g_nixCacheLru;
+uint32_t Ipv4NixVectorRouting::g_nInstances = 0;
+
+/**
+ * \ingroup nix-vector-routing
+ * Maximum number of nix-vectors held in the shared cache (0 means unbounded)
+ */
+static GlobalValue g_nixVectorCacheSize = GlobalValue ("NixVectorCacheSize",
+                                                       "The maximum number of nix-vectors kept in the cache "
+                                                       "shared by all the nodes (0 means unbounded)",
+                                                       UintegerValue (100000),
+                                                       MakeUintegerChecker<uint32_t> ());
 
 TypeId 
 Ipv4NixVectorRouting::GetTypeId (void)
@@ -51,11 +68,24 @@ Ipv4NixVectorRouting::Ipv4NixVectorRouting ()
   : m_totalNeighbors (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
+  g_nInstances++;
+  g_isTopologyDirty = true;
 }
 
 Ipv4NixVectorRouting::~Ipv4NixVectorRouting ()
 {
   NS_LOG_FUNCTION_NOARGS ();
+
+  // release the shared state along with the last instance
+  NS_ASSERT (g_nInstances > 0);
+  if (--g_nInstances == 0)
+    {
+      g_nixCache.clear ();
+      g_nixCacheLru.clear ();
+      g_topology = NixTopology ();
+      g_isTopologyDirty = true;
+      g_isCacheDirty = false;
+    }
 }
 
 void
@@ -73,8 +103,18 @@ Ipv4NixVectorRouting::DoDispose ()
 {
   NS_LOG_FUNCTION_NOARGS ();
 
+  if (m_node != 0)
+    {
+      m_node->UnregisterDeviceAdditionListener (MakeCallback (&Ipv4NixVectorRouting::NotifyDeviceAdded, this));
+    }
   m_node = 0;
   m_ipv4 = 0;
+  FlushIpv4RouteCache ();
+
+  // the compact topology holds references to the Ipv4 objects of
+  // all the nodes, which would otherwise never be released
+  g_topology = NixTopology ();
+  g_isTopologyDirty = true;
 
   Ipv4RoutingProtocol::DoDispose ();
 }
@@ -86,12 +126,15 @@ Ipv4NixVectorRouting::SetNode (Ptr<Node> node)
   NS_LOG_FUNCTION_NOARGS ();
 
   m_node = node;
+  m_node->RegisterDeviceAdditionListener (MakeCallback (&Ipv4NixVectorRouting::NotifyDeviceAdded, this));
 }
 
 void
 Ipv4NixVectorRouting::FlushGlobalNixRoutingCache (void) const
 {
   NS_LOG_FUNCTION_NOARGS ();
+  FlushNixCache ();
+  g_isTopologyDirty = true;
   NodeList::Iterator listEnd = NodeList::End ();
   for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
     {
@@ -102,8 +145,8 @@ Ipv4NixVectorRouting::FlushGlobalNixRoutingCache (void) const
           continue;
         }
       NS_LOG_LOGIC ("Flushing Nix caches.");
-      rp->FlushNixCache ();
       rp->FlushIpv4RouteCache ();
+      rp->ResetTotalNeighbors ();
     }
 }
 
@@ -111,7 +154,8 @@ void
 Ipv4NixVectorRouting::FlushNixCache (void) const
 {
   NS_LOG_FUNCTION_NOARGS ();
-  m_nixCache.clear ();
+  g_nixCache.clear ();
+  g_nixCacheLru.clear ();
 }
 
 void
@@ -119,10 +163,27 @@ Ipv4NixVectorRouting::FlushIpv4RouteCache (void) const
 {
   NS_LOG_FUNCTION_NOARGS ();
   m_ipv4RouteCache.clear ();
+  m_ipv4RouteCacheLru.clear ();
+}
+
+void
+Ipv4NixVectorRouting::ResetTotalNeighbors (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_totalNeighbors = 0;
+}
+
+uint32_t
+Ipv4NixVectorRouting::GetMaxCacheEntries (void)
+{
+  UintegerValue cacheSize;
+  g_nixVectorCacheSize.GetValue (cacheSize);
+  return cacheSize.Get ();
 }
 
 Ptr<NixVector>
-Ipv4NixVectorRouting::GetNixVector (Ptr<Node> source, Ipv4Address dest, Ptr<NetDevice> oif)
+Ipv4NixVectorRouting::GetNixVector (Ptr<Node> source, Ipv4Address dest, Ptr<NetDevice> oif,
+                                    std::vector<uint32_t> & links)
 {
   NS_LOG_FUNCTION_NOARGS ();
 
@@ -150,11 +211,13 @@ Ipv4NixVectorRouting::GetNixVector (Ptr<Node> source, Ipv4Address dest, Ptr<NetD
     {
       // otherwise proceed as normal 
       // and build the nix vector
-      std::vector< Ptr<Node> > parentVector;
+      // the parent of each node, sized to the topology by BFS
+      std::vector<int32_t> parentVector;
 
-      BFS (NodeList::GetNNodes (), source, destNode, parentVector, oif);
+      BFS (source->GetId (), destNode->GetId (), parentVector, oif);
 
-      if (BuildNixVector (parentVector, source->GetId (), destNode->GetId (), nixVector))
+      links.clear ();
+      if (BuildNixVector (parentVector, source->GetId (), destNode->GetId (), nixVector, links))
         {
           return nixVector;
         }
@@ -173,17 +236,51 @@ Ipv4NixVectorRouting::GetNixVectorInCache (Ipv4Address address)
 
   CheckCacheStateAndFlush ();
 
-  NixMap_t::iterator iter = m_nixCache.find (address);
-  if (iter != m_nixCache.end ())
+  NixCache_t::iterator iter = g_nixCache.find (NixCacheKey_t (m_node->GetId (), address));
+  if (iter != g_nixCache.end ())
     {
       NS_LOG_LOGIC ("Found Nix-vector in cache.");
-      return iter->second;
+      // move to the front of the LRU list
+      g_nixCacheLru.splice (g_nixCacheLru.begin (), g_nixCacheLru, iter->second.lruIterator);
+      return iter->second.nixVector;
     }
 
   // not in cache
   return 0;
 }
 
+void
+Ipv4NixVectorRouting::AddNixVectorInCache (Ipv4Address address, Ptr<NixVector> nixVector,
+                                           const std::vector<uint32_t> & links)
+{
+  NS_LOG_FUNCTION (this << address);
+
+  uint32_t maxEntries = GetMaxCacheEntries ();
+
+  NixCacheKey_t key (m_node->GetId (), address);
+  NixCache_t::iterator iter = g_nixCache.find (key);
+  if (iter != g_nixCache.end ())
+    {
+      g_nixCacheLru.erase (iter->second.lruIterator);
+      g_nixCache.erase (iter);
+    }
+
+  while (maxEntries != 0 && g_nixCache.size () >= maxEntries)
+    {
+      NS_LOG_LOGIC ("Nix-vector cache full, evicting the least recently used entry");
+      iter = g_nixCache.find (g_nixCacheLru.back ());
+      NS_ASSERT (iter != g_nixCache.end ());
+      g_nixCacheLru.pop_back ();
+      g_nixCache.erase (iter);
+    }
+
+  g_nixCacheLru.push_front (key);
+  NixCacheEntry & entry = g_nixCache[key];
+  entry.nixVector = nixVector;
+  entry.links = links;
+  entry.lruIterator = g_nixCacheLru.begin ();
+}
+
 Ptr<Ipv4Route>
 Ipv4NixVectorRouting::GetIpv4RouteInCache (Ipv4Address address)
 {
@@ -191,17 +288,53 @@ Ipv4NixVectorRouting::GetIpv4RouteInCache (Ipv4Address address)
 
   CheckCacheStateAndFlush ();
 
-  Ipv4RouteMap_t::iterator iter = m_ipv4RouteCache.find (address);
+  Ipv4RouteCache_t::iterator iter = m_ipv4RouteCache.find (address);
   if (iter != m_ipv4RouteCache.end ())
     {
       NS_LOG_LOGIC ("Found Ipv4Route in cache.");
-      return iter->second;
+      // move to the front of the LRU list
+      m_ipv4RouteCacheLru.splice (m_ipv4RouteCacheLru.begin (), m_ipv4RouteCacheLru, iter->second.lruIterator);
+      return iter->second.route;
     }
 
   // not in cache
   return 0;
 }
 
+void
+Ipv4NixVectorRouting::AddIpv4RouteInCache (Ipv4Address address, Ptr<Ipv4Route> route)
+{
+  NS_LOG_FUNCTION (this << address);
+
+  uint32_t maxEntries = GetMaxCacheEntries ();
+
+  EraseIpv4RouteInCache (address);
+  while (maxEntries != 0 && m_ipv4RouteCache.size () >= maxEntries)
+    {
+      NS_LOG_LOGIC ("Ipv4Route cache full, evicting the least recently used entry");
+      m_ipv4RouteCache.erase (m_ipv4RouteCacheLru.back ());
+      m_ipv4RouteCacheLru.pop_back ();
+    }
+
+  m_ipv4RouteCacheLru.push_front (address);
+  Ipv4RouteCacheEntry & entry = m_ipv4RouteCache[address];
+  entry.route = route;
+  entry.lruIterator = m_ipv4RouteCacheLru.begin ();
+}
+
+void
+Ipv4NixVectorRouting::EraseIpv4RouteInCache (Ipv4Address address)
+{
+  NS_LOG_FUNCTION (this << address);
+
+  Ipv4RouteCache_t::iterator iter = m_ipv4RouteCache.find (address);
+  if (iter != m_ipv4RouteCache.end ())
+    {
+      m_ipv4RouteCacheLru.erase (iter->second.lruIterator);
+      m_ipv4RouteCache.erase (iter);
+    }
+}
+
 bool
 Ipv4NixVectorRouting::BuildNixVectorLocal (Ptr<NixVector> nixVector)
 {
@@ -230,7 +363,8 @@ Ipv4NixVectorRouting::BuildNixVectorLocal (Ptr<NixVector> nixVector)
 }
 
 bool
-Ipv4NixVectorRouting::BuildNixVector (const std::vector< Ptr<Node> > & parentVector, uint32_t source, uint32_t dest, Ptr<NixVector> nixVector)
+Ipv4NixVectorRouting::BuildNixVector (const std::vector<int32_t> & parentVector, uint32_t source, uint32_t dest,
+                                      Ptr<NixVector> nixVector, std::vector<uint32_t> & links)
 {
   NS_LOG_FUNCTION_NOARGS ();
 
@@ -239,66 +373,40 @@ Ipv4NixVectorRouting::BuildNixVector (const std::vector< Ptr<Node> > & parentVec
       return true;
     }
 
-  if (parentVector.at (dest) == 0)
+  if (parentVector.at (dest) < 0)
     {
       return false;
     }
 
-  Ptr<Node> parentNode = parentVector.at (dest);
-
-  uint32_t numberOfDevices = parentNode->GetNDevices ();
+  uint32_t parentNode = parentVector.at (dest);
+  uint32_t first = g_topology.offsets[parentNode];
+  uint32_t totalNeighbors = g_topology.offsets[parentNode + 1] - first;
   uint32_t destId = 0;
-  uint32_t totalNeighbors = 0;
 
-  // scan through the net devices on the parent node
-  // and then look at the nodes adjacent to them
-  for (uint32_t i = 0; i < numberOfDevices; i++)
+  // scan through the neighbors of the parent node; if we
+  // find the node that matches "dest" then we can add
+  // the index to the nix vector.
+  for (uint32_t i = 0; i < totalNeighbors; i++)
     {
-      // Get a net device from the node
-      // as well as the channel, and figure
-      // out the adjacent net devices
-      Ptr<NetDevice> localNetDevice = parentNode->GetDevice (i);
-      if (localNetDevice->IsBridge ())
+      if (g_topology.remoteNode[first + i] == dest)
         {
-          continue;
+          destId = i;
         }
-      Ptr<Channel> channel = localNetDevice->GetChannel ();
-      if (channel == 0)
-        {
-          continue;
-        }
-
-      // this function takes in the local net dev, and channel, and
-      // writes to the netDeviceContainer the adjacent net devs
-      NetDeviceContainer netDeviceContainer;
-      GetAdjacentNetDevices (localNetDevice, channel, netDeviceContainer);
-
-      // Finally we can get the adjacent nodes
-      // and scan through them.  If we find the 
-      // node that matches "dest" then we can add 
-      // the index  to the nix vector.
-      // the index corresponds to the neighbor index
-      uint32_t offset = 0;
-      for (NetDeviceContainer::Iterator iter = netDeviceContainer.Begin (); iter != netDeviceContainer.End (); iter++)
-        {
-          Ptr<Node> remoteNode = (*iter)->GetNode ();
-
-          if (remoteNode->GetId () == dest)
-            {
-              destId = totalNeighbors + offset;
-            }
-          offset += 1;
-        }
-
-      totalNeighbors += netDeviceContainer.GetN ();
     }
   NS_LOG_LOGIC ("Adding Nix: " << destId << " with " 
-                               << nixVector->BitCount (totalNeighbors) << " bits, for node " << parentNode->GetId ());
+                               << nixVector->BitCount (totalNeighbors) << " bits, for node " << parentNode);
   nixVector->AddNeighborIndex (destId, nixVector->BitCount (totalNeighbors));
 
+  // remember the link, so that the path can be invalidated
+  // when any of its ends changes
+  links.push_back (parentNode);
+  links.push_back (g_topology.localDevice[first + destId]);
+  links.push_back (dest);
+  links.push_back (g_topology.remoteDevice[first + destId]);
+
   // recurse through parent vector, grabbing the path 
   // and building the nix vector
-  BuildNixVector (parentVector, source, (parentVector.at (dest))->GetId (), nixVector);
+  BuildNixVector (parentVector, source, parentNode, nixVector, links);
   return true;
 }
 
@@ -347,27 +455,16 @@ Ipv4NixVectorRouting::GetNodeByIp (Ipv4Address dest)
 { 
   NS_LOG_FUNCTION_NOARGS ();
 
-  NodeContainer allNodes = NodeContainer::GetGlobal ();
-  Ptr<Node> destNode;
+  CheckTopologyAndBuild ();
 
-  for (NodeContainer::Iterator i = allNodes.Begin (); i != allNodes.End (); ++i)
-    {
-      Ptr<Node> node = *i;
-      Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-      if (ipv4->GetInterfaceForAddress (dest) != -1)
-        {
-          destNode = node;
-          break;
-        }
-    }
-
-  if (!destNode)
+  std::map<Ipv4Address, uint32_t>::const_iterator it = g_topology.addressToNode.find (dest);
+  if (it == g_topology.addressToNode.end ())
     {
       NS_LOG_ERROR ("Couldn't find dest node given the IP" << dest);
       return 0;
     }
 
-  return destNode;
+  return NodeList::GetNode (it->second);
 }
 
 uint32_t
@@ -402,7 +499,7 @@ Ipv4NixVectorRouting::FindTotalNeighbors (void)
 }
 
 Ptr<BridgeNetDevice>
-Ipv4NixVectorRouting::NetDeviceIsBridged (Ptr<NetDevice> nd) const
+Ipv4NixVectorRouting::NetDeviceIsBridged (Ptr<NetDevice> nd)
 {
   NS_LOG_FUNCTION (nd);
 
@@ -507,10 +604,14 @@ Ipv4NixVectorRouting::RouteOutput (Ptr<Packet> p, const Ipv4Header &header, Ptr<
       NS_LOG_LOGIC ("Nix-vector not in cache, build: ");
       // Build the nix-vector, given this node and the
       // dest IP address
-      nixVectorInCache = GetNixVector (m_node, header.GetDestination (), oif);
+      std::vector<uint32_t> links;
+      nixVectorInCache = GetNixVector (m_node, header.GetDestination (), oif, links);
 
       // cache it
-      m_nixCache.insert (NixMap_t::value_type (header.GetDestination (), nixVectorInCache));
+      if (nixVectorInCache)
+        {
+          AddNixVectorInCache (header.GetDestination (), nixVectorInCache, links);
+        }
     }
 
   // path exists
@@ -548,7 +649,7 @@ Ipv4NixVectorRouting::RouteOutput (Ptr<Packet> p, const Ipv4Header &header, Ptr<
           // rtentry from the map
           if (rtentry)
             {
-              m_ipv4RouteCache.erase (header.GetDestination ());
+              EraseIpv4RouteInCache (header.GetDestination ());
             }
 
           NS_LOG_LOGIC ("Ipv4Route not in cache, build: ");
@@ -588,7 +689,7 @@ Ipv4NixVectorRouting::RouteOutput (Ptr<Packet> p, const Ipv4Header &header, Ptr<
           sockerr = Socket::ERROR_NOTERROR;
 
           // add rtentry to cache
-          m_ipv4RouteCache.insert (Ipv4RouteMap_t::value_type (header.GetDestination (), rtentry));
+          AddIpv4RouteInCache (header.GetDestination (), rtentry);
         }
 
       NS_LOG_LOGIC ("Nix-vector contents: " << *nixVectorInCache << " : Remaining bits: " << nixVectorForPacket->GetRemainingBits ());
@@ -680,7 +781,7 @@ Ipv4NixVectorRouting::RouteInput (Ptr<const Packet> p, const Ipv4Header &header,
       rtentry->SetOutputDevice (m_ipv4->GetNetDevice (interfaceIndex));
 
       // add rtentry to cache
-      m_ipv4RouteCache.insert (Ipv4RouteMap_t::value_type (header.GetDestination (), rtentry));
+      AddIpv4RouteInCache (header.GetDestination (), rtentry);
     }
 
   NS_LOG_LOGIC ("At Node " << m_node->GetId () << ", Extracting " << numberOfBits <<
@@ -709,38 +810,41 @@ Ipv4NixVectorRouting::PrintRoutingTable (Ptr<OutputStreamWrapper> stream, Time::
       << ", Nix Routing" << std::endl;
 
   *os << "NixCache:" << std::endl;
-  if (m_nixCache.size () > 0)
+  uint32_t nodeId = m_node->GetId ();
+  NixCache_t::const_iterator begin = g_nixCache.lower_bound (NixCacheKey_t (nodeId, Ipv4Address::GetZero ()));
+  if (begin != g_nixCache.end () && begin->first.first == nodeId)
     {
       *os << "Destination     NixVector" << std::endl;
-      for (NixMap_t::const_iterator it = m_nixCache.begin (); it != m_nixCache.end (); it++)
+      for (NixCache_t::const_iterator it = begin; it != g_nixCache.end () && it->first.first == nodeId; it++)
         {
           std::ostringstream dest;
-          dest << it->first;
+          dest << it->first.second;
           *os << std::setiosflags (std::ios::left) << std::setw (16) << dest.str ();
-          *os << *(it->second) << std::endl;
+          *os << *(it->second.nixVector) << std::endl;
         }
     }
   *os << "Ipv4RouteCache:" << std::endl;
   if (m_ipv4RouteCache.size () > 0)
     {
       *os << "Destination     Gateway         Source            OutputDevice" << std::endl;
-      for (Ipv4RouteMap_t::const_iterator it = m_ipv4RouteCache.begin (); it != m_ipv4RouteCache.end (); it++)
+      for (Ipv4RouteCache_t::const_iterator it = m_ipv4RouteCache.begin (); it != m_ipv4RouteCache.end (); it++)
         {
+          Ptr<Ipv4Route> route = it->second.route;
           std::ostringstream dest, gw, src;
-          dest << it->second->GetDestination ();
+          dest << route->GetDestination ();
           *os << std::setiosflags (std::ios::left) << std::setw (16) << dest.str ();
-          gw << it->second->GetGateway ();
+          gw << route->GetGateway ();
           *os << std::setiosflags (std::ios::left) << std::setw (16) << gw.str ();
-          src << it->second->GetSource ();
+          src << route->GetSource ();
           *os << std::setiosflags (std::ios::left) << std::setw (16) << src.str ();
           *os << "  ";
-          if (Names::FindName (it->second->GetOutputDevice ()) != "")
+          if (Names::FindName (route->GetOutputDevice ()) != "")
             {
-              *os << Names::FindName (it->second->GetOutputDevice ());
+              *os << Names::FindName (route->GetOutputDevice ());
             }
           else
             {
-              *os << it->second->GetOutputDevice ()->GetIfIndex ();
+              *os << route->GetOutputDevice ()->GetIfIndex ();
             }
           *os << std::endl;
         }
@@ -752,58 +856,249 @@ Ipv4NixVectorRouting::PrintRoutingTable (Ptr<OutputStreamWrapper> stream, Time::
 void
 Ipv4NixVectorRouting::NotifyInterfaceUp (uint32_t i)
 {
-  g_isCacheDirty = true;
+  // a new link may shorten any path
+  NotifyTopologyChange (i, true);
 }
 void
 Ipv4NixVectorRouting::NotifyInterfaceDown (uint32_t i)
 {
-  g_isCacheDirty = true;
+  NotifyTopologyChange (i, false);
 }
 void
 Ipv4NixVectorRouting::NotifyAddAddress (uint32_t interface, Ipv4InterfaceAddress address)
 {
-  g_isCacheDirty = true;
+  NotifyTopologyChange (interface, true);
 }
 void
 Ipv4NixVectorRouting::NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress address)
 {
+  NotifyTopologyChange (interface, false);
+  InvalidateDestination (address.GetLocal ());
+}
+
+void
+Ipv4NixVectorRouting::NotifyTopologyChange (uint32_t interface, bool fullFlush)
+{
+  NS_LOG_FUNCTION (this << interface << fullFlush);
+
+  g_isTopologyDirty = true;
+  if (fullFlush || g_isCacheDirty)
+    {
+      g_isCacheDirty = true;
+      return;
+    }
+  if (g_nixCache.empty () || m_node == 0 || m_ipv4 == 0)
+    {
+      return;
+    }
+  Ptr<NetDevice> device = m_ipv4->GetNetDevice (interface);
+  if (device)
+    {
+      InvalidateLink (m_node->GetId (), device->GetIfIndex ());
+    }
+}
+
+void
+Ipv4NixVectorRouting::NotifyDeviceAdded (Ptr<NetDevice> device)
+{
+  NS_LOG_FUNCTION (this << device);
+
+  g_isTopologyDirty = true;
   g_isCacheDirty = true;
 }
 
+void
+Ipv4NixVectorRouting::InvalidateLink (uint32_t nodeId, uint32_t deviceIndex)
+{
+  NS_LOG_FUNCTION (nodeId << deviceIndex);
+
+  NixCache_t::iterator it = g_nixCache.begin ();
+  while (it != g_nixCache.end ())
+    {
+      const std::vector<uint32_t> & links = it->second.links;
+      bool traversed = false;
+      for (uint32_t i = 0; i < links.size (); i += 2)
+        {
+          if (links[i] == nodeId && links[i + 1] == deviceIndex)
+            {
+              traversed = true;
+              break;
+            }
+        }
+      if (traversed)
+        {
+          EraseCacheEntry (it++);
+        }
+      else
+        {
+          ++it;
+        }
+    }
+}
+
+void
+Ipv4NixVectorRouting::InvalidateDestination (Ipv4Address address)
+{
+  NS_LOG_FUNCTION (address);
+
+  NixCache_t::iterator it = g_nixCache.begin ();
+  while (it != g_nixCache.end ())
+    {
+      if (it->first.second == address)
+        {
+          EraseCacheEntry (it++);
+        }
+      else
+        {
+          ++it;
+        }
+    }
+}
+
+void
+Ipv4NixVectorRouting::EraseCacheEntry (NixCache_t::iterator it)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  Ipv4Address dest = it->first.second;
+  const std::vector<uint32_t> & links = it->second.links;
+
+  // every node along the path may have cached an Ipv4Route
+  // towards the destination
+  for (uint32_t i = 0; i < links.size (); i += 2)
+    {
+      if (links[i] >= NodeList::GetNNodes ())
+        {
+          continue;
+        }
+      Ptr<Ipv4NixVectorRouting> rp = NodeList::GetNode (links[i])->GetObject<Ipv4NixVectorRouting> ();
+      if (rp)
+        {
+          rp->EraseIpv4RouteInCache (dest);
+        }
+    }
+
+  g_nixCacheLru.erase (it->second.lruIterator);
+  g_nixCache.erase (it);
+}
+
+void
+Ipv4NixVectorRouting::CheckTopologyAndBuild (void)
+{
+  // nodes not running this protocol (e.g., bridges) do not notify
+  // their changes, but their creation is detected here
+  uint32_t nNodes = NodeList::GetNNodes ();
+  if (!g_isTopologyDirty && g_topology.offsets.size () == nNodes + 1)
+    {
+      return;
+    }
+  NS_LOG_FUNCTION_NOARGS ();
+
+  if (!g_topology.offsets.empty () && g_topology.offsets.size () != nNodes + 1)
+    {
+      // the new nodes may have changed the neighbors of existing ones
+      g_isCacheDirty = true;
+    }
+
+  NixTopology topology;
+  topology.offsets.reserve (nNodes + 1);
+  topology.ipv4.reserve (nNodes);
+
+  for (uint32_t n = 0; n < nNodes; n++)
+    {
+      Ptr<Node> node = NodeList::GetNode (n);
+      Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+      topology.offsets.push_back (topology.remoteNode.size ());
+      topology.ipv4.push_back (ipv4);
+
+      if (ipv4)
+        {
+          for (uint32_t i = 0; i < ipv4->GetNInterfaces (); i++)
+            {
+              for (uint32_t j = 0; j < ipv4->GetNAddresses (i); j++)
+                {
+                  // the first node owning an address wins, as
+                  // the nodes are walked in the NodeList order
+                  topology.addressToNode.insert (std::make_pair (ipv4->GetAddress (i, j).GetLocal (), n));
+                }
+            }
+        }
+
+      // the neighbors are stored in the same order used to
+      // compute the nix index of each hop
+      for (uint32_t i = 0; i < node->GetNDevices (); i++)
+        {
+          Ptr<NetDevice> localNetDevice = node->GetDevice (i);
+          if (localNetDevice->IsBridge ())
+            {
+              continue;
+            }
+          Ptr<Channel> channel = localNetDevice->GetChannel ();
+          if (channel == 0)
+            {
+              continue;
+            }
+          int32_t interface = ipv4 ? ipv4->GetInterfaceForDevice (localNetDevice) : -1;
+
+          NetDeviceContainer netDeviceContainer;
+          GetAdjacentNetDevices (localNetDevice, channel, netDeviceContainer);
+          for (NetDeviceContainer::Iterator iter = netDeviceContainer.Begin (); iter != netDeviceContainer.End (); iter++)
+            {
+              topology.remoteNode.push_back ((*iter)->GetNode ()->GetId ());
+              topology.localDevice.push_back (i);
+              topology.remoteDevice.push_back ((*iter)->GetIfIndex ());
+              topology.localInterface.push_back (interface);
+            }
+        }
+    }
+  topology.offsets.push_back (topology.remoteNode.size ());
+
+  NS_LOG_LOGIC ("Built compact topology with " << nNodes << " nodes and "
+                << topology.remoteNode.size () << " edges");
+  std::swap (g_topology, topology);
+  g_isTopologyDirty = false;
+}
+
 bool
-Ipv4NixVectorRouting::BFS (uint32_t numberOfNodes, Ptr<Node> source, 
-                           Ptr<Node> dest, std::vector< Ptr<Node> > & parentVector,
+Ipv4NixVectorRouting::BFS (uint32_t source, uint32_t dest,
+                           std::vector<int32_t> & parentVector,
                            Ptr<NetDevice> oif)
 {
   NS_LOG_FUNCTION_NOARGS ();
 
-  NS_LOG_LOGIC ("Going from Node " << source->GetId () << " to Node " << dest->GetId ());
-  std::queue< Ptr<Node> > greyNodeList;  // discovered nodes with unexplored children
+  NS_LOG_LOGIC ("Going from Node " << source << " to Node " << dest);
+
+  CheckTopologyAndBuild ();
+  uint32_t numberOfNodes = g_topology.offsets.size () - 1;
+
+  // discovered nodes with unexplored children, reserved to the
+  // topology size so that the search does not reallocate it
+  std::vector<uint32_t> greyNodeList;
+  greyNodeList.reserve (numberOfNodes);
 
   // reset the parent vector
-  parentVector.clear ();
-  parentVector.reserve (sizeof (Ptr<Node>)*numberOfNodes);
-  parentVector.insert (parentVector.begin (), sizeof (Ptr<Node>)*numberOfNodes, 0); // initialize to 0
+  parentVector.assign (numberOfNodes, -1);
 
   // Add the source node to the queue, set its parent to itself 
-  greyNodeList.push (source);
-  parentVector.at (source->GetId ()) = source;
+  greyNodeList.push_back (source);
+  parentVector.at (source) = source;
 
   // BFS loop
-  while (greyNodeList.size () != 0)
+  for (uint32_t head = 0; head < greyNodeList.size (); head++)
     {
-      Ptr<Node> currNode = greyNodeList.front ();
-      Ptr<Ipv4> ipv4 = currNode->GetObject<Ipv4> ();
+      uint32_t currNode = greyNodeList[head];
+      Ptr<Ipv4> ipv4 = g_topology.ipv4[currNode];
  
       if (currNode == dest) 
         {
-          NS_LOG_LOGIC ("Made it to Node " << currNode->GetId ());
+          NS_LOG_LOGIC ("Made it to Node " << currNode);
           return true;
         }
 
       // if this is the first iteration of the loop and a 
       // specific output interface was given, make sure 
       // we go this way
+      uint32_t oifIndex = 0;
       if (currNode == source && oif)
         {
           // make sure that we can go this way
@@ -821,97 +1116,58 @@ Ipv4NixVectorRouting::BFS (uint32_t numberOfNodes, Ptr<Node> source,
               NS_LOG_LOGIC ("Link is down.");
               return false;
             }
-          Ptr<Channel> channel = oif->GetChannel ();
-          if (channel == 0)
+          if (oif->GetChannel () == 0)
             { 
               return false;
             }
+          oifIndex = oif->GetIfIndex ();
+        }
 
-          // this function takes in the local net dev, and channel, and
-          // writes to the netDeviceContainer the adjacent net devs
-          NetDeviceContainer netDeviceContainer;
-          GetAdjacentNetDevices (oif, channel, netDeviceContainer);
-
-          // Finally we can get the adjacent nodes
-          // and scan through them.  We push them
-          // to the greyNode queue, if they aren't 
-          // already there.
-          for (NetDeviceContainer::Iterator iter = netDeviceContainer.Begin (); iter != netDeviceContainer.End (); iter++)
+      // Iterate over the current node's adjacent vertices
+      // and push them into the queue.  The edges of a device
+      // are contiguous, so its state is checked once.
+      Ptr<Node> node = NodeList::GetNode (currNode);
+      bool usable = false;
+      uint32_t lastDevice = std::numeric_limits<uint32_t>::max ();
+      for (uint32_t e = g_topology.offsets[currNode]; e < g_topology.offsets[currNode + 1]; e++)
+        {
+          uint32_t device = g_topology.localDevice[e];
+          if (currNode == source && oif && device != oifIndex)
             {
-              Ptr<Node> remoteNode = (*iter)->GetNode ();
-
-              // check to see if this node has been pushed before
-              // by checking to see if it has a parent
-              // if it doesn't (null or 0), then set its parent and 
-              // push to the queue
-              if (parentVector.at (remoteNode->GetId ()) == 0)
-                {
-                  parentVector.at (remoteNode->GetId ()) = currNode;
-                  greyNodeList.push (remoteNode);
-                }
+              continue;
             }
-        }
-      else
-        {
-          // Iterate over the current node's adjacent vertices
-          // and push them into the queue
-          for (uint32_t i = 0; i < (currNode->GetNDevices ()); i++)
+          if (device != lastDevice)
             {
-              // Get a net device from the node
-              // as well as the channel, and figure
-              // out the adjacent net device
-              Ptr<NetDevice> localNetDevice = currNode->GetDevice (i);
-
-              // make sure that we can go this way
-              if (ipv4)
+              lastDevice = device;
+              usable = true;
+              int32_t interface = g_topology.localInterface[e];
+              if (ipv4 && interface >= 0 && !(ipv4->IsUp (interface)))
                 {
-                  uint32_t interfaceIndex = (ipv4)->GetInterfaceForDevice (currNode->GetDevice (i));
-                  if (!(ipv4->IsUp (interfaceIndex)))
-                    {
-                      NS_LOG_LOGIC ("Ipv4Interface is down");
-                      continue;
-                    }
+                  NS_LOG_LOGIC ("Ipv4Interface is down");
+                  usable = false;
                 }
-              if (!(localNetDevice->IsLinkUp ()))
+              else if (!(node->GetDevice (device)->IsLinkUp ()))
                 {
                   NS_LOG_LOGIC ("Link is down.");
-                  continue;
-                }
-              Ptr<Channel> channel = localNetDevice->GetChannel ();
-              if (channel == 0)
-                { 
-                  continue;
+                  usable = false;
                 }
+            }
+          if (!usable)
+            {
+              continue;
+            }
 
-              // this function takes in the local net dev, and channel, and
-              // writes to the netDeviceContainer the adjacent net devs
-              NetDeviceContainer netDeviceContainer;
-              GetAdjacentNetDevices (localNetDevice, channel, netDeviceContainer);
-
-              // Finally we can get the adjacent nodes
-              // and scan through them.  We push them
-              // to the greyNode queue, if they aren't 
-              // already there.
-              for (NetDeviceContainer::Iterator iter = netDeviceContainer.Begin (); iter != netDeviceContainer.End (); iter++)
-                {
-                  Ptr<Node> remoteNode = (*iter)->GetNode ();
-
-                  // check to see if this node has been pushed before
-                  // by checking to see if it has a parent
-                  // if it doesn't (null or 0), then set its parent and 
-                  // push to the queue
-                  if (parentVector.at (remoteNode->GetId ()) == 0)
-                    {
-                      parentVector.at (remoteNode->GetId ()) = currNode;
-                      greyNodeList.push (remoteNode);
-                    }
-                }
+          // check to see if this node has been pushed before
+          // by checking to see if it has a parent
+          // if it doesn't, then set its parent and
+          // push to the queue
+          uint32_t remoteNode = g_topology.remoteNode[e];
+          if (parentVector[remoteNode] < 0)
+            {
+              parentVector[remoteNode] = currNode;
+              greyNodeList.push_back (remoteNode);
             }
         }
-
-      // Pop off the head grey node.  We have all its children.
-      // It is now black.
-      greyNodeList.pop ();
     }
 
   // Didn't find the dest...
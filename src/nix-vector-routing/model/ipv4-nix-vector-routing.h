@@ -22,6 +22,8 @@
 #define IPV4_NIX_VECTOR_ROUTING_H
 
 #include <map>
+#include <list>
+#include <vector>
 
 #include "ns3/channel.h"
 #include "ns3/node-container.h"
@@ -56,6 +58,23 @@ typedef std::map<Ipv4Address, Ptr<Ipv4Route> > Ipv4RouteMap_t;
 /**
  * \ingroup nix-vector-routing
  * Nix-vector routing protocol
+ *
+ * Nix-vectors are stored in a single least-recently-used cache shared
+ * by all the nodes and keyed by (source node, destination address).
+ * The size of the cache is bounded by the "NixVectorCacheSize" global
+ * value.  Routes are computed with a breadth-first search over a
+ * compact adjacency representation of the topology which is built
+ * once and rebuilt lazily after a topology change.
+ *
+ * The Ipv4Routes that each node builds towards the destinations it
+ * sends or forwards to are kept in a per-node least-recently-used
+ * cache, whose size is bounded by the same global value.
+ *
+ * The topology is marked for rebuild when an interface or an address
+ * of a node changes, when a device is added to a node running this
+ * protocol, and when the number of nodes changes.  Any other change
+ * (e.g., attaching an existing device to another channel later on)
+ * must be followed by a call to FlushGlobalNixRoutingCache.
  */
 class Ipv4NixVectorRouting : public Ipv4RoutingProtocol
 {
@@ -78,8 +97,8 @@ public:
 
   /**
    * @brief Called when run-time link topology change occurs
-   * which iterates through the node list and flushes any
-   * nix vector caches
+   * which flushes the shared nix-vector cache, iterates through
+   * the node list and flushes any Ipv4Route caches
    *
    * \internal
    * \c const is used here due to need to potentially flush the cache
@@ -90,6 +109,63 @@ public:
 
 private:
 
+  /**
+   * Key of the shared nix-vector cache: source node id and destination address.
+   */
+  typedef std::pair<uint32_t, Ipv4Address> NixCacheKey_t;
+
+  /**
+   * Entry of the shared nix-vector cache.
+   */
+  struct NixCacheEntry
+  {
+    Ptr<NixVector> nixVector; //!< the nix-vector from the source to the destination
+    /**
+     * Links traversed by the path, stored as a flat sequence of
+     * (node id, device index) pairs, two pairs (local and remote
+     * end) per hop.
+     */
+    std::vector<uint32_t> links;
+    std::list<NixCacheKey_t>::iterator lruIterator; //!< position in the LRU list
+  };
+
+  /**
+   * Map of (source, destination) to the cached nix-vector
+   */
+  typedef std::map<NixCacheKey_t, NixCacheEntry> NixCache_t;
+
+  /**
+   * Entry of the per-node Ipv4Route cache.
+   */
+  struct Ipv4RouteCacheEntry
+  {
+    Ptr<Ipv4Route> route; //!< the route towards the destination
+    std::list<Ipv4Address>::iterator lruIterator; //!< position in the LRU list
+  };
+
+  /**
+   * Map of destination to the cached Ipv4Route
+   */
+  typedef std::map<Ipv4Address, Ipv4RouteCacheEntry> Ipv4RouteCache_t;
+
+  /**
+   * Compact adjacency (CSR) representation of the whole topology.
+   *
+   * The neighbors of node n are stored in the edge arrays between
+   * offsets[n] and offsets[n+1], in neighbor-index order (i.e., the
+   * position of an edge in this range is its nix index).
+   */
+  struct NixTopology
+  {
+    std::vector<uint32_t> offsets;        //!< start of the edges of each node (size nNodes+1)
+    std::vector<uint32_t> remoteNode;     //!< remote node id of each edge
+    std::vector<uint32_t> localDevice;    //!< local device index of each edge
+    std::vector<uint32_t> remoteDevice;   //!< remote device index of each edge
+    std::vector<int32_t> localInterface;  //!< local Ipv4 interface of each edge (-1 if none)
+    std::vector<Ptr<Ipv4> > ipv4;         //!< Ipv4 object of each node (may be null)
+    std::map<Ipv4Address, uint32_t> addressToNode; //!< node owning each address
+  };
+
   /**
    * Flushes the cache which stores nix-vector based on
    * destination IP
@@ -117,17 +193,30 @@ private:
    * \param source Source node
    * \param dest Destination node address
    * \param oif Preferred output interface
+   * \param [out] links the links traversed by the path
    * \returns The NixVector to be used in routing.
    */
-  Ptr<NixVector> GetNixVector (Ptr<Node> source, Ipv4Address dest, Ptr<NetDevice> oif);
+  Ptr<NixVector> GetNixVector (Ptr<Node> source, Ipv4Address dest, Ptr<NetDevice> oif,
+                               std::vector<uint32_t> & links);
 
   /**
-   * Checks the cache based on dest IP for the nix-vector
+   * Checks the shared cache based on this node and dest IP
+   * for the nix-vector, and refreshes its LRU position if found
    * \param address Address to check
    * \returns The NixVector to be used in routing.
    */
   Ptr<NixVector> GetNixVectorInCache (Ipv4Address address);
 
+  /**
+   * Inserts a nix-vector in the shared cache, evicting the least
+   * recently used entries if the cache is full
+   * \param address the destination address
+   * \param nixVector the nix-vector to cache
+   * \param links the links traversed by the path
+   */
+  void AddNixVectorInCache (Ipv4Address address, Ptr<NixVector> nixVector,
+                            const std::vector<uint32_t> & links);
+
   /**
    * Checks the cache based on dest IP for the Ipv4Route
    * \param address Address to check
@@ -135,6 +224,26 @@ private:
    */
   Ptr<Ipv4Route> GetIpv4RouteInCache (Ipv4Address address);
 
+  /**
+   * Inserts an Ipv4Route in the cache of this node, evicting the least
+   * recently used entries if the cache is full
+   * \param address the destination address
+   * \param route the route to cache
+   */
+  void AddIpv4RouteInCache (Ipv4Address address, Ptr<Ipv4Route> route);
+
+  /**
+   * Removes the Ipv4Route towards the given destination from the
+   * cache of this node, if any
+   * \param address the destination address
+   */
+  void EraseIpv4RouteInCache (Ipv4Address address);
+
+  /**
+   * \returns the maximum number of entries of each cache (0 means unbounded)
+   */
+  static uint32_t GetMaxCacheEntries (void);
+
   /**
    * Given a net-device returns all the adjacent net-devices,
    * essentially getting the neighbors on that channel
@@ -142,11 +251,10 @@ private:
    * \param [in] channel the channel to check
    * \param [out] netDeviceContainer the NetDeviceContainer of the NetDevices in the channel.
    */
-  void GetAdjacentNetDevices (Ptr<NetDevice> netDevice, Ptr<Channel> channel, NetDeviceContainer & netDeviceContainer);
+  static void GetAdjacentNetDevices (Ptr<NetDevice> netDevice, Ptr<Channel> channel, NetDeviceContainer & netDeviceContainer);
 
   /**
-   * Iterates through the node list and finds the one
-   * corresponding to the given Ipv4Address
+   * Finds the node corresponding to the given Ipv4Address
    * \param dest destination node IP
    * \return The node with the specified IP.
    */
@@ -158,9 +266,11 @@ private:
    * \param [in] source Source Node index
    * \param [in] dest Destination Node index
    * \param [out] nixVector the NixVector to be used for routing
+   * \param [out] links the links traversed by the path
    * \returns true on success, false otherwise.
    */
-  bool BuildNixVector (const std::vector< Ptr<Node> > & parentVector, uint32_t source, uint32_t dest, Ptr<NixVector> nixVector);
+  bool BuildNixVector (const std::vector<int32_t> & parentVector, uint32_t source, uint32_t dest,
+                       Ptr<NixVector> nixVector, std::vector<uint32_t> & links);
 
   /**
    * Special variation of BuildNixVector for when a node is sending to itself
@@ -181,7 +291,7 @@ private:
    * \param nd the NetDevice to check
    * \returns the bridging NetDevice (or null if the NetDevice is not bridged)
    */
-  Ptr<BridgeNetDevice> NetDeviceIsBridged (Ptr<NetDevice> nd) const;
+  static Ptr<BridgeNetDevice> NetDeviceIsBridged (Ptr<NetDevice> nd);
 
 
   /**
@@ -194,20 +304,61 @@ private:
   uint32_t FindNetDeviceForNixIndex (uint32_t nodeIndex, Ipv4Address & gatewayIp);
 
   /**
-   * \brief Breadth first search algorithm.
-   * \param [in] numberOfNodes total number of nodes
-   * \param [in] source Source Node
-   * \param [in] dest Destination Node
-   * \param [out] parentVector Parent vector for retracing routes
+   * \brief Breadth first search algorithm on the compact topology.
+   * \param [in] source Source Node id
+   * \param [in] dest Destination Node id
+   * \param [out] parentVector Parent vector for retracing routes (-1 if not reached)
    * \param [in] oif specific output interface to use from source node, if not null
    * \returns false if dest not found, true o.w.
    */
-  bool BFS (uint32_t numberOfNodes,
-            Ptr<Node> source,
-            Ptr<Node> dest,
-            std::vector< Ptr<Node> > & parentVector,
+  bool BFS (uint32_t source,
+            uint32_t dest,
+            std::vector<int32_t> & parentVector,
             Ptr<NetDevice> oif);
 
+  /**
+   * Rebuilds the compact topology representation if it is out of date.
+   */
+  static void CheckTopologyAndBuild (void);
+
+  /**
+   * Removes from the shared cache all the paths traversing the
+   * given device, and the Ipv4Routes built for them.
+   * \param nodeId the node owning the device
+   * \param deviceIndex the index of the device in the node
+   */
+  static void InvalidateLink (uint32_t nodeId, uint32_t deviceIndex);
+
+  /**
+   * Removes from the shared cache all the paths towards the
+   * given address, and the Ipv4Routes built for them.
+   * \param address the destination address
+   */
+  static void InvalidateDestination (Ipv4Address address);
+
+  /**
+   * Removes an entry from the shared cache, along with the Ipv4Routes
+   * cached for its destination by the nodes along its path.
+   * \param it the entry to erase
+   */
+  static void EraseCacheEntry (NixCache_t::iterator it);
+
+  /**
+   * Handles a change of the given interface: paths traversing it are
+   * invalidated, and the topology is marked for rebuild.
+   * \param interface the interface index
+   * \param fullFlush whether the whole cache has to be flushed
+   */
+  void NotifyTopologyChange (uint32_t interface, bool fullFlush);
+
+  /**
+   * Handles the addition of a device to the node: the neighbor indices
+   * of the node may change, so all the caches are flushed and the
+   * topology is marked for rebuild.
+   * \param device the new device
+   */
+  void NotifyDeviceAdded (Ptr<NetDevice> device);
+
   void DoDispose (void);
 
   /* From Ipv4RoutingProtocol */
@@ -233,11 +384,26 @@ private:
    */
   static bool g_isCacheDirty;
 
-  /** Cache stores nix-vectors based on destination ip */
-  mutable NixMap_t m_nixCache;
+  /** Flag to mark when the compact topology must be rebuilt */
+  static bool g_isTopologyDirty;
+
+  /** Compact topology shared by all the instances */
+  static NixTopology g_topology;
+
+  /** Shared cache of nix-vectors based on source node and destination ip */
+  static NixCache_t g_nixCache;
+
+  /** Shared cache keys, most recently used first */
+  static std::list<NixCacheKey_t> g_nixCacheLru;
+
+  /** Number of live instances, to release the shared state */
+  static uint32_t g_nInstances;
 
   /** Cache stores Ipv4Routes based on destination ip */
-  mutable Ipv4RouteMap_t m_ipv4RouteCache;
+  mutable Ipv4RouteCache_t m_ipv4RouteCache;
+
+  /** Cached destinations, most recently used first */
+  mutable std::list<Ipv4Address> m_ipv4RouteCacheLru;
 
   Ptr<Ipv4> m_ipv4; //!< IPv4 object
   Ptr<Node> m_node; //!< Node object
@@ -0,0 +1,451 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <map>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/global-value.h"
+#include "ns3/uinteger.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/nix-vector.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-interface-container.h"
+#include "ns3/ipv4-nix-vector-helper.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup nix-vector-routing
+ * \defgroup nix-vector-routing-test Nix-vector routing tests
+ */
+
+/**
+ * Connects nodes through a single channel and assigns them addresses
+ * in a new network.
+ * \param nodes the nodes to connect
+ * \param address the address helper
+ * \returns the addresses of the nodes on the channel
+ */
+static Ipv4InterfaceContainer
+Connect (NodeContainer nodes, Ipv4AddressHelper &address)
+{
+  SimpleNetDeviceHelper simple;
+  Ipv4InterfaceContainer interfaces = address.Assign (simple.Install (nodes));
+  address.NewNetwork ();
+  return interfaces;
+}
+
+/**
+ * Asks the routing protocol of a node for a route.
+ * \param node the source node
+ * \param dest the destination address
+ * \param p the packet which receives the nix-vector (may be null)
+ * \returns the route
+ */
+static Ptr<Ipv4Route>
+RouteTo (Ptr<Node> node, Ipv4Address dest, Ptr<Packet> p)
+{
+  Ipv4Header header;
+  header.SetDestination (dest);
+  Socket::SocketErrno sockerr;
+  return node->GetObject<Ipv4> ()->GetRoutingProtocol ()->RouteOutput (p, header, 0, sockerr);
+}
+
+/**
+ * Reads the destinations held in the caches of a node from its
+ * routing table printout.
+ * \param node the node
+ * \returns the destinations of the "NixCache" and "Ipv4RouteCache" sections
+ */
+static std::map<std::string, std::set<std::string> >
+GetCachedDestinations (Ptr<Node> node)
+{
+  std::ostringstream oss;
+  node->GetObject<Ipv4> ()->GetRoutingProtocol ()->PrintRoutingTable (Create<OutputStreamWrapper> (&oss));
+
+  std::map<std::string, std::set<std::string> > caches;
+  std::istringstream iss (oss.str ());
+  std::string line;
+  std::string section;
+  while (std::getline (iss, line))
+    {
+      if (line == "NixCache:" || line == "Ipv4RouteCache:")
+        {
+          section = line.substr (0, line.size () - 1);
+          caches[section];
+        }
+      else if (!section.empty () && !line.empty () && line.compare (0, 11, "Destination") != 0)
+        {
+          std::istringstream fields (line);
+          std::string dest;
+          fields >> dest;
+          caches[section].insert (dest);
+        }
+    }
+  return caches;
+}
+
+/**
+ * \param address an address
+ * \returns the address as a string
+ */
+static std::string
+ToString (Ipv4Address address)
+{
+  std::ostringstream oss;
+  oss << address;
+  return oss.str ();
+}
+
+/**
+ * \ingroup nix-vector-routing-test
+ * \ingroup tests
+ *
+ * Checks that the nix-vector and Ipv4Route caches are bounded by the
+ * "NixVectorCacheSize" global value and evict the least recently used
+ * entries.
+ */
+class NixVectorRoutingLruTestCase : public TestCase
+{
+public:
+  NixVectorRoutingLruTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+NixVectorRoutingLruTestCase::NixVectorRoutingLruTestCase ()
+  : TestCase ("Bounded caches with least-recently-used eviction")
+{
+}
+
+void
+NixVectorRoutingLruTestCase::DoRun (void)
+{
+  UintegerValue cacheSize;
+  GlobalValue::GetValueByName ("NixVectorCacheSize", cacheSize);
+  Config::SetGlobal ("NixVectorCacheSize", UintegerValue (3));
+
+  // a hub connected to 5 leaves
+  NodeContainer nodes;
+  nodes.Create (6);
+  InternetStackHelper internet;
+  internet.SetRoutingHelper (Ipv4NixVectorHelper ());
+  internet.Install (nodes);
+  Ipv4AddressHelper address ("10.1.0.0", "255.255.255.0");
+  std::vector<std::string> leaves;
+  for (uint32_t i = 1; i < nodes.GetN (); i++)
+    {
+      leaves.push_back (ToString (Connect (NodeContainer (nodes.Get (0), nodes.Get (i)), address).GetAddress (1)));
+    }
+  Ptr<Node> hub = nodes.Get (0);
+
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      NS_TEST_ASSERT_MSG_NE (RouteTo (hub, Ipv4Address (leaves[i].c_str ()), 0), 0, "no route to leaf " << i);
+    }
+  std::map<std::string, std::set<std::string> > caches = GetCachedDestinations (hub);
+  NS_TEST_ASSERT_MSG_EQ (caches["NixCache"].size (), 3, "wrong number of nix-vectors");
+  NS_TEST_ASSERT_MSG_EQ (caches["Ipv4RouteCache"].size (), 3, "wrong number of routes");
+
+  // refresh the first leaf, then let the fourth one evict the second one
+  RouteTo (hub, Ipv4Address (leaves[0].c_str ()), 0);
+  RouteTo (hub, Ipv4Address (leaves[3].c_str ()), 0);
+  caches = GetCachedDestinations (hub);
+  std::set<std::string> expected;
+  expected.insert (leaves[0]);
+  expected.insert (leaves[2]);
+  expected.insert (leaves[3]);
+  NS_TEST_ASSERT_MSG_EQ ((caches["NixCache"] == expected), true, "wrong nix-vectors evicted");
+  NS_TEST_ASSERT_MSG_EQ ((caches["Ipv4RouteCache"] == expected), true, "wrong routes evicted");
+
+  // the evicted destination is computed again
+  NS_TEST_ASSERT_MSG_NE (RouteTo (hub, Ipv4Address (leaves[1].c_str ()), 0), 0, "no route to leaf 1");
+  caches = GetCachedDestinations (hub);
+  NS_TEST_ASSERT_MSG_EQ (caches["NixCache"].count (leaves[1]), 1, "nix-vector not cached again");
+  NS_TEST_ASSERT_MSG_EQ (caches["NixCache"].count (leaves[2]), 0, "least recently used nix-vector not evicted");
+
+  Simulator::Destroy ();
+  Config::SetGlobal ("NixVectorCacheSize", cacheSize);
+}
+
+/**
+ * \ingroup nix-vector-routing-test
+ * \ingroup tests
+ *
+ * Checks that the paths are computed again after the topology changes:
+ * on a ring, an interface going down only invalidates the paths
+ * traversing it, and a new link shortens the path.
+ */
+class NixVectorRoutingTopologyChangeTestCase : public TestCase
+{
+public:
+  NixVectorRoutingTopologyChangeTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+NixVectorRoutingTopologyChangeTestCase::NixVectorRoutingTopologyChangeTestCase ()
+  : TestCase ("Paths computed again after a topology change")
+{
+}
+
+void
+NixVectorRoutingTopologyChangeTestCase::DoRun (void)
+{
+  // a ring of 6 nodes, where link i connects node i and node i+1
+  NodeContainer nodes;
+  nodes.Create (6);
+  InternetStackHelper internet;
+  internet.SetRoutingHelper (Ipv4NixVectorHelper ());
+  internet.Install (nodes);
+  Ipv4AddressHelper address ("10.1.0.0", "255.255.255.0");
+  std::vector<Ipv4InterfaceContainer> links;
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      links.push_back (Connect (NodeContainer (nodes.Get (i), nodes.Get ((i + 1) % nodes.GetN ())), address));
+    }
+  Ptr<Node> source = nodes.Get (0);
+  Ipv4Address farNode = links[2].GetAddress (1);
+  Ipv4Address lastNode = links[5].GetAddress (0);
+
+  // both directions have the same length, the first one found wins
+  Ptr<Ipv4Route> route = RouteTo (source, farNode, 0);
+  NS_TEST_ASSERT_MSG_NE (route, 0, "no route to node 3");
+  NS_TEST_ASSERT_MSG_EQ (route->GetGateway (), links[0].GetAddress (1), "wrong gateway to node 3");
+  NS_TEST_ASSERT_MSG_NE (RouteTo (source, lastNode, 0), 0, "no route to node 5");
+
+  // taking down the link between node 1 and node 2 invalidates the path
+  // to node 3 only
+  Ptr<Ipv4> ipv4 = links[1].Get (0).first;
+  ipv4->SetDown (links[1].Get (0).second);
+  std::map<std::string, std::set<std::string> > caches = GetCachedDestinations (source);
+  NS_TEST_ASSERT_MSG_EQ (caches["NixCache"].count (ToString (farNode)), 0, "stale nix-vector to node 3");
+  NS_TEST_ASSERT_MSG_EQ (caches["Ipv4RouteCache"].count (ToString (farNode)), 0, "stale route to node 3");
+  NS_TEST_ASSERT_MSG_EQ (caches["NixCache"].count (ToString (lastNode)), 1, "nix-vector to node 5 invalidated");
+
+  route = RouteTo (source, farNode, 0);
+  NS_TEST_ASSERT_MSG_NE (route, 0, "no route to node 3 with a link down");
+  NS_TEST_ASSERT_MSG_EQ (route->GetGateway (), lastNode, "wrong gateway to node 3 with a link down");
+
+  // taking the link up again flushes the caches
+  ipv4->SetUp (links[1].Get (0).second);
+  caches = GetCachedDestinations (source);
+  NS_TEST_ASSERT_MSG_EQ (caches["NixCache"].empty (), true, "nix-vector cache not flushed");
+  route = RouteTo (source, farNode, 0);
+  NS_TEST_ASSERT_MSG_EQ (route->GetGateway (), links[0].GetAddress (1), "wrong gateway to node 3 with the link up");
+
+  // a new link between node 0 and node 3 shortens the path
+  Ipv4InterfaceContainer shortcut = Connect (NodeContainer (nodes.Get (0), nodes.Get (3)), address);
+  Ptr<Packet> p = Create<Packet> ();
+  route = RouteTo (source, farNode, p);
+  NS_TEST_ASSERT_MSG_NE (route, 0, "no route to node 3 with the new link");
+  NS_TEST_ASSERT_MSG_EQ (route->GetGateway (), shortcut.GetAddress (1), "wrong gateway to node 3 with the new link");
+  NS_TEST_ASSERT_MSG_EQ (p->GetNixVector ()->GetRemainingBits (), 0, "path to node 3 is not a single hop");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup nix-vector-routing-test
+ * \ingroup tests
+ *
+ * Checks, on a random topology, that the routes are the ones found by
+ * a breadth-first search walking the nodes, devices and channels, as
+ * the routing protocol did before using a compact topology.
+ */
+class NixVectorRoutingBfsTestCase : public TestCase
+{
+public:
+  NixVectorRoutingBfsTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Builds the nix-vector from a node to another one by walking the
+   * nodes, devices and channels.
+   * \param source the source node id
+   * \param dest the destination node id
+   * \param [out] gateway the address of the first hop
+   * \returns the nix-vector, or null if there is no path
+   */
+  Ptr<NixVector> GetReferenceNixVector (uint32_t source, uint32_t dest, Ipv4Address &gateway);
+
+  std::vector<std::vector<Ptr<NetDevice> > > m_neighbors; //!< remote devices of each node, in neighbor-index order
+};
+
+NixVectorRoutingBfsTestCase::NixVectorRoutingBfsTestCase ()
+  : TestCase ("Paths of the breadth-first search")
+{
+}
+
+Ptr<NixVector>
+NixVectorRoutingBfsTestCase::GetReferenceNixVector (uint32_t source, uint32_t dest, Ipv4Address &gateway)
+{
+  std::vector<int32_t> parent (m_neighbors.size (), -1);
+  std::vector<uint32_t> queue (1, source);
+  parent[source] = source;
+  for (uint32_t head = 0; head < queue.size () && parent[dest] < 0; head++)
+    {
+      uint32_t node = queue[head];
+      for (uint32_t i = 0; i < m_neighbors[node].size (); i++)
+        {
+          uint32_t remote = m_neighbors[node][i]->GetNode ()->GetId ();
+          if (parent[remote] < 0)
+            {
+              parent[remote] = node;
+              queue.push_back (remote);
+            }
+        }
+    }
+  if (parent[dest] < 0)
+    {
+      return 0;
+    }
+
+  // the hops are added from the destination back to the source, and the
+  // last neighbor matching a hop gives its index
+  Ptr<NixVector> nixVector = Create<NixVector> ();
+  for (uint32_t node = dest; node != source; node = parent[node])
+    {
+      uint32_t hop = parent[node];
+      uint32_t index = 0;
+      for (uint32_t i = 0; i < m_neighbors[hop].size (); i++)
+        {
+          if (m_neighbors[hop][i]->GetNode ()->GetId () == node)
+            {
+              index = i;
+            }
+        }
+      nixVector->AddNeighborIndex (index, nixVector->BitCount (m_neighbors[hop].size ()));
+      if (hop == source)
+        {
+          Ptr<NetDevice> device = m_neighbors[hop][index];
+          Ptr<Ipv4> ipv4 = device->GetNode ()->GetObject<Ipv4> ();
+          gateway = ipv4->GetAddress (ipv4->GetInterfaceForDevice (device), 0).GetLocal ();
+        }
+    }
+  return nixVector;
+}
+
+void
+NixVectorRoutingBfsTestCase::DoRun (void)
+{
+  const uint32_t nNodes = 25;
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+  InternetStackHelper internet;
+  internet.SetRoutingHelper (Ipv4NixVectorHelper ());
+  internet.Install (nodes);
+  Ipv4AddressHelper address ("10.1.0.0", "255.255.255.0");
+
+  // a random tree, a few random links (possibly parallel ones) and
+  // a channel shared by several nodes
+  Ptr<UniformRandomVariable> rv = CreateObject<UniformRandomVariable> ();
+  rv->SetStream (1);
+  for (uint32_t i = 1; i < nNodes; i++)
+    {
+      Connect (NodeContainer (nodes.Get (i), nodes.Get (rv->GetInteger (0, i - 1))), address);
+    }
+  for (uint32_t i = 0; i < 15; i++)
+    {
+      uint32_t a = rv->GetInteger (0, nNodes - 1);
+      uint32_t b = rv->GetInteger (0, nNodes - 1);
+      if (a != b)
+        {
+          Connect (NodeContainer (nodes.Get (a), nodes.Get (b)), address);
+        }
+    }
+  Connect (NodeContainer (NodeContainer (nodes.Get (3), nodes.Get (8)), NodeContainer (nodes.Get (13), nodes.Get (21))), address);
+
+  m_neighbors.assign (nNodes, std::vector<Ptr<NetDevice> > ());
+  for (uint32_t n = 0; n < nNodes; n++)
+    {
+      Ptr<Node> node = nodes.Get (n);
+      for (uint32_t i = 0; i < node->GetNDevices (); i++)
+        {
+          Ptr<NetDevice> device = node->GetDevice (i);
+          Ptr<Channel> channel = device->GetChannel ();
+          for (uint32_t j = 0; channel && j < channel->GetNDevices (); j++)
+            {
+              if (channel->GetDevice (j) != device)
+                {
+                  m_neighbors[n].push_back (channel->GetDevice (j));
+                }
+            }
+        }
+    }
+
+  for (uint32_t source = 0; source < nNodes; source++)
+    {
+      for (uint32_t dest = 0; dest < nNodes; dest++)
+        {
+          if (source == dest)
+            {
+              continue;
+            }
+          Ipv4Address destAddress = nodes.Get (dest)->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal ();
+          Ipv4Address gateway;
+          Ptr<NixVector> expected = GetReferenceNixVector (source, dest, gateway);
+          NS_TEST_ASSERT_MSG_NE (expected, 0, "the topology is not connected");
+
+          Ptr<Packet> p = Create<Packet> ();
+          Ptr<Ipv4Route> route = RouteTo (nodes.Get (source), destAddress, p);
+          NS_TEST_ASSERT_MSG_NE (route, 0, "no route from " << source << " to " << dest);
+          std::ostringstream expectedBits;
+          std::ostringstream bits;
+          expectedBits << *expected;
+          bits << *p->GetNixVector ();
+          NS_TEST_ASSERT_MSG_EQ (bits.str (), expectedBits.str (), "wrong path from " << source << " to " << dest);
+          NS_TEST_ASSERT_MSG_EQ (route->GetGateway (), gateway, "wrong gateway from " << source << " to " << dest);
+        }
+    }
+
+  m_neighbors.clear ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup nix-vector-routing-test
+ * \ingroup tests
+ *
+ * Nix-vector routing TestSuite
+ */
+class NixVectorRoutingTestSuite : public TestSuite
+{
+public:
+  NixVectorRoutingTestSuite ()
+    : TestSuite ("nix-vector-routing", UNIT)
+  {
+    AddTestCase (new NixVectorRoutingLruTestCase (), TestCase::QUICK);
+    AddTestCase (new NixVectorRoutingTopologyChangeTestCase (), TestCase::QUICK);
+    AddTestCase (new NixVectorRoutingBfsTestCase (), TestCase::QUICK);
+  }
+};
+
+static NixVectorRoutingTestSuite g_nixVectorRoutingTestSuite; ///< the test suite
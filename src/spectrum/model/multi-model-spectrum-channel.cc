@@ -466,6 +466,13 @@ MultiModelSpectrumChannel::SetPropagationDelayModel (Ptr<PropagationDelayModel>
   m_propagationDelay = delay;
 }
 
+Ptr<PropagationLossModel>
+MultiModelSpectrumChannel::GetPropagationLossModel (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_propagationLoss;
+}
+
 Ptr<SpectrumPropagationLossModel>
 MultiModelSpectrumChannel::GetSpectrumPropagationLossModel (void)
 {
@@ -262,6 +262,13 @@ SingleModelSpectrumChannel::SetPropagationDelayModel (Ptr<PropagationDelayModel>
 }
 
 
+Ptr<PropagationLossModel>
+SingleModelSpectrumChannel::GetPropagationLossModel (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_propagationLoss;
+}
+
 Ptr<SpectrumPropagationLossModel>
 SingleModelSpectrumChannel::GetSpectrumPropagationLossModel (void)
 {
@@ -74,6 +74,27 @@ public:
    */
   virtual void SetPropagationDelayModel (Ptr<PropagationDelayModel> delay) = 0;
 
+  /**
+   * Get the single-frequency propagation loss model.
+   *
+   * The default implementation returns 0, as for a channel without a
+   * propagation loss model.
+   *
+   * \returns a pointer to the first propagation loss model of the chain,
+   * or 0 if none was added.
+   */
+  virtual Ptr<PropagationLossModel> GetPropagationLossModel (void);
+
+  /**
+   * Get the frequency-dependent propagation loss model.
+   *
+   * The default implementation returns 0, as for a channel without a
+   * propagation loss model.
+   *
+   * \returns a pointer to the first propagation loss model of the chain,
+   * or 0 if none was added.
+   */
+  virtual Ptr<SpectrumPropagationLossModel> GetSpectrumPropagationLossModel (void);
 
   /**
    * Used by attached PHY instances to transmit signals on the channel
@@ -27,6 +27,9 @@
 #include "ns3/log.h"
 #include "ns3/pointer.h"
 #include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include <limits>
 #include "uan-channel.h"
 #include "uan-phy.h"
 #include "uan-prop-model.h"
@@ -59,6 +62,20 @@ UanChannel::GetTypeId ()
                    StringValue ("ns3::UanNoiseModelDefault"),
                    MakePointerAccessor (&UanChannel::m_noise),
                    MakePointerChecker<UanNoiseModel> ())
+    .AddAttribute ("CacheLinks",
+                   "Cache the delay, path loss and PDP from each device to each other "
+                   "one, for each mode, and only compute them again when either device "
+                   "has moved.  Only valid with deterministic propagation models.  "
+                   "The cache grows with the square of the number of devices.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&UanChannel::m_cacheLinks),
+                   MakeBooleanChecker ())
+    .AddAttribute ("MaxPathLossDb",
+                   "Packets are not sent to the receivers with a larger path loss, "
+                   "which then see neither the packet nor its interference.",
+                   DoubleValue (std::numeric_limits<double>::max ()),
+                   MakeDoubleAccessor (&UanChannel::m_maxPathLossDb),
+                   MakeDoubleChecker<double> ())
   ;
 
   return tid;
@@ -98,6 +115,8 @@ UanChannel::Clear ()
         }
     }
   m_devList.clear ();
+  m_links.clear ();
+  m_linksProp = 0;
   if (m_prop)
     {
       m_prop->Clear ();
@@ -141,6 +160,8 @@ UanChannel::AddDevice (Ptr<UanNetDevice> dev, Ptr<UanTransducer> trans)
 {
   NS_LOG_DEBUG ("Adding dev/trans pair number " << m_devList.size ());
   m_devList.push_back (std::make_pair (dev, trans));
+  // the links are indexed by the number of devices
+  m_links.clear ();
 }
 
 void
@@ -148,6 +169,7 @@ UanChannel::TxPacket (Ptr<UanTransducer> src, Ptr<Packet> packet,
                       double txPowerDb, UanTxMode txMode)
 {
   Ptr<MobilityModel> senderMobility = 0;
+  uint32_t srcIndex = 0;
 
   NS_LOG_DEBUG ("Channel scheduling");
   for (UanDeviceList::const_iterator i = m_devList.begin (); i
@@ -159,6 +181,7 @@ UanChannel::TxPacket (Ptr<UanTransducer> src, Ptr<Packet> packet,
           senderMobility = i->first->GetNode ()->GetObject<MobilityModel> ();
           break;
         }
+      srcIndex++;
     }
   NS_ASSERT (senderMobility != 0);
   uint32_t j = 0;
@@ -167,13 +190,32 @@ UanChannel::TxPacket (Ptr<UanTransducer> src, Ptr<Packet> packet,
     {
       if (src != i->second)
         {
-          NS_LOG_DEBUG ("Scheduling " << i->first->GetMac ()->GetAddress ());
           Ptr<MobilityModel> rcvrMobility = i->first->GetNode ()->GetObject<MobilityModel> ();
-          Time delay = m_prop->GetDelay (senderMobility, rcvrMobility, txMode);
-          UanPdp pdp = m_prop->GetPdp (senderMobility, rcvrMobility, txMode);
-          double rxPowerDb = txPowerDb - m_prop->GetPathLossDb (senderMobility,
-                                                                rcvrMobility,
-                                                                txMode);
+          Time delay;
+          UanPdp pdp;
+          double pathLossDb;
+          if (m_cacheLinks)
+            {
+              const Link &link = GetLink (srcIndex, j, senderMobility, rcvrMobility, txMode);
+              delay = link.delay;
+              pdp = link.pdp;
+              pathLossDb = link.pathLossDb;
+            }
+          else
+            {
+              delay = m_prop->GetDelay (senderMobility, rcvrMobility, txMode);
+              pdp = m_prop->GetPdp (senderMobility, rcvrMobility, txMode);
+              pathLossDb = m_prop->GetPathLossDb (senderMobility, rcvrMobility, txMode);
+            }
+          if (pathLossDb > m_maxPathLossDb)
+            {
+              NS_LOG_DEBUG ("Not scheduling " << i->first->GetMac ()->GetAddress ()
+                                              << ", pathLossDb=" << pathLossDb << "dB");
+              j++;
+              continue;
+            }
+          NS_LOG_DEBUG ("Scheduling " << i->first->GetMac ()->GetAddress ());
+          double rxPowerDb = txPowerDb - pathLossDb;
 
           NS_LOG_DEBUG ("txPowerDb=" << txPowerDb << "dB, rxPowerDb="
                                      << rxPowerDb << "dB, distance="
@@ -195,6 +237,41 @@ UanChannel::TxPacket (Ptr<UanTransducer> src, Ptr<Packet> packet,
     }
 }
 
+const UanChannel::Link &
+UanChannel::GetLink (uint32_t src, uint32_t dst,
+                     Ptr<MobilityModel> srcMobility, Ptr<MobilityModel> dstMobility,
+                     UanTxMode txMode)
+{
+  if (m_linksProp != m_prop)
+    {
+      m_links.clear ();
+      m_linksProp = m_prop;
+    }
+  std::vector<Link> &links = m_links[txMode.GetUid ()];
+  if (links.empty ())
+    {
+      Link invalid;
+      invalid.valid = false;
+      links.resize (m_devList.size () * m_devList.size (), invalid);
+    }
+  Link &link = links[src * m_devList.size () + dst];
+  Vector txPosition = srcMobility->GetPosition ();
+  Vector rxPosition = dstMobility->GetPosition ();
+  if (!link.valid
+      || link.txPosition.x != txPosition.x || link.txPosition.y != txPosition.y
+      || link.txPosition.z != txPosition.z || link.rxPosition.x != rxPosition.x
+      || link.rxPosition.y != rxPosition.y || link.rxPosition.z != rxPosition.z)
+    {
+      link.valid = true;
+      link.txPosition = txPosition;
+      link.rxPosition = rxPosition;
+      link.delay = m_prop->GetDelay (srcMobility, dstMobility, txMode);
+      link.pdp = m_prop->GetPdp (srcMobility, dstMobility, txMode);
+      link.pathLossDb = m_prop->GetPathLossDb (srcMobility, dstMobility, txMode);
+    }
+  return link;
+}
+
 void
 UanChannel::SetNoiseModel (Ptr<UanNoiseModel> noise)
 {
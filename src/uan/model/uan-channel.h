@@ -26,12 +26,16 @@
 #include "ns3/packet.h"
 #include "ns3/uan-prop-model.h"
 #include "ns3/uan-noise-model.h"
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
 
 #include <list>
+#include <map>
 #include <vector>
 
 namespace ns3 {
 
+class MobilityModel;
 class UanNetDevice;
 class UanPhy;
 class UanTransducer;
@@ -118,6 +122,42 @@ protected:
   /** Has Clear ever been called on the channel. */
   bool m_cleared;
 
+  /** The propagation from a device to another one, with a mode. */
+  struct Link
+  {
+    bool valid;          //!< Whether the link has been computed.
+    Vector txPosition;   //!< The position of the transmitter, when computed.
+    Vector rxPosition;   //!< The position of the receiver, when computed.
+    Time delay;          //!< The propagation delay.
+    double pathLossDb;   //!< The path loss, in dB.
+    UanPdp pdp;          //!< The power delay profile.
+  };
+  /**
+   * The links of each mode, by UanTxMode uid, indexed by
+   * transmitter * number of devices + receiver.
+   */
+  typedef std::map<uint32_t, std::vector<Link> > LinkCache;
+
+  bool m_cacheLinks;              //!< Whether to cache the propagation of each link.
+  double m_maxPathLossDb;         //!< Receivers with a larger path loss are not sent packets.
+  LinkCache m_links;              //!< The cached links.
+  Ptr<UanPropModel> m_linksProp;  //!< The propagation model of the cached links.
+
+  /**
+   * Get the propagation from a device to another one, computing it
+   * again only if one of them moved since it was last computed.
+   *
+   * \param src The index of the transmitting device.
+   * \param dst The index of the receiving device.
+   * \param srcMobility The mobility model of the transmitting device.
+   * \param dstMobility The mobility model of the receiving device.
+   * \param txMode The mode of the transmission.
+   * \return The link.
+   */
+  const Link & GetLink (uint32_t src, uint32_t dst,
+                        Ptr<MobilityModel> srcMobility, Ptr<MobilityModel> dstMobility,
+                        UanTxMode txMode);
+
   /**
    * Send a packet up to the receiving UanTransducer.
    *
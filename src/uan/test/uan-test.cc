@@ -24,6 +24,7 @@
 #include "ns3/uan-phy-gen.h"
 #include "ns3/uan-transducer-hd.h"
 #include "ns3/uan-prop-model-ideal.h"
+#include "ns3/uan-prop-model-thorp.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
@@ -31,6 +32,9 @@
 #include "ns3/object-factory.h"
 #include "ns3/pointer.h"
 #include "ns3/callback.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include <limits>
 
 using namespace ns3;
 
@@ -283,6 +287,184 @@ UanTest::DoRun (void)
   DoPhyTests ();
 }
 
+/**
+ * \ingroup uan-test
+ * \ingroup tests
+ *
+ * \brief Thorp propagation model counting the path loss computations.
+ */
+class UanPropModelCounting : public UanPropModelThorp
+{
+public:
+  UanPropModelCounting () : m_count (0)
+  {
+  }
+  virtual double GetPathLossDb (Ptr<MobilityModel> a, Ptr<MobilityModel> b, UanTxMode mode)
+  {
+    m_count++;
+    return UanPropModelThorp::GetPathLossDb (a, b, mode);
+  }
+  uint32_t m_count; ///< the number of path loss computations
+};
+
+/**
+ * \ingroup uan-test
+ * \ingroup tests
+ *
+ * \brief Uan Channel link cache and path loss culling test
+ */
+class UanChannelCacheTest : public TestCase
+{
+public:
+  UanChannelCacheTest ();
+
+  virtual void DoRun (void);
+private:
+  /**
+   * Create node function
+   * \param pos the position of the device
+   * \param chan the communication channel
+   * \returns the UAN device
+   */
+  Ptr<UanNetDevice> CreateNode (Vector pos, Ptr<UanChannel> chan);
+  /**
+   * Receive packet function
+   * \param dev the device
+   * \param pkt the packet
+   * \param mode the mode
+   * \param sender the address of the sender
+   * \returns true if successful
+   */
+  bool RxPacket (Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address &sender);
+  /**
+   * Send one packet function
+   * \param dev the device
+   */
+  void SendOnePacket (Ptr<UanNetDevice> dev);
+  /**
+   * Move a device
+   * \param dev the device
+   * \param pos the new position of the device
+   */
+  void Move (Ptr<UanNetDevice> dev, Vector pos);
+  /**
+   * Count the packets received by two devices
+   * \param cache whether the channel caches the links
+   * \param maxPathLossDb the largest path loss of the receivers
+   * \returns the path loss computations
+   */
+  uint32_t Run (bool cache, double maxPathLossDb);
+
+  Ptr<UanNetDevice> m_near; ///< the device near the transmitter
+  Ptr<UanNetDevice> m_far; ///< the device far from the transmitter
+  uint32_t m_nearRx; ///< packets received by the near device
+  uint32_t m_farRx; ///< packets received by the far device
+};
+
+UanChannelCacheTest::UanChannelCacheTest ()
+  : TestCase ("UAN channel link cache")
+{
+}
+
+bool
+UanChannelCacheTest::RxPacket (Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address &sender)
+{
+  NS_UNUSED (pkt);
+  NS_UNUSED (mode);
+  NS_UNUSED (sender);
+  if (dev == m_near)
+    {
+      m_nearRx++;
+    }
+  else if (dev == m_far)
+    {
+      m_farRx++;
+    }
+  return true;
+}
+
+void
+UanChannelCacheTest::SendOnePacket (Ptr<UanNetDevice> dev)
+{
+  Ptr<Packet> pkt = Create<Packet> (17);
+  dev->Send (pkt, dev->GetBroadcast (), 0);
+}
+
+void
+UanChannelCacheTest::Move (Ptr<UanNetDevice> dev, Vector pos)
+{
+  dev->GetNode ()->GetObject<MobilityModel> ()->SetPosition (pos);
+}
+
+Ptr<UanNetDevice>
+UanChannelCacheTest::CreateNode (Vector pos, Ptr<UanChannel> chan)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<UanNetDevice> dev = CreateObject<UanNetDevice> ();
+  Ptr<UanMacAloha> mac = CreateObject<UanMacAloha> ();
+  Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+
+  mobility->SetPosition (pos);
+  node->AggregateObject (mobility);
+  mac->SetAddress (Mac8Address::Allocate ());
+
+  dev->SetPhy (CreateObject<UanPhyGen> ());
+  dev->SetMac (mac);
+  dev->SetChannel (chan);
+  dev->SetTransducer (CreateObject<UanTransducerHd> ());
+  node->AddDevice (dev);
+  dev->SetReceiveCallback (MakeCallback (&UanChannelCacheTest::RxPacket, this));
+
+  return dev;
+}
+
+uint32_t
+UanChannelCacheTest::Run (bool cache, double maxPathLossDb)
+{
+  Ptr<UanPropModelCounting> prop = CreateObject<UanPropModelCounting> ();
+  Ptr<UanChannel> channel = CreateObject<UanChannel> ();
+  channel->SetAttribute ("PropagationModel", PointerValue (prop));
+  channel->SetAttribute ("CacheLinks", BooleanValue (cache));
+  channel->SetAttribute ("MaxPathLossDb", DoubleValue (maxPathLossDb));
+
+  Ptr<UanNetDevice> tx = CreateNode (Vector (0, 50, 50), channel);
+  m_near = CreateNode (Vector (100, 50, 50), channel);
+  m_far = CreateNode (Vector (2000, 50, 50), channel);
+  m_nearRx = 0;
+  m_farRx = 0;
+
+  // four packets, the far device moves closer before the last one
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      Simulator::Schedule (Seconds (10.0 * i), &UanChannelCacheTest::SendOnePacket, this, tx);
+    }
+  Simulator::Schedule (Seconds (25.0), &UanChannelCacheTest::Move, this, m_far, Vector (200, 50, 50));
+  Simulator::Stop (Seconds (50.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  return prop->m_count;
+}
+
+void
+UanChannelCacheTest::DoRun (void)
+{
+  double noLimit = std::numeric_limits<double>::max ();
+  NS_TEST_ASSERT_MSG_EQ (Run (false, noLimit), 8, "Path loss not computed on each transmission");
+  NS_TEST_ASSERT_MSG_EQ (m_nearRx, 4, "Near device did not receive all packets");
+  uint32_t farRx = m_farRx;
+
+  // computed once per receiver, and again after the move
+  NS_TEST_ASSERT_MSG_EQ (Run (true, noLimit), 3, "Path loss not cached");
+  NS_TEST_ASSERT_MSG_EQ (m_nearRx, 4, "Near device did not receive all packets");
+  NS_TEST_ASSERT_MSG_EQ (m_farRx, farRx, "Cache changed the far device receptions");
+
+  // the far device is culled until it moves
+  NS_TEST_ASSERT_MSG_EQ (Run (true, 40), 3, "Path loss not cached");
+  NS_TEST_ASSERT_MSG_EQ (m_nearRx, 4, "Near device did not receive all packets");
+  NS_TEST_ASSERT_MSG_EQ (m_farRx, 1, "Far device not culled");
+}
+
 /**
  * \ingroup uan-test
  * \ingroup tests
@@ -299,6 +481,7 @@ UanTestSuite::UanTestSuite ()
   :  TestSuite ("devices-uan", UNIT)
 {
   AddTestCase (new UanTest, TestCase::QUICK);
+  AddTestCase (new UanChannelCacheTest, TestCase::QUICK);
 }
 
 static UanTestSuite g_uanTestSuite; ///< the test suite
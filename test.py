@@ -27,6 +27,7 @@ import signal
 import xml.dom.minidom
 import shutil
 import re
+import json
 
 from utils import get_list_from_file
 
@@ -86,6 +87,7 @@ VALGRIND_FOUND = True
 # read.
 #
 test_runner_name = "test-runner"
+bench_suite_name = "bench-suite"
 
 #
 # If the user has constrained us to run certain kinds of tests, we can tell waf
@@ -1000,6 +1002,82 @@ class worker_thread(threading.Thread):
 # This is the main function that does the work of interacting with the
 # test-runner itself.
 #
+#
+# Run the benchmark suite, each benchmark in its own process so that its
+# peak memory usage is measured in isolation, and compare the results with
+# a baseline, i.e. the JSON results of a previous run.  A benchmark fails
+# if its rate of operations drops, or if its number of allocations or its
+# peak memory usage grows, by more than the tolerance.
+#
+def run_benchmarks():
+    if not os.path.exists(os.path.join(NS3_BUILDDIR, "utils", bench_suite_name)):
+        print("The benchmark suite was not built; it requires the lte, wifi, "
+              "point-to-point and applications modules.", file=sys.stderr)
+        return 2
+
+    path_cmd = os.path.join("utils", bench_suite_name)
+    if options.benchmark == "all":
+        (rc, standard_out, standard_err, et) = run_job_synchronously(path_cmd + " --list", os.getcwd(), False, False)
+        if rc != 0:
+            print(standard_err, file=sys.stderr)
+            return rc
+        names = [line.split('\t')[0] for line in standard_out.split('\n') if len(line.strip())]
+    else:
+        names = options.benchmark.split(',')
+
+    baseline = {}
+    if len(options.baseline):
+        with open(options.baseline) as f:
+            for result in json.load(f)["benchmarks"]:
+                baseline[result["name"]] = result
+
+    if not os.path.exists(TMP_OUTPUT_DIR):
+        os.makedirs(TMP_OUTPUT_DIR)
+    json_file = os.path.abspath(os.path.join(TMP_OUTPUT_DIR, "bench-suite.json"))
+
+    tolerance = options.tolerance / 100.0
+    results = []
+    failed = 0
+    for name in names:
+        cmd = "%s --run=%s --json=%s --scale=%s" % (path_cmd, name, json_file, options.scale)
+        (rc, standard_out, standard_err, et) = run_job_synchronously(cmd, os.getcwd(), False, False)
+        if rc != 0:
+            print("CRASH: Benchmark %s" % name)
+            print(standard_err, end='')
+            failed += 1
+            continue
+        with open(json_file) as f:
+            result = json.load(f)["benchmarks"][0]
+        results.append(result)
+
+        status = "PASS"
+        text = "%.0f ops/s, %.0f events/s, %d kB, %d allocations" % (result["operationsPerSecond"], result["eventsPerSecond"],
+                                                                     result["peakRssKb"], result["allocations"])
+        if name in baseline:
+            reference = baseline[name]
+            regressions = []
+            if result["operationsPerSecond"] < reference["operationsPerSecond"] * (1 - tolerance):
+                regressions.append("ops/s")
+            if result["allocations"] > reference["allocations"] * (1 + tolerance):
+                regressions.append("allocations")
+            if result["peakRssKb"] > reference["peakRssKb"] * (1 + tolerance):
+                regressions.append("peak RSS")
+            if len(regressions):
+                status = "FAIL"
+                failed += 1
+            text += "; baseline %.0f ops/s (%+.1f%%)" % (reference["operationsPerSecond"],
+                100.0 * (float(result["operationsPerSecond"]) / max(reference["operationsPerSecond"], 1e-9) - 1))
+            if len(regressions):
+                text += "; regression of " + ", ".join(regressions)
+        print("%s: Benchmark %s (%s)" % (status, name, text))
+
+    if len(options.benchmark_json):
+        with open(options.benchmark_json, 'w') as f:
+            json.dump({"scale": options.scale, "benchmarks": results}, f, indent=2)
+
+    print("%d of %d benchmarks passed (%d failed)" % (len(names) - failed, len(names), failed))
+    return 1 if failed else 0
+
 def run_tests():
     #
     # Pull some interesting configuration information out of waf, primarily
@@ -1023,6 +1101,8 @@ def run_tests():
     # match what is done in the wscript file.
     #
     test_runner_name = "%s%s-%s%s" % (APPNAME, VERSION, "test-runner", BUILD_PROFILE_SUFFIX)
+    global bench_suite_name
+    bench_suite_name = "%s%s-%s%s" % (APPNAME, VERSION, "bench-suite", BUILD_PROFILE_SUFFIX)
 
     #
     # Run waf to make sure that everything is built, configured and ready to go
@@ -1059,6 +1139,8 @@ def run_tests():
                 waf_cmd = sys.executable + " waf --target=%s" % os.path.basename(options.example)
             else:
                 waf_cmd = sys.executable + " waf --target=%s" % os.path.basename(options.example)
+        elif len(options.benchmark):
+            waf_cmd = sys.executable + " waf --target=bench-suite"
 
         else:
             if sys.platform == "win32": #Modify for windows
@@ -1209,6 +1291,9 @@ def run_tests():
     if options.kinds or options.list:
         return
 
+    if len(options.benchmark):
+        return run_benchmarks()
+
     #
     # We communicate results in two ways.  First, a simple message relating 
     # PASS, FAIL, CRASH or SKIP is always written to the standard output.  It 
@@ -1873,6 +1958,27 @@ def main(argv):
                       metavar="BUILDPATH",
                       help="specify the path where ns-3 was built (defaults to the build directory for the current variant)")
 
+    parser.add_option("--benchmark", action="store", type="string", dest="benchmark", default="",
+                      metavar="BENCHMARKS",
+                      help="run a comma separated list of benchmarks of utils/bench-suite, or all of them "
+                           "with --benchmark=all, instead of the tests")
+
+    parser.add_option("--baseline", action="store", type="string", dest="baseline", default="",
+                      metavar="JSON-FILE",
+                      help="compare the benchmark results with those stored in JSON-FILE by --benchmark-json")
+
+    parser.add_option("--benchmark-json", action="store", type="string", dest="benchmark_json", default="",
+                      metavar="JSON-FILE",
+                      help="write the benchmark results into JSON-FILE")
+
+    parser.add_option("--scale", action="store", type="float", dest="scale", default=1.0,
+                      help="scale the workload of the benchmarks (default 1.0)")
+
+    parser.add_option("--tolerance", action="store", type="float", dest="tolerance", default=20.0,
+                      metavar="PERCENT",
+                      help="flag a benchmark as a regression if it is more than PERCENT worse than the baseline "
+                           "(default 20)")
+
     parser.add_option("-c", "--constrain", action="store", type="string", dest="constrain", default="",
                       metavar="KIND",
                       help="constrain the test-runner by kind of test")
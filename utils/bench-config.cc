@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the setup time of a simulation
+// which connects per-node trace sources through the Config system, with
+// 'n' nodes each having a SimpleNetDevice and its transmit queue.
+// Sample usage:  ./waf --run 'bench-config --n=10000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/config.h"
+#include "ns3/callback.h"
+#include "ns3/data-rate.h"
+#include "ns3/packet.h"
+#include "ns3/node-container.h"
+#include "ns3/simple-net-device-helper.h"
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/// Number of trace sink invocations
+static uint32_t g_count = 0;
+
+/**
+ * Trace sink of the device and queue packet trace sources.
+ * \param context The context.
+ * \param p The packet.
+ */
+static void
+Sink (std::string context, Ptr<const Packet> p)
+{
+  g_count++;
+}
+
+/**
+ * Print the rate of an operation.
+ * \param count the number of operations
+ * \param ms the elapsed time
+ * \param name the operation name
+ */
+static void
+Report (uint32_t count, uint64_t ms, char const *name)
+{
+  double ps = count;
+  ps *= 1000;
+  ps /= ms > 0 ? ms : 1;
+  std::cout << ps << " ops/s"
+            << " (" << ms << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+/**
+ * Get the path of a trace source of a node device.
+ * \param node The node index.
+ * \param source The trace source, relative to the device.
+ * \return The path.
+ */
+static std::string
+DevicePath (uint32_t node, std::string source)
+{
+  std::ostringstream oss;
+  oss << "/NodeList/" << node << "/DeviceList/0/$ns3::SimpleNetDevice/" << source;
+  return oss.str ();
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 2000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the per-node Config::Connect and Config::Set setup");
+  cmd.AddValue ("n", "number of nodes", n);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- the number of nodes must be positive" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-config with n=" << n << std::endl;
+
+  NodeContainer nodes;
+  nodes.Create (n);
+  SimpleNetDeviceHelper simple;
+  simple.Install (nodes);
+
+  std::vector<std::string> sources;
+  sources.push_back ("PhyRxDrop");
+  sources.push_back ("TxQueue/Enqueue");
+  sources.push_back ("TxQueue/Dequeue");
+  sources.push_back ("TxQueue/Drop");
+
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      for (uint32_t j = 0; j < sources.size (); j++)
+        {
+          Config::Connect (DevicePath (i, sources[j]), MakeCallback (&Sink));
+        }
+    }
+  Report (n * sources.size (), time.End (), "Config::Connect per node");
+
+  std::vector<std::string> paths;
+  std::vector<CallbackBase> cbs;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      for (uint32_t j = 0; j < sources.size (); j++)
+        {
+          paths.push_back (DevicePath (i, sources[j]));
+          cbs.push_back (MakeCallback (&Sink));
+        }
+    }
+  time.Start ();
+  Config::Connect (paths, cbs);
+  Report (n * sources.size (), time.End (), "Config::Connect batch");
+
+  time.Start ();
+  for (uint32_t j = 0; j < sources.size (); j++)
+    {
+      Config::Connect ("/NodeList/*/DeviceList/*/$ns3::SimpleNetDevice/" + sources[j],
+                       MakeCallback (&Sink));
+    }
+  Report (n * sources.size (), time.End (), "Config::Connect wildcard");
+
+  time.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Config::Set (DevicePath (i, "DataRate"), DataRateValue (DataRate ("1Gbps")));
+    }
+  Report (n, time.End (), "Config::Set per node");
+
+  time.Start ();
+  uint32_t matches = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      matches += Config::LookupMatches (DevicePath (i, "TxQueue")).GetN ();
+    }
+  Report (n, time.End (), "Config::LookupMatches per node");
+
+  if (matches != n)
+    {
+      std::cerr << "Error-- matched " << matches << " of " << n << " queues" << std::endl;
+      return 1;
+    }
+  return 0;
+}
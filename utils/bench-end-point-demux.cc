@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the transport endpoint demux
+// of a node hosting many connections, e.g., a server accepting 'n'
+// TCP connections on the same listening port.
+// Sample usage:  ./waf --run 'bench-end-point-demux --n=50000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv4-interface-address.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-end-point-demux.h"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/**
+ * Address of the n-th peer.
+ * \param n the peer index
+ * \return the peer address
+ */
+static Ipv4Address
+PeerAddress (uint32_t n)
+{
+  return Ipv4Address (0x0b000000 + n / 1000);
+}
+
+/**
+ * Port of the n-th peer.
+ * \param n the peer index
+ * \return the peer port
+ */
+static uint16_t
+PeerPort (uint32_t n)
+{
+  return 1024 + n % 1000;
+}
+
+/**
+ * Print the rate of an operation.
+ * \param count the number of operations
+ * \param ms the elapsed time
+ * \param name the operation name
+ */
+static void
+Report (uint32_t count, uint64_t ms, char const *name)
+{
+  double ps = count;
+  ps *= 1000;
+  ps /= ms > 0 ? ms : 1;
+  std::cout << ps << " ops/s"
+            << " (" << ms << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 50000;
+  uint32_t lookups = 1000000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the IPv4 endpoint demux");
+  cmd.AddValue ("n", "number of connections", n);
+  cmd.AddValue ("lookups", "number of lookups", lookups);
+  cmd.Parse (argc, argv);
+
+  if (n == 0 || n > 1000000)
+    {
+      std::cerr << "Error-- the number of connections must be in [1, 1000000]" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-end-point-demux with n=" << n << std::endl;
+
+  Ipv4Address local ("10.0.0.1");
+  Ptr<Ipv4Interface> interface = CreateObject<Ipv4Interface> ();
+  interface->AddAddress (Ipv4InterfaceAddress (local, Ipv4Mask ("255.255.255.0")));
+
+  Ipv4EndPointDemux demux;
+  demux.Allocate (0, Ipv4Address::GetAny (), 9);
+
+  SystemWallClockMs time;
+  time.Start ();
+  std::vector<Ipv4EndPoint *> accepted;
+  accepted.reserve (n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      accepted.push_back (demux.Allocate (0, local, 9, PeerAddress (i), PeerPort (i)));
+    }
+  Report (n, time.End (), "Accept connections");
+
+  time.Start ();
+  uint32_t found = 0;
+  for (uint32_t i = 0; i < lookups; i++)
+    {
+      uint32_t peer = (i * 7919) % n;
+      found += demux.Lookup (local, 9, PeerAddress (peer), PeerPort (peer), interface).size ();
+    }
+  Report (lookups, time.End (), "Lookup established connections");
+
+  time.Start ();
+  Ipv4Address newPeer ("12.0.0.1");
+  for (uint32_t i = 0; i < lookups; i++)
+    {
+      found += demux.Lookup (local, 9, newPeer, PeerPort (i), interface).size ();
+    }
+  Report (lookups, time.End (), "Lookup new connections (listening socket)");
+
+  time.Start ();
+  std::vector<Ipv4EndPoint *> clients;
+  uint32_t nClients = std::min<uint32_t> (n, 16000);
+  clients.reserve (nClients);
+  for (uint32_t i = 0; i < nClients; i++)
+    {
+      Ipv4EndPoint *endPoint = demux.Allocate (local);
+      endPoint->SetPeer (PeerAddress (i), 80);
+      clients.push_back (endPoint);
+    }
+  Report (nClients, time.End (), "Allocate ephemeral ports and connect");
+
+  time.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      demux.DeAllocate (accepted[i]);
+    }
+  for (uint32_t i = 0; i < nClients; i++)
+    {
+      demux.DeAllocate (clients[i]);
+    }
+  Report (n + nClients, time.End (), "Close connections");
+
+  if (found != 2 * lookups)
+    {
+      std::cerr << "Error-- " << found << " matches for " << 2 * lookups << " lookups" << std::endl;
+      return 1;
+    }
+  return 0;
+}
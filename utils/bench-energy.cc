@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the energy accounting of 'n'
+// nodes, each with a BasicEnergySource and a device whose current
+// changes every few seconds, with periodic and event-driven updates.
+// Sample usage:  ./waf --run 'bench-energy --n=5000 --stop=3600'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/node-container.h"
+#include "ns3/basic-energy-source.h"
+#include "ns3/simple-device-energy-model.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/// The currents drawn by the devices, in Amperes.
+static const double g_currents[] = { 0.0004, 0.017, 0.0197, 0.0174 };
+
+/**
+ * Switch a device to another current, and schedule the next switch.
+ * \param device the device.
+ * \param delay the delay between two switches.
+ * \param state the index of the current.
+ */
+static void
+Switch (Ptr<SimpleDeviceEnergyModel> device, Ptr<RandomVariableStream> delay, uint32_t state)
+{
+  device->SetCurrentA (g_currents[state % 4]);
+  Simulator::Schedule (Seconds (delay->GetValue ()), &Switch, device, delay, state + 1);
+}
+
+/**
+ * Add up the remaining energy of the sources.
+ * \param sources the sources.
+ * \param total the total remaining energy.
+ */
+static void
+Collect (std::vector<Ptr<BasicEnergySource> > *sources, double *total)
+{
+  for (uint32_t i = 0; i < sources->size (); i++)
+    {
+      *total += (*sources)[i]->GetRemainingEnergy ();
+    }
+}
+
+/**
+ * Run the simulation.
+ * \param n the number of nodes.
+ * \param stop the simulated time.
+ * \param eventDriven whether the sources are event-driven.
+ * \return the total remaining energy.
+ */
+static double
+Run (uint32_t n, Time stop, bool eventDriven)
+{
+  NodeContainer nodes;
+  nodes.Create (n);
+  Ptr<UniformRandomVariable> delay = CreateObject<UniformRandomVariable> ();
+  delay->SetAttribute ("Min", DoubleValue (1.0));
+  delay->SetAttribute ("Max", DoubleValue (20.0));
+  delay->SetStream (1);
+
+  std::vector<Ptr<BasicEnergySource> > sources;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<BasicEnergySource> source = CreateObject<BasicEnergySource> ();
+      source->SetAttribute ("EventDrivenEnergyUpdate", BooleanValue (eventDriven));
+      source->SetInitialEnergy (1000);
+      source->SetNode (nodes.Get (i));
+      nodes.Get (i)->AggregateObject (source);
+
+      Ptr<SimpleDeviceEnergyModel> device = CreateObject<SimpleDeviceEnergyModel> ();
+      device->SetEnergySource (source);
+      device->SetNode (nodes.Get (i));
+      source->AppendDeviceEnergyModel (device);
+      Simulator::Schedule (Seconds (delay->GetValue ()), &Switch, device, delay, i);
+      sources.push_back (source);
+    }
+
+  double total = 0;
+  Simulator::Schedule (stop, &Collect, &sources, &total);
+
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Stop (stop);
+  Simulator::Run ();
+  uint64_t ms = time.End ();
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+
+  std::cout << (eventDriven ? "event-driven" : "periodic    ")
+            << "  " << ms << " ms, " << events << " events,"
+            << " remaining " << total << " J"
+            << std::endl;
+  return total;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 5000;
+  double stop = 3600;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark periodic and event-driven BasicEnergySource updates");
+  cmd.AddValue ("n", "number of nodes", n);
+  cmd.AddValue ("stop", "simulated time, in seconds", stop);
+  cmd.Parse (argc, argv);
+
+  if (n == 0 || stop <= 0)
+    {
+      std::cerr << "Error-- the number of nodes and the time must be positive" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-energy with n=" << n << " stop=" << stop << std::endl;
+
+  double periodic = Run (n, Seconds (stop), false);
+  double eventDriven = Run (n, Seconds (stop), true);
+  if (std::abs (periodic - eventDriven) > 1e-6 * periodic)
+    {
+      std::cerr << "Error-- different remaining energy" << std::endl;
+      return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the downlink packet classification
+// of the PGW, with 'n' UEs each having a default bearer plus 'bearers'
+// dedicated bearers, and 'flows' flows per UE.  The packets are injected
+// as if received from the TUN device; the S1-U socket has no route to the
+// eNB, so that the packets are dropped right after the GTP-U encapsulation.
+// Sample usage:  ./waf --run 'bench-epc-tft-classifier --n=1000 --bearers=8'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/packet.h"
+#include "ns3/node.h"
+#include "ns3/socket.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/udp-header.h"
+#include "ns3/udp-l4-protocol.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/virtual-net-device.h"
+#include "ns3/epc-tft.h"
+#include "ns3/epc-s11-sap.h"
+#include "ns3/epc-sgw-pgw-application.h"
+#include <iostream>
+#include <vector>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/**
+ * MME side of the S11 SAP, ignoring all the messages.
+ */
+class NullS11SapMme : public EpcS11SapMme
+{
+public:
+  virtual void CreateSessionResponse (CreateSessionResponseMessage msg)
+  {
+  }
+  virtual void ModifyBearerResponse (ModifyBearerResponseMessage msg)
+  {
+  }
+  virtual void DeleteBearerRequest (DeleteBearerRequestMessage msg)
+  {
+  }
+};
+
+/**
+ * Print the rate of an operation.
+ * \param count the number of operations
+ * \param ms the elapsed time
+ * \param name the operation name
+ */
+static void
+Report (uint32_t count, uint64_t ms, char const *name)
+{
+  double ps = count;
+  ps *= 1000;
+  ps /= ms > 0 ? ms : 1;
+  std::cout << ps << " ops/s"
+            << " (" << ms << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+/**
+ * Address of the n-th UE.
+ * \param n the UE index
+ * \return the UE address
+ */
+static Ipv4Address
+UeAddress (uint32_t n)
+{
+  return Ipv4Address (0x07000002 + n);
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 1000;
+  uint32_t bearers = 4;
+  uint32_t filters = 4;
+  uint32_t flows = 8;
+  uint32_t packets = 1000000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the downlink TFT classification of the PGW");
+  cmd.AddValue ("n", "number of UEs", n);
+  cmd.AddValue ("bearers", "number of dedicated bearers per UE", bearers);
+  cmd.AddValue ("filters", "number of packet filters per dedicated bearer", filters);
+  cmd.AddValue ("flows", "number of flows per UE", flows);
+  cmd.AddValue ("packets", "number of packets", packets);
+  cmd.Parse (argc, argv);
+
+  if (n == 0 || n > 65000 || bearers > 10 || filters == 0 || filters > 15 || flows == 0)
+    {
+      std::cerr << "Error-- invalid number of UEs, bearers, filters or flows" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-epc-tft-classifier with n=" << n << " bearers=" << bearers
+            << " filters=" << filters << " flows=" << flows << std::endl;
+
+  Ptr<Node> pgw = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.Install (pgw);
+  Ptr<Socket> s1uSocket = Socket::CreateSocket (pgw, UdpSocketFactory::GetTypeId ());
+  s1uSocket->Bind (InetSocketAddress (Ipv4Address::GetAny (), 2152));
+  Ptr<VirtualNetDevice> tunDevice = CreateObject<VirtualNetDevice> ();
+
+  Ptr<EpcSgwPgwApplication> app = CreateObject<EpcSgwPgwApplication> (tunDevice, s1uSocket);
+  NullS11SapMme mme;
+  app->SetS11SapMme (&mme);
+  app->AddEnb (1, Ipv4Address ("10.0.0.2"), Ipv4Address ("10.0.0.1"));
+
+  // dedicated bearer 'b' matches the remote ports [1000 + 100 * b, 1000 + 100 * b + 'filters')
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      uint64_t imsi = i + 1;
+      app->AddUe (imsi);
+      app->SetUeAddress (imsi, UeAddress (i));
+
+      EpcS11SapSgw::CreateSessionRequestMessage req;
+      req.imsi = imsi;
+      req.uli.gci = 1;
+      EpcS11SapSgw::BearerContextToBeCreated bearer;
+      bearer.epsBearerId = 1;
+      bearer.tft = EpcTft::Default ();
+      req.bearerContextsToBeCreated.push_back (bearer);
+      for (uint32_t b = 0; b < bearers; b++)
+        {
+          bearer.epsBearerId = b + 2;
+          bearer.tft = Create<EpcTft> ();
+          for (uint32_t f = 0; f < filters; f++)
+            {
+              EpcTft::PacketFilter pf;
+              pf.direction = EpcTft::DOWNLINK;
+              pf.remotePortStart = 1000 + 100 * b + f;
+              pf.remotePortEnd = pf.remotePortStart;
+              bearer.tft->Add (pf);
+            }
+          req.bearerContextsToBeCreated.push_back (bearer);
+        }
+      app->GetS11SapSgw ()->CreateSessionRequest (req);
+    }
+  Report (n, time.End (), "Create sessions");
+
+  // one packet per flow, the flows of a UE being spread over all its bearers
+  std::vector<Ptr<Packet> > flowPackets;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      for (uint32_t f = 0; f < flows; f++)
+        {
+          UdpHeader udpHeader;
+          udpHeader.SetSourcePort (1000 + 100 * (f % (bearers + 1)) + f % filters);
+          udpHeader.SetDestinationPort (5000 + f);
+          Ipv4Header ipHeader;
+          ipHeader.SetSource (Ipv4Address ("1.0.0.1"));
+          ipHeader.SetDestination (UeAddress (i));
+          ipHeader.SetProtocol (UdpL4Protocol::PROT_NUMBER);
+          ipHeader.SetPayloadSize (100 + udpHeader.GetSerializedSize ());
+          Ptr<Packet> packet = Create<Packet> (100);
+          packet->AddHeader (udpHeader);
+          packet->AddHeader (ipHeader);
+          flowPackets.push_back (packet);
+        }
+    }
+
+  Address tunAddress;
+  time.Start ();
+  for (uint32_t i = 0; i < packets; i++)
+    {
+      // interleave the UEs, as downlink traffic through the PGW would
+      uint32_t flow = (i % n) * flows + (i / n) % flows;
+      app->RecvFromTunDevice (flowPackets[flow]->Copy (), tunAddress, tunAddress, 0x0800);
+    }
+  Report (packets, time.End (), "Classify downlink packets at the PGW");
+
+  app->Dispose ();
+  pgw->Dispose ();
+  return 0;
+}
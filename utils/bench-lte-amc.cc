@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the CQI feedbacks created by
+// LteAmc for the periodic wideband (P10) and aperiodic subband (A30)
+// reports of the UEs, with 25, 50 and 100 RBs of bandwidth.
+// Sample usage:  ./waf --run 'bench-lte-amc --n=10000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/enum.h"
+#include "ns3/spectrum-model.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/lte-amc.h"
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/**
+ * Print the rate of an operation.
+ * \param count the number of operations
+ * \param ms the elapsed time
+ * \param name the operation name
+ */
+static void
+Report (uint64_t count, uint64_t ms, std::string name)
+{
+  double ps = count;
+  ps *= 1000;
+  ps /= ms > 0 ? ms : 1;
+  std::cout << ps << " ops/s"
+            << " (" << ms << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+/**
+ * Create the CQI feedbacks of SINR vectors.
+ * \param amc the AMC
+ * \param sinrs the SINR vectors
+ * \param n the number of feedbacks
+ * \param rbgSize the RBG size
+ * \return the sum of the CQIs
+ */
+static uint64_t
+Create (Ptr<LteAmc> amc, const std::vector<SpectrumValue> &sinrs, uint64_t n, uint8_t rbgSize)
+{
+  uint64_t total = 0;
+  for (uint64_t i = 0; i < n; i++)
+    {
+      std::vector<int> cqi = amc->CreateCqiFeedbacks (sinrs[i % sinrs.size ()], rbgSize);
+      total += cqi[i % cqi.size ()] + 1;
+    }
+  return total;
+}
+
+int main (int argc, char *argv[])
+{
+  uint64_t n = 10000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the CQI feedbacks created by LteAmc");
+  cmd.AddValue ("n", "number of feedbacks per measure", n);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- the number of feedbacks must be positive" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-lte-amc with n=" << n << std::endl;
+
+  Ptr<LteAmc> piro = CreateObject<LteAmc> ();
+  piro->SetAttribute ("AmcModel", EnumValue (LteAmc::PiroEW2010));
+  Ptr<LteAmc> mi = CreateObject<LteAmc> ();
+  mi->SetAttribute ("AmcModel", EnumValue (LteAmc::MiErrorModel));
+
+  uint64_t total = 0;
+  const uint32_t bandwidths[] = { 25, 50, 100 };
+  const uint8_t rbgSizes[] = { 2, 3, 4 }; // type 0 allocation, TS 36.213 table 7.1.6.1-1
+  for (uint32_t b = 0; b < 3; b++)
+    {
+      uint32_t rbs = bandwidths[b];
+      std::vector<double> freqs;
+      for (uint32_t i = 0; i < rbs; i++)
+        {
+          freqs.push_back (2.12e9 + i * 180e3);
+        }
+      Ptr<SpectrumModel> model = Create<SpectrumModel> (freqs);
+
+      // frequency selective SINRs, from -5 to 25 dB on average
+      std::vector<SpectrumValue> sinrs;
+      for (uint32_t k = 0; k < 16; k++)
+        {
+          SpectrumValue sinr (model);
+          for (uint32_t i = 0; i < rbs; i++)
+            {
+              double sinrDb = -5 + 2 * k + 6 * std::sin (0.21 * i + k) + 3 * std::cos (1.3 * i);
+              sinr[i] = std::pow (10.0, sinrDb / 10.0);
+            }
+          sinrs.push_back (sinr);
+        }
+
+      std::ostringstream oss;
+      oss << ", " << rbs << " RBs";
+      SystemWallClockMs time;
+
+      time.Start ();
+      total += Create (piro, sinrs, n, rbgSizes[b]);
+      Report (n, time.End (), "PiroEW2010" + oss.str ());
+
+      time.Start ();
+      total += Create (mi, sinrs, n, rbs);
+      Report (n, time.End (), "MiErrorModel wideband (P10)" + oss.str ());
+
+      time.Start ();
+      total += Create (mi, sinrs, n, rbgSizes[b]);
+      Report (n, time.End (), "MiErrorModel subband (A30)" + oss.str ());
+    }
+
+  // keep the compiler from discarding the loops
+  if (total == 0)
+    {
+      std::cerr << "Error-- no CQI created" << std::endl;
+      return 1;
+    }
+  return 0;
+}
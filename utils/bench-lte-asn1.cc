@@ -0,0 +1,264 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the ASN.1 encoding and decoding
+// of the RRC messages exchanged by LteRrcProtocolReal during a handover:
+// the measurement report of the UE, the handover preparation information
+// sent over X2, the RRC connection reconfiguration carrying the handover
+// command and its completion.  Messages are encoded into and decoded from
+// packets, as done by LteRrcProtocolReal.
+// Sample usage:  ./waf --run 'bench-lte-asn1 --n=100000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/packet.h"
+#include "ns3/lte-rrc-header.h"
+#include "ns3/lte-rrc-sap.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/**
+ * Print the rate of an operation.
+ * \param count the number of operations
+ * \param ms the elapsed time
+ * \param name the operation name
+ */
+static void
+Report (uint64_t count, uint64_t ms, std::string name)
+{
+  double ps = count;
+  ps *= 1000;
+  ps /= ms > 0 ? ms : 1;
+  std::cout << ps << " ops/s"
+            << " (" << ms << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+/**
+ * Encode and decode a message n times.
+ * \param msg the message
+ * \param n the number of encodings and decodings
+ * \param name the message name
+ * \return the number of bytes of the encoded packets
+ */
+template <class H, class M>
+static uint64_t
+Run (const M &msg, uint64_t n, std::string name)
+{
+  uint64_t bytes = 0;
+  SystemWallClockMs time;
+
+  time.Start ();
+  for (uint64_t i = 0; i < n; i++)
+    {
+      H header;
+      header.SetMessage (msg);
+      Ptr<Packet> packet = Create<Packet> ();
+      packet->AddHeader (header);
+      bytes += packet->GetSize ();
+    }
+  Report (n, time.End (), "encode " + name);
+
+  H source;
+  source.SetMessage (msg);
+  Ptr<Packet> encoded = Create<Packet> ();
+  encoded->AddHeader (source);
+
+  M decoded;
+  time.Start ();
+  for (uint64_t i = 0; i < n; i++)
+    {
+      Ptr<Packet> packet = encoded->Copy ();
+      H header;
+      packet->RemoveHeader (header);
+      decoded = header.GetMessage ();
+      bytes += header.GetSerializedSize ();
+    }
+  Report (n, time.End (), "decode " + name);
+
+  // the decoded message must encode as the original one
+  H check;
+  check.SetMessage (decoded);
+  Ptr<Packet> reencoded = Create<Packet> ();
+  reencoded->AddHeader (check);
+  std::vector<uint8_t> original (encoded->GetSize ());
+  std::vector<uint8_t> copy (reencoded->GetSize ());
+  encoded->CopyData (&original[0], original.size ());
+  reencoded->CopyData (&copy[0], copy.size ());
+  if (copy != original)
+    {
+      std::cerr << "Error-- " << name << " decoded differently" << std::endl;
+      exit (1);
+    }
+
+  std::cout << "  " << encoded->GetSize () << " bytes per message" << std::endl;
+  return bytes;
+}
+
+/**
+ * \return the radio resource configuration of a UE with one data radio bearer
+ */
+static LteRrcSap::RadioResourceConfigDedicated
+CreateRadioResourceConfigDedicated ()
+{
+  LteRrcSap::RadioResourceConfigDedicated rrcd;
+
+  LteRrcSap::SrbToAddMod srb;
+  srb.srbIdentity = 1;
+  srb.logicalChannelConfig.priority = 1;
+  srb.logicalChannelConfig.prioritizedBitRateKbps = 0;
+  srb.logicalChannelConfig.bucketSizeDurationMs = 100;
+  srb.logicalChannelConfig.logicalChannelGroup = 0;
+  rrcd.srbToAddModList.push_back (srb);
+
+  LteRrcSap::DrbToAddMod drb;
+  drb.epsBearerIdentity = 5;
+  drb.drbIdentity = 1;
+  drb.logicalChannelIdentity = 3;
+  drb.rlcConfig.choice = LteRrcSap::RlcConfig::AM;
+  drb.logicalChannelConfig.priority = 9;
+  drb.logicalChannelConfig.prioritizedBitRateKbps = 256;
+  drb.logicalChannelConfig.bucketSizeDurationMs = 100;
+  drb.logicalChannelConfig.logicalChannelGroup = 3;
+  rrcd.drbToAddModList.push_back (drb);
+
+  rrcd.havePhysicalConfigDedicated = true;
+  rrcd.physicalConfigDedicated.haveSoundingRsUlConfigDedicated = true;
+  rrcd.physicalConfigDedicated.soundingRsUlConfigDedicated.type = LteRrcSap::SoundingRsUlConfigDedicated::SETUP;
+  rrcd.physicalConfigDedicated.soundingRsUlConfigDedicated.srsBandwidth = 0;
+  rrcd.physicalConfigDedicated.soundingRsUlConfigDedicated.srsConfigIndex = 17;
+  rrcd.physicalConfigDedicated.haveAntennaInfoDedicated = true;
+  rrcd.physicalConfigDedicated.antennaInfo.transmissionMode = 0;
+  rrcd.physicalConfigDedicated.havePdschConfigDedicated = true;
+  rrcd.physicalConfigDedicated.pdschConfigDedicated.pa = LteRrcSap::PdschConfigDedicated::dB0;
+  return rrcd;
+}
+
+/**
+ * \return an empty measurement configuration
+ */
+static LteRrcSap::MeasConfig
+CreateMeasConfig ()
+{
+  LteRrcSap::MeasConfig measConfig;
+  measConfig.haveQuantityConfig = false;
+  measConfig.haveMeasGapConfig = false;
+  measConfig.haveSmeasure = false;
+  measConfig.haveSpeedStatePars = false;
+  return measConfig;
+}
+
+int main (int argc, char *argv[])
+{
+  uint64_t n = 100000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the ASN.1 encoding and decoding of the RRC handover messages");
+  cmd.AddValue ("n", "number of encodings and decodings per message", n);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- the number of encodings must be positive" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-lte-asn1 with n=" << n << std::endl;
+
+  uint64_t bytes = 0;
+
+  // measurement report of an A3 event, with four neighbours
+  LteRrcSap::MeasurementReport report;
+  report.measResults.measId = 1;
+  report.measResults.rsrpResult = 45;
+  report.measResults.rsrqResult = 20;
+  report.measResults.haveMeasResultNeighCells = true;
+  for (uint16_t cellId = 2; cellId < 6; cellId++)
+    {
+      LteRrcSap::MeasResultEutra neighbour;
+      neighbour.physCellId = cellId;
+      neighbour.haveCgiInfo = false;
+      neighbour.haveRsrpResult = true;
+      neighbour.rsrpResult = 40 + cellId;
+      neighbour.haveRsrqResult = true;
+      neighbour.rsrqResult = 18 + cellId;
+      report.measResults.measResultListEutra.push_back (neighbour);
+    }
+  report.measResults.haveScellsMeas = false;
+  bytes += Run<MeasurementReportHeader> (report, n, "MeasurementReport");
+
+  // handover preparation information sent by the source eNB over X2
+  LteRrcSap::HandoverPreparationInfo hpi;
+  hpi.asConfig.sourceMeasConfig = CreateMeasConfig ();
+  hpi.asConfig.sourceRadioResourceConfig = CreateRadioResourceConfigDedicated ();
+  hpi.asConfig.sourceUeIdentity = 7;
+  hpi.asConfig.sourceMasterInformationBlock.dlBandwidth = 25;
+  hpi.asConfig.sourceMasterInformationBlock.systemFrameNumber = 0;
+  hpi.asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.plmnIdentityInfo.plmnIdentity = 0;
+  hpi.asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.cellIdentity = 1;
+  hpi.asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.csgIndication = false;
+  hpi.asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.csgIdentity = 0;
+  hpi.asConfig.sourceSystemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.preambleInfo.numberOfRaPreambles = 52;
+  hpi.asConfig.sourceSystemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.preambleTransMax = 50;
+  hpi.asConfig.sourceSystemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.raResponseWindowSize = 3;
+  hpi.asConfig.sourceSystemInformationBlockType2.freqInfo.ulCarrierFreq = 18100;
+  hpi.asConfig.sourceSystemInformationBlockType2.freqInfo.ulBandwidth = 25;
+  hpi.asConfig.sourceDlCarrierFreq = 100;
+  bytes += Run<HandoverPreparationInfoHeader> (hpi, n, "HandoverPreparationInfo");
+
+  // handover command built by the target eNB
+  LteRrcSap::RrcConnectionReconfiguration command;
+  command.rrcTransactionIdentifier = 1;
+  command.haveMeasConfig = true;
+  command.measConfig = CreateMeasConfig ();
+  command.measConfig.measIdToRemoveList.push_back (1);
+  command.haveMobilityControlInfo = true;
+  command.mobilityControlInfo.targetPhysCellId = 2;
+  command.mobilityControlInfo.haveCarrierFreq = true;
+  command.mobilityControlInfo.carrierFreq.dlCarrierFreq = 100;
+  command.mobilityControlInfo.carrierFreq.ulCarrierFreq = 18100;
+  command.mobilityControlInfo.haveCarrierBandwidth = true;
+  command.mobilityControlInfo.carrierBandwidth.dlBandwidth = 25;
+  command.mobilityControlInfo.carrierBandwidth.ulBandwidth = 25;
+  command.mobilityControlInfo.newUeIdentity = 3;
+  command.mobilityControlInfo.haveRachConfigDedicated = true;
+  command.mobilityControlInfo.rachConfigDedicated.raPreambleIndex = 60;
+  command.mobilityControlInfo.rachConfigDedicated.raPrachMaskIndex = 0;
+  command.mobilityControlInfo.radioResourceConfigCommon.rachConfigCommon.preambleInfo.numberOfRaPreambles = 52;
+  command.mobilityControlInfo.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.preambleTransMax = 50;
+  command.mobilityControlInfo.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.raResponseWindowSize = 3;
+  command.haveRadioResourceConfigDedicated = true;
+  command.radioResourceConfigDedicated = CreateRadioResourceConfigDedicated ();
+  command.haveNonCriticalExtension = false;
+  bytes += Run<RrcConnectionReconfigurationHeader> (command, n, "RrcConnectionReconfiguration");
+
+  // completion of the handover
+  LteRrcSap::RrcConnectionReconfigurationCompleted complete;
+  complete.rrcTransactionIdentifier = 1;
+  bytes += Run<RrcConnectionReconfigurationCompleteHeader> (complete, n, "RrcConnectionReconfigurationComplete");
+
+  // keep the compiler from discarding the loops
+  if (bytes == 0)
+    {
+      std::cerr << "Error-- nothing encoded" << std::endl;
+      return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,279 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the setup of a city scenario, with
+// eNodeBs spread over a square area with 500 m between neighbours:
+//  - the search of the closest eNodeB of 'ues' UEs among 'enbs' eNodeBs,
+//    by a linear search and with the k-d tree of LteHelper::AttachToClosestEnb;
+//  - the installation of 'devUes' UE and 'devEnbs' eNodeB devices and
+//    LteHelper::AttachToClosestEnb;
+//  - the initial cell selection of 'idleUes' UEs among 'idleEnbs' eNodeBs,
+//    with the cells below 'rsrpThreshold' ignored during the cell search,
+//    and the signals with a pathloss above 'maxLossDb' not propagated by
+//    the spectrum channel.
+// Sample usage:  ./waf --run 'bench-lte-attach --ues=10000 --enbs=500'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/simulator.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/position-allocator.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/lte-helper.h"
+#include "ns3/lte-enb-net-device.h"
+#include "ns3/lte-ue-net-device.h"
+#include "ns3/epc-ue-nas.h"
+#include "ns3/lte-ue-rrc.h"
+#include "ns3/position-kd-tree.h"
+#include <iostream>
+#include <limits>
+#include <cmath>
+#include <vector>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/**
+ * Place nodes uniformly at random over the area of a city.
+ * \param enbs the number of eNodeBs of the city
+ * \param n the number of positions
+ * \param z the height of the positions
+ * \return the positions
+ */
+static std::vector<Vector>
+CreatePositions (uint32_t enbs, uint32_t n, double z)
+{
+  double side = std::sqrt ((double) enbs) * 500.0;
+  Ptr<UniformRandomVariable> rv = CreateObject<UniformRandomVariable> ();
+  std::vector<Vector> positions;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      positions.push_back (Vector (rv->GetValue (0, side), rv->GetValue (0, side), z));
+    }
+  return positions;
+}
+
+/**
+ * Install mobility models at fixed positions.
+ * \param nodes the nodes
+ * \param positions the positions of the nodes
+ */
+static void
+InstallMobility (NodeContainer nodes, const std::vector<Vector> &positions)
+{
+  Ptr<ListPositionAllocator> allocator = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < positions.size (); i++)
+    {
+      allocator->Add (positions[i]);
+    }
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (allocator);
+  mobility.Install (nodes);
+}
+
+/**
+ * Compare the linear search of the closest eNodeB and the k-d tree.
+ * \param ues the number of UEs
+ * \param enbs the number of eNodeBs
+ */
+static void
+BenchSearch (uint32_t ues, uint32_t enbs)
+{
+  std::vector<Vector> enbPositions = CreatePositions (enbs, enbs, 30.0);
+  std::vector<Vector> uePositions = CreatePositions (enbs, ues, 1.5);
+  std::vector<uint32_t> linear (ues);
+  std::vector<uint32_t> tree (ues);
+  SystemWallClockMs time;
+
+  time.Start ();
+  for (uint32_t u = 0; u < ues; u++)
+    {
+      double minDistance = std::numeric_limits<double>::infinity ();
+      for (uint32_t e = 0; e < enbs; e++)
+        {
+          double distance = CalculateDistance (uePositions[u], enbPositions[e]);
+          if (distance < minDistance)
+            {
+              minDistance = distance;
+              linear[u] = e;
+            }
+        }
+    }
+  uint64_t linearMs = time.End ();
+
+  time.Start ();
+  PositionKdTree enbTree;
+  enbTree.Build (enbPositions);
+  uint64_t buildMs = time.End ();
+  time.Start ();
+  for (uint32_t u = 0; u < ues; u++)
+    {
+      tree[u] = enbTree.FindClosest (uePositions[u]);
+    }
+  uint64_t treeMs = time.End ();
+
+  uint32_t mismatches = 0;
+  for (uint32_t u = 0; u < ues; u++)
+    {
+      mismatches += (linear[u] != tree[u]);
+    }
+  std::cout << "closest eNB of " << ues << " UEs among " << enbs << " eNBs:" << std::endl
+            << "  linear search " << linearMs << " ms" << std::endl
+            << "  k-d tree      " << buildMs + treeMs << " ms (build " << buildMs
+            << " ms, search " << treeMs << " ms)" << std::endl;
+  if (mismatches > 0)
+    {
+      std::cerr << "Error-- " << mismatches << " different closest eNBs" << std::endl;
+      exit (1);
+    }
+}
+
+/**
+ * Time the installation of the devices and the attachment to the closest eNodeB.
+ * \param ues the number of UEs
+ * \param enbs the number of eNodeBs
+ */
+static void
+BenchAttach (uint32_t ues, uint32_t enbs)
+{
+  NodeContainer enbNodes;
+  enbNodes.Create (enbs);
+  NodeContainer ueNodes;
+  ueNodes.Create (ues);
+  InstallMobility (enbNodes, CreatePositions (enbs, enbs, 30.0));
+  InstallMobility (ueNodes, CreatePositions (enbs, ues, 1.5));
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  SystemWallClockMs time;
+
+  time.Start ();
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  uint64_t enbMs = time.End ();
+  time.Start ();
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  uint64_t ueMs = time.End ();
+  time.Start ();
+  lteHelper->AttachToClosestEnb (ueDevs, enbDevs);
+  uint64_t attachMs = time.End ();
+
+  std::cout << "setup of " << ues << " UEs and " << enbs << " eNBs:" << std::endl
+            << "  InstallEnbDevice   " << enbMs << " ms" << std::endl
+            << "  InstallUeDevice    " << ueMs << " ms" << std::endl
+            << "  AttachToClosestEnb " << attachMs << " ms" << std::endl;
+  Simulator::Destroy ();
+}
+
+/**
+ * Time the initial cell selection of idle UEs.
+ * \param ues the number of UEs
+ * \param enbs the number of eNodeBs
+ * \param simTime the simulated time in seconds
+ */
+static void
+BenchCellSelection (uint32_t ues, uint32_t enbs, double simTime)
+{
+  NodeContainer enbNodes;
+  enbNodes.Create (enbs);
+  NodeContainer ueNodes;
+  ueNodes.Create (ues);
+  InstallMobility (enbNodes, CreatePositions (enbs, enbs, 30.0));
+  InstallMobility (ueNodes, CreatePositions (enbs, ues, 1.5));
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+
+  uint32_t dlEarfcn = enbDevs.Get (0)->GetObject<LteEnbNetDevice> ()->GetDlEarfcn ();
+  for (uint32_t i = 0; i < ueDevs.GetN (); i++)
+    {
+      ueDevs.Get (i)->GetObject<LteUeNetDevice> ()->GetNas ()->StartCellSelection (dlEarfcn);
+    }
+
+  Simulator::Stop (Seconds (simTime));
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  uint64_t ms = time.End ();
+
+  uint32_t camped = 0;
+  for (uint32_t i = 0; i < ueDevs.GetN (); i++)
+    {
+      if (ueDevs.Get (i)->GetObject<LteUeNetDevice> ()->GetRrc ()->GetState ()
+          == LteUeRrc::IDLE_CAMPED_NORMALLY)
+        {
+          camped++;
+        }
+    }
+  Simulator::Destroy ();
+
+  std::cout << "cell selection of " << ues << " UEs among " << enbs << " eNBs:" << std::endl
+            << "  " << ms << " ms elapsed, " << camped << " UEs camped" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t ues = 10000;
+  uint32_t enbs = 500;
+  uint32_t devUes = 500;
+  uint32_t devEnbs = 50;
+  uint32_t idleUes = 20;
+  uint32_t idleEnbs = 20;
+  double rsrpThreshold = -1000.0;
+  double maxLossDb = 1.0e9;
+  double simTime = 0.5;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the setup of a city scenario");
+  cmd.AddValue ("ues", "number of UEs of the closest eNB search", ues);
+  cmd.AddValue ("enbs", "number of eNBs of the closest eNB search", enbs);
+  cmd.AddValue ("devUes", "number of UE devices to install and attach (0 to skip)", devUes);
+  cmd.AddValue ("devEnbs", "number of eNB devices to install", devEnbs);
+  cmd.AddValue ("idleUes", "number of UEs of the cell selection (0 to skip)", idleUes);
+  cmd.AddValue ("idleEnbs", "number of eNBs of the cell selection", idleEnbs);
+  cmd.AddValue ("rsrpThreshold", "RSRP [dBm] below which cells are ignored by the cell search", rsrpThreshold);
+  cmd.AddValue ("maxLossDb", "pathloss [dB] above which the signals are not propagated", maxLossDb);
+  cmd.AddValue ("simTime", "simulated time of the cell selection in seconds", simTime);
+  cmd.Parse (argc, argv);
+
+  if (ues == 0 || enbs == 0 || (devUes > 0 && devEnbs == 0) || (idleUes > 0 && idleEnbs == 0))
+    {
+      std::cerr << "Error-- the number of eNBs must be positive" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-lte-attach with ues=" << ues << " enbs=" << enbs
+            << " devUes=" << devUes << " devEnbs=" << devEnbs
+            << " idleUes=" << idleUes << " idleEnbs=" << idleEnbs
+            << " rsrpThreshold=" << rsrpThreshold << " maxLossDb=" << maxLossDb << std::endl;
+
+  Config::SetDefault ("ns3::LteUePhy::CellSearchRsrpThreshold", DoubleValue (rsrpThreshold));
+  Config::SetDefault ("ns3::MultiModelSpectrumChannel::MaxLossDb", DoubleValue (maxLossDb));
+
+  BenchSearch (ues, enbs);
+  if (devUes > 0)
+    {
+      BenchAttach (devUes, devEnbs);
+    }
+  if (idleUes > 0)
+    {
+      BenchCellSelection (idleUes, idleEnbs, simTime);
+    }
+  return 0;
+}
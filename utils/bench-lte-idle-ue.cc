@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the per-subframe processing of
+// UEs which are camped on a cell but have nothing to transmit, e.g.,
+// a massive IoT deployment of 'n' idle UEs around a single eNodeB.
+// The UE PHY idle subframe skipping can be toggled with '--skip'.
+// Sample usage:  ./waf --run 'bench-lte-idle-ue --n=10000 --skip=1'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/simulator.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/lte-helper.h"
+#include "ns3/lte-enb-net-device.h"
+#include "ns3/lte-ue-net-device.h"
+#include "ns3/epc-ue-nas.h"
+#include "ns3/lte-ue-rrc.h"
+#include <iostream>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 1000;
+  double simTime = 1.0;
+  double radius = 500.0;
+  bool skip = true;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark a cell with many idle camped UEs");
+  cmd.AddValue ("n", "number of UEs", n);
+  cmd.AddValue ("simTime", "simulated time in seconds", simTime);
+  cmd.AddValue ("radius", "radius of the disc in which the UEs are placed", radius);
+  cmd.AddValue ("skip", "let the UE PHY skip idle subframes", skip);
+  cmd.Parse (argc, argv);
+
+  if (n == 0 || simTime <= 0)
+    {
+      std::cerr << "Error-- the number of UEs and the simulated time must be positive" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-lte-idle-ue with n=" << n << " simTime=" << simTime
+            << " skip=" << skip << std::endl;
+
+  Config::SetDefault ("ns3::LteUePhy::EnableIdleSubframeSkipping", BooleanValue (skip));
+
+  NodeContainer enbNodes;
+  enbNodes.Create (1);
+  NodeContainer ueNodes;
+  ueNodes.Create (n);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (enbNodes);
+  mobility.SetPositionAllocator ("ns3::UniformDiscPositionAllocator",
+                                 "rho", DoubleValue (radius));
+  mobility.Install (ueNodes);
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+
+  uint32_t dlEarfcn = enbDevs.Get (0)->GetObject<LteEnbNetDevice> ()->GetDlEarfcn ();
+  for (uint32_t i = 0; i < ueDevs.GetN (); i++)
+    {
+      ueDevs.Get (i)->GetObject<LteUeNetDevice> ()->GetNas ()->StartCellSelection (dlEarfcn);
+    }
+
+  Simulator::Stop (Seconds (simTime));
+
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  uint64_t ms = time.End ();
+
+  uint32_t camped = 0;
+  for (uint32_t i = 0; i < ueDevs.GetN (); i++)
+    {
+      if (ueDevs.Get (i)->GetObject<LteUeNetDevice> ()->GetRrc ()->GetState ()
+          == LteUeRrc::IDLE_CAMPED_NORMALLY)
+        {
+          camped++;
+        }
+    }
+  Simulator::Destroy ();
+
+  double ueSubframes = n * simTime * 1000;
+  std::cout << camped << " of " << n << " UEs camped" << std::endl;
+  std::cout << ms << " ms elapsed (" << ueSubframes / (ms > 0 ? ms / 1e3 : 1e-3)
+            << " UE subframes per second)" << std::endl;
+  return 0;
+}
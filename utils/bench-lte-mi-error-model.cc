@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the LTE MI error model, as
+// evaluated by the PHY for every TB received over 'rbs' RBs: the MI
+// of the TB, the BLER of its code blocks, sampled or evaluated, and
+// the whole TB decodification stats.
+// Sample usage:  ./waf --run 'bench-lte-mi-error-model --n=1000000 --rbs=100'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/spectrum-model.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/lte-mi-error-model.h"
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/**
+ * Print the rate of an operation.
+ * \param count the number of operations
+ * \param ms the elapsed time
+ * \param name the operation name
+ */
+static void
+Report (uint64_t count, uint64_t ms, std::string name)
+{
+  double ps = count;
+  ps *= 1000;
+  ps /= ms > 0 ? ms : 1;
+  std::cout << ps << " ops/s"
+            << " (" << ms << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint64_t n = 1000000;
+  uint32_t rbs = 100;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the LTE MI error model");
+  cmd.AddValue ("n", "number of evaluations per measure", n);
+  cmd.AddValue ("rbs", "number of RBs of a TB", rbs);
+  cmd.Parse (argc, argv);
+
+  if (n == 0 || rbs == 0 || rbs > 100)
+    {
+      std::cerr << "Error-- the number of evaluations must be positive and the number of RBs in [1..100]" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-lte-mi-error-model with n=" << n << " rbs=" << rbs << std::endl;
+
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      freqs.push_back (2.12e9 + i * 180e3);
+    }
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (freqs);
+
+  // SINRs around the thresholds of the MCSs, varying over the band
+  const uint32_t count = 64;
+  std::vector<SpectrumValue> sinrs;
+  for (uint32_t k = 0; k < count; k++)
+    {
+      SpectrumValue sinr (model);
+      for (uint32_t i = 0; i < 100; i++)
+        {
+          sinr[i] = std::pow (10.0, (-8.0 + 0.4 * k + 0.3 * (i % 7)) / 10.0);
+        }
+      sinrs.push_back (sinr);
+    }
+  std::vector<int> map;
+  for (uint32_t i = 0; i < rbs; i++)
+    {
+      map.push_back (i);
+    }
+
+  double total = 0;
+  SystemWallClockMs time;
+
+  time.Start ();
+  for (uint64_t i = 0; i < n; i++)
+    {
+      total += LteMiErrorModel::Mib (sinrs[i % count], map, (i * 7) % 29);
+    }
+  Report (n, time.End (), "Mib");
+
+  time.Start ();
+  for (uint64_t i = 0; i < n; i++)
+    {
+      total += LteMiErrorModel::MappingMiBler ((i % 1000) / 1000.0, (i * 7) % 38, 40 << (i % 8));
+    }
+  Report (n, time.End (), "MappingMiBler");
+
+  time.Start ();
+  for (uint64_t i = 0; i < n; i++)
+    {
+      total += LteMiErrorModel::EvaluateMiBler ((i % 1000) / 1000.0, (i * 7) % 38, 40 << (i % 8));
+    }
+  Report (n, time.End (), "EvaluateMiBler");
+
+  HarqProcessInfoList_t history;
+  time.Start ();
+  for (uint64_t i = 0; i < n; i++)
+    {
+      uint8_t mcs = (i * 7) % 29;
+      uint16_t size = 20 + (i % 100) * 15 * rbs / 10;
+      total += LteMiErrorModel::GetTbDecodificationStats (sinrs[i % count], map, size, mcs, history).tbler;
+    }
+  Report (n, time.End (), "GetTbDecodificationStats");
+
+  // keep the compiler from discarding the loops
+  if (total == 0)
+    {
+      std::cerr << "Error-- nothing evaluated" << std::endl;
+      return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,195 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the generation of a Radio
+// Environment Map of 'res' x 'res' points over 'enbs' eNodeBs spread on a
+// square grid with 500 m between neighbours:
+//  - with the listeners moved over the map during the simulation,
+//  - with the direct computation, in text and in binary, by one thread
+//    and by 'threads' threads.
+// The maps are written to files starting with 'prefix', and the maps of
+// the direct computation are compared to the one of the listeners.
+// Sample usage:  ./waf --run 'bench-lte-rem --enbs=16 --res=200 --threads=4'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/lte-helper.h"
+#include "ns3/spectrum-channel.h"
+#include "ns3/radio-environment-map-helper.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <cmath>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/**
+ * Generate a REM.
+ * \param enbs the number of eNodeBs
+ * \param res the resolution of the map along each axis
+ * \param computeDirectly the `ComputeDirectly` attribute of the REM
+ * \param threads the `NumThreads` attribute of the REM
+ * \param binary the `BinaryOutput` attribute of the REM
+ * \param filename the output file of the REM
+ * \return the wall time of the simulation in ms
+ */
+static uint64_t
+RunRem (uint32_t enbs, uint32_t res, bool computeDirectly, uint32_t threads,
+        bool binary, std::string filename)
+{
+  uint32_t side = std::ceil (std::sqrt ((double) enbs));
+  NodeContainer enbNodes;
+  enbNodes.Create (enbs);
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "MinX", DoubleValue (0.0),
+                                 "MinY", DoubleValue (0.0),
+                                 "DeltaX", DoubleValue (500.0),
+                                 "DeltaY", DoubleValue (500.0),
+                                 "GridWidth", UintegerValue (side));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (enbNodes);
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->InstallEnbDevice (enbNodes);
+
+  std::ostringstream channelPath;
+  channelPath << "/ChannelList/" << lteHelper->GetDownlinkSpectrumChannel ()->GetId ();
+  Ptr<RadioEnvironmentMapHelper> remHelper = CreateObject<RadioEnvironmentMapHelper> ();
+  remHelper->SetAttribute ("ChannelPath", StringValue (channelPath.str ()));
+  remHelper->SetAttribute ("OutputFile", StringValue (filename));
+  remHelper->SetAttribute ("XMin", DoubleValue (-250.0));
+  remHelper->SetAttribute ("XMax", DoubleValue (side * 500.0 - 250.0));
+  remHelper->SetAttribute ("XRes", UintegerValue (res));
+  remHelper->SetAttribute ("YMin", DoubleValue (-250.0));
+  remHelper->SetAttribute ("YMax", DoubleValue (side * 500.0 - 250.0));
+  remHelper->SetAttribute ("YRes", UintegerValue (res));
+  remHelper->SetAttribute ("Z", DoubleValue (1.5));
+  remHelper->SetAttribute ("ComputeDirectly", BooleanValue (computeDirectly));
+  remHelper->SetAttribute ("NumThreads", UintegerValue (threads));
+  remHelper->SetAttribute ("BinaryOutput", BooleanValue (binary));
+  remHelper->Install ();
+
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  uint64_t ms = time.End ();
+  Simulator::Destroy ();
+  return ms;
+}
+
+/**
+ * \param filename a REM file in text
+ * \return the SINR of the points of the REM
+ */
+static std::vector<double>
+ReadSinr (std::string filename)
+{
+  std::vector<double> sinr;
+  std::ifstream file (filename.c_str ());
+  double x, y, z, s;
+  while (file >> x >> y >> z >> s)
+    {
+      sinr.push_back (s);
+    }
+  return sinr;
+}
+
+/**
+ * \param a the SINR of a REM
+ * \param b the SINR of another REM
+ * \return the largest relative difference of the SINR
+ */
+static double
+MaxRelativeDifference (const std::vector<double> &a, const std::vector<double> &b)
+{
+  if (a.size () != b.size () || a.empty ())
+    {
+      std::cerr << "Error-- REMs of " << a.size () << " and " << b.size () << " points" << std::endl;
+      exit (1);
+    }
+  double diff = 0;
+  for (uint32_t i = 0; i < a.size (); i++)
+    {
+      if (a[i] != b[i])
+        {
+          diff = std::max (diff, std::fabs (a[i] - b[i]) / std::max (std::fabs (a[i]), std::fabs (b[i])));
+        }
+    }
+  return diff;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t enbs = 16;
+  uint32_t res = 100;
+  uint32_t threads = 4;
+  bool listeners = true;
+  std::string prefix = "bench-lte-rem";
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the generation of a Radio Environment Map");
+  cmd.AddValue ("enbs", "number of eNBs", enbs);
+  cmd.AddValue ("res", "number of points of the map along each axis", res);
+  cmd.AddValue ("threads", "number of threads of the direct computation", threads);
+  cmd.AddValue ("listeners", "whether to generate the map with the listeners too", listeners);
+  cmd.AddValue ("prefix", "prefix of the output files", prefix);
+  cmd.Parse (argc, argv);
+
+  if (enbs == 0 || res < 2 || threads == 0)
+    {
+      std::cerr << "Error-- at least 1 eNB, 2 points per axis and 1 thread are needed" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-lte-rem with enbs=" << enbs << " res=" << res
+            << " threads=" << threads << std::endl;
+
+  std::string listenersFile = prefix + "-listeners.out";
+  std::string directFile = prefix + "-direct.out";
+  std::string threadsFile = prefix + "-threads.out";
+  std::string binaryFile = prefix + "-threads.bin";
+
+  if (listeners)
+    {
+      std::cout << "listeners:                " << RunRem (enbs, res, false, 1, false, listenersFile) << " ms" << std::endl;
+    }
+  std::cout << "direct, 1 thread:         " << RunRem (enbs, res, true, 1, false, directFile) << " ms" << std::endl;
+  std::cout << "direct, " << threads << " threads:        " << RunRem (enbs, res, true, threads, false, threadsFile) << " ms" << std::endl;
+  std::cout << "direct, " << threads << " threads, binary: " << RunRem (enbs, res, true, threads, true, binaryFile) << " ms" << std::endl;
+
+  std::vector<double> direct = ReadSinr (directFile);
+  if (MaxRelativeDifference (direct, ReadSinr (threadsFile)) != 0)
+    {
+      std::cerr << "Error-- different REMs with 1 and " << threads << " threads" << std::endl;
+      exit (1);
+    }
+  if (listeners)
+    {
+      std::cout << "largest relative SINR difference with the listeners: "
+                << MaxRelativeDifference (ReadSinr (listenersFile), direct) << std::endl;
+    }
+  return 0;
+}
@@ -0,0 +1,298 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the LTE RLC entities: two AM (or
+// UM) entities are connected back to back, without MAC nor PHY, and the
+// sender is given 'opportunities' transmission opportunities per 1 ms TTI
+// for a total of 'rate' Mbps during 'simTime' seconds. SDUs of 'sduSize'
+// bytes are offered at the same rate, on top of a backlog of 'backlog'
+// SDUs queued at the start, and each PDU is lost with probability 'loss',
+// so that the receiver reorders them and, in AM, requests their
+// retransmission.
+// Sample usage:  ./waf --run 'bench-lte-rlc --mode=am --rate=300 --opportunities=2 --loss=0.01'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/lte-rlc.h"
+#include "ns3/lte-rlc-am.h"
+#include "ns3/lte-rlc-um.h"
+#include "ns3/lte-rlc-sap.h"
+#include "ns3/lte-mac-sap.h"
+#include "ns3/uinteger.h"
+#include <iostream>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/**
+ * The MAC SAP of a RLC entity, which delivers its PDUs directly to the
+ * peer RLC entity, unless they are lost, and keeps its last buffer status.
+ */
+class BenchRlcMac : public LteMacSapProvider
+{
+public:
+  /**
+   * Constructor
+   * \param loss the probability of losing a PDU
+   */
+  BenchRlcMac (double loss)
+    : m_peer (0),
+      m_loss (loss),
+      m_pdus (0),
+      m_bytes (0)
+  {
+    m_rv = CreateObject<UniformRandomVariable> ();
+    m_bufferStatus.txQueueSize = 0;
+    m_bufferStatus.retxQueueSize = 0;
+    m_bufferStatus.statusPduSize = 0;
+  }
+
+  /**
+   * \param peer the MAC SAP of the peer RLC entity
+   */
+  void SetPeer (LteMacSapUser *peer)
+  {
+    m_peer = peer;
+  }
+
+  // inherited from LteMacSapProvider
+  virtual void TransmitPdu (TransmitPduParameters params)
+  {
+    m_pdus++;
+    m_bytes += params.pdu->GetSize ();
+    if (m_loss > 0 && m_rv->GetValue () < m_loss)
+      {
+        return;
+      }
+    m_peer->ReceivePdu (params.pdu, params.rnti, params.lcid);
+  }
+
+  // inherited from LteMacSapProvider
+  virtual void ReportBufferStatus (ReportBufferStatusParameters params)
+  {
+    m_bufferStatus = params;
+  }
+
+  /**
+   * \return the bytes that the RLC entity has to transmit, as last reported
+   */
+  uint32_t GetPendingBytes (void) const
+  {
+    return m_bufferStatus.txQueueSize + m_bufferStatus.retxQueueSize + m_bufferStatus.statusPduSize;
+  }
+
+  /**
+   * \return the size of the STATUS PDU that the RLC entity has to transmit, as last reported
+   */
+  uint32_t GetStatusPduSize (void) const
+  {
+    return m_bufferStatus.statusPduSize;
+  }
+
+  LteMacSapUser *m_peer;                        ///< the MAC SAP of the peer RLC entity
+  double m_loss;                                ///< the probability of losing a PDU
+  Ptr<UniformRandomVariable> m_rv;              ///< the random variable of the losses
+  ReportBufferStatusParameters m_bufferStatus;  ///< the last buffer status
+  uint64_t m_pdus;                              ///< the number of transmitted PDUs
+  uint64_t m_bytes;                             ///< the number of transmitted bytes
+};
+
+/**
+ * The RLC SAP of the receiving RLC entity, which counts the delivered SDUs.
+ */
+class BenchRlcSink : public LteRlcSapUser
+{
+public:
+  BenchRlcSink ()
+    : m_sdus (0),
+      m_bytes (0)
+  {
+  }
+
+  // inherited from LteRlcSapUser
+  virtual void ReceivePdcpPdu (Ptr<Packet> p)
+  {
+    m_sdus++;
+    m_bytes += p->GetSize ();
+  }
+
+  uint64_t m_sdus;  ///< the number of delivered SDUs
+  uint64_t m_bytes; ///< the number of delivered bytes
+};
+
+/**
+ * Two RLC entities connected back to back, driven every TTI.
+ */
+class BenchRlcLink
+{
+public:
+  /**
+   * Constructor
+   * \param mode "am" or "um"
+   * \param bytesPerTti the bytes offered and granted to the sender every TTI
+   * \param opportunities the number of transmission opportunities per TTI
+   * \param sduSize the size of the SDUs
+   * \param backlog the number of SDUs queued at the start
+   * \param loss the probability of losing a PDU
+   */
+  BenchRlcLink (std::string mode, uint32_t bytesPerTti, uint32_t opportunities,
+                uint32_t sduSize, uint32_t backlog, double loss)
+    : m_senderMac (loss),
+      m_receiverMac (loss),
+      m_bytesPerTti (bytesPerTti),
+      m_opportunities (opportunities),
+      m_sduSize (sduSize),
+      m_credit (0),
+      m_sdus (0)
+  {
+    if (mode == "am")
+      {
+        m_sender = CreateObject<LteRlcAm> ();
+        m_receiver = CreateObject<LteRlcAm> ();
+      }
+    else
+      {
+        m_sender = CreateObjectWithAttributes<LteRlcUm> ("MaxTxBufferSize", UintegerValue (UINT32_MAX));
+        m_receiver = CreateObjectWithAttributes<LteRlcUm> ("MaxTxBufferSize", UintegerValue (UINT32_MAX));
+      }
+    Ptr<LteRlc> rlcs[2] = { m_sender, m_receiver };
+    BenchRlcMac *macs[2] = { &m_senderMac, &m_receiverMac };
+    for (uint32_t i = 0; i < 2; i++)
+      {
+        rlcs[i]->SetRnti (1);
+        rlcs[i]->SetLcId (3);
+        rlcs[i]->SetLteRlcSapUser (&m_sink);
+        rlcs[i]->SetLteMacSapProvider (macs[i]);
+      }
+    m_senderMac.SetPeer (m_receiver->GetLteMacSapUser ());
+    m_receiverMac.SetPeer (m_sender->GetLteMacSapUser ());
+    for (uint32_t i = 0; i < backlog; i++)
+      {
+        SendSdu ();
+      }
+    Simulator::ScheduleNow (&BenchRlcLink::Tti, this);
+  }
+
+  ~BenchRlcLink ()
+  {
+    m_sender->Dispose ();
+    m_receiver->Dispose ();
+  }
+
+  /// Offer the SDUs and give the transmission opportunities of a TTI
+  void Tti (void)
+  {
+    for (m_credit += m_bytesPerTti; m_credit >= m_sduSize; m_credit -= m_sduSize)
+      {
+        SendSdu ();
+      }
+    // the STATUS PDUs of the receiver first, like the MAC does with the
+    // uplink grants
+    if (m_receiverMac.GetStatusPduSize () > 0)
+      {
+        m_receiver->GetLteMacSapUser ()->NotifyTxOpportunity (m_receiverMac.GetPendingBytes (), 0, 0, 0, 1, 3);
+      }
+    for (uint32_t i = 0; i < m_opportunities; i++)
+      {
+        m_sender->GetLteMacSapUser ()->NotifyTxOpportunity (m_bytesPerTti / m_opportunities, 0, i % 8, i, 1, 3);
+      }
+    Simulator::Schedule (MilliSeconds (1), &BenchRlcLink::Tti, this);
+  }
+
+  /// Give a SDU to the sender
+  void SendSdu (void)
+  {
+    LteRlcSapProvider::TransmitPdcpPduParameters params;
+    params.pdcpPdu = Create<Packet> (m_sduSize);
+    params.rnti = 1;
+    params.lcid = 3;
+    m_sender->GetLteRlcSapProvider ()->TransmitPdcpPdu (params);
+    m_sdus++;
+  }
+
+  Ptr<LteRlc> m_sender;       ///< the sending RLC entity
+  Ptr<LteRlc> m_receiver;     ///< the receiving RLC entity
+  BenchRlcMac m_senderMac;    ///< the MAC SAP of the sender
+  BenchRlcMac m_receiverMac;  ///< the MAC SAP of the receiver
+  BenchRlcSink m_sink;        ///< the RLC SAP of both entities
+  uint32_t m_bytesPerTti;     ///< the bytes offered and granted every TTI
+  uint32_t m_opportunities;   ///< the number of transmission opportunities per TTI
+  uint32_t m_sduSize;         ///< the size of the SDUs
+  uint32_t m_credit;          ///< the bytes offered but not yet sent as a SDU
+  uint64_t m_sdus;            ///< the number of SDUs given to the sender
+};
+
+int main (int argc, char *argv[])
+{
+  std::string mode = "am";
+  double rate = 150.0;
+  uint32_t opportunities = 1;
+  uint32_t sduSize = 1500;
+  uint32_t backlog = 10000;
+  double loss = 0.0;
+  double simTime = 10.0;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark two LTE RLC entities connected back to back");
+  cmd.AddValue ("mode", "RLC mode: am or um", mode);
+  cmd.AddValue ("rate", "line rate in Mbps", rate);
+  cmd.AddValue ("opportunities", "number of transmission opportunities per TTI", opportunities);
+  cmd.AddValue ("sduSize", "size of the SDUs in bytes", sduSize);
+  cmd.AddValue ("backlog", "number of SDUs queued at the start", backlog);
+  cmd.AddValue ("loss", "probability of losing a PDU", loss);
+  cmd.AddValue ("simTime", "simulated time in seconds", simTime);
+  cmd.Parse (argc, argv);
+
+  uint32_t bytesPerTti = rate * 1e6 / 8 / 1000;
+  if ((mode != "am" && mode != "um") || opportunities == 0 || sduSize == 0
+      || bytesPerTti / opportunities < 10 || loss < 0 || loss >= 1)
+    {
+      std::cerr << "Error-- invalid parameters" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-lte-rlc with mode=" << mode << " rate=" << rate
+            << " opportunities=" << opportunities << " sduSize=" << sduSize
+            << " backlog=" << backlog << " loss=" << loss << " simTime=" << simTime << std::endl;
+
+  SystemWallClockMs time;
+  time.Start ();
+  uint64_t ms;
+  {
+    BenchRlcLink link (mode, bytesPerTti, opportunities, sduSize, backlog, loss);
+    Simulator::Stop (Seconds (simTime));
+    Simulator::Run ();
+    ms = time.End ();
+
+    std::cout << "SDUs offered:   " << link.m_sdus << std::endl
+              << "SDUs delivered: " << link.m_sink.m_sdus << " ("
+              << link.m_sink.m_bytes * 8 / simTime / 1e6 << " Mbps)" << std::endl
+              << "PDUs sent:      " << link.m_senderMac.m_pdus << " data, "
+              << link.m_receiverMac.m_pdus << " status" << std::endl
+              << "elapsed:        " << ms << " ms ("
+              << (link.m_senderMac.m_pdus > 0 ? ms * 1e6 / link.m_senderMac.m_pdus : 0)
+              << " ns per data PDU)" << std::endl;
+    if (link.m_sink.m_sdus == 0)
+      {
+        std::cerr << "Error-- no SDU delivered" << std::endl;
+        exit (1);
+      }
+  }
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,784 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the LTE MAC schedulers in
+// isolation, without the PHY, the channel and the RLC.  The schedulers
+// are driven through the FF MAC Scheduler API, either by 'n' synthetic
+// full-buffer UEs, which report fixed CQIs periodically and whose DL
+// transmissions are all acknowledged, or by the calls of a real cell
+// recorded with ns3::RecordingFfMacScheduler (see below).  For each
+// scheduler, the program reports the distribution of the time spent
+// per TTI and the resources allocated.
+// Sample usage:
+//   ./waf --run 'bench-lte-scheduler --n=200 --scheduler=ns3::PfFfMacScheduler'
+//
+// To replay a recorded trace, run the scenario with
+//   lteHelper->SetSchedulerType ("ns3::RecordingFfMacScheduler");
+//   lteHelper->SetSchedulerAttribute ("SchedulerType", StringValue ("ns3::PfFfMacScheduler"));
+// and then
+//   ./waf --run 'bench-lte-scheduler --trace=ff-mac-sched-0.trace'
+// The CQI, buffer status, SR and RACH reports are replayed as recorded.
+// The HARQ feedback follows the allocations of the replayed scheduler:
+// each transmission to a UE gets the outcome and the feedback delay of
+// the next recorded transmission to the same UE.
+
+#include "ns3/command-line.h"
+#include "ns3/object-factory.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/ff-mac-scheduler.h"
+#include "ns3/ff-mac-csched-sap.h"
+#include "ns3/ff-mac-sched-sap.h"
+#include "ns3/ff-mac-sched-trace.h"
+#include "ns3/lte-fr-no-op-algorithm.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/// The LCID of the data radio bearer of the UEs
+static const uint8_t LCID = 3;
+
+/// The delay of the HARQ feedback, in TTIs, when the trace has none
+static const uint32_t DEFAULT_HARQ_DELAY = 4;
+
+/**
+ * MAC side of the CSCHED SAP, which ignores the confirmations.
+ */
+class BenchCschedSapUser : public FfMacCschedSapUser
+{
+public:
+  virtual void CschedCellConfigCnf (const struct CschedCellConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedUeConfigCnf (const struct CschedUeConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedLcConfigCnf (const struct CschedLcConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedLcReleaseCnf (const struct CschedLcReleaseCnfParameters& params)
+  {
+  }
+  virtual void CschedUeReleaseCnf (const struct CschedUeReleaseCnfParameters& params)
+  {
+  }
+  virtual void CschedUeConfigUpdateInd (const struct CschedUeConfigUpdateIndParameters& params)
+  {
+  }
+  virtual void CschedCellConfigUpdateInd (const struct CschedCellConfigUpdateIndParameters& params)
+  {
+  }
+};
+
+/**
+ * MAC side of the SCHED SAP, which keeps the allocations of the last
+ * TTI and counts the resources allocated.
+ */
+class BenchSchedSapUser : public FfMacSchedSapUser
+{
+public:
+  BenchSchedSapUser ()
+    : m_dlRbgs (0),
+      m_dlBytes (0),
+      m_dlDcis (0),
+      m_ulGrants (0),
+      m_ulBytes (0)
+  {
+  }
+  virtual void SchedDlConfigInd (const struct SchedDlConfigIndParameters& params)
+  {
+    for (uint32_t i = 0; i < params.m_buildDataList.size (); i++)
+      {
+        const BuildDataListElement_s &data = params.m_buildDataList[i];
+        for (uint32_t j = 0; j < data.m_dci.m_tbsSize.size (); j++)
+          {
+            m_dlBytes += data.m_dci.m_tbsSize[j];
+            m_dlBytesPerUe[data.m_rnti] += data.m_dci.m_tbsSize[j];
+          }
+        for (uint32_t rbgMask = data.m_dci.m_rbBitmap; rbgMask != 0; rbgMask &= rbgMask - 1)
+          {
+            m_dlRbgs++;
+          }
+        m_dl.push_back (data.m_dci);
+      }
+    m_dlDcis += params.m_buildDataList.size ();
+  }
+  virtual void SchedUlConfigInd (const struct SchedUlConfigIndParameters& params)
+  {
+    for (uint32_t i = 0; i < params.m_dciList.size (); i++)
+      {
+        m_ulBytes += params.m_dciList[i].m_tbSize;
+        m_ul.push_back (params.m_dciList[i]);
+      }
+    m_ulGrants += params.m_dciList.size ();
+  }
+
+  std::vector<DlDciListElement_s> m_dl;       //!< DL allocations since the last HARQ feedback
+  std::vector<UlDciListElement_s> m_ul;       //!< UL allocations since the last HARQ feedback
+  std::map<uint16_t, uint64_t> m_dlBytesPerUe; //!< bytes allocated in DL to each UE
+  uint64_t m_dlRbgs;                          //!< RBGs allocated in DL
+  uint64_t m_dlBytes;                         //!< bytes allocated in DL
+  uint64_t m_dlDcis;                          //!< DL DCIs
+  uint64_t m_ulGrants;                        //!< UL grants
+  uint64_t m_ulBytes;                         //!< bytes allocated in UL
+};
+
+/**
+ * Print the time spent per TTI and the resources allocated by a scheduler.
+ * \param type the scheduler type
+ * \param latencies the time spent in each TTI, in microseconds
+ * \param ues the number of UEs
+ * \param user the MAC side of the SCHED SAP
+ */
+static void
+Report (std::string type, std::vector<double> latencies, uint32_t ues, const BenchSchedSapUser &user)
+{
+  double total = 0;
+  for (uint32_t i = 0; i < latencies.size (); i++)
+    {
+      total += latencies[i];
+    }
+  std::sort (latencies.begin (), latencies.end ());
+  uint32_t ttis = latencies.size ();
+
+  // Jain's fairness index of the DL bytes, over all the UEs
+  double sum = 0;
+  double sumSquares = 0;
+  for (std::map<uint16_t, uint64_t>::const_iterator it = user.m_dlBytesPerUe.begin ();
+       it != user.m_dlBytesPerUe.end (); ++it)
+    {
+      sum += it->second;
+      sumSquares += static_cast<double> (it->second) * it->second;
+    }
+  double fairness = sumSquares > 0 ? sum * sum / (std::max<uint32_t> (ues, user.m_dlBytesPerUe.size ()) * sumSquares) : 0;
+
+  std::cout << type << ":" << std::endl
+            << std::fixed << std::setprecision (1)
+            << "  us/TTI: mean " << (ttis > 0 ? total / ttis : 0);
+  if (ttis > 0)
+    {
+      std::cout << ", min " << latencies[0]
+                << ", p50 " << latencies[ttis / 2]
+                << ", p90 " << latencies[ttis * 9 / 10]
+                << ", p99 " << latencies[ttis * 99 / 100]
+                << ", max " << latencies[ttis - 1];
+    }
+  std::cout << " (" << ttis << " TTIs, " << total / 1000 << " ms elapsed)" << std::endl
+            << std::setprecision (3)
+            << "  DL: " << user.m_dlRbgs << " RBGs, "
+            << user.m_dlBytes << " bytes, "
+            << user.m_dlDcis << " DCIs, "
+            << user.m_dlBytesPerUe.size () << " UEs served, "
+            << "fairness " << fairness << std::endl
+            << "  UL: " << user.m_ulGrants << " grants, "
+            << user.m_ulBytes << " bytes" << std::endl;
+  std::cout.unsetf (std::ios::floatfield);
+}
+
+/**
+ * Create a scheduler, and connect it to a FFR algorithm and to the MAC
+ * side of the SAPs.
+ * \param type the scheduler type
+ * \param cschedSapUser the MAC side of the CSCHED SAP
+ * \param schedSapUser the MAC side of the SCHED SAP
+ * \param ffr the FFR algorithm, created by this function
+ * \return the scheduler
+ */
+static Ptr<FfMacScheduler>
+CreateScheduler (std::string type, FfMacCschedSapUser *cschedSapUser, FfMacSchedSapUser *schedSapUser,
+                 Ptr<LteFfrAlgorithm> &ffr)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (type);
+  Ptr<FfMacScheduler> sched = factory.Create<FfMacScheduler> ();
+  ffr = CreateObject<LteFrNoOpAlgorithm> ();
+  sched->SetLteFfrSapProvider (ffr->GetLteFfrSapProvider ());
+  ffr->SetLteFfrSapUser (sched->GetLteFfrSapUser ());
+  sched->SetFfMacCschedSapUser (cschedSapUser);
+  sched->SetFfMacSchedSapUser (schedSapUser);
+  return sched;
+}
+
+/**
+ * Report the buffer of a UE, which always has data to transmit.
+ * \param sched the scheduler
+ * \param rnti the RNTI of the UE
+ */
+static void
+ReportBuffer (FfMacSchedSapProvider *sched, uint16_t rnti)
+{
+  FfMacSchedSapProvider::SchedDlRlcBufferReqParameters params;
+  params.m_rnti = rnti;
+  params.m_logicalChannelIdentity = LCID;
+  params.m_rlcTransmissionQueueSize = 1000000;
+  params.m_rlcTransmissionQueueHolDelay = 10;
+  params.m_rlcRetransmissionQueueSize = 0;
+  params.m_rlcRetransmissionHolDelay = 0;
+  params.m_rlcStatusPduSize = 0;
+  sched->SchedDlRlcBufferReq (params);
+}
+
+/**
+ * Run a scheduler with synthetic full-buffer UEs.
+ * \param type the scheduler type
+ * \param n the number of UEs
+ * \param bandwidth the cell bandwidth, in RBs
+ * \param ttis the number of TTIs
+ * \param cqiPeriod the period of the CQI reports, in TTIs
+ * \param a30 whether the CQIs are subband (A30) or wideband (P10) ones
+ */
+static void
+Run (std::string type, uint32_t n, uint8_t bandwidth, uint32_t ttis, uint32_t cqiPeriod, bool a30)
+{
+  BenchCschedSapUser cschedSapUser;
+  BenchSchedSapUser schedSapUser;
+  Ptr<LteFfrAlgorithm> ffr;
+  Ptr<FfMacScheduler> sched = CreateScheduler (type, &cschedSapUser, &schedSapUser, ffr);
+  ffr->SetDlBandwidth (bandwidth);
+  ffr->SetUlBandwidth (bandwidth);
+  FfMacCschedSapProvider *csched = sched->GetFfMacCschedSapProvider ();
+  FfMacSchedSapProvider *schedSap = sched->GetFfMacSchedSapProvider ();
+
+  FfMacCschedSapProvider::CschedCellConfigReqParameters cell;
+  cell.m_ulBandwidth = bandwidth;
+  cell.m_dlBandwidth = bandwidth;
+  csched->CschedCellConfigReq (cell);
+
+  // the CQI of each UE on each RBG
+  uint32_t rbgSize = bandwidth < 27 ? 2 : (bandwidth < 64 ? 3 : 4);
+  uint32_t rbgNum = (bandwidth + rbgSize - 1) / rbgSize;
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable> ();
+  rand->SetStream (1);
+  std::vector<std::vector<uint8_t> > cqis (n);
+  for (uint32_t u = 0; u < n; u++)
+    {
+      uint32_t wb = rand->GetInteger (3, 15);
+      for (uint32_t i = 0; i < rbgNum; i++)
+        {
+          cqis[u].push_back (std::max<int> (1, wb - rand->GetInteger (0, 2)));
+        }
+    }
+
+  for (uint32_t u = 0; u < n; u++)
+    {
+      uint16_t rnti = u + 1;
+      FfMacCschedSapProvider::CschedUeConfigReqParameters ue;
+      ue.m_rnti = rnti;
+      ue.m_reconfigureFlag = false;
+      ue.m_transmissionMode = 0;
+      csched->CschedUeConfigReq (ue);
+
+      FfMacCschedSapProvider::CschedLcConfigReqParameters lc;
+      lc.m_rnti = rnti;
+      lc.m_reconfigureFlag = false;
+      LogicalChannelConfigListElement_s lcInfo;
+      lcInfo.m_logicalChannelIdentity = LCID;
+      lcInfo.m_logicalChannelGroup = 1;
+      lcInfo.m_direction = LogicalChannelConfigListElement_s::DIR_BOTH;
+      lcInfo.m_qosBearerType = LogicalChannelConfigListElement_s::QBT_NON_GBR;
+      lcInfo.m_qci = 9;
+      lcInfo.m_eRabMaximulBitrateUl = 0;
+      lcInfo.m_eRabMaximulBitrateDl = 0;
+      lcInfo.m_eRabGuaranteedBitrateUl = 0;
+      lcInfo.m_eRabGuaranteedBitrateDl = 0;
+      lc.m_logicalChannelConfigList.push_back (lcInfo);
+      csched->CschedLcConfigReq (lc);
+
+      ReportBuffer (schedSap, rnti);
+    }
+
+  std::vector<double> latencies;
+  std::vector<DlInfoListElement_s> acks;
+  for (uint32_t tti = 0; tti < ttis; tti++)
+    {
+      uint16_t sfnSf = (((tti / 10) & 0x3FF) << 4) | (tti % 10 + 1);
+
+      // the UEs served refill their buffer, and acknowledge the transmission
+      acks.clear ();
+      for (uint32_t i = 0; i < schedSapUser.m_dl.size (); i++)
+        {
+          const DlDciListElement_s &dci = schedSapUser.m_dl[i];
+          ReportBuffer (schedSap, dci.m_rnti);
+          DlInfoListElement_s ack;
+          ack.m_rnti = dci.m_rnti;
+          ack.m_harqProcessId = dci.m_harqProcess;
+          ack.m_harqStatus.assign (dci.m_tbsSize.size (), DlInfoListElement_s::ACK);
+          acks.push_back (ack);
+        }
+      schedSapUser.m_dl.clear ();
+      schedSapUser.m_ul.clear ();
+
+      FfMacSchedSapProvider::SchedDlCqiInfoReqParameters cqiReq;
+      cqiReq.m_sfnSf = sfnSf;
+      FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters bsrReq;
+      bsrReq.m_sfnSf = sfnSf;
+      for (uint32_t u = tti % cqiPeriod; u < n; u += cqiPeriod)
+        {
+          CqiListElement_s cqi;
+          cqi.m_rnti = u + 1;
+          cqi.m_ri = 1;
+          cqi.m_cqiType = a30 ? CqiListElement_s::A30 : CqiListElement_s::P10;
+          cqi.m_wbCqi.push_back (cqis[u][0]);
+          cqi.m_wbPmi = 0;
+          if (a30)
+            {
+              for (uint32_t i = 0; i < rbgNum; i++)
+                {
+                  HigherLayerSelected_s sb;
+                  sb.m_sbPmi = 0;
+                  sb.m_sbCqi.push_back (cqis[u][i]);
+                  cqi.m_sbMeasResult.m_higherLayerSelected.push_back (sb);
+                }
+            }
+          cqiReq.m_cqiList.push_back (cqi);
+
+          MacCeListElement_s bsr;
+          bsr.m_rnti = u + 1;
+          bsr.m_macCeType = MacCeListElement_s::BSR;
+          bsr.m_macCeValue.m_bufferStatus.assign (4, 0);
+          bsr.m_macCeValue.m_bufferStatus[1] = 40;
+          bsrReq.m_macCeList.push_back (bsr);
+        }
+      schedSap->SchedDlCqiInfoReq (cqiReq);
+      schedSap->SchedUlMacCtrlInfoReq (bsrReq);
+
+      FfMacSchedSapProvider::SchedDlTriggerReqParameters dl;
+      dl.m_sfnSf = sfnSf;
+      dl.m_dlInfoList.swap (acks);
+      FfMacSchedSapProvider::SchedUlTriggerReqParameters ul;
+      ul.m_sfnSf = sfnSf;
+
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+      schedSap->SchedDlTriggerReq (dl);
+      schedSap->SchedUlTriggerReq (ul);
+      latencies.push_back (std::chrono::duration<double, std::micro> (std::chrono::steady_clock::now () - start).count ());
+    }
+
+  Report (type, latencies, n, schedSapUser);
+
+  sched->Dispose ();
+  ffr->Dispose ();
+}
+
+/// Outcome of a recorded transmission
+struct HarqOutcome
+{
+  bool ok;          //!< whether the transmission was received
+  uint32_t delay;   //!< TTIs between the transmission and its feedback
+};
+
+/// The recorded outcomes of the transmissions to each UE, in order
+typedef std::map<uint16_t, std::deque<HarqOutcome> > HarqOutcomes;
+
+/**
+ * Extract the outcomes of the recorded transmissions from a trace: each
+ * feedback is matched to the transmission of the same UE (and, in DL,
+ * of the same HARQ process) that it acknowledges.
+ * \param filename the trace file
+ * \param dlOutcomes the outcomes of the DL transmissions
+ * \param ulOutcomes the outcomes of the UL transmissions
+ */
+static void
+ReadOutcomes (std::string filename, HarqOutcomes &dlOutcomes, HarqOutcomes &ulOutcomes)
+{
+  FfMacSchedTraceReader reader;
+  reader.Open (filename);
+  uint32_t dlTti = 0;
+  uint32_t ulTti = 0;
+  std::map<uint32_t, uint32_t> dlSent;                  // (RNTI, HARQ process) -> TTI
+  std::map<uint16_t, std::deque<uint32_t> > ulSent;     // RNTI -> TTIs
+  FfMacSchedTracePrimitive_e primitive;
+  while ((primitive = reader.Next ()) != TRACE_END)
+    {
+      if (primitive == TRACE_SCHED_DL_TRIGGER_REQ)
+        {
+          FfMacSchedSapProvider::SchedDlTriggerReqParameters params;
+          reader.Get (params);
+          dlTti++;
+          for (uint32_t i = 0; i < params.m_dlInfoList.size (); i++)
+            {
+              const DlInfoListElement_s &info = params.m_dlInfoList[i];
+              std::map<uint32_t, uint32_t>::iterator it = dlSent.find ((info.m_rnti << 8) | info.m_harqProcessId);
+              if (it != dlSent.end ())
+                {
+                  HarqOutcome outcome;
+                  outcome.ok = std::count (info.m_harqStatus.begin (), info.m_harqStatus.end (), DlInfoListElement_s::ACK)
+                    == static_cast<int> (info.m_harqStatus.size ());
+                  outcome.delay = dlTti - it->second;
+                  dlOutcomes[info.m_rnti].push_back (outcome);
+                  dlSent.erase (it);
+                }
+            }
+        }
+      else if (primitive == TRACE_SCHED_DL_CONFIG_IND)
+        {
+          FfMacSchedSapUser::SchedDlConfigIndParameters params;
+          reader.Get (params);
+          for (uint32_t i = 0; i < params.m_buildDataList.size (); i++)
+            {
+              const BuildDataListElement_s &data = params.m_buildDataList[i];
+              dlSent[(data.m_rnti << 8) | data.m_dci.m_harqProcess] = dlTti;
+            }
+        }
+      else if (primitive == TRACE_SCHED_UL_TRIGGER_REQ)
+        {
+          FfMacSchedSapProvider::SchedUlTriggerReqParameters params;
+          reader.Get (params);
+          ulTti++;
+          for (uint32_t i = 0; i < params.m_ulInfoList.size (); i++)
+            {
+              const UlInfoListElement_s &info = params.m_ulInfoList[i];
+              std::deque<uint32_t> &sent = ulSent[info.m_rnti];
+              if (!sent.empty ())
+                {
+                  HarqOutcome outcome;
+                  outcome.ok = info.m_receptionStatus != UlInfoListElement_s::NotOk;
+                  outcome.delay = ulTti - sent.front ();
+                  ulOutcomes[info.m_rnti].push_back (outcome);
+                  sent.pop_front ();
+                }
+            }
+        }
+      else if (primitive == TRACE_SCHED_UL_CONFIG_IND)
+        {
+          FfMacSchedSapUser::SchedUlConfigIndParameters params;
+          reader.Get (params);
+          for (uint32_t i = 0; i < params.m_dciList.size (); i++)
+            {
+              ulSent[params.m_dciList[i].m_rnti].push_back (ulTti);
+            }
+        }
+    }
+  reader.Close ();
+}
+
+/**
+ * Take the outcome of the next transmission to a UE.
+ * \param outcomes the recorded outcomes
+ * \param rnti the RNTI of the UE
+ * \return the outcome
+ */
+static HarqOutcome
+NextOutcome (HarqOutcomes &outcomes, uint16_t rnti)
+{
+  HarqOutcome outcome;
+  outcome.ok = true;
+  outcome.delay = DEFAULT_HARQ_DELAY;
+  HarqOutcomes::iterator it = outcomes.find (rnti);
+  if (it != outcomes.end () && !it->second.empty ())
+    {
+      outcome = it->second.front ();
+      it->second.pop_front ();
+    }
+  return outcome;
+}
+
+/**
+ * Replay a recorded trace against a scheduler.
+ * \param type the scheduler type
+ * \param filename the trace file
+ */
+static void
+Replay (std::string type, std::string filename)
+{
+  HarqOutcomes dlOutcomes;
+  HarqOutcomes ulOutcomes;
+  ReadOutcomes (filename, dlOutcomes, ulOutcomes);
+
+  BenchCschedSapUser cschedSapUser;
+  BenchSchedSapUser schedSapUser;
+  Ptr<LteFfrAlgorithm> ffr;
+  Ptr<FfMacScheduler> sched = CreateScheduler (type, &cschedSapUser, &schedSapUser, ffr);
+  FfMacCschedSapProvider *csched = sched->GetFfMacCschedSapProvider ();
+  FfMacSchedSapProvider *schedSap = sched->GetFfMacSchedSapProvider ();
+
+  // the HARQ feedback to send at each TTI
+  std::map<uint32_t, std::vector<DlInfoListElement_s> > dlFeedback;
+  std::map<uint32_t, std::vector<UlInfoListElement_s> > ulFeedback;
+  std::set<uint16_t> ues;
+  uint32_t allUes = 0;
+  uint32_t dlTti = 0;
+  uint32_t ulTti = 0;
+  std::vector<double> latencies;
+
+  FfMacSchedTraceReader reader;
+  reader.Open (filename);
+  FfMacSchedTracePrimitive_e primitive;
+  while ((primitive = reader.Next ()) != TRACE_END)
+    {
+      switch (primitive)
+        {
+        case TRACE_CSCHED_CELL_CONFIG_REQ:
+          {
+            FfMacCschedSapProvider::CschedCellConfigReqParameters params;
+            reader.Get (params);
+            ffr->SetDlBandwidth (params.m_dlBandwidth);
+            ffr->SetUlBandwidth (params.m_ulBandwidth);
+            csched->CschedCellConfigReq (params);
+          }
+          break;
+        case TRACE_CSCHED_UE_CONFIG_REQ:
+          {
+            FfMacCschedSapProvider::CschedUeConfigReqParameters params;
+            reader.Get (params);
+            if (ues.insert (params.m_rnti).second)
+              {
+                allUes++;
+              }
+            csched->CschedUeConfigReq (params);
+          }
+          break;
+        case TRACE_CSCHED_LC_CONFIG_REQ:
+          {
+            FfMacCschedSapProvider::CschedLcConfigReqParameters params;
+            reader.Get (params);
+            csched->CschedLcConfigReq (params);
+          }
+          break;
+        case TRACE_CSCHED_LC_RELEASE_REQ:
+          {
+            FfMacCschedSapProvider::CschedLcReleaseReqParameters params;
+            reader.Get (params);
+            csched->CschedLcReleaseReq (params);
+          }
+          break;
+        case TRACE_CSCHED_UE_RELEASE_REQ:
+          {
+            FfMacCschedSapProvider::CschedUeReleaseReqParameters params;
+            reader.Get (params);
+            ues.erase (params.m_rnti);
+            csched->CschedUeReleaseReq (params);
+          }
+          break;
+        case TRACE_SCHED_DL_RLC_BUFFER_REQ:
+          {
+            FfMacSchedSapProvider::SchedDlRlcBufferReqParameters params;
+            reader.Get (params);
+            schedSap->SchedDlRlcBufferReq (params);
+          }
+          break;
+        case TRACE_SCHED_DL_MAC_BUFFER_REQ:
+          {
+            FfMacSchedSapProvider::SchedDlMacBufferReqParameters params;
+            reader.Get (params);
+            schedSap->SchedDlMacBufferReq (params);
+          }
+          break;
+        case TRACE_SCHED_DL_RACH_INFO_REQ:
+          {
+            FfMacSchedSapProvider::SchedDlRachInfoReqParameters params;
+            reader.Get (params);
+            schedSap->SchedDlRachInfoReq (params);
+          }
+          break;
+        case TRACE_SCHED_DL_CQI_INFO_REQ:
+          {
+            FfMacSchedSapProvider::SchedDlCqiInfoReqParameters params;
+            reader.Get (params);
+            schedSap->SchedDlCqiInfoReq (params);
+          }
+          break;
+        case TRACE_SCHED_UL_NOISE_INTERFERENCE_REQ:
+          {
+            FfMacSchedSapProvider::SchedUlNoiseInterferenceReqParameters params;
+            reader.Get (params);
+            schedSap->SchedUlNoiseInterferenceReq (params);
+          }
+          break;
+        case TRACE_SCHED_UL_SR_INFO_REQ:
+          {
+            FfMacSchedSapProvider::SchedUlSrInfoReqParameters params;
+            reader.Get (params);
+            schedSap->SchedUlSrInfoReq (params);
+          }
+          break;
+        case TRACE_SCHED_UL_MAC_CTRL_INFO_REQ:
+          {
+            FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters params;
+            reader.Get (params);
+            schedSap->SchedUlMacCtrlInfoReq (params);
+          }
+          break;
+        case TRACE_SCHED_UL_CQI_INFO_REQ:
+          {
+            FfMacSchedSapProvider::SchedUlCqiInfoReqParameters params;
+            reader.Get (params);
+            schedSap->SchedUlCqiInfoReq (params);
+          }
+          break;
+        case TRACE_SCHED_DL_TRIGGER_REQ:
+          {
+            FfMacSchedSapProvider::SchedDlTriggerReqParameters params;
+            reader.Get (params);
+            dlTti++;
+            // the recorded feedback is replaced by the one of the
+            // transmissions of this scheduler, if the UE is still there
+            params.m_dlInfoList.clear ();
+            std::map<uint32_t, std::vector<DlInfoListElement_s> >::iterator it = dlFeedback.find (dlTti);
+            if (it != dlFeedback.end ())
+              {
+                for (uint32_t i = 0; i < it->second.size (); i++)
+                  {
+                    if (ues.count (it->second[i].m_rnti) > 0)
+                      {
+                        params.m_dlInfoList.push_back (it->second[i]);
+                      }
+                  }
+                dlFeedback.erase (it);
+              }
+            schedSapUser.m_dl.clear ();
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+            schedSap->SchedDlTriggerReq (params);
+            latencies.push_back (std::chrono::duration<double, std::micro> (std::chrono::steady_clock::now () - start).count ());
+
+            for (uint32_t i = 0; i < schedSapUser.m_dl.size (); i++)
+              {
+                const DlDciListElement_s &dci = schedSapUser.m_dl[i];
+                HarqOutcome outcome = NextOutcome (dlOutcomes, dci.m_rnti);
+                DlInfoListElement_s info;
+                info.m_rnti = dci.m_rnti;
+                info.m_harqProcessId = dci.m_harqProcess;
+                info.m_harqStatus.assign (dci.m_tbsSize.size (),
+                                          outcome.ok ? DlInfoListElement_s::ACK : DlInfoListElement_s::NACK);
+                dlFeedback[dlTti + outcome.delay].push_back (info);
+              }
+          }
+          break;
+        case TRACE_SCHED_UL_TRIGGER_REQ:
+          {
+            FfMacSchedSapProvider::SchedUlTriggerReqParameters params;
+            reader.Get (params);
+            ulTti++;
+            params.m_ulInfoList.clear ();
+            std::map<uint32_t, std::vector<UlInfoListElement_s> >::iterator it = ulFeedback.find (ulTti);
+            if (it != ulFeedback.end ())
+              {
+                for (uint32_t i = 0; i < it->second.size (); i++)
+                  {
+                    if (ues.count (it->second[i].m_rnti) > 0)
+                      {
+                        params.m_ulInfoList.push_back (it->second[i]);
+                      }
+                  }
+                ulFeedback.erase (it);
+              }
+            schedSapUser.m_ul.clear ();
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+            schedSap->SchedUlTriggerReq (params);
+            double us = std::chrono::duration<double, std::micro> (std::chrono::steady_clock::now () - start).count ();
+            // a TTI is made of a DL trigger and of the following UL trigger
+            if (!latencies.empty ())
+              {
+                latencies.back () += us;
+              }
+
+            for (uint32_t i = 0; i < schedSapUser.m_ul.size (); i++)
+              {
+                const UlDciListElement_s &dci = schedSapUser.m_ul[i];
+                HarqOutcome outcome = NextOutcome (ulOutcomes, dci.m_rnti);
+                UlInfoListElement_s info;
+                info.m_rnti = dci.m_rnti;
+                info.m_receptionStatus = outcome.ok ? UlInfoListElement_s::Ok : UlInfoListElement_s::NotOk;
+                info.m_tpc = 0;
+                ulFeedback[ulTti + outcome.delay].push_back (info);
+              }
+          }
+          break;
+        default:
+          // the recorded allocations are only used by ReadOutcomes ()
+          break;
+        }
+    }
+  reader.Close ();
+
+  Report (type, latencies, allUes, schedSapUser);
+
+  sched->Dispose ();
+  ffr->Dispose ();
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 200;
+  uint32_t bandwidth = 100;
+  uint32_t ttis = 1000;
+  uint32_t cqiPeriod = 5;
+  bool a30 = true;
+  std::string trace;
+  std::string schedulers = "ns3::PfFfMacScheduler,ns3::PssFfMacScheduler,"
+    "ns3::CqaFfMacScheduler,ns3::TdTbfqFfMacScheduler";
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the LTE MAC schedulers through the FF MAC Scheduler API");
+  cmd.AddValue ("n", "number of UEs", n);
+  cmd.AddValue ("bandwidth", "cell bandwidth, in RBs", bandwidth);
+  cmd.AddValue ("ttis", "number of TTIs", ttis);
+  cmd.AddValue ("cqiPeriod", "period of the CQI and buffer status reports, in TTIs", cqiPeriod);
+  cmd.AddValue ("a30", "whether the UEs report subband (A30) CQIs instead of wideband (P10) ones", a30);
+  cmd.AddValue ("trace", "trace of a RecordingFfMacScheduler to replay, instead of the synthetic UEs", trace);
+  cmd.AddValue ("scheduler", "comma separated list of the scheduler types", schedulers);
+  cmd.Parse (argc, argv);
+
+  if (trace.empty ())
+    {
+      if (n == 0 || n > 65000 || ttis == 0 || cqiPeriod == 0)
+        {
+          std::cerr << "Error-- the numbers of UEs and TTIs and the CQI period must be positive" << std::endl;
+          exit (1);
+        }
+      if (bandwidth < 6 || bandwidth > 100)
+        {
+          std::cerr << "Error-- the bandwidth must be between 6 and 100 RBs" << std::endl;
+          exit (1);
+        }
+      std::cout << "Running bench-lte-scheduler with n=" << n
+                << " bandwidth=" << bandwidth
+                << " ttis=" << ttis
+                << " cqiPeriod=" << cqiPeriod
+                << " a30=" << a30
+                << std::endl;
+    }
+  else
+    {
+      std::cout << "Running bench-lte-scheduler with trace=" << trace << std::endl;
+    }
+
+  std::istringstream iss (schedulers);
+  std::string type;
+  while (std::getline (iss, type, ','))
+    {
+      if (trace.empty ())
+        {
+          Run (type, n, bandwidth, ttis, cqiPeriod, a30);
+        }
+      else
+        {
+          Replay (type, trace);
+        }
+    }
+  return 0;
+}
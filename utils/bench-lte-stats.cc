@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the output of the LTE MAC and
+// PHY stats calculators, as enabled by LteHelper::EnableTraces, with
+// 'cells' cells of 'ues' UEs allocated every subframe.  The rows are
+// written one per record, as before by opening and closing the file
+// for each record, or in summaries per aggregation epoch.
+// Sample usage:  ./waf --run 'bench-lte-stats --cells=50 --ues=10 --stop=1'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/string.h"
+#include "ns3/mac-stats-calculator.h"
+#include "ns3/phy-stats-calculator.h"
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/**
+ * Append a record to a file, opening and closing it.
+ * \param filename the name of the file.
+ * \param cellId the cell ID.
+ * \param imsi the IMSI.
+ * \param rnti the C-RNTI.
+ */
+static void
+AppendRecord (std::string filename, uint16_t cellId, uint64_t imsi, uint16_t rnti)
+{
+  std::ofstream outFile;
+  outFile.open (filename.c_str (), std::ios_base::app);
+  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
+  outFile << cellId << "\t" << imsi << "\t0\t0\t" << rnti << "\t";
+  outFile << 20 << "\t" << 1000 << "\t" << 0 << "\t" << 0 << "\t" << 0 << std::endl;
+  outFile.close ();
+}
+
+/**
+ * Report the allocations and SINR of all the UEs in a subframe, and
+ * schedule the next subframe.
+ * \param macStats the MAC stats calculator, or 0 to append by reopening.
+ * \param phyStats the PHY stats calculator.
+ * \param cells the number of cells.
+ * \param ues the number of UEs per cell.
+ */
+static void
+Subframe (Ptr<MacStatsCalculator> macStats, Ptr<PhyStatsCalculator> phyStats,
+          uint32_t cells, uint32_t ues)
+{
+  for (uint16_t cellId = 1; cellId <= cells; cellId++)
+    {
+      for (uint16_t rnti = 1; rnti <= ues; rnti++)
+        {
+          uint64_t imsi = (cellId - 1) * ues + rnti;
+          if (macStats == 0)
+            {
+              AppendRecord ("DlMacStats.txt", cellId, imsi, rnti);
+              AppendRecord ("UlSinrStats.txt", cellId, imsi, rnti);
+              continue;
+            }
+          DlSchedulingCallbackInfo info;
+          info.frameNo = 0;
+          info.subframeNo = 0;
+          info.rnti = rnti;
+          info.mcsTb1 = 20;
+          info.sizeTb1 = 1000;
+          info.mcsTb2 = 0;
+          info.sizeTb2 = 0;
+          info.componentCarrierId = 0;
+          macStats->DlScheduling (cellId, imsi, info);
+          phyStats->ReportUeSinr (cellId, imsi, rnti, 10.0, 0);
+        }
+    }
+  Simulator::Schedule (MilliSeconds (1), &Subframe, macStats, phyStats, cells, ues);
+}
+
+/**
+ * Run the simulation.
+ * \param cells the number of cells.
+ * \param ues the number of UEs per cell.
+ * \param stop the simulated time.
+ * \param mode the output mode: "reopen", "buffered" or "aggregated".
+ */
+static void
+Run (uint32_t cells, uint32_t ues, Time stop, std::string mode)
+{
+  Ptr<MacStatsCalculator> macStats;
+  Ptr<PhyStatsCalculator> phyStats;
+  if (mode != "reopen")
+    {
+      macStats = CreateObject<MacStatsCalculator> ();
+      phyStats = CreateObject<PhyStatsCalculator> ();
+      if (mode == "aggregated")
+        {
+          macStats->SetAttribute ("AggregationEpoch", StringValue ("100ms"));
+          phyStats->SetAttribute ("AggregationEpoch", StringValue ("100ms"));
+        }
+    }
+  else
+    {
+      std::ofstream ("DlMacStats.txt");
+      std::ofstream ("UlSinrStats.txt");
+    }
+  Simulator::Schedule (MilliSeconds (1), &Subframe, macStats, phyStats, cells, ues);
+
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Stop (stop);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  uint64_t ms = time.End ();
+
+  std::ifstream file ("DlMacStats.txt", std::ios_base::ate);
+  std::cout << mode << "\t" << ms << " ms, DlMacStats.txt " << file.tellg () << " bytes"
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t cells = 50;
+  uint32_t ues = 10;
+  double stop = 1;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the output of the LTE MAC and PHY stats calculators");
+  cmd.AddValue ("cells", "number of cells", cells);
+  cmd.AddValue ("ues", "number of UEs per cell", ues);
+  cmd.AddValue ("stop", "simulated time, in seconds", stop);
+  cmd.Parse (argc, argv);
+
+  if (cells == 0 || ues == 0 || stop <= 0)
+    {
+      std::cerr << "Error-- the number of cells and UEs and the time must be positive" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-lte-stats with cells=" << cells << " ues=" << ues
+            << " stop=" << stop << std::endl;
+
+  Run (cells, ues, Seconds (stop), "reopen");
+  Run (cells, ues, Seconds (stop), "buffered");
+  Run (cells, ues, Seconds (stop), "aggregated");
+  return 0;
+}
@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark 'n' nodes walking randomly,
+// with per-node mobility models and with a MobilityBatch, while the
+// positions of all the nodes are read once per second.
+// Sample usage:  ./waf --run 'bench-mobility --n=10000 --stop=100'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/pointer.h"
+#include "ns3/string.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/mobility-model.h"
+#include "ns3/box.h"
+#include "ns3/mobility-batch.h"
+#include <iostream>
+#include <string>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/**
+ * Read the positions of all the nodes, and schedule the next reading.
+ * \param nodes the nodes.
+ * \param sum the sum of the coordinates read.
+ */
+static void
+Read (NodeContainer nodes, double *sum)
+{
+  for (NodeContainer::Iterator i = nodes.Begin (); i != nodes.End (); ++i)
+    {
+      Vector position = (*i)->GetObject<MobilityModel> ()->GetPosition ();
+      *sum += position.x + position.y;
+    }
+  Simulator::Schedule (Seconds (1), &Read, nodes, sum);
+}
+
+/**
+ * Run the simulation.
+ * \param n the number of nodes.
+ * \param stop the simulated time.
+ * \param mobility the helper installing the mobility models.
+ * \param name the name of the mobility models.
+ */
+static void
+Run (uint32_t n, Time stop, MobilityHelper &mobility, std::string name)
+{
+  NodeContainer nodes;
+  nodes.Create (n);
+  mobility.SetPositionAllocator ("ns3::RandomRectanglePositionAllocator",
+                                 "X", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=1000.0]"),
+                                 "Y", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=1000.0]"));
+  mobility.Install (nodes);
+
+  double sum = 0;
+  Simulator::Schedule (Seconds (0.5), &Read, nodes, &sum);
+
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Stop (stop);
+  Simulator::Run ();
+  uint64_t ms = time.End ();
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+
+  std::cout << name << "  " << ms << " ms, " << events << " events" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 10000;
+  double stop = 100;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark per-node and batched random walks");
+  cmd.AddValue ("n", "number of nodes", n);
+  cmd.AddValue ("stop", "simulated time, in seconds", stop);
+  cmd.Parse (argc, argv);
+
+  if (n == 0 || stop <= 0)
+    {
+      std::cerr << "Error-- the number of nodes and the time must be positive" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-mobility with n=" << n << " stop=" << stop << std::endl;
+
+  const Rectangle bounds (0, 1000, 0, 1000);
+  MobilityHelper walk;
+  walk.SetMobilityModel ("ns3::RandomWalk2dMobilityModel",
+                         "Bounds", RectangleValue (bounds),
+                         "Mode", StringValue ("Time"),
+                         "Time", StringValue ("1s"),
+                         "Speed", StringValue ("ns3::UniformRandomVariable[Min=10.0|Max=30.0]"));
+  Run (n, Seconds (stop), walk, "RandomWalk2dMobilityModel");
+
+  MobilityHelper gaussMarkov;
+  gaussMarkov.SetMobilityModel ("ns3::GaussMarkovMobilityModel",
+                                "Bounds", BoxValue (Box (0, 1000, 0, 1000, 0, 0)),
+                                "TimeStep", StringValue ("1s"));
+  Run (n, Seconds (stop), gaussMarkov, "GaussMarkovMobilityModel ");
+
+  Ptr<MobilityBatch> batch = CreateObject<MobilityBatch> ();
+  batch->SetAttribute ("Bounds", RectangleValue (bounds));
+  batch->SetAttribute ("Interval", StringValue ("1s"));
+  batch->SetAttribute ("Speed", StringValue ("ns3::UniformRandomVariable[Min=10.0|Max=30.0]"));
+  MobilityHelper batched;
+  batched.SetMobilityModel ("ns3::BatchMobilityModel", "Batch", PointerValue (batch));
+  Run (n, Seconds (stop), batched, "MobilityBatch            ");
+
+  // without the per-node course change notifications, which take an
+  // event per node to run in the context of the node
+  batch = CreateObject<MobilityBatch> ();
+  batch->SetAttribute ("Bounds", RectangleValue (bounds));
+  batch->SetAttribute ("Interval", StringValue ("1s"));
+  batch->SetAttribute ("Speed", StringValue ("ns3::UniformRandomVariable[Min=10.0|Max=30.0]"));
+  batch->SetAttribute ("NotifyEachNode", BooleanValue (false));
+  batched.SetMobilityModel ("ns3::BatchMobilityModel", "Batch", PointerValue (batch));
+  Run (n, Seconds (stop), batched, "MobilityBatch, batch only");
+  return 0;
+}
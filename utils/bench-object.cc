@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark Object::GetObject on aggregates
+// of 5 to 20 Objects, as found on the nodes of a simulation.
+// Sample usage:  ./waf --run 'bench-object --n=1000000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/object.h"
+#include "ns3/object-factory.h"
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/// The number of aggregated Object types
+static const uint32_t MAX_AGGREGATES = 20;
+
+/**
+ * An Object type to aggregate.
+ * \tparam K The index of the type.
+ */
+template <uint32_t K>
+class BenchObject : public Object
+{
+public:
+  /**
+   * Register this type.
+   * \return The TypeId.
+   */
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId (GetName ().c_str ())
+      .SetParent<Object> ()
+      .HideFromDocumentation ()
+      .AddConstructor<BenchObject<K> > ();
+    return tid;
+  }
+private:
+  /**
+   * Get the name of this type.
+   * \return The name.
+   */
+  static std::string GetName (void)
+  {
+    std::ostringstream oss;
+    oss << "ns3::BenchObject" << K;
+    return oss.str ();
+  }
+};
+
+/**
+ * Register the types of BenchObject<0> to BenchObject<K>.
+ * \tparam K The index of the last type.
+ * \param tids The TypeIds registered.
+ */
+template <uint32_t K>
+static void
+Register (std::vector<TypeId> &tids)
+{
+  Register<K - 1> (tids);
+  tids.push_back (BenchObject<K>::GetTypeId ());
+}
+
+/** \copydoc Register */
+template <>
+void
+Register<0> (std::vector<TypeId> &tids)
+{
+  tids.push_back (BenchObject<0>::GetTypeId ());
+}
+
+/**
+ * Print the rate of an operation.
+ * \param count the number of operations
+ * \param ms the elapsed time
+ * \param name the operation name
+ */
+static void
+Report (uint64_t count, uint64_t ms, std::string name)
+{
+  double ps = count;
+  ps *= 1000;
+  ps /= ms > 0 ? ms : 1;
+  std::cout << ps << " ops/s"
+            << " (" << ms << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint64_t n = 1000000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark Object::GetObject on aggregates of 5 to 20 Objects");
+  cmd.AddValue ("n", "number of lookups per measure", n);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- the number of lookups must be positive" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-object with n=" << n << std::endl;
+
+  std::vector<TypeId> tids;
+  Register<MAX_AGGREGATES - 1> (tids);
+
+  uint64_t found = 0;
+  for (uint32_t size = 5; size <= MAX_AGGREGATES; size += 5)
+    {
+      ObjectFactory factory;
+      factory.SetTypeId (tids[0]);
+      Ptr<Object> root = factory.Create ();
+      for (uint32_t i = 1; i < size; i++)
+        {
+          factory.SetTypeId (tids[i]);
+          root->AggregateObject (factory.Create ());
+        }
+
+      std::ostringstream oss;
+      oss << size << " aggregates";
+
+      // look up every Object of the aggregate in turn
+      SystemWallClockMs time;
+      time.Start ();
+      for (uint64_t i = 0; i < n; i++)
+        {
+          found += root->GetObject<Object> (tids[i % size]) != 0;
+        }
+      Report (n, time.End (), "GetObject (TypeId), " + oss.str ());
+
+      // look up the same two types over and over, as the channels
+      // and propagation models do with the mobility model of a node
+      time.Start ();
+      for (uint64_t i = 0; i < n; i += 2)
+        {
+          found += root->GetObject<BenchObject<3> > () != 0;
+          found += root->GetObject<BenchObject<4> > () != 0;
+        }
+      Report (n, time.End (), "GetObject<T> (), " + oss.str ());
+
+      // look up a type which is not aggregated
+      time.Start ();
+      for (uint64_t i = 0; i < n; i++)
+        {
+          found += root->GetObject<BenchObject<MAX_AGGREGATES> > () != 0;
+        }
+      Report (n, time.End (), "GetObject<T> () failed, " + oss.str ());
+
+      root->Dispose ();
+    }
+
+  uint64_t expected = 4 * (n + (n + 1) / 2 * 2);
+  if (found != expected)
+    {
+      std::cerr << "Error-- found " << found << " of " << expected << " objects" << std::endl;
+      return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the random variable streams,
+// drawing their values one at a time and in batches.
+// Sample usage:  ./waf --run 'bench-rng --n=10000000 --batch=256'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/double.h"
+#include "ns3/object-factory.h"
+#include "ns3/random-variable-stream.h"
+#include <iostream>
+#include <vector>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/**
+ * Print the rate of an operation.
+ * \param count the number of operations
+ * \param ms the elapsed time
+ * \param name the operation name
+ */
+static void
+Report (uint64_t count, uint64_t ms, std::string name)
+{
+  double ps = count;
+  ps *= 1000;
+  ps /= ms > 0 ? ms : 1;
+  std::cout << ps << " ops/s"
+            << " (" << ms << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+/**
+ * Draw values from a random variable, one at a time then in batches.
+ * \param factory The factory of the random variable.
+ * \param n The number of values to draw.
+ * \param batch The size of the batches.
+ * \return The sum of the values, so that they are used.
+ */
+static double
+Bench (ObjectFactory factory, uint64_t n, uint32_t batch)
+{
+  std::string name = factory.GetTypeId ().GetName ();
+  Ptr<RandomVariableStream> rv = factory.Create<RandomVariableStream> ();
+  double sum = 0;
+
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint64_t i = 0; i < n; i++)
+    {
+      sum += rv->GetValue ();
+    }
+  Report (n, time.End (), name + "::GetValue");
+
+  std::vector<double> values (batch);
+  time.Start ();
+  for (uint64_t i = 0; i < n; i += batch)
+    {
+      rv->GetValues (&values[0], batch);
+      for (uint32_t j = 0; j < batch; j++)
+        {
+          sum += values[j];
+        }
+    }
+  Report (n, time.End (), name + "::GetValues");
+
+  std::vector<uint32_t> integers (batch);
+  time.Start ();
+  for (uint64_t i = 0; i < n; i += batch)
+    {
+      rv->GetIntegers (&integers[0], batch);
+      for (uint32_t j = 0; j < batch; j++)
+        {
+          sum += integers[j];
+        }
+    }
+  Report (n, time.End (), name + "::GetIntegers");
+  return sum;
+}
+
+int main (int argc, char *argv[])
+{
+  uint64_t n = 10000000;
+  uint32_t batch = 256;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the random variable streams, one value at a time and in batches");
+  cmd.AddValue ("n", "number of values to draw per measure", n);
+  cmd.AddValue ("batch", "number of values per batch", batch);
+  cmd.Parse (argc, argv);
+
+  if (n == 0 || batch == 0)
+    {
+      std::cerr << "Error-- the number of values and the batch size must be positive" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-rng with n=" << n << " batch=" << batch << std::endl;
+
+  double sum = 0;
+  ObjectFactory factory;
+  factory.SetTypeId ("ns3::UniformRandomVariable");
+  factory.Set ("Max", DoubleValue (1000));
+  sum += Bench (factory, n, batch);
+
+  factory = ObjectFactory ();
+  factory.SetTypeId ("ns3::ExponentialRandomVariable");
+  factory.Set ("Mean", DoubleValue (10));
+  sum += Bench (factory, n, batch);
+
+  factory = ObjectFactory ();
+  factory.SetTypeId ("ns3::NormalRandomVariable");
+  factory.Set ("Mean", DoubleValue (100));
+  factory.Set ("Variance", DoubleValue (25));
+  sum += Bench (factory, n, batch);
+
+  return sum > 0 ? 0 : 1;
+}
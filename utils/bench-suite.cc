@@ -0,0 +1,850 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program is a suite of benchmarks covering the event schedulers,
+// packet and buffer operations, spectrum value math, the Wi-Fi and LTE
+// interference models, the LTE FF MAC schedulers and a few reference
+// scenarios.  Each benchmark reports its wall clock time, its rate of
+// operations and of simulation events, the peak resident set size of the
+// process and the number of heap allocations, in text or JSON.
+//
+// The peak resident set size is that of the whole process, so that only
+// the first benchmark run by a process has a meaningful value; test.py
+// --benchmark runs each benchmark in its own process and compares the
+// results against a stored baseline.
+//
+// Sample usage:  ./waf --run 'bench-suite --run=scheduler-heap,packet-headers --json=out.json'
+//                ./waf --run 'bench-suite --list'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/spectrum-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/lte-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/applications-module.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <new>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+using namespace ns3;
+
+/// Number of heap allocations done by the process
+static uint64_t g_allocations = 0;
+
+void *
+operator new (std::size_t size)
+{
+  g_allocations++;
+  void *p = std::malloc (size == 0 ? 1 : size);
+  if (p == 0)
+    {
+      throw std::bad_alloc ();
+    }
+  return p;
+}
+
+void
+operator delete (void *p) noexcept
+{
+  std::free (p);
+}
+
+void *
+operator new[] (std::size_t size)
+{
+  return operator new (size);
+}
+
+void
+operator delete[] (void *p) noexcept
+{
+  operator delete (p);
+}
+
+/**
+ * \returns the peak resident set size of the process, in kB,
+ * or 0 if unknown.
+ */
+static uint64_t
+GetPeakRss (void)
+{
+#ifndef _WIN32
+  struct rusage usage;
+  if (getrusage (RUSAGE_SELF, &usage) == 0)
+    {
+#ifdef __APPLE__
+      return usage.ru_maxrss / 1024;
+#else
+      return usage.ru_maxrss;
+#endif
+    }
+#endif
+  return 0;
+}
+
+/// The measurements of a benchmark run
+struct Result
+{
+  std::string name;      //!< benchmark name
+  uint64_t operations;   //!< number of operations done
+  uint64_t events;       //!< number of simulation events executed
+  uint64_t wallMs;       //!< wall clock time, in ms
+  uint64_t peakRssKb;    //!< peak resident set size of the process, in kB
+  uint64_t allocations;  //!< number of heap allocations
+};
+
+/**
+ * A benchmark function.  The simulation events that it runs are
+ * counted, and the simulator is destroyed, once it returns.
+ * \param scale the workload scaling factor
+ * \returns the number of operations done, 0 if they are the events
+ */
+typedef uint64_t (*BenchmarkFunction)(double scale);
+
+/// A benchmark of the suite
+struct Benchmark
+{
+  const char *name;            //!< benchmark name
+  const char *description;     //!< benchmark description
+  BenchmarkFunction function;  //!< benchmark function
+};
+
+/**
+ * Scale a workload.
+ * \param n the workload at scale 1
+ * \param scale the scaling factor
+ * \returns the scaled workload, at least 1
+ */
+static uint64_t
+Scale (uint64_t n, double scale)
+{
+  uint64_t scaled = static_cast<uint64_t> (n * scale);
+  return scaled > 0 ? scaled : 1;
+}
+
+// ---------------------------------------------------------------------------
+// Event schedulers
+// ---------------------------------------------------------------------------
+
+/// Hold model: each event schedules another one, after a random delay
+class HoldBench
+{
+public:
+  /**
+   * Constructor
+   * \param total the number of events to run
+   */
+  HoldBench (uint64_t total)
+    : m_total (total),
+      m_count (0)
+  {
+    m_delay = CreateObject<ExponentialRandomVariable> ();
+    m_delay->SetAttribute ("Mean", DoubleValue (100));
+  }
+  /**
+   * Schedule the initial population of events.
+   * \param population the number of events
+   */
+  void Start (uint32_t population)
+  {
+    for (uint32_t i = 0; i < population; i++)
+      {
+        Simulator::Schedule (NanoSeconds (m_delay->GetInteger ()), &HoldBench::Hold, this);
+      }
+  }
+private:
+  /// Event handler
+  void Hold (void)
+  {
+    if (++m_count < m_total)
+      {
+        Simulator::Schedule (NanoSeconds (m_delay->GetInteger ()), &HoldBench::Hold, this);
+      }
+  }
+  Ptr<ExponentialRandomVariable> m_delay; //!< event delay
+  uint64_t m_total;  //!< number of events to run
+  uint64_t m_count;  //!< number of events run
+};
+
+/**
+ * Run the hold model with a scheduler.
+ * \param type the scheduler TypeId name
+ * \param scale the workload scaling factor
+ * \returns 0, the operations being the events
+ */
+static uint64_t
+RunScheduler (std::string type, double scale)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (type);
+  Simulator::SetScheduler (factory);
+  HoldBench bench (Scale (1000000, scale));
+  bench.Start (type == "ns3::ListScheduler" ? 1000 : 100000);
+  Simulator::Run ();
+  return 0;
+}
+
+/// \copydoc BenchmarkFunction
+static uint64_t
+BenchMapScheduler (double scale)
+{
+  return RunScheduler ("ns3::MapScheduler", scale);
+}
+
+/// \copydoc BenchmarkFunction
+static uint64_t
+BenchListScheduler (double scale)
+{
+  return RunScheduler ("ns3::ListScheduler", scale);
+}
+
+/// \copydoc BenchmarkFunction
+static uint64_t
+BenchHeapScheduler (double scale)
+{
+  return RunScheduler ("ns3::HeapScheduler", scale);
+}
+
+/// \copydoc BenchmarkFunction
+static uint64_t
+BenchCalendarScheduler (double scale)
+{
+  return RunScheduler ("ns3::CalendarScheduler", scale);
+}
+
+// ---------------------------------------------------------------------------
+// Packets and buffers
+// ---------------------------------------------------------------------------
+
+/// \copydoc BenchmarkFunction
+static uint64_t
+BenchPacketHeaders (double scale)
+{
+  uint64_t n = Scale (200000, scale);
+  UdpHeader udpHeader;
+  udpHeader.SetSourcePort (1000);
+  udpHeader.SetDestinationPort (2000);
+  Ipv4Header ipHeader;
+  ipHeader.SetSource (Ipv4Address ("10.0.0.1"));
+  ipHeader.SetDestination (Ipv4Address ("10.0.0.2"));
+  ipHeader.SetPayloadSize (1008);
+  for (uint64_t i = 0; i < n; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (1000);
+      p->AddHeader (udpHeader);
+      p->AddHeader (ipHeader);
+      Ptr<Packet> copy = p->Copy ();
+      Ipv4Header ip;
+      copy->RemoveHeader (ip);
+      UdpHeader udp;
+      copy->RemoveHeader (udp);
+    }
+  return n;
+}
+
+/// \copydoc BenchmarkFunction
+static uint64_t
+BenchPacketFragments (double scale)
+{
+  uint64_t n = Scale (100000, scale);
+  for (uint64_t i = 0; i < n; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (4000);
+      Ptr<Packet> whole = Create<Packet> ();
+      for (uint32_t offset = 0; offset < 4000; offset += 1000)
+        {
+          whole->AddAtEnd (p->CreateFragment (offset, 1000));
+        }
+      whole->RemoveAtStart (500);
+      whole->RemoveAtEnd (500);
+    }
+  return n;
+}
+
+/// \copydoc BenchmarkFunction
+static uint64_t
+BenchBuffer (double scale)
+{
+  uint64_t n = Scale (200000, scale);
+  uint64_t sum = 0;
+  for (uint64_t i = 0; i < n; i++)
+    {
+      Buffer buffer (1000);
+      buffer.AddAtStart (64);
+      Buffer::Iterator it = buffer.Begin ();
+      for (uint32_t j = 0; j < 16; j++)
+        {
+          it.WriteHtonU32 (j);
+        }
+      buffer.AddAtEnd (64);
+      it = buffer.Begin ();
+      for (uint32_t j = 0; j < 16; j++)
+        {
+          sum += it.ReadNtohU32 ();
+        }
+      buffer.RemoveAtStart (64);
+    }
+  NS_ABORT_IF (sum != n * 120);
+  return n;
+}
+
+// ---------------------------------------------------------------------------
+// Spectrum and interference models
+// ---------------------------------------------------------------------------
+
+/// \copydoc BenchmarkFunction
+static uint64_t
+BenchSpectrumValue (double scale)
+{
+  uint64_t n = Scale (100000, scale);
+  std::vector<double> frequencies;
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      frequencies.push_back (2.1e9 + i * 180e3);
+    }
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (frequencies);
+  SpectrumValue signal (model);
+  SpectrumValue noise (model);
+  signal = 1e-13;
+  noise = 1e-15;
+  double total = 0;
+  for (uint64_t i = 0; i < n; i++)
+    {
+      SpectrumValue interference = signal * 0.1 + noise;
+      SpectrumValue sinr = signal / interference;
+      total += Integral (sinr);
+    }
+  NS_ABORT_IF (total <= 0);
+  return n;
+}
+
+/// Wi-Fi receptions in presence of interference
+class WifiInterferenceBench
+{
+public:
+  /**
+   * Constructor
+   * \param total the number of receptions
+   */
+  WifiInterferenceBench (uint64_t total)
+    : m_total (total),
+      m_count (0)
+  {
+    m_helper.SetNoiseFigure (5);
+    m_helper.SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+    m_txVector.SetMode (WifiPhy::GetOfdmRate54Mbps ());
+    m_txVector.SetPreambleType (WIFI_PREAMBLE_LONG);
+    m_txVector.SetChannelWidth (20);
+    m_packet = Create<Packet> (1500);
+    m_power = CreateObject<UniformRandomVariable> ();
+    m_power->SetAttribute ("Min", DoubleValue (1e-12));
+    m_power->SetAttribute ("Max", DoubleValue (1e-10));
+  }
+  /// Receive a frame, with overlapping interferers
+  void Receive (void)
+  {
+    for (uint32_t i = 0; i < 4; i++)
+      {
+        m_helper.AddForeignSignal (MicroSeconds (300), m_power->GetValue ());
+      }
+    Ptr<Event> event = m_helper.Add (m_packet, m_txVector, MicroSeconds (300),
+                                     m_power->GetValue () * 100);
+    m_helper.NotifyRxStart ();
+    m_helper.CalculatePlcpHeaderSnrPer (event);
+    m_helper.CalculatePlcpPayloadSnrPer (event);
+    m_helper.NotifyRxEnd ();
+    if (++m_count < m_total)
+      {
+        Simulator::Schedule (MicroSeconds (100), &WifiInterferenceBench::Receive, this);
+      }
+  }
+private:
+  InterferenceHelper m_helper; //!< the interference helper
+  WifiTxVector m_txVector;     //!< the TX vector of the frames
+  Ptr<Packet> m_packet;        //!< the frame
+  Ptr<UniformRandomVariable> m_power; //!< received power
+  uint64_t m_total;  //!< number of receptions
+  uint64_t m_count;  //!< number of receptions done
+};
+
+/// \copydoc BenchmarkFunction
+static uint64_t
+BenchWifiInterferenceHelper (double scale)
+{
+  uint64_t n = Scale (20000, scale);
+  WifiInterferenceBench bench (n);
+  Simulator::ScheduleNow (&WifiInterferenceBench::Receive, &bench);
+  Simulator::Run ();
+  return n;
+}
+
+/// LTE receptions in presence of interference
+class LteInterferenceBench
+{
+public:
+  /**
+   * Constructor
+   * \param total the number of receptions
+   */
+  LteInterferenceBench (uint64_t total)
+    : m_total (total),
+      m_count (0)
+  {
+    std::vector<int> activeRbs;
+    for (int i = 0; i < 100; i++)
+      {
+        activeRbs.push_back (i);
+      }
+    m_signal = LteSpectrumValueHelper::CreateTxPowerSpectralDensity (100, 100, 30, activeRbs);
+    for (uint32_t i = 0; i < 6; i++)
+      {
+        m_interferers.push_back (LteSpectrumValueHelper::CreateTxPowerSpectralDensity (100, 100, 10 + i, activeRbs));
+      }
+    m_interference = CreateObject<LteInterference> ();
+    m_interference->SetNoisePowerSpectralDensity (LteSpectrumValueHelper::CreateNoisePowerSpectralDensity (100, 100, 9));
+    Ptr<LteChunkProcessor> sinr = Create<LteChunkProcessor> ();
+    sinr->AddCallback (MakeCallback (&LteInterferenceBench::Sinr, this));
+    m_interference->AddSinrChunkProcessor (sinr);
+    m_interference->AddInterferenceChunkProcessor (Create<LteChunkProcessor> ());
+  }
+  /// Start the reception of a subframe
+  void StartRx (void)
+  {
+    for (uint32_t i = 0; i < m_interferers.size (); i++)
+      {
+        m_interference->AddSignal (m_interferers[i], MilliSeconds (1));
+      }
+    m_interference->AddSignal (m_signal, MilliSeconds (1));
+    m_interference->StartRx (m_signal);
+    Simulator::Schedule (MilliSeconds (1), &LteInterferenceBench::EndRx, this);
+  }
+  /// End the reception of a subframe
+  void EndRx (void)
+  {
+    m_interference->EndRx ();
+    if (++m_count < m_total)
+      {
+        StartRx ();
+      }
+  }
+  /**
+   * Dispose of the interference model.
+   */
+  void Dispose (void)
+  {
+    m_interference->Dispose ();
+  }
+private:
+  /**
+   * SINR chunk callback
+   * \param sinr the SINR
+   */
+  void Sinr (const SpectrumValue &sinr)
+  {
+  }
+  Ptr<LteInterference> m_interference;   //!< the interference model
+  Ptr<SpectrumValue> m_signal;           //!< the received signal
+  std::vector<Ptr<SpectrumValue> > m_interferers; //!< the interferers
+  uint64_t m_total;  //!< number of receptions
+  uint64_t m_count;  //!< number of receptions done
+};
+
+/// \copydoc BenchmarkFunction
+static uint64_t
+BenchLteInterference (double scale)
+{
+  uint64_t n = Scale (20000, scale);
+  LteInterferenceBench bench (n);
+  Simulator::ScheduleNow (&LteInterferenceBench::StartRx, &bench);
+  Simulator::Run ();
+  bench.Dispose ();
+  return n;
+}
+
+// ---------------------------------------------------------------------------
+// Scenarios
+// ---------------------------------------------------------------------------
+
+/**
+ * Run a cell of saturated LTE UEs, without EPC.
+ * \param scheduler the FF MAC scheduler TypeId name
+ * \param nEnbs the number of eNBs, placed on a grid
+ * \param nUes the number of UEs per eNB
+ * \param simTime the simulation time
+ * \returns 0, the operations being the events
+ */
+static uint64_t
+RunLte (std::string scheduler, uint32_t nEnbs, uint32_t nUes, Time simTime)
+{
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetSchedulerType (scheduler);
+
+  NodeContainer enbNodes;
+  enbNodes.Create (nEnbs);
+  MobilityHelper enbMobility;
+  enbMobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                    "DeltaX", DoubleValue (500),
+                                    "DeltaY", DoubleValue (500),
+                                    "GridWidth", UintegerValue (4));
+  enbMobility.Install (enbNodes);
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+
+  for (uint32_t i = 0; i < nEnbs; i++)
+    {
+      NodeContainer ueNodes;
+      ueNodes.Create (nUes);
+      Vector position = enbNodes.Get (i)->GetObject<MobilityModel> ()->GetPosition ();
+      MobilityHelper ueMobility;
+      ueMobility.SetPositionAllocator ("ns3::UniformDiscPositionAllocator",
+                                       "X", DoubleValue (position.x),
+                                       "Y", DoubleValue (position.y),
+                                       "rho", DoubleValue (200));
+      ueMobility.Install (ueNodes);
+      NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+      lteHelper->Attach (ueDevs, enbDevs.Get (i));
+      lteHelper->ActivateDataRadioBearer (ueDevs, EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+    }
+
+  Simulator::Stop (simTime);
+  Simulator::Run ();
+  return 0;
+}
+
+/// \copydoc BenchmarkFunction
+static uint64_t
+BenchFfMacRr (double scale)
+{
+  return RunLte ("ns3::RrFfMacScheduler", 1, 20, Seconds (0.5 * scale));
+}
+
+/// \copydoc BenchmarkFunction
+static uint64_t
+BenchFfMacPf (double scale)
+{
+  return RunLte ("ns3::PfFfMacScheduler", 1, 20, Seconds (0.5 * scale));
+}
+
+/// \copydoc BenchmarkFunction
+static uint64_t
+BenchFfMacPss (double scale)
+{
+  return RunLte ("ns3::PssFfMacScheduler", 1, 20, Seconds (0.5 * scale));
+}
+
+/// \copydoc BenchmarkFunction
+static uint64_t
+BenchFfMacCqa (double scale)
+{
+  return RunLte ("ns3::CqaFfMacScheduler", 1, 20, Seconds (0.5 * scale));
+}
+
+/// \copydoc BenchmarkFunction
+static uint64_t
+BenchLenaProfiling (double scale)
+{
+  // the lena-profiling example without buildings
+  return RunLte ("ns3::PfFfMacScheduler", 4, 10, Seconds (0.5 * scale));
+}
+
+/// \copydoc BenchmarkFunction
+static uint64_t
+BenchWifiDenseBss (double scale)
+{
+  uint32_t nStas = 30;
+  NodeContainer apNode;
+  apNode.Create (1);
+  NodeContainer staNodes;
+  staNodes.Create (nStas);
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  WifiHelper wifi;
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate54Mbps"));
+  WifiMacHelper mac;
+  Ssid ssid = Ssid ("bench");
+  mac.SetType ("ns3::StaWifiMac", "Ssid", SsidValue (ssid));
+  NetDeviceContainer staDevs = wifi.Install (phy, mac, staNodes);
+  mac.SetType ("ns3::ApWifiMac", "Ssid", SsidValue (ssid));
+  NetDeviceContainer apDev = wifi.Install (phy, mac, apNode);
+
+  MobilityHelper mobility;
+  mobility.Install (apNode);
+  mobility.SetPositionAllocator ("ns3::UniformDiscPositionAllocator",
+                                 "rho", DoubleValue (10));
+  mobility.Install (staNodes);
+
+  InternetStackHelper internet;
+  internet.Install (apNode);
+  internet.Install (staNodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.0.0", "255.255.0.0");
+  Ipv4InterfaceContainer apInterface = address.Assign (apDev);
+  address.Assign (staDevs);
+
+  uint16_t port = 9;
+  PacketSinkHelper sink ("ns3::UdpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), port));
+  sink.Install (apNode);
+  OnOffHelper onOff ("ns3::UdpSocketFactory", InetSocketAddress (apInterface.GetAddress (0), port));
+  onOff.SetConstantRate (DataRate ("2Mbps"), 1000);
+  ApplicationContainer sources = onOff.Install (staNodes);
+  sources.Start (Seconds (0.5));
+
+  Simulator::Stop (Seconds (0.5 + 1.0 * scale));
+  Simulator::Run ();
+  return 0;
+}
+
+/// \copydoc BenchmarkFunction
+static uint64_t
+BenchP2pDumbbell (double scale)
+{
+  uint32_t nLeaves = 8;
+  NodeContainer routers;
+  routers.Create (2);
+  NodeContainer left;
+  left.Create (nLeaves);
+  NodeContainer right;
+  right.Create (nLeaves);
+
+  InternetStackHelper internet;
+  internet.InstallAll ();
+
+  PointToPointHelper bottleneck;
+  bottleneck.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  bottleneck.SetChannelAttribute ("Delay", StringValue ("20ms"));
+  PointToPointHelper leaf;
+  leaf.SetDeviceAttribute ("DataRate", StringValue ("100Mbps"));
+  leaf.SetChannelAttribute ("Delay", StringValue ("1ms"));
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.0.0.0", "255.255.255.0");
+  address.Assign (bottleneck.Install (routers));
+  std::vector<Ipv4Address> sinkAddresses;
+  for (uint32_t i = 0; i < nLeaves; i++)
+    {
+      address.NewNetwork ();
+      address.Assign (leaf.Install (left.Get (i), routers.Get (0)));
+      address.NewNetwork ();
+      Ipv4InterfaceContainer interfaces = address.Assign (leaf.Install (right.Get (i), routers.Get (1)));
+      sinkAddresses.push_back (interfaces.GetAddress (0));
+    }
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+
+  uint16_t port = 9;
+  PacketSinkHelper sink ("ns3::TcpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), port));
+  sink.Install (right);
+  for (uint32_t i = 0; i < nLeaves; i++)
+    {
+      BulkSendHelper source ("ns3::TcpSocketFactory", InetSocketAddress (sinkAddresses[i], port));
+      source.Install (left.Get (i));
+    }
+
+  Simulator::Stop (Seconds (5 * scale));
+  Simulator::Run ();
+  return 0;
+}
+
+/// The benchmarks of the suite
+static const Benchmark g_benchmarks[] = {
+  { "scheduler-map", "hold model with the map scheduler", &BenchMapScheduler },
+  { "scheduler-list", "hold model with the list scheduler", &BenchListScheduler },
+  { "scheduler-heap", "hold model with the heap scheduler", &BenchHeapScheduler },
+  { "scheduler-calendar", "hold model with the calendar scheduler", &BenchCalendarScheduler },
+  { "packet-headers", "add, copy and remove IPv4 and UDP headers", &BenchPacketHeaders },
+  { "packet-fragments", "fragment and reassemble packets", &BenchPacketFragments },
+  { "buffer", "write and read a buffer", &BenchBuffer },
+  { "spectrum-value", "SINR computation over 100 bands", &BenchSpectrumValue },
+  { "wifi-interference-helper", "Wi-Fi receptions with 4 interferers", &BenchWifiInterferenceHelper },
+  { "lte-interference", "LTE subframe receptions with 6 interferers", &BenchLteInterference },
+  { "ff-mac-rr", "1 cell of 20 saturated UEs, RR scheduler", &BenchFfMacRr },
+  { "ff-mac-pf", "1 cell of 20 saturated UEs, PF scheduler", &BenchFfMacPf },
+  { "ff-mac-pss", "1 cell of 20 saturated UEs, PSS scheduler", &BenchFfMacPss },
+  { "ff-mac-cqa", "1 cell of 20 saturated UEs, CQA scheduler", &BenchFfMacCqa },
+  { "lena-profiling", "4 cells of 10 saturated UEs, as lena-profiling", &BenchLenaProfiling },
+  { "wifi-dense-bss", "1 AP and 30 saturated UDP STAs", &BenchWifiDenseBss },
+  { "p2p-dumbbell", "8 TCP bulk flows over a point-to-point dumbbell", &BenchP2pDumbbell },
+};
+
+/**
+ * Run a benchmark.
+ * \param benchmark the benchmark
+ * \param scale the workload scaling factor
+ * \returns the measurements
+ */
+static Result
+Run (const Benchmark &benchmark, double scale)
+{
+  Result result;
+  result.name = benchmark.name;
+  uint64_t allocations = g_allocations;
+  SystemWallClockMs time;
+  time.Start ();
+  result.operations = benchmark.function (scale);
+  result.events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+  result.wallMs = time.End ();
+  result.allocations = g_allocations - allocations;
+  result.peakRssKb = GetPeakRss ();
+  if (result.operations == 0)
+    {
+      // the simulation events are the operations
+      result.operations = result.events;
+    }
+  return result;
+}
+
+/**
+ * Compute a rate.
+ * \param count the count
+ * \param ms the elapsed time
+ * \returns the rate, per second
+ */
+static double
+Rate (uint64_t count, uint64_t ms)
+{
+  return count * 1000.0 / (ms > 0 ? ms : 1);
+}
+
+/**
+ * Write the results in JSON.
+ * \param os the output stream
+ * \param results the results
+ * \param scale the workload scaling factor
+ */
+static void
+WriteJson (std::ostream &os, const std::vector<Result> &results, double scale)
+{
+  os << "{" << std::endl
+     << "  \"scale\": " << scale << "," << std::endl
+     << "  \"benchmarks\": [" << std::endl;
+  for (uint32_t i = 0; i < results.size (); i++)
+    {
+      const Result &r = results[i];
+      os << "    {\"name\": \"" << r.name << "\""
+         << ", \"wallMs\": " << r.wallMs
+         << ", \"operations\": " << r.operations
+         << ", \"operationsPerSecond\": " << Rate (r.operations, r.wallMs)
+         << ", \"events\": " << r.events
+         << ", \"eventsPerSecond\": " << Rate (r.events, r.wallMs)
+         << ", \"peakRssKb\": " << r.peakRssKb
+         << ", \"allocations\": " << r.allocations
+         << "}" << (i + 1 < results.size () ? "," : "") << std::endl;
+    }
+  os << "  ]" << std::endl
+     << "}" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  bool list = false;
+  std::string run;
+  std::string json;
+  double scale = 1.0;
+
+  CommandLine cmd;
+  cmd.Usage ("Run the ns-3 benchmark suite");
+  cmd.AddValue ("list", "print the list of benchmarks", list);
+  cmd.AddValue ("run", "comma separated list of benchmarks to run (default all)", run);
+  cmd.AddValue ("json", "write the results in JSON to this file ('-' for stdout)", json);
+  cmd.AddValue ("scale", "workload scaling factor", scale);
+  cmd.Parse (argc, argv);
+
+  uint32_t nBenchmarks = sizeof (g_benchmarks) / sizeof (g_benchmarks[0]);
+  if (list)
+    {
+      for (uint32_t i = 0; i < nBenchmarks; i++)
+        {
+          std::cout << g_benchmarks[i].name << "\t" << g_benchmarks[i].description << std::endl;
+        }
+      return 0;
+    }
+  if (scale <= 0)
+    {
+      std::cerr << "Error-- the scale must be positive" << std::endl;
+      exit (1);
+    }
+
+  std::vector<const Benchmark *> selected;
+  if (run.empty ())
+    {
+      for (uint32_t i = 0; i < nBenchmarks; i++)
+        {
+          selected.push_back (&g_benchmarks[i]);
+        }
+    }
+  else
+    {
+      std::istringstream names (run);
+      std::string name;
+      while (std::getline (names, name, ','))
+        {
+          uint32_t i = 0;
+          while (i < nBenchmarks && name != g_benchmarks[i].name)
+            {
+              i++;
+            }
+          if (i == nBenchmarks)
+            {
+              std::cerr << "Error-- unknown benchmark " << name << std::endl;
+              exit (1);
+            }
+          selected.push_back (&g_benchmarks[i]);
+        }
+    }
+
+  std::vector<Result> results;
+  for (uint32_t i = 0; i < selected.size (); i++)
+    {
+      Result r = Run (*selected[i], scale);
+      results.push_back (r);
+      if (json != "-")
+        {
+          std::cout << r.name << ": " << r.wallMs << " ms, "
+                    << Rate (r.operations, r.wallMs) << " ops/s, "
+                    << Rate (r.events, r.wallMs) << " events/s, "
+                    << r.peakRssKb << " kB peak RSS, "
+                    << r.allocations << " allocations" << std::endl;
+        }
+    }
+
+  if (json == "-")
+    {
+      WriteJson (std::cout, results, scale);
+    }
+  else if (!json.empty ())
+    {
+      std::ofstream os (json.c_str ());
+      if (!os)
+        {
+          std::cerr << "Error-- cannot open " << json << std::endl;
+          exit (1);
+        }
+      WriteJson (os, results, scale);
+    }
+  return 0;
+}
@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the TCP send and receive buffers
+// with a single bulk transfer over a long, fast and lossy point-to-point
+// link.  The default setting moves 1 GB over a 10 Gbps link with a 100 ms
+// RTT, i.e., with windows larger than 100 MB, and SACK enabled.
+// Sample usage:  ./waf --run 'bench-tcp-bulk --bytes=100000000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/config.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/pointer.h"
+#include "ns3/string.h"
+#include "ns3/simulator.h"
+#include "ns3/error-model.h"
+#include "ns3/net-device.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-interface-container.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/bulk-send-helper.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/callback.h"
+#include <iostream>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/// Time at which the sink received the last byte
+static Time g_lastRx;
+
+/**
+ * Record the reception time of a packet at the sink.
+ * \param p the packet
+ * \param from the sender address
+ */
+static void
+SinkRx (Ptr<const Packet> p, const Address &from)
+{
+  g_lastRx = Simulator::Now ();
+}
+
+int main (int argc, char *argv[])
+{
+  uint64_t bytes = 1000000000;
+  std::string rate = "10Gbps";
+  std::string delay = "50ms";
+  double errorRate = 1e-5;
+  uint32_t bufferSize = 256 * 1024 * 1024;
+  bool sack = true;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark a TCP bulk transfer over a long fat lossy pipe");
+  cmd.AddValue ("bytes", "number of bytes to transfer", bytes);
+  cmd.AddValue ("rate", "link data rate", rate);
+  cmd.AddValue ("delay", "one-way link delay", delay);
+  cmd.AddValue ("errorRate", "packet error rate of the link", errorRate);
+  cmd.AddValue ("bufferSize", "TCP send and receive buffer size", bufferSize);
+  cmd.AddValue ("sack", "enable SACK", sack);
+  cmd.Parse (argc, argv);
+
+  if (bytes == 0)
+    {
+      std::cerr << "Error-- the number of bytes must be positive" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-tcp-bulk with bytes=" << bytes << " rate=" << rate
+            << " delay=" << delay << " errorRate=" << errorRate << std::endl;
+
+  Config::SetDefault ("ns3::TcpSocket::SegmentSize", UintegerValue (1448));
+  Config::SetDefault ("ns3::TcpSocket::SndBufSize", UintegerValue (bufferSize));
+  Config::SetDefault ("ns3::TcpSocket::RcvBufSize", UintegerValue (bufferSize));
+  Config::SetDefault ("ns3::TcpSocketBase::Sack", BooleanValue (sack));
+
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue (rate));
+  p2p.SetChannelAttribute ("Delay", StringValue (delay));
+  NetDeviceContainer devices = p2p.Install (nodes);
+
+  Ptr<RateErrorModel> em = CreateObject<RateErrorModel> ();
+  em->SetUnit (RateErrorModel::ERROR_UNIT_PACKET);
+  em->SetRate (errorRate);
+  devices.Get (1)->SetAttribute ("ReceiveErrorModel", PointerValue (em));
+
+  InternetStackHelper internet;
+  internet.Install (nodes);
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  uint16_t port = 9;
+  BulkSendHelper source ("ns3::TcpSocketFactory",
+                         InetSocketAddress (interfaces.GetAddress (1), port));
+  source.SetAttribute ("MaxBytes", UintegerValue (bytes));
+  source.SetAttribute ("SendSize", UintegerValue (1448 * 64));
+  source.Install (nodes.Get (0));
+
+  PacketSinkHelper sink ("ns3::TcpSocketFactory",
+                         InetSocketAddress (Ipv4Address::GetAny (), port));
+  Ptr<PacketSink> sinkApp = DynamicCast<PacketSink> (sink.Install (nodes.Get (1)).Get (0));
+  sinkApp->TraceConnectWithoutContext ("Rx", MakeCallback (&SinkRx));
+
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  uint64_t ms = time.End ();
+
+  double simSeconds = g_lastRx.GetSeconds ();
+  uint64_t received = sinkApp->GetTotalRx ();
+  Simulator::Destroy ();
+
+  std::cout << received << " bytes received in " << simSeconds << " s of simulated time ("
+            << received * 8 / simSeconds / 1e9 << " Gbps)" << std::endl;
+  std::cout << ms << " ms elapsed (" << received / 1e6 / (ms > 0 ? ms / 1e3 : 1e-3)
+            << " MB of simulated transfer per second)" << std::endl;
+
+  if (received != bytes)
+    {
+      std::cerr << "Error-- received " << received << " of " << bytes << " bytes" << std::endl;
+      return 1;
+    }
+  return 0;
+}
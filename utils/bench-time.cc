@@ -0,0 +1,205 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the conversions between Time
+// and doubles found in PHY duration computations, against the
+// int64x64_t conversions and plain double arithmetic.
+// Sample usage:  ./waf --run 'bench-time --n=10000000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/int64x64.h"
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/**
+ * Print the rate of an operation.
+ * \param count the number of operations
+ * \param ms the elapsed time
+ * \param name the operation name
+ */
+static void
+Report (uint64_t count, uint64_t ms, std::string name)
+{
+  double ps = count;
+  ps *= 1000;
+  ps /= ms > 0 ? ms : 1;
+  std::cout << ps << " ops/s"
+            << " (" << ms << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+/**
+ * Get the name of the int64x64_t implementation.
+ * \return The name.
+ */
+static std::string
+Implementation (void)
+{
+  switch (int64x64_t::implementation)
+    {
+    case int64x64_t::int128_impl:
+      return "int128";
+    case int64x64_t::cairo_impl:
+      return "cairo";
+    case int64x64_t::ld_impl:
+      return "long double";
+    }
+  return "unknown";
+}
+
+int main (int argc, char *argv[])
+{
+  uint64_t n = 10000000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark Time conversions in PHY duration computations");
+  cmd.AddValue ("n", "number of conversions per measure", n);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- the number of conversions must be positive" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-time with n=" << n
+            << ", int64x64_t implementation " << Implementation ()
+            << std::endl;
+  const std::string ref = " [" + Implementation () + "]";
+
+  // Times built before Simulator::Run are recorded in case the
+  // resolution changes; measure the conversions as a running
+  // simulation sees them.
+  Simulator::Run ();
+
+  // Durations in seconds, as computed by the PHYs: OFDM symbols
+  // and TTIs, propagation delays, and payload durations at
+  // some rate.
+  const uint32_t count = 1024;
+  std::vector<double> seconds;
+  for (uint32_t i = 0; i < count; i++)
+    {
+      switch (i % 4)
+        {
+        case 0:
+          seconds.push_back ((i + 1) * 4e-6);
+          break;
+        case 1:
+          seconds.push_back ((i + 1) * 0.001);
+          break;
+        case 2:
+          seconds.push_back ((i + 1) * 7.5 / 299792458.0);
+          break;
+        default:
+          seconds.push_back ((i + 1) * 1500 * 8 / 54e6);
+          break;
+        }
+    }
+  std::vector<Time> times;
+  for (uint32_t i = 0; i < count; i++)
+    {
+      times.push_back (i % 2 ? Seconds (i + 1) : MicroSeconds (4 * (i + 1)));
+    }
+
+  int64_t steps = 0;
+  double total = 0;
+  SystemWallClockMs time;
+
+  time.Start ();
+  for (uint64_t i = 0; i < n; i++)
+    {
+      steps += Seconds (seconds[i % count]).GetTimeStep ();
+    }
+  Report (n, time.End (), "Seconds (double)");
+
+  time.Start ();
+  for (uint64_t i = 0; i < n; i++)
+    {
+      steps += Time::From (int64x64_t (seconds[i % count]), Time::S).GetTimeStep ();
+    }
+  Report (n, time.End (), "Seconds (double)" + ref);
+
+  time.Start ();
+  for (uint64_t i = 0; i < n; i++)
+    {
+      steps += static_cast<int64_t> (seconds[i % count] * 1e9);
+    }
+  Report (n, time.End (), "Seconds (double) [double]");
+
+  time.Start ();
+  for (uint64_t i = 0; i < n; i++)
+    {
+      total += times[i % count].GetSeconds ();
+    }
+  Report (n, time.End (), "GetSeconds ()");
+
+  time.Start ();
+  for (uint64_t i = 0; i < n; i++)
+    {
+      total += times[i % count].To (Time::S).GetDouble ();
+    }
+  Report (n, time.End (), "GetSeconds ()" + ref);
+
+  time.Start ();
+  for (uint64_t i = 0; i < n; i++)
+    {
+      total += times[i % count].GetTimeStep () / 1e9;
+    }
+  Report (n, time.End (), "GetSeconds () [double]");
+
+  // WifiPhy::GetPayloadDuration: the duration of the symbols
+  // carrying the payload, plus the preamble and the header
+  const Time symbol = NanoSeconds (4000);
+  const Time preamble = MicroSeconds (20);
+  time.Start ();
+  for (uint64_t i = 0; i < n; i++)
+    {
+      double bits = 8 * (i % count) + 22;
+      double symbols = std::ceil (bits / (54e6 * symbol.GetSeconds ()));
+      Time duration = preamble + symbol * static_cast<int64_t> (symbols);
+      steps += (duration / symbol) + Seconds (duration.GetSeconds () * 0.5).GetTimeStep ();
+    }
+  Report (n, time.End (), "payload duration");
+
+  time.Start ();
+  for (uint64_t i = 0; i < n; i++)
+    {
+      double bits = 8 * (i % count) + 22;
+      double symbols = std::ceil (bits / (54e6 * symbol.To (Time::S).GetDouble ()));
+      Time duration = preamble + symbol * static_cast<int64_t> (symbols);
+      double half = duration.To (Time::S).GetDouble () * 0.5;
+      steps += (duration / symbol) + Time::From (int64x64_t (half), Time::S).GetTimeStep ();
+    }
+  Report (n, time.End (), "payload duration" + ref);
+
+  Simulator::Destroy ();
+
+  // keep the compiler from discarding the loops
+  if (steps == 0 && total == 0)
+    {
+      std::cerr << "Error-- nothing converted" << std::endl;
+      return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark a UanChannel shared by 'n'
+// static nodes broadcasting periodically, with the Thorp propagation
+// model recomputed on each transmission, cached per link, and with the
+// distant receivers culled.
+// Sample usage:  ./waf --run 'bench-uan --n=500 --stop=600'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/pointer.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/uan-channel.h"
+#include "ns3/uan-net-device.h"
+#include "ns3/uan-mac-aloha.h"
+#include "ns3/uan-phy-gen.h"
+#include "ns3/uan-transducer-hd.h"
+#include "ns3/uan-prop-model-thorp.h"
+#include <iostream>
+#include <limits>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/// Number of packets received
+static uint64_t g_received = 0;
+
+/**
+ * Receive callback of the devices.
+ * \param dev the device.
+ * \param pkt the packet.
+ * \param mode the protocol number.
+ * \param sender the address of the sender.
+ * \return true.
+ */
+static bool
+Receive (Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address &sender)
+{
+  g_received++;
+  return true;
+}
+
+/**
+ * Broadcast a packet, and schedule the next one.
+ * \param dev the device.
+ * \param interval the interval between two packets.
+ */
+static void
+Broadcast (Ptr<UanNetDevice> dev, Time interval)
+{
+  dev->Send (Create<Packet> (17), dev->GetBroadcast (), 0);
+  Simulator::Schedule (interval, &Broadcast, dev, interval);
+}
+
+/**
+ * Run the simulation.
+ * \param n the number of nodes.
+ * \param stop the simulated time.
+ * \param cache whether the channel caches the links.
+ * \param maxPathLossDb the largest path loss of the receivers.
+ */
+static void
+Run (uint32_t n, Time stop, bool cache, double maxPathLossDb)
+{
+  Ptr<UanChannel> channel = CreateObject<UanChannel> ();
+  channel->SetAttribute ("PropagationModel", PointerValue (CreateObject<UanPropModelThorp> ()));
+  channel->SetAttribute ("CacheLinks", BooleanValue (cache));
+  channel->SetAttribute ("MaxPathLossDb", DoubleValue (maxPathLossDb));
+
+  // nodes spread over 10 km, broadcasting every minute
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  uniform->SetStream (1);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<Node> node = CreateObject<Node> ();
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (uniform->GetValue (0, 10000), uniform->GetValue (0, 10000), 50));
+      node->AggregateObject (mobility);
+
+      Ptr<UanMacAloha> mac = CreateObject<UanMacAloha> ();
+      mac->SetAddress (Mac8Address::Allocate ());
+      Ptr<UanNetDevice> dev = CreateObject<UanNetDevice> ();
+      dev->SetPhy (CreateObject<UanPhyGen> ());
+      dev->SetMac (mac);
+      dev->SetChannel (channel);
+      dev->SetTransducer (CreateObject<UanTransducerHd> ());
+      node->AddDevice (dev);
+      dev->SetReceiveCallback (MakeCallback (&Receive));
+
+      Simulator::Schedule (Seconds (uniform->GetValue (0, 60)), &Broadcast, dev, Seconds (60));
+    }
+
+  g_received = 0;
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Stop (stop);
+  Simulator::Run ();
+  uint64_t ms = time.End ();
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+
+  std::cout << (cache ? "cached  " : "uncached")
+            << (maxPathLossDb < std::numeric_limits<double>::max () ? " culled" : "       ")
+            << "  "
+            << ms << " ms, " << events << " events, "
+            << g_received << " packets received"
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 500;
+  double stop = 600;
+  double maxPathLossDb = 80;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark UanChannel link caching and receiver culling");
+  cmd.AddValue ("n", "number of nodes", n);
+  cmd.AddValue ("stop", "simulated time, in seconds", stop);
+  cmd.AddValue ("maxPathLossDb", "largest path loss of the receivers, when culling", maxPathLossDb);
+  cmd.Parse (argc, argv);
+
+  if (n == 0 || stop <= 0)
+    {
+      std::cerr << "Error-- the number of nodes and the time must be positive" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-uan with n=" << n << " stop=" << stop << std::endl;
+
+  double noLimit = std::numeric_limits<double>::max ();
+  Run (n, Seconds (stop), false, noLimit);
+  Run (n, Seconds (stop), true, noLimit);
+  Run (n, Seconds (stop), true, maxPathLossDb);
+  return 0;
+}